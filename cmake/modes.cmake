@@ -25,3 +25,15 @@ if(USE_PERF_TESTS)
   message(STATUS "Enable performance tests")
   add_compile_definitions(USE_PERF_TESTS)
 endif(USE_PERF_TESTS)
+
+# PMPI wrappers need the MPI library to export PMPI_ entry points with the C calling convention.
+if(WIN32)
+  set(MPI_ACCOUNTING_DEFAULT OFF)
+else()
+  set(MPI_ACCOUNTING_DEFAULT ON)
+endif()
+option(USE_MPI_ACCOUNTING "Count point-to-point MPI messages to detect unread ones" ${MPI_ACCOUNTING_DEFAULT})
+if(USE_MPI_ACCOUNTING)
+  message(STATUS "Enable MPI message accounting")
+  add_compile_definitions(PPC_MPI_ACCOUNTING)
+endif(USE_MPI_ACCOUNTING)
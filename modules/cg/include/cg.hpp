@@ -0,0 +1,165 @@
+#pragma once
+
+#include <mpi.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <string>
+#include <vector>
+
+#include "shared_memory/include/parallel_for.hpp"
+#include "sparse/include/sparse.hpp"
+
+namespace ppc::cg {
+
+using Backend = ppc::shared_memory::Backend;
+
+/// @brief Rows [RowOffset(), RowOffset() + Rows()) of a square SPD matrix of order Cols().
+/// @details In a distributed solve every rank owns one contiguous strip; shared-memory solves use
+/// a single strip with offset zero.
+class Operator {
+ public:
+  Operator() = default;
+  virtual ~Operator() = default;
+  Operator(const Operator &) = default;
+  Operator &operator=(const Operator &) = default;
+  Operator(Operator &&) = default;
+  Operator &operator=(Operator &&) = default;
+
+  [[nodiscard]] virtual std::size_t Rows() const = 0;
+  [[nodiscard]] virtual std::size_t Cols() const = 0;
+  [[nodiscard]] virtual std::size_t RowOffset() const = 0;
+
+  /// @brief y = A_local * x for the whole vector @p x.
+  /// @return The local part of (x, A x), fused into the same pass over the rows.
+  virtual double Apply(std::span<const double> x, std::span<double> y, Backend backend) const = 0;
+
+  /// @brief Diagonal of the local strip.
+  [[nodiscard]] virtual std::vector<double> Diagonal() const = 0;
+
+  /// @brief Square block of the local strip on its own rows and columns, as used by the block-Jacobi
+  /// incomplete Cholesky preconditioner.
+  [[nodiscard]] virtual ppc::sparse::Crs<double> DiagonalBlock() const = 0;
+};
+
+/// @brief Operator over a row-major dense strip.
+class DenseOperator final : public Operator {
+ public:
+  /// @param values Rows x cols row-major strip.
+  /// @throws std::invalid_argument When the strip size or offset does not match the shape.
+  DenseOperator(std::size_t rows, std::size_t cols, std::vector<double> values, std::size_t row_offset = 0);
+
+  [[nodiscard]] std::size_t Rows() const override {
+    return rows_;
+  }
+  [[nodiscard]] std::size_t Cols() const override {
+    return cols_;
+  }
+  [[nodiscard]] std::size_t RowOffset() const override {
+    return row_offset_;
+  }
+  double Apply(std::span<const double> x, std::span<double> y, Backend backend) const override;
+  [[nodiscard]] std::vector<double> Diagonal() const override;
+  [[nodiscard]] ppc::sparse::Crs<double> DiagonalBlock() const override;
+
+ private:
+  std::size_t rows_;
+  std::size_t cols_;
+  std::size_t row_offset_;
+  std::vector<double> values_;
+};
+
+/// @brief Operator over a Crs strip whose column indices are global.
+class CrsOperator final : public Operator {
+ public:
+  /// @throws std::invalid_argument When @p strip is malformed or does not fit the offset.
+  explicit CrsOperator(ppc::sparse::Crs<double> strip, std::size_t row_offset = 0);
+
+  [[nodiscard]] std::size_t Rows() const override {
+    return strip_.rows;
+  }
+  [[nodiscard]] std::size_t Cols() const override {
+    return strip_.cols;
+  }
+  [[nodiscard]] std::size_t RowOffset() const override {
+    return row_offset_;
+  }
+  double Apply(std::span<const double> x, std::span<double> y, Backend backend) const override;
+  [[nodiscard]] std::vector<double> Diagonal() const override;
+  [[nodiscard]] ppc::sparse::Crs<double> DiagonalBlock() const override;
+
+ private:
+  ppc::sparse::Crs<double> strip_;
+  std::size_t row_offset_;
+};
+
+/// @brief Whole row-major n x n matrix, the dense input of the course tasks.
+struct DenseMatrix {
+  std::size_t n = 0;
+  std::vector<double> values;
+};
+
+/// @brief Operator over rows [begin, end) of @p a.
+/// @throws std::invalid_argument When the range does not fit the matrix.
+std::unique_ptr<Operator> MakeStrip(const DenseMatrix &a, std::size_t begin, std::size_t end);
+
+/// @brief Operator over rows [begin, end) of the square matrix @p a.
+/// @throws std::invalid_argument When the range does not fit the matrix.
+std::unique_ptr<Operator> MakeStrip(const ppc::sparse::Crs<double> &a, std::size_t begin, std::size_t end);
+
+/// @brief CG recurrence.
+enum class Variant : uint8_t {
+  /// Hestenes-Stiefel PCG: two reductions per iteration
+  kClassic,
+  /// Ghysels-Vanroose pipelined PCG: one non-blocking reduction per iteration, overlapped with the
+  /// preconditioner and the operator
+  kPipelined
+};
+
+/// @brief Returns the lower-case name of the variant ("classic", "pipelined").
+std::string VariantToString(Variant variant);
+
+/// @brief Preconditioner M^{-1}.
+enum class Preconditioner : uint8_t {
+  kNone,
+  /// Inverse of the diagonal, fused into the vector updates
+  kJacobi,
+  /// IC(0) of the local diagonal block (block Jacobi across ranks)
+  kIncompleteCholesky
+};
+
+/// @brief Returns the lower-case name of the preconditioner ("none", "jacobi", "ic0").
+std::string PreconditionerToString(Preconditioner preconditioner);
+
+struct Options {
+  Variant variant = Variant::kClassic;
+  Preconditioner preconditioner = Preconditioner::kJacobi;
+  /// Stop once ||r|| <= tolerance * ||b||.
+  double tolerance = 1e-8;
+  std::size_t max_iterations = 1000;
+  /// Thread back-end of the local kernels.
+  Backend backend = Backend::kSeq;
+};
+
+struct Result {
+  /// Local part of the solution.
+  std::vector<double> x;
+  std::size_t iterations = 0;
+  bool converged = false;
+  /// ||r_k|| / ||b|| for k = 0 .. iterations.
+  std::vector<double> history;
+  /// Wall time of the iterations, without the setup of the preconditioner.
+  double seconds = 0.0;
+};
+
+/// @brief Solves A x = b from x = 0.
+/// @param b_local Local rows of b.
+/// @param comm Communicator of the strips, or MPI_COMM_NULL for a shared-memory solve.
+/// @throws std::invalid_argument When b_local does not match the operator, the strips do not tile
+/// the matrix, or IC(0) meets a non-positive pivot on any rank (then on every rank).
+Result Solve(const Operator &a, std::span<const double> b_local, const Options &options = {},
+             MPI_Comm comm = MPI_COMM_NULL);
+
+}  // namespace ppc::cg
@@ -0,0 +1,123 @@
+#pragma once
+
+#include <mpi.h>
+
+#include <concepts>
+#include <cstddef>
+#include <memory>
+#include <span>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include "cg/include/cg.hpp"
+#include "shared_memory/include/parallel_for.hpp"
+#include "shared_memory/include/shared_memory.hpp"
+#include "sparse/include/sparse.hpp"
+#include "task/include/task.hpp"
+
+namespace ppc::cg {
+
+template <typename M>
+concept Matrix = std::same_as<M, DenseMatrix> || std::same_as<M, ppc::sparse::Crs<double>>;
+
+/// @brief A x = b with A symmetric positive definite; every rank holds the whole input, as in the
+/// course tasks.
+template <Matrix M>
+struct CgProblem {
+  M a;
+  std::vector<double> b;
+};
+
+/// @brief Preconditioned CG as a course task on any back-end.
+/// @details The kMPI variant solves on a block of rows per rank and gathers the whole solution on
+/// every rank in PostProcessing. The output carries the convergence history of the solve.
+template <Matrix M, ppc::task::TypeOfTask kType, Variant kVariant = Variant::kClassic,
+          Preconditioner kPreconditioner = Preconditioner::kJacobi>
+class CgTask : public ppc::task::Task<CgProblem<M>, Result> {
+ public:
+  using InType = CgProblem<M>;
+  using OutType = Result;
+
+  static constexpr ppc::task::TypeOfTask GetStaticTypeOfTask() {
+    return kType;
+  }
+
+  explicit CgTask(const InType &in, double tolerance = 1e-8, std::size_t max_iterations = 1000) {
+    this->SetTypeOfTask(GetStaticTypeOfTask());
+    this->GetInput() = in;
+    options_ = {.variant = kVariant,
+                .preconditioner = kPreconditioner,
+                .tolerance = tolerance,
+                .max_iterations = max_iterations,
+                .backend = ppc::shared_memory::BackendOf(kType)};
+  }
+
+ private:
+  static std::size_t Order(const M &a) {
+    if constexpr (std::same_as<M, DenseMatrix>) {
+      return a.n;
+    } else {
+      return a.rows;
+    }
+  }
+
+  bool ValidationImpl() override {
+    const InType &in = this->GetInput();
+    if constexpr (std::same_as<M, DenseMatrix>) {
+      return in.a.values.size() == in.a.n * in.a.n && in.b.size() == in.a.n;
+    } else {
+      return ppc::sparse::IsValid(in.a) && in.a.rows == in.a.cols && in.b.size() == in.a.rows;
+    }
+  }
+
+  bool PreProcessingImpl() override {
+    const InType &in = this->GetInput();
+    const std::size_t n = Order(in.a);
+    begin_ = 0;
+    std::size_t end = n;
+    if constexpr (kType == ppc::task::TypeOfTask::kMPI) {
+      int rank = 0;
+      int size = 1;
+      MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+      MPI_Comm_size(MPI_COMM_WORLD, &size);
+      std::tie(begin_, end) = ppc::shared_memory::BlockRange(n, size, rank);
+    }
+    strip_ = MakeStrip(in.a, begin_, end);
+    return true;
+  }
+
+  bool RunImpl() override {
+    const auto b_local = std::span<const double>(this->GetInput().b).subspan(begin_, strip_->Rows());
+    const MPI_Comm comm = kType == ppc::task::TypeOfTask::kMPI ? MPI_COMM_WORLD : MPI_COMM_NULL;
+    this->GetOutput() = Solve(*strip_, b_local, options_, comm);
+    return true;
+  }
+
+  bool PostProcessingImpl() override {
+    Result &out = this->GetOutput();
+    if constexpr (kType == ppc::task::TypeOfTask::kMPI) {
+      int size = 1;
+      MPI_Comm_size(MPI_COMM_WORLD, &size);
+      const std::size_t n = Order(this->GetInput().a);
+      std::vector<int> counts(static_cast<std::size_t>(size));
+      std::vector<int> displs(static_cast<std::size_t>(size));
+      for (int r = 0; r < size; r++) {
+        const auto [b, e] = ppc::shared_memory::BlockRange(n, size, r);
+        displs[static_cast<std::size_t>(r)] = static_cast<int>(b);
+        counts[static_cast<std::size_t>(r)] = static_cast<int>(e - b);
+      }
+      std::vector<double> x(n);
+      MPI_Allgatherv(out.x.data(), static_cast<int>(out.x.size()), MPI_DOUBLE, x.data(), counts.data(),
+                     displs.data(), MPI_DOUBLE, MPI_COMM_WORLD);
+      out.x = std::move(x);
+    }
+    return out.x.size() == Order(this->GetInput().a);
+  }
+
+  Options options_;
+  std::size_t begin_ = 0;
+  std::unique_ptr<Operator> strip_;
+};
+
+}  // namespace ppc::cg
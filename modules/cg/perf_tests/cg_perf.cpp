@@ -0,0 +1,154 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+
+#include "cg/include/cg.hpp"
+#include "cg/include/cg_task.hpp"
+#include "sparse/include/sparse.hpp"
+#include "task/include/task.hpp"
+#include "util/include/perf_test_util.hpp"
+
+namespace ppc::cg::perf {
+
+using ppc::sparse::Crs;
+using ppc::task::TypeOfTask;
+
+namespace {
+
+constexpr double kTolerance = 1e-8;
+constexpr std::size_t kMaxIterations = 5000;
+
+/// Five-point Laplacian on a 256 x 256 grid: 65536 rows, several hundred Jacobi-PCG iterations.
+const Crs<double> &PoissonMatrix() {
+  static const Crs<double> kMatrix = [] {
+    constexpr std::size_t kSide = 256;
+    std::vector<ppc::sparse::Triplet<double>> entries;
+    for (std::size_t i = 0; i < kSide; i++) {
+      for (std::size_t j = 0; j < kSide; j++) {
+        const std::size_t row = (i * kSide) + j;
+        entries.push_back({.row = row, .col = row, .value = 4.0});
+        if (i > 0) {
+          entries.push_back({.row = row, .col = row - kSide, .value = -1.0});
+        }
+        if (i + 1 < kSide) {
+          entries.push_back({.row = row, .col = row + kSide, .value = -1.0});
+        }
+        if (j > 0) {
+          entries.push_back({.row = row, .col = row - 1, .value = -1.0});
+        }
+        if (j + 1 < kSide) {
+          entries.push_back({.row = row, .col = row + 1, .value = -1.0});
+        }
+      }
+    }
+    return ppc::sparse::FromTriplets<double>(kSide * kSide, kSide * kSide, entries);
+  }();
+  return kMatrix;
+}
+
+/// Kac-Murdock-Szego matrix 0.99^|i-j| of order 1024: dense, SPD and moderately ill-conditioned.
+const DenseMatrix &DenseSpdMatrix() {
+  static const DenseMatrix kMatrix = [] {
+    constexpr std::size_t kOrder = 1024;
+    DenseMatrix a{.n = kOrder, .values = std::vector<double>(kOrder * kOrder)};
+    for (std::size_t i = 0; i < kOrder; i++) {
+      for (std::size_t j = 0; j < kOrder; j++) {
+        a.values[(i * kOrder) + j] = std::pow(0.99, static_cast<double>(i > j ? i - j : j - i));
+      }
+    }
+    return a;
+  }();
+  return kMatrix;
+}
+
+/// CgTask with the tolerance and iteration cap of the perf suites.
+template <typename M, TypeOfTask kType, Variant kVariant, Preconditioner kPreconditioner>
+class PerfCgTask : public CgTask<M, kType, kVariant, kPreconditioner> {
+ public:
+  explicit PerfCgTask(const CgProblem<M> &in)
+      : CgTask<M, kType, kVariant, kPreconditioner>(in, kTolerance, kMaxIterations) {}
+};
+
+}  // namespace
+
+/// Reports iterations per second, the in-solver time per iteration and every 16th entry of the
+/// convergence history.
+template <typename M>
+class CgPerfTests : public ppc::util::BaseRunPerfTests<CgProblem<M>, Result> {
+  CgProblem<M> input_data_;
+
+  void SetUp() override {
+    if constexpr (std::is_same_v<M, DenseMatrix>) {
+      input_data_.a = DenseSpdMatrix();
+      input_data_.b.assign(input_data_.a.n, 1.0);
+    } else {
+      input_data_.a = PoissonMatrix();
+      input_data_.b.assign(input_data_.a.rows, 1.0);
+    }
+  }
+
+  bool CheckTestOutputData(Result &output_data) final {
+    const auto iterations = static_cast<double>(output_data.iterations);
+    this->PrintRate("iterations_per_s", iterations);
+    this->PrintValue("iterations", iterations);
+    this->PrintValue("ms_per_iteration", 1e3 * output_data.seconds / std::max(iterations, 1.0));
+    std::vector<double> sampled;
+    for (std::size_t k = 0; k < output_data.history.size(); k += 16) {
+      sampled.push_back(output_data.history[k]);
+    }
+    this->PrintSeries("history", sampled);
+    return output_data.converged && output_data.x.size() == input_data_.b.size();
+  }
+
+  CgProblem<M> GetTestInputData() final {
+    return input_data_;
+  }
+};
+
+using PoissonPerfTests = CgPerfTests<Crs<double>>;
+using DensePerfTests = CgPerfTests<DenseMatrix>;
+
+/// PerfCgTask of every back-end for one matrix type, variant and preconditioner.
+template <typename M, Variant kVariant, Preconditioner kPreconditioner>
+struct PerfCgTasks {
+  template <TypeOfTask kType>
+  using Task = PerfCgTask<M, kType, kVariant, kPreconditioner>;
+};
+
+template <typename M, Variant kVariant, Preconditioner kPreconditioner>
+auto MakeBackendSuite(const std::string &kernel) {
+  return ppc::util::MakeBackendPerfTaskTuples<PerfCgTasks<M, kVariant, kPreconditioner>::template Task, CgProblem<M>>(
+      "ppc_cg", kernel);
+}
+
+TEST_P(PoissonPerfTests, RunPerfModes) {
+  ExecuteTest(GetParam());
+}
+
+TEST_P(DensePerfTests, RunPerfModes) {
+  ExecuteTest(GetParam());
+}
+
+const auto kPoissonPerfTasks =
+    std::tuple_cat(MakeBackendSuite<Crs<double>, Variant::kClassic, Preconditioner::kJacobi>("poisson_classic"),
+                   MakeBackendSuite<Crs<double>, Variant::kPipelined, Preconditioner::kJacobi>("poisson_pipelined"),
+                   MakeBackendSuite<Crs<double>, Variant::kClassic, Preconditioner::kIncompleteCholesky>(
+                       "poisson_classic_ic0"));
+
+const auto kDensePerfTasks =
+    std::tuple_cat(MakeBackendSuite<DenseMatrix, Variant::kClassic, Preconditioner::kJacobi>("dense_classic"),
+                   MakeBackendSuite<DenseMatrix, Variant::kPipelined, Preconditioner::kJacobi>("dense_pipelined"));
+
+INSTANTIATE_TEST_SUITE_P(Poisson2D, PoissonPerfTests, ppc::util::TupleToGTestValues(kPoissonPerfTasks),
+                         PoissonPerfTests::CustomPerfTestName);
+
+INSTANTIATE_TEST_SUITE_P(DenseSpd, DensePerfTests, ppc::util::TupleToGTestValues(kDensePerfTasks),
+                         DensePerfTests::CustomPerfTestName);
+
+}  // namespace ppc::cg::perf
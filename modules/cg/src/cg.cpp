@@ -0,0 +1,526 @@
+#include "cg/include/cg.hpp"
+
+#include <mpi.h>
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <memory>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "shared_memory/include/parallel_for.hpp"
+#include "shared_memory/include/shared_memory.hpp"
+#include "sparse/include/sparse.hpp"
+
+namespace ppc::cg {
+
+namespace {
+
+/// Sums K per-block partials of @p body(begin, end, partial) over the rows [0, count).
+/// Partials are added in block order, so results do not depend on scheduling.
+template <std::size_t K, typename Body>
+std::array<double, K> BlockSums(std::size_t count, Backend backend, const Body &body) {
+  const int blocks = ppc::shared_memory::BackendWorkers(backend);
+  std::vector<std::array<double, K>> partials(static_cast<std::size_t>(blocks));
+  ppc::shared_memory::ParallelFor(partials.size(), backend, [&](std::size_t block) {
+    const auto [begin, end] = ppc::shared_memory::BlockRange(count, blocks, static_cast<int>(block));
+    std::array<double, K> partial{};
+    body(begin, end, partial);
+    partials[block] = partial;
+  });
+  std::array<double, K> total{};
+  for (const auto &partial : partials) {
+    for (std::size_t k = 0; k < K; k++) {
+      total[k] += partial[k];
+    }
+  }
+  return total;
+}
+
+template <std::size_t K>
+void Allreduce(std::array<double, K> &values, MPI_Comm comm) {
+  if (comm != MPI_COMM_NULL) {
+    MPI_Allreduce(MPI_IN_PLACE, values.data(), static_cast<int>(K), MPI_DOUBLE, MPI_SUM, comm);
+  }
+}
+
+/// Assembles whole vectors from the strips of all ranks for the operator.
+class Assembler {
+ public:
+  Assembler(const Operator &a, MPI_Comm comm) : comm_(comm), full_(comm == MPI_COMM_NULL ? 0 : a.Cols()) {
+    if (comm == MPI_COMM_NULL) {
+      if (a.RowOffset() != 0 || a.Rows() != a.Cols()) {
+        throw std::invalid_argument("cg: a shared-memory solve needs the whole matrix");
+      }
+      return;
+    }
+    int size = 1;
+    MPI_Comm_size(comm, &size);
+    std::array<int, 2> mine = {static_cast<int>(a.RowOffset()), static_cast<int>(a.Rows())};
+    std::vector<int> all(2 * static_cast<std::size_t>(size));
+    MPI_Allgather(mine.data(), 2, MPI_INT, all.data(), 2, MPI_INT, comm);
+    counts_.resize(static_cast<std::size_t>(size));
+    displs_.resize(static_cast<std::size_t>(size));
+    std::size_t next = 0;
+    for (std::size_t r = 0; r < counts_.size(); r++) {
+      displs_[r] = all[2 * r];
+      counts_[r] = all[(2 * r) + 1];
+      if (static_cast<std::size_t>(displs_[r]) != next) {
+        throw std::invalid_argument("cg: the strips must tile the matrix in rank order");
+      }
+      next += static_cast<std::size_t>(counts_[r]);
+    }
+    if (next != a.Cols()) {
+      throw std::invalid_argument("cg: the strips must tile the matrix in rank order");
+    }
+  }
+
+  /// Whole vector whose local strip is @p local (the strip itself in shared memory).
+  std::span<const double> Full(const std::vector<double> &local) {
+    if (comm_ == MPI_COMM_NULL) {
+      return local;
+    }
+    MPI_Allgatherv(local.data(), static_cast<int>(local.size()), MPI_DOUBLE, full_.data(), counts_.data(),
+                   displs_.data(), MPI_DOUBLE, comm_);
+    return full_;
+  }
+
+ private:
+  MPI_Comm comm_;
+  std::vector<double> full_;
+  std::vector<int> counts_;
+  std::vector<int> displs_;
+};
+
+/// IC(0): L L^T with the lower-triangular pattern of the block, applied by two triangular solves.
+/// A factorization that fails records why in Failure() instead of throwing, so that the ranks can
+/// agree on it first.
+class IncompleteCholesky {
+ public:
+  explicit IncompleteCholesky(const ppc::sparse::Crs<double> &block) : n_(block.rows), ptr_(block.rows + 1, 0) {
+    for (std::size_t i = 0; i < n_; i++) {
+      for (std::size_t e = block.row_ptr[i]; e < block.row_ptr[i + 1] && block.col_indices[e] <= i; e++) {
+        idx_.push_back(block.col_indices[e]);
+        val_.push_back(block.values[e]);
+      }
+      ptr_[i + 1] = idx_.size();
+      if (ptr_[i + 1] == ptr_[i] || idx_.back() != i) {
+        failure_ = "cg: IC(0) needs every diagonal entry";
+        return;
+      }
+    }
+    for (std::size_t i = 0; i < n_; i++) {
+      const std::size_t diag = ptr_[i + 1] - 1;
+      for (std::size_t e = ptr_[i]; e < diag; e++) {
+        const std::size_t k = idx_[e];
+        // Sparse dot of rows i and k over the columns left of k.
+        double sum = 0.0;
+        std::size_t f = ptr_[k];
+        for (std::size_t g = ptr_[i]; g < e; g++) {
+          while (f < ptr_[k + 1] && idx_[f] < idx_[g]) {
+            f++;
+          }
+          if (f < ptr_[k + 1] && idx_[f] == idx_[g]) {
+            sum += val_[g] * val_[f];
+          }
+        }
+        val_[e] = (val_[e] - sum) / val_[ptr_[k + 1] - 1];
+      }
+      double pivot = val_[diag];
+      for (std::size_t e = ptr_[i]; e < diag; e++) {
+        pivot -= val_[e] * val_[e];
+      }
+      if (!(pivot > 0.0)) {
+        failure_ = "cg: IC(0) breakdown, the matrix is not positive definite enough";
+        return;
+      }
+      val_[diag] = std::sqrt(pivot);
+    }
+  }
+
+  /// Empty when the factorization succeeded.
+  [[nodiscard]] const std::string &Failure() const {
+    return failure_;
+  }
+
+  /// z = (L L^T)^{-1} r.
+  void Solve(std::span<const double> r, std::span<double> z) const {
+    for (std::size_t i = 0; i < n_; i++) {
+      double sum = r[i];
+      const std::size_t diag = ptr_[i + 1] - 1;
+      for (std::size_t e = ptr_[i]; e < diag; e++) {
+        sum -= val_[e] * z[idx_[e]];
+      }
+      z[i] = sum / val_[diag];
+    }
+    for (std::size_t i = n_; i-- > 0;) {
+      const std::size_t diag = ptr_[i + 1] - 1;
+      z[i] /= val_[diag];
+      for (std::size_t e = ptr_[i]; e < diag; e++) {
+        z[idx_[e]] -= val_[e] * z[i];
+      }
+    }
+  }
+
+ private:
+  std::size_t n_;
+  std::vector<std::size_t> ptr_;
+  std::vector<std::size_t> idx_;
+  std::vector<double> val_;
+  std::string failure_;
+};
+
+/// Shared state of both recurrences.
+struct Context {
+  const Operator &a;
+  const Options &options;
+  MPI_Comm comm;
+  std::size_t n;
+  Assembler assembler;
+  std::vector<double> inverse_diagonal;
+  std::unique_ptr<IncompleteCholesky> ic;
+
+  /// out = M^{-1} in.
+  void Precondition(const std::vector<double> &in, std::vector<double> &out) const {
+    switch (options.preconditioner) {
+      case Preconditioner::kNone:
+        std::ranges::copy(in, out.begin());
+        return;
+      case Preconditioner::kJacobi:
+        ppc::shared_memory::ParallelForBlocks(n, options.backend, [&](std::size_t begin, std::size_t end) {
+          for (std::size_t i = begin; i < end; i++) {
+            out[i] = inverse_diagonal[i] * in[i];
+          }
+        });
+        return;
+      case Preconditioner::kIncompleteCholesky:
+        ic->Solve(in, out);
+        return;
+    }
+  }
+
+  /// Scale the fused passes apply to produce M^{-1} v in place (1 without a diagonal preconditioner).
+  [[nodiscard]] double Scale(std::size_t i) const {
+    return options.preconditioner == Preconditioner::kJacobi ? inverse_diagonal[i] : 1.0;
+  }
+
+  [[nodiscard]] bool Fusable() const {
+    return options.preconditioner != Preconditioner::kIncompleteCholesky;
+  }
+};
+
+void SolveClassic(Context &ctx, std::span<const double> b, Result &result, double b_norm) {
+  const std::size_t n = ctx.n;
+  const Backend backend = ctx.options.backend;
+  std::vector<double> &x = result.x;
+  std::vector<double> r(b.begin(), b.end());
+  std::vector<double> z(n);
+  std::vector<double> q(n);
+  ctx.Precondition(r, z);
+  std::vector<double> p = z;
+  auto sums = BlockSums<2>(n, backend, [&](std::size_t begin, std::size_t end, std::array<double, 2> &acc) {
+    for (std::size_t i = begin; i < end; i++) {
+      acc[0] += r[i] * z[i];
+      acc[1] += r[i] * r[i];
+    }
+  });
+  Allreduce(sums, ctx.comm);
+  double rz = sums[0];
+  result.history.push_back(std::sqrt(sums[1]) / b_norm);
+
+  while (result.history.back() > ctx.options.tolerance && result.iterations < ctx.options.max_iterations) {
+    std::array<double, 1> pq = {ctx.a.Apply(ctx.assembler.Full(p), q, backend)};
+    Allreduce(pq, ctx.comm);
+    const double alpha = rz / pq[0];
+    // One pass: x and r updates, the diagonal preconditioner and both dot products.
+    sums = BlockSums<2>(n, backend, [&](std::size_t begin, std::size_t end, std::array<double, 2> &acc) {
+      for (std::size_t i = begin; i < end; i++) {
+        x[i] += alpha * p[i];
+        r[i] -= alpha * q[i];
+        z[i] = ctx.Scale(i) * r[i];
+        acc[0] += r[i] * z[i];
+        acc[1] += r[i] * r[i];
+      }
+    });
+    if (!ctx.Fusable()) {
+      ctx.Precondition(r, z);
+      sums[0] = BlockSums<1>(n, backend, [&](std::size_t begin, std::size_t end, std::array<double, 1> &acc) {
+        for (std::size_t i = begin; i < end; i++) {
+          acc[0] += r[i] * z[i];
+        }
+      })[0];
+    }
+    Allreduce(sums, ctx.comm);
+    result.iterations++;
+    result.history.push_back(std::sqrt(sums[1]) / b_norm);
+    const double beta = sums[0] / rz;
+    rz = sums[0];
+    ppc::shared_memory::ParallelForBlocks(n, backend, [&](std::size_t begin, std::size_t end) {
+      for (std::size_t i = begin; i < end; i++) {
+        p[i] = z[i] + (beta * p[i]);
+      }
+    });
+  }
+}
+
+void SolvePipelined(Context &ctx, std::span<const double> b, Result &result, double b_norm) {
+  const std::size_t n = ctx.n;
+  const Backend backend = ctx.options.backend;
+  std::vector<double> &x = result.x;
+  std::vector<double> r(b.begin(), b.end());
+  std::vector<double> u(n);
+  std::vector<double> w(n);
+  std::vector<double> m(n);
+  std::vector<double> nv(n);
+  std::vector<double> p(n);
+  std::vector<double> q(n);
+  std::vector<double> s(n);
+  std::vector<double> z(n);
+  ctx.Precondition(r, u);
+  (void)ctx.a.Apply(ctx.assembler.Full(u), w, backend);
+  if (ctx.Fusable()) {
+    ctx.Precondition(w, m);
+  }
+  // gamma = (r, u), delta = (w, u), rr = (r, r) of the current iterate.
+  auto sums = BlockSums<3>(n, backend, [&](std::size_t begin, std::size_t end, std::array<double, 3> &acc) {
+    for (std::size_t i = begin; i < end; i++) {
+      acc[0] += r[i] * u[i];
+      acc[1] += w[i] * u[i];
+      acc[2] += r[i] * r[i];
+    }
+  });
+
+  double gamma_old = 0.0;
+  double alpha_old = 0.0;
+  while (true) {
+    MPI_Request request = MPI_REQUEST_NULL;
+    if (ctx.comm != MPI_COMM_NULL) {
+      MPI_Iallreduce(MPI_IN_PLACE, sums.data(), 3, MPI_DOUBLE, MPI_SUM, ctx.comm, &request);
+    }
+    // Overlapped with the reduction: m = M^{-1} w (unless fused below) and n = A m.
+    if (!ctx.Fusable()) {
+      ctx.Precondition(w, m);
+    }
+    (void)ctx.a.Apply(ctx.assembler.Full(m), nv, backend);
+    MPI_Wait(&request, MPI_STATUS_IGNORE);
+
+    const double gamma = sums[0];
+    const double delta = sums[1];
+    result.history.push_back(std::sqrt(sums[2]) / b_norm);
+    if (result.history.back() <= ctx.options.tolerance || result.iterations >= ctx.options.max_iterations) {
+      break;
+    }
+    const double beta = result.iterations == 0 ? 0.0 : gamma / gamma_old;
+    const double alpha = result.iterations == 0 ? gamma / delta : gamma / (delta - (beta * gamma / alpha_old));
+    // One pass: the eight recurrences, the diagonal preconditioner of the next m and the next dots.
+    sums = BlockSums<3>(n, backend, [&](std::size_t begin, std::size_t end, std::array<double, 3> &acc) {
+      for (std::size_t i = begin; i < end; i++) {
+        z[i] = nv[i] + (beta * z[i]);
+        q[i] = m[i] + (beta * q[i]);
+        s[i] = w[i] + (beta * s[i]);
+        p[i] = u[i] + (beta * p[i]);
+        x[i] += alpha * p[i];
+        r[i] -= alpha * s[i];
+        u[i] -= alpha * q[i];
+        w[i] -= alpha * z[i];
+        m[i] = ctx.Scale(i) * w[i];
+        acc[0] += r[i] * u[i];
+        acc[1] += w[i] * u[i];
+        acc[2] += r[i] * r[i];
+      }
+    });
+    gamma_old = gamma;
+    alpha_old = alpha;
+    result.iterations++;
+  }
+}
+
+}  // namespace
+
+DenseOperator::DenseOperator(std::size_t rows, std::size_t cols, std::vector<double> values, std::size_t row_offset)
+    : rows_(rows), cols_(cols), row_offset_(row_offset), values_(std::move(values)) {
+  if (values_.size() != rows * cols || row_offset + rows > cols) {
+    throw std::invalid_argument("cg: dense strip does not match its shape");
+  }
+}
+
+double DenseOperator::Apply(std::span<const double> x, std::span<double> y, Backend backend) const {
+  return BlockSums<1>(rows_, backend, [&](std::size_t begin, std::size_t end, std::array<double, 1> &acc) {
+    for (std::size_t i = begin; i < end; i++) {
+      const double *row = values_.data() + (i * cols_);
+      double sum = 0.0;
+      for (std::size_t j = 0; j < cols_; j++) {
+        sum += row[j] * x[j];
+      }
+      y[i] = sum;
+      acc[0] += x[row_offset_ + i] * sum;
+    }
+  })[0];
+}
+
+std::vector<double> DenseOperator::Diagonal() const {
+  std::vector<double> diagonal(rows_);
+  for (std::size_t i = 0; i < rows_; i++) {
+    diagonal[i] = values_[(i * cols_) + row_offset_ + i];
+  }
+  return diagonal;
+}
+
+ppc::sparse::Crs<double> DenseOperator::DiagonalBlock() const {
+  ppc::sparse::Crs<double> block{.rows = rows_, .cols = rows_, .values = {}, .col_indices = {}, .row_ptr = {0}};
+  for (std::size_t i = 0; i < rows_; i++) {
+    for (std::size_t j = 0; j < rows_; j++) {
+      const double value = values_[(i * cols_) + row_offset_ + j];
+      if (value != 0.0) {
+        block.col_indices.push_back(j);
+        block.values.push_back(value);
+      }
+    }
+    block.row_ptr.push_back(block.values.size());
+  }
+  return block;
+}
+
+CrsOperator::CrsOperator(ppc::sparse::Crs<double> strip, std::size_t row_offset)
+    : strip_(std::move(strip)), row_offset_(row_offset) {
+  if (!ppc::sparse::IsValid(strip_) || row_offset + strip_.rows > strip_.cols) {
+    throw std::invalid_argument("cg: Crs strip is malformed or does not fit its offset");
+  }
+}
+
+double CrsOperator::Apply(std::span<const double> x, std::span<double> y, Backend backend) const {
+  return BlockSums<1>(strip_.rows, backend, [&](std::size_t begin, std::size_t end, std::array<double, 1> &acc) {
+    for (std::size_t i = begin; i < end; i++) {
+      double sum = 0.0;
+      for (std::size_t e = strip_.row_ptr[i]; e < strip_.row_ptr[i + 1]; e++) {
+        sum += strip_.values[e] * x[strip_.col_indices[e]];
+      }
+      y[i] = sum;
+      acc[0] += x[row_offset_ + i] * sum;
+    }
+  })[0];
+}
+
+std::vector<double> CrsOperator::Diagonal() const {
+  std::vector<double> diagonal(strip_.rows);
+  for (std::size_t i = 0; i < strip_.rows; i++) {
+    for (std::size_t e = strip_.row_ptr[i]; e < strip_.row_ptr[i + 1]; e++) {
+      if (strip_.col_indices[e] == row_offset_ + i) {
+        diagonal[i] = strip_.values[e];
+      }
+    }
+  }
+  return diagonal;
+}
+
+ppc::sparse::Crs<double> CrsOperator::DiagonalBlock() const {
+  ppc::sparse::Crs<double> block{
+      .rows = strip_.rows, .cols = strip_.rows, .values = {}, .col_indices = {}, .row_ptr = {0}};
+  for (std::size_t i = 0; i < strip_.rows; i++) {
+    for (std::size_t e = strip_.row_ptr[i]; e < strip_.row_ptr[i + 1]; e++) {
+      const std::size_t col = strip_.col_indices[e];
+      if (col >= row_offset_ && col < row_offset_ + strip_.rows) {
+        block.col_indices.push_back(col - row_offset_);
+        block.values.push_back(strip_.values[e]);
+      }
+    }
+    block.row_ptr.push_back(block.values.size());
+  }
+  return block;
+}
+
+std::unique_ptr<Operator> MakeStrip(const DenseMatrix &a, std::size_t begin, std::size_t end) {
+  if (begin > end || end > a.n || a.values.size() != a.n * a.n) {
+    throw std::invalid_argument("cg: row range does not fit the dense matrix");
+  }
+  std::vector<double> values(a.values.begin() + static_cast<std::ptrdiff_t>(begin * a.n),
+                             a.values.begin() + static_cast<std::ptrdiff_t>(end * a.n));
+  return std::make_unique<DenseOperator>(end - begin, a.n, std::move(values), begin);
+}
+
+std::unique_ptr<Operator> MakeStrip(const ppc::sparse::Crs<double> &a, std::size_t begin, std::size_t end) {
+  if (a.rows != a.cols) {
+    throw std::invalid_argument("cg: the Crs matrix is not square");
+  }
+  return std::make_unique<CrsOperator>(ppc::sparse::SliceRows(a, begin, end), begin);
+}
+
+std::string VariantToString(Variant variant) {
+  switch (variant) {
+    case Variant::kClassic:
+      return "classic";
+    case Variant::kPipelined:
+      return "pipelined";
+  }
+  return "unknown";
+}
+
+std::string PreconditionerToString(Preconditioner preconditioner) {
+  switch (preconditioner) {
+    case Preconditioner::kNone:
+      return "none";
+    case Preconditioner::kJacobi:
+      return "jacobi";
+    case Preconditioner::kIncompleteCholesky:
+      return "ic0";
+  }
+  return "unknown";
+}
+
+Result Solve(const Operator &a, std::span<const double> b_local, const Options &options, MPI_Comm comm) {
+  if (b_local.size() != a.Rows()) {
+    throw std::invalid_argument("cg: b does not match the rows of the operator");
+  }
+  Context ctx{.a = a,
+              .options = options,
+              .comm = comm,
+              .n = a.Rows(),
+              .assembler = Assembler(a, comm),
+              .inverse_diagonal = {},
+              .ic = nullptr};
+  if (options.preconditioner == Preconditioner::kJacobi) {
+    ctx.inverse_diagonal = a.Diagonal();
+    for (auto &d : ctx.inverse_diagonal) {
+      d = d != 0.0 ? 1.0 / d : 1.0;
+    }
+  } else if (options.preconditioner == Preconditioner::kIncompleteCholesky) {
+    ctx.ic = std::make_unique<IncompleteCholesky>(a.DiagonalBlock());
+    // Every rank factors its own block; they throw together, or the others would wait in the
+    // first reduction.
+    std::array<double, 1> failed = {ctx.ic->Failure().empty() ? 0.0 : 1.0};
+    Allreduce(failed, comm);
+    if (failed[0] != 0.0) {
+      throw std::invalid_argument(ctx.ic->Failure().empty() ? "cg: IC(0) failed on another rank" : ctx.ic->Failure());
+    }
+  }
+
+  Result result;
+  result.x.assign(a.Rows(), 0.0);
+  std::array<double, 1> bb = {0.0};
+  for (const double v : b_local) {
+    bb[0] += v * v;
+  }
+  Allreduce(bb, comm);
+  if (bb[0] == 0.0) {
+    result.converged = true;
+    result.history = {0.0};
+    return result;
+  }
+  const auto start = std::chrono::steady_clock::now();
+  if (options.variant == Variant::kClassic) {
+    SolveClassic(ctx, b_local, result, std::sqrt(bb[0]));
+  } else {
+    SolvePipelined(ctx, b_local, result, std::sqrt(bb[0]));
+  }
+  result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+  result.converged = result.history.back() <= options.tolerance;
+  return result;
+}
+
+}  // namespace ppc::cg
@@ -0,0 +1,250 @@
+#include <gtest/gtest.h>
+#include <mpi.h>
+
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+#include "cg/include/cg.hpp"
+#include "cg/include/cg_task.hpp"
+#include "shared_memory/include/parallel_for.hpp"
+#include "shared_memory/include/shared_memory.hpp"
+#include "sparse/include/sparse.hpp"
+#include "task/include/task.hpp"
+#include "util/include/func_test_util.hpp"
+
+using ppc::cg::Backend;
+using ppc::cg::Preconditioner;
+using ppc::cg::Variant;
+using ppc::sparse::Crs;
+using ppc::task::TypeOfTask;
+
+namespace {
+
+constexpr std::array<Backend, 4> kAllBackends = {Backend::kSeq, Backend::kOmp, Backend::kTbb, Backend::kStl};
+constexpr std::array<Preconditioner, 3> kAllPreconditioners = {Preconditioner::kNone, Preconditioner::kJacobi,
+                                                               Preconditioner::kIncompleteCholesky};
+
+/// Five-point Laplacian on a k x k grid with Dirichlet boundaries.
+Crs<double> Poisson2D(std::size_t k) {
+  std::vector<ppc::sparse::Triplet<double>> entries;
+  for (std::size_t i = 0; i < k; i++) {
+    for (std::size_t j = 0; j < k; j++) {
+      const std::size_t row = (i * k) + j;
+      entries.push_back({.row = row, .col = row, .value = 4.0});
+      if (i > 0) {
+        entries.push_back({.row = row, .col = row - k, .value = -1.0});
+      }
+      if (i + 1 < k) {
+        entries.push_back({.row = row, .col = row + k, .value = -1.0});
+      }
+      if (j > 0) {
+        entries.push_back({.row = row, .col = row - 1, .value = -1.0});
+      }
+      if (j + 1 < k) {
+        entries.push_back({.row = row, .col = row + 1, .value = -1.0});
+      }
+    }
+  }
+  return ppc::sparse::FromTriplets<double>(k * k, k * k, entries);
+}
+
+/// B^T B + n I for a random B: dense and well conditioned.
+ppc::cg::DenseMatrix RandomSpd(std::size_t n, unsigned seed) {
+  std::mt19937_64 gen(seed);
+  std::uniform_real_distribution<double> value(-1.0, 1.0);
+  std::vector<double> b(n * n);
+  for (auto &entry : b) {
+    entry = value(gen);
+  }
+  ppc::cg::DenseMatrix a{.n = n, .values = std::vector<double>(n * n)};
+  for (std::size_t i = 0; i < n; i++) {
+    for (std::size_t j = 0; j < n; j++) {
+      double sum = i == j ? static_cast<double>(n) : 0.0;
+      for (std::size_t l = 0; l < n; l++) {
+        sum += b[(l * n) + i] * b[(l * n) + j];
+      }
+      a.values[(i * n) + j] = sum;
+    }
+  }
+  return a;
+}
+
+/// Right-hand side whose exact solution is x_i = sin(i).
+std::vector<double> RhsOf(const Crs<double> &a) {
+  std::vector<double> x(a.cols);
+  for (std::size_t i = 0; i < x.size(); i++) {
+    x[i] = std::sin(static_cast<double>(i));
+  }
+  return ppc::sparse::SpMV(a, x);
+}
+
+void ExpectSolves(const std::vector<double> &x, std::size_t offset, double tolerance) {
+  for (std::size_t i = 0; i < x.size(); i++) {
+    ASSERT_NEAR(x[i], std::sin(static_cast<double>(offset + i)), tolerance) << "at " << offset + i;
+  }
+}
+
+}  // namespace
+
+TEST(Cg, EveryVariantPreconditionerAndBackendSolvesPoisson) {
+  const auto a = Poisson2D(12);
+  const auto b = RhsOf(a);
+  const ppc::cg::CrsOperator op(a);
+  for (const Variant variant : {Variant::kClassic, Variant::kPipelined}) {
+    for (const Preconditioner preconditioner : kAllPreconditioners) {
+      for (const Backend backend : kAllBackends) {
+        const auto result = ppc::cg::Solve(op, b,
+                                           {.variant = variant,
+                                            .preconditioner = preconditioner,
+                                            .tolerance = 1e-10,
+                                            .max_iterations = 500,
+                                            .backend = backend});
+        SCOPED_TRACE(ppc::cg::VariantToString(variant) + "/" + ppc::cg::PreconditionerToString(preconditioner) +
+                     "/" + ppc::shared_memory::BackendToString(backend));
+        ASSERT_TRUE(result.converged);
+        ASSERT_EQ(result.history.size(), result.iterations + 1);
+        EXPECT_DOUBLE_EQ(result.history.front(), 1.0);
+        EXPECT_LE(result.history.back(), 1e-10);
+        ExpectSolves(result.x, 0, 1e-8);
+      }
+    }
+  }
+}
+
+TEST(Cg, DenseOperatorFusesTheDotProductAndSolves) {
+  const auto a = RandomSpd(40, 1);
+  const ppc::cg::DenseOperator op(a.n, a.n, a.values);
+  std::vector<double> x(a.n);
+  std::vector<double> expected_b(a.n);
+  double expected_dot = 0.0;
+  for (std::size_t i = 0; i < a.n; i++) {
+    x[i] = std::sin(static_cast<double>(i));
+  }
+  for (std::size_t i = 0; i < a.n; i++) {
+    for (std::size_t j = 0; j < a.n; j++) {
+      expected_b[i] += a.values[(i * a.n) + j] * x[j];
+    }
+    expected_dot += x[i] * expected_b[i];
+  }
+  std::vector<double> b(a.n);
+  EXPECT_NEAR(op.Apply(x, b, Backend::kTbb), expected_dot, 1e-9 * std::abs(expected_dot));
+
+  for (const Variant variant : {Variant::kClassic, Variant::kPipelined}) {
+    const auto result =
+        ppc::cg::Solve(op, b, {.variant = variant, .preconditioner = Preconditioner::kIncompleteCholesky});
+    ASSERT_TRUE(result.converged);
+    ExpectSolves(result.x, 0, 1e-7);
+  }
+}
+
+TEST(Cg, IncompleteCholeskyNeedsFewerIterationsThanJacobi) {
+  const auto a = Poisson2D(32);
+  const auto b = RhsOf(a);
+  const ppc::cg::CrsOperator op(a);
+  const auto jacobi = ppc::cg::Solve(op, b, {.preconditioner = Preconditioner::kJacobi});
+  const auto ic = ppc::cg::Solve(op, b, {.preconditioner = Preconditioner::kIncompleteCholesky});
+  ASSERT_TRUE(jacobi.converged);
+  ASSERT_TRUE(ic.converged);
+  EXPECT_LT(2 * ic.iterations, 3 * jacobi.iterations / 2);
+}
+
+TEST(Cg, RejectsMalformedInput) {
+  const auto a = Poisson2D(4);
+  const ppc::cg::CrsOperator op(a);
+  EXPECT_THROW((void)ppc::cg::Solve(op, std::vector<double>(15)), std::invalid_argument);
+
+  const auto strip = ppc::cg::MakeStrip(a, 4, 8);
+  EXPECT_THROW((void)ppc::cg::Solve(*strip, std::vector<double>(4)), std::invalid_argument);
+  EXPECT_THROW((void)ppc::cg::MakeStrip(a, 8, 17), std::invalid_argument);
+
+  auto indefinite = a;
+  indefinite.values[0] = -4.0;
+  EXPECT_THROW((void)ppc::cg::Solve(ppc::cg::CrsOperator(indefinite), std::vector<double>(16, 1.0),
+                                    {.preconditioner = Preconditioner::kIncompleteCholesky}),
+               std::invalid_argument);
+}
+
+TEST(Cg, DistributedStripsMatchTheSharedMemorySolve) {
+  if (!ppc::util::MpiReady()) {
+    GTEST_SKIP() << "MPI is not initialized";
+  }
+  int rank = 0;
+  int size = 1;
+  MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+  MPI_Comm_size(MPI_COMM_WORLD, &size);
+  const auto a = Poisson2D(15);
+  const auto b = RhsOf(a);
+  const auto [begin, end] = ppc::shared_memory::BlockRange(a.rows, size, rank);
+  const auto strip = ppc::cg::MakeStrip(a, begin, end);
+  const std::vector<double> b_local(b.begin() + static_cast<std::ptrdiff_t>(begin),
+                                    b.begin() + static_cast<std::ptrdiff_t>(end));
+  for (const Variant variant : {Variant::kClassic, Variant::kPipelined}) {
+    for (const Preconditioner preconditioner : kAllPreconditioners) {
+      const ppc::cg::Options options{.variant = variant, .preconditioner = preconditioner, .tolerance = 1e-10};
+      const auto result = ppc::cg::Solve(*strip, b_local, options, MPI_COMM_WORLD);
+      ASSERT_TRUE(result.converged);
+      ASSERT_EQ(result.x.size(), end - begin);
+      ExpectSolves(result.x, begin, 1e-8);
+      if (preconditioner != Preconditioner::kIncompleteCholesky) {
+        // Block IC(0) depends on the strips; the other preconditioners give the shared-memory iterates.
+        const auto whole = ppc::cg::Solve(ppc::cg::CrsOperator(a), b, options);
+        EXPECT_EQ(result.iterations, whole.iterations);
+      }
+    }
+  }
+}
+
+TEST(Cg, DistributedIncompleteCholeskyBreakdownThrowsOnEveryRank) {
+  if (!ppc::util::MpiReady()) {
+    GTEST_SKIP() << "MPI is not initialized";
+  }
+  int rank = 0;
+  int size = 1;
+  MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+  MPI_Comm_size(MPI_COMM_WORLD, &size);
+  auto a = Poisson2D(15);
+  // Only the strip of the last rank holds the negative pivot; the last entry of a row is its diagonal.
+  a.values[a.row_ptr[a.rows] - 1] = -4.0;
+  const auto [begin, end] = ppc::shared_memory::BlockRange(a.rows, size, rank);
+  const auto strip = ppc::cg::MakeStrip(a, begin, end);
+  const std::vector<double> b_local(end - begin, 1.0);
+  EXPECT_THROW((void)ppc::cg::Solve(*strip, b_local, {.preconditioner = Preconditioner::kIncompleteCholesky},
+                                    MPI_COMM_WORLD),
+               std::invalid_argument);
+}
+
+template <typename M, TypeOfTask kType, Variant kVariant>
+void RunCgTask(const M &a, const std::vector<double> &b, const std::vector<double> &expected) {
+  ppc::cg::CgTask<M, kType, kVariant> task({.a = a, .b = b}, 1e-10);
+  ASSERT_TRUE(task.Validation());
+  ASSERT_TRUE(task.PreProcessing());
+  ASSERT_TRUE(task.Run());
+  ASSERT_TRUE(task.PostProcessing());
+  ASSERT_TRUE(task.GetOutput().converged);
+  ASSERT_EQ(task.GetOutput().x.size(), expected.size());
+  for (std::size_t i = 0; i < expected.size(); i++) {
+    ASSERT_NEAR(task.GetOutput().x[i], expected[i], 1e-7) << "at " << i;
+  }
+}
+
+TEST(Cg, TasksSolveSparseAndDenseSystems) {
+  const auto sparse = Poisson2D(10);
+  const auto sparse_b = RhsOf(sparse);
+  std::vector<double> expected(sparse.rows);
+  for (std::size_t i = 0; i < expected.size(); i++) {
+    expected[i] = std::sin(static_cast<double>(i));
+  }
+  const ppc::cg::DenseMatrix dense{.n = sparse.rows, .values = ppc::sparse::ToDense(sparse)};
+
+  RunCgTask<Crs<double>, TypeOfTask::kOMP, Variant::kClassic>(sparse, sparse_b, expected);
+  RunCgTask<Crs<double>, TypeOfTask::kTBB, Variant::kPipelined>(sparse, sparse_b, expected);
+  RunCgTask<ppc::cg::DenseMatrix, TypeOfTask::kSTL, Variant::kPipelined>(dense, sparse_b, expected);
+  if (ppc::util::MpiReady()) {
+    RunCgTask<Crs<double>, TypeOfTask::kMPI, Variant::kPipelined>(sparse, sparse_b, expected);
+    RunCgTask<ppc::cg::DenseMatrix, TypeOfTask::kMPI, Variant::kClassic>(dense, sparse_b, expected);
+  }
+}
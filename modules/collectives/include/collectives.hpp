@@ -0,0 +1,99 @@
+#pragma once
+
+#include <mpi.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+
+namespace ppc::collectives {
+
+/// @brief Point-to-point algorithm used to implement a collective.
+enum class Algorithm : uint8_t {
+  /// Pick by message size and communicator size (see Tuning)
+  kAuto,
+  /// Binomial tree: log2(p) rounds, whole message per round
+  kBinomialTree,
+  /// Chain of ranks forwarding fixed-size segments as soon as they arrive
+  kPipelinedChain,
+  /// Pairwise exchange with partner rank ^ 2^k
+  kRecursiveDoubling,
+  /// Reduce-scatter by recursive halving followed by allgather by recursive doubling
+  kRabenseifner,
+  /// Reduce-scatter and allgather around a ring: bandwidth-optimal for long messages
+  kRing
+};
+
+/// @brief Returns the lower-case name of the algorithm ("binomial_tree", ...).
+std::string AlgorithmToString(Algorithm algorithm);
+
+/// @brief Message-size switch points used by Algorithm::kAuto.
+struct Tuning {
+  /// Broadcasts of at least this many bytes use the pipelined chain.
+  std::size_t bcast_chain_min_bytes = std::size_t{64} * 1024;
+  /// Segment size of the pipelined chain.
+  std::size_t chain_segment_bytes = std::size_t{16} * 1024;
+  /// Allreduces below this size use recursive doubling.
+  std::size_t allreduce_rabenseifner_min_bytes = std::size_t{2} * 1024;
+  /// Allreduces of at least this size use the ring.
+  std::size_t allreduce_ring_min_bytes = std::size_t{512} * 1024;
+};
+
+/// @brief Returns the tuning shared by all collectives of this module.
+Tuning &GetTuning();
+
+/// @brief Algorithm chosen by kAuto for a broadcast.
+Algorithm SelectBcast(std::size_t bytes, int comm_size);
+
+/// @brief Algorithm chosen by kAuto for an allreduce.
+/// @param commutative Whether the reduction operator is commutative.
+Algorithm SelectAllreduce(std::size_t bytes, int count, int comm_size, bool commutative);
+
+/// @brief Broadcasts @p count elements of @p type from @p root.
+/// @param algorithm kBinomialTree, kPipelinedChain or kAuto.
+/// @throws std::invalid_argument On a bad root, count or algorithm.
+void Bcast(void *buffer, int count, MPI_Datatype type, int root, MPI_Comm comm,
+           Algorithm algorithm = Algorithm::kAuto);
+
+/// @brief Reduces @p count elements onto @p root over a binomial tree.
+/// @details Non-commutative operators are reduced in rank order.
+/// @param recv_buf Result buffer, significant only on @p root.
+void Reduce(const void *send_buf, void *recv_buf, int count, MPI_Datatype type, MPI_Op op, int root, MPI_Comm comm);
+
+/// @brief Reduces @p count elements and leaves the result on every rank.
+/// @param algorithm kRecursiveDoubling, kRabenseifner, kRing or kAuto. Rabenseifner and ring
+/// need a commutative operator and at least one element per rank, otherwise recursive
+/// doubling is used.
+void Allreduce(const void *send_buf, void *recv_buf, int count, MPI_Datatype type, MPI_Op op, MPI_Comm comm,
+               Algorithm algorithm = Algorithm::kAuto);
+
+/// @brief Scatters @p count elements to every rank over a binomial tree.
+/// @param send_buf size * count elements ordered by rank, significant only on @p root.
+void Scatter(const void *send_buf, void *recv_buf, int count, MPI_Datatype type, int root, MPI_Comm comm);
+
+/// @brief Gathers @p count elements from every rank over a binomial tree.
+/// @param recv_buf size * count elements ordered by rank, significant only on @p root.
+void Gather(const void *send_buf, void *recv_buf, int count, MPI_Datatype type, int root, MPI_Comm comm);
+
+/// @brief Gathers @p count elements from every rank onto every rank.
+/// @param algorithm kRecursiveDoubling (power-of-two sizes), kRing or kAuto.
+void Allgather(const void *send_buf, void *recv_buf, int count, MPI_Datatype type, MPI_Comm comm,
+               Algorithm algorithm = Algorithm::kAuto);
+
+/// @brief Personalized all-to-all exchange in rounds of at most @p chunk elements per pair of
+/// ranks, which keeps the int counts of MPI in range and bounds the buffers MPI allocates per round.
+/// @details Rank r is sent send_counts[r] elements of @p type from element send_offsets[r] of
+/// @p send_buf and receives recv_counts[r] elements at element recv_offsets[r] of @p recv_buf;
+/// the receive counts must have been exchanged beforehand, e.g. with MPI_Alltoall. Every round
+/// posts one MPI_Isend and MPI_Irecv per peer at the block addresses, so the offsets may exceed
+/// INT_MAX.
+/// @return The number of rounds, the same on every rank.
+/// @throws std::invalid_argument When a span does not hold one entry per rank of @p comm or
+/// @p chunk exceeds INT_MAX.
+std::uint64_t ChunkedAlltoallv(const void *send_buf, std::span<const std::uint64_t> send_counts,
+                               std::span<const std::size_t> send_offsets, void *recv_buf,
+                               std::span<const std::uint64_t> recv_counts, std::span<const std::size_t> recv_offsets,
+                               MPI_Datatype type, std::uint64_t chunk, MPI_Comm comm);
+
+}  // namespace ppc::collectives
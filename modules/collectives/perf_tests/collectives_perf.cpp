@@ -0,0 +1,143 @@
+#include <gtest/gtest.h>
+#include <mpi.h>
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <numeric>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include "collectives/include/collectives.hpp"
+#include "task/include/task.hpp"
+#include "util/include/perf_test_util.hpp"
+
+namespace ppc::collectives::perf {
+
+using InType = std::vector<double>;
+using OutType = double;
+
+enum class Kind : uint8_t { kBcast, kAllreduce };
+
+/// Benchmark task: one collective per Run(); kVendor selects MPI_Bcast/MPI_Allreduce.
+template <Kind kKind, Algorithm kAlgorithm, bool kVendor = false>
+class CollectiveTask : public ppc::task::Task<InType, OutType> {
+ public:
+  static constexpr ppc::task::TypeOfTask GetStaticTypeOfTask() {
+    return ppc::task::TypeOfTask::kMPI;
+  }
+
+  explicit CollectiveTask(const InType &in) {
+    SetTypeOfTask(GetStaticTypeOfTask());
+    GetInput() = in;
+    GetOutput() = 0.0;
+  }
+
+ private:
+  bool ValidationImpl() override {
+    return !GetInput().empty();
+  }
+
+  bool PreProcessingImpl() override {
+    int rank = 0;
+    MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+    buffer_ = (kKind == Kind::kAllreduce || rank == 0) ? GetInput() : InType(GetInput().size(), 0.0);
+    result_.assign(GetInput().size(), 0.0);
+    return true;
+  }
+
+  bool RunImpl() override {
+    const int count = static_cast<int>(buffer_.size());
+    if constexpr (kKind == Kind::kBcast) {
+      if constexpr (kVendor) {
+        MPI_Bcast(buffer_.data(), count, MPI_DOUBLE, 0, MPI_COMM_WORLD);
+      } else {
+        Bcast(buffer_.data(), count, MPI_DOUBLE, 0, MPI_COMM_WORLD, kAlgorithm);
+      }
+    } else {
+      if constexpr (kVendor) {
+        MPI_Allreduce(buffer_.data(), result_.data(), count, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD);
+      } else {
+        Allreduce(buffer_.data(), result_.data(), count, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD, kAlgorithm);
+      }
+    }
+    return true;
+  }
+
+  bool PostProcessingImpl() override {
+    const auto &data = (kKind == Kind::kBcast) ? buffer_ : result_;
+    GetOutput() = std::accumulate(data.begin(), data.end(), 0.0);
+    return true;
+  }
+
+  InType buffer_;
+  InType result_;
+};
+
+template <Kind kKind>
+class CollectivesRunPerfTests : public ppc::util::BaseRunPerfTests<InType, OutType> {
+  static constexpr std::size_t kCount = std::size_t{1} << 20;
+  InType input_data_;
+
+  void SetUp() override {
+    input_data_.resize(kCount);
+    for (std::size_t i = 0; i < kCount; i++) {
+      input_data_[i] = static_cast<double>(i % 7);
+    }
+  }
+
+  bool CheckTestOutputData(OutType &output_data) final {
+    double expected = std::accumulate(input_data_.begin(), input_data_.end(), 0.0);
+    if constexpr (kKind == Kind::kAllreduce) {
+      int size = 1;
+      MPI_Comm_size(MPI_COMM_WORLD, &size);
+      expected *= size;
+    }
+    return std::abs(output_data - expected) <= 1e-9 * expected;
+  }
+
+  InType GetTestInputData() final {
+    return input_data_;
+  }
+};
+
+template <typename TaskType>
+auto MakeCollectivePerfTasks(const std::string &name) {
+  // "_mpi_" in the name lets scripts/run_tests.py pick the case up in its MPI pass.
+  const std::string test_name = "ppc_collectives_mpi_" + name;
+  return ppc::util::MakeNamedPerfTaskTuples<TaskType, InType>(test_name);
+}
+
+using BcastPerfTests = CollectivesRunPerfTests<Kind::kBcast>;
+using AllreducePerfTests = CollectivesRunPerfTests<Kind::kAllreduce>;
+
+TEST_P(BcastPerfTests, RunPerfModes) {
+  ExecuteTest(GetParam());
+}
+
+TEST_P(AllreducePerfTests, RunPerfModes) {
+  ExecuteTest(GetParam());
+}
+
+const auto kBcastPerfTasks = std::tuple_cat(
+    MakeCollectivePerfTasks<CollectiveTask<Kind::kBcast, Algorithm::kAuto, true>>("bcast_vendor"),
+    MakeCollectivePerfTasks<CollectiveTask<Kind::kBcast, Algorithm::kAuto>>("bcast_auto"),
+    MakeCollectivePerfTasks<CollectiveTask<Kind::kBcast, Algorithm::kBinomialTree>>("bcast_binomial_tree"),
+    MakeCollectivePerfTasks<CollectiveTask<Kind::kBcast, Algorithm::kPipelinedChain>>("bcast_pipelined_chain"));
+
+const auto kAllreducePerfTasks = std::tuple_cat(
+    MakeCollectivePerfTasks<CollectiveTask<Kind::kAllreduce, Algorithm::kAuto, true>>("allreduce_vendor"),
+    MakeCollectivePerfTasks<CollectiveTask<Kind::kAllreduce, Algorithm::kAuto>>("allreduce_auto"),
+    MakeCollectivePerfTasks<CollectiveTask<Kind::kAllreduce, Algorithm::kRecursiveDoubling>>(
+        "allreduce_recursive_doubling"),
+    MakeCollectivePerfTasks<CollectiveTask<Kind::kAllreduce, Algorithm::kRabenseifner>>("allreduce_rabenseifner"),
+    MakeCollectivePerfTasks<CollectiveTask<Kind::kAllreduce, Algorithm::kRing>>("allreduce_ring"));
+
+INSTANTIATE_TEST_SUITE_P(CollectivesBcast, BcastPerfTests, ppc::util::TupleToGTestValues(kBcastPerfTasks),
+                         BcastPerfTests::CustomPerfTestName);
+
+INSTANTIATE_TEST_SUITE_P(CollectivesAllreduce, AllreducePerfTests, ppc::util::TupleToGTestValues(kAllreducePerfTasks),
+                         AllreducePerfTests::CustomPerfTestName);
+
+}  // namespace ppc::collectives::perf
@@ -0,0 +1,625 @@
+#include "collectives/include/collectives.hpp"
+
+#include <mpi.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace ppc::collectives {
+
+namespace {
+
+constexpr int kTagBcast = 7101;
+constexpr int kTagReduce = 7102;
+constexpr int kTagAllreduce = 7103;
+constexpr int kTagScatter = 7104;
+constexpr int kTagGather = 7105;
+constexpr int kTagAllgather = 7106;
+constexpr int kTagAlltoallv = 7107;
+
+using Bytes = std::vector<unsigned char>;
+
+struct CommInfo {
+  int rank = 0;
+  int size = 1;
+};
+
+CommInfo GetCommInfo(MPI_Comm comm) {
+  CommInfo info;
+  MPI_Comm_rank(comm, &info.rank);
+  MPI_Comm_size(comm, &info.size);
+  return info;
+}
+
+std::size_t Extent(MPI_Datatype type) {
+  MPI_Aint lb = 0;
+  MPI_Aint extent = 0;
+  MPI_Type_get_extent(type, &lb, &extent);
+  return static_cast<std::size_t>(extent);
+}
+
+std::size_t PayloadBytes(int count, MPI_Datatype type) {
+  int type_size = 0;
+  MPI_Type_size(type, &type_size);
+  return static_cast<std::size_t>(count) * static_cast<std::size_t>(type_size);
+}
+
+unsigned char *At(void *base, std::size_t extent, std::size_t index) {
+  return static_cast<unsigned char *>(base) + (index * extent);
+}
+
+const unsigned char *At(const void *base, std::size_t extent, std::size_t index) {
+  return static_cast<const unsigned char *>(base) + (index * extent);
+}
+
+bool IsCommutative(MPI_Op op) {
+  int commute = 0;
+  MPI_Op_commutative(op, &commute);
+  return commute != 0;
+}
+
+int LargestPowerOfTwo(int n) {
+  int pof2 = 1;
+  while (pof2 * 2 <= n) {
+    pof2 *= 2;
+  }
+  return pof2;
+}
+
+void CheckArguments(int count, int root, const CommInfo &info) {
+  if (count < 0) {
+    throw std::invalid_argument("collectives: negative element count");
+  }
+  if (root < 0 || root >= info.size) {
+    throw std::invalid_argument("collectives: root " + std::to_string(root) + " is out of range");
+  }
+}
+
+/// Splits @p count elements into @p parts blocks; first count % parts blocks get one more.
+void SplitBlocks(int count, int parts, std::vector<int> &counts, std::vector<int> &displs) {
+  counts.assign(static_cast<std::size_t>(parts), count / parts);
+  displs.assign(static_cast<std::size_t>(parts), 0);
+  for (int i = 0; i < count % parts; i++) {
+    counts[static_cast<std::size_t>(i)]++;
+  }
+  for (std::size_t i = 1; i < counts.size(); i++) {
+    displs[i] = displs[i - 1] + counts[i - 1];
+  }
+}
+
+int SumRange(const std::vector<int> &counts, int first, int last) {
+  int sum = 0;
+  for (int i = first; i < last; i++) {
+    sum += counts[static_cast<std::size_t>(i)];
+  }
+  return sum;
+}
+
+void BcastBinomial(void *buffer, int count, MPI_Datatype type, int root, MPI_Comm comm, const CommInfo &info) {
+  const int vrank = (info.rank - root + info.size) % info.size;
+  int mask = 1;
+  while (mask < info.size) {
+    if ((vrank & mask) != 0) {
+      MPI_Recv(buffer, count, type, (vrank - mask + root) % info.size, kTagBcast, comm, MPI_STATUS_IGNORE);
+      break;
+    }
+    mask <<= 1;
+  }
+  mask >>= 1;
+  while (mask > 0) {
+    if (vrank + mask < info.size) {
+      MPI_Send(buffer, count, type, (vrank + mask + root) % info.size, kTagBcast, comm);
+    }
+    mask >>= 1;
+  }
+}
+
+void BcastChain(void *buffer, int count, MPI_Datatype type, int root, MPI_Comm comm, const CommInfo &info) {
+  const int vrank = (info.rank - root + info.size) % info.size;
+  const int prev = vrank > 0 ? (info.rank - 1 + info.size) % info.size : MPI_PROC_NULL;
+  const int next = vrank < info.size - 1 ? (info.rank + 1) % info.size : MPI_PROC_NULL;
+
+  const std::size_t extent = Extent(type);
+  const std::size_t element_bytes = std::max<std::size_t>(PayloadBytes(1, type), 1);
+  const int segment = static_cast<int>(std::max<std::size_t>(GetTuning().chain_segment_bytes / element_bytes, 1));
+
+  std::vector<MPI_Request> requests;
+  requests.reserve(static_cast<std::size_t>((count / segment) + 1));
+  for (int offset = 0; offset < count; offset += segment) {
+    const int len = std::min(segment, count - offset);
+    auto *chunk = At(buffer, extent, static_cast<std::size_t>(offset));
+    MPI_Recv(chunk, len, type, prev, kTagBcast, comm, MPI_STATUS_IGNORE);
+    if (next != MPI_PROC_NULL) {
+      requests.emplace_back();
+      MPI_Isend(chunk, len, type, next, kTagBcast, comm, &requests.back());
+    }
+  }
+  MPI_Waitall(static_cast<int>(requests.size()), requests.data(), MPI_STATUSES_IGNORE);
+}
+
+/// Folds ranks beyond the largest power of two into their even neighbours.
+/// @return Rank inside the power-of-two group, or -1 for ranks that sit out.
+int FoldIn(void *recv_buf, void *tmp, int count, MPI_Datatype type, MPI_Op op, int rem, MPI_Comm comm,
+           const CommInfo &info) {
+  if (info.rank >= 2 * rem) {
+    return info.rank - rem;
+  }
+  if (info.rank % 2 == 0) {
+    MPI_Send(recv_buf, count, type, info.rank + 1, kTagAllreduce, comm);
+    return -1;
+  }
+  MPI_Recv(tmp, count, type, info.rank - 1, kTagAllreduce, comm, MPI_STATUS_IGNORE);
+  MPI_Reduce_local(tmp, recv_buf, count, type, op);
+  return info.rank / 2;
+}
+
+void FoldOut(void *recv_buf, int count, MPI_Datatype type, int rem, MPI_Comm comm, const CommInfo &info) {
+  if (info.rank >= 2 * rem) {
+    return;
+  }
+  if (info.rank % 2 == 0) {
+    MPI_Recv(recv_buf, count, type, info.rank + 1, kTagAllreduce, comm, MPI_STATUS_IGNORE);
+  } else {
+    MPI_Send(recv_buf, count, type, info.rank - 1, kTagAllreduce, comm);
+  }
+}
+
+int RealRank(int new_rank, int rem) {
+  return new_rank < rem ? (new_rank * 2) + 1 : new_rank + rem;
+}
+
+void AllreduceRecursiveDoubling(void *recv_buf, int count, MPI_Datatype type, MPI_Op op, MPI_Comm comm,
+                                const CommInfo &info) {
+  const std::size_t extent = Extent(type);
+  const std::size_t bytes = static_cast<std::size_t>(count) * extent;
+  Bytes tmp(bytes);
+  const int pof2 = LargestPowerOfTwo(info.size);
+  const int rem = info.size - pof2;
+
+  const int new_rank = FoldIn(recv_buf, tmp.data(), count, type, op, rem, comm, info);
+  if (new_rank >= 0) {
+    for (int mask = 1; mask < pof2; mask <<= 1) {
+      const int dst = RealRank(new_rank ^ mask, rem);
+      MPI_Sendrecv(recv_buf, count, type, dst, kTagAllreduce, tmp.data(), count, type, dst, kTagAllreduce, comm,
+                   MPI_STATUS_IGNORE);
+      // Keep lower ranks on the left so non-commutative operators stay in rank order.
+      if (dst < info.rank) {
+        MPI_Reduce_local(tmp.data(), recv_buf, count, type, op);
+      } else {
+        MPI_Reduce_local(recv_buf, tmp.data(), count, type, op);
+        std::memcpy(recv_buf, tmp.data(), bytes);
+      }
+    }
+  }
+  FoldOut(recv_buf, count, type, rem, comm, info);
+}
+
+void AllreduceRabenseifner(void *recv_buf, int count, MPI_Datatype type, MPI_Op op, MPI_Comm comm,
+                           const CommInfo &info) {
+  const std::size_t extent = Extent(type);
+  Bytes tmp(static_cast<std::size_t>(count) * extent);
+  const int pof2 = LargestPowerOfTwo(info.size);
+  const int rem = info.size - pof2;
+
+  const int new_rank = FoldIn(recv_buf, tmp.data(), count, type, op, rem, comm, info);
+  if (new_rank >= 0) {
+    std::vector<int> counts;
+    std::vector<int> displs;
+    SplitBlocks(count, pof2, counts, displs);
+    auto disp = [&](int block) { return static_cast<std::size_t>(displs[static_cast<std::size_t>(block)]); };
+
+    // Reduce-scatter by recursive halving: each round keeps half of the remaining blocks.
+    int send_idx = 0;
+    int recv_idx = 0;
+    int last_idx = pof2;
+    int mask = 1;
+    while (mask < pof2) {
+      const int new_dst = new_rank ^ mask;
+      const int dst = RealRank(new_dst, rem);
+      int send_cnt = 0;
+      int recv_cnt = 0;
+      if (new_rank < new_dst) {
+        send_idx = recv_idx + (pof2 / (mask * 2));
+        send_cnt = SumRange(counts, send_idx, last_idx);
+        recv_cnt = SumRange(counts, recv_idx, send_idx);
+      } else {
+        recv_idx = send_idx + (pof2 / (mask * 2));
+        send_cnt = SumRange(counts, send_idx, recv_idx);
+        recv_cnt = SumRange(counts, recv_idx, last_idx);
+      }
+      MPI_Sendrecv(At(recv_buf, extent, disp(send_idx)), send_cnt, type, dst, kTagAllreduce,
+                   At(tmp.data(), extent, disp(recv_idx)), recv_cnt, type, dst, kTagAllreduce, comm,
+                   MPI_STATUS_IGNORE);
+      MPI_Reduce_local(At(tmp.data(), extent, disp(recv_idx)), At(recv_buf, extent, disp(recv_idx)), recv_cnt, type,
+                       op);
+      send_idx = recv_idx;
+      mask <<= 1;
+      if (mask < pof2) {
+        last_idx = recv_idx + (pof2 / mask);
+      }
+    }
+
+    // Allgather by recursive doubling: the same exchanges in reverse order.
+    mask >>= 1;
+    while (mask > 0) {
+      const int new_dst = new_rank ^ mask;
+      const int dst = RealRank(new_dst, rem);
+      int send_cnt = 0;
+      int recv_cnt = 0;
+      if (new_rank < new_dst) {
+        if (mask != pof2 / 2) {
+          last_idx = last_idx + (pof2 / (mask * 2));
+        }
+        recv_idx = send_idx + (pof2 / (mask * 2));
+        send_cnt = SumRange(counts, send_idx, recv_idx);
+        recv_cnt = SumRange(counts, recv_idx, last_idx);
+      } else {
+        recv_idx = send_idx - (pof2 / (mask * 2));
+        send_cnt = SumRange(counts, send_idx, last_idx);
+        recv_cnt = SumRange(counts, recv_idx, send_idx);
+      }
+      MPI_Sendrecv(At(recv_buf, extent, disp(send_idx)), send_cnt, type, dst, kTagAllreduce,
+                   At(recv_buf, extent, disp(recv_idx)), recv_cnt, type, dst, kTagAllreduce, comm,
+                   MPI_STATUS_IGNORE);
+      if (new_rank > new_dst) {
+        send_idx = recv_idx;
+      }
+      mask >>= 1;
+    }
+  }
+  FoldOut(recv_buf, count, type, rem, comm, info);
+}
+
+void AllreduceRing(void *recv_buf, int count, MPI_Datatype type, MPI_Op op, MPI_Comm comm, const CommInfo &info) {
+  const std::size_t extent = Extent(type);
+  std::vector<int> counts;
+  std::vector<int> displs;
+  SplitBlocks(count, info.size, counts, displs);
+  Bytes tmp(static_cast<std::size_t>(counts[0]) * extent);
+
+  const int left = (info.rank - 1 + info.size) % info.size;
+  const int right = (info.rank + 1) % info.size;
+  auto block_ptr = [&](int block) {
+    return At(recv_buf, extent, static_cast<std::size_t>(displs[static_cast<std::size_t>(block)]));
+  };
+  auto block_count = [&](int block) { return counts[static_cast<std::size_t>(block)]; };
+
+  for (int step = 0; step < info.size - 1; step++) {
+    const int send_block = (info.rank - step + info.size) % info.size;
+    const int recv_block = (info.rank - step - 1 + (2 * info.size)) % info.size;
+    MPI_Sendrecv(block_ptr(send_block), block_count(send_block), type, right, kTagAllreduce, tmp.data(),
+                 block_count(recv_block), type, left, kTagAllreduce, comm, MPI_STATUS_IGNORE);
+    MPI_Reduce_local(tmp.data(), block_ptr(recv_block), block_count(recv_block), type, op);
+  }
+  for (int step = 0; step < info.size - 1; step++) {
+    const int send_block = (info.rank + 1 - step + info.size) % info.size;
+    const int recv_block = (info.rank - step + info.size) % info.size;
+    MPI_Sendrecv(block_ptr(send_block), block_count(send_block), type, right, kTagAllreduce, block_ptr(recv_block),
+                 block_count(recv_block), type, left, kTagAllreduce, comm, MPI_STATUS_IGNORE);
+  }
+}
+
+void AllgatherRing(void *recv_buf, int count, MPI_Datatype type, MPI_Comm comm, const CommInfo &info) {
+  const std::size_t block_bytes = static_cast<std::size_t>(count) * Extent(type);
+  const int left = (info.rank - 1 + info.size) % info.size;
+  const int right = (info.rank + 1) % info.size;
+  for (int step = 0; step < info.size - 1; step++) {
+    const auto send_block = static_cast<std::size_t>((info.rank - step + info.size) % info.size);
+    const auto recv_block = static_cast<std::size_t>((info.rank - step - 1 + (2 * info.size)) % info.size);
+    MPI_Sendrecv(At(recv_buf, block_bytes, send_block), count, type, right, kTagAllgather,
+                 At(recv_buf, block_bytes, recv_block), count, type, left, kTagAllgather, comm, MPI_STATUS_IGNORE);
+  }
+}
+
+void AllgatherRecursiveDoubling(void *recv_buf, int count, MPI_Datatype type, MPI_Comm comm, const CommInfo &info) {
+  const std::size_t block_bytes = static_cast<std::size_t>(count) * Extent(type);
+  for (int mask = 1; mask < info.size; mask <<= 1) {
+    const int dst = info.rank ^ mask;
+    const auto my_first = static_cast<std::size_t>(info.rank & ~(mask - 1));
+    const auto dst_first = static_cast<std::size_t>(dst & ~(mask - 1));
+    MPI_Sendrecv(At(recv_buf, block_bytes, my_first), count * mask, type, dst, kTagAllgather,
+                 At(recv_buf, block_bytes, dst_first), count * mask, type, dst, kTagAllgather, comm,
+                 MPI_STATUS_IGNORE);
+  }
+}
+
+}  // namespace
+
+std::string AlgorithmToString(Algorithm algorithm) {
+  switch (algorithm) {
+    case Algorithm::kAuto:
+      return "auto";
+    case Algorithm::kBinomialTree:
+      return "binomial_tree";
+    case Algorithm::kPipelinedChain:
+      return "pipelined_chain";
+    case Algorithm::kRecursiveDoubling:
+      return "recursive_doubling";
+    case Algorithm::kRabenseifner:
+      return "rabenseifner";
+    case Algorithm::kRing:
+      return "ring";
+  }
+  return "unknown";
+}
+
+Tuning &GetTuning() {
+  static Tuning tuning;
+  return tuning;
+}
+
+Algorithm SelectBcast(std::size_t bytes, int comm_size) {
+  if (comm_size > 2 && bytes >= GetTuning().bcast_chain_min_bytes) {
+    return Algorithm::kPipelinedChain;
+  }
+  return Algorithm::kBinomialTree;
+}
+
+Algorithm SelectAllreduce(std::size_t bytes, int count, int comm_size, bool commutative) {
+  if (!commutative || count < comm_size || bytes < GetTuning().allreduce_rabenseifner_min_bytes) {
+    return Algorithm::kRecursiveDoubling;
+  }
+  if (bytes >= GetTuning().allreduce_ring_min_bytes) {
+    return Algorithm::kRing;
+  }
+  return Algorithm::kRabenseifner;
+}
+
+void Bcast(void *buffer, int count, MPI_Datatype type, int root, MPI_Comm comm, Algorithm algorithm) {
+  const auto info = GetCommInfo(comm);
+  CheckArguments(count, root, info);
+  if (info.size == 1 || count == 0) {
+    return;
+  }
+  if (algorithm == Algorithm::kAuto) {
+    algorithm = SelectBcast(PayloadBytes(count, type), info.size);
+  }
+  switch (algorithm) {
+    case Algorithm::kBinomialTree:
+      BcastBinomial(buffer, count, type, root, comm, info);
+      return;
+    case Algorithm::kPipelinedChain:
+      BcastChain(buffer, count, type, root, comm, info);
+      return;
+    case Algorithm::kAuto:
+    case Algorithm::kRecursiveDoubling:
+    case Algorithm::kRabenseifner:
+    case Algorithm::kRing:
+      break;
+  }
+  throw std::invalid_argument("collectives: Bcast does not support " + AlgorithmToString(algorithm));
+}
+
+void Reduce(const void *send_buf, void *recv_buf, int count, MPI_Datatype type, MPI_Op op, int root,
+            MPI_Comm comm) {
+  const auto info = GetCommInfo(comm);
+  CheckArguments(count, root, info);
+  const std::size_t bytes = static_cast<std::size_t>(count) * Extent(type);
+  const void *input = (send_buf == MPI_IN_PLACE) ? recv_buf : send_buf;
+
+  // Non-commutative operators need contiguous rank ranges, i.e. a tree rooted at rank 0.
+  const int tree_root = IsCommutative(op) ? root : 0;
+  const int vrank = (info.rank - tree_root + info.size) % info.size;
+  Bytes acc(static_cast<const unsigned char *>(input), static_cast<const unsigned char *>(input) + bytes);
+  Bytes tmp(bytes);
+
+  for (int mask = 1; mask < info.size; mask <<= 1) {
+    if ((vrank & mask) != 0) {
+      MPI_Send(acc.data(), count, type, ((vrank & ~mask) + tree_root) % info.size, kTagReduce, comm);
+      break;
+    }
+    const int src = vrank | mask;
+    if (src < info.size) {
+      MPI_Recv(tmp.data(), count, type, (src + tree_root) % info.size, kTagReduce, comm, MPI_STATUS_IGNORE);
+      MPI_Reduce_local(acc.data(), tmp.data(), count, type, op);
+      std::swap(acc, tmp);
+    }
+  }
+
+  if (tree_root == root) {
+    if (info.rank == root && bytes > 0) {
+      std::memcpy(recv_buf, acc.data(), bytes);
+    }
+  } else if (info.rank == tree_root) {
+    MPI_Send(acc.data(), count, type, root, kTagReduce, comm);
+  } else if (info.rank == root) {
+    MPI_Recv(recv_buf, count, type, tree_root, kTagReduce, comm, MPI_STATUS_IGNORE);
+  }
+}
+
+void Allreduce(const void *send_buf, void *recv_buf, int count, MPI_Datatype type, MPI_Op op, MPI_Comm comm,
+               Algorithm algorithm) {
+  const auto info = GetCommInfo(comm);
+  CheckArguments(count, 0, info);
+  const std::size_t bytes = static_cast<std::size_t>(count) * Extent(type);
+  if (send_buf != MPI_IN_PLACE && bytes > 0) {
+    std::memcpy(recv_buf, send_buf, bytes);
+  }
+  if (info.size == 1 || count == 0) {
+    return;
+  }
+
+  const bool commutative = IsCommutative(op);
+  if (algorithm == Algorithm::kAuto) {
+    algorithm = SelectAllreduce(PayloadBytes(count, type), count, info.size, commutative);
+  }
+  const bool block_algorithm = algorithm == Algorithm::kRabenseifner || algorithm == Algorithm::kRing;
+  if (block_algorithm && (!commutative || count < info.size)) {
+    algorithm = Algorithm::kRecursiveDoubling;
+  }
+  switch (algorithm) {
+    case Algorithm::kRecursiveDoubling:
+      AllreduceRecursiveDoubling(recv_buf, count, type, op, comm, info);
+      return;
+    case Algorithm::kRabenseifner:
+      AllreduceRabenseifner(recv_buf, count, type, op, comm, info);
+      return;
+    case Algorithm::kRing:
+      AllreduceRing(recv_buf, count, type, op, comm, info);
+      return;
+    case Algorithm::kAuto:
+    case Algorithm::kBinomialTree:
+    case Algorithm::kPipelinedChain:
+      break;
+  }
+  throw std::invalid_argument("collectives: Allreduce does not support " + AlgorithmToString(algorithm));
+}
+
+void Scatter(const void *send_buf, void *recv_buf, int count, MPI_Datatype type, int root, MPI_Comm comm) {
+  const auto info = GetCommInfo(comm);
+  CheckArguments(count, root, info);
+  const std::size_t block_bytes = static_cast<std::size_t>(count) * Extent(type);
+  const int vrank = (info.rank - root + info.size) % info.size;
+
+  // Blocks are kept in virtual-rank order: a subtree always owns a contiguous range.
+  Bytes tmp;
+  int mask = 1;
+  if (vrank == 0) {
+    tmp.resize(block_bytes * static_cast<std::size_t>(info.size));
+    for (int v = 0; v < info.size; v++) {
+      const auto real = static_cast<std::size_t>((v + root) % info.size);
+      std::memcpy(At(tmp.data(), block_bytes, static_cast<std::size_t>(v)), At(send_buf, block_bytes, real),
+                  block_bytes);
+    }
+    while (mask < info.size) {
+      mask <<= 1;
+    }
+  } else {
+    while ((vrank & mask) == 0) {
+      mask <<= 1;
+    }
+    const int blocks = std::min(mask, info.size - vrank);
+    tmp.resize(block_bytes * static_cast<std::size_t>(blocks));
+    MPI_Recv(tmp.data(), count * blocks, type, (vrank - mask + root) % info.size, kTagScatter, comm,
+             MPI_STATUS_IGNORE);
+  }
+  for (mask >>= 1; mask > 0; mask >>= 1) {
+    if (vrank + mask < info.size) {
+      const int blocks = std::min(mask, info.size - vrank - mask);
+      MPI_Send(At(tmp.data(), block_bytes, static_cast<std::size_t>(mask)), count * blocks, type,
+               (vrank + mask + root) % info.size, kTagScatter, comm);
+    }
+  }
+  if (block_bytes > 0) {
+    std::memcpy(recv_buf, tmp.data(), block_bytes);
+  }
+}
+
+void Gather(const void *send_buf, void *recv_buf, int count, MPI_Datatype type, int root, MPI_Comm comm) {
+  const auto info = GetCommInfo(comm);
+  CheckArguments(count, root, info);
+  const std::size_t block_bytes = static_cast<std::size_t>(count) * Extent(type);
+  const int vrank = (info.rank - root + info.size) % info.size;
+
+  int subtree = 1;
+  while (vrank + subtree < info.size && (vrank & subtree) == 0) {
+    subtree <<= 1;
+  }
+  const int blocks = std::min(subtree, info.size - vrank);
+  Bytes tmp(block_bytes * static_cast<std::size_t>(blocks));
+  if (block_bytes > 0) {
+    std::memcpy(tmp.data(), send_buf, block_bytes);
+  }
+
+  int mask = 1;
+  for (; mask < info.size; mask <<= 1) {
+    if ((vrank & mask) != 0) {
+      MPI_Send(tmp.data(), count * blocks, type, (vrank - mask + root) % info.size, kTagGather, comm);
+      break;
+    }
+    if (vrank + mask < info.size) {
+      const int child_blocks = std::min(mask, info.size - vrank - mask);
+      MPI_Recv(At(tmp.data(), block_bytes, static_cast<std::size_t>(mask)), count * child_blocks, type,
+               (vrank + mask + root) % info.size, kTagGather, comm, MPI_STATUS_IGNORE);
+    }
+  }
+
+  if (vrank == 0) {
+    for (int v = 0; v < info.size; v++) {
+      const auto real = static_cast<std::size_t>((v + root) % info.size);
+      std::memcpy(At(recv_buf, block_bytes, real), At(tmp.data(), block_bytes, static_cast<std::size_t>(v)),
+                  block_bytes);
+    }
+  }
+}
+
+void Allgather(const void *send_buf, void *recv_buf, int count, MPI_Datatype type, MPI_Comm comm,
+               Algorithm algorithm) {
+  const auto info = GetCommInfo(comm);
+  CheckArguments(count, 0, info);
+  const std::size_t block_bytes = static_cast<std::size_t>(count) * Extent(type);
+  if (send_buf != MPI_IN_PLACE && block_bytes > 0) {
+    std::memcpy(At(recv_buf, block_bytes, static_cast<std::size_t>(info.rank)), send_buf, block_bytes);
+  }
+  if (info.size == 1 || count == 0) {
+    return;
+  }
+
+  const bool power_of_two = (info.size & (info.size - 1)) == 0;
+  if (algorithm == Algorithm::kAuto) {
+    algorithm = power_of_two ? Algorithm::kRecursiveDoubling : Algorithm::kRing;
+  }
+  if (algorithm == Algorithm::kRecursiveDoubling && power_of_two) {
+    AllgatherRecursiveDoubling(recv_buf, count, type, comm, info);
+  } else if (algorithm == Algorithm::kRecursiveDoubling || algorithm == Algorithm::kRing) {
+    AllgatherRing(recv_buf, count, type, comm, info);
+  } else {
+    throw std::invalid_argument("collectives: Allgather does not support " + AlgorithmToString(algorithm));
+  }
+}
+
+std::uint64_t ChunkedAlltoallv(const void *send_buf, std::span<const std::uint64_t> send_counts,
+                               std::span<const std::size_t> send_offsets, void *recv_buf,
+                               std::span<const std::uint64_t> recv_counts, std::span<const std::size_t> recv_offsets,
+                               MPI_Datatype type, std::uint64_t chunk, MPI_Comm comm) {
+  const auto info = GetCommInfo(comm);
+  const auto ranks = static_cast<std::size_t>(info.size);
+  if (send_counts.size() != ranks || send_offsets.size() != ranks || recv_counts.size() != ranks ||
+      recv_offsets.size() != ranks) {
+    throw std::invalid_argument("collectives: ChunkedAlltoallv needs one count and offset per rank");
+  }
+  if (chunk > static_cast<std::uint64_t>(std::numeric_limits<int>::max())) {
+    throw std::invalid_argument("collectives: ChunkedAlltoallv chunk does not fit into an MPI int");
+  }
+  chunk = std::max<std::uint64_t>(chunk, 1);
+  std::uint64_t rounds = 0;
+  for (std::size_t r = 0; r < ranks; r++) {
+    rounds = std::max({rounds, (send_counts[r] + chunk - 1) / chunk, (recv_counts[r] + chunk - 1) / chunk});
+  }
+  MPI_Allreduce(MPI_IN_PLACE, &rounds, 1, MPI_UINT64_T, MPI_MAX, comm);
+  // Every round addresses its blocks by pointer, so only the counts of a round go through an int,
+  // however large the buffers are.
+  const std::size_t extent = Extent(type);
+  std::vector<MPI_Request> requests;
+  requests.reserve(2 * ranks);
+  for (std::uint64_t round = 0; round < rounds; round++) {
+    const std::uint64_t done = round * chunk;
+    requests.clear();
+    for (std::size_t r = 0; r < ranks; r++) {
+      if (recv_counts[r] > done) {
+        const auto count = static_cast<int>(std::min(chunk, recv_counts[r] - done));
+        MPI_Irecv(At(recv_buf, extent, recv_offsets[r] + done), count, type, static_cast<int>(r), kTagAlltoallv, comm,
+                  &requests.emplace_back());
+      }
+    }
+    for (std::size_t r = 0; r < ranks; r++) {
+      if (send_counts[r] > done) {
+        const auto count = static_cast<int>(std::min(chunk, send_counts[r] - done));
+        MPI_Isend(At(send_buf, extent, send_offsets[r] + done), count, type, static_cast<int>(r), kTagAlltoallv, comm,
+                  &requests.emplace_back());
+      }
+    }
+    MPI_Waitall(static_cast<int>(requests.size()), requests.data(), MPI_STATUSES_IGNORE);
+  }
+  return rounds;
+}
+
+}  // namespace ppc::collectives
@@ -0,0 +1,245 @@
+#include <gtest/gtest.h>
+#include <mpi.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <numeric>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+#include "collectives/include/collectives.hpp"
+#include "util/include/func_test_util.hpp"
+
+using ppc::collectives::Algorithm;
+
+namespace {
+
+int CommRank() {
+  int rank = 0;
+  MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+  return rank;
+}
+
+int CommSize() {
+  int size = 1;
+  MPI_Comm_size(MPI_COMM_WORLD, &size);
+  return size;
+}
+
+// Associative but non-commutative: a (op) b = a, so any reduction yields rank 0's value.
+void KeepLeft(void *in, void *inout, int *len, MPI_Datatype * /*type*/) {
+  auto *src = static_cast<int *>(in);
+  auto *dst = static_cast<int *>(inout);
+  for (int i = 0; i < *len; i++) {
+    dst[i] = src[i];
+  }
+}
+
+}  // namespace
+
+TEST(CollectivesSelection, BcastSwitchesToChainForLongMessages) {
+  const auto &tuning = ppc::collectives::GetTuning();
+  EXPECT_EQ(ppc::collectives::SelectBcast(8, 16), Algorithm::kBinomialTree);
+  EXPECT_EQ(ppc::collectives::SelectBcast(tuning.bcast_chain_min_bytes, 16), Algorithm::kPipelinedChain);
+  EXPECT_EQ(ppc::collectives::SelectBcast(tuning.bcast_chain_min_bytes, 2), Algorithm::kBinomialTree);
+}
+
+TEST(CollectivesSelection, AllreduceDependsOnSizeAndOperator) {
+  const auto &tuning = ppc::collectives::GetTuning();
+  EXPECT_EQ(ppc::collectives::SelectAllreduce(8, 1, 4, true), Algorithm::kRecursiveDoubling);
+  EXPECT_EQ(ppc::collectives::SelectAllreduce(tuning.allreduce_rabenseifner_min_bytes, 1024, 4, true),
+            Algorithm::kRabenseifner);
+  EXPECT_EQ(ppc::collectives::SelectAllreduce(tuning.allreduce_ring_min_bytes, 1 << 20, 4, true), Algorithm::kRing);
+  EXPECT_EQ(ppc::collectives::SelectAllreduce(tuning.allreduce_ring_min_bytes, 1 << 20, 4, false),
+            Algorithm::kRecursiveDoubling);
+}
+
+TEST(CollectivesSelection, AlgorithmNames) {
+  EXPECT_EQ(ppc::collectives::AlgorithmToString(Algorithm::kRabenseifner), "rabenseifner");
+  EXPECT_EQ(ppc::collectives::AlgorithmToString(Algorithm::kPipelinedChain), "pipelined_chain");
+}
+
+TEST(CollectivesMPI, BcastMatchesVendorForEveryRootAndAlgorithm) {
+  if (!ppc::util::MpiReady()) {
+    GTEST_SKIP() << "MPI is not initialized";
+  }
+  const int rank = CommRank();
+  const int size = CommSize();
+  for (const auto algorithm : {Algorithm::kBinomialTree, Algorithm::kPipelinedChain, Algorithm::kAuto}) {
+    for (int root = 0; root < size; root++) {
+      std::vector<double> data(5000, -1.0);
+      if (rank == root) {
+        std::iota(data.begin(), data.end(), static_cast<double>(root));
+      }
+      ppc::collectives::Bcast(data.data(), static_cast<int>(data.size()), MPI_DOUBLE, root, MPI_COMM_WORLD, algorithm);
+      for (std::size_t i = 0; i < data.size(); i++) {
+        ASSERT_EQ(data[i], static_cast<double>(root) + static_cast<double>(i));
+      }
+    }
+  }
+}
+
+TEST(CollectivesMPI, BcastRejectsInvalidRoot) {
+  if (!ppc::util::MpiReady()) {
+    GTEST_SKIP() << "MPI is not initialized";
+  }
+  int value = 0;
+  EXPECT_THROW(ppc::collectives::Bcast(&value, 1, MPI_INT, CommSize(), MPI_COMM_WORLD), std::invalid_argument);
+}
+
+TEST(CollectivesMPI, AllreduceMatchesVendorForEveryAlgorithm) {
+  if (!ppc::util::MpiReady()) {
+    GTEST_SKIP() << "MPI is not initialized";
+  }
+  const int rank = CommRank();
+  for (const int count : {1, 3, 17, 4099}) {
+    std::vector<long long> local(static_cast<std::size_t>(count));
+    std::iota(local.begin(), local.end(), static_cast<long long>(rank) * 1000);
+    std::vector<long long> expected(local.size());
+    MPI_Allreduce(local.data(), expected.data(), count, MPI_LONG_LONG, MPI_SUM, MPI_COMM_WORLD);
+    for (const auto algorithm :
+         {Algorithm::kRecursiveDoubling, Algorithm::kRabenseifner, Algorithm::kRing, Algorithm::kAuto}) {
+      std::vector<long long> result(local.size(), 0);
+      ppc::collectives::Allreduce(local.data(), result.data(), count, MPI_LONG_LONG, MPI_SUM, MPI_COMM_WORLD,
+                                  algorithm);
+      ASSERT_EQ(result, expected) << ppc::collectives::AlgorithmToString(algorithm) << " count " << count;
+    }
+  }
+}
+
+TEST(CollectivesMPI, NonCommutativeOperatorsKeepRankOrder) {
+  if (!ppc::util::MpiReady()) {
+    GTEST_SKIP() << "MPI is not initialized";
+  }
+  MPI_Op keep_left = MPI_OP_NULL;
+  MPI_Op_create(&KeepLeft, 0, &keep_left);
+  const int rank = CommRank();
+  const int size = CommSize();
+  std::vector<int> local(64, rank + 10);
+
+  std::vector<int> result(local.size(), -1);
+  ppc::collectives::Allreduce(local.data(), result.data(), static_cast<int>(local.size()), MPI_INT, keep_left,
+                              MPI_COMM_WORLD, Algorithm::kRing);
+  EXPECT_EQ(result, std::vector<int>(local.size(), 10));
+
+  const int root = size - 1;
+  std::vector<int> reduced(local.size(), -1);
+  ppc::collectives::Reduce(local.data(), reduced.data(), static_cast<int>(local.size()), MPI_INT, keep_left, root,
+                           MPI_COMM_WORLD);
+  if (rank == root) {
+    EXPECT_EQ(reduced, std::vector<int>(local.size(), 10));
+  }
+  MPI_Op_free(&keep_left);
+}
+
+TEST(CollectivesMPI, ReduceOntoEveryRoot) {
+  if (!ppc::util::MpiReady()) {
+    GTEST_SKIP() << "MPI is not initialized";
+  }
+  const int rank = CommRank();
+  const int size = CommSize();
+  for (int root = 0; root < size; root++) {
+    std::vector<int> local = {rank, 1, -rank};
+    std::vector<int> result(3, 0);
+    ppc::collectives::Reduce(local.data(), result.data(), 3, MPI_INT, MPI_SUM, root, MPI_COMM_WORLD);
+    if (rank == root) {
+      EXPECT_EQ(result, (std::vector<int>{size * (size - 1) / 2, size, -size * (size - 1) / 2}));
+    }
+  }
+}
+
+TEST(CollectivesMPI, ScatterGatherRoundTrip) {
+  if (!ppc::util::MpiReady()) {
+    GTEST_SKIP() << "MPI is not initialized";
+  }
+  const int rank = CommRank();
+  const int size = CommSize();
+  constexpr int kCount = 3;
+  for (int root = 0; root < size; root++) {
+    std::vector<int> all(static_cast<std::size_t>(size) * kCount);
+    if (rank == root) {
+      std::iota(all.begin(), all.end(), 0);
+    }
+    std::vector<int> mine(kCount, -1);
+    ppc::collectives::Scatter(all.data(), mine.data(), kCount, MPI_INT, root, MPI_COMM_WORLD);
+    for (int i = 0; i < kCount; i++) {
+      ASSERT_EQ(mine[static_cast<std::size_t>(i)], (rank * kCount) + i);
+    }
+
+    std::vector<int> gathered(all.size(), -1);
+    ppc::collectives::Gather(mine.data(), gathered.data(), kCount, MPI_INT, root, MPI_COMM_WORLD);
+    if (rank == root) {
+      EXPECT_EQ(gathered, all);
+    }
+  }
+}
+
+TEST(CollectivesMPI, AllgatherCollectsEveryBlock) {
+  if (!ppc::util::MpiReady()) {
+    GTEST_SKIP() << "MPI is not initialized";
+  }
+  const int rank = CommRank();
+  const int size = CommSize();
+  for (const auto algorithm : {Algorithm::kRing, Algorithm::kRecursiveDoubling}) {
+    std::vector<int> mine = {rank, rank * 2};
+    std::vector<int> all(static_cast<std::size_t>(size) * 2, -1);
+    ppc::collectives::Allgather(mine.data(), all.data(), 2, MPI_INT, MPI_COMM_WORLD, algorithm);
+    for (int r = 0; r < size; r++) {
+      EXPECT_EQ(all[static_cast<std::size_t>(r) * 2], r);
+      EXPECT_EQ(all[(static_cast<std::size_t>(r) * 2) + 1], r * 2);
+    }
+  }
+}
+
+TEST(CollectivesMPI, ChunkedAlltoallvDeliversEveryBlockInRounds) {
+  if (!ppc::util::MpiReady()) {
+    GTEST_SKIP() << "MPI is not initialized";
+  }
+  const int rank = CommRank();
+  const auto ranks = static_cast<std::size_t>(CommSize());
+  const auto me = static_cast<std::size_t>(rank);
+  // Rank r sends r + d + 1 elements to rank d, so the blocks differ in size in both directions.
+  std::vector<std::uint64_t> send_counts(ranks);
+  std::vector<std::uint64_t> recv_counts(ranks);
+  std::vector<std::size_t> send_offsets(ranks + 1, 0);
+  std::vector<std::size_t> recv_offsets(ranks + 1, 0);
+  for (std::size_t r = 0; r < ranks; r++) {
+    send_counts[r] = me + r + 1;
+    recv_counts[r] = r + me + 1;
+    send_offsets[r + 1] = send_offsets[r] + send_counts[r];
+    recv_offsets[r + 1] = recv_offsets[r] + recv_counts[r];
+  }
+  std::vector<int> send(send_offsets[ranks]);
+  for (std::size_t r = 0; r < ranks; r++) {
+    for (std::size_t i = 0; i < send_counts[r]; i++) {
+      send[send_offsets[r] + i] = static_cast<int>((((me * ranks) + r) * 100) + i);
+    }
+  }
+  std::vector<int> recv(recv_offsets[ranks], -1);
+  const std::uint64_t rounds = ppc::collectives::ChunkedAlltoallv(
+      send.data(), send_counts, std::span(send_offsets).first(ranks), recv.data(), recv_counts,
+      std::span(recv_offsets).first(ranks), MPI_INT, 2, MPI_COMM_WORLD);
+  EXPECT_EQ(rounds, ranks);
+  for (std::size_t r = 0; r < ranks; r++) {
+    for (std::size_t i = 0; i < recv_counts[r]; i++) {
+      EXPECT_EQ(recv[recv_offsets[r] + i], static_cast<int>((((r * ranks) + me) * 100) + i));
+    }
+  }
+}
+
+TEST(CollectivesMPI, ChunkedAlltoallvRejectsInvalidArguments) {
+  if (!ppc::util::MpiReady()) {
+    GTEST_SKIP() << "MPI is not initialized";
+  }
+  const auto ranks = static_cast<std::size_t>(CommSize());
+  const std::vector<std::uint64_t> counts(ranks, 0);
+  const std::vector<std::size_t> offsets(ranks, 0);
+  const std::vector<std::uint64_t> short_counts(ranks + 1, 0);
+  EXPECT_THROW((void)ppc::collectives::ChunkedAlltoallv(nullptr, short_counts, offsets, nullptr, counts, offsets,
+                                                        MPI_INT, 1, MPI_COMM_WORLD),
+               std::invalid_argument);
+  EXPECT_THROW((void)ppc::collectives::ChunkedAlltoallv(nullptr, counts, offsets, nullptr, counts, offsets, MPI_INT,
+                                                        std::uint64_t{1} << 31U, MPI_COMM_WORLD),
+               std::invalid_argument);
+}
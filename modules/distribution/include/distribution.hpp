@@ -0,0 +1,274 @@
+#pragma once
+
+#include <mpi.h>
+
+#include <complex>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace ppc::distribution {
+
+/// @brief How the elements of one dimension are dealt to the parts.
+enum class Scheme : uint8_t {
+  /// Contiguous chunks; the first count % parts chunks hold one extra element
+  kBlock,
+  /// Element i goes to part i % parts
+  kCyclic,
+  /// Blocks of BlockSize() elements dealt round-robin (ScaLAPACK style)
+  kBlockCyclic
+};
+
+/// @brief Returns the lower-case name of the scheme ("block", "cyclic", "block_cyclic").
+std::string SchemeToString(Scheme scheme);
+
+/// @brief Split of @p count indices over @p parts parts.
+/// @details Local indices of a part follow the global order, so the local array of every part
+/// is the subsequence of the global array it owns.
+class Partition {
+ public:
+  /// @param block Block size of kBlockCyclic (ignored otherwise).
+  /// @throws std::invalid_argument On parts <= 0 or block == 0.
+  Partition(std::size_t count, int parts, Scheme scheme = Scheme::kBlock, std::size_t block = 1);
+
+  [[nodiscard]] std::size_t Count() const {
+    return count_;
+  }
+  [[nodiscard]] int Parts() const {
+    return parts_;
+  }
+  [[nodiscard]] Scheme GetScheme() const {
+    return scheme_;
+  }
+  /// @brief Round-robin block size (1 for kCyclic, 0 for kBlock).
+  [[nodiscard]] std::size_t BlockSize() const {
+    return block_;
+  }
+
+  /// @brief Part owning global @p index.
+  [[nodiscard]] int Owner(std::size_t index) const;
+  /// @brief Position of global @p index in its owner's local array.
+  [[nodiscard]] std::size_t ToLocal(std::size_t index) const;
+  /// @brief Global index of element @p local of @p part.
+  [[nodiscard]] std::size_t ToGlobal(int part, std::size_t local) const;
+  /// @brief Number of indices owned by @p part.
+  [[nodiscard]] std::size_t LocalCount(int part) const;
+
+  /// @brief LocalCount() of every part, ready for MPI_Scatterv/MPI_Gatherv.
+  /// @throws std::invalid_argument When a count does not fit into int.
+  [[nodiscard]] std::vector<int> Counts() const;
+  /// @brief Global offset of every part; kBlock only.
+  /// @throws std::logic_error For the cyclic schemes, whose parts are not contiguous.
+  [[nodiscard]] std::vector<int> Displs() const;
+
+ private:
+  void CheckPart(int part) const;
+
+  std::size_t count_;
+  int parts_;
+  Scheme scheme_;
+  std::size_t block_;
+};
+
+/// @brief Row-major rows x cols matrix split over a grid_rows x grid_cols process grid.
+/// @details Part (i, j) has number i * grid_cols + j and owns the rows of part i of
+/// RowPartition() crossed with the columns of part j of ColPartition(). Its local block is
+/// stored row-major with LocalRows() x LocalCols() elements.
+class MatrixDistribution {
+ public:
+  MatrixDistribution(Partition rows, Partition cols);
+
+  /// @brief Horizontal strips: every part owns whole rows.
+  static MatrixDistribution RowStrips(std::size_t rows, std::size_t cols, int parts, Scheme scheme = Scheme::kBlock,
+                                     std::size_t block = 1);
+  /// @brief Vertical strips: every part owns whole columns.
+  static MatrixDistribution ColumnStrips(std::size_t rows, std::size_t cols, int parts,
+                                         Scheme scheme = Scheme::kBlock, std::size_t block = 1);
+  /// @brief 2D blocks over a grid_rows x grid_cols grid, same scheme in both dimensions.
+  static MatrixDistribution Blocks(std::size_t rows, std::size_t cols, int grid_rows, int grid_cols,
+                                   Scheme scheme = Scheme::kBlock, std::size_t block = 1);
+
+  [[nodiscard]] const Partition &RowPartition() const {
+    return rows_;
+  }
+  [[nodiscard]] const Partition &ColPartition() const {
+    return cols_;
+  }
+  [[nodiscard]] std::size_t Rows() const {
+    return rows_.Count();
+  }
+  [[nodiscard]] std::size_t Cols() const {
+    return cols_.Count();
+  }
+  [[nodiscard]] int Parts() const {
+    return rows_.Parts() * cols_.Parts();
+  }
+  [[nodiscard]] int GridRow(int part) const {
+    return part / cols_.Parts();
+  }
+  [[nodiscard]] int GridCol(int part) const {
+    return part % cols_.Parts();
+  }
+
+  /// @brief Part owning element (@p row, @p col).
+  [[nodiscard]] int Owner(std::size_t row, std::size_t col) const;
+  [[nodiscard]] std::size_t LocalRows(int part) const;
+  [[nodiscard]] std::size_t LocalCols(int part) const;
+  [[nodiscard]] std::size_t LocalCount(int part) const {
+    return LocalRows(part) * LocalCols(part);
+  }
+
+ private:
+  Partition rows_;
+  Partition cols_;
+};
+
+// The operations below are collective over @p comm, whose size must equal Parts() of every
+// distribution passed in (std::invalid_argument otherwise). Global buffers hold Count()
+// (or Rows() x Cols() row-major) elements of @p type and are significant only on @p root.
+// Parts are moved with derived datatypes, so strided and round-robin parts are never packed
+// by hand. Typical use inside a ppc::task::Task:
+//   PreProcessingImpl:  local_ = ppc::distribution::Scatter(dist, GetInput(), 0, MPI_COMM_WORLD);
+//   PostProcessingImpl: GetOutput() = ppc::distribution::Allgather(dist, local_, MPI_COMM_WORLD);
+
+/// @brief Sends every part of @p global from @p root to its owner.
+void Scatter(const Partition &partition, const void *global, void *local, MPI_Datatype type, int root,
+             MPI_Comm comm);
+/// @brief Assembles the local parts into @p global on @p root.
+void Gather(const Partition &partition, const void *local, void *global, MPI_Datatype type, int root,
+            MPI_Comm comm);
+/// @brief Assembles the local parts into @p global on every rank.
+void Allgather(const Partition &partition, const void *local, void *global, MPI_Datatype type, MPI_Comm comm);
+/// @brief Moves data laid out by @p from into the layout of @p to (same Count()).
+void Redistribute(const Partition &from, const Partition &to, const void *local_in, void *local_out,
+                  MPI_Datatype type, MPI_Comm comm);
+
+void Scatter(const MatrixDistribution &dist, const void *global, void *local, MPI_Datatype type, int root,
+             MPI_Comm comm);
+void Gather(const MatrixDistribution &dist, const void *local, void *global, MPI_Datatype type, int root,
+            MPI_Comm comm);
+void Allgather(const MatrixDistribution &dist, const void *local, void *global, MPI_Datatype type, MPI_Comm comm);
+/// @brief Moves a matrix laid out by @p from into the layout of @p to (same shape).
+void Redistribute(const MatrixDistribution &from, const MatrixDistribution &to, const void *local_in,
+                  void *local_out, MPI_Datatype type, MPI_Comm comm);
+
+/// @brief MPI datatype matching the C++ element type @p T.
+template <typename T>
+MPI_Datatype DatatypeOf() {
+  if constexpr (std::is_same_v<T, double>) {
+    return MPI_DOUBLE;
+  } else if constexpr (std::is_same_v<T, float>) {
+    return MPI_FLOAT;
+  } else if constexpr (std::is_same_v<T, int>) {
+    return MPI_INT;
+  } else if constexpr (std::is_same_v<T, unsigned>) {
+    return MPI_UNSIGNED;
+  } else if constexpr (std::is_same_v<T, std::int64_t>) {
+    return MPI_INT64_T;
+  } else if constexpr (std::is_same_v<T, std::uint64_t>) {
+    return MPI_UINT64_T;
+  } else if constexpr (std::is_same_v<T, std::uint8_t>) {
+    return MPI_UINT8_T;
+  } else if constexpr (std::is_same_v<T, char>) {
+    return MPI_CHAR;
+  } else if constexpr (std::is_same_v<T, std::complex<double>>) {
+    return MPI_C_DOUBLE_COMPLEX;
+  } else {
+    static_assert(sizeof(T) == 0, "no MPI datatype for this element type");
+  }
+}
+
+namespace detail {
+
+/// @brief Returns the rank of the caller in @p comm.
+/// @throws std::invalid_argument When the size of @p comm differs from @p parts.
+inline int CheckedRank(int parts, MPI_Comm comm) {
+  int rank = 0;
+  int size = 0;
+  MPI_Comm_rank(comm, &rank);
+  MPI_Comm_size(comm, &size);
+  if (size != parts) {
+    throw std::invalid_argument("distribution: " + std::to_string(parts) + " parts on a communicator of " +
+                                std::to_string(size) + " ranks");
+  }
+  return rank;
+}
+
+template <typename T>
+void CheckSize(const std::vector<T> &buffer, std::size_t expected) {
+  if (buffer.size() != expected) {
+    throw std::invalid_argument("distribution: buffer holds " + std::to_string(buffer.size()) +
+                                " elements, expected " + std::to_string(expected));
+  }
+}
+
+/// @brief CheckSize() agreed on over @p comm: every rank throws when the buffer of a rank that
+/// passes @p check has the wrong size, so no rank is left waiting in the collective.
+template <typename T>
+void CheckSizeOnEveryRank(const std::vector<T> &buffer, std::size_t expected, bool check, MPI_Comm comm) {
+  int wrong = check && buffer.size() != expected ? 1 : 0;
+  MPI_Allreduce(MPI_IN_PLACE, &wrong, 1, MPI_INT, MPI_MAX, comm);
+  if (wrong == 0) {
+    return;
+  }
+  if (check) {
+    CheckSize(buffer, expected);
+  }
+  throw std::invalid_argument("distribution: a buffer on another rank has the wrong size");
+}
+
+inline std::size_t GlobalCount(const Partition &partition) {
+  return partition.Count();
+}
+
+inline std::size_t GlobalCount(const MatrixDistribution &dist) {
+  return dist.Rows() * dist.Cols();
+}
+
+}  // namespace detail
+
+/// @brief Typed Scatter(): returns the local part of the calling rank.
+/// @param global Read on @p root only; may be empty elsewhere.
+/// @throws std::invalid_argument On every rank when @p global on @p root has the wrong size.
+template <typename Dist, typename T>
+std::vector<T> Scatter(const Dist &dist, const std::vector<T> &global, int root, MPI_Comm comm) {
+  const int rank = detail::CheckedRank(dist.Parts(), comm);
+  detail::CheckSizeOnEveryRank(global, detail::GlobalCount(dist), rank == root, comm);
+  std::vector<T> local(dist.LocalCount(rank));
+  Scatter(dist, global.data(), local.data(), DatatypeOf<T>(), root, comm);
+  return local;
+}
+
+/// @brief Typed Gather(): returns the global data on @p root and an empty vector elsewhere.
+template <typename Dist, typename T>
+std::vector<T> Gather(const Dist &dist, const std::vector<T> &local, int root, MPI_Comm comm) {
+  const int rank = detail::CheckedRank(dist.Parts(), comm);
+  detail::CheckSizeOnEveryRank(local, dist.LocalCount(rank), true, comm);
+  std::vector<T> global(rank == root ? detail::GlobalCount(dist) : 0);
+  Gather(dist, local.data(), global.data(), DatatypeOf<T>(), root, comm);
+  return global;
+}
+
+/// @brief Typed Allgather(): returns the global data on every rank.
+template <typename Dist, typename T>
+std::vector<T> Allgather(const Dist &dist, const std::vector<T> &local, MPI_Comm comm) {
+  detail::CheckSizeOnEveryRank(local, dist.LocalCount(detail::CheckedRank(dist.Parts(), comm)), true, comm);
+  std::vector<T> global(detail::GlobalCount(dist));
+  Allgather(dist, local.data(), global.data(), DatatypeOf<T>(), comm);
+  return global;
+}
+
+/// @brief Typed Redistribute(): returns the local part of the calling rank under @p to.
+template <typename Dist, typename T>
+std::vector<T> Redistribute(const Dist &from, const Dist &to, const std::vector<T> &local, MPI_Comm comm) {
+  const int rank = detail::CheckedRank(from.Parts(), comm);
+  detail::CheckSizeOnEveryRank(local, from.LocalCount(rank), true, comm);
+  std::vector<T> out(to.LocalCount(rank));
+  Redistribute(from, to, local.data(), out.data(), DatatypeOf<T>(), comm);
+  return out;
+}
+
+}  // namespace ppc::distribution
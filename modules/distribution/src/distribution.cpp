@@ -0,0 +1,504 @@
+#include "distribution/include/distribution.hpp"
+
+#include <mpi.h>
+
+#include <array>
+#include <climits>
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "shared_memory/include/shared_memory.hpp"
+
+namespace ppc::distribution {
+
+namespace {
+
+int ToInt(std::size_t value) {
+  if (value > static_cast<std::size_t>(INT_MAX)) {
+    throw std::invalid_argument("distribution: " + std::to_string(value) + " elements do not fit into an MPI count");
+  }
+  return static_cast<int>(value);
+}
+
+int CheckComm(int parts, int root, MPI_Comm comm) {
+  const int rank = detail::CheckedRank(parts, comm);
+  if (root < 0 || root >= parts) {
+    throw std::invalid_argument("distribution: root " + std::to_string(root) + " is out of range");
+  }
+  return rank;
+}
+
+MPI_Aint ExtentOf(MPI_Datatype type) {
+  MPI_Aint lb = 0;
+  MPI_Aint extent = 0;
+  MPI_Type_get_extent(type, &lb, &extent);
+  return extent;
+}
+
+MPI_Datatype Empty(MPI_Datatype unit) {
+  MPI_Datatype type = MPI_DATATYPE_NULL;
+  MPI_Type_contiguous(0, unit, &type);
+  return type;
+}
+
+/// Datatype selecting the units owned by @p part from the start of a global array of units.
+/// Block parts are one contiguous run, round-robin parts a vector of whole blocks plus the
+/// partial last block, if the part owns it.
+MPI_Datatype PartType(const Partition &partition, int part, MPI_Datatype unit) {
+  const std::size_t local = partition.LocalCount(part);
+  if (local == 0) {
+    return Empty(unit);
+  }
+  const MPI_Aint extent = ExtentOf(unit);
+
+  std::array<int, 2> lengths{};
+  std::array<MPI_Aint, 2> displs{};
+  std::array<MPI_Datatype, 2> types{};
+  int entries = 0;
+  MPI_Datatype strided = MPI_DATATYPE_NULL;
+  if (partition.GetScheme() == Scheme::kBlock) {
+    lengths[0] = ToInt(local);
+    displs[0] = static_cast<MPI_Aint>(partition.ToGlobal(part, 0)) * extent;
+    types[0] = unit;
+    entries = 1;
+  } else {
+    const std::size_t block = partition.BlockSize();
+    const std::size_t full = local / block;
+    const std::size_t tail = local % block;
+    if (full > 0) {
+      MPI_Type_vector(ToInt(full), ToInt(block), ToInt(block * static_cast<std::size_t>(partition.Parts())), unit,
+                      &strided);
+      lengths[entries] = 1;
+      displs[entries] = static_cast<MPI_Aint>(partition.ToGlobal(part, 0)) * extent;
+      types[entries] = strided;
+      entries++;
+    }
+    if (tail > 0) {
+      lengths[entries] = ToInt(tail);
+      displs[entries] = static_cast<MPI_Aint>(partition.ToGlobal(part, full * block)) * extent;
+      types[entries] = unit;
+      entries++;
+    }
+  }
+  MPI_Datatype type = MPI_DATATYPE_NULL;
+  MPI_Type_create_struct(entries, lengths.data(), displs.data(), types.data(), &type);
+  if (strided != MPI_DATATYPE_NULL) {
+    MPI_Type_free(&strided);
+  }
+  return type;
+}
+
+/// Datatype selecting the local block of @p part from a row-major global matrix of units.
+MPI_Datatype PartType(const MatrixDistribution &dist, int part, MPI_Datatype unit) {
+  if (dist.LocalCount(part) == 0) {
+    return Empty(unit);
+  }
+  const Partition &rows = dist.RowPartition();
+  const Partition &cols = dist.ColPartition();
+  const int grid_row = dist.GridRow(part);
+  const int grid_col = dist.GridCol(part);
+  MPI_Datatype type = MPI_DATATYPE_NULL;
+
+  if (rows.GetScheme() == Scheme::kBlock && cols.GetScheme() == Scheme::kBlock) {
+    const std::array<int, 2> sizes = {ToInt(dist.Rows()), ToInt(dist.Cols())};
+    const std::array<int, 2> subsizes = {ToInt(dist.LocalRows(part)), ToInt(dist.LocalCols(part))};
+    const std::array<int, 2> starts = {ToInt(rows.ToGlobal(grid_row, 0)), ToInt(cols.ToGlobal(grid_col, 0))};
+    MPI_Type_create_subarray(2, sizes.data(), subsizes.data(), starts.data(), MPI_ORDER_C, unit, &type);
+    return type;
+  }
+
+  // Columns of one row, stretched to the row length, then the owned rows of those.
+  MPI_Datatype in_row = PartType(cols, grid_col, unit);
+  MPI_Datatype row = MPI_DATATYPE_NULL;
+  MPI_Type_create_resized(in_row, 0, static_cast<MPI_Aint>(dist.Cols()) * ExtentOf(unit), &row);
+  type = PartType(rows, grid_row, row);
+  MPI_Type_free(&row);
+  MPI_Type_free(&in_row);
+  return type;
+}
+
+/// Per-peer arguments of MPI_Alltoallw; frees the datatypes it built.
+class ExchangePlan {
+ public:
+  explicit ExchangePlan(int size)
+      : counts_(static_cast<std::size_t>(size), 0),
+        displs_(static_cast<std::size_t>(size), 0),
+        types_(static_cast<std::size_t>(size), MPI_BYTE) {}
+
+  ~ExchangePlan() {
+    for (auto &type : owned_) {
+      MPI_Type_free(&type);
+    }
+  }
+
+  ExchangePlan(const ExchangePlan &) = delete;
+  ExchangePlan &operator=(const ExchangePlan &) = delete;
+
+  /// Moves @p count elements of a predefined or caller-owned @p type.
+  void Set(int peer, int count, MPI_Datatype type) {
+    counts_[static_cast<std::size_t>(peer)] = count;
+    types_[static_cast<std::size_t>(peer)] = type;
+  }
+
+  /// Moves one element of @p type, which is committed here and freed with the plan.
+  void Own(int peer, MPI_Datatype type) {
+    MPI_Type_commit(&type);
+    owned_.push_back(type);
+    Set(peer, 1, type);
+  }
+
+  int *Counts() {
+    return counts_.data();
+  }
+  int *Displs() {
+    return displs_.data();
+  }
+  MPI_Datatype *Types() {
+    return types_.data();
+  }
+
+ private:
+  std::vector<int> counts_;
+  std::vector<int> displs_;
+  std::vector<MPI_Datatype> types_;
+  std::vector<MPI_Datatype> owned_;
+};
+
+void Exchange(const void *send_buf, ExchangePlan &send, void *recv_buf, ExchangePlan &recv, MPI_Comm comm) {
+  MPI_Alltoallw(send_buf, send.Counts(), send.Displs(), send.Types(), recv_buf, recv.Counts(), recv.Displs(),
+                recv.Types(), comm);
+}
+
+template <typename Dist>
+void ScatterTyped(const Dist &dist, const void *global, void *local, MPI_Datatype type, int root, MPI_Comm comm) {
+  const int rank = CheckComm(dist.Parts(), root, comm);
+  ExchangePlan send(dist.Parts());
+  ExchangePlan recv(dist.Parts());
+  if (rank == root) {
+    for (int part = 0; part < dist.Parts(); part++) {
+      send.Own(part, PartType(dist, part, type));
+    }
+  }
+  recv.Set(root, ToInt(dist.LocalCount(rank)), type);
+  Exchange(global, send, local, recv, comm);
+}
+
+template <typename Dist>
+void GatherTyped(const Dist &dist, const void *local, void *global, MPI_Datatype type, int root, MPI_Comm comm) {
+  const int rank = CheckComm(dist.Parts(), root, comm);
+  ExchangePlan send(dist.Parts());
+  ExchangePlan recv(dist.Parts());
+  send.Set(root, ToInt(dist.LocalCount(rank)), type);
+  if (rank == root) {
+    for (int part = 0; part < dist.Parts(); part++) {
+      recv.Own(part, PartType(dist, part, type));
+    }
+  }
+  Exchange(local, send, global, recv, comm);
+}
+
+template <typename Dist>
+void AllgatherTyped(const Dist &dist, const void *local, void *global, MPI_Datatype type, MPI_Comm comm) {
+  const int rank = detail::CheckedRank(dist.Parts(), comm);
+  ExchangePlan send(dist.Parts());
+  ExchangePlan recv(dist.Parts());
+  const int count = ToInt(dist.LocalCount(rank));
+  for (int part = 0; part < dist.Parts(); part++) {
+    send.Set(part, count, type);
+    recv.Own(part, PartType(dist, part, type));
+  }
+  Exchange(local, send, global, recv, comm);
+}
+
+/// Local positions exchanged with every peer, merged into runs for MPI_Type_indexed.
+class RunLists {
+ public:
+  explicit RunLists(int size)
+      : lengths_(static_cast<std::size_t>(size)), displs_(static_cast<std::size_t>(size)) {}
+
+  void Add(int peer, std::size_t position) {
+    auto &lengths = lengths_[static_cast<std::size_t>(peer)];
+    auto &displs = displs_[static_cast<std::size_t>(peer)];
+    const int pos = ToInt(position);
+    if (!lengths.empty() && displs.back() + lengths.back() == pos) {
+      lengths.back()++;
+    } else {
+      lengths.push_back(1);
+      displs.push_back(pos);
+    }
+  }
+
+  void Fill(ExchangePlan &plan, MPI_Datatype unit) {
+    for (std::size_t peer = 0; peer < lengths_.size(); peer++) {
+      if (lengths_[peer].empty()) {
+        continue;
+      }
+      MPI_Datatype type = MPI_DATATYPE_NULL;
+      MPI_Type_indexed(static_cast<int>(lengths_[peer].size()), lengths_[peer].data(), displs_[peer].data(), unit,
+                       &type);
+      plan.Own(static_cast<int>(peer), type);
+    }
+  }
+
+ private:
+  std::vector<std::vector<int>> lengths_;
+  std::vector<std::vector<int>> displs_;
+};
+
+}  // namespace
+
+std::string SchemeToString(Scheme scheme) {
+  switch (scheme) {
+    case Scheme::kBlock:
+      return "block";
+    case Scheme::kCyclic:
+      return "cyclic";
+    case Scheme::kBlockCyclic:
+      return "block_cyclic";
+  }
+  return "unknown";
+}
+
+Partition::Partition(std::size_t count, int parts, Scheme scheme, std::size_t block)
+    : count_(count), parts_(parts), scheme_(scheme), block_(block) {
+  if (parts <= 0) {
+    throw std::invalid_argument("distribution: number of parts must be positive");
+  }
+  switch (scheme) {
+    case Scheme::kBlock:
+      block_ = 0;
+      break;
+    case Scheme::kCyclic:
+      block_ = 1;
+      break;
+    case Scheme::kBlockCyclic:
+      if (block == 0) {
+        throw std::invalid_argument("distribution: block-cyclic block size must be positive");
+      }
+      break;
+  }
+}
+
+void Partition::CheckPart(int part) const {
+  if (part < 0 || part >= parts_) {
+    throw std::out_of_range("distribution: part " + std::to_string(part) + " is out of range");
+  }
+}
+
+int Partition::Owner(std::size_t index) const {
+  if (index >= count_) {
+    throw std::out_of_range("distribution: index " + std::to_string(index) + " is out of range");
+  }
+  const auto parts = static_cast<std::size_t>(parts_);
+  if (scheme_ != Scheme::kBlock) {
+    return static_cast<int>((index / block_) % parts);
+  }
+  const std::size_t base = count_ / parts;
+  const std::size_t extra = count_ % parts;
+  const std::size_t long_span = extra * (base + 1);
+  if (index < long_span) {
+    return static_cast<int>(index / (base + 1));
+  }
+  return static_cast<int>(extra + ((index - long_span) / base));
+}
+
+std::size_t Partition::ToLocal(std::size_t index) const {
+  const int owner = Owner(index);
+  if (scheme_ == Scheme::kBlock) {
+    return index - ppc::shared_memory::BlockRange(count_, parts_, owner).first;
+  }
+  return ((index / block_ / static_cast<std::size_t>(parts_)) * block_) + (index % block_);
+}
+
+std::size_t Partition::ToGlobal(int part, std::size_t local) const {
+  if (local >= LocalCount(part)) {
+    throw std::out_of_range("distribution: local index " + std::to_string(local) + " is out of range");
+  }
+  if (scheme_ == Scheme::kBlock) {
+    return ppc::shared_memory::BlockRange(count_, parts_, part).first + local;
+  }
+  const auto parts = static_cast<std::size_t>(parts_);
+  const std::size_t block_index = ((local / block_) * parts) + static_cast<std::size_t>(part);
+  return (block_index * block_) + (local % block_);
+}
+
+std::size_t Partition::LocalCount(int part) const {
+  CheckPart(part);
+  if (scheme_ == Scheme::kBlock) {
+    const auto [begin, end] = ppc::shared_memory::BlockRange(count_, parts_, part);
+    return end - begin;
+  }
+  const auto p = static_cast<std::size_t>(part);
+  const auto parts = static_cast<std::size_t>(parts_);
+  const std::size_t blocks = (count_ + block_ - 1) / block_;
+  if (p >= blocks) {
+    return 0;
+  }
+  std::size_t local = (((blocks - 1 - p) / parts) + 1) * block_;
+  if ((blocks - 1) % parts == p) {
+    local -= (blocks * block_) - count_;
+  }
+  return local;
+}
+
+std::vector<int> Partition::Counts() const {
+  std::vector<int> counts(static_cast<std::size_t>(parts_));
+  for (int part = 0; part < parts_; part++) {
+    counts[static_cast<std::size_t>(part)] = ToInt(LocalCount(part));
+  }
+  return counts;
+}
+
+std::vector<int> Partition::Displs() const {
+  if (scheme_ != Scheme::kBlock) {
+    throw std::logic_error("distribution: " + SchemeToString(scheme_) + " parts have no single displacement");
+  }
+  std::vector<int> displs(static_cast<std::size_t>(parts_));
+  for (int part = 0; part < parts_; part++) {
+    displs[static_cast<std::size_t>(part)] = ToInt(ppc::shared_memory::BlockRange(count_, parts_, part).first);
+  }
+  return displs;
+}
+
+MatrixDistribution::MatrixDistribution(Partition rows, Partition cols) : rows_(rows), cols_(cols) {}
+
+MatrixDistribution MatrixDistribution::RowStrips(std::size_t rows, std::size_t cols, int parts, Scheme scheme,
+                                                 std::size_t block) {
+  return {Partition(rows, parts, scheme, block), Partition(cols, 1)};
+}
+
+MatrixDistribution MatrixDistribution::ColumnStrips(std::size_t rows, std::size_t cols, int parts, Scheme scheme,
+                                                    std::size_t block) {
+  return {Partition(rows, 1), Partition(cols, parts, scheme, block)};
+}
+
+MatrixDistribution MatrixDistribution::Blocks(std::size_t rows, std::size_t cols, int grid_rows, int grid_cols,
+                                              Scheme scheme, std::size_t block) {
+  return {Partition(rows, grid_rows, scheme, block), Partition(cols, grid_cols, scheme, block)};
+}
+
+int MatrixDistribution::Owner(std::size_t row, std::size_t col) const {
+  return (rows_.Owner(row) * cols_.Parts()) + cols_.Owner(col);
+}
+
+std::size_t MatrixDistribution::LocalRows(int part) const {
+  if (part < 0 || part >= Parts()) {
+    throw std::out_of_range("distribution: part " + std::to_string(part) + " is out of range");
+  }
+  return rows_.LocalCount(GridRow(part));
+}
+
+std::size_t MatrixDistribution::LocalCols(int part) const {
+  if (part < 0 || part >= Parts()) {
+    throw std::out_of_range("distribution: part " + std::to_string(part) + " is out of range");
+  }
+  return cols_.LocalCount(GridCol(part));
+}
+
+void Scatter(const Partition &partition, const void *global, void *local, MPI_Datatype type, int root,
+             MPI_Comm comm) {
+  if (partition.GetScheme() != Scheme::kBlock) {
+    ScatterTyped(partition, global, local, type, root, comm);
+    return;
+  }
+  const int rank = CheckComm(partition.Parts(), root, comm);
+  const auto counts = partition.Counts();
+  const auto displs = partition.Displs();
+  MPI_Scatterv(global, counts.data(), displs.data(), type, local, counts[static_cast<std::size_t>(rank)], type, root,
+               comm);
+}
+
+void Gather(const Partition &partition, const void *local, void *global, MPI_Datatype type, int root,
+            MPI_Comm comm) {
+  if (partition.GetScheme() != Scheme::kBlock) {
+    GatherTyped(partition, local, global, type, root, comm);
+    return;
+  }
+  const int rank = CheckComm(partition.Parts(), root, comm);
+  const auto counts = partition.Counts();
+  const auto displs = partition.Displs();
+  MPI_Gatherv(local, counts[static_cast<std::size_t>(rank)], type, global, counts.data(), displs.data(), type, root,
+              comm);
+}
+
+void Allgather(const Partition &partition, const void *local, void *global, MPI_Datatype type, MPI_Comm comm) {
+  if (partition.GetScheme() != Scheme::kBlock) {
+    AllgatherTyped(partition, local, global, type, comm);
+    return;
+  }
+  const int rank = detail::CheckedRank(partition.Parts(), comm);
+  const auto counts = partition.Counts();
+  const auto displs = partition.Displs();
+  MPI_Allgatherv(local, counts[static_cast<std::size_t>(rank)], type, global, counts.data(), displs.data(), type,
+                 comm);
+}
+
+void Redistribute(const Partition &from, const Partition &to, const void *local_in, void *local_out,
+                  MPI_Datatype type, MPI_Comm comm) {
+  if (from.Count() != to.Count() || from.Parts() != to.Parts()) {
+    throw std::invalid_argument("distribution: redistribution between partitions of different shape");
+  }
+  const int rank = detail::CheckedRank(from.Parts(), comm);
+  // Both sides enumerate the shared indices in global order, so the runs line up.
+  RunLists sends(from.Parts());
+  for (std::size_t local = 0; local < from.LocalCount(rank); local++) {
+    sends.Add(to.Owner(from.ToGlobal(rank, local)), local);
+  }
+  RunLists recvs(to.Parts());
+  for (std::size_t local = 0; local < to.LocalCount(rank); local++) {
+    recvs.Add(from.Owner(to.ToGlobal(rank, local)), local);
+  }
+  ExchangePlan send(from.Parts());
+  ExchangePlan recv(to.Parts());
+  sends.Fill(send, type);
+  recvs.Fill(recv, type);
+  Exchange(local_in, send, local_out, recv, comm);
+}
+
+void Scatter(const MatrixDistribution &dist, const void *global, void *local, MPI_Datatype type, int root,
+             MPI_Comm comm) {
+  ScatterTyped(dist, global, local, type, root, comm);
+}
+
+void Gather(const MatrixDistribution &dist, const void *local, void *global, MPI_Datatype type, int root,
+            MPI_Comm comm) {
+  GatherTyped(dist, local, global, type, root, comm);
+}
+
+void Allgather(const MatrixDistribution &dist, const void *local, void *global, MPI_Datatype type, MPI_Comm comm) {
+  AllgatherTyped(dist, local, global, type, comm);
+}
+
+void Redistribute(const MatrixDistribution &from, const MatrixDistribution &to, const void *local_in,
+                  void *local_out, MPI_Datatype type, MPI_Comm comm) {
+  if (from.Rows() != to.Rows() || from.Cols() != to.Cols() || from.Parts() != to.Parts()) {
+    throw std::invalid_argument("distribution: redistribution between matrices of different shape");
+  }
+  const int rank = detail::CheckedRank(from.Parts(), comm);
+  // Local blocks are row-major in both layouts, so both sides walk the shared elements in
+  // global row-major order.
+  const auto walk = [rank](const MatrixDistribution &mine, const MatrixDistribution &other, RunLists &runs) {
+    const std::size_t local_cols = mine.LocalCols(rank);
+    for (std::size_t lr = 0; lr < mine.LocalRows(rank); lr++) {
+      const std::size_t row = mine.RowPartition().ToGlobal(mine.GridRow(rank), lr);
+      for (std::size_t lc = 0; lc < local_cols; lc++) {
+        const std::size_t col = mine.ColPartition().ToGlobal(mine.GridCol(rank), lc);
+        runs.Add(other.Owner(row, col), (lr * local_cols) + lc);
+      }
+    }
+  };
+  RunLists sends(from.Parts());
+  RunLists recvs(to.Parts());
+  walk(from, to, sends);
+  walk(to, from, recvs);
+  ExchangePlan send(from.Parts());
+  ExchangePlan recv(to.Parts());
+  sends.Fill(send, type);
+  recvs.Fill(recv, type);
+  Exchange(local_in, send, local_out, recv, comm);
+}
+
+}  // namespace ppc::distribution
@@ -0,0 +1,267 @@
+#include <gtest/gtest.h>
+#include <mpi.h>
+
+#include <array>
+#include <cstddef>
+#include <numeric>
+#include <stdexcept>
+#include <vector>
+
+#include "distribution/include/distribution.hpp"
+#include "task/include/task.hpp"
+#include "util/include/func_test_util.hpp"
+
+using ppc::distribution::MatrixDistribution;
+using ppc::distribution::Partition;
+using ppc::distribution::Scheme;
+
+namespace {
+
+constexpr std::array<Scheme, 3> kAllSchemes = {Scheme::kBlock, Scheme::kCyclic, Scheme::kBlockCyclic};
+
+int WorldSize() {
+  int size = 1;
+  MPI_Comm_size(MPI_COMM_WORLD, &size);
+  return size;
+}
+
+int WorldRank() {
+  int rank = 0;
+  MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+  return rank;
+}
+
+std::vector<double> Iota(std::size_t count) {
+  std::vector<double> data(count);
+  std::iota(data.begin(), data.end(), 0.0);
+  return data;
+}
+
+/// Column sums of a matrix scattered in column strips; the result is gathered in PostProcessing.
+class ColumnSumTask : public ppc::task::Task<std::vector<double>, std::vector<double>> {
+ public:
+  static constexpr ppc::task::TypeOfTask GetStaticTypeOfTask() {
+    return ppc::task::TypeOfTask::kMPI;
+  }
+
+  ColumnSumTask(const std::vector<double> &in, std::size_t rows, std::size_t cols)
+      : matrix_(MatrixDistribution::ColumnStrips(rows, cols, WorldSize(), Scheme::kCyclic)),
+        sums_(Partition(cols, WorldSize(), Scheme::kCyclic)) {
+    SetTypeOfTask(GetStaticTypeOfTask());
+    GetInput() = in;
+  }
+
+ private:
+  bool ValidationImpl() override {
+    return GetInput().size() == matrix_.Rows() * matrix_.Cols();
+  }
+
+  bool PreProcessingImpl() override {
+    local_ = ppc::distribution::Scatter(matrix_, GetInput(), 0, MPI_COMM_WORLD);
+    return true;
+  }
+
+  bool RunImpl() override {
+    const std::size_t cols = matrix_.LocalCols(WorldRank());
+    local_sums_.assign(cols, 0.0);
+    for (std::size_t i = 0; i < local_.size(); i++) {
+      local_sums_[i % cols] += local_[i];
+    }
+    return true;
+  }
+
+  bool PostProcessingImpl() override {
+    GetOutput() = ppc::distribution::Allgather(sums_, local_sums_, MPI_COMM_WORLD);
+    return true;
+  }
+
+  MatrixDistribution matrix_;
+  Partition sums_;
+  std::vector<double> local_;
+  std::vector<double> local_sums_;
+};
+
+}  // namespace
+
+TEST(DistributionPartition, IndexMappingRoundTrips) {
+  for (const auto scheme : kAllSchemes) {
+    for (const std::size_t count : {0U, 1U, 7U, 64U, 103U}) {
+      for (const int parts : {1, 3, 4, 8}) {
+        const Partition partition(count, parts, scheme, 5);
+        std::size_t total = 0;
+        for (int part = 0; part < parts; part++) {
+          for (std::size_t local = 0; local < partition.LocalCount(part); local++) {
+            const std::size_t index = partition.ToGlobal(part, local);
+            ASSERT_EQ(partition.Owner(index), part);
+            ASSERT_EQ(partition.ToLocal(index), local);
+            if (local > 0) {
+              ASSERT_LT(partition.ToGlobal(part, local - 1), index);
+            }
+          }
+          total += partition.LocalCount(part);
+        }
+        EXPECT_EQ(total, count);
+      }
+    }
+  }
+}
+
+TEST(DistributionPartition, BlockCountsAndDispls) {
+  const Partition partition(10, 4);
+  EXPECT_EQ(partition.Counts(), (std::vector<int>{3, 3, 2, 2}));
+  EXPECT_EQ(partition.Displs(), (std::vector<int>{0, 3, 6, 8}));
+  EXPECT_THROW((void)Partition(10, 4, Scheme::kCyclic).Displs(), std::logic_error);
+}
+
+TEST(DistributionPartition, BlockCyclicDealsBlocksRoundRobin) {
+  const Partition partition(11, 2, Scheme::kBlockCyclic, 3);
+  const std::vector<int> owners = {0, 0, 0, 1, 1, 1, 0, 0, 0, 1, 1};
+  for (std::size_t i = 0; i < owners.size(); i++) {
+    EXPECT_EQ(partition.Owner(i), owners[i]);
+  }
+  EXPECT_EQ(partition.LocalCount(0), 6U);
+  EXPECT_EQ(partition.LocalCount(1), 5U);
+}
+
+TEST(DistributionPartition, RejectsInvalidArguments) {
+  EXPECT_THROW(Partition(10, 0), std::invalid_argument);
+  EXPECT_THROW(Partition(10, 2, Scheme::kBlockCyclic, 0), std::invalid_argument);
+  const Partition partition(10, 2);
+  EXPECT_THROW((void)partition.Owner(10), std::out_of_range);
+  EXPECT_THROW((void)partition.LocalCount(2), std::out_of_range);
+}
+
+TEST(DistributionMatrix, BlocksCoverEveryElementOnce) {
+  const auto dist = MatrixDistribution::Blocks(7, 9, 2, 3, Scheme::kBlockCyclic, 2);
+  std::vector<std::size_t> owned(static_cast<std::size_t>(dist.Parts()), 0);
+  for (std::size_t r = 0; r < dist.Rows(); r++) {
+    for (std::size_t c = 0; c < dist.Cols(); c++) {
+      owned[static_cast<std::size_t>(dist.Owner(r, c))]++;
+    }
+  }
+  for (int part = 0; part < dist.Parts(); part++) {
+    EXPECT_EQ(owned[static_cast<std::size_t>(part)], dist.LocalCount(part));
+  }
+}
+
+TEST(DistributionMPI, VectorScatterGatherRoundTrips) {
+  if (!ppc::util::MpiReady()) {
+    GTEST_SKIP() << "MPI is not initialized";
+  }
+  const int size = WorldSize();
+  const int root = size - 1;
+  const auto data = Iota(101);
+  for (const auto scheme : kAllSchemes) {
+    const Partition partition(data.size(), size, scheme, 4);
+    const auto local = ppc::distribution::Scatter(partition, data, root, MPI_COMM_WORLD);
+    ASSERT_EQ(local.size(), partition.LocalCount(WorldRank()));
+    for (std::size_t i = 0; i < local.size(); i++) {
+      ASSERT_EQ(local[i], static_cast<double>(partition.ToGlobal(WorldRank(), i)));
+    }
+    const auto gathered = ppc::distribution::Gather(partition, local, root, MPI_COMM_WORLD);
+    if (WorldRank() == root) {
+      EXPECT_EQ(gathered, data);
+    } else {
+      EXPECT_TRUE(gathered.empty());
+    }
+    EXPECT_EQ(ppc::distribution::Allgather(partition, local, MPI_COMM_WORLD), data);
+  }
+}
+
+TEST(DistributionMPI, MatrixScatterGatherRoundTrips) {
+  if (!ppc::util::MpiReady()) {
+    GTEST_SKIP() << "MPI is not initialized";
+  }
+  const int size = WorldSize();
+  std::array<int, 2> grid = {0, 0};
+  MPI_Dims_create(size, 2, grid.data());
+  constexpr std::size_t kRows = 13;
+  constexpr std::size_t kCols = 11;
+  const auto data = Iota(kRows * kCols);
+  for (const auto scheme : kAllSchemes) {
+    const std::vector<MatrixDistribution> layouts = {
+        MatrixDistribution::RowStrips(kRows, kCols, size, scheme, 2),
+        MatrixDistribution::ColumnStrips(kRows, kCols, size, scheme, 2),
+        MatrixDistribution::Blocks(kRows, kCols, grid[0], grid[1], scheme, 2)};
+    for (const auto &dist : layouts) {
+      const int rank = WorldRank();
+      const auto local = ppc::distribution::Scatter(dist, data, 0, MPI_COMM_WORLD);
+      ASSERT_EQ(local.size(), dist.LocalCount(rank));
+      const std::size_t local_cols = dist.LocalCols(rank);
+      for (std::size_t i = 0; i < local.size(); i++) {
+        const std::size_t row = dist.RowPartition().ToGlobal(dist.GridRow(rank), i / local_cols);
+        const std::size_t col = dist.ColPartition().ToGlobal(dist.GridCol(rank), i % local_cols);
+        ASSERT_EQ(local[i], static_cast<double>((row * kCols) + col));
+      }
+      EXPECT_EQ(ppc::distribution::Allgather(dist, local, MPI_COMM_WORLD), data);
+    }
+  }
+}
+
+TEST(DistributionMPI, RedistributeChangesLayout) {
+  if (!ppc::util::MpiReady()) {
+    GTEST_SKIP() << "MPI is not initialized";
+  }
+  const int size = WorldSize();
+  const auto data = Iota(97);
+  const Partition block(data.size(), size);
+  const Partition cyclic(data.size(), size, Scheme::kBlockCyclic, 3);
+  const auto local = ppc::distribution::Scatter(block, data, 0, MPI_COMM_WORLD);
+  const auto moved = ppc::distribution::Redistribute(block, cyclic, local, MPI_COMM_WORLD);
+  EXPECT_EQ(moved, ppc::distribution::Scatter(cyclic, data, 0, MPI_COMM_WORLD));
+
+  const auto rows = MatrixDistribution::RowStrips(9, 10, size);
+  const auto cols = MatrixDistribution::ColumnStrips(9, 10, size, Scheme::kCyclic);
+  const auto matrix = Iota(90);
+  const auto transposed = ppc::distribution::Redistribute(
+      rows, cols, ppc::distribution::Scatter(rows, matrix, 0, MPI_COMM_WORLD), MPI_COMM_WORLD);
+  EXPECT_EQ(transposed, ppc::distribution::Scatter(cols, matrix, 0, MPI_COMM_WORLD));
+}
+
+TEST(DistributionMPI, RejectsMismatchedCommunicator) {
+  if (!ppc::util::MpiReady()) {
+    GTEST_SKIP() << "MPI is not initialized";
+  }
+  const Partition partition(10, WorldSize() + 1);
+  EXPECT_THROW((void)ppc::distribution::Scatter(partition, Iota(10), 0, MPI_COMM_WORLD), std::invalid_argument);
+}
+
+TEST(DistributionMPI, RejectsWrongBufferSizeOnEveryRank) {
+  if (!ppc::util::MpiReady()) {
+    GTEST_SKIP() << "MPI is not initialized";
+  }
+  const int rank = WorldRank();
+  const Partition partition(10, WorldSize());
+  // Only the root reads the global buffer, yet every rank has to leave the call by the throw.
+  const auto global = rank == 0 ? Iota(9) : std::vector<double>{};
+  EXPECT_THROW((void)ppc::distribution::Scatter(partition, global, 0, MPI_COMM_WORLD), std::invalid_argument);
+  // A wrong local part on the last rank alone fails the gather everywhere.
+  auto local = ppc::distribution::Scatter(partition, Iota(10), 0, MPI_COMM_WORLD);
+  if (rank == WorldSize() - 1) {
+    local.push_back(0.0);
+  }
+  EXPECT_THROW((void)ppc::distribution::Gather(partition, local, 0, MPI_COMM_WORLD), std::invalid_argument);
+  EXPECT_THROW((void)ppc::distribution::Allgather(partition, local, MPI_COMM_WORLD), std::invalid_argument);
+}
+
+TEST(DistributionMPI, PlugsIntoTaskPipeline) {
+  if (!ppc::util::MpiReady()) {
+    GTEST_SKIP() << "MPI is not initialized";
+  }
+  constexpr std::size_t kRows = 6;
+  constexpr std::size_t kCols = 10;
+  const auto matrix = Iota(kRows * kCols);
+  ColumnSumTask task(matrix, kRows, kCols);
+  ASSERT_TRUE(task.Validation());
+  ASSERT_TRUE(task.PreProcessing());
+  ASSERT_TRUE(task.Run());
+  ASSERT_TRUE(task.PostProcessing());
+  ASSERT_EQ(task.GetOutput().size(), kCols);
+  for (std::size_t c = 0; c < kCols; c++) {
+    double expected = 0.0;
+    for (std::size_t r = 0; r < kRows; r++) {
+      expected += matrix[(r * kCols) + c];
+    }
+    EXPECT_EQ(task.GetOutput()[c], expected);
+  }
+}
@@ -0,0 +1,84 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "shared_memory/include/parallel_for.hpp"
+
+namespace ppc::gemm {
+
+/// @brief Parallel back-end of the outer GEMM loop.
+using Backend = ppc::shared_memory::Backend;
+using ppc::shared_memory::BackendToString;
+
+/// @brief Fast matrix multiplication scheme used above Tuning::strassen_cutoff.
+enum class FastScheme : uint8_t {
+  /// 7 products, 18 additions per level
+  kStrassen,
+  /// 7 products, 15 additions per level
+  kWinograd
+};
+
+/// @brief Returns the lower-case name of the scheme ("strassen", "winograd").
+std::string FastSchemeToString(FastScheme scheme);
+
+/// @brief Data cache sizes in bytes.
+struct CacheSizes {
+  std::size_t l1 = std::size_t{32} << 10;
+  std::size_t l2 = std::size_t{1} << 20;
+  std::size_t l3 = std::size_t{8} << 20;
+};
+
+/// @brief Cache sizes reported by the OS; the defaults of CacheSizes where it reports none.
+CacheSizes DetectCacheSizes();
+
+/// @brief Blocking of Gemm() and the recursion cutoff of FastMultiply().
+/// @details An mr x kc sliver of A and a kc x nr sliver of B stay in L1, the packed mc x kc block of A
+/// in L2 and the packed kc x nc panel of B in L3. Gemm() rounds mc and nc to the micro-tile.
+struct Tuning {
+  std::size_t mc = 0;
+  std::size_t kc = 0;
+  std::size_t nc = 0;
+  /// FastMultiply() falls back to Gemm() once min(m, n, k) is at or below this.
+  std::size_t strassen_cutoff = 512;
+};
+
+/// @brief Tuning derived from DetectCacheSizes() for the micro-kernel selected on this host.
+Tuning DefaultTuning();
+
+/// @brief Returns the tuning shared by all multiplications of this module (DefaultTuning() initially).
+Tuning &GetTuning();
+
+/// @brief Rows and columns of the register tile of the active micro-kernel.
+struct MicroTile {
+  std::size_t mr = 0;
+  std::size_t nr = 0;
+};
+
+/// @brief Register tile of the micro-kernel chosen by ppc::reduction::ActiveIsa() (AVX2 needs FMA).
+MicroTile ActiveMicroTile();
+
+/// @brief C = alpha * A * B + beta * C for row-major A (m x k), B (k x n) and C (m x n).
+/// @details Packed, cache-blocked GEMM in the Goto/BLIS scheme: the outer back-end splits the mc
+/// blocks of each packed B panel between workers. When @p beta is zero C is not read, so it may
+/// hold garbage.
+/// @param lda, ldb, ldc Row strides, at least k, n and n respectively.
+/// @throws std::invalid_argument When a stride is smaller than its row length.
+void Gemm(std::size_t m, std::size_t n, std::size_t k, double alpha, const double *a, std::size_t lda,
+          const double *b, std::size_t ldb, double beta, double *c, std::size_t ldc, Backend backend = Backend::kSeq);
+
+/// @brief C = A * B by Strassen or Winograd recursion down to Tuning::strassen_cutoff, then Gemm().
+/// @details Odd dimensions are handled by peeling the last row, column or inner index at each level.
+/// @throws std::invalid_argument When a stride is smaller than its row length.
+void FastMultiply(std::size_t m, std::size_t n, std::size_t k, const double *a, std::size_t lda, const double *b,
+                  std::size_t ldb, double *c, std::size_t ldc, Backend backend = Backend::kSeq,
+                  FastScheme scheme = FastScheme::kWinograd);
+
+/// @brief Returns A * B for dense row-major A (m x k) and B (k x n).
+/// @throws std::invalid_argument When the vector sizes do not match the dimensions.
+std::vector<double> Multiply(const std::vector<double> &a, const std::vector<double> &b, std::size_t m,
+                             std::size_t n, std::size_t k, Backend backend = Backend::kSeq);
+
+}  // namespace ppc::gemm
@@ -0,0 +1,148 @@
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include "gemm/include/gemm.hpp"
+#include "task/include/task.hpp"
+#include "util/include/perf_test_util.hpp"
+
+namespace ppc::gemm::perf {
+
+/// Square n x n operands of C = A * B.
+struct Problem {
+  std::size_t n = 0;
+  std::vector<double> a;
+  std::vector<double> b;
+};
+
+using InType = Problem;
+using OutType = std::vector<double>;
+
+enum class Algorithm : uint8_t { kGemm, kStrassen, kWinograd };
+
+constexpr ppc::task::TypeOfTask TaskTypeOf(Backend backend) {
+  switch (backend) {
+    case Backend::kSeq:
+      return ppc::task::TypeOfTask::kSEQ;
+    case Backend::kOmp:
+      return ppc::task::TypeOfTask::kOMP;
+    case Backend::kTbb:
+      return ppc::task::TypeOfTask::kTBB;
+    case Backend::kStl:
+      return ppc::task::TypeOfTask::kSTL;
+  }
+  return ppc::task::TypeOfTask::kUnknown;
+}
+
+template <Backend kBackend, Algorithm kAlgorithm>
+class GemmTask : public ppc::task::Task<InType, OutType> {
+ public:
+  static constexpr ppc::task::TypeOfTask GetStaticTypeOfTask() {
+    return TaskTypeOf(kBackend);
+  }
+
+  explicit GemmTask(const InType &in) {
+    SetTypeOfTask(GetStaticTypeOfTask());
+    GetInput() = in;
+  }
+
+ private:
+  bool ValidationImpl() override {
+    const auto &in = GetInput();
+    return in.n > 0 && in.a.size() == in.n * in.n && in.b.size() == in.n * in.n;
+  }
+
+  bool PreProcessingImpl() override {
+    GetOutput().assign(GetInput().n * GetInput().n, 0.0);
+    return true;
+  }
+
+  bool RunImpl() override {
+    const auto &in = GetInput();
+    const std::size_t n = in.n;
+    switch (kAlgorithm) {
+      case Algorithm::kGemm:
+        Gemm(n, n, n, 1.0, in.a.data(), n, in.b.data(), n, 0.0, GetOutput().data(), n, kBackend);
+        break;
+      case Algorithm::kStrassen:
+        FastMultiply(n, n, n, in.a.data(), n, in.b.data(), n, GetOutput().data(), n, kBackend, FastScheme::kStrassen);
+        break;
+      case Algorithm::kWinograd:
+        FastMultiply(n, n, n, in.a.data(), n, in.b.data(), n, GetOutput().data(), n, kBackend, FastScheme::kWinograd);
+        break;
+    }
+    return true;
+  }
+
+  bool PostProcessingImpl() override {
+    return true;
+  }
+};
+
+class GemmRunPerfTests : public ppc::util::BaseRunPerfTests<InType, OutType> {
+  // Above the default Strassen cutoff, so the fast schemes recurse once.
+  static constexpr std::size_t kN = 1024;
+  InType input_data_;
+
+  void SetUp() override {
+    input_data_ = {.n = kN, .a = std::vector<double>(kN * kN), .b = std::vector<double>(kN * kN)};
+    for (std::size_t i = 0; i < kN * kN; i++) {
+      input_data_.a[i] = static_cast<double>(i % 7) - 3.0;
+      input_data_.b[i] = static_cast<double>(i % 5) - 2.0;
+    }
+  }
+
+  bool CheckTestOutputData(OutType &output_data) final {
+    PrintRate("gflop_per_s", 2e-9 * static_cast<double>(kN * kN * kN));
+    if (output_data.size() != kN * kN) {
+      return false;
+    }
+    // Spot-check a diagonal of entries; the operands are small integers, so every scheme is exact.
+    for (std::size_t i = 0; i < kN; i += 97) {
+      const std::size_t j = (i * 31) % kN;
+      double expected = 0.0;
+      for (std::size_t l = 0; l < kN; l++) {
+        expected += input_data_.a[(i * kN) + l] * input_data_.b[(l * kN) + j];
+      }
+      if (std::abs(output_data[(i * kN) + j] - expected) > 1e-6) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  InType GetTestInputData() final {
+    return input_data_;
+  }
+};
+
+template <Backend kBackend, Algorithm kAlgorithm>
+auto MakeGemmPerfTasks(const std::string &algorithm) {
+  using TaskType = GemmTask<kBackend, kAlgorithm>;
+  const std::string name = "ppc_gemm_" + BackendToString(kBackend) + "_" + algorithm;
+  return ppc::util::MakeNamedPerfTaskTuples<TaskType, InType>(name);
+}
+
+template <Backend kBackend>
+auto MakeBackendSuite() {
+  return std::tuple_cat(MakeGemmPerfTasks<kBackend, Algorithm::kGemm>("gemm"),
+                        MakeGemmPerfTasks<kBackend, Algorithm::kStrassen>("strassen"),
+                        MakeGemmPerfTasks<kBackend, Algorithm::kWinograd>("winograd"));
+}
+
+TEST_P(GemmRunPerfTests, RunPerfModes) {
+  ExecuteTest(GetParam());
+}
+
+const auto kGemmPerfTasks = std::tuple_cat(MakeBackendSuite<Backend::kSeq>(), MakeBackendSuite<Backend::kOmp>(),
+                                           MakeBackendSuite<Backend::kTbb>(), MakeBackendSuite<Backend::kStl>());
+
+INSTANTIATE_TEST_SUITE_P(GemmKernels, GemmRunPerfTests, ppc::util::TupleToGTestValues(kGemmPerfTasks),
+                         GemmRunPerfTests::CustomPerfTestName);
+
+}  // namespace ppc::gemm::perf
@@ -0,0 +1,531 @@
+#include "gemm/include/gemm.hpp"
+
+#if __has_include(<unistd.h>)
+#include <unistd.h>
+#endif
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "reduction/include/reduction.hpp"
+#include "shared_memory/include/parallel_for.hpp"
+
+#ifdef PPC_TARGET_AVX2
+#define PPC_GEMM_X86 1
+#include <immintrin.h>
+// The AVX2 kernel also needs FMA, which reduction.hpp's PPC_TARGET_AVX2 does not enable.
+#define PPC_TARGET_AVX2_FMA __attribute__((target("avx2,fma")))
+#endif
+
+namespace ppc::gemm {
+
+namespace {
+
+/// Computes the full mr x nr tile C = beta * C + A_packed * B_packed (C is not read when beta is 0).
+using MicroKernelFn = void (*)(std::size_t kc, const double *a, const double *b, double *c, std::size_t ldc,
+                               double beta);
+
+/// Largest mr * nr of the kernels below.
+constexpr std::size_t kMaxTile = 8 * 16;
+
+struct MicroKernel {
+  std::size_t mr;
+  std::size_t nr;
+  MicroKernelFn run;
+};
+
+namespace scalar {
+
+constexpr std::size_t kMr = 4;
+constexpr std::size_t kNr = 8;
+
+void Kernel(std::size_t kc, const double *a, const double *b, double *c, std::size_t ldc, double beta) {
+  std::array<double, kMr * kNr> acc{};
+  for (std::size_t l = 0; l < kc; l++) {
+    for (std::size_t i = 0; i < kMr; i++) {
+      const double ai = a[(l * kMr) + i];
+      for (std::size_t j = 0; j < kNr; j++) {
+        acc[(i * kNr) + j] += ai * b[(l * kNr) + j];
+      }
+    }
+  }
+  for (std::size_t i = 0; i < kMr; i++) {
+    for (std::size_t j = 0; j < kNr; j++) {
+      double &out = c[(i * ldc) + j];
+      out = beta == 0.0 ? acc[(i * kNr) + j] : (beta * out) + acc[(i * kNr) + j];
+    }
+  }
+}
+
+constexpr MicroKernel kKernel = {.mr = kMr, .nr = kNr, .run = Kernel};
+
+}  // namespace scalar
+
+#ifdef PPC_GEMM_X86
+
+namespace avx2 {
+
+constexpr std::size_t kMr = 4;
+constexpr std::size_t kNr = 8;
+
+PPC_TARGET_AVX2_FMA void Kernel(std::size_t kc, const double *a, const double *b, double *c, std::size_t ldc,
+                                double beta) {
+  // C arrays: std::array<__m256d> would drop the vector type's alignment attribute.
+  __m256d lo[kMr];  // NOLINT(*-avoid-c-arrays)
+  __m256d hi[kMr];  // NOLINT(*-avoid-c-arrays)
+  for (std::size_t i = 0; i < kMr; i++) {
+    lo[i] = _mm256_setzero_pd();
+    hi[i] = _mm256_setzero_pd();
+  }
+  for (std::size_t l = 0; l < kc; l++) {
+    const __m256d b0 = _mm256_loadu_pd(b + (l * kNr));
+    const __m256d b1 = _mm256_loadu_pd(b + (l * kNr) + 4);
+    for (std::size_t i = 0; i < kMr; i++) {
+      const __m256d ai = _mm256_broadcast_sd(a + (l * kMr) + i);
+      lo[i] = _mm256_fmadd_pd(ai, b0, lo[i]);
+      hi[i] = _mm256_fmadd_pd(ai, b1, hi[i]);
+    }
+  }
+  const __m256d vbeta = _mm256_set1_pd(beta);
+  for (std::size_t i = 0; i < kMr; i++) {
+    double *row = c + (i * ldc);
+    if (beta != 0.0) {
+      lo[i] = _mm256_fmadd_pd(vbeta, _mm256_loadu_pd(row), lo[i]);
+      hi[i] = _mm256_fmadd_pd(vbeta, _mm256_loadu_pd(row + 4), hi[i]);
+    }
+    _mm256_storeu_pd(row, lo[i]);
+    _mm256_storeu_pd(row + 4, hi[i]);
+  }
+}
+
+constexpr MicroKernel kKernel = {.mr = kMr, .nr = kNr, .run = Kernel};
+
+}  // namespace avx2
+
+namespace avx512 {
+
+constexpr std::size_t kMr = 8;
+constexpr std::size_t kNr = 16;
+
+PPC_TARGET_AVX512 void Kernel(std::size_t kc, const double *a, const double *b, double *c, std::size_t ldc,
+                              double beta) {
+  // C arrays: std::array<__m512d> would drop the vector type's alignment attribute.
+  __m512d lo[kMr];  // NOLINT(*-avoid-c-arrays)
+  __m512d hi[kMr];  // NOLINT(*-avoid-c-arrays)
+  for (std::size_t i = 0; i < kMr; i++) {
+    lo[i] = _mm512_setzero_pd();
+    hi[i] = _mm512_setzero_pd();
+  }
+  for (std::size_t l = 0; l < kc; l++) {
+    const __m512d b0 = _mm512_loadu_pd(b + (l * kNr));
+    const __m512d b1 = _mm512_loadu_pd(b + (l * kNr) + 8);
+    for (std::size_t i = 0; i < kMr; i++) {
+      const __m512d ai = _mm512_set1_pd(a[(l * kMr) + i]);
+      lo[i] = _mm512_fmadd_pd(ai, b0, lo[i]);
+      hi[i] = _mm512_fmadd_pd(ai, b1, hi[i]);
+    }
+  }
+  const __m512d vbeta = _mm512_set1_pd(beta);
+  for (std::size_t i = 0; i < kMr; i++) {
+    double *row = c + (i * ldc);
+    if (beta != 0.0) {
+      lo[i] = _mm512_fmadd_pd(vbeta, _mm512_loadu_pd(row), lo[i]);
+      hi[i] = _mm512_fmadd_pd(vbeta, _mm512_loadu_pd(row + 8), hi[i]);
+    }
+    _mm512_storeu_pd(row, lo[i]);
+    _mm512_storeu_pd(row + 8, hi[i]);
+  }
+}
+
+constexpr MicroKernel kKernel = {.mr = kMr, .nr = kNr, .run = Kernel};
+
+}  // namespace avx512
+
+#endif  // PPC_GEMM_X86
+
+const MicroKernel &ActiveKernel() {
+#ifdef PPC_GEMM_X86
+  switch (ppc::reduction::ActiveIsa()) {
+    case ppc::reduction::Isa::kAvx512:
+      return avx512::kKernel;
+    case ppc::reduction::Isa::kAvx2:
+      return __builtin_cpu_supports("fma") != 0 ? avx2::kKernel : scalar::kKernel;
+    case ppc::reduction::Isa::kScalar:
+      return scalar::kKernel;
+  }
+#endif
+  return scalar::kKernel;
+}
+
+std::size_t RoundDown(std::size_t value, std::size_t step) {
+  return std::max(step, (value / step) * step);
+}
+
+std::size_t CeilDiv(std::size_t value, std::size_t step) {
+  return (value + step - 1) / step;
+}
+
+void CheckStrides(std::size_t m, std::size_t n, std::size_t k, std::size_t lda, std::size_t ldb, std::size_t ldc) {
+  if ((m > 0 && lda < k) || (k > 0 && ldb < n) || (m > 0 && ldc < n)) {
+    throw std::invalid_argument("gemm: row stride smaller than the row length");
+  }
+}
+
+/// Packs rows [0, rows) x columns [0, depth) of alpha * A into mr-row slivers, zero-padding the last one.
+void PackA(std::size_t rows, std::size_t depth, double alpha, const double *a, std::size_t lda, std::size_t mr,
+           double *packed) {
+  for (std::size_t i0 = 0; i0 < rows; i0 += mr) {
+    const std::size_t height = std::min(mr, rows - i0);
+    for (std::size_t l = 0; l < depth; l++) {
+      for (std::size_t i = 0; i < mr; i++) {
+        packed[(l * mr) + i] = i < height ? alpha * a[((i0 + i) * lda) + l] : 0.0;
+      }
+    }
+    packed += mr * depth;
+  }
+}
+
+/// Packs rows [0, depth) x columns [0, cols) of B into nr-column slivers, zero-padding the last one.
+void PackB(std::size_t depth, std::size_t cols, const double *b, std::size_t ldb, std::size_t nr, double *packed) {
+  for (std::size_t j0 = 0; j0 < cols; j0 += nr) {
+    const std::size_t width = std::min(nr, cols - j0);
+    for (std::size_t l = 0; l < depth; l++) {
+      const double *row = b + (l * ldb) + j0;
+      std::copy_n(row, width, packed + (l * nr));
+      std::fill_n(packed + (l * nr) + width, nr - width, 0.0);
+    }
+    packed += nr * depth;
+  }
+}
+
+/// Multiplies a packed mc x kc block of A by a packed kc x nc panel of B into C.
+void MacroKernel(const MicroKernel &kernel, std::size_t rows, std::size_t cols, std::size_t depth,
+                 const double *a_packed, const double *b_packed, double beta, double *c, std::size_t ldc) {
+  std::array<double, kMaxTile> edge{};
+  for (std::size_t j0 = 0; j0 < cols; j0 += kernel.nr) {
+    const std::size_t width = std::min(kernel.nr, cols - j0);
+    const double *b_sliver = b_packed + (j0 * depth);
+    for (std::size_t i0 = 0; i0 < rows; i0 += kernel.mr) {
+      const std::size_t height = std::min(kernel.mr, rows - i0);
+      const double *a_sliver = a_packed + (i0 * depth);
+      double *tile = c + (i0 * ldc) + j0;
+      if (height == kernel.mr && width == kernel.nr) {
+        kernel.run(depth, a_sliver, b_sliver, tile, ldc, beta);
+        continue;
+      }
+      kernel.run(depth, a_sliver, b_sliver, edge.data(), kernel.nr, 0.0);
+      for (std::size_t i = 0; i < height; i++) {
+        for (std::size_t j = 0; j < width; j++) {
+          double &out = tile[(i * ldc) + j];
+          out = beta == 0.0 ? edge[(i * kernel.nr) + j] : (beta * out) + edge[(i * kernel.nr) + j];
+        }
+      }
+    }
+  }
+}
+
+void ScaleC(std::size_t m, std::size_t n, double beta, double *c, std::size_t ldc) {
+  for (std::size_t i = 0; i < m; i++) {
+    for (std::size_t j = 0; j < n; j++) {
+      c[(i * ldc) + j] = beta == 0.0 ? 0.0 : beta * c[(i * ldc) + j];
+    }
+  }
+}
+
+/// out = sx * x + sy * y for h x w blocks.
+void Combine(std::size_t h, std::size_t w, double sx, const double *x, std::size_t ldx, double sy, const double *y,
+             std::size_t ldy, double *out, std::size_t ldo) {
+  for (std::size_t i = 0; i < h; i++) {
+    for (std::size_t j = 0; j < w; j++) {
+      out[(i * ldo) + j] = (sx * x[(i * ldx) + j]) + (sy * y[(i * ldy) + j]);
+    }
+  }
+}
+
+void Copy(std::size_t h, std::size_t w, const double *x, std::size_t ldx, double *out, std::size_t ldo) {
+  for (std::size_t i = 0; i < h; i++) {
+    std::copy_n(x + (i * ldx), w, out + (i * ldo));
+  }
+}
+
+/// out += s * x for h x w blocks.
+void AddTo(std::size_t h, std::size_t w, double s, const double *x, std::size_t ldx, double *out, std::size_t ldo) {
+  for (std::size_t i = 0; i < h; i++) {
+    for (std::size_t j = 0; j < w; j++) {
+      out[(i * ldo) + j] += s * x[(i * ldx) + j];
+    }
+  }
+}
+
+struct Operands {
+  const double *a;
+  std::size_t lda;
+  const double *b;
+  std::size_t ldb;
+  double *c;
+  std::size_t ldc;
+};
+
+void Fast(std::size_t m, std::size_t n, std::size_t k, const Operands &op, Backend backend, FastScheme scheme,
+          std::size_t cutoff);
+
+/// One level of Strassen's scheme on even m, n, k.
+void StrassenLevel(std::size_t hm, std::size_t hn, std::size_t hk, const Operands &op, Backend backend,
+                   std::size_t cutoff) {
+  const double *a11 = op.a;
+  const double *a12 = op.a + hk;
+  const double *a21 = op.a + (hm * op.lda);
+  const double *a22 = a21 + hk;
+  const double *b11 = op.b;
+  const double *b12 = op.b + hn;
+  const double *b21 = op.b + (hk * op.ldb);
+  const double *b22 = b21 + hn;
+  double *c11 = op.c;
+  double *c12 = op.c + hn;
+  double *c21 = op.c + (hm * op.ldc);
+  double *c22 = c21 + hn;
+  std::vector<double> ta(hm * hk);
+  std::vector<double> tb(hk * hn);
+  std::vector<double> p(hm * hn);
+  const auto product = [&](const double *x, std::size_t ldx, const double *y, std::size_t ldy) {
+    Fast(hm, hn, hk, {.a = x, .lda = ldx, .b = y, .ldb = ldy, .c = p.data(), .ldc = hn}, backend,
+         FastScheme::kStrassen, cutoff);
+  };
+  const std::size_t lda = op.lda;
+  const std::size_t ldb = op.ldb;
+  const std::size_t ldc = op.ldc;
+
+  Combine(hm, hk, 1.0, a11, lda, 1.0, a22, lda, ta.data(), hk);  // M1 = (A11 + A22)(B11 + B22)
+  Combine(hk, hn, 1.0, b11, ldb, 1.0, b22, ldb, tb.data(), hn);
+  product(ta.data(), hk, tb.data(), hn);
+  Copy(hm, hn, p.data(), hn, c11, ldc);
+  Copy(hm, hn, p.data(), hn, c22, ldc);
+  Combine(hm, hk, 1.0, a21, lda, 1.0, a22, lda, ta.data(), hk);  // M2 = (A21 + A22) B11
+  product(ta.data(), hk, b11, ldb);
+  Copy(hm, hn, p.data(), hn, c21, ldc);
+  AddTo(hm, hn, -1.0, p.data(), hn, c22, ldc);
+  Combine(hk, hn, 1.0, b12, ldb, -1.0, b22, ldb, tb.data(), hn);  // M3 = A11 (B12 - B22)
+  product(a11, lda, tb.data(), hn);
+  Copy(hm, hn, p.data(), hn, c12, ldc);
+  AddTo(hm, hn, 1.0, p.data(), hn, c22, ldc);
+  Combine(hk, hn, 1.0, b21, ldb, -1.0, b11, ldb, tb.data(), hn);  // M4 = A22 (B21 - B11)
+  product(a22, lda, tb.data(), hn);
+  AddTo(hm, hn, 1.0, p.data(), hn, c11, ldc);
+  AddTo(hm, hn, 1.0, p.data(), hn, c21, ldc);
+  Combine(hm, hk, 1.0, a11, lda, 1.0, a12, lda, ta.data(), hk);  // M5 = (A11 + A12) B22
+  product(ta.data(), hk, b22, ldb);
+  AddTo(hm, hn, -1.0, p.data(), hn, c11, ldc);
+  AddTo(hm, hn, 1.0, p.data(), hn, c12, ldc);
+  Combine(hm, hk, 1.0, a21, lda, -1.0, a11, lda, ta.data(), hk);  // M6 = (A21 - A11)(B11 + B12)
+  Combine(hk, hn, 1.0, b11, ldb, 1.0, b12, ldb, tb.data(), hn);
+  product(ta.data(), hk, tb.data(), hn);
+  AddTo(hm, hn, 1.0, p.data(), hn, c22, ldc);
+  Combine(hm, hk, 1.0, a12, lda, -1.0, a22, lda, ta.data(), hk);  // M7 = (A12 - A22)(B21 + B22)
+  Combine(hk, hn, 1.0, b21, ldb, 1.0, b22, ldb, tb.data(), hn);
+  product(ta.data(), hk, tb.data(), hn);
+  AddTo(hm, hn, 1.0, p.data(), hn, c11, ldc);
+}
+
+/// One level of the Winograd variant on even m, n, k.
+void WinogradLevel(std::size_t hm, std::size_t hn, std::size_t hk, const Operands &op, Backend backend,
+                   std::size_t cutoff) {
+  const double *a11 = op.a;
+  const double *a12 = op.a + hk;
+  const double *a21 = op.a + (hm * op.lda);
+  const double *a22 = a21 + hk;
+  const double *b11 = op.b;
+  const double *b12 = op.b + hn;
+  const double *b21 = op.b + (hk * op.ldb);
+  const double *b22 = b21 + hn;
+  double *c11 = op.c;
+  double *c12 = op.c + hn;
+  double *c21 = op.c + (hm * op.ldc);
+  double *c22 = c21 + hn;
+  const std::size_t lda = op.lda;
+  const std::size_t ldb = op.ldb;
+  const std::size_t ldc = op.ldc;
+
+  std::vector<double> s1(hm * hk);
+  std::vector<double> s2(hm * hk);
+  std::vector<double> s3(hm * hk);
+  std::vector<double> s4(hm * hk);
+  std::vector<double> t1(hk * hn);
+  std::vector<double> t2(hk * hn);
+  std::vector<double> t3(hk * hn);
+  std::vector<double> t4(hk * hn);
+  Combine(hm, hk, 1.0, a21, lda, 1.0, a22, lda, s1.data(), hk);
+  Combine(hm, hk, 1.0, s1.data(), hk, -1.0, a11, lda, s2.data(), hk);
+  Combine(hm, hk, 1.0, a11, lda, -1.0, a21, lda, s3.data(), hk);
+  Combine(hm, hk, 1.0, a12, lda, -1.0, s2.data(), hk, s4.data(), hk);
+  Combine(hk, hn, 1.0, b12, ldb, -1.0, b11, ldb, t1.data(), hn);
+  Combine(hk, hn, 1.0, b22, ldb, -1.0, t1.data(), hn, t2.data(), hn);
+  Combine(hk, hn, 1.0, b22, ldb, -1.0, b12, ldb, t3.data(), hn);
+  Combine(hk, hn, 1.0, t2.data(), hn, -1.0, b21, ldb, t4.data(), hn);
+
+  std::vector<double> p(hm * hn);
+  std::vector<double> u(hm * hn);
+  const auto product = [&](const double *x, std::size_t ldx, const double *y, std::size_t ldy) {
+    Fast(hm, hn, hk, {.a = x, .lda = ldx, .b = y, .ldb = ldy, .c = p.data(), .ldc = hn}, backend,
+         FastScheme::kWinograd, cutoff);
+  };
+  product(a11, lda, b11, ldb);  // P1
+  Copy(hm, hn, p.data(), hn, c11, ldc);
+  Copy(hm, hn, p.data(), hn, u.data(), hn);
+  product(a12, lda, b21, ldb);  // P2: C11 = P1 + P2
+  AddTo(hm, hn, 1.0, p.data(), hn, c11, ldc);
+  product(s2.data(), hk, t2.data(), hn);  // P6: U2 = P1 + P6
+  AddTo(hm, hn, 1.0, p.data(), hn, u.data(), hn);
+  Copy(hm, hn, u.data(), hn, c12, ldc);
+  product(s3.data(), hk, t3.data(), hn);  // P7: U3 = U2 + P7
+  Combine(hm, hn, 1.0, u.data(), hn, 1.0, p.data(), hn, c21, ldc);
+  Combine(hm, hn, 1.0, u.data(), hn, 1.0, p.data(), hn, c22, ldc);
+  product(s1.data(), hk, t1.data(), hn);  // P5: C12 = U2 + P5 + P3, C22 = U3 + P5
+  AddTo(hm, hn, 1.0, p.data(), hn, c12, ldc);
+  AddTo(hm, hn, 1.0, p.data(), hn, c22, ldc);
+  product(s4.data(), hk, b22, ldb);  // P3
+  AddTo(hm, hn, 1.0, p.data(), hn, c12, ldc);
+  product(a22, lda, t4.data(), hn);  // P4: C21 = U3 - P4
+  AddTo(hm, hn, -1.0, p.data(), hn, c21, ldc);
+}
+
+void Fast(std::size_t m, std::size_t n, std::size_t k, const Operands &op, Backend backend, FastScheme scheme,
+          std::size_t cutoff) {
+  if (std::min({m, n, k}) <= cutoff) {
+    Gemm(m, n, k, 1.0, op.a, op.lda, op.b, op.ldb, 0.0, op.c, op.ldc, backend);
+    return;
+  }
+  const std::size_t m2 = m & ~std::size_t{1};
+  const std::size_t n2 = n & ~std::size_t{1};
+  const std::size_t k2 = k & ~std::size_t{1};
+  switch (scheme) {
+    case FastScheme::kStrassen:
+      StrassenLevel(m2 / 2, n2 / 2, k2 / 2, op, backend, cutoff);
+      break;
+    case FastScheme::kWinograd:
+      WinogradLevel(m2 / 2, n2 / 2, k2 / 2, op, backend, cutoff);
+      break;
+  }
+  // Peel the odd remainders: the inner index as a rank-1 update, then the last column and row.
+  if (k2 < k) {
+    Gemm(m2, n2, 1, 1.0, op.a + k2, op.lda, op.b + (k2 * op.ldb), op.ldb, 1.0, op.c, op.ldc, backend);
+  }
+  if (n2 < n) {
+    Gemm(m, 1, k, 1.0, op.a, op.lda, op.b + n2, op.ldb, 0.0, op.c + n2, op.ldc, backend);
+  }
+  if (m2 < m) {
+    Gemm(1, n2, k, 1.0, op.a + (m2 * op.lda), op.lda, op.b, op.ldb, 0.0, op.c + (m2 * op.ldc), op.ldc, backend);
+  }
+}
+
+}  // namespace
+
+std::string FastSchemeToString(FastScheme scheme) {
+  switch (scheme) {
+    case FastScheme::kStrassen:
+      return "strassen";
+    case FastScheme::kWinograd:
+      return "winograd";
+  }
+  return "unknown";
+}
+
+CacheSizes DetectCacheSizes() {
+  CacheSizes sizes;
+#if defined(_SC_LEVEL1_DCACHE_SIZE) && defined(_SC_LEVEL2_CACHE_SIZE) && defined(_SC_LEVEL3_CACHE_SIZE)
+  const auto query = [](int name, std::size_t fallback) {
+    const long value = sysconf(name);
+    return value > 0 ? static_cast<std::size_t>(value) : fallback;
+  };
+  sizes.l1 = query(_SC_LEVEL1_DCACHE_SIZE, sizes.l1);
+  sizes.l2 = query(_SC_LEVEL2_CACHE_SIZE, sizes.l2);
+  sizes.l3 = query(_SC_LEVEL3_CACHE_SIZE, sizes.l3);
+#endif
+  return sizes;
+}
+
+Tuning DefaultTuning() {
+  const CacheSizes caches = DetectCacheSizes();
+  const MicroTile tile = ActiveMicroTile();
+  // Each level keeps half of its cache for C and for the slivers streaming through it.
+  Tuning tuning;
+  tuning.kc = RoundDown(caches.l1 / 2 / (tile.nr * sizeof(double)), 8);
+  tuning.mc = RoundDown(caches.l2 / 2 / (tuning.kc * sizeof(double)), tile.mr);
+  tuning.nc = RoundDown(caches.l3 / 2 / (tuning.kc * sizeof(double)), tile.nr);
+  return tuning;
+}
+
+Tuning &GetTuning() {
+  static Tuning tuning = DefaultTuning();
+  return tuning;
+}
+
+MicroTile ActiveMicroTile() {
+  const MicroKernel &kernel = ActiveKernel();
+  return {.mr = kernel.mr, .nr = kernel.nr};
+}
+
+void Gemm(std::size_t m, std::size_t n, std::size_t k, double alpha, const double *a, std::size_t lda,
+          const double *b, std::size_t ldb, double beta, double *c, std::size_t ldc, Backend backend) {
+  CheckStrides(m, n, k, lda, ldb, ldc);
+  if (m == 0 || n == 0) {
+    return;
+  }
+  if (k == 0 || alpha == 0.0) {
+    ScaleC(m, n, beta, c, ldc);
+    return;
+  }
+  const MicroKernel &kernel = ActiveKernel();
+  const Tuning &tuning = GetTuning();
+  const std::size_t kc = std::max<std::size_t>(tuning.kc, 1);
+  const std::size_t nc = RoundDown(tuning.nc, kernel.nr);
+  std::size_t mc = RoundDown(tuning.mc, kernel.mr);
+  if (backend != Backend::kSeq) {
+    // Give every worker at least one block of rows.
+    const auto workers = static_cast<std::size_t>(ppc::shared_memory::BackendWorkers(backend));
+    mc = std::min(mc, RoundDown(CeilDiv(CeilDiv(m, workers), kernel.mr) * kernel.mr, kernel.mr));
+  }
+
+  std::vector<double> b_packed(CeilDiv(std::min(nc, n), kernel.nr) * kernel.nr * kc);
+  for (std::size_t jc = 0; jc < n; jc += nc) {
+    const std::size_t cols = std::min(nc, n - jc);
+    for (std::size_t pc = 0; pc < k; pc += kc) {
+      const std::size_t depth = std::min(kc, k - pc);
+      const double beta_block = pc == 0 ? beta : 1.0;
+      PackB(depth, cols, b + (pc * ldb) + jc, ldb, kernel.nr, b_packed.data());
+      ppc::shared_memory::ParallelFor(CeilDiv(m, mc), backend, [&](std::size_t block) {
+        thread_local std::vector<double> a_packed;
+        const std::size_t ic = block * mc;
+        const std::size_t rows = std::min(mc, m - ic);
+        a_packed.resize(CeilDiv(rows, kernel.mr) * kernel.mr * depth);
+        PackA(rows, depth, alpha, a + (ic * lda) + pc, lda, kernel.mr, a_packed.data());
+        MacroKernel(kernel, rows, cols, depth, a_packed.data(), b_packed.data(), beta_block, c + (ic * ldc) + jc,
+                    ldc);
+      });
+    }
+  }
+}
+
+void FastMultiply(std::size_t m, std::size_t n, std::size_t k, const double *a, std::size_t lda, const double *b,
+                  std::size_t ldb, double *c, std::size_t ldc, Backend backend, FastScheme scheme) {
+  CheckStrides(m, n, k, lda, ldb, ldc);
+  const std::size_t cutoff = std::max<std::size_t>(GetTuning().strassen_cutoff, 1);
+  Fast(m, n, k, {.a = a, .lda = lda, .b = b, .ldb = ldb, .c = c, .ldc = ldc}, backend, scheme, cutoff);
+}
+
+std::vector<double> Multiply(const std::vector<double> &a, const std::vector<double> &b, std::size_t m,
+                             std::size_t n, std::size_t k, Backend backend) {
+  if (a.size() != m * k || b.size() != k * n) {
+    throw std::invalid_argument("gemm: matrix sizes do not match the dimensions");
+  }
+  std::vector<double> c(m * n);
+  Gemm(m, n, k, 1.0, a.data(), std::max<std::size_t>(k, 1), b.data(), std::max<std::size_t>(n, 1), 0.0, c.data(),
+       std::max<std::size_t>(n, 1), backend);
+  return c;
+}
+
+}  // namespace ppc::gemm
@@ -0,0 +1,165 @@
+#include <gtest/gtest.h>
+
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+#include "gemm/include/gemm.hpp"
+#include "reduction/include/reduction.hpp"
+
+using ppc::gemm::Backend;
+using ppc::gemm::FastScheme;
+
+namespace {
+
+constexpr std::array<Backend, 4> kAllBackends = {Backend::kSeq, Backend::kOmp, Backend::kTbb, Backend::kStl};
+
+std::vector<double> RandomMatrix(std::size_t count, unsigned seed) {
+  std::mt19937_64 gen(seed);
+  std::uniform_real_distribution<double> dist(-1.0, 1.0);
+  std::vector<double> data(count);
+  for (auto &value : data) {
+    value = dist(gen);
+  }
+  return data;
+}
+
+/// Reference C = alpha * A * B + beta * C with the given strides.
+void NaiveGemm(std::size_t m, std::size_t n, std::size_t k, double alpha, const double *a, std::size_t lda,
+               const double *b, std::size_t ldb, double beta, double *c, std::size_t ldc) {
+  for (std::size_t i = 0; i < m; i++) {
+    for (std::size_t j = 0; j < n; j++) {
+      double sum = 0.0;
+      for (std::size_t l = 0; l < k; l++) {
+        sum += a[(i * lda) + l] * b[(l * ldb) + j];
+      }
+      c[(i * ldc) + j] = (alpha * sum) + (beta == 0.0 ? 0.0 : beta * c[(i * ldc) + j]);
+    }
+  }
+}
+
+void ExpectClose(const std::vector<double> &actual, const std::vector<double> &expected, double tolerance) {
+  ASSERT_EQ(actual.size(), expected.size());
+  for (std::size_t i = 0; i < actual.size(); i++) {
+    ASSERT_NEAR(actual[i], expected[i], tolerance) << "at " << i;
+  }
+}
+
+/// Shrinks the blocking so small problems cross every mc/kc/nc boundary; restores it afterwards.
+class SmallBlocks {
+ public:
+  explicit SmallBlocks(std::size_t cutoff = 512) : saved_(ppc::gemm::GetTuning()) {
+    ppc::gemm::GetTuning() = {.mc = 16, .kc = 8, .nc = 32, .strassen_cutoff = cutoff};
+  }
+  SmallBlocks(const SmallBlocks &) = delete;
+  SmallBlocks &operator=(const SmallBlocks &) = delete;
+  ~SmallBlocks() {
+    ppc::gemm::GetTuning() = saved_;
+  }
+
+ private:
+  ppc::gemm::Tuning saved_;
+};
+
+class IsaGuard {
+ public:
+  explicit IsaGuard(ppc::reduction::Isa isa) : saved_(ppc::reduction::GetTuning().isa) {
+    ppc::reduction::GetTuning().isa = isa;
+  }
+  IsaGuard(const IsaGuard &) = delete;
+  IsaGuard &operator=(const IsaGuard &) = delete;
+  ~IsaGuard() {
+    ppc::reduction::GetTuning().isa = saved_;
+  }
+
+ private:
+  ppc::reduction::Isa saved_;
+};
+
+}  // namespace
+
+TEST(Gemm, DefaultTuningFitsCaches) {
+  const auto caches = ppc::gemm::DetectCacheSizes();
+  const auto tuning = ppc::gemm::DefaultTuning();
+  const auto tile = ppc::gemm::ActiveMicroTile();
+  EXPECT_GT(tuning.kc, 0U);
+  EXPECT_EQ(tuning.mc % tile.mr, 0U);
+  EXPECT_EQ(tuning.nc % tile.nr, 0U);
+  EXPECT_LE(tuning.kc * tile.nr * sizeof(double), caches.l1);
+  EXPECT_EQ(ppc::gemm::BackendToString(Backend::kTbb), "tbb");
+  EXPECT_EQ(ppc::gemm::FastSchemeToString(FastScheme::kWinograd), "winograd");
+}
+
+TEST(Gemm, MatchesNaiveOnEveryKernelAndBackend) {
+  const SmallBlocks blocks;
+  for (const auto isa : {ppc::reduction::Isa::kScalar, ppc::reduction::Isa::kAvx2, ppc::reduction::Isa::kAvx512}) {
+    const IsaGuard guard(isa);
+    for (const auto backend : kAllBackends) {
+      for (const std::array<std::size_t, 3> dims : {std::array<std::size_t, 3>{1, 1, 1}, {5, 3, 7}, {37, 41, 29},
+                                                    {64, 64, 64}, {33, 70, 19}}) {
+        const auto [m, n, k] = dims;
+        const auto a = RandomMatrix(m * k, 1);
+        const auto b = RandomMatrix(k * n, 2);
+        auto c = RandomMatrix(m * n, 3);
+        auto expected = c;
+        NaiveGemm(m, n, k, 0.5, a.data(), k, b.data(), n, -2.0, expected.data(), n);
+        ppc::gemm::Gemm(m, n, k, 0.5, a.data(), k, b.data(), n, -2.0, c.data(), n, backend);
+        ExpectClose(c, expected, 1e-12);
+      }
+    }
+  }
+}
+
+TEST(Gemm, HonoursStridesAndIgnoresCWhenBetaIsZero) {
+  const SmallBlocks blocks;
+  constexpr std::size_t kM = 23;
+  constexpr std::size_t kN = 17;
+  constexpr std::size_t kK = 13;
+  constexpr std::size_t kLd = 40;
+  const auto a = RandomMatrix(kM * kLd, 4);
+  const auto b = RandomMatrix(kK * kLd, 5);
+  std::vector<double> c(kM * kLd, std::numeric_limits<double>::quiet_NaN());
+  std::vector<double> expected(kM * kLd, std::numeric_limits<double>::quiet_NaN());
+  NaiveGemm(kM, kN, kK, 1.0, a.data(), kLd, b.data(), kLd, 0.0, expected.data(), kLd);
+  ppc::gemm::Gemm(kM, kN, kK, 1.0, a.data(), kLd, b.data(), kLd, 0.0, c.data(), kLd);
+  for (std::size_t i = 0; i < kM; i++) {
+    for (std::size_t j = 0; j < kLd; j++) {
+      if (j < kN) {
+        EXPECT_NEAR(c[(i * kLd) + j], expected[(i * kLd) + j], 1e-12);
+      } else {
+        EXPECT_TRUE(std::isnan(c[(i * kLd) + j])) << "wrote outside C at " << i << "," << j;
+      }
+    }
+  }
+}
+
+TEST(Gemm, FastMultiplyMatchesGemm) {
+  const SmallBlocks blocks(4);
+  for (const auto scheme : {FastScheme::kStrassen, FastScheme::kWinograd}) {
+    for (const auto backend : {Backend::kSeq, Backend::kOmp}) {
+      for (const std::array<std::size_t, 3> dims : {std::array<std::size_t, 3>{32, 32, 32}, {45, 38, 51}, {3, 9, 40}}) {
+        const auto [m, n, k] = dims;
+        const auto a = RandomMatrix(m * k, 6);
+        const auto b = RandomMatrix(k * n, 7);
+        std::vector<double> c(m * n);
+        ppc::gemm::FastMultiply(m, n, k, a.data(), k, b.data(), n, c.data(), n, backend, scheme);
+        ExpectClose(c, ppc::gemm::Multiply(a, b, m, n, k), 1e-10);
+      }
+    }
+  }
+}
+
+TEST(Gemm, RejectsInconsistentShapes) {
+  const std::vector<double> a(6);
+  const std::vector<double> b(6);
+  EXPECT_THROW((void)ppc::gemm::Multiply(a, b, 2, 2, 2), std::invalid_argument);
+  std::vector<double> c(4);
+  EXPECT_THROW(ppc::gemm::Gemm(2, 2, 3, 1.0, a.data(), 2, b.data(), 2, 0.0, c.data(), 2), std::invalid_argument);
+  EXPECT_TRUE(ppc::gemm::Multiply({}, {}, 0, 0, 0).empty());
+  const auto zero_depth = ppc::gemm::Multiply({}, {}, 2, 2, 0);
+  EXPECT_EQ(zero_depth, std::vector<double>(4, 0.0));
+}
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <compare>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace ppc::geometry {
+
+/// @brief Point of the plane; points compare lexicographically, by x and then by y.
+struct Point {
+  double x = 0.0;
+  double y = 0.0;
+
+  friend auto operator<=>(const Point &, const Point &) = default;
+};
+
+/// @brief Side of the directed line @p a -> @p b that @p c lies on: 1 to the left (a
+/// counter-clockwise turn), -1 to the right, 0 on the line.
+/// @details Exact: the determinant is evaluated in double precision and accepted when it exceeds
+/// the forward error bound (almost always); otherwise it is summed again as an expansion of exact
+/// products. The result is exact unless a product underflows or overflows.
+int Orientation(const Point &a, const Point &b, const Point &c);
+
+/// @brief Distribution of a random point cloud.
+enum class Cloud : uint8_t {
+  /// Uniform in the unit square; the hull has O(log n) vertices
+  kSquare,
+  /// Uniform in the unit disk; O(n^(1/3)) hull vertices
+  kDisk,
+  /// Standard normal in both coordinates; O(sqrt(log n)) hull vertices
+  kGaussian,
+  /// On the unit circle, rounded to doubles; most points are hull vertices
+  kCircle
+};
+
+/// @brief Returns the lower-case name of the cloud ("square", "disk", "gaussian", "circle").
+std::string CloudToString(Cloud cloud);
+
+/// @brief Returns @p count random points of the @p cloud distribution.
+std::vector<Point> RandomCloud(std::size_t count, Cloud cloud, std::uint64_t seed);
+
+}  // namespace ppc::geometry
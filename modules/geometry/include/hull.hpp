@@ -0,0 +1,95 @@
+#pragma once
+
+#include <mpi.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <vector>
+
+#include "geometry/include/geometry.hpp"
+#include "shared_memory/include/parallel_for.hpp"
+
+namespace ppc::geometry {
+
+using Backend = ppc::shared_memory::Backend;
+
+/// @brief Convex hull algorithm.
+enum class Algorithm : uint8_t {
+  /// Graham scan in Andrew's monotone chain form: every block is sorted and scanned on its own,
+  /// and the sub-hulls are merged pairwise in a tree
+  kGraham,
+  /// Jarvis march: every wrap step takes the most clockwise candidate of each block in parallel
+  /// and reduces them; O(n h) for h hull vertices
+  kJarvis
+};
+
+/// @brief Returns the lower-case name of the algorithm ("graham", "jarvis").
+std::string AlgorithmToString(Algorithm algorithm);
+
+struct Options {
+  Algorithm algorithm = Algorithm::kGraham;
+  /// Drops the points strictly inside the quadrilateral of the extreme points (Akl-Toussaint)
+  /// before the algorithm runs.
+  bool prefilter = true;
+  /// Blocks the points are split into; 0 takes one per worker of the back-end.
+  std::size_t blocks = 0;
+  Backend backend = Backend::kSeq;
+};
+
+struct Tuning {
+  /// Fewest points per block: smaller inputs are split into fewer blocks.
+  std::size_t min_block = std::size_t{1} << 12;
+};
+
+/// @brief Returns the tuning shared by all kernels of this module.
+Tuning &GetTuning();
+
+/// @brief Whether @p point lies inside or on the boundary of the convex polygon @p hull, given
+/// counter-clockwise as ConvexHull() returns it.
+bool Contains(std::span<const Point> hull, const Point &point);
+
+/// @brief Convex hull of @p points.
+/// @return The hull vertices counter-clockwise from the lexicographically smallest point, without
+/// collinear points: one point when all points coincide, two when they lie on a line, none for no
+/// points. Every algorithm and back-end returns the same vertices.
+/// @throws std::invalid_argument When a coordinate is not finite.
+std::vector<Point> ConvexHull(std::span<const Point> points, const Options &options = {});
+
+/// @brief Convex hull of the union of two convex hulls (or of any two point sets, in O(n log n)).
+std::vector<Point> MergeHulls(std::span<const Point> first, std::span<const Point> second);
+
+/// @brief Convex hull of the points of all ranks of @p comm, each holding its share in @p local.
+/// @details Every rank computes the hull of its share with ConvexHull(); the sub-hulls are
+/// gathered on every rank and merged there.
+/// @return The hull, the same on every rank.
+/// @throws std::invalid_argument On every rank when a coordinate of any rank is not finite.
+std::vector<Point> DistributedConvexHull(std::span<const Point> local, const Options &options, MPI_Comm comm);
+
+/// @brief Points with the component each belongs to.
+struct LabelledPoints {
+  std::vector<Point> points;
+  std::vector<std::size_t> labels;
+  std::size_t components = 0;
+};
+
+/// @brief Convex hulls of many point sets at once: point i belongs to component @p labels[i].
+/// @details The points are bucketed by component in parallel (counts per block, then a scatter),
+/// and the components are handed out to the workers, each hull computed sequentially with the
+/// algorithm of @p options.
+/// @return One hull per component, as ConvexHull() returns it.
+/// @throws std::invalid_argument When the sizes differ, a label is not below @p components, or a
+/// coordinate is not finite.
+std::vector<std::vector<Point>> ComponentHulls(std::span<const Point> points, std::span<const std::size_t> labels,
+                                               std::size_t components, const Options &options = {});
+
+/// @brief ComponentHulls() with the components split over the ranks of @p comm.
+/// @details Every rank holds all points and labels and computes the hulls of the components in
+/// its BlockRange share; the hulls are then gathered on every rank.
+/// @throws std::invalid_argument On every rank, for the cases of ComponentHulls().
+std::vector<std::vector<Point>> DistributedComponentHulls(std::span<const Point> points,
+                                                          std::span<const std::size_t> labels, std::size_t components,
+                                                          const Options &options, MPI_Comm comm);
+
+}  // namespace ppc::geometry
@@ -0,0 +1,113 @@
+#pragma once
+
+#include <mpi.h>
+
+#include <cstddef>
+#include <span>
+#include <vector>
+
+#include "geometry/include/geometry.hpp"
+#include "geometry/include/hull.hpp"
+#include "shared_memory/include/parallel_for.hpp"
+#include "shared_memory/include/shared_memory.hpp"
+#include "task/include/task.hpp"
+
+namespace ppc::geometry {
+
+/// @brief Convex hull of a point cloud as a course task on any back-end.
+/// @details The kMPI variant takes the BlockRange share of the points of its rank and runs
+/// DistributedConvexHull(); every rank holds the whole input, as in the course tasks.
+template <ppc::task::TypeOfTask kType, Algorithm kAlgorithm = Algorithm::kGraham>
+class ConvexHullTask : public ppc::task::Task<std::vector<Point>, std::vector<Point>> {
+ public:
+  using InType = std::vector<Point>;
+  using OutType = std::vector<Point>;
+
+  static constexpr ppc::task::TypeOfTask GetStaticTypeOfTask() {
+    return kType;
+  }
+
+  explicit ConvexHullTask(const InType &in) {
+    this->SetTypeOfTask(GetStaticTypeOfTask());
+    this->GetInput() = in;
+  }
+
+ private:
+  bool ValidationImpl() override {
+    return !this->GetInput().empty();
+  }
+
+  bool PreProcessingImpl() override {
+    return true;
+  }
+
+  bool RunImpl() override {
+    const InType &in = this->GetInput();
+    Options options;
+    options.algorithm = kAlgorithm;
+    options.backend = ppc::shared_memory::BackendOf(kType);
+    if constexpr (kType != ppc::task::TypeOfTask::kMPI) {
+      this->GetOutput() = ConvexHull(in, options);
+    } else {
+      int rank = 0;
+      int size = 1;
+      MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+      MPI_Comm_size(MPI_COMM_WORLD, &size);
+      const auto [begin, end] = ppc::shared_memory::BlockRange(in.size(), size, rank);
+      this->GetOutput() =
+          DistributedConvexHull(std::span<const Point>(in).subspan(begin, end - begin), options, MPI_COMM_WORLD);
+    }
+    return true;
+  }
+
+  bool PostProcessingImpl() override {
+    return !this->GetOutput().empty();
+  }
+};
+
+/// @brief Convex hulls of every component as a course task on any back-end; the kMPI variant
+/// splits the components over the ranks with DistributedComponentHulls().
+template <ppc::task::TypeOfTask kType, Algorithm kAlgorithm = Algorithm::kGraham>
+class ComponentHullsTask : public ppc::task::Task<LabelledPoints, std::vector<std::vector<Point>>> {
+ public:
+  using InType = LabelledPoints;
+  using OutType = std::vector<std::vector<Point>>;
+
+  static constexpr ppc::task::TypeOfTask GetStaticTypeOfTask() {
+    return kType;
+  }
+
+  explicit ComponentHullsTask(const InType &in) {
+    this->SetTypeOfTask(GetStaticTypeOfTask());
+    this->GetInput() = in;
+  }
+
+ private:
+  bool ValidationImpl() override {
+    const InType &in = this->GetInput();
+    return in.points.size() == in.labels.size() && in.components > 0;
+  }
+
+  bool PreProcessingImpl() override {
+    return true;
+  }
+
+  bool RunImpl() override {
+    const InType &in = this->GetInput();
+    Options options;
+    options.algorithm = kAlgorithm;
+    options.backend = ppc::shared_memory::BackendOf(kType);
+    if constexpr (kType != ppc::task::TypeOfTask::kMPI) {
+      this->GetOutput() = ComponentHulls(in.points, in.labels, in.components, options);
+    } else {
+      this->GetOutput() = DistributedComponentHulls(in.points, in.labels, in.components, options, MPI_COMM_WORLD);
+    }
+    return true;
+  }
+
+  bool PostProcessingImpl() override {
+    return this->GetOutput().size() == this->GetInput().components;
+  }
+};
+
+}  // namespace ppc::geometry
@@ -0,0 +1,143 @@
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include "geometry/include/geometry.hpp"
+#include "geometry/include/hull.hpp"
+#include "geometry/include/hull_task.hpp"
+#include "task/include/task.hpp"
+#include "util/include/perf_test_util.hpp"
+
+namespace ppc::geometry::perf {
+
+using ppc::task::TypeOfTask;
+
+namespace {
+
+// The clouds are shared by the cases of a suite: generating one costs more than a run. They hold
+// 10^6 to 10^7 points, which fits the memory of a course machine (10^8 points take 1.6 GB).
+
+constexpr std::size_t kMillion = 1'000'000;
+
+template <Cloud kCloud, std::size_t kCount>
+const std::vector<Point> &CloudPoints() {
+  static const std::vector<Point> kPoints = RandomCloud(kCount, kCloud, 1);
+  return kPoints;
+}
+
+/// 4096 unit-disk clusters of 256 points on average, scattered over a 1000 x 1000 square.
+const LabelledPoints &Clusters() {
+  static const LabelledPoints kClusters = [] {
+    constexpr std::size_t kComponents = 4096;
+    const std::vector<Point> centers = RandomCloud(kComponents, Cloud::kSquare, 2);
+    const std::vector<Point> offsets = RandomCloud(kMillion, Cloud::kDisk, 3);
+    LabelledPoints clusters{.points = {}, .labels = {}, .components = kComponents};
+    clusters.points.reserve(kMillion);
+    clusters.labels.reserve(kMillion);
+    for (std::size_t i = 0; i < kMillion; i++) {
+      const std::size_t label = (i * 2654435761U) % kComponents;
+      clusters.points.push_back(
+          {.x = (1000.0 * centers[label].x) + offsets[i].x, .y = (1000.0 * centers[label].y) + offsets[i].y});
+      clusters.labels.push_back(label);
+    }
+    return clusters;
+  }();
+  return kClusters;
+}
+
+}  // namespace
+
+/// Reports points per second, with the number of hull vertices.
+template <Cloud kCloud, std::size_t kCount>
+class ConvexHullPerfTests : public ppc::util::BaseRunPerfTests<std::vector<Point>, std::vector<Point>> {
+  bool CheckTestOutputData(std::vector<Point> &output_data) final {
+    PrintRate("mpoints_per_s", static_cast<double>(kCount) / 1e6);
+    PrintValue("vertices", static_cast<double>(output_data.size()));
+    return output_data.size() >= 3;
+  }
+
+  std::vector<Point> GetTestInputData() final {
+    return CloudPoints<kCloud, kCount>();
+  }
+};
+
+/// Reports points per second over all components, with the total number of hull vertices.
+class ComponentHullsPerfTests
+    : public ppc::util::BaseRunPerfTests<LabelledPoints, std::vector<std::vector<Point>>> {
+  bool CheckTestOutputData(std::vector<std::vector<Point>> &output_data) final {
+    std::size_t vertices = 0;
+    for (const std::vector<Point> &hull : output_data) {
+      vertices += hull.size();
+    }
+    PrintRate("mpoints_per_s", static_cast<double>(Clusters().points.size()) / 1e6);
+    PrintValue("vertices", static_cast<double>(vertices));
+    return output_data.size() == Clusters().components;
+  }
+
+  LabelledPoints GetTestInputData() final {
+    return Clusters();
+  }
+};
+
+/// Hull task of every back-end for one algorithm.
+template <template <TypeOfTask, Algorithm> class Task, Algorithm kAlgorithm>
+struct HullTasks {
+  template <TypeOfTask kType>
+  using Of = Task<kType, kAlgorithm>;
+};
+
+template <template <TypeOfTask, Algorithm> class Task, typename InType, Algorithm kAlgorithm>
+auto MakeBackendSuite(const std::string &input) {
+  const std::string kernel = AlgorithmToString(kAlgorithm) + "_" + input;
+  return ppc::util::MakeBackendPerfTaskTuples<HullTasks<Task, kAlgorithm>::template Of, InType>("ppc_geometry", kernel);
+}
+
+namespace {
+
+template <template <TypeOfTask, Algorithm> class Task, typename InType>
+auto MakeAlgorithmSuite(const std::string &input) {
+  return std::tuple_cat(MakeBackendSuite<Task, InType, Algorithm::kGraham>(input),
+                        MakeBackendSuite<Task, InType, Algorithm::kJarvis>(input));
+}
+
+}  // namespace
+
+using SquarePerfTests = ConvexHullPerfTests<Cloud::kSquare, kMillion>;
+using DiskPerfTests = ConvexHullPerfTests<Cloud::kDisk, kMillion>;
+using GaussianPerfTests = ConvexHullPerfTests<Cloud::kGaussian, 10 * kMillion>;
+
+TEST_P(SquarePerfTests, RunPerfModes) {
+  ExecuteTest(GetParam());
+}
+
+TEST_P(DiskPerfTests, RunPerfModes) {
+  ExecuteTest(GetParam());
+}
+
+TEST_P(GaussianPerfTests, RunPerfModes) {
+  ExecuteTest(GetParam());
+}
+
+TEST_P(ComponentHullsPerfTests, RunPerfModes) {
+  ExecuteTest(GetParam());
+}
+
+const auto kSquarePerfTasks = MakeAlgorithmSuite<ConvexHullTask, std::vector<Point>>("square");
+const auto kDiskPerfTasks = MakeAlgorithmSuite<ConvexHullTask, std::vector<Point>>("disk");
+const auto kGaussianPerfTasks = MakeAlgorithmSuite<ConvexHullTask, std::vector<Point>>("gaussian");
+const auto kComponentPerfTasks = MakeAlgorithmSuite<ComponentHullsTask, LabelledPoints>("components");
+
+INSTANTIATE_TEST_SUITE_P(HullSquare, SquarePerfTests, ppc::util::TupleToGTestValues(kSquarePerfTasks),
+                         SquarePerfTests::CustomPerfTestName);
+INSTANTIATE_TEST_SUITE_P(HullDisk, DiskPerfTests, ppc::util::TupleToGTestValues(kDiskPerfTasks),
+                         DiskPerfTests::CustomPerfTestName);
+INSTANTIATE_TEST_SUITE_P(HullGaussian, GaussianPerfTests, ppc::util::TupleToGTestValues(kGaussianPerfTasks),
+                         GaussianPerfTests::CustomPerfTestName);
+INSTANTIATE_TEST_SUITE_P(HullComponents, ComponentHullsPerfTests, ppc::util::TupleToGTestValues(kComponentPerfTasks),
+                         ComponentHullsPerfTests::CustomPerfTestName);
+
+}  // namespace ppc::geometry::perf
@@ -0,0 +1,148 @@
+#include "geometry/include/geometry.hpp"
+
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <numbers>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace ppc::geometry {
+
+namespace {
+
+/// Relative error bound of the double precision determinant, (3 + 16 eps) eps with eps = 2^-53.
+constexpr double kOrientationBound = (3.0 + (16.0 * 0x1p-53)) * 0x1p-53;
+
+/// A rounded result and its rounding error: value + error is exact.
+struct Exact {
+  double value;
+  double error;
+};
+
+Exact TwoSum(double a, double b) {
+  const double sum = a + b;
+  const double b_part = sum - a;
+  const double a_part = sum - b_part;
+  return {.value = sum, .error = (a - a_part) + (b - b_part)};
+}
+
+Exact TwoProduct(double a, double b) {
+  const double product = a * b;
+  return {.value = product, .error = std::fma(a, b, -product)};
+}
+
+/// Nonoverlapping expansion, components in increasing magnitude; the sign of the sum is that of
+/// the last component.
+class Expansion {
+ public:
+  /// Adds @p term exactly, dropping components that become zero.
+  void Add(double term) {
+    double carry = term;
+    std::size_t kept = 0;
+    for (std::size_t i = 0; i < size_; i++) {
+      const Exact sum = TwoSum(carry, components_[i]);
+      carry = sum.value;
+      if (sum.error != 0.0) {
+        components_[kept++] = sum.error;
+      }
+    }
+    if (carry != 0.0) {
+      components_[kept++] = carry;
+    }
+    size_ = kept;
+  }
+
+  void Add(Exact term) {
+    Add(term.error);
+    Add(term.value);
+  }
+
+  [[nodiscard]] int Sign() const {
+    if (size_ == 0) {
+      return 0;
+    }
+    return components_[size_ - 1] > 0.0 ? 1 : -1;
+  }
+
+ private:
+  /// Six exact products of two components each.
+  std::array<double, 12> components_{};
+  std::size_t size_ = 0;
+};
+
+/// The determinant expanded into the six products of coordinates, which are exact as two
+/// components each, while the differences of the fast path are not.
+int ExactOrientation(const Point &a, const Point &b, const Point &c) {
+  Expansion det;
+  det.Add(TwoProduct(b.x, c.y));
+  det.Add(TwoProduct(-b.x, a.y));
+  det.Add(TwoProduct(-a.x, c.y));
+  det.Add(TwoProduct(-b.y, c.x));
+  det.Add(TwoProduct(b.y, a.x));
+  det.Add(TwoProduct(a.y, c.x));
+  return det.Sign();
+}
+
+}  // namespace
+
+int Orientation(const Point &a, const Point &b, const Point &c) {
+  const double left = (b.x - a.x) * (c.y - a.y);
+  const double right = (b.y - a.y) * (c.x - a.x);
+  const double det = left - right;
+  const double bound = kOrientationBound * (std::abs(left) + std::abs(right));
+  if (det > bound) {
+    return 1;
+  }
+  if (-det > bound) {
+    return -1;
+  }
+  return ExactOrientation(a, b, c);
+}
+
+std::string CloudToString(Cloud cloud) {
+  switch (cloud) {
+    case Cloud::kSquare:
+      return "square";
+    case Cloud::kDisk:
+      return "disk";
+    case Cloud::kGaussian:
+      return "gaussian";
+    case Cloud::kCircle:
+      return "circle";
+  }
+  return "unknown";
+}
+
+std::vector<Point> RandomCloud(std::size_t count, Cloud cloud, std::uint64_t seed) {
+  std::mt19937_64 gen(seed);
+  std::uniform_real_distribution<double> unit(0.0, 1.0);
+  std::normal_distribution<double> normal(0.0, 1.0);
+  std::vector<Point> points(count);
+  for (Point &point : points) {
+    switch (cloud) {
+      case Cloud::kSquare:
+        point = {.x = unit(gen), .y = unit(gen)};
+        break;
+      case Cloud::kDisk: {
+        const double radius = std::sqrt(unit(gen));
+        const double angle = 2.0 * std::numbers::pi * unit(gen);
+        point = {.x = radius * std::cos(angle), .y = radius * std::sin(angle)};
+        break;
+      }
+      case Cloud::kGaussian:
+        point = {.x = normal(gen), .y = normal(gen)};
+        break;
+      case Cloud::kCircle: {
+        const double angle = 2.0 * std::numbers::pi * unit(gen);
+        point = {.x = std::cos(angle), .y = std::sin(angle)};
+        break;
+      }
+    }
+  }
+  return points;
+}
+
+}  // namespace ppc::geometry
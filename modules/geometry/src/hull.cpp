@@ -0,0 +1,406 @@
+#include "geometry/include/hull.hpp"
+
+#include <mpi.h>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "geometry/include/geometry.hpp"
+#include "shared_memory/include/parallel_for.hpp"
+#include "shared_memory/include/shared_memory.hpp"
+
+namespace ppc::geometry {
+
+namespace {
+
+using ppc::shared_memory::ParallelFor;
+
+bool AllFinite(std::span<const Point> points) {
+  return std::ranges::all_of(points, [](const Point &p) { return std::isfinite(p.x) && std::isfinite(p.y); });
+}
+
+void CheckFinite(std::span<const Point> points, const std::string &where) {
+  if (!AllFinite(points)) {
+    throw std::invalid_argument(where + ": coordinate is not finite");
+  }
+}
+
+/// Blocks of @p count points: Options::blocks or one per worker, with at least Tuning::min_block
+/// points each.
+std::size_t PartCount(const Options &options, std::size_t count) {
+  const std::size_t blocks = options.blocks != 0
+                                 ? options.blocks
+                                 : static_cast<std::size_t>(ppc::shared_memory::BackendWorkers(options.backend));
+  const std::size_t by_size = count / std::max<std::size_t>(GetTuning().min_block, 1);
+  return std::max<std::size_t>(std::min(blocks, by_size), 1);
+}
+
+std::span<const Point> Block(std::span<const Point> points, std::size_t parts, std::size_t part) {
+  const auto [begin, end] =
+      ppc::shared_memory::BlockRange(points.size(), static_cast<int>(parts), static_cast<int>(part));
+  return points.subspan(begin, end - begin);
+}
+
+/// Andrew's monotone chain over lexicographically sorted points, duplicates allowed: the lower
+/// chain left to right, then the upper one back, popping every non-left turn.
+std::vector<Point> ChainSorted(std::span<const Point> sorted) {
+  if (sorted.empty()) {
+    return {};
+  }
+  if (sorted.front() == sorted[sorted.size() - 1]) {
+    return {sorted.front()};
+  }
+  std::vector<Point> hull(2 * sorted.size());
+  std::size_t size = 0;
+  for (const Point &point : sorted) {
+    while (size >= 2 && Orientation(hull[size - 2], hull[size - 1], point) <= 0) {
+      size--;
+    }
+    hull[size++] = point;
+  }
+  const std::size_t lower = size + 1;
+  for (std::size_t i = sorted.size() - 1; i-- > 0;) {
+    while (size >= lower && Orientation(hull[size - 2], hull[size - 1], sorted[i]) <= 0) {
+      size--;
+    }
+    hull[size++] = sorted[i];
+  }
+  hull.resize(size - 1);
+  return hull;
+}
+
+/// Whether @p candidate lies beyond @p current on the ray from @p origin, given the three collinear.
+bool Farther(const Point &origin, const Point &current, const Point &candidate) {
+  if (current.x != origin.x) {
+    return current.x > origin.x ? candidate.x > current.x : candidate.x < current.x;
+  }
+  return current.y > origin.y ? candidate.y > current.y : candidate.y < current.y;
+}
+
+/// Whether @p candidate should replace @p current as the next vertex after @p origin: it lies to
+/// the right of origin -> current, or on that ray and farther.
+bool Better(const Point &origin, const Point &current, const Point &candidate) {
+  const int side = Orientation(origin, current, candidate);
+  return side < 0 || (side == 0 && Farther(origin, current, candidate));
+}
+
+struct Candidate {
+  Point point;
+  bool found = false;
+};
+
+Candidate WrapCandidate(const Point &origin, std::span<const Point> points) {
+  Candidate best;
+  for (const Point &point : points) {
+    if (point != origin && (!best.found || Better(origin, best.point, point))) {
+      best = {.point = point, .found = true};
+    }
+  }
+  return best;
+}
+
+std::vector<Point> JarvisMarch(const std::vector<std::vector<Point>> &parts, Backend backend) {
+  std::size_t total = 0;
+  Candidate start;
+  for (const std::vector<Point> &part : parts) {
+    total += part.size();
+    if (!part.empty()) {
+      const Point lowest = std::ranges::min(part);
+      if (!start.found || lowest < start.point) {
+        start = {.point = lowest, .found = true};
+      }
+    }
+  }
+  if (!start.found) {
+    return {};
+  }
+  std::vector<Point> hull = {start.point};
+  std::vector<Candidate> best(parts.size());
+  while (true) {
+    const Point origin = hull[hull.size() - 1];
+    ParallelFor(parts.size(), backend, [&](std::size_t part) { best[part] = WrapCandidate(origin, parts[part]); });
+    Candidate next;
+    for (const Candidate &candidate : best) {
+      if (candidate.found && (!next.found || Better(origin, next.point, candidate.point))) {
+        next = candidate;
+      }
+    }
+    if (!next.found || next.point == start.point) {
+      return hull;
+    }
+    if (hull.size() == total) {
+      throw std::runtime_error("ConvexHull: Jarvis march did not close");
+    }
+    hull.push_back(next.point);
+  }
+}
+
+/// Leftmost, lowest, rightmost and highest points, counter-clockwise.
+using Quadrilateral = std::array<Point, 4>;
+
+Quadrilateral ExtremePoints(std::span<const Point> points) {
+  const auto by_y = [](const Point &a, const Point &b) { return std::pair(a.y, a.x) < std::pair(b.y, b.x); };
+  Quadrilateral quad = {points[0], points[0], points[0], points[0]};
+  for (const Point &point : points) {
+    quad[0] = std::min(quad[0], point);
+    quad[1] = std::min(quad[1], point, by_y);
+    quad[2] = std::max(quad[2], point);
+    quad[3] = std::max(quad[3], point, by_y);
+  }
+  return quad;
+}
+
+bool StrictlyInside(const Quadrilateral &quad, const Point &point) {
+  return Orientation(quad[0], quad[1], point) > 0 && Orientation(quad[1], quad[2], point) > 0 &&
+         Orientation(quad[2], quad[3], point) > 0 && Orientation(quad[3], quad[0], point) > 0;
+}
+
+/// The points of every block that can be hull vertices: all of them, or those outside the
+/// quadrilateral of the extreme points (Akl-Toussaint), which is itself convex.
+std::vector<std::vector<Point>> Candidates(std::span<const Point> points, const Options &options, std::size_t parts) {
+  std::vector<std::vector<Point>> candidates(parts);
+  if (!options.prefilter) {
+    ParallelFor(parts, options.backend, [&](std::size_t part) {
+      const std::span<const Point> block = Block(points, parts, part);
+      candidates[part].assign(block.begin(), block.end());
+    });
+    return candidates;
+  }
+  std::vector<Quadrilateral> extremes(parts);
+  ParallelFor(parts, options.backend,
+              [&](std::size_t part) { extremes[part] = ExtremePoints(Block(points, parts, part)); });
+  std::vector<Point> corners;
+  for (const Quadrilateral &quad : extremes) {
+    corners.insert(corners.end(), quad.begin(), quad.end());
+  }
+  const Quadrilateral quad = ExtremePoints(corners);
+  ParallelFor(parts, options.backend, [&](std::size_t part) {
+    for (const Point &point : Block(points, parts, part)) {
+      if (!StrictlyInside(quad, point)) {
+        candidates[part].push_back(point);
+      }
+    }
+  });
+  return candidates;
+}
+
+/// ConvexHull() without the input check.
+std::vector<Point> Hull(std::span<const Point> points, const Options &options) {
+  if (points.empty()) {
+    return {};
+  }
+  const std::size_t parts = PartCount(options, points.size());
+  std::vector<std::vector<Point>> candidates = Candidates(points, options, parts);
+  if (options.algorithm == Algorithm::kJarvis) {
+    return JarvisMarch(candidates, options.backend);
+  }
+  std::vector<std::vector<Point>> hulls(parts);
+  ParallelFor(parts, options.backend, [&](std::size_t part) {
+    std::ranges::sort(candidates[part]);
+    hulls[part] = ChainSorted(candidates[part]);
+  });
+  while (hulls.size() > 1) {
+    std::vector<std::vector<Point>> merged((hulls.size() + 1) / 2);
+    ParallelFor(hulls.size() / 2, options.backend,
+                [&](std::size_t i) { merged[i] = MergeHulls(hulls[2 * i], hulls[(2 * i) + 1]); });
+    if (hulls.size() % 2 == 1) {
+      merged[merged.size() - 1] = std::move(hulls[hulls.size() - 1]);
+    }
+    hulls = std::move(merged);
+  }
+  return std::move(hulls[0]);
+}
+
+void CheckLabels(std::span<const Point> points, std::span<const std::size_t> labels, std::size_t components,
+                 const std::string &where) {
+  if (points.size() != labels.size()) {
+    throw std::invalid_argument(where + ": points and labels differ in size");
+  }
+  if (std::ranges::any_of(labels, [components](std::size_t label) { return label >= components; })) {
+    throw std::invalid_argument(where + ": label out of range");
+  }
+  CheckFinite(points, where);
+}
+
+std::vector<std::vector<Point>> ComponentHullsOf(std::span<const Point> points, std::span<const std::size_t> labels,
+                                                 std::size_t components, const Options &options) {
+  const std::size_t parts = PartCount(options, points.size());
+  // Bucket by component: counts per block, offsets component-major so that every block scatters
+  // its points of a component after those of the blocks before it.
+  std::vector<std::size_t> offsets(parts * components, 0);
+  ParallelFor(parts, options.backend, [&](std::size_t part) {
+    const auto [begin, end] =
+        ppc::shared_memory::BlockRange(points.size(), static_cast<int>(parts), static_cast<int>(part));
+    for (std::size_t i = begin; i < end; i++) {
+      offsets[(part * components) + labels[i]]++;
+    }
+  });
+  std::vector<std::size_t> starts(components + 1, 0);
+  std::size_t running = 0;
+  for (std::size_t component = 0; component < components; component++) {
+    starts[component] = running;
+    for (std::size_t part = 0; part < parts; part++) {
+      const std::size_t count = offsets[(part * components) + component];
+      offsets[(part * components) + component] = running;
+      running += count;
+    }
+  }
+  starts[components] = running;
+  std::vector<Point> bucketed(points.size());
+  ParallelFor(parts, options.backend, [&](std::size_t part) {
+    const auto [begin, end] =
+        ppc::shared_memory::BlockRange(points.size(), static_cast<int>(parts), static_cast<int>(part));
+    for (std::size_t i = begin; i < end; i++) {
+      bucketed[offsets[(part * components) + labels[i]]++] = points[i];
+    }
+  });
+  Options sequential = options;
+  sequential.backend = Backend::kSeq;
+  sequential.blocks = 1;
+  std::vector<std::vector<Point>> hulls(components);
+  ParallelFor(components, options.backend, [&](std::size_t component) {
+    hulls[component] =
+        Hull(std::span<const Point>(bucketed).subspan(starts[component], starts[component + 1] - starts[component]),
+             sequential);
+  });
+  return hulls;
+}
+
+/// Concatenation of the @p local points of every rank, in rank order.
+std::vector<Point> AllGatherPoints(const std::vector<Point> &local, MPI_Comm comm) {
+  int size = 1;
+  MPI_Comm_size(comm, &size);
+  const int bytes = static_cast<int>(local.size() * sizeof(Point));
+  std::vector<int> counts(static_cast<std::size_t>(size));
+  MPI_Allgather(&bytes, 1, MPI_INT, counts.data(), 1, MPI_INT, comm);
+  std::vector<int> displs(static_cast<std::size_t>(size), 0);
+  for (std::size_t r = 1; r < counts.size(); r++) {
+    displs[r] = displs[r - 1] + counts[r - 1];
+  }
+  std::vector<Point> all(static_cast<std::size_t>(displs[counts.size() - 1] + counts[counts.size() - 1]) /
+                         sizeof(Point));
+  MPI_Allgatherv(local.data(), bytes, MPI_BYTE, all.data(), counts.data(), displs.data(), MPI_BYTE, comm);
+  return all;
+}
+
+}  // namespace
+
+std::string AlgorithmToString(Algorithm algorithm) {
+  switch (algorithm) {
+    case Algorithm::kGraham:
+      return "graham";
+    case Algorithm::kJarvis:
+      return "jarvis";
+  }
+  return "unknown";
+}
+
+Tuning &GetTuning() {
+  static Tuning tuning;
+  return tuning;
+}
+
+bool Contains(std::span<const Point> hull, const Point &point) {
+  if (hull.size() <= 2) {
+    if (hull.empty()) {
+      return false;
+    }
+    const Point &first = hull.front();
+    const Point &last = hull[hull.size() - 1];
+    return Orientation(first, last, point) == 0 && std::min(first, last) <= point && point <= std::max(first, last);
+  }
+  for (std::size_t i = 0; i < hull.size(); i++) {
+    if (Orientation(hull[i], hull[(i + 1) % hull.size()], point) < 0) {
+      return false;
+    }
+  }
+  return true;
+}
+
+std::vector<Point> ConvexHull(std::span<const Point> points, const Options &options) {
+  CheckFinite(points, "ConvexHull");
+  return Hull(points, options);
+}
+
+std::vector<Point> MergeHulls(std::span<const Point> first, std::span<const Point> second) {
+  std::vector<Point> points;
+  points.reserve(first.size() + second.size());
+  points.insert(points.end(), first.begin(), first.end());
+  points.insert(points.end(), second.begin(), second.end());
+  std::ranges::sort(points);
+  return ChainSorted(points);
+}
+
+std::vector<Point> DistributedConvexHull(std::span<const Point> local, const Options &options, MPI_Comm comm) {
+  int finite = AllFinite(local) ? 1 : 0;
+  MPI_Allreduce(MPI_IN_PLACE, &finite, 1, MPI_INT, MPI_MIN, comm);
+  if (finite == 0) {
+    throw std::invalid_argument("DistributedConvexHull: coordinate is not finite");
+  }
+  std::vector<Point> hulls = AllGatherPoints(Hull(local, options), comm);
+  std::ranges::sort(hulls);
+  return ChainSorted(hulls);
+}
+
+std::vector<std::vector<Point>> ComponentHulls(std::span<const Point> points, std::span<const std::size_t> labels,
+                                               std::size_t components, const Options &options) {
+  CheckLabels(points, labels, components, "ComponentHulls");
+  return ComponentHullsOf(points, labels, components, options);
+}
+
+std::vector<std::vector<Point>> DistributedComponentHulls(std::span<const Point> points,
+                                                          std::span<const std::size_t> labels, std::size_t components,
+                                                          const Options &options, MPI_Comm comm) {
+  CheckLabels(points, labels, components, "DistributedComponentHulls");
+  int rank = 0;
+  int size = 1;
+  MPI_Comm_rank(comm, &rank);
+  MPI_Comm_size(comm, &size);
+  const auto [first, last] = ppc::shared_memory::BlockRange(components, size, rank);
+  std::vector<Point> mine;
+  std::vector<std::size_t> mine_labels;
+  for (std::size_t i = 0; i < points.size(); i++) {
+    if (labels[i] >= first && labels[i] < last) {
+      mine.push_back(points[i]);
+      mine_labels.push_back(labels[i] - first);
+    }
+  }
+  const std::vector<std::vector<Point>> local = ComponentHullsOf(mine, mine_labels, last - first, options);
+
+  // Hull sizes first, in component order since the shares are consecutive, then the vertices.
+  std::vector<std::uint64_t> local_sizes;
+  std::vector<Point> flat;
+  for (const std::vector<Point> &hull : local) {
+    local_sizes.push_back(hull.size());
+    flat.insert(flat.end(), hull.begin(), hull.end());
+  }
+  std::vector<int> counts(static_cast<std::size_t>(size));
+  std::vector<int> displs(static_cast<std::size_t>(size));
+  for (int r = 0; r < size; r++) {
+    const auto [begin, end] = ppc::shared_memory::BlockRange(components, size, r);
+    counts[static_cast<std::size_t>(r)] = static_cast<int>(end - begin);
+    displs[static_cast<std::size_t>(r)] = static_cast<int>(begin);
+  }
+  std::vector<std::uint64_t> sizes(components);
+  MPI_Allgatherv(local_sizes.data(), static_cast<int>(local_sizes.size()), MPI_UINT64_T, sizes.data(), counts.data(),
+                 displs.data(), MPI_UINT64_T, comm);
+  const std::vector<Point> vertices = AllGatherPoints(flat, comm);
+  std::vector<std::vector<Point>> hulls(components);
+  std::size_t offset = 0;
+  for (std::size_t component = 0; component < components; component++) {
+    hulls[component].assign(vertices.begin() + static_cast<std::ptrdiff_t>(offset),
+                            vertices.begin() + static_cast<std::ptrdiff_t>(offset + sizes[component]));
+    offset += sizes[component];
+  }
+  return hulls;
+}
+
+}  // namespace ppc::geometry
@@ -0,0 +1,253 @@
+#include <gtest/gtest.h>
+#include <mpi.h>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+#include "geometry/include/geometry.hpp"
+#include "geometry/include/hull.hpp"
+#include "geometry/include/hull_task.hpp"
+#include "shared_memory/include/parallel_for.hpp"
+#include "shared_memory/include/shared_memory.hpp"
+#include "task/include/task.hpp"
+#include "util/include/func_test_util.hpp"
+
+using ppc::geometry::Algorithm;
+using ppc::geometry::Backend;
+using ppc::geometry::Cloud;
+using ppc::geometry::Point;
+using ppc::task::TypeOfTask;
+
+namespace {
+
+constexpr std::array<Backend, 4> kAllBackends = {Backend::kSeq, Backend::kOmp, Backend::kTbb, Backend::kStl};
+constexpr std::array<Algorithm, 2> kAllAlgorithms = {Algorithm::kGraham, Algorithm::kJarvis};
+constexpr std::array<Cloud, 4> kAllClouds = {Cloud::kSquare, Cloud::kDisk, Cloud::kGaussian, Cloud::kCircle};
+
+/// Counter-clockwise from the smallest point, strictly convex, and containing every point.
+void ExpectHullOf(const std::vector<Point> &hull, std::span<const Point> points) {
+  ASSERT_FALSE(hull.empty());
+  EXPECT_EQ(hull.front(), *std::ranges::min_element(points));
+  if (hull.size() >= 3) {
+    for (std::size_t i = 0; i < hull.size(); i++) {
+      ASSERT_GT(ppc::geometry::Orientation(hull[i], hull[(i + 1) % hull.size()], hull[(i + 2) % hull.size()]), 0)
+          << "at " << i;
+    }
+  }
+  for (const Point &point : points) {
+    ASSERT_TRUE(ppc::geometry::Contains(hull, point)) << point.x << " " << point.y;
+  }
+}
+
+/// Small blocks, so that the test inputs split into several of them.
+class SmallBlocks {
+ public:
+  SmallBlocks() : saved_(ppc::geometry::GetTuning().min_block) {
+    ppc::geometry::GetTuning().min_block = 16;
+  }
+  ~SmallBlocks() {
+    ppc::geometry::GetTuning().min_block = saved_;
+  }
+  SmallBlocks(const SmallBlocks &) = delete;
+  SmallBlocks &operator=(const SmallBlocks &) = delete;
+
+ private:
+  std::size_t saved_;
+};
+
+}  // namespace
+
+TEST(Geometry, OrientationIsExactNearDegenerateInputs) {
+  // Kettner et al.: points a few ulps around the diagonal through (12, 12) and (24, 24), where the
+  // rounded determinant takes the wrong sign; the exact one is that of y - x.
+  const Point q{.x = 12.0, .y = 12.0};
+  const Point r{.x = 24.0, .y = 24.0};
+  for (int i = 0; i < 32; i++) {
+    for (int j = 0; j < 32; j++) {
+      const Point p{.x = 0.5 + std::ldexp(i, -53), .y = 0.5 + std::ldexp(j, -53)};
+      const int expected = (j > i) - (j < i);
+      ASSERT_EQ(ppc::geometry::Orientation(p, q, r), expected) << i << " " << j;
+      ASSERT_EQ(ppc::geometry::Orientation(p, r, q), -expected) << i << " " << j;
+      ASSERT_EQ(ppc::geometry::Orientation(q, r, p), expected) << i << " " << j;
+    }
+  }
+  EXPECT_EQ(ppc::geometry::Orientation({.x = 0.0, .y = 0.0}, {.x = 1.0, .y = 0.0}, {.x = 0.0, .y = 1.0}), 1);
+  EXPECT_EQ(ppc::geometry::Orientation({.x = 0.0, .y = 0.0}, {.x = 0.0, .y = 1.0}, {.x = 1.0, .y = 0.0}), -1);
+  EXPECT_EQ(ppc::geometry::Orientation({.x = 0.1, .y = 0.3}, {.x = 0.1, .y = 0.3}, {.x = 7.0, .y = 5.0}), 0);
+}
+
+TEST(Geometry, EveryAlgorithmAndBackendGivesTheSameHull) {
+  const SmallBlocks small_blocks;
+  for (const Cloud cloud : kAllClouds) {
+    const std::vector<Point> points = ppc::geometry::RandomCloud(3000, cloud, 7);
+    const std::vector<Point> reference = ppc::geometry::ConvexHull(points, {.prefilter = false});
+    ExpectHullOf(reference, points);
+    EXPECT_GE(reference.size(), 3U) << ppc::geometry::CloudToString(cloud);
+    for (const Algorithm algorithm : kAllAlgorithms) {
+      for (const Backend backend : kAllBackends) {
+        for (const bool prefilter : {false, true}) {
+          for (const std::size_t blocks : {0, 1, 5}) {
+            EXPECT_EQ(ppc::geometry::ConvexHull(points, {.algorithm = algorithm,
+                                                         .prefilter = prefilter,
+                                                         .blocks = blocks,
+                                                         .backend = backend}),
+                      reference)
+                << ppc::geometry::CloudToString(cloud) << " " << ppc::geometry::AlgorithmToString(algorithm) << " "
+                << ppc::shared_memory::BackendToString(backend) << " " << prefilter << " " << blocks;
+          }
+        }
+      }
+    }
+  }
+}
+
+TEST(Geometry, DegenerateInputsGiveCanonicalHulls) {
+  const SmallBlocks small_blocks;
+  const Point origin{.x = 0.0, .y = 0.0};
+  // The corners of a square, with duplicates and points along its edges and inside.
+  std::vector<Point> square;
+  for (int i = 0; i <= 8; i++) {
+    const double t = i / 8.0;
+    square.insert(square.end(), {{.x = t, .y = 0.0}, {.x = 1.0, .y = t}, {.x = t, .y = 1.0}, {.x = 0.0, .y = t}});
+    square.push_back({.x = t, .y = 1.0 - t});
+  }
+  std::vector<Point> line;
+  for (int i = 40; i >= 0; i--) {
+    line.push_back({.x = 3.0 * i, .y = -2.0 * i});
+  }
+  const std::vector<Point> same(50, {.x = 2.5, .y = -1.0});
+  for (const Algorithm algorithm : kAllAlgorithms) {
+    for (const Backend backend : kAllBackends) {
+      const ppc::geometry::Options options{.algorithm = algorithm, .backend = backend};
+      EXPECT_TRUE(ppc::geometry::ConvexHull({}, options).empty());
+      EXPECT_EQ(ppc::geometry::ConvexHull(same, options), std::vector<Point>{same.front()});
+      EXPECT_EQ(ppc::geometry::ConvexHull(line, options),
+                (std::vector<Point>{{.x = 0.0, .y = 0.0}, {.x = 120.0, .y = -80.0}}));
+      EXPECT_EQ(ppc::geometry::ConvexHull(square, options),
+                (std::vector<Point>{origin, {.x = 1.0, .y = 0.0}, {.x = 1.0, .y = 1.0}, {.x = 0.0, .y = 1.0}}));
+    }
+  }
+  EXPECT_TRUE(ppc::geometry::Contains(std::vector<Point>{origin, {.x = 2.0, .y = 2.0}}, {.x = 1.0, .y = 1.0}));
+  EXPECT_FALSE(ppc::geometry::Contains(std::vector<Point>{origin, {.x = 2.0, .y = 2.0}}, {.x = 3.0, .y = 3.0}));
+  const std::vector<Point> bad = {origin, {.x = std::numeric_limits<double>::quiet_NaN(), .y = 0.0}};
+  EXPECT_THROW((void)ppc::geometry::ConvexHull(bad), std::invalid_argument);
+}
+
+TEST(Geometry, MergedSubHullsGiveTheHullOfTheUnion) {
+  const std::vector<Point> points = ppc::geometry::RandomCloud(2000, Cloud::kDisk, 3);
+  const std::span<const Point> all(points);
+  for (const std::size_t split : {std::size_t{1}, std::size_t{700}, std::size_t{1999}}) {
+    const auto first = ppc::geometry::ConvexHull(all.first(split));
+    const auto second = ppc::geometry::ConvexHull(all.subspan(split));
+    EXPECT_EQ(ppc::geometry::MergeHulls(first, second), ppc::geometry::ConvexHull(points)) << split;
+  }
+}
+
+TEST(Geometry, ComponentHullsMatchTheHullOfEveryComponent) {
+  const SmallBlocks small_blocks;
+  constexpr std::size_t kComponents = 37;
+  const std::vector<Point> points = ppc::geometry::RandomCloud(5000, Cloud::kGaussian, 11);
+  std::mt19937_64 gen(5);
+  std::vector<std::size_t> labels(points.size());
+  for (std::size_t &label : labels) {
+    // Component 36 stays empty and 0 gets a point in ten.
+    label = 1 + (gen() % (kComponents - 2));
+    if (gen() % 10 == 0) {
+      label = 0;
+    }
+  }
+  std::vector<std::vector<Point>> expected(kComponents);
+  for (std::size_t component = 0; component < kComponents; component++) {
+    std::vector<Point> members;
+    for (std::size_t i = 0; i < points.size(); i++) {
+      if (labels[i] == component) {
+        members.push_back(points[i]);
+      }
+    }
+    expected[component] = ppc::geometry::ConvexHull(members);
+  }
+  EXPECT_TRUE(expected[kComponents - 1].empty());
+  for (const Algorithm algorithm : kAllAlgorithms) {
+    for (const Backend backend : kAllBackends) {
+      const ppc::geometry::Options options{.algorithm = algorithm, .backend = backend};
+      EXPECT_EQ(ppc::geometry::ComponentHulls(points, labels, kComponents, options), expected)
+          << ppc::geometry::AlgorithmToString(algorithm) << " " << ppc::shared_memory::BackendToString(backend);
+    }
+  }
+  EXPECT_THROW((void)ppc::geometry::ComponentHulls(points, labels, kComponents - 2), std::invalid_argument);
+  EXPECT_THROW((void)ppc::geometry::ComponentHulls(points, std::span(labels).first(10), kComponents),
+               std::invalid_argument);
+}
+
+TEST(Geometry, DistributedHullsMatchTheSequentialOnes) {
+  if (!ppc::util::MpiReady()) {
+    GTEST_SKIP() << "MPI is not initialized";
+  }
+  int rank = 0;
+  int size = 1;
+  MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+  MPI_Comm_size(MPI_COMM_WORLD, &size);
+  const std::vector<Point> points = ppc::geometry::RandomCloud(4000, Cloud::kDisk, 13);
+  const auto [begin, end] = ppc::shared_memory::BlockRange(points.size(), size, rank);
+  const std::span<const Point> local = std::span<const Point>(points).subspan(begin, end - begin);
+  for (const Algorithm algorithm : kAllAlgorithms) {
+    EXPECT_EQ(ppc::geometry::DistributedConvexHull(local, {.algorithm = algorithm}, MPI_COMM_WORLD),
+              ppc::geometry::ConvexHull(points));
+  }
+  std::vector<std::size_t> labels(points.size());
+  for (std::size_t i = 0; i < points.size(); i++) {
+    labels[i] = (i * 7) % 23;
+  }
+  EXPECT_EQ(ppc::geometry::DistributedComponentHulls(points, labels, 23, {}, MPI_COMM_WORLD),
+            ppc::geometry::ComponentHulls(points, labels, 23));
+  std::vector<Point> bad(local.begin(), local.end());
+  if (rank == size - 1) {
+    bad.push_back({.x = std::numeric_limits<double>::infinity(), .y = 0.0});
+  }
+  EXPECT_THROW((void)ppc::geometry::DistributedConvexHull(bad, {}, MPI_COMM_WORLD), std::invalid_argument);
+}
+
+namespace {
+
+template <TypeOfTask kType, Algorithm kAlgorithm>
+void RunHullTasks() {
+  const std::vector<Point> points = ppc::geometry::RandomCloud(3000, Cloud::kSquare, 17);
+  ppc::geometry::ConvexHullTask<kType, kAlgorithm> task(points);
+  ASSERT_TRUE(task.Validation());
+  ASSERT_TRUE(task.PreProcessing());
+  ASSERT_TRUE(task.Run());
+  ASSERT_TRUE(task.PostProcessing());
+  EXPECT_EQ(task.GetOutput(), ppc::geometry::ConvexHull(points));
+
+  ppc::geometry::LabelledPoints labelled{.points = points, .labels = {}, .components = 10};
+  for (std::size_t i = 0; i < points.size(); i++) {
+    labelled.labels.push_back(static_cast<std::size_t>(points[i].x * 10.0));
+  }
+  ppc::geometry::ComponentHullsTask<kType, kAlgorithm> components_task(labelled);
+  ASSERT_TRUE(components_task.Validation());
+  ASSERT_TRUE(components_task.PreProcessing());
+  ASSERT_TRUE(components_task.Run());
+  ASSERT_TRUE(components_task.PostProcessing());
+  EXPECT_EQ(components_task.GetOutput(), ppc::geometry::ComponentHulls(points, labelled.labels, 10));
+}
+
+}  // namespace
+
+TEST(Geometry, TasksMatchTheSequentialHullOnEveryBackend) {
+  RunHullTasks<TypeOfTask::kSEQ, Algorithm::kGraham>();
+  RunHullTasks<TypeOfTask::kOMP, Algorithm::kJarvis>();
+  RunHullTasks<TypeOfTask::kTBB, Algorithm::kGraham>();
+  RunHullTasks<TypeOfTask::kSTL, Algorithm::kJarvis>();
+  if (ppc::util::MpiReady()) {
+    RunHullTasks<TypeOfTask::kMPI, Algorithm::kGraham>();
+    RunHullTasks<TypeOfTask::kMPI, Algorithm::kJarvis>();
+  }
+}
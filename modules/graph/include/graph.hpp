@@ -0,0 +1,78 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <vector>
+
+namespace ppc::graph {
+
+/// @brief Weighted directed graph in compressed row storage.
+/// @details The out-edges of vertex v are offsets[v] .. offsets[v + 1] - 1 of targets and weights,
+/// with strictly increasing targets. A strip of vertices [first, first + vertices) of a larger
+/// graph (see SliceVertices()) keeps global target indices.
+struct Graph {
+  std::size_t vertices = 0;
+  std::vector<std::size_t> offsets = {0};
+  std::vector<std::size_t> targets;
+  std::vector<double> weights;
+
+  [[nodiscard]] std::size_t Edges() const {
+    return targets.size();
+  }
+  [[nodiscard]] std::span<const std::size_t> Targets(std::size_t v) const {
+    return std::span<const std::size_t>(targets).subspan(offsets[v], offsets[v + 1] - offsets[v]);
+  }
+  [[nodiscard]] std::span<const double> Weights(std::size_t v) const {
+    return std::span<const double>(weights).subspan(offsets[v], offsets[v + 1] - offsets[v]);
+  }
+};
+
+/// @brief One weighted directed edge.
+struct Edge {
+  std::size_t from = 0;
+  std::size_t to = 0;
+  double weight = 0.0;
+};
+
+/// @brief Checks the offsets, the target order and the bounds of @p graph against @p targets_bound
+/// (0 takes graph.vertices, as for a whole graph).
+bool IsValid(const Graph &graph, std::size_t targets_bound = 0);
+
+/// @brief Builds a Graph from an edge list in any order.
+/// @details Self-loops are dropped and parallel edges keep the lightest weight. With
+/// @p undirected every edge is also added in reverse.
+/// @throws std::invalid_argument When an edge leaves the vertex range or a weight is NaN.
+Graph FromEdges(std::size_t vertices, std::vector<Edge> edges, bool undirected = false);
+
+/// @brief Out-edges of vertices [begin, end) of @p graph, with offsets starting at zero and global targets.
+/// @throws std::invalid_argument When the range does not fit the graph.
+Graph SliceVertices(const Graph &graph, std::size_t begin, std::size_t end);
+
+/// @brief Directed R-MAT graph of 2^scale vertices and about edge_factor out-edges per vertex,
+/// weights uniform in (0, 1].
+/// @details Quadrant probabilities 0.57/0.19/0.19/0.05, as in Graph500, give power-law degrees.
+Graph RmatGraph(unsigned scale, std::size_t edge_factor, std::uint64_t seed);
+
+/// @brief Undirected 4-neighbour width x height grid, vertex x + y * width, weights uniform in (0, 1].
+Graph GridGraph(std::size_t width, std::size_t height, std::uint64_t seed);
+
+/// @brief Undirected random geometric graph: @p vertices uniform points of the unit square, joined
+/// when closer than @p radius, weighted by their distance.
+/// @details Points are binned into cells of side @p radius, so only neighbouring cells are compared.
+/// @throws std::invalid_argument When radius is not positive.
+Graph GeometricGraph(std::size_t vertices, double radius, std::uint64_t seed);
+
+/// @brief Writes @p graph in the binary CRS format read by ReadGraph().
+/// @details A 32-byte header (magic, vertices, edges, reserved) is followed by offsets, targets and
+/// weights as raw 8-byte arrays. The file is written to a temporary and renamed, so concurrent
+/// readers never see a partial graph.
+/// @throws std::runtime_error When the file cannot be written.
+void WriteGraph(const std::string &path, const Graph &graph);
+
+/// @brief Reads a graph written by WriteGraph(); the file is memory-mapped where possible.
+/// @throws std::runtime_error When the file is missing, has another format or is truncated.
+Graph ReadGraph(const std::string &path);
+
+}  // namespace ppc::graph
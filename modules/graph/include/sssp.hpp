@@ -0,0 +1,89 @@
+#pragma once
+
+#include <mpi.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "graph/include/graph.hpp"
+#include "shared_memory/include/parallel_for.hpp"
+
+namespace ppc::graph {
+
+using Backend = ppc::shared_memory::Backend;
+
+/// @brief Single-source shortest path algorithm.
+enum class Algorithm : uint8_t {
+  /// Binary-heap Dijkstra, sequential on every back-end; the reference
+  kDijkstra,
+  /// Delta-stepping: buckets of width Options::delta are settled in order, the light edges (weight
+  /// up to delta) relaxed until the bucket stays empty and the heavy ones once after it
+  kDeltaStepping,
+  /// Frontier Bellman-Ford: every round relaxes the out-edges of the vertices the last one improved;
+  /// the only one that accepts negative weights
+  kBellmanFord
+};
+
+/// @brief Returns the lower-case name of the algorithm ("dijkstra", "delta_stepping", "bellman_ford").
+std::string AlgorithmToString(Algorithm algorithm);
+
+struct Options {
+  Algorithm algorithm = Algorithm::kDeltaStepping;
+  /// Bucket width of delta-stepping; 0 takes DefaultDelta().
+  double delta = 0.0;
+  Backend backend = Backend::kSeq;
+};
+
+struct Tuning {
+  /// Frontier blocks per worker, each with its own buckets and output list.
+  std::size_t parts_per_worker = 4;
+  /// Relaxation messages a rank sends to one destination per exchange round, which bounds
+  /// the bytes in flight.
+  std::size_t message_batch = std::size_t{1} << 16;
+};
+
+/// @brief Returns the tuning shared by all kernels of this module.
+Tuning &GetTuning();
+
+/// @brief Distances from the source, with the work it took.
+struct Paths {
+  /// Distance of every vertex (of the local strip for DistributedShortestPaths()); infinity when
+  /// unreachable.
+  std::vector<double> distance;
+  /// Parallel steps: light and heavy phases of delta-stepping, rounds of Bellman-Ford, supersteps
+  /// of the distributed version; 0 for Dijkstra.
+  std::size_t rounds = 0;
+  /// Edges relaxed, summed over the ranks.
+  std::uint64_t relaxations = 0;
+  /// Relaxations sent between ranks after merging those to the same vertex, summed over the ranks.
+  std::uint64_t messages = 0;
+};
+
+/// @brief Delta-stepping bucket width: the largest weight over the average out-degree, so that a
+/// bucket holds about one hop of light edges.
+double DefaultDelta(const Graph &graph);
+
+/// @brief Distances from @p source on the whole @p graph.
+/// @details The parallel algorithms split the frontier into Tuning::parts_per_worker blocks per
+/// worker; each block keeps its own buckets (delta-stepping) or next frontier (Bellman-Ford), and
+/// distances fall by atomic compare-and-swap.
+/// @throws std::invalid_argument When the graph is invalid, the source out of range, delta
+/// negative, or a weight negative for Dijkstra or delta-stepping.
+/// @throws std::runtime_error When Bellman-Ford reaches a negative cycle.
+Paths ShortestPaths(const Graph &graph, std::size_t source, const Options &options = {});
+
+/// @brief Distances from @p source with the vertices split over the ranks of @p comm.
+/// @details Rank r holds the out-edges of vertices BlockRange(vertices, size, r) in @p local (see
+/// SliceVertices()). Every superstep relaxes the pending vertices of the lowest bucket on all ranks
+/// (delta infinite for Bellman-Ford); relaxations of remote vertices are merged per target and
+/// sent in batches of at most Tuning::message_batch per destination through ppc::collectives::ChunkedAlltoallv().
+/// @return Distances of the local vertices; the statistics are the same on every rank.
+/// @throws std::invalid_argument On every rank when a strip is invalid, for Dijkstra, or for the
+/// cases of ShortestPaths().
+/// @throws std::runtime_error When Bellman-Ford reaches a negative cycle.
+Paths DistributedShortestPaths(const Graph &local, std::size_t vertices, std::size_t source, const Options &options,
+                               MPI_Comm comm);
+
+}  // namespace ppc::graph
@@ -0,0 +1,97 @@
+#pragma once
+
+#include <mpi.h>
+
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+#include "graph/include/graph.hpp"
+#include "graph/include/sssp.hpp"
+#include "shared_memory/include/parallel_for.hpp"
+#include "shared_memory/include/shared_memory.hpp"
+#include "task/include/task.hpp"
+
+namespace ppc::graph {
+
+/// @brief Graph and source of a shortest path problem; every rank holds the whole input, as in the
+/// course tasks.
+struct SsspProblem {
+  Graph graph;
+  std::size_t source = 0;
+};
+
+/// @brief Single-source shortest paths as a course task on any back-end.
+/// @details The kMPI variant slices its BlockRange strip of vertices in PreProcessing, runs
+/// DistributedShortestPaths() and gathers the distances on every rank; Dijkstra has no kMPI variant.
+template <ppc::task::TypeOfTask kType, Algorithm kAlgorithm = Algorithm::kDeltaStepping>
+class ShortestPathsTask : public ppc::task::Task<SsspProblem, Paths> {
+ public:
+  using InType = SsspProblem;
+  using OutType = Paths;
+
+  static constexpr ppc::task::TypeOfTask GetStaticTypeOfTask() {
+    return kType;
+  }
+
+  explicit ShortestPathsTask(const InType &in) {
+    this->SetTypeOfTask(GetStaticTypeOfTask());
+    this->GetInput() = in;
+  }
+
+ private:
+  bool ValidationImpl() override {
+    const InType &in = this->GetInput();
+    return IsValid(in.graph) && in.source < in.graph.vertices &&
+           (kType != ppc::task::TypeOfTask::kMPI || kAlgorithm != Algorithm::kDijkstra);
+  }
+
+  bool PreProcessingImpl() override {
+    if constexpr (kType == ppc::task::TypeOfTask::kMPI) {
+      int rank = 0;
+      int size = 1;
+      MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+      MPI_Comm_size(MPI_COMM_WORLD, &size);
+      const Graph &graph = this->GetInput().graph;
+      const auto [begin, end] = ppc::shared_memory::BlockRange(graph.vertices, size, rank);
+      local_ = SliceVertices(graph, begin, end);
+    }
+    return true;
+  }
+
+  bool RunImpl() override {
+    const InType &in = this->GetInput();
+    Options options;
+    options.algorithm = kAlgorithm;
+    options.backend = ppc::shared_memory::BackendOf(kType);
+    if constexpr (kType != ppc::task::TypeOfTask::kMPI) {
+      this->GetOutput() = ShortestPaths(in.graph, in.source, options);
+    } else {
+      Paths paths = DistributedShortestPaths(local_, in.graph.vertices, in.source, options, MPI_COMM_WORLD);
+      int size = 1;
+      MPI_Comm_size(MPI_COMM_WORLD, &size);
+      std::vector<int> counts(static_cast<std::size_t>(size));
+      std::vector<int> displs(static_cast<std::size_t>(size));
+      for (int r = 0; r < size; r++) {
+        const auto [begin, end] = ppc::shared_memory::BlockRange(in.graph.vertices, size, r);
+        counts[static_cast<std::size_t>(r)] = static_cast<int>(end - begin);
+        displs[static_cast<std::size_t>(r)] = static_cast<int>(begin);
+      }
+      std::vector<double> local = std::move(paths.distance);
+      paths.distance.assign(in.graph.vertices, 0.0);
+      MPI_Allgatherv(local.data(), static_cast<int>(local.size()), MPI_DOUBLE, paths.distance.data(), counts.data(),
+                     displs.data(), MPI_DOUBLE, MPI_COMM_WORLD);
+      this->GetOutput() = std::move(paths);
+    }
+    return true;
+  }
+
+  bool PostProcessingImpl() override {
+    const Paths &paths = this->GetOutput();
+    return paths.distance.size() == this->GetInput().graph.vertices && paths.distance[this->GetInput().source] == 0.0;
+  }
+
+  Graph local_;
+};
+
+}  // namespace ppc::graph
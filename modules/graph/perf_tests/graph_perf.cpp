@@ -0,0 +1,120 @@
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <numbers>
+#include <string>
+#include <tuple>
+
+#include "graph/include/graph.hpp"
+#include "graph/include/sssp.hpp"
+#include "graph/include/sssp_task.hpp"
+#include "task/include/task.hpp"
+#include "util/include/perf_test_util.hpp"
+
+namespace ppc::graph::perf {
+
+using ppc::task::TypeOfTask;
+
+namespace {
+
+// The graphs are shared by the cases of a suite: generating one costs more than a run.
+
+enum class Family : uint8_t { kRmat, kGrid, kGeometric };
+
+/// About 1M edges each: R-MAT with 2^16 vertices, a 512 x 512 grid, and 2^17 geometric points of
+/// average degree 8.
+const Graph &FamilyGraph(Family family) {
+  static const Graph kRmat = RmatGraph(16, 16, 1);
+  static const Graph kGrid = GridGraph(512, 512, 2);
+  static const Graph kGeometric = [] {
+    constexpr std::size_t kPoints = std::size_t{1} << 17;
+    return GeometricGraph(kPoints, std::sqrt(8.0 / (std::numbers::pi * static_cast<double>(kPoints))), 3);
+  }();
+  switch (family) {
+    case Family::kRmat:
+      return kRmat;
+    case Family::kGrid:
+      return kGrid;
+    case Family::kGeometric:
+      return kGeometric;
+  }
+  return kRmat;
+}
+
+}  // namespace
+
+/// Reports traversed edges per second (edges of the graph over the run time, as Graph500 counts),
+/// with the rounds, relaxations and remote messages of the run.
+template <Family kFamily>
+class ShortestPathsPerfTests : public ppc::util::BaseRunPerfTests<SsspProblem, Paths> {
+  bool CheckTestOutputData(Paths &output_data) final {
+    const Graph &graph = FamilyGraph(kFamily);
+    PrintRate("teps", static_cast<double>(graph.Edges()));
+    PrintValue("rounds", static_cast<double>(output_data.rounds));
+    PrintValue("relaxations", static_cast<double>(output_data.relaxations));
+    PrintValue("messages", static_cast<double>(output_data.messages));
+    return output_data.distance.size() == graph.vertices && output_data.distance[0] == 0.0;
+  }
+
+  SsspProblem GetTestInputData() final {
+    return {.graph = FamilyGraph(kFamily), .source = 0};
+  }
+};
+
+/// ShortestPathsTask of every back-end for one algorithm.
+template <Algorithm kAlgorithm>
+struct ShortestPathsTasks {
+  template <TypeOfTask kType>
+  using Task = ShortestPathsTask<kType, kAlgorithm>;
+};
+
+template <Algorithm kAlgorithm>
+auto MakeBackendSuite(const std::string &family) {
+  const std::string kernel = AlgorithmToString(kAlgorithm) + "_" + family;
+  return ppc::util::MakeBackendPerfTaskTuples<ShortestPathsTasks<kAlgorithm>::template Task, SsspProblem>("ppc_graph",
+                                                                                                          kernel);
+}
+
+namespace {
+
+/// Sequential Dijkstra as the baseline, then both parallel algorithms on every back-end.
+auto MakeFamilySuite(const std::string &family) {
+  using DijkstraTask = ShortestPathsTask<TypeOfTask::kSEQ, Algorithm::kDijkstra>;
+  const std::string dijkstra = "ppc_graph_seq_dijkstra_" + family;
+  return std::tuple_cat(ppc::util::MakeNamedPerfTaskTuples<DijkstraTask, SsspProblem>(dijkstra),
+                        MakeBackendSuite<Algorithm::kDeltaStepping>(family),
+                        MakeBackendSuite<Algorithm::kBellmanFord>(family));
+}
+
+}  // namespace
+
+using RmatPerfTests = ShortestPathsPerfTests<Family::kRmat>;
+using GridPerfTests = ShortestPathsPerfTests<Family::kGrid>;
+using GeometricPerfTests = ShortestPathsPerfTests<Family::kGeometric>;
+
+TEST_P(RmatPerfTests, RunPerfModes) {
+  ExecuteTest(GetParam());
+}
+
+TEST_P(GridPerfTests, RunPerfModes) {
+  ExecuteTest(GetParam());
+}
+
+TEST_P(GeometricPerfTests, RunPerfModes) {
+  ExecuteTest(GetParam());
+}
+
+const auto kRmatPerfTasks = MakeFamilySuite("rmat");
+const auto kGridPerfTasks = MakeFamilySuite("grid");
+const auto kGeometricPerfTasks = MakeFamilySuite("geometric");
+
+INSTANTIATE_TEST_SUITE_P(SsspRmat, RmatPerfTests, ppc::util::TupleToGTestValues(kRmatPerfTasks),
+                         RmatPerfTests::CustomPerfTestName);
+INSTANTIATE_TEST_SUITE_P(SsspGrid, GridPerfTests, ppc::util::TupleToGTestValues(kGridPerfTasks),
+                         GridPerfTests::CustomPerfTestName);
+INSTANTIATE_TEST_SUITE_P(SsspGeometric, GeometricPerfTests, ppc::util::TupleToGTestValues(kGeometricPerfTasks),
+                         GeometricPerfTests::CustomPerfTestName);
+
+}  // namespace ppc::graph::perf
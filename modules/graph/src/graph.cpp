@@ -0,0 +1,253 @@
+#include "graph/include/graph.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <random>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include "sparse/include/matrix_market.hpp"
+#include "util/include/util.hpp"
+
+namespace ppc::graph {
+
+namespace {
+
+static_assert(sizeof(std::size_t) == sizeof(std::uint64_t), "graph files store indices as 64-bit words");
+
+/// Graph file header; the arrays follow it directly.
+struct FileHeader {
+  std::array<char, 8> magic;
+  std::uint64_t vertices;
+  std::uint64_t edges;
+  std::uint64_t reserved;
+};
+static_assert(sizeof(FileHeader) == 32, "graph header must keep the arrays 8-byte aligned");
+
+constexpr std::array<char, 8> kFileMagic = {'P', 'P', 'C', 'G', 'R', 'F', '0', '1'};
+
+/// Weight uniform in (0, 1].
+double PositiveWeight(std::mt19937_64 &gen) {
+  return 1.0 - std::uniform_real_distribution<double>(0.0, 1.0)(gen);
+}
+
+}  // namespace
+
+bool IsValid(const Graph &graph, std::size_t targets_bound) {
+  const std::size_t bound = targets_bound != 0 ? targets_bound : graph.vertices;
+  if (graph.offsets.size() != graph.vertices + 1 || graph.offsets.front() != 0 ||
+      graph.offsets[graph.vertices] != graph.targets.size() || graph.weights.size() != graph.targets.size()) {
+    return false;
+  }
+  for (std::size_t v = 0; v < graph.vertices; v++) {
+    if (graph.offsets[v] > graph.offsets[v + 1]) {
+      return false;
+    }
+    for (std::size_t e = graph.offsets[v]; e < graph.offsets[v + 1]; e++) {
+      if (graph.targets[e] >= bound || (e > graph.offsets[v] && graph.targets[e] <= graph.targets[e - 1])) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+Graph FromEdges(std::size_t vertices, std::vector<Edge> edges, bool undirected) {
+  for (const Edge &edge : edges) {
+    if (edge.from >= vertices || edge.to >= vertices) {
+      throw std::invalid_argument("FromEdges: edge leaves the vertex range");
+    }
+    if (std::isnan(edge.weight)) {
+      throw std::invalid_argument("FromEdges: NaN weight");
+    }
+  }
+  if (undirected) {
+    const std::size_t count = edges.size();
+    edges.reserve(2 * count);
+    for (std::size_t i = 0; i < count; i++) {
+      edges.push_back({.from = edges[i].to, .to = edges[i].from, .weight = edges[i].weight});
+    }
+  }
+  std::erase_if(edges, [](const Edge &edge) { return edge.from == edge.to; });
+  std::ranges::sort(edges, [](const Edge &a, const Edge &b) {
+    return std::tie(a.from, a.to, a.weight) < std::tie(b.from, b.to, b.weight);
+  });
+
+  Graph graph{.vertices = vertices, .offsets = std::vector<std::size_t>(vertices + 1, 0), .targets = {}, .weights = {}};
+  graph.targets.reserve(edges.size());
+  graph.weights.reserve(edges.size());
+  for (std::size_t i = 0; i < edges.size(); i++) {
+    if (i > 0 && edges[i].from == edges[i - 1].from && edges[i].to == edges[i - 1].to) {
+      continue;
+    }
+    graph.targets.push_back(edges[i].to);
+    graph.weights.push_back(edges[i].weight);
+    graph.offsets[edges[i].from + 1]++;
+  }
+  for (std::size_t v = 0; v < vertices; v++) {
+    graph.offsets[v + 1] += graph.offsets[v];
+  }
+  return graph;
+}
+
+Graph SliceVertices(const Graph &graph, std::size_t begin, std::size_t end) {
+  if (begin > end || end > graph.vertices || graph.offsets.size() != graph.vertices + 1) {
+    throw std::invalid_argument("SliceVertices: vertex range does not fit the graph");
+  }
+  const auto first = static_cast<std::ptrdiff_t>(graph.offsets[begin]);
+  const auto last = static_cast<std::ptrdiff_t>(graph.offsets[end]);
+  Graph strip{.vertices = end - begin,
+              .offsets = {},
+              .targets = {graph.targets.begin() + first, graph.targets.begin() + last},
+              .weights = {graph.weights.begin() + first, graph.weights.begin() + last}};
+  strip.offsets.reserve(end - begin + 1);
+  for (std::size_t v = begin; v <= end; v++) {
+    strip.offsets.push_back(graph.offsets[v] - graph.offsets[begin]);
+  }
+  return strip;
+}
+
+Graph RmatGraph(unsigned scale, std::size_t edge_factor, std::uint64_t seed) {
+  const std::size_t n = std::size_t{1} << scale;
+  std::mt19937_64 gen(seed);
+  std::uniform_real_distribution<double> unit(0.0, 1.0);
+  std::vector<Edge> edges(n * edge_factor);
+  for (Edge &edge : edges) {
+    std::size_t from = 0;
+    std::size_t to = 0;
+    for (unsigned level = 0; level < scale; level++) {
+      const double p = unit(gen);
+      from = (from << 1U) | static_cast<std::size_t>(p >= 0.76);
+      to = (to << 1U) | static_cast<std::size_t>((p >= 0.57 && p < 0.76) || p >= 0.95);
+    }
+    edge = {.from = from, .to = to, .weight = PositiveWeight(gen)};
+  }
+  return FromEdges(n, std::move(edges));
+}
+
+Graph GridGraph(std::size_t width, std::size_t height, std::uint64_t seed) {
+  std::mt19937_64 gen(seed);
+  std::vector<Edge> edges;
+  edges.reserve(2 * width * height);
+  for (std::size_t y = 0; y < height; y++) {
+    for (std::size_t x = 0; x < width; x++) {
+      const std::size_t v = x + (y * width);
+      if (x + 1 < width) {
+        edges.push_back({.from = v, .to = v + 1, .weight = PositiveWeight(gen)});
+      }
+      if (y + 1 < height) {
+        edges.push_back({.from = v, .to = v + width, .weight = PositiveWeight(gen)});
+      }
+    }
+  }
+  return FromEdges(width * height, std::move(edges), true);
+}
+
+Graph GeometricGraph(std::size_t vertices, double radius, std::uint64_t seed) {
+  if (!(radius > 0.0)) {
+    throw std::invalid_argument("GeometricGraph: radius must be positive");
+  }
+  std::mt19937_64 gen(seed);
+  std::uniform_real_distribution<double> unit(0.0, 1.0);
+  std::vector<double> xs(vertices);
+  std::vector<double> ys(vertices);
+  for (std::size_t i = 0; i < vertices; i++) {
+    xs[i] = unit(gen);
+    ys[i] = unit(gen);
+  }
+  // Cells at least radius wide, and no more of them than points.
+  const auto cells = static_cast<std::size_t>(
+      std::max(1.0, std::min(std::floor(1.0 / radius), std::ceil(std::sqrt(static_cast<double>(vertices))))));
+  const auto cell_of = [&](double coordinate) {
+    return std::min(cells - 1, static_cast<std::size_t>(coordinate * static_cast<double>(cells)));
+  };
+  std::vector<std::size_t> cell_start(cells * cells + 1, 0);
+  for (std::size_t i = 0; i < vertices; i++) {
+    cell_start[cell_of(xs[i]) + (cell_of(ys[i]) * cells) + 1]++;
+  }
+  for (std::size_t c = 0; c < cells * cells; c++) {
+    cell_start[c + 1] += cell_start[c];
+  }
+  std::vector<std::size_t> members(vertices);
+  std::vector<std::size_t> fill(cell_start.begin(), cell_start.end() - 1);
+  for (std::size_t i = 0; i < vertices; i++) {
+    members[fill[cell_of(xs[i]) + (cell_of(ys[i]) * cells)]++] = i;
+  }
+
+  std::vector<Edge> edges;
+  for (std::size_t i = 0; i < vertices; i++) {
+    const std::size_t cx = cell_of(xs[i]);
+    const std::size_t cy = cell_of(ys[i]);
+    for (std::size_t ny = cy > 0 ? cy - 1 : 0; ny <= std::min(cy + 1, cells - 1); ny++) {
+      for (std::size_t nx = cx > 0 ? cx - 1 : 0; nx <= std::min(cx + 1, cells - 1); nx++) {
+        const std::size_t c = nx + (ny * cells);
+        for (std::size_t m = cell_start[c]; m < cell_start[c + 1]; m++) {
+          const std::size_t j = members[m];
+          const double distance = std::hypot(xs[i] - xs[j], ys[i] - ys[j]);
+          if (j > i && distance < radius) {
+            edges.push_back({.from = i, .to = j, .weight = distance});
+          }
+        }
+      }
+    }
+  }
+  return FromEdges(vertices, std::move(edges), true);
+}
+
+void WriteGraph(const std::string &path, const Graph &graph) {
+  const FileHeader header{.magic = kFileMagic, .vertices = graph.vertices, .edges = graph.Edges(), .reserved = 0};
+  ppc::util::WriteFileAtomically(path,
+                                 {std::as_bytes(std::span(&header, 1)), std::as_bytes(std::span(graph.offsets)),
+                                  std::as_bytes(std::span(graph.targets)), std::as_bytes(std::span(graph.weights))});
+}
+
+Graph ReadGraph(const std::string &path) {
+  const ppc::sparse::MappedFile file(path);
+  FileHeader header{};
+  if (file.Size() < sizeof(header)) {
+    throw std::runtime_error("Graph file " + path + " is truncated");
+  }
+  std::memcpy(&header, file.Data(), sizeof(header));
+  if (header.magic != kFileMagic) {
+    throw std::runtime_error("Graph file " + path + " has a different format");
+  }
+  // Bounding the counts by the file size first keeps the size below from wrapping around.
+  const std::size_t payload = file.Size() - sizeof(header);
+  if (header.vertices >= payload / sizeof(std::uint64_t) ||
+      header.edges > payload / (sizeof(std::uint64_t) + sizeof(double))) {
+    throw std::runtime_error("Graph file " + path + " is truncated");
+  }
+  const std::size_t expected =
+      sizeof(header) + ((header.vertices + 1 + header.edges) * sizeof(std::uint64_t)) + (header.edges * sizeof(double));
+  if (file.Size() != expected) {
+    throw std::runtime_error("Graph file " + path + " is truncated");
+  }
+  Graph graph{.vertices = header.vertices,
+              .offsets = std::vector<std::size_t>(header.vertices + 1),
+              .targets = std::vector<std::size_t>(header.edges),
+              .weights = std::vector<double>(header.edges)};
+  const char *base = file.Data() + sizeof(header);
+  const auto read = [&base](void *data, std::size_t bytes) {
+    if (bytes > 0) {
+      std::memcpy(data, base, bytes);
+      base += bytes;
+    }
+  };
+  read(graph.offsets.data(), graph.offsets.size() * sizeof(std::size_t));
+  read(graph.targets.data(), graph.targets.size() * sizeof(std::size_t));
+  read(graph.weights.data(), graph.weights.size() * sizeof(double));
+  if (!IsValid(graph)) {
+    throw std::runtime_error("Graph file " + path + " is corrupt");
+  }
+  return graph;
+}
+
+}  // namespace ppc::graph
@@ -0,0 +1,446 @@
+#include "graph/include/sssp.hpp"
+
+#include <mpi.h>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <numeric>
+#include <queue>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "collectives/include/collectives.hpp"
+#include "graph/include/graph.hpp"
+#include "shared_memory/include/parallel_for.hpp"
+#include "shared_memory/include/shared_memory.hpp"
+
+namespace ppc::graph {
+
+namespace {
+
+constexpr double kInfinity = std::numeric_limits<double>::infinity();
+
+/// A vertex queued with the distance it had then; it is stale once the distance has fallen.
+struct Entry {
+  std::size_t vertex;
+  double distance;
+};
+
+/// Relaxation of a remote vertex.
+struct Message {
+  std::uint64_t target;
+  double distance;
+};
+
+bool HasNegativeWeight(const Graph &graph) {
+  return std::ranges::any_of(graph.weights, [](double w) { return w < 0.0; });
+}
+
+/// Lowers @p target to @p value; true when it was higher.
+bool AtomicMin(std::atomic<double> &target, double value) {
+  double seen = target.load(std::memory_order_relaxed);
+  while (value < seen) {
+    if (target.compare_exchange_weak(seen, value, std::memory_order_relaxed)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+std::size_t PartCount(Backend backend) {
+  return static_cast<std::size_t>(ppc::shared_memory::BackendWorkers(backend)) *
+         std::max<std::size_t>(GetTuning().parts_per_worker, 1);
+}
+
+std::vector<double> Unwrap(const std::vector<std::atomic<double>> &distance) {
+  std::vector<double> plain(distance.size());
+  for (std::size_t v = 0; v < distance.size(); v++) {
+    plain[v] = distance[v].load(std::memory_order_relaxed);
+  }
+  return plain;
+}
+
+Paths Dijkstra(const Graph &graph, std::size_t source) {
+  Paths paths{.distance = std::vector<double>(graph.vertices, kInfinity), .rounds = 0, .relaxations = 0, .messages = 0};
+  using Item = std::pair<double, std::size_t>;
+  std::priority_queue<Item, std::vector<Item>, std::greater<>> heap;
+  paths.distance[source] = 0.0;
+  heap.emplace(0.0, source);
+  while (!heap.empty()) {
+    const auto [d, u] = heap.top();
+    heap.pop();
+    if (d > paths.distance[u]) {
+      continue;
+    }
+    const auto targets = graph.Targets(u);
+    const auto weights = graph.Weights(u);
+    for (std::size_t e = 0; e < targets.size(); e++) {
+      paths.relaxations++;
+      if (d + weights[e] < paths.distance[targets[e]]) {
+        paths.distance[targets[e]] = d + weights[e];
+        heap.emplace(d + weights[e], targets[e]);
+      }
+    }
+  }
+  return paths;
+}
+
+Paths DeltaStepping(const Graph &graph, std::size_t source, double delta, Backend backend) {
+  const std::size_t parts = PartCount(backend);
+  std::vector<std::atomic<double>> distance(graph.vertices);
+  for (auto &d : distance) {
+    d.store(kInfinity, std::memory_order_relaxed);
+  }
+  distance[source].store(0.0, std::memory_order_relaxed);
+  // buckets[part][b]: entries part queued into bucket b, so that no two workers share a list.
+  std::vector<std::vector<std::vector<Entry>>> buckets(parts);
+  std::vector<std::vector<Entry>> settled(parts);
+  std::vector<std::uint64_t> relaxations(parts, 0);
+  buckets[0].resize(1);
+  buckets[0][0].push_back({.vertex = source, .distance = 0.0});
+
+  const auto relax = [&](std::size_t part, const Entry &entry, bool heavy) {
+    const auto targets = graph.Targets(entry.vertex);
+    const auto weights = graph.Weights(entry.vertex);
+    for (std::size_t e = 0; e < targets.size(); e++) {
+      if ((weights[e] > delta) != heavy) {
+        continue;
+      }
+      relaxations[part]++;
+      const double candidate = entry.distance + weights[e];
+      if (AtomicMin(distance[targets[e]], candidate)) {
+        auto &mine = buckets[part];
+        const auto b = static_cast<std::size_t>(candidate / delta);
+        if (b >= mine.size()) {
+          mine.resize(b + 1);
+        }
+        mine[b].push_back({.vertex = targets[e], .distance = candidate});
+      }
+    }
+  };
+  const auto fresh = [&](const Entry &entry) {
+    return distance[entry.vertex].load(std::memory_order_relaxed) >= entry.distance;
+  };
+
+  Paths paths;
+  std::vector<Entry> frontier;
+  for (std::size_t current = 0;; current++) {
+    std::size_t next = std::numeric_limits<std::size_t>::max();
+    for (const auto &mine : buckets) {
+      for (std::size_t b = current; b < mine.size() && b < next; b++) {
+        if (!mine[b].empty()) {
+          next = b;
+        }
+      }
+    }
+    if (next == std::numeric_limits<std::size_t>::max()) {
+      break;
+    }
+    current = next;
+    for (auto &mine : settled) {
+      mine.clear();
+    }
+    // Light phases until the bucket stays empty.
+    while (true) {
+      frontier.clear();
+      for (auto &mine : buckets) {
+        if (current < mine.size()) {
+          frontier.insert(frontier.end(), mine[current].begin(), mine[current].end());
+          std::vector<Entry>().swap(mine[current]);
+        }
+      }
+      if (frontier.empty()) {
+        break;
+      }
+      paths.rounds++;
+      ppc::shared_memory::ParallelFor(parts, backend, [&](std::size_t part) {
+        const auto [begin, end] = ppc::shared_memory::BlockRange(frontier.size(), static_cast<int>(parts),
+                                                                 static_cast<int>(part));
+        for (std::size_t i = begin; i < end; i++) {
+          if (fresh(frontier[i])) {
+            settled[part].push_back(frontier[i]);
+            relax(part, frontier[i], false);
+          }
+        }
+      });
+    }
+    // Heavy edges once, from the final distances of the bucket; they only reach later buckets.
+    paths.rounds++;
+    ppc::shared_memory::ParallelFor(parts, backend, [&](std::size_t part) {
+      for (const Entry &entry : settled[part]) {
+        if (fresh(entry)) {
+          relax(part, entry, true);
+        }
+      }
+    });
+  }
+  paths.distance = Unwrap(distance);
+  paths.relaxations = std::accumulate(relaxations.begin(), relaxations.end(), std::uint64_t{0});
+  return paths;
+}
+
+Paths BellmanFord(const Graph &graph, std::size_t source, Backend backend) {
+  const std::size_t parts = PartCount(backend);
+  std::vector<std::atomic<double>> distance(graph.vertices);
+  for (auto &d : distance) {
+    d.store(kInfinity, std::memory_order_relaxed);
+  }
+  distance[source].store(0.0, std::memory_order_relaxed);
+  std::vector<std::atomic<bool>> queued(graph.vertices);
+  std::vector<std::vector<std::size_t>> next(parts);
+  std::vector<std::uint64_t> relaxations(parts, 0);
+  std::vector<std::size_t> frontier = {source};
+
+  Paths paths;
+  while (!frontier.empty()) {
+    // Without a negative cycle every shortest path has fewer than vertices edges.
+    if (++paths.rounds > graph.vertices) {
+      throw std::runtime_error("ShortestPaths: negative cycle reachable from the source");
+    }
+    ppc::shared_memory::ParallelFor(parts, backend, [&](std::size_t part) {
+      const auto [begin, end] =
+          ppc::shared_memory::BlockRange(frontier.size(), static_cast<int>(parts), static_cast<int>(part));
+      for (std::size_t i = begin; i < end; i++) {
+        const std::size_t u = frontier[i];
+        const double du = distance[u].load(std::memory_order_relaxed);
+        const auto targets = graph.Targets(u);
+        const auto weights = graph.Weights(u);
+        relaxations[part] += targets.size();
+        for (std::size_t e = 0; e < targets.size(); e++) {
+          if (AtomicMin(distance[targets[e]], du + weights[e]) && !queued[targets[e]].exchange(true)) {
+            next[part].push_back(targets[e]);
+          }
+        }
+      }
+    });
+    frontier.clear();
+    for (auto &mine : next) {
+      frontier.insert(frontier.end(), mine.begin(), mine.end());
+      mine.clear();
+    }
+    for (const std::size_t v : frontier) {
+      queued[v].store(false, std::memory_order_relaxed);
+    }
+  }
+  paths.distance = Unwrap(distance);
+  paths.relaxations = std::accumulate(relaxations.begin(), relaxations.end(), std::uint64_t{0});
+  return paths;
+}
+
+/// Sends every outbox to its rank in rounds of at most Tuning::message_batch messages each and
+/// returns what arrived.
+std::vector<Message> ExchangeMessages(const std::vector<std::vector<Message>> &outboxes, MPI_Comm comm) {
+  const std::size_t ranks = outboxes.size();
+  std::vector<std::uint64_t> send(ranks);
+  std::vector<std::uint64_t> receive(ranks);
+  for (std::size_t r = 0; r < ranks; r++) {
+    send[r] = outboxes[r].size();
+  }
+  MPI_Alltoall(send.data(), 1, MPI_UINT64_T, receive.data(), 1, MPI_UINT64_T, comm);
+  std::vector<std::size_t> received_at(ranks + 1, 0);
+  for (std::size_t r = 0; r < ranks; r++) {
+    received_at[r + 1] = received_at[r] + receive[r];
+  }
+  std::vector<Message> flat;
+  std::vector<std::size_t> sent_at(ranks + 1, 0);
+  for (std::size_t r = 0; r < ranks; r++) {
+    flat.insert(flat.end(), outboxes[r].begin(), outboxes[r].end());
+    sent_at[r + 1] = flat.size();
+  }
+  std::vector<Message> received(received_at[ranks]);
+  MPI_Datatype type = MPI_DATATYPE_NULL;
+  MPI_Type_contiguous(static_cast<int>(sizeof(Message)), MPI_BYTE, &type);
+  MPI_Type_commit(&type);
+  ppc::collectives::ChunkedAlltoallv(flat.data(), send, std::span(sent_at).first(ranks), received.data(), receive,
+                                     std::span(received_at).first(ranks), type, GetTuning().message_batch, comm);
+  MPI_Type_free(&type);
+  return received;
+}
+
+}  // namespace
+
+std::string AlgorithmToString(Algorithm algorithm) {
+  switch (algorithm) {
+    case Algorithm::kDijkstra:
+      return "dijkstra";
+    case Algorithm::kDeltaStepping:
+      return "delta_stepping";
+    case Algorithm::kBellmanFord:
+      return "bellman_ford";
+  }
+  return "unknown";
+}
+
+Tuning &GetTuning() {
+  static Tuning tuning;
+  return tuning;
+}
+
+double DefaultDelta(const Graph &graph) {
+  const double heaviest = graph.weights.empty() ? 0.0 : std::ranges::max(graph.weights);
+  if (!(heaviest > 0.0)) {
+    return 1.0;
+  }
+  const double degree =
+      static_cast<double>(graph.Edges()) / static_cast<double>(std::max<std::size_t>(graph.vertices, 1));
+  return heaviest / std::max(degree, 1.0);
+}
+
+Paths ShortestPaths(const Graph &graph, std::size_t source, const Options &options) {
+  if (!IsValid(graph) || source >= graph.vertices) {
+    throw std::invalid_argument("ShortestPaths: invalid graph or source out of range");
+  }
+  if (options.delta < 0.0 || std::isnan(options.delta)) {
+    throw std::invalid_argument("ShortestPaths: delta must not be negative");
+  }
+  if (options.algorithm != Algorithm::kBellmanFord && HasNegativeWeight(graph)) {
+    throw std::invalid_argument("ShortestPaths: " + AlgorithmToString(options.algorithm) +
+                                " needs non-negative weights");
+  }
+  switch (options.algorithm) {
+    case Algorithm::kDijkstra:
+      return Dijkstra(graph, source);
+    case Algorithm::kDeltaStepping:
+      return DeltaStepping(graph, source, options.delta > 0.0 ? options.delta : DefaultDelta(graph), options.backend);
+    case Algorithm::kBellmanFord:
+      return BellmanFord(graph, source, options.backend);
+  }
+  throw std::invalid_argument("ShortestPaths: unknown algorithm");
+}
+
+Paths DistributedShortestPaths(const Graph &local, std::size_t vertices, std::size_t source, const Options &options,
+                               MPI_Comm comm) {
+  int rank = 0;
+  int size = 1;
+  MPI_Comm_rank(comm, &rank);
+  MPI_Comm_size(comm, &size);
+  const auto ranks = static_cast<std::size_t>(size);
+  const auto [first, last] = ppc::shared_memory::BlockRange(vertices, size, rank);
+
+  // Agree on the checks, so that every rank throws or none does.
+  std::array<int, 2> checks = {
+      (local.vertices == last - first && IsValid(local, std::max<std::size_t>(vertices, 1))) ? 1 : 0,
+      HasNegativeWeight(local) ? 0 : 1};
+  MPI_Allreduce(MPI_IN_PLACE, checks.data(), 2, MPI_INT, MPI_MIN, comm);
+  if (checks[0] == 0 || source >= vertices) {
+    throw std::invalid_argument("DistributedShortestPaths: invalid strip or source out of range");
+  }
+  if (options.algorithm == Algorithm::kDijkstra) {
+    throw std::invalid_argument("DistributedShortestPaths: dijkstra is sequential");
+  }
+  if (options.delta < 0.0 || std::isnan(options.delta)) {
+    throw std::invalid_argument("DistributedShortestPaths: delta must not be negative");
+  }
+  if (options.algorithm == Algorithm::kDeltaStepping && checks[1] == 0) {
+    throw std::invalid_argument("DistributedShortestPaths: delta_stepping needs non-negative weights");
+  }
+
+  double delta = kInfinity;
+  if (options.algorithm == Algorithm::kDeltaStepping) {
+    delta = options.delta;
+    if (!(delta > 0.0)) {
+      std::array<double, 2> totals = {local.weights.empty() ? 0.0 : std::ranges::max(local.weights),
+                                      static_cast<double>(local.Edges())};
+      MPI_Allreduce(MPI_IN_PLACE, totals.data(), 1, MPI_DOUBLE, MPI_MAX, comm);
+      MPI_Allreduce(MPI_IN_PLACE, &totals[1], 1, MPI_DOUBLE, MPI_SUM, comm);
+      const double degree = totals[1] / static_cast<double>(std::max<std::size_t>(vertices, 1));
+      delta = totals[0] > 0.0 ? totals[0] / std::max(degree, 1.0) : 1.0;
+    }
+  }
+  std::vector<std::size_t> starts(ranks);
+  for (std::size_t r = 0; r < ranks; r++) {
+    starts[r] = ppc::shared_memory::BlockRange(vertices, size, static_cast<int>(r)).first;
+  }
+  const auto owner = [&](std::size_t v) {
+    return static_cast<std::size_t>(std::ranges::upper_bound(starts, v) - starts.begin()) - 1;
+  };
+
+  Paths paths{.distance = std::vector<double>(local.vertices, kInfinity), .rounds = 0, .relaxations = 0, .messages = 0};
+  std::vector<char> queued(local.vertices, 0);
+  std::vector<std::size_t> pending;
+  const auto improve = [&](std::size_t v, double candidate) {
+    if (candidate < paths.distance[v]) {
+      paths.distance[v] = candidate;
+      if (queued[v] == 0) {
+        queued[v] = 1;
+        pending.push_back(v);
+      }
+    }
+  };
+  if (source >= first && source < last) {
+    improve(source - first, 0.0);
+  }
+
+  std::vector<std::vector<Message>> outboxes(ranks);
+  std::vector<std::size_t> frontier;
+  while (true) {
+    double lowest = kInfinity;
+    for (const std::size_t v : pending) {
+      lowest = std::min(lowest, paths.distance[v]);
+    }
+    MPI_Allreduce(MPI_IN_PLACE, &lowest, 1, MPI_DOUBLE, MPI_MIN, comm);
+    if (lowest == kInfinity) {
+      break;
+    }
+    if (++paths.rounds > vertices + 1 && options.algorithm == Algorithm::kBellmanFord) {
+      throw std::runtime_error("DistributedShortestPaths: negative cycle reachable from the source");
+    }
+    // The pending vertices of the lowest bucket relax now; the rest wait.
+    const double bound = delta == kInfinity ? kInfinity : (std::floor(lowest / delta) + 1.0) * delta;
+    frontier.clear();
+    std::erase_if(pending, [&](std::size_t v) {
+      if (paths.distance[v] < bound) {
+        frontier.push_back(v);
+        queued[v] = 0;
+        return true;
+      }
+      return false;
+    });
+    for (const std::size_t u : frontier) {
+      const double du = paths.distance[u];
+      const auto targets = local.Targets(u);
+      const auto weights = local.Weights(u);
+      paths.relaxations += targets.size();
+      for (std::size_t e = 0; e < targets.size(); e++) {
+        if (targets[e] >= first && targets[e] < last) {
+          improve(targets[e] - first, du + weights[e]);
+        } else {
+          outboxes[owner(targets[e])].push_back({.target = targets[e], .distance = du + weights[e]});
+        }
+      }
+    }
+    // One message per remote vertex: the smallest candidate.
+    for (auto &outbox : outboxes) {
+      std::ranges::sort(outbox, [](const Message &a, const Message &b) {
+        return a.target != b.target ? a.target < b.target : a.distance < b.distance;
+      });
+      const auto [tail, end] = std::ranges::unique(outbox, [](const Message &a, const Message &b) {
+        return a.target == b.target;
+      });
+      outbox.erase(tail, end);
+      paths.messages += outbox.size();
+    }
+    for (const Message &message : ExchangeMessages(outboxes, comm)) {
+      improve(message.target - first, message.distance);
+    }
+    for (auto &outbox : outboxes) {
+      outbox.clear();
+    }
+  }
+  std::array<std::uint64_t, 2> sums = {paths.relaxations, paths.messages};
+  MPI_Allreduce(MPI_IN_PLACE, sums.data(), 2, MPI_UINT64_T, MPI_SUM, comm);
+  paths.relaxations = sums[0];
+  paths.messages = sums[1];
+  return paths;
+}
+
+}  // namespace ppc::graph
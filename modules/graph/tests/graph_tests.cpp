@@ -0,0 +1,246 @@
+#include <gtest/gtest.h>
+#include <mpi.h>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "graph/include/graph.hpp"
+#include "graph/include/sssp.hpp"
+#include "graph/include/sssp_task.hpp"
+#include "shared_memory/include/parallel_for.hpp"
+#include "shared_memory/include/shared_memory.hpp"
+#include "task/include/task.hpp"
+#include "util/include/func_test_util.hpp"
+
+using ppc::graph::Algorithm;
+using ppc::graph::Backend;
+using ppc::graph::Edge;
+using ppc::graph::Graph;
+using ppc::task::TypeOfTask;
+
+namespace {
+
+constexpr std::array<Backend, 4> kAllBackends = {Backend::kSeq, Backend::kOmp, Backend::kTbb, Backend::kStl};
+constexpr double kInfinity = std::numeric_limits<double>::infinity();
+
+/// Per-rank path in the temporary directory, so that concurrent ranks do not share files.
+std::string TempPath(const std::string &name) {
+  int rank = 0;
+  if (ppc::util::MpiReady()) {
+    MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+  }
+  return (std::filesystem::temp_directory_path() / ("ppc_graph_" + std::to_string(rank) + "_" + name)).string();
+}
+
+/// Equal up to the rounding of sums taken along different shortest paths; infinities must match.
+void ExpectSameDistances(const std::vector<double> &actual, const std::vector<double> &expected) {
+  ASSERT_EQ(actual.size(), expected.size());
+  for (std::size_t v = 0; v < actual.size(); v++) {
+    if (std::isinf(expected[v])) {
+      ASSERT_TRUE(std::isinf(actual[v])) << "at " << v;
+    } else {
+      ASSERT_NEAR(actual[v], expected[v], 1e-12 * (1.0 + expected[v])) << "at " << v;
+    }
+  }
+}
+
+/// An R-MAT, a grid and a random geometric graph: skewed, long-diameter and local.
+std::vector<Graph> TestGraphs() {
+  return {ppc::graph::RmatGraph(10, 8, 3), ppc::graph::GridGraph(40, 30, 4), ppc::graph::GeometricGraph(1500, 0.05, 5)};
+}
+
+}  // namespace
+
+TEST(Graph, EdgeListsBuildValidStripsOfCrs) {
+  const std::vector<Edge> edges = {{.from = 2, .to = 0, .weight = 1.5},  {.from = 0, .to = 3, .weight = 2.0},
+                                   {.from = 0, .to = 1, .weight = 0.5},  {.from = 0, .to = 3, .weight = 1.0},
+                                   {.from = 1, .to = 1, .weight = 0.25}, {.from = 3, .to = 2, .weight = 4.0}};
+  const Graph graph = ppc::graph::FromEdges(4, edges);
+  ASSERT_TRUE(ppc::graph::IsValid(graph));
+  // The self-loop is dropped and the parallel edges 0 -> 3 keep the lighter weight.
+  EXPECT_EQ(graph.offsets, (std::vector<std::size_t>{0, 2, 2, 3, 4}));
+  EXPECT_EQ(graph.targets, (std::vector<std::size_t>{1, 3, 0, 2}));
+  EXPECT_EQ(graph.weights, (std::vector<double>{0.5, 1.0, 1.5, 4.0}));
+
+  const Graph undirected = ppc::graph::FromEdges(4, edges, true);
+  EXPECT_EQ(undirected.Edges(), 8U);
+  EXPECT_EQ(undirected.Targets(3).size(), 2U);
+
+  const Graph strip = ppc::graph::SliceVertices(graph, 2, 4);
+  EXPECT_TRUE(ppc::graph::IsValid(strip, graph.vertices));
+  EXPECT_FALSE(ppc::graph::IsValid(strip));
+  EXPECT_EQ(strip.offsets, (std::vector<std::size_t>{0, 1, 2}));
+  EXPECT_EQ(strip.targets, (std::vector<std::size_t>{0, 2}));
+
+  EXPECT_THROW((void)ppc::graph::FromEdges(3, edges), std::invalid_argument);
+  EXPECT_THROW((void)ppc::graph::SliceVertices(graph, 3, 5), std::invalid_argument);
+  EXPECT_THROW((void)ppc::graph::GeometricGraph(10, 0.0, 1), std::invalid_argument);
+}
+
+TEST(Graph, GeneratorsGiveTheExpectedStructure) {
+  const Graph grid = ppc::graph::GridGraph(7, 5, 1);
+  ASSERT_TRUE(ppc::graph::IsValid(grid));
+  EXPECT_EQ(grid.Edges(), 2U * ((6U * 5U) + (7U * 4U)));
+
+  const Graph rmat = ppc::graph::RmatGraph(8, 16, 2);
+  ASSERT_TRUE(ppc::graph::IsValid(rmat));
+  EXPECT_EQ(rmat.vertices, 256U);
+  std::size_t widest = 0;
+  for (std::size_t v = 0; v < rmat.vertices; v++) {
+    widest = std::max(widest, rmat.Targets(v).size());
+  }
+  EXPECT_GT(widest, 4 * rmat.Edges() / rmat.vertices);
+
+  // The cell binning finds exactly the pairs a quadratic scan does, weighted by their distance.
+  const Graph geometric = ppc::graph::GeometricGraph(400, 0.1, 3);
+  ASSERT_TRUE(ppc::graph::IsValid(geometric));
+  const Graph dense = ppc::graph::GeometricGraph(400, 2.0, 3);
+  std::size_t close = 0;
+  for (std::size_t v = 0; v < dense.vertices; v++) {
+    for (const double w : dense.Weights(v)) {
+      close += w < 0.1 ? 1 : 0;
+    }
+  }
+  EXPECT_EQ(dense.Edges(), 400U * 399U);
+  EXPECT_EQ(geometric.Edges(), close);
+  for (const double w : geometric.weights) {
+    EXPECT_LT(w, 0.1);
+  }
+}
+
+TEST(Graph, BinaryFilesRoundTrip) {
+  const Graph graph = ppc::graph::RmatGraph(9, 8, 7);
+  const std::string path = TempPath("roundtrip.graph");
+  ppc::graph::WriteGraph(path, graph);
+  const Graph read = ppc::graph::ReadGraph(path);
+  EXPECT_EQ(read.vertices, graph.vertices);
+  EXPECT_EQ(read.offsets, graph.offsets);
+  EXPECT_EQ(read.targets, graph.targets);
+  EXPECT_EQ(read.weights, graph.weights);
+
+  {
+    // A vertex count 2^61 too large wraps the size it implies back to the size of the file.
+    std::fstream file(path, std::ios::binary | std::ios::in | std::ios::out);
+    const std::uint64_t vertices = graph.vertices + (std::uint64_t{1} << 61U);
+    file.seekp(8);
+    file.write(reinterpret_cast<const char *>(&vertices), sizeof(vertices));  // NOLINT(*-reinterpret-cast)
+  }
+  EXPECT_THROW((void)ppc::graph::ReadGraph(path), std::runtime_error);
+  ppc::graph::WriteGraph(path, graph);
+  std::filesystem::resize_file(path, std::filesystem::file_size(path) - 8);
+  EXPECT_THROW((void)ppc::graph::ReadGraph(path), std::runtime_error);
+  {
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    out << "not a graph file at all, but long enough for a header";
+  }
+  EXPECT_THROW((void)ppc::graph::ReadGraph(path), std::runtime_error);
+  std::filesystem::remove(path);
+  EXPECT_THROW((void)ppc::graph::ReadGraph(path), std::runtime_error);
+}
+
+TEST(Graph, ParallelShortestPathsMatchDijkstraOnEveryBackend) {
+  for (const Graph &graph : TestGraphs()) {
+    const auto reference = ppc::graph::ShortestPaths(graph, 1, {.algorithm = Algorithm::kDijkstra});
+    for (const Backend backend : kAllBackends) {
+      // Default, narrow and wide buckets, the widest degenerating to Bellman-Ford.
+      for (const double delta : {0.0, 0.01, 0.3, 100.0}) {
+        const ppc::graph::Options options{.algorithm = Algorithm::kDeltaStepping, .delta = delta, .backend = backend};
+        const auto paths = ppc::graph::ShortestPaths(graph, 1, options);
+        ExpectSameDistances(paths.distance, reference.distance);
+        EXPECT_GT(paths.rounds, 0U);
+      }
+      const auto paths =
+          ppc::graph::ShortestPaths(graph, 1, {.algorithm = Algorithm::kBellmanFord, .backend = backend});
+      ExpectSameDistances(paths.distance, reference.distance);
+      EXPECT_GE(paths.relaxations, reference.relaxations);
+    }
+  }
+}
+
+TEST(Graph, BellmanFordTakesNegativeWeights) {
+  const std::vector<Edge> edges = {{.from = 0, .to = 1, .weight = 4.0},
+                                   {.from = 0, .to = 2, .weight = 1.0},
+                                   {.from = 2, .to = 1, .weight = -2.0},
+                                   {.from = 1, .to = 3, .weight = 1.0}};
+  const Graph graph = ppc::graph::FromEdges(5, edges);
+  for (const Backend backend : kAllBackends) {
+    const auto paths = ppc::graph::ShortestPaths(graph, 0, {.algorithm = Algorithm::kBellmanFord, .backend = backend});
+    EXPECT_EQ(paths.distance, (std::vector<double>{0.0, -1.0, 1.0, 0.0, kInfinity}));
+  }
+  EXPECT_THROW((void)ppc::graph::ShortestPaths(graph, 0, {.algorithm = Algorithm::kDeltaStepping}),
+               std::invalid_argument);
+  EXPECT_THROW((void)ppc::graph::ShortestPaths(graph, 5), std::invalid_argument);
+
+  std::vector<Edge> cycle = edges;
+  cycle.push_back({.from = 3, .to = 2, .weight = 0.5});
+  EXPECT_THROW((void)ppc::graph::ShortestPaths(ppc::graph::FromEdges(5, cycle), 0,
+                                               {.algorithm = Algorithm::kBellmanFord, .backend = Backend::kOmp}),
+               std::runtime_error);
+}
+
+TEST(Graph, DistributedShortestPathsBatchRemoteRelaxations) {
+  if (!ppc::util::MpiReady()) {
+    GTEST_SKIP() << "MPI is not initialized";
+  }
+  int rank = 0;
+  int size = 1;
+  MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+  MPI_Comm_size(MPI_COMM_WORLD, &size);
+  // Small batches, so that busy supersteps take several exchange rounds.
+  const std::size_t saved = ppc::graph::GetTuning().message_batch;
+  ppc::graph::GetTuning().message_batch = 7;
+  for (const Graph &graph : TestGraphs()) {
+    const auto reference = ppc::graph::ShortestPaths(graph, 0, {.algorithm = Algorithm::kDijkstra});
+    const auto [begin, end] = ppc::shared_memory::BlockRange(graph.vertices, size, rank);
+    const Graph local = ppc::graph::SliceVertices(graph, begin, end);
+    const std::vector<double> expected(reference.distance.begin() + static_cast<std::ptrdiff_t>(begin),
+                                       reference.distance.begin() + static_cast<std::ptrdiff_t>(end));
+    for (const Algorithm algorithm : {Algorithm::kDeltaStepping, Algorithm::kBellmanFord}) {
+      const auto paths =
+          ppc::graph::DistributedShortestPaths(local, graph.vertices, 0, {.algorithm = algorithm}, MPI_COMM_WORLD);
+      ExpectSameDistances(paths.distance, expected);
+      EXPECT_EQ(paths.messages > 0, size > 1) << ppc::graph::AlgorithmToString(algorithm);
+      EXPECT_GE(paths.relaxations, reference.relaxations);
+    }
+    EXPECT_THROW((void)ppc::graph::DistributedShortestPaths(local, graph.vertices, 0,
+                                                            {.algorithm = Algorithm::kDijkstra}, MPI_COMM_WORLD),
+                 std::invalid_argument);
+  }
+  ppc::graph::GetTuning().message_batch = saved;
+}
+
+namespace {
+
+template <TypeOfTask kType, Algorithm kAlgorithm>
+void RunShortestPathsTask() {
+  const ppc::graph::SsspProblem problem{.graph = ppc::graph::GridGraph(25, 20, 9), .source = 42};
+  ppc::graph::ShortestPathsTask<kType, kAlgorithm> task(problem);
+  ASSERT_TRUE(task.Validation());
+  ASSERT_TRUE(task.PreProcessing());
+  ASSERT_TRUE(task.Run());
+  ASSERT_TRUE(task.PostProcessing());
+  const auto reference = ppc::graph::ShortestPaths(problem.graph, problem.source, {.algorithm = Algorithm::kDijkstra});
+  ExpectSameDistances(task.GetOutput().distance, reference.distance);
+}
+
+}  // namespace
+
+TEST(Graph, TasksMatchDijkstraOnEveryBackend) {
+  RunShortestPathsTask<TypeOfTask::kSEQ, Algorithm::kDijkstra>();
+  RunShortestPathsTask<TypeOfTask::kOMP, Algorithm::kDeltaStepping>();
+  RunShortestPathsTask<TypeOfTask::kTBB, Algorithm::kBellmanFord>();
+  RunShortestPathsTask<TypeOfTask::kSTL, Algorithm::kDeltaStepping>();
+  if (ppc::util::MpiReady()) {
+    RunShortestPathsTask<TypeOfTask::kMPI, Algorithm::kDeltaStepping>();
+    RunShortestPathsTask<TypeOfTask::kMPI, Algorithm::kBellmanFord>();
+  }
+}
@@ -0,0 +1,161 @@
+#pragma once
+
+#include <mpi.h>
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "shared_memory/include/shared_memory.hpp"
+
+namespace ppc::hybrid {
+
+/// @brief Thread support level requested from MPI_Init_thread by the test runners.
+/// @details SERIALIZED lets the progress thread own MPI while the main thread computes;
+/// worker threads of the pool never call MPI.
+inline constexpr int kRequestedThreadLevel = MPI_THREAD_SERIALIZED;
+
+/// @brief Fixed-size pool of STL threads with a blocking parallel-for.
+/// @details The calling thread takes part in every loop as worker 0, so a pool of one
+/// thread runs the body inline without any synchronisation.
+class ThreadPool {
+ public:
+  /// @brief Starts @p num_threads - 1 helper threads.
+  explicit ThreadPool(int num_threads);
+  ~ThreadPool();
+
+  ThreadPool(const ThreadPool &) = delete;
+  ThreadPool &operator=(const ThreadPool &) = delete;
+
+  /// @brief Number of threads taking part in a loop (helpers + caller).
+  [[nodiscard]] int Size() const {
+    return static_cast<int>(workers_.size()) + 1;
+  }
+
+  /// @brief Runs @p body(i) for i in [begin, end) split into one contiguous block per thread.
+  /// @throws Rethrows the first exception raised by @p body.
+  void ParallelFor(int begin, int end, const std::function<void(int)> &body);
+
+  /// @brief Runs @p body(thread_id) once on every thread of the pool.
+  void RunOnAll(const std::function<void(int)> &body);
+
+ private:
+  void Launch(int begin, int end, const std::function<void(int)> &body, bool per_thread);
+  void WorkerLoop(int id);
+  void RunChunk(int id);
+
+  std::vector<std::thread> workers_;
+  std::mutex mutex_;
+  std::condition_variable start_cv_;
+  std::condition_variable done_cv_;
+  const std::function<void(int)> *body_ = nullptr;
+  int begin_ = 0;
+  int end_ = 0;
+  bool per_thread_ = false;
+  std::uint64_t generation_ = 0;
+  int pending_ = 0;
+  bool stop_ = false;
+  std::exception_ptr error_;
+};
+
+/// @brief Dedicated thread that owns MPI communication for a hybrid kernel.
+/// @details Communication closures are executed one at a time in submission order, which
+/// is exactly what MPI_THREAD_SERIALIZED allows. When MPI provides a lower level the
+/// closures run inline on the submitting thread, which must then be the main thread.
+class ProgressThread {
+ public:
+  /// @param asynchronous Start a background thread; otherwise Submit() runs inline.
+  explicit ProgressThread(bool asynchronous);
+  ~ProgressThread();
+
+  ProgressThread(const ProgressThread &) = delete;
+  ProgressThread &operator=(const ProgressThread &) = delete;
+
+  /// @brief True when closures run on the background thread.
+  [[nodiscard]] bool IsAsynchronous() const {
+    return thread_.joinable();
+  }
+
+  /// @brief Queues @p fn for execution on the progress thread.
+  /// @note The caller must not issue MPI calls until the returned future is ready.
+  template <typename Fn>
+  auto Submit(Fn &&fn) -> std::future<std::invoke_result_t<Fn>> {
+    using Result = std::invoke_result_t<Fn>;
+    auto task = std::make_shared<std::packaged_task<Result()>>(std::forward<Fn>(fn));
+    auto future = task->get_future();
+    Enqueue([task] { (*task)(); });
+    return future;
+  }
+
+ private:
+  void Enqueue(std::function<void()> job);
+  void Loop();
+
+  std::thread thread_;
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  std::deque<std::function<void()>> queue_;
+  bool stop_ = false;
+};
+
+/// @brief Execution context handed to kALL tasks.
+/// @details Bundles the node/leader communicators (intra-node work with threads,
+/// inter-node work with one rank per node), the local thread pool and the progress thread.
+class Context {
+ public:
+  /// @brief Builds the context (collective over @p comm).
+  /// @param comm Communicator of the participating ranks.
+  /// @param num_threads Threads per rank for the local pool.
+  Context(MPI_Comm comm, int num_threads);
+  ~Context();
+
+  Context(const Context &) = delete;
+  Context &operator=(const Context &) = delete;
+
+  /// @brief Process-wide context over MPI_COMM_WORLD sized by PPC_NUM_THREADS.
+  /// @note Created on first use, which must happen on all ranks (collective).
+  static Context &Default();
+
+  [[nodiscard]] const ppc::shared_memory::NodeTopology &Topology() const {
+    return topology_;
+  }
+  /// @brief Communicator of all participating ranks.
+  [[nodiscard]] MPI_Comm Comm() const {
+    return topology_.Parent();
+  }
+  /// @brief Ranks sharing the node with this rank.
+  [[nodiscard]] MPI_Comm Node() const {
+    return topology_.Node();
+  }
+  /// @brief One rank per node; MPI_COMM_NULL on non-leaders.
+  [[nodiscard]] MPI_Comm Leaders() const {
+    return topology_.Leaders();
+  }
+  [[nodiscard]] ThreadPool &Pool() {
+    return *pool_;
+  }
+  [[nodiscard]] ProgressThread &Progress() {
+    return *progress_;
+  }
+  /// @brief Thread support level reported by MPI_Query_thread.
+  [[nodiscard]] int ThreadLevel() const {
+    return thread_level_;
+  }
+
+ private:
+  ppc::shared_memory::NodeTopology topology_;
+  int thread_level_ = MPI_THREAD_SINGLE;
+  std::unique_ptr<ThreadPool> pool_;
+  std::unique_ptr<ProgressThread> progress_;
+};
+
+}  // namespace ppc::hybrid
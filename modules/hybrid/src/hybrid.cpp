@@ -0,0 +1,180 @@
+#include "hybrid/include/hybrid.hpp"
+
+#include <mpi.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+
+#include "shared_memory/include/shared_memory.hpp"
+#include "util/include/util.hpp"
+
+namespace ppc::hybrid {
+
+ThreadPool::ThreadPool(int num_threads) {
+  const int helpers = std::max(num_threads, 1) - 1;
+  workers_.reserve(static_cast<std::size_t>(helpers));
+  for (int i = 0; i < helpers; i++) {
+    workers_.emplace_back([this, i] { WorkerLoop(i + 1); });
+  }
+}
+
+ThreadPool::~ThreadPool() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stop_ = true;
+  }
+  start_cv_.notify_all();
+  for (auto &worker : workers_) {
+    worker.join();
+  }
+}
+
+void ThreadPool::ParallelFor(int begin, int end, const std::function<void(int)> &body) {
+  Launch(begin, end, body, false);
+}
+
+void ThreadPool::RunOnAll(const std::function<void(int)> &body) {
+  Launch(0, Size(), body, true);
+}
+
+void ThreadPool::Launch(int begin, int end, const std::function<void(int)> &body, bool per_thread) {
+  if (end <= begin) {
+    return;
+  }
+  if (workers_.empty()) {
+    for (int i = begin; i < end; i++) {
+      body(i);
+    }
+    return;
+  }
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    body_ = &body;
+    begin_ = begin;
+    end_ = end;
+    per_thread_ = per_thread;
+    pending_ = static_cast<int>(workers_.size());
+    error_ = nullptr;
+    generation_++;
+  }
+  start_cv_.notify_all();
+  RunChunk(0);
+
+  std::unique_lock<std::mutex> lock(mutex_);
+  done_cv_.wait(lock, [this] { return pending_ == 0; });
+  body_ = nullptr;
+  if (error_) {
+    std::rethrow_exception(std::exchange(error_, nullptr));
+  }
+}
+
+void ThreadPool::RunChunk(int id) {
+  try {
+    if (per_thread_) {
+      (*body_)(id);
+      return;
+    }
+    const auto [first, last] =
+        ppc::shared_memory::BlockRange(static_cast<std::size_t>(end_ - begin_), Size(), id);
+    for (auto i = first; i < last; i++) {
+      (*body_)(begin_ + static_cast<int>(i));
+    }
+  } catch (...) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!error_) {
+      error_ = std::current_exception();
+    }
+  }
+}
+
+void ThreadPool::WorkerLoop(int id) {
+  std::uint64_t seen = 0;
+  while (true) {
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      start_cv_.wait(lock, [&] { return stop_ || generation_ != seen; });
+      if (stop_) {
+        return;
+      }
+      seen = generation_;
+    }
+    RunChunk(id);
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      pending_--;
+    }
+    done_cv_.notify_one();
+  }
+}
+
+ProgressThread::ProgressThread(bool asynchronous) {
+  if (asynchronous) {
+    thread_ = std::thread([this] { Loop(); });
+  }
+}
+
+ProgressThread::~ProgressThread() {
+  if (!thread_.joinable()) {
+    return;
+  }
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stop_ = true;
+  }
+  cv_.notify_one();
+  thread_.join();
+}
+
+void ProgressThread::Enqueue(std::function<void()> job) {
+  if (!thread_.joinable()) {
+    job();
+    return;
+  }
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    queue_.push_back(std::move(job));
+  }
+  cv_.notify_one();
+}
+
+void ProgressThread::Loop() {
+  while (true) {
+    std::function<void()> job;
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      cv_.wait(lock, [this] { return stop_ || !queue_.empty(); });
+      if (queue_.empty()) {
+        return;
+      }
+      job = std::move(queue_.front());
+      queue_.pop_front();
+    }
+    job();
+  }
+}
+
+Context::Context(MPI_Comm comm, int num_threads) : topology_(comm) {
+  MPI_Query_thread(&thread_level_);
+  pool_ = std::make_unique<ThreadPool>(num_threads);
+  progress_ = std::make_unique<ProgressThread>(thread_level_ >= MPI_THREAD_SERIALIZED);
+}
+
+Context::~Context() {
+  // Stop the progress thread before the communicators it may use are freed.
+  progress_.reset();
+  pool_.reset();
+}
+
+Context &Context::Default() {
+  static Context context(MPI_COMM_WORLD, ppc::util::GetNumThreads());
+  return context;
+}
+
+}  // namespace ppc::hybrid
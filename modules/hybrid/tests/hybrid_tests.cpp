@@ -0,0 +1,118 @@
+#include <gtest/gtest.h>
+#include <mpi.h>
+
+#include <atomic>
+#include <cstddef>
+#include <future>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "hybrid/include/hybrid.hpp"
+
+using ppc::hybrid::Context;
+using ppc::hybrid::ProgressThread;
+using ppc::hybrid::ThreadPool;
+
+TEST(HybridThreadPool, ParallelForVisitsEveryIndexOnce) {
+  ThreadPool pool(4);
+  ASSERT_EQ(pool.Size(), 4);
+  std::vector<std::atomic<int>> hits(1000);
+  pool.ParallelFor(0, 1000, [&](int i) { hits[static_cast<std::size_t>(i)]++; });
+  for (const auto &hit : hits) {
+    EXPECT_EQ(hit.load(), 1);
+  }
+}
+
+TEST(HybridThreadPool, ParallelForCanBeReused) {
+  ThreadPool pool(3);
+  std::atomic<int> sum(0);
+  for (int round = 0; round < 50; round++) {
+    pool.ParallelFor(round, round + 10, [&](int i) { sum += i; });
+  }
+  int expected = 0;
+  for (int round = 0; round < 50; round++) {
+    for (int i = round; i < round + 10; i++) {
+      expected += i;
+    }
+  }
+  EXPECT_EQ(sum.load(), expected);
+}
+
+TEST(HybridThreadPool, RunOnAllPassesDistinctThreadIds) {
+  ThreadPool pool(4);
+  std::vector<std::atomic<int>> ids(4);
+  pool.RunOnAll([&](int id) { ids[static_cast<std::size_t>(id)]++; });
+  for (const auto &id : ids) {
+    EXPECT_EQ(id.load(), 1);
+  }
+}
+
+TEST(HybridThreadPool, SingleThreadRunsInline) {
+  ThreadPool pool(1);
+  const auto caller = std::this_thread::get_id();
+  bool inline_run = true;
+  pool.ParallelFor(0, 5, [&](int /*i*/) { inline_run = inline_run && std::this_thread::get_id() == caller; });
+  EXPECT_TRUE(inline_run);
+}
+
+TEST(HybridThreadPool, RethrowsBodyException) {
+  ThreadPool pool(2);
+  EXPECT_THROW(pool.ParallelFor(0, 100,
+                                [](int i) {
+                                  if (i == 99) {
+                                    throw std::runtime_error("boom");
+                                  }
+                                }),
+               std::runtime_error);
+  std::atomic<int> count(0);
+  pool.ParallelFor(0, 10, [&](int /*i*/) { count++; });
+  EXPECT_EQ(count.load(), 10);
+}
+
+TEST(HybridProgressThread, AsynchronousKeepsSubmissionOrder) {
+  ProgressThread progress(true);
+  EXPECT_TRUE(progress.IsAsynchronous());
+  std::vector<int> order;
+  std::vector<std::future<void>> futures;
+  futures.reserve(10);
+  for (int i = 0; i < 10; i++) {
+    futures.push_back(progress.Submit([&order, i] { order.push_back(i); }));
+  }
+  for (auto &future : futures) {
+    future.get();
+  }
+  ASSERT_EQ(order.size(), 10U);
+  for (int i = 0; i < 10; i++) {
+    EXPECT_EQ(order[static_cast<std::size_t>(i)], i);
+  }
+}
+
+TEST(HybridProgressThread, SynchronousRunsOnCaller) {
+  ProgressThread progress(false);
+  EXPECT_FALSE(progress.IsAsynchronous());
+  auto future = progress.Submit([] { return std::this_thread::get_id(); });
+  EXPECT_EQ(future.get(), std::this_thread::get_id());
+}
+
+TEST(HybridContext, ExposesNodeAndLeaderCommunicators) {
+  int initialized = 0;
+  MPI_Initialized(&initialized);
+  if (initialized == 0) {
+    GTEST_SKIP() << "MPI is not initialized";
+  }
+  Context context(MPI_COMM_WORLD, 2);
+  EXPECT_EQ(context.Pool().Size(), 2);
+  EXPECT_NE(context.Node(), MPI_COMM_NULL);
+  EXPECT_EQ(context.Topology().IsLeader(), context.Leaders() != MPI_COMM_NULL);
+
+  int ranks_on_node = 1;
+  if (context.Leaders() != MPI_COMM_NULL) {
+    ranks_on_node = context.Topology().NodeSize();
+    context.Progress()
+        .Submit([&] { MPI_Allreduce(MPI_IN_PLACE, &ranks_on_node, 1, MPI_INT, MPI_SUM, context.Leaders()); })
+        .get();
+  }
+  MPI_Bcast(&ranks_on_node, 1, MPI_INT, 0, context.Node());
+  EXPECT_EQ(ranks_on_node, context.Topology().Size());
+}
@@ -0,0 +1,131 @@
+#pragma once
+
+#include <mpi.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "image/include/image.hpp"
+#include "shared_memory/include/parallel_for.hpp"
+
+namespace ppc::image {
+
+using Backend = ppc::shared_memory::Backend;
+
+/// @brief Value of the samples outside the image.
+enum class Border : uint8_t {
+  /// The nearest edge sample (aaa|abc|ccc)
+  kClamp,
+  /// Reflection about the edge sample, which is not repeated (cb|abc|ba)
+  kMirror,
+  /// The other side of the image (bc|abc|ab)
+  kWrap,
+  /// Zero
+  kZero
+};
+
+/// @brief Returns the lower-case name of the border ("clamp", "mirror", "wrap", "zero").
+std::string BorderToString(Border border);
+
+/// @brief Index of sample @p index of a row or column of @p size samples after the @p border
+/// mapping; -1 for a zero sample.
+std::ptrdiff_t BorderIndex(std::ptrdiff_t index, std::size_t size, Border border);
+
+/// @brief Image operation of the course variants.
+enum class Operation : uint8_t {
+  /// 3 x 3 Gaussian blur, [1 2 1] / 4 in both directions, rounded
+  kGaussian,
+  /// Sobel gradient magnitude |gx| + |gy|, saturated to 255
+  kSobel,
+  /// Sobel of the Gaussian blur, fused so that the blurred rows stay in cache
+  kGaussianSobel
+};
+
+/// @brief Returns the lower-case name of the operation ("gaussian", "sobel", "gaussian_sobel").
+std::string OperationToString(Operation operation);
+
+/// @brief Separable integer kernel of odd lengths, centred: every output sample is
+/// (sum of vertical[i] * horizontal[j] * input + 2^(shift - 1)) >> shift, saturated to [0, 255].
+struct Kernel {
+  std::vector<int> horizontal;
+  std::vector<int> vertical;
+  int shift = 0;
+};
+
+/// @brief The kernel of Operation::kGaussian.
+Kernel GaussianKernel();
+
+struct Options {
+  Border border = Border::kClamp;
+  Backend backend = Backend::kSeq;
+};
+
+struct Tuning {
+  /// Rows of a tile; the horizontal pass of a tile keeps tile_rows plus the kernel height rows.
+  std::size_t tile_rows = 16;
+  /// Samples of a tile row, all channels of the interleaved layout counted.
+  std::size_t tile_samples = 2048;
+};
+
+/// @brief Returns the tuning shared by all kernels of this module.
+Tuning &GetTuning();
+
+/// @brief Convolves every channel of @p image with @p kernel.
+/// @details The image is cut into tiles of Tuning::tile_rows x Tuning::tile_samples handed out to
+/// the workers. A tile runs the horizontal pass over its rows and the vertical halo, then the
+/// vertical pass. Kernels whose sums fit 16 bits use AVX2 over 16 samples at a time where the CPU
+/// has it, with the saturation of the packing instructions. Results are exact, hence the same on
+/// every back-end and instruction set.
+/// @throws std::invalid_argument When the image is invalid, a kernel length is even, the shift is
+/// not in [0, 24], or the sums may overflow 32 bits.
+Image Convolve(const Image &image, const Kernel &kernel, const Options &options = {});
+
+/// @brief Applies @p operation to every channel of @p image, tiled as Convolve().
+/// @details kGaussianSobel works on bands of Tuning::tile_rows full rows: the band is blurred
+/// with one row of halo on each side and differentiated right away, which gives the same result
+/// as Sobel after a separate Gaussian pass.
+/// @throws std::invalid_argument When the image is invalid.
+Image Apply(const Image &image, Operation operation, const Options &options = {});
+
+/// @brief How the image is split over the ranks.
+enum class Partition : uint8_t {
+  /// Strips of whole rows
+  kRows,
+  /// Strips of whole columns
+  kColumns,
+  /// A near-square grid of blocks
+  kBlocks
+};
+
+/// @brief Returns the lower-case name of the partition ("rows", "columns", "blocks").
+std::string PartitionToString(Partition partition);
+
+/// @brief Window of the image a rank owns.
+struct Block {
+  std::size_t x0 = 0;
+  std::size_t y0 = 0;
+  std::size_t width = 0;
+  std::size_t height = 0;
+};
+
+/// @brief Block of rank @p rank of @p size under @p partition, in BlockRange shares of the rows
+/// and columns of the process grid.
+Block PartitionBlock(std::size_t width, std::size_t height, Partition partition, int size, int rank);
+
+/// @brief Applies @p operation to a @p width x @p height image split over the ranks of @p comm.
+/// @details Rank r holds its PartitionBlock() in @p local. The blocks exchange a halo of one
+/// sample with their grid neighbours, rows first and then columns of the extended block, which
+/// brings the corners along; samples beyond the image are filled by the border, from the opposite
+/// rank for Border::kWrap. kGaussianSobel takes two exchanges, one per pass.
+/// @return The local block of the result.
+/// @throws std::invalid_argument On every rank when a block does not match its partition or is
+/// thinner than two samples.
+Image DistributedApply(const Image &local, std::size_t width, std::size_t height, Operation operation,
+                       Partition partition, const Options &options, MPI_Comm comm);
+
+/// @brief Assembles the whole image on every rank from the PartitionBlock() of each in @p local.
+Image AllGatherImage(const Image &local, std::size_t width, std::size_t height, Partition partition, MPI_Comm comm);
+
+}  // namespace ppc::image
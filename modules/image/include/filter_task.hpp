@@ -0,0 +1,73 @@
+#pragma once
+
+#include <mpi.h>
+
+#include "image/include/filter.hpp"
+#include "image/include/image.hpp"
+#include "shared_memory/include/parallel_for.hpp"
+#include "task/include/task.hpp"
+
+namespace ppc::image {
+
+/// @brief Image operation with the clamp border as a course task on any back-end.
+/// @details The kMPI variant crops the PartitionBlock() of its rank in PreProcessing, runs
+/// DistributedApply() and assembles the result on every rank; every rank holds the whole input,
+/// as in the course tasks.
+template <ppc::task::TypeOfTask kType, Operation kOperation, Partition kPartition = Partition::kRows>
+class FilterTask : public ppc::task::Task<Image, Image> {
+ public:
+  using InType = Image;
+  using OutType = Image;
+
+  static constexpr ppc::task::TypeOfTask GetStaticTypeOfTask() {
+    return kType;
+  }
+
+  explicit FilterTask(const InType &in) {
+    this->SetTypeOfTask(GetStaticTypeOfTask());
+    this->GetInput() = in;
+  }
+
+ private:
+  bool ValidationImpl() override {
+    const InType &in = this->GetInput();
+    return IsValid(in) && in.width > 0 && in.height > 0;
+  }
+
+  bool PreProcessingImpl() override {
+    if constexpr (kType == ppc::task::TypeOfTask::kMPI) {
+      int rank = 0;
+      int size = 1;
+      MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+      MPI_Comm_size(MPI_COMM_WORLD, &size);
+      const InType &in = this->GetInput();
+      const Block block = PartitionBlock(in.width, in.height, kPartition, size, rank);
+      local_ = Crop(in, block.x0, block.y0, block.width, block.height);
+    }
+    return true;
+  }
+
+  bool RunImpl() override {
+    const InType &in = this->GetInput();
+    Options options;
+    options.backend = ppc::shared_memory::BackendOf(kType);
+    if constexpr (kType != ppc::task::TypeOfTask::kMPI) {
+      this->GetOutput() = Apply(in, kOperation, options);
+    } else {
+      const Image result =
+          DistributedApply(local_, in.width, in.height, kOperation, kPartition, options, MPI_COMM_WORLD);
+      this->GetOutput() = AllGatherImage(result, in.width, in.height, kPartition, MPI_COMM_WORLD);
+    }
+    return true;
+  }
+
+  bool PostProcessingImpl() override {
+    const OutType &out = this->GetOutput();
+    const InType &in = this->GetInput();
+    return out.width == in.width && out.height == in.height && out.channels == in.channels && IsValid(out);
+  }
+
+  Image local_;
+};
+
+}  // namespace ppc::image
@@ -0,0 +1,70 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <vector>
+
+namespace ppc::image {
+
+/// @brief Order of the channel samples in memory.
+enum class Layout : uint8_t {
+  /// Pixel after pixel with all its channels, as stbi_load() returns images
+  kInterleaved,
+  /// One width x height plane per channel
+  kPlanar
+};
+
+/// @brief Returns the lower-case name of the layout ("interleaved", "planar").
+std::string LayoutToString(Layout layout);
+
+/// @brief Image of 8-bit samples.
+struct Image {
+  std::size_t width = 0;
+  std::size_t height = 0;
+  std::size_t channels = 1;
+  Layout layout = Layout::kInterleaved;
+  std::vector<std::uint8_t> pixels;
+
+  [[nodiscard]] std::size_t Index(std::size_t x, std::size_t y, std::size_t channel) const {
+    return layout == Layout::kInterleaved ? (((y * width) + x) * channels) + channel
+                                          : (((channel * height) + y) * width) + x;
+  }
+  [[nodiscard]] std::uint8_t &At(std::size_t x, std::size_t y, std::size_t channel) {
+    return pixels[Index(x, y, channel)];
+  }
+  [[nodiscard]] std::uint8_t At(std::size_t x, std::size_t y, std::size_t channel) const {
+    return pixels[Index(x, y, channel)];
+  }
+
+  friend bool operator==(const Image &, const Image &) = default;
+};
+
+/// @brief Returns a black image.
+Image MakeImage(std::size_t width, std::size_t height, std::size_t channels, Layout layout = Layout::kInterleaved);
+
+/// @brief Whether @p image has at least one channel and width * height * channels samples.
+bool IsValid(const Image &image);
+
+/// @brief Image of the flat interleaved buffer @p bytes, as stbi_load() returns it, in @p layout.
+/// @throws std::invalid_argument When the buffer does not hold width * height * channels bytes or
+/// channels is 0.
+Image FromInterleaved(std::span<const std::uint8_t> bytes, std::size_t width, std::size_t height,
+                      std::size_t channels, Layout layout = Layout::kInterleaved);
+
+/// @brief Returns @p image with its samples in @p layout.
+Image ToLayout(const Image &image, Layout layout);
+
+/// @brief Returns the @p width x @p height window of @p image at (@p x0, @p y0), in its layout.
+/// @throws std::invalid_argument When the window does not fit the image.
+Image Crop(const Image &image, std::size_t x0, std::size_t y0, std::size_t width, std::size_t height);
+
+/// @brief Copies @p source into @p target at (@p x0, @p y0); layouts may differ.
+/// @throws std::invalid_argument When the channels differ or @p source does not fit.
+void Paste(Image &target, const Image &source, std::size_t x0, std::size_t y0);
+
+/// @brief Synthetic test picture: gradients, a few discs and uniform noise in every channel.
+Image TestPattern(std::size_t width, std::size_t height, std::size_t channels, Layout layout, std::uint64_t seed);
+
+}  // namespace ppc::image
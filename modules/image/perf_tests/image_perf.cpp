@@ -0,0 +1,90 @@
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <string>
+#include <tuple>
+
+#include "image/include/filter.hpp"
+#include "image/include/filter_task.hpp"
+#include "image/include/image.hpp"
+#include "task/include/task.hpp"
+#include "util/include/perf_test_util.hpp"
+
+namespace ppc::image::perf {
+
+using ppc::task::TypeOfTask;
+
+namespace {
+
+constexpr std::size_t kSide = 2048;
+
+/// A 2048 x 2048 RGB picture, shared by the cases of a suite.
+template <Layout kLayout>
+const Image &Picture() {
+  static const Image kPicture = TestPattern(kSide, kSide, 3, kLayout, 1);
+  return kPicture;
+}
+
+}  // namespace
+
+/// Reports megapixels per second.
+template <Layout kLayout>
+class FilterPerfTests : public ppc::util::BaseRunPerfTests<Image, Image> {
+  bool CheckTestOutputData(Image &output_data) final {
+    PrintRate("mpixels_per_s", static_cast<double>(kSide * kSide) / 1e6);
+    return output_data.width == kSide && output_data.height == kSide;
+  }
+
+  Image GetTestInputData() final {
+    return Picture<kLayout>();
+  }
+};
+
+/// FilterTask of every back-end for one operation; MPI splits the image into row strips.
+template <Operation kOperation>
+struct FilterTasks {
+  template <TypeOfTask kType>
+  using Task = FilterTask<kType, kOperation>;
+};
+
+/// Every back-end, then MPI with the other partitions.
+template <Operation kOperation>
+auto MakeBackendSuite(const std::string &layout) {
+  const std::string kernel = OperationToString(kOperation) + "_" + layout;
+  using ColumnsTask = FilterTask<TypeOfTask::kMPI, kOperation, Partition::kColumns>;
+  using BlocksTask = FilterTask<TypeOfTask::kMPI, kOperation, Partition::kBlocks>;
+  return std::tuple_cat(
+      ppc::util::MakeBackendPerfTaskTuples<FilterTasks<kOperation>::template Task, Image>("ppc_image", kernel),
+      ppc::util::MakeNamedPerfTaskTuples<ColumnsTask, Image>("ppc_image_mpi_columns_" + kernel),
+      ppc::util::MakeNamedPerfTaskTuples<BlocksTask, Image>("ppc_image_mpi_blocks_" + kernel));
+}
+
+namespace {
+
+auto MakeLayoutSuite(const std::string &layout) {
+  return std::tuple_cat(MakeBackendSuite<Operation::kGaussian>(layout), MakeBackendSuite<Operation::kSobel>(layout),
+                        MakeBackendSuite<Operation::kGaussianSobel>(layout));
+}
+
+}  // namespace
+
+using InterleavedPerfTests = FilterPerfTests<Layout::kInterleaved>;
+using PlanarPerfTests = FilterPerfTests<Layout::kPlanar>;
+
+TEST_P(InterleavedPerfTests, RunPerfModes) {
+  ExecuteTest(GetParam());
+}
+
+TEST_P(PlanarPerfTests, RunPerfModes) {
+  ExecuteTest(GetParam());
+}
+
+const auto kInterleavedPerfTasks = MakeLayoutSuite("interleaved");
+const auto kPlanarPerfTasks = MakeLayoutSuite("planar");
+
+INSTANTIATE_TEST_SUITE_P(FilterInterleaved, InterleavedPerfTests, ppc::util::TupleToGTestValues(kInterleavedPerfTasks),
+                         InterleavedPerfTests::CustomPerfTestName);
+INSTANTIATE_TEST_SUITE_P(FilterPlanar, PlanarPerfTests, ppc::util::TupleToGTestValues(kPlanarPerfTasks),
+                         PlanarPerfTests::CustomPerfTestName);
+
+}  // namespace ppc::image::perf
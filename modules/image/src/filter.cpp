@@ -0,0 +1,690 @@
+#include "image/include/filter.hpp"
+
+#include <mpi.h>
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <numeric>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "image/include/image.hpp"
+#include "reduction/include/reduction.hpp"
+#include "shared_memory/include/parallel_for.hpp"
+#include "shared_memory/include/shared_memory.hpp"
+
+#ifdef PPC_TARGET_AVX2
+#define PPC_IMAGE_X86 1
+#include <immintrin.h>
+#endif
+
+namespace ppc::image {
+
+namespace {
+
+/// Samples of a 2-D array in which horizontal neighbours are step apart: one plane of a planar
+/// image (step 1) or a whole interleaved image (step = channels).
+struct Plane {
+  const std::uint8_t *data;
+  std::size_t rows;
+  std::size_t samples;
+  std::size_t step;
+
+  /// Row @p y after the border mapping; nullptr for a zero row.
+  [[nodiscard]] const std::uint8_t *Row(std::ptrdiff_t y, Border border) const {
+    const std::ptrdiff_t mapped = BorderIndex(y, rows, border);
+    return mapped < 0 ? nullptr : data + (static_cast<std::size_t>(mapped) * samples);
+  }
+};
+
+/// The planes of @p image and the matching ones of @p output, which has the same shape.
+std::vector<std::pair<Plane, std::uint8_t *>> PlanesOf(const Image &image, Image &output) {
+  if (image.layout == Layout::kInterleaved) {
+    return {{Plane{.data = image.pixels.data(),
+                   .rows = image.height,
+                   .samples = image.width * image.channels,
+                   .step = image.channels},
+             output.pixels.data()}};
+  }
+  std::vector<std::pair<Plane, std::uint8_t *>> planes;
+  const std::size_t size = image.width * image.height;
+  for (std::size_t channel = 0; channel < image.channels; channel++) {
+    planes.emplace_back(
+        Plane{.data = image.pixels.data() + (channel * size), .rows = image.height, .samples = image.width, .step = 1},
+        output.pixels.data() + (channel * size));
+  }
+  return planes;
+}
+
+/// Writes samples begin .. begin + out.size() - 1 of @p row (nullptr for a zero row) to @p out,
+/// mapping those beyond the row pixel by pixel through the border.
+void LoadPadded(const std::uint8_t *row, const Plane &plane, std::ptrdiff_t begin, Border border,
+                std::span<std::uint8_t> out) {
+  if (row == nullptr) {
+    std::ranges::fill(out, std::uint8_t{0});
+    return;
+  }
+  const auto samples = static_cast<std::ptrdiff_t>(plane.samples);
+  const auto step = static_cast<std::ptrdiff_t>(plane.step);
+  const auto end = begin + static_cast<std::ptrdiff_t>(out.size());
+  const std::ptrdiff_t low = std::clamp<std::ptrdiff_t>(begin, 0, samples);
+  const std::ptrdiff_t high = std::clamp<std::ptrdiff_t>(end, low, samples);
+  if (low < high) {
+    std::memcpy(out.data() + (low - begin), row + low, static_cast<std::size_t>(high - low));
+  }
+  const auto outside = [&](std::ptrdiff_t sample) {
+    const std::ptrdiff_t pixel = sample >= 0 ? sample / step : -((step - 1 - sample) / step);
+    const std::ptrdiff_t mapped = BorderIndex(pixel, plane.samples / plane.step, border);
+    out[static_cast<std::size_t>(sample - begin)] = mapped < 0 ? 0 : row[(mapped * step) + (sample - (pixel * step))];
+  };
+  for (std::ptrdiff_t sample = begin; sample < std::min(low, end); sample++) {
+    outside(sample);
+  }
+  for (std::ptrdiff_t sample = std::max(high, begin); sample < end; sample++) {
+    outside(sample);
+  }
+}
+
+std::int64_t AbsoluteSum(const std::vector<int> &taps) {
+  return std::accumulate(taps.begin(), taps.end(), std::int64_t{0},
+                         [](std::int64_t sum, int tap) { return sum + std::abs(static_cast<std::int64_t>(tap)); });
+}
+
+int Rounding(int shift) {
+  return shift > 0 ? 1 << (shift - 1) : 0;
+}
+
+void CheckKernel(const Kernel &kernel) {
+  if (kernel.horizontal.size() % 2 == 0 || kernel.vertical.size() % 2 == 0) {
+    throw std::invalid_argument("Convolve: kernel lengths must be odd");
+  }
+  if (kernel.shift < 0 || kernel.shift > 24) {
+    throw std::invalid_argument("Convolve: shift must be in [0, 24]");
+  }
+  if ((AbsoluteSum(kernel.horizontal) * AbsoluteSum(kernel.vertical) * 255) + Rounding(kernel.shift) >
+      std::int64_t{0x7FFFFFFF}) {
+    throw std::invalid_argument("Convolve: kernel sums may overflow");
+  }
+}
+
+/// Whether the horizontal sums and the whole convolution fit 16-bit lanes.
+bool Fits16(const Kernel &kernel) {
+  const std::int64_t horizontal = AbsoluteSum(kernel.horizontal) * 255;
+  return horizontal <= 0x7FFF && (horizontal * AbsoluteSum(kernel.vertical)) + Rounding(kernel.shift) <= 0x7FFF;
+}
+
+bool UseSimd() {
+  return ppc::reduction::ActiveIsa() != ppc::reduction::Isa::kScalar;
+}
+
+#ifdef PPC_IMAGE_X86
+
+namespace avx2 {
+
+// 16 samples per register, widened to 16 bits; the kernels that reach here cannot overflow them.
+
+constexpr std::size_t kWidth = 16;
+
+PPC_TARGET_AVX2 __m256i Widen(const std::uint8_t *samples) {
+  return _mm256_cvtepu8_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i *>(samples)));
+}
+
+/// Saturates 16 lanes to [0, 255] and stores them as bytes.
+PPC_TARGET_AVX2 void StoreSaturated(std::uint8_t *out, __m256i values) {
+  const __m256i packed = _mm256_permute4x64_epi64(_mm256_packus_epi16(values, values), 0xD8);
+  _mm_storeu_si128(reinterpret_cast<__m128i *>(out), _mm256_castsi256_si128(packed));
+}
+
+PPC_TARGET_AVX2 std::size_t Horizontal(const std::uint8_t *padded, std::size_t step, std::span<const int> taps,
+                                       std::size_t count, std::int16_t *out) {
+  std::size_t i = 0;
+  for (; i + kWidth <= count; i += kWidth) {
+    __m256i sum = _mm256_setzero_si256();
+    for (std::size_t k = 0; k < taps.size(); k++) {
+      if (taps[k] != 0) {
+        const __m256i tap = _mm256_set1_epi16(static_cast<std::int16_t>(taps[k]));
+        sum = _mm256_add_epi16(sum, _mm256_mullo_epi16(Widen(padded + i + (k * step)), tap));
+      }
+    }
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(out + i), sum);
+  }
+  return i;
+}
+
+PPC_TARGET_AVX2 std::size_t Vertical(std::span<const std::int16_t *const> rows, std::span<const int> taps, int shift,
+                                     std::size_t count, std::uint8_t *out) {
+  const __m256i rounding = _mm256_set1_epi16(static_cast<std::int16_t>(Rounding(shift)));
+  const __m128i amount = _mm_cvtsi32_si128(shift);
+  std::size_t i = 0;
+  for (; i + kWidth <= count; i += kWidth) {
+    __m256i sum = rounding;
+    for (std::size_t k = 0; k < taps.size(); k++) {
+      if (taps[k] != 0) {
+        const __m256i tap = _mm256_set1_epi16(static_cast<std::int16_t>(taps[k]));
+        const __m256i row = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(rows[k] + i));
+        sum = _mm256_add_epi16(sum, _mm256_mullo_epi16(row, tap));
+      }
+    }
+    StoreSaturated(out + i, _mm256_sra_epi16(sum, amount));
+  }
+  return i;
+}
+
+/// 1 2 1 weighted sum of three widened registers.
+PPC_TARGET_AVX2 __m256i Smooth(__m256i first, __m256i middle, __m256i last) {
+  return _mm256_add_epi16(_mm256_add_epi16(first, last), _mm256_add_epi16(middle, middle));
+}
+
+PPC_TARGET_AVX2 std::size_t Sobel(std::array<const std::uint8_t *, 3> rows, std::size_t step, std::size_t count,
+                                  std::uint8_t *out) {
+  const auto [above, centre, below] = rows;
+  std::size_t i = 0;
+  for (; i + kWidth <= count; i += kWidth) {
+    const __m256i above_left = Widen(above + i);
+    const __m256i above_right = Widen(above + i + (2 * step));
+    const __m256i below_left = Widen(below + i);
+    const __m256i below_right = Widen(below + i + (2 * step));
+    const __m256i left = Smooth(above_left, Widen(centre + i), below_left);
+    const __m256i right = Smooth(above_right, Widen(centre + i + (2 * step)), below_right);
+    const __m256i top = Smooth(above_left, Widen(above + i + step), above_right);
+    const __m256i bottom = Smooth(below_left, Widen(below + i + step), below_right);
+    const __m256i gx = _mm256_abs_epi16(_mm256_sub_epi16(right, left));
+    const __m256i gy = _mm256_abs_epi16(_mm256_sub_epi16(bottom, top));
+    StoreSaturated(out + i, _mm256_add_epi16(gx, gy));
+  }
+  return i;
+}
+
+}  // namespace avx2
+
+#endif
+
+template <typename Acc>
+void HorizontalPass(std::span<const std::uint8_t> padded, std::size_t step, const std::vector<int> &taps,
+                    std::span<Acc> out, bool simd) {
+  std::size_t i = 0;
+#ifdef PPC_IMAGE_X86
+  if constexpr (std::is_same_v<Acc, std::int16_t>) {
+    if (simd) {
+      i = avx2::Horizontal(padded.data(), step, taps, out.size(), out.data());
+    }
+  }
+#else
+  (void)simd;
+#endif
+  for (; i < out.size(); i++) {
+    int sum = 0;
+    for (std::size_t k = 0; k < taps.size(); k++) {
+      sum += taps[k] * padded[i + (k * step)];
+    }
+    out[i] = static_cast<Acc>(sum);
+  }
+}
+
+template <typename Acc>
+void VerticalPass(std::span<const Acc *const> rows, const std::vector<int> &taps, int shift,
+                  std::span<std::uint8_t> out, bool simd) {
+  std::size_t i = 0;
+#ifdef PPC_IMAGE_X86
+  if constexpr (std::is_same_v<Acc, std::int16_t>) {
+    if (simd) {
+      i = avx2::Vertical(rows, taps, shift, out.size(), out.data());
+    }
+  }
+#else
+  (void)simd;
+#endif
+  for (; i < out.size(); i++) {
+    int sum = Rounding(shift);
+    for (std::size_t k = 0; k < taps.size(); k++) {
+      sum += taps[k] * rows[k][i];
+    }
+    out[i] = static_cast<std::uint8_t>(std::clamp(sum >> shift, 0, 255));
+  }
+}
+
+/// Rows [y0, y1) x samples [s0, s1) of the convolution of @p plane; row y0 goes to @p out, the
+/// next ones @p stride further.
+template <typename Acc>
+void ConvolveTile(const Plane &plane, const Kernel &kernel, Border border, std::pair<std::size_t, std::size_t> rows,
+                  std::pair<std::size_t, std::size_t> samples, std::uint8_t *out, std::size_t stride, bool simd) {
+  const auto [y0, y1] = rows;
+  const auto [s0, s1] = samples;
+  const std::size_t count = s1 - s0;
+  const std::size_t radius_x = kernel.horizontal.size() / 2;
+  const std::size_t radius_y = kernel.vertical.size() / 2;
+  std::vector<std::uint8_t> padded(count + (2 * radius_x * plane.step));
+  std::vector<Acc> horizontal((y1 - y0 + (2 * radius_y)) * count);
+  for (std::size_t i = 0; i < y1 - y0 + (2 * radius_y); i++) {
+    const std::uint8_t *row =
+        plane.Row(static_cast<std::ptrdiff_t>(y0 + i) - static_cast<std::ptrdiff_t>(radius_y), border);
+    const std::span<Acc> target = std::span<Acc>(horizontal).subspan(i * count, count);
+    if (row == nullptr) {
+      std::ranges::fill(target, Acc{0});
+      continue;
+    }
+    LoadPadded(row, plane, static_cast<std::ptrdiff_t>(s0) - static_cast<std::ptrdiff_t>(radius_x * plane.step), border,
+               padded);
+    HorizontalPass<Acc>(padded, plane.step, kernel.horizontal, target, simd);
+  }
+  std::vector<const Acc *> taps(kernel.vertical.size());
+  for (std::size_t y = y0; y < y1; y++) {
+    for (std::size_t k = 0; k < taps.size(); k++) {
+      taps[k] = horizontal.data() + ((y - y0 + k) * count);
+    }
+    VerticalPass<Acc>(taps, kernel.vertical, kernel.shift, std::span<std::uint8_t>(out + ((y - y0) * stride), count),
+                      simd);
+  }
+}
+
+/// One row of Sobel magnitudes from the padded rows above, at and below it (each one sample of
+/// the step longer on both sides).
+void SobelRow(std::array<const std::uint8_t *, 3> rows, std::size_t step, std::span<std::uint8_t> out, bool simd) {
+  std::size_t i = 0;
+#ifdef PPC_IMAGE_X86
+  if (simd) {
+    i = avx2::Sobel(rows, step, out.size(), out.data());
+  }
+#else
+  (void)simd;
+#endif
+  const auto [above, centre, below] = rows;
+  for (; i < out.size(); i++) {
+    const std::size_t left = i;
+    const std::size_t middle = i + step;
+    const std::size_t right = i + (2 * step);
+    const int gx =
+        (above[right] + (2 * centre[right]) + below[right]) - (above[left] + (2 * centre[left]) + below[left]);
+    const int gy =
+        (below[left] + (2 * below[middle]) + below[right]) - (above[left] + (2 * above[middle]) + above[right]);
+    out[i] = static_cast<std::uint8_t>(std::min(std::abs(gx) + std::abs(gy), 255));
+  }
+}
+
+/// Sobel of rows [y0, y1) x samples [s0, s1) of @p plane, written as ConvolveTile() does.
+void SobelTile(const Plane &plane, Border border, std::pair<std::size_t, std::size_t> rows,
+               std::pair<std::size_t, std::size_t> samples, std::uint8_t *out, std::size_t stride, bool simd) {
+  const auto [y0, y1] = rows;
+  const auto [s0, s1] = samples;
+  const std::size_t count = s1 - s0;
+  const std::size_t width = count + (2 * plane.step);
+  const auto begin = static_cast<std::ptrdiff_t>(s0) - static_cast<std::ptrdiff_t>(plane.step);
+  // A ring of three padded rows, row y - 1 in slot y % 3: each source row is loaded once per tile.
+  std::vector<std::uint8_t> ring(3 * width);
+  const auto slot = [&](std::size_t shifted) {
+    return std::span<std::uint8_t>(ring).subspan((shifted % 3) * width, width);
+  };
+  const auto load = [&](std::size_t shifted) {
+    LoadPadded(plane.Row(static_cast<std::ptrdiff_t>(shifted) - 1, border), plane, begin, border, slot(shifted));
+  };
+  load(y0);
+  load(y0 + 1);
+  for (std::size_t y = y0; y < y1; y++) {
+    load(y + 2);
+    SobelRow({slot(y).data(), slot(y + 1).data(), slot(y + 2).data()}, plane.step,
+             std::span<std::uint8_t>(out + ((y - y0) * stride), count), simd);
+  }
+}
+
+/// Sobel of the Gaussian blur of full rows [y0, y1): the band is blurred with a row of halo on
+/// each side, taken at the border-mapped row as a separate blur pass would have it.
+void GaussianSobelBand(const Plane &plane, Border border, std::pair<std::size_t, std::size_t> rows,
+                       std::uint8_t *out, bool simd) {
+  const auto [y0, y1] = rows;
+  const Kernel gaussian = GaussianKernel();
+  const std::size_t samples = plane.samples;
+  const std::size_t band = y1 - y0 + 2;
+  std::vector<std::uint8_t> blurred(band * samples);
+  std::vector<bool> zero(band, false);
+  const auto blur = [&](std::size_t first, std::size_t last, std::size_t slot) {
+    ConvolveTile<std::int16_t>(plane, gaussian, border, {first, last}, {0, samples}, blurred.data() + (slot * samples),
+                               samples, simd);
+  };
+  blur(y0, y1, 1);
+  for (const std::size_t slot : {std::size_t{0}, band - 1}) {
+    const std::ptrdiff_t halo = slot == 0 ? static_cast<std::ptrdiff_t>(y0) - 1 : static_cast<std::ptrdiff_t>(y1);
+    const std::ptrdiff_t mapped = BorderIndex(halo, plane.rows, border);
+    if (mapped < 0) {
+      zero[slot] = true;
+    } else {
+      blur(static_cast<std::size_t>(mapped), static_cast<std::size_t>(mapped) + 1, slot);
+    }
+  }
+  const Plane smooth{.data = blurred.data(), .rows = band, .samples = samples, .step = plane.step};
+  const std::size_t width = samples + (2 * plane.step);
+  std::vector<std::uint8_t> padded(band * width);
+  for (std::size_t slot = 0; slot < band; slot++) {
+    LoadPadded(zero[slot] ? nullptr : blurred.data() + (slot * samples), smooth,
+               -static_cast<std::ptrdiff_t>(plane.step), border,
+               std::span<std::uint8_t>(padded).subspan(slot * width, width));
+  }
+  for (std::size_t y = y0; y < y1; y++) {
+    const std::size_t slot = y - y0;
+    SobelRow({&padded[slot * width], &padded[(slot + 1) * width], &padded[(slot + 2) * width]}, plane.step,
+             std::span<std::uint8_t>(out + (y * samples), samples), simd);
+  }
+}
+
+struct Tile {
+  std::size_t plane;
+  std::pair<std::size_t, std::size_t> rows;
+  std::pair<std::size_t, std::size_t> samples;
+};
+
+/// Tiles of Tuning::tile_rows rows by Tuning::tile_samples samples (whole rows when @p full_rows).
+std::vector<Tile> TilesOf(std::size_t planes, const Plane &plane, bool full_rows) {
+  const std::size_t tile_rows = std::max<std::size_t>(GetTuning().tile_rows, 1);
+  const std::size_t tile_samples = full_rows ? plane.samples : std::max<std::size_t>(GetTuning().tile_samples, 1);
+  std::vector<Tile> tiles;
+  for (std::size_t index = 0; index < planes; index++) {
+    for (std::size_t y = 0; y < plane.rows; y += tile_rows) {
+      for (std::size_t s = 0; s < plane.samples; s += tile_samples) {
+        tiles.push_back({.plane = index,
+                         .rows = {y, std::min(y + tile_rows, plane.rows)},
+                         .samples = {s, std::min(s + tile_samples, plane.samples)}});
+      }
+    }
+  }
+  return tiles;
+}
+
+void CheckImage(const Image &image, const std::string &where) {
+  if (!IsValid(image)) {
+    throw std::invalid_argument(where + ": invalid image");
+  }
+}
+
+/// Runs @p body on every tile of every plane of @p image, writing to a new image of its shape.
+template <typename Body>
+Image ForEachTile(const Image &image, bool full_rows, Backend backend, const Body &body) {
+  Image output = MakeImage(image.width, image.height, image.channels, image.layout);
+  if (image.pixels.empty()) {
+    return output;
+  }
+  const std::vector<std::pair<Plane, std::uint8_t *>> planes = PlanesOf(image, output);
+  const std::vector<Tile> tiles = TilesOf(planes.size(), planes[0].first, full_rows);
+  ppc::shared_memory::ParallelFor(tiles.size(), backend, [&](std::size_t index) {
+    const Tile &tile = tiles[index];
+    const auto &[plane, out] = planes[tile.plane];
+    body(plane, tile, out + (tile.rows.first * plane.samples) + tile.samples.first);
+  });
+  return output;
+}
+
+struct Grid {
+  int rows;
+  int cols;
+};
+
+Grid GridOf(Partition partition, int size) {
+  switch (partition) {
+    case Partition::kRows:
+      return {.rows = size, .cols = 1};
+    case Partition::kColumns:
+      return {.rows = 1, .cols = size};
+    case Partition::kBlocks: {
+      int cols = 1;
+      for (int d = 1; d * d <= size; d++) {
+        if (size % d == 0) {
+          cols = d;
+        }
+      }
+      return {.rows = size / cols, .cols = cols};
+    }
+  }
+  return {.rows = size, .cols = 1};
+}
+
+/// Sends the @p send window of @p extended to rank @p to and receives the @p receive window from
+/// rank @p from (either may be MPI_PROC_NULL).
+void ExchangeWindow(Image &extended, const Block &send, const Block &receive, int to, int from, MPI_Comm comm) {
+  const Image outgoing = Crop(extended, send.x0, send.y0, send.width, send.height);
+  Image incoming = MakeImage(receive.width, receive.height, extended.channels, extended.layout);
+  MPI_Sendrecv(outgoing.pixels.data(), static_cast<int>(outgoing.pixels.size()), MPI_BYTE, to, 0,
+               incoming.pixels.data(), static_cast<int>(incoming.pixels.size()), MPI_BYTE, from, 0, comm,
+               MPI_STATUS_IGNORE);
+  if (from != MPI_PROC_NULL) {
+    Paste(extended, incoming, receive.x0, receive.y0);
+  }
+}
+
+/// @p local extended by one sample on every side: rows of the grid neighbours above and below
+/// first, then columns of the extended rows from the left and right, which brings the corners.
+/// Beyond the image the border fills them locally, or the opposite rank sends them for kWrap.
+Image Extend(const Image &local, const Block &block, std::size_t width, std::size_t height, const Grid &grid,
+             int rank, Border border, MPI_Comm comm) {
+  const std::size_t w = local.width;
+  const std::size_t h = local.height;
+  Image extended = MakeImage(w + 2, h + 2, local.channels, local.layout);
+  Paste(extended, local, 1, 1);
+  const int row = rank / grid.cols;
+  const int col = rank % grid.cols;
+  const bool periodic = border == Border::kWrap;
+  const auto neighbour = [&](int r, int c) {
+    if (!periodic && (r < 0 || r >= grid.rows || c < 0 || c >= grid.cols)) {
+      return MPI_PROC_NULL;
+    }
+    return (((r + grid.rows) % grid.rows) * grid.cols) + ((c + grid.cols) % grid.cols);
+  };
+  const int up = neighbour(row - 1, col);
+  const int down = neighbour(row + 1, col);
+  ExchangeWindow(extended, {.x0 = 1, .y0 = 1, .width = w, .height = 1}, {.x0 = 1, .y0 = h + 1, .width = w, .height = 1},
+                 up, down, comm);
+  ExchangeWindow(extended, {.x0 = 1, .y0 = h, .width = w, .height = 1}, {.x0 = 1, .y0 = 0, .width = w, .height = 1},
+                 down, up, comm);
+  // Rows beyond the image edge come from inside the block (clamp, mirror) or stay zero.
+  const auto fill_row = [&](std::size_t target, std::ptrdiff_t global) {
+    const std::ptrdiff_t mapped = BorderIndex(global, height, border);
+    if (mapped >= 0) {
+      Paste(extended, Crop(extended, 1, static_cast<std::size_t>(mapped) - block.y0 + 1, w, 1), 1, target);
+    }
+  };
+  if (up == MPI_PROC_NULL) {
+    fill_row(0, -1);
+  }
+  if (down == MPI_PROC_NULL) {
+    fill_row(h + 1, static_cast<std::ptrdiff_t>(height));
+  }
+  const int left = neighbour(row, col - 1);
+  const int right = neighbour(row, col + 1);
+  ExchangeWindow(extended, {.x0 = 1, .y0 = 0, .width = 1, .height = h + 2},
+                 {.x0 = w + 1, .y0 = 0, .width = 1, .height = h + 2}, left, right, comm);
+  ExchangeWindow(extended, {.x0 = w, .y0 = 0, .width = 1, .height = h + 2},
+                 {.x0 = 0, .y0 = 0, .width = 1, .height = h + 2}, right, left, comm);
+  const auto fill_col = [&](std::size_t target, std::ptrdiff_t global) {
+    const std::ptrdiff_t mapped = BorderIndex(global, width, border);
+    if (mapped >= 0) {
+      Paste(extended, Crop(extended, static_cast<std::size_t>(mapped) - block.x0 + 1, 0, 1, h + 2), target, 0);
+    }
+  };
+  if (left == MPI_PROC_NULL) {
+    fill_col(0, -1);
+  }
+  if (right == MPI_PROC_NULL) {
+    fill_col(w + 1, static_cast<std::ptrdiff_t>(width));
+  }
+  return extended;
+}
+
+}  // namespace
+
+std::string BorderToString(Border border) {
+  switch (border) {
+    case Border::kClamp:
+      return "clamp";
+    case Border::kMirror:
+      return "mirror";
+    case Border::kWrap:
+      return "wrap";
+    case Border::kZero:
+      return "zero";
+  }
+  return "unknown";
+}
+
+std::ptrdiff_t BorderIndex(std::ptrdiff_t index, std::size_t size, Border border) {
+  const auto n = static_cast<std::ptrdiff_t>(size);
+  if (index >= 0 && index < n) {
+    return index;
+  }
+  switch (border) {
+    case Border::kClamp:
+      return std::clamp<std::ptrdiff_t>(index, 0, n - 1);
+    case Border::kMirror: {
+      if (n == 1) {
+        return 0;
+      }
+      const std::ptrdiff_t period = 2 * (n - 1);
+      std::ptrdiff_t folded = ((index % period) + period) % period;
+      return folded < n ? folded : period - folded;
+    }
+    case Border::kWrap:
+      return ((index % n) + n) % n;
+    case Border::kZero:
+      return -1;
+  }
+  return -1;
+}
+
+std::string OperationToString(Operation operation) {
+  switch (operation) {
+    case Operation::kGaussian:
+      return "gaussian";
+    case Operation::kSobel:
+      return "sobel";
+    case Operation::kGaussianSobel:
+      return "gaussian_sobel";
+  }
+  return "unknown";
+}
+
+Kernel GaussianKernel() {
+  return {.horizontal = {1, 2, 1}, .vertical = {1, 2, 1}, .shift = 4};
+}
+
+Tuning &GetTuning() {
+  static Tuning tuning;
+  return tuning;
+}
+
+Image Convolve(const Image &image, const Kernel &kernel, const Options &options) {
+  CheckImage(image, "Convolve");
+  CheckKernel(kernel);
+  const bool narrow = Fits16(kernel);
+  const bool simd = narrow && UseSimd();
+  return ForEachTile(image, false, options.backend, [&](const Plane &plane, const Tile &tile, std::uint8_t *out) {
+    if (narrow) {
+      ConvolveTile<std::int16_t>(plane, kernel, options.border, tile.rows, tile.samples, out, plane.samples, simd);
+    } else {
+      ConvolveTile<std::int32_t>(plane, kernel, options.border, tile.rows, tile.samples, out, plane.samples, false);
+    }
+  });
+}
+
+Image Apply(const Image &image, Operation operation, const Options &options) {
+  CheckImage(image, "Apply");
+  const bool simd = UseSimd();
+  switch (operation) {
+    case Operation::kGaussian:
+      return Convolve(image, GaussianKernel(), options);
+    case Operation::kSobel:
+      return ForEachTile(image, false, options.backend, [&](const Plane &plane, const Tile &tile, std::uint8_t *out) {
+        SobelTile(plane, options.border, tile.rows, tile.samples, out, plane.samples, simd);
+      });
+    case Operation::kGaussianSobel:
+      return ForEachTile(image, true, options.backend, [&](const Plane &plane, const Tile &tile, std::uint8_t *out) {
+        // The band writes whole rows from its first one on.
+        GaussianSobelBand(plane, options.border, tile.rows, out - (tile.rows.first * plane.samples), simd);
+      });
+  }
+  return image;
+}
+
+std::string PartitionToString(Partition partition) {
+  switch (partition) {
+    case Partition::kRows:
+      return "rows";
+    case Partition::kColumns:
+      return "columns";
+    case Partition::kBlocks:
+      return "blocks";
+  }
+  return "unknown";
+}
+
+Block PartitionBlock(std::size_t width, std::size_t height, Partition partition, int size, int rank) {
+  const Grid grid = GridOf(partition, size);
+  const auto [y0, y1] = ppc::shared_memory::BlockRange(height, grid.rows, rank / grid.cols);
+  const auto [x0, x1] = ppc::shared_memory::BlockRange(width, grid.cols, rank % grid.cols);
+  return {.x0 = x0, .y0 = y0, .width = x1 - x0, .height = y1 - y0};
+}
+
+Image DistributedApply(const Image &local, std::size_t width, std::size_t height, Operation operation,
+                       Partition partition, const Options &options, MPI_Comm comm) {
+  int rank = 0;
+  int size = 1;
+  MPI_Comm_rank(comm, &rank);
+  MPI_Comm_size(comm, &size);
+  const Block block = PartitionBlock(width, height, partition, size, rank);
+  int valid = IsValid(local) && local.width == block.width && local.height == block.height ? 1 : 0;
+  MPI_Allreduce(MPI_IN_PLACE, &valid, 1, MPI_INT, MPI_MIN, comm);
+  if (valid == 0) {
+    throw std::invalid_argument("DistributedApply: a block does not match its partition");
+  }
+  for (int r = 0; r < size; r++) {
+    const Block other = PartitionBlock(width, height, partition, size, r);
+    if (other.width < 2 || other.height < 2) {
+      throw std::invalid_argument("DistributedApply: a block is thinner than two samples");
+    }
+  }
+  const Grid grid = GridOf(partition, size);
+  std::vector<Operation> passes = {operation};
+  if (operation == Operation::kGaussianSobel) {
+    passes = {Operation::kGaussian, Operation::kSobel};
+  }
+  Image current = local;
+  for (const Operation pass : passes) {
+    const Image extended = Extend(current, block, width, height, grid, rank, options.border, comm);
+    current = Crop(Apply(extended, pass, options), 1, 1, block.width, block.height);
+  }
+  return current;
+}
+
+Image AllGatherImage(const Image &local, std::size_t width, std::size_t height, Partition partition, MPI_Comm comm) {
+  int size = 1;
+  MPI_Comm_size(comm, &size);
+  std::vector<int> counts(static_cast<std::size_t>(size));
+  std::vector<int> displs(static_cast<std::size_t>(size));
+  int total = 0;
+  for (int r = 0; r < size; r++) {
+    const Block block = PartitionBlock(width, height, partition, size, r);
+    counts[static_cast<std::size_t>(r)] = static_cast<int>(block.width * block.height * local.channels);
+    displs[static_cast<std::size_t>(r)] = total;
+    total += counts[static_cast<std::size_t>(r)];
+  }
+  std::vector<std::uint8_t> blocks(static_cast<std::size_t>(total));
+  MPI_Allgatherv(local.pixels.data(), static_cast<int>(local.pixels.size()), MPI_BYTE, blocks.data(), counts.data(),
+                 displs.data(), MPI_BYTE, comm);
+  Image image = MakeImage(width, height, local.channels, local.layout);
+  for (int r = 0; r < size; r++) {
+    const Block block = PartitionBlock(width, height, partition, size, r);
+    const auto begin = blocks.begin() + displs[static_cast<std::size_t>(r)];
+    const Image piece{.width = block.width,
+                      .height = block.height,
+                      .channels = local.channels,
+                      .layout = local.layout,
+                      .pixels = std::vector<std::uint8_t>(begin, begin + counts[static_cast<std::size_t>(r)])};
+    Paste(image, piece, block.x0, block.y0);
+  }
+  return image;
+}
+
+}  // namespace ppc::image
@@ -0,0 +1,141 @@
+#include "image/include/image.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace ppc::image {
+
+namespace {
+
+/// Copies the target-sized window of @p source at (@p sx, @p sy), or all of it, into @p target at
+/// (@p tx, @p ty): whole rows of a plane or of the interleaved samples when the layouts agree.
+void CopyWindow(Image &target, const Image &source, std::size_t tx, std::size_t ty, std::size_t sx, std::size_t sy) {
+  const std::size_t width = std::min(source.width - sx, target.width - tx);
+  const std::size_t height = std::min(source.height - sy, target.height - ty);
+  if (target.layout == source.layout) {
+    const std::size_t planes = source.layout == Layout::kPlanar ? source.channels : 1;
+    const std::size_t run = source.layout == Layout::kPlanar ? width : width * source.channels;
+    for (std::size_t plane = 0; plane < planes; plane++) {
+      for (std::size_t y = 0; y < height; y++) {
+        std::copy_n(source.pixels.begin() + static_cast<std::ptrdiff_t>(source.Index(sx, sy + y, plane)), run,
+                    target.pixels.begin() + static_cast<std::ptrdiff_t>(target.Index(tx, ty + y, plane)));
+      }
+    }
+    return;
+  }
+  for (std::size_t channel = 0; channel < source.channels; channel++) {
+    for (std::size_t y = 0; y < height; y++) {
+      for (std::size_t x = 0; x < width; x++) {
+        target.At(tx + x, ty + y, channel) = source.At(sx + x, sy + y, channel);
+      }
+    }
+  }
+}
+
+}  // namespace
+
+std::string LayoutToString(Layout layout) {
+  switch (layout) {
+    case Layout::kInterleaved:
+      return "interleaved";
+    case Layout::kPlanar:
+      return "planar";
+  }
+  return "unknown";
+}
+
+Image MakeImage(std::size_t width, std::size_t height, std::size_t channels, Layout layout) {
+  return {.width = width,
+          .height = height,
+          .channels = channels,
+          .layout = layout,
+          .pixels = std::vector<std::uint8_t>(width * height * channels, 0)};
+}
+
+bool IsValid(const Image &image) {
+  return image.channels > 0 && image.pixels.size() == image.width * image.height * image.channels;
+}
+
+Image FromInterleaved(std::span<const std::uint8_t> bytes, std::size_t width, std::size_t height,
+                      std::size_t channels, Layout layout) {
+  if (channels == 0 || bytes.size() != width * height * channels) {
+    throw std::invalid_argument("FromInterleaved: buffer does not match the image size");
+  }
+  Image image{.width = width,
+              .height = height,
+              .channels = channels,
+              .layout = Layout::kInterleaved,
+              .pixels = std::vector<std::uint8_t>(bytes.begin(), bytes.end())};
+  return ToLayout(image, layout);
+}
+
+Image ToLayout(const Image &image, Layout layout) {
+  if (image.layout == layout) {
+    return image;
+  }
+  Image result = MakeImage(image.width, image.height, image.channels, layout);
+  Paste(result, image, 0, 0);
+  return result;
+}
+
+Image Crop(const Image &image, std::size_t x0, std::size_t y0, std::size_t width, std::size_t height) {
+  if (x0 + width > image.width || y0 + height > image.height) {
+    throw std::invalid_argument("Crop: window does not fit the image");
+  }
+  Image result = MakeImage(width, height, image.channels, image.layout);
+  CopyWindow(result, image, 0, 0, x0, y0);
+  return result;
+}
+
+void Paste(Image &target, const Image &source, std::size_t x0, std::size_t y0) {
+  if (target.channels != source.channels || x0 + source.width > target.width || y0 + source.height > target.height) {
+    throw std::invalid_argument("Paste: source does not fit the target");
+  }
+  CopyWindow(target, source, x0, y0, 0, 0);
+}
+
+Image TestPattern(std::size_t width, std::size_t height, std::size_t channels, Layout layout, std::uint64_t seed) {
+  std::mt19937_64 gen(seed);
+  std::uniform_int_distribution<int> noise(-24, 24);
+  struct Disc {
+    double x;
+    double y;
+    double radius;
+    int value;
+  };
+  std::vector<Disc> discs(6);
+  std::uniform_real_distribution<double> unit(0.0, 1.0);
+  for (Disc &disc : discs) {
+    disc = {.x = unit(gen) * static_cast<double>(width),
+            .y = unit(gen) * static_cast<double>(height),
+            .radius = (0.05 + (0.15 * unit(gen))) * static_cast<double>(std::min(width, height)),
+            .value = static_cast<int>(gen() % 256)};
+  }
+  Image image = MakeImage(width, height, channels, layout);
+  for (std::size_t y = 0; y < height; y++) {
+    for (std::size_t x = 0; x < width; x++) {
+      for (std::size_t channel = 0; channel < channels; channel++) {
+        const std::size_t ramp = channel % 2 == 0 ? x : y;
+        const std::size_t extent = channel % 2 == 0 ? width : height;
+        int value = static_cast<int>((255 * ramp) / std::max<std::size_t>(extent, 1));
+        for (const Disc &disc : discs) {
+          const double dx = static_cast<double>(x) - disc.x;
+          const double dy = static_cast<double>(y) - disc.y;
+          if ((dx * dx) + (dy * dy) < disc.radius * disc.radius) {
+            value = (disc.value + static_cast<int>(channel * 85)) % 256;
+          }
+        }
+        image.At(x, y, channel) = static_cast<std::uint8_t>(std::clamp(value + noise(gen), 0, 255));
+      }
+    }
+  }
+  return image;
+}
+
+}  // namespace ppc::image
@@ -0,0 +1,300 @@
+#include <gtest/gtest.h>
+#include <mpi.h>
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "image/include/filter.hpp"
+#include "image/include/filter_task.hpp"
+#include "image/include/image.hpp"
+#include "reduction/include/reduction.hpp"
+#include "shared_memory/include/parallel_for.hpp"
+#include "task/include/task.hpp"
+#include "util/include/func_test_util.hpp"
+
+using ppc::image::Backend;
+using ppc::image::Border;
+using ppc::image::Image;
+using ppc::image::Kernel;
+using ppc::image::Layout;
+using ppc::image::Operation;
+using ppc::image::Partition;
+using ppc::task::TypeOfTask;
+
+namespace {
+
+constexpr std::array<Backend, 4> kAllBackends = {Backend::kSeq, Backend::kOmp, Backend::kTbb, Backend::kStl};
+constexpr std::array<Border, 4> kAllBorders = {Border::kClamp, Border::kMirror, Border::kWrap, Border::kZero};
+constexpr std::array<Layout, 2> kAllLayouts = {Layout::kInterleaved, Layout::kPlanar};
+constexpr std::array<Partition, 3> kAllPartitions = {Partition::kRows, Partition::kColumns, Partition::kBlocks};
+
+/// Small tiles, so that the test images split into many with partial SIMD chunks, for the
+/// scalar kernels and for the best instruction set in turn.
+class SmallTiles {
+ public:
+  SmallTiles() : saved_(ppc::image::GetTuning()), isa_(ppc::reduction::GetTuning().isa) {
+    ppc::image::GetTuning().tile_rows = 5;
+    ppc::image::GetTuning().tile_samples = 40;
+  }
+  ~SmallTiles() {
+    ppc::image::GetTuning() = saved_;
+    ppc::reduction::GetTuning().isa = isa_;
+  }
+  SmallTiles(const SmallTiles &) = delete;
+  SmallTiles &operator=(const SmallTiles &) = delete;
+
+  [[nodiscard]] std::array<ppc::reduction::Isa, 2> Isas() const {
+    return {ppc::reduction::Isa::kScalar, isa_};
+  }
+
+ private:
+  ppc::image::Tuning saved_;
+  ppc::reduction::Isa isa_;
+};
+
+int Sample(const Image &image, std::ptrdiff_t x, std::ptrdiff_t y, std::size_t channel, Border border) {
+  const std::ptrdiff_t mx = ppc::image::BorderIndex(x, image.width, border);
+  const std::ptrdiff_t my = ppc::image::BorderIndex(y, image.height, border);
+  if (mx < 0 || my < 0) {
+    return 0;
+  }
+  return image.At(static_cast<std::size_t>(mx), static_cast<std::size_t>(my), channel);
+}
+
+/// Direct two-dimensional sum of every output sample.
+Image ReferenceConvolve(const Image &image, const Kernel &kernel, Border border) {
+  Image out = ppc::image::MakeImage(image.width, image.height, image.channels, image.layout);
+  const auto rx = static_cast<std::ptrdiff_t>(kernel.horizontal.size() / 2);
+  const auto ry = static_cast<std::ptrdiff_t>(kernel.vertical.size() / 2);
+  for (std::size_t c = 0; c < image.channels; c++) {
+    for (std::size_t y = 0; y < image.height; y++) {
+      for (std::size_t x = 0; x < image.width; x++) {
+        int sum = kernel.shift > 0 ? 1 << (kernel.shift - 1) : 0;
+        for (std::ptrdiff_t j = -ry; j <= ry; j++) {
+          for (std::ptrdiff_t i = -rx; i <= rx; i++) {
+            const int weight =
+                kernel.vertical[static_cast<std::size_t>(j + ry)] * kernel.horizontal[static_cast<std::size_t>(i + rx)];
+            const std::ptrdiff_t sx = static_cast<std::ptrdiff_t>(x) + i;
+            const std::ptrdiff_t sy = static_cast<std::ptrdiff_t>(y) + j;
+            sum += weight * Sample(image, sx, sy, c, border);
+          }
+        }
+        out.At(x, y, c) = static_cast<std::uint8_t>(std::clamp(sum >> kernel.shift, 0, 255));
+      }
+    }
+  }
+  return out;
+}
+
+Image ReferenceSobel(const Image &image, Border border) {
+  constexpr std::array<std::array<int, 3>, 3> kGx = {{{-1, 0, 1}, {-2, 0, 2}, {-1, 0, 1}}};
+  constexpr std::array<std::array<int, 3>, 3> kGy = {{{-1, -2, -1}, {0, 0, 0}, {1, 2, 1}}};
+  Image out = ppc::image::MakeImage(image.width, image.height, image.channels, image.layout);
+  for (std::size_t c = 0; c < image.channels; c++) {
+    for (std::size_t y = 0; y < image.height; y++) {
+      for (std::size_t x = 0; x < image.width; x++) {
+        int gx = 0;
+        int gy = 0;
+        for (std::size_t j = 0; j < 3; j++) {
+          for (std::size_t i = 0; i < 3; i++) {
+            const int s = Sample(image, static_cast<std::ptrdiff_t>(x + i) - 1, static_cast<std::ptrdiff_t>(y + j) - 1,
+                                 c, border);
+            gx += kGx[j][i] * s;
+            gy += kGy[j][i] * s;
+          }
+        }
+        out.At(x, y, c) = static_cast<std::uint8_t>(std::min(std::abs(gx) + std::abs(gy), 255));
+      }
+    }
+  }
+  return out;
+}
+
+/// Test images of one and three channels in both layouts, with odd sizes.
+std::vector<Image> TestImages() {
+  std::vector<Image> images;
+  for (const Layout layout : kAllLayouts) {
+    images.push_back(ppc::image::TestPattern(37, 23, 1, layout, 1));
+    images.push_back(ppc::image::TestPattern(29, 17, 3, layout, 2));
+  }
+  images.push_back(ppc::image::TestPattern(1, 9, 3, Layout::kInterleaved, 3));
+  return images;
+}
+
+std::string Describe(const Image &image, Border border, Backend backend) {
+  return std::to_string(image.width) + "x" + std::to_string(image.height) + "x" + std::to_string(image.channels) +
+         " " + ppc::image::LayoutToString(image.layout) + " " + ppc::image::BorderToString(border) + " " +
+         ppc::shared_memory::BackendToString(backend) + " " +
+         ppc::reduction::IsaToString(ppc::reduction::GetTuning().isa);
+}
+
+}  // namespace
+
+TEST(Image, LayoutsAndBordersIndexTheSameSamples) {
+  const Image image = ppc::image::TestPattern(13, 7, 3, Layout::kInterleaved, 4);
+  const Image planar = ppc::image::ToLayout(image, Layout::kPlanar);
+  EXPECT_EQ(planar.At(5, 6, 2), image.At(5, 6, 2));
+  EXPECT_EQ(planar.pixels[(2 * 13 * 7) + (6 * 13) + 5], image.pixels[(((6 * 13) + 5) * 3) + 2]);
+  EXPECT_EQ(ppc::image::ToLayout(planar, Layout::kInterleaved), image);
+  EXPECT_EQ(ppc::image::FromInterleaved(image.pixels, 13, 7, 3, Layout::kPlanar), planar);
+  EXPECT_THROW((void)ppc::image::FromInterleaved(image.pixels, 13, 7, 2), std::invalid_argument);
+
+  Image pasted = ppc::image::MakeImage(13, 7, 3, Layout::kPlanar);
+  ppc::image::Paste(pasted, ppc::image::Crop(image, 0, 0, 6, 7), 0, 0);
+  ppc::image::Paste(pasted, ppc::image::Crop(image, 6, 0, 7, 7), 6, 0);
+  EXPECT_EQ(pasted, planar);
+  EXPECT_THROW((void)ppc::image::Crop(image, 8, 0, 6, 7), std::invalid_argument);
+
+  const std::array<std::ptrdiff_t, 8> indices = {-3, -2, -1, 0, 3, 4, 5, 6};
+  const std::array<std::array<std::ptrdiff_t, 8>, 4> expected = {{{0, 0, 0, 0, 3, 3, 3, 3},
+                                                                  {3, 2, 1, 0, 3, 2, 1, 0},
+                                                                  {1, 2, 3, 0, 3, 0, 1, 2},
+                                                                  {-1, -1, -1, 0, 3, -1, -1, -1}}};
+  for (std::size_t b = 0; b < kAllBorders.size(); b++) {
+    for (std::size_t i = 0; i < indices.size(); i++) {
+      EXPECT_EQ(ppc::image::BorderIndex(indices[i], 4, kAllBorders[b]), expected[b][i])
+          << ppc::image::BorderToString(kAllBorders[b]) << " " << indices[i];
+    }
+  }
+}
+
+TEST(Image, ConvolutionMatchesTheDirectSum) {
+  const SmallTiles small_tiles;
+  // 16-bit lanes with rounding; 32-bit sums; negative sums saturated to zero.
+  const std::array<Kernel, 3> kernels = {ppc::image::GaussianKernel(),
+                                         Kernel{.horizontal = {1, 4, 6, 4, 1}, .vertical = {1, 4, 6, 4, 1}, .shift = 8},
+                                         Kernel{.horizontal = {-1, 0, 1}, .vertical = {1, 2, 1}, .shift = 0}};
+  for (const Image &image : TestImages()) {
+    for (const Border border : kAllBorders) {
+      for (const Kernel &kernel : kernels) {
+        const Image expected = ReferenceConvolve(image, kernel, border);
+        for (const ppc::reduction::Isa isa : small_tiles.Isas()) {
+          ppc::reduction::GetTuning().isa = isa;
+          for (const Backend backend : kAllBackends) {
+            ASSERT_EQ(ppc::image::Convolve(image, kernel, {.border = border, .backend = backend}), expected)
+                << Describe(image, border, backend) << " taps " << kernel.horizontal.size();
+          }
+        }
+      }
+    }
+  }
+}
+
+TEST(Image, SobelMatchesTheDirectGradient) {
+  const SmallTiles small_tiles;
+  for (const Image &image : TestImages()) {
+    for (const Border border : kAllBorders) {
+      const Image expected = ReferenceSobel(image, border);
+      for (const ppc::reduction::Isa isa : small_tiles.Isas()) {
+        ppc::reduction::GetTuning().isa = isa;
+        for (const Backend backend : kAllBackends) {
+          ASSERT_EQ(ppc::image::Apply(image, Operation::kSobel, {.border = border, .backend = backend}), expected)
+              << Describe(image, border, backend);
+        }
+      }
+    }
+  }
+}
+
+TEST(Image, FusedGaussianSobelMatchesTwoPasses) {
+  const SmallTiles small_tiles;
+  for (const Image &image : TestImages()) {
+    for (const Border border : kAllBorders) {
+      const Image blurred = ReferenceConvolve(image, ppc::image::GaussianKernel(), border);
+      const Image expected = ReferenceSobel(blurred, border);
+      for (const ppc::reduction::Isa isa : small_tiles.Isas()) {
+        ppc::reduction::GetTuning().isa = isa;
+        for (const Backend backend : kAllBackends) {
+          const ppc::image::Options options{.border = border, .backend = backend};
+          ASSERT_EQ(ppc::image::Apply(image, Operation::kGaussian, options), blurred)
+              << Describe(image, border, backend);
+          ASSERT_EQ(ppc::image::Apply(image, Operation::kGaussianSobel, options), expected)
+              << Describe(image, border, backend);
+        }
+      }
+    }
+  }
+}
+
+TEST(Image, InvalidKernelsAndImagesAreRejected) {
+  const Image image = ppc::image::TestPattern(8, 8, 1, Layout::kInterleaved, 5);
+  EXPECT_THROW((void)ppc::image::Convolve(image, {.horizontal = {1, 1}, .vertical = {1}, .shift = 1}),
+               std::invalid_argument);
+  EXPECT_THROW((void)ppc::image::Convolve(image, {.horizontal = {1}, .vertical = {1}, .shift = 25}),
+               std::invalid_argument);
+  EXPECT_THROW(
+      (void)ppc::image::Convolve(image, {.horizontal = {1 << 12, 1, 1 << 12}, .vertical = {1 << 12}, .shift = 0}),
+      std::invalid_argument);
+  Image broken = image;
+  broken.pixels.pop_back();
+  EXPECT_THROW((void)ppc::image::Apply(broken, Operation::kSobel), std::invalid_argument);
+  EXPECT_EQ(ppc::image::Apply(ppc::image::MakeImage(0, 0, 3), Operation::kGaussianSobel).pixels.size(), 0U);
+}
+
+TEST(Image, DistributedFiltersMatchSharedMemory) {
+  if (!ppc::util::MpiReady()) {
+    GTEST_SKIP() << "MPI is not initialized";
+  }
+  int rank = 0;
+  int size = 1;
+  MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+  MPI_Comm_size(MPI_COMM_WORLD, &size);
+  for (const Layout layout : kAllLayouts) {
+    const Image image = ppc::image::TestPattern(41, 29, 3, layout, 6);
+    for (const Partition partition : kAllPartitions) {
+      const ppc::image::Block block = ppc::image::PartitionBlock(41, 29, partition, size, rank);
+      const Image local = ppc::image::Crop(image, block.x0, block.y0, block.width, block.height);
+      for (const Border border : kAllBorders) {
+        for (const Operation operation : {Operation::kGaussian, Operation::kSobel, Operation::kGaussianSobel}) {
+          const ppc::image::Options options{.border = border};
+          const Image result =
+              ppc::image::DistributedApply(local, 41, 29, operation, partition, options, MPI_COMM_WORLD);
+          ASSERT_EQ(ppc::image::AllGatherImage(result, 41, 29, partition, MPI_COMM_WORLD),
+                    ppc::image::Apply(image, operation, options))
+              << ppc::image::PartitionToString(partition) << " " << ppc::image::BorderToString(border) << " "
+              << ppc::image::OperationToString(operation) << " " << ppc::image::LayoutToString(layout);
+        }
+      }
+    }
+  }
+  if (size > 1) {
+    const Image narrow = ppc::image::TestPattern(size, 8, 1, Layout::kInterleaved, 7);
+    const ppc::image::Block block = ppc::image::PartitionBlock(size, 8, Partition::kColumns, size, rank);
+    EXPECT_THROW((void)ppc::image::DistributedApply(ppc::image::Crop(narrow, block.x0, 0, block.width, 8), size, 8,
+                                                    Operation::kSobel, Partition::kColumns, {}, MPI_COMM_WORLD),
+                 std::invalid_argument);
+  }
+}
+
+namespace {
+
+template <TypeOfTask kType, Operation kOperation, Partition kPartition = Partition::kRows>
+void RunFilterTask(const Image &image) {
+  ppc::image::FilterTask<kType, kOperation, kPartition> task(image);
+  ASSERT_TRUE(task.Validation());
+  ASSERT_TRUE(task.PreProcessing());
+  ASSERT_TRUE(task.Run());
+  ASSERT_TRUE(task.PostProcessing());
+  EXPECT_EQ(task.GetOutput(), ppc::image::Apply(image, kOperation));
+}
+
+}  // namespace
+
+TEST(Image, TasksMatchTheSequentialFilterOnEveryBackend) {
+  const Image image = ppc::image::TestPattern(64, 48, 3, Layout::kInterleaved, 8);
+  RunFilterTask<TypeOfTask::kSEQ, Operation::kGaussian>(image);
+  RunFilterTask<TypeOfTask::kOMP, Operation::kSobel>(image);
+  RunFilterTask<TypeOfTask::kTBB, Operation::kGaussianSobel>(image);
+  RunFilterTask<TypeOfTask::kSTL, Operation::kGaussian>(image);
+  if (ppc::util::MpiReady()) {
+    RunFilterTask<TypeOfTask::kMPI, Operation::kGaussian, Partition::kRows>(image);
+    RunFilterTask<TypeOfTask::kMPI, Operation::kSobel, Partition::kColumns>(image);
+    RunFilterTask<TypeOfTask::kMPI, Operation::kGaussianSobel, Partition::kBlocks>(image);
+  }
+}
@@ -0,0 +1,474 @@
+#pragma once
+
+#include <mpi.h>
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+#include "integration/include/integration.hpp"
+#include "shared_memory/include/parallel_for.hpp"
+
+namespace ppc::integration {
+
+struct AdaptiveOptions {
+  /// Stop once the error estimate is at most max(abs_tolerance, rel_tolerance * |value|).
+  double abs_tolerance = 1e-10;
+  double rel_tolerance = 1e-8;
+  /// Stop after this many integrand evaluations over all ranks, converged or not.
+  std::size_t max_evaluations = std::size_t{1} << 24;
+  /// Regions bisected per step; their children are evaluated in parallel. The batch does not depend
+  /// on the worker count, so the shared-memory result is the same on every back-end.
+  std::size_t batch = 64;
+  /// Under MPI: steps between the global convergence checks, each followed by a rebalancing.
+  std::size_t sync_every = 8;
+  /// Under MPI: a rank whose error exceeds its partner's by this factor hands it regions.
+  double imbalance = 2.0;
+  /// Thread back-end of the region evaluations.
+  Backend backend = Backend::kSeq;
+};
+
+/// @brief Progress of an adaptive run at one convergence check.
+struct ErrorCheck {
+  std::size_t evaluations = 0;
+  double seconds = 0.0;
+  double error = 0.0;
+};
+
+struct AdaptiveResult {
+  double value = 0.0;
+  double error = 0.0;
+  /// Integrand evaluations over all ranks.
+  std::size_t evaluations = 0;
+  /// Regions of the final partition over all ranks.
+  std::size_t regions = 0;
+  /// Subdivision steps of this rank.
+  std::size_t steps = 0;
+  bool converged = false;
+  /// Regions this rank received from others when rebalancing.
+  std::size_t migrated = 0;
+  double seconds = 0.0;
+  /// One entry per convergence check.
+  std::vector<ErrorCheck> history;
+};
+
+/// @brief Box of the adaptive partition with the estimate of its embedded rule pair.
+template <std::size_t kDim>
+struct Region {
+  std::array<double, kDim> lower{};
+  std::array<double, kDim> upper{};
+  double value = 0.0;
+  double error = 0.0;
+  /// Axis to bisect next: the one with the largest fourth divided difference.
+  std::size_t axis = 0;
+};
+
+/// @brief Evaluation points of the rule for kDim dimensions: the 15-point Gauss-Kronrod rule in 1-D,
+/// the 1 + 4d + 2d(d - 1) + 2^d point Genz-Malik rule above.
+constexpr std::size_t RulePoints(std::size_t dim) {
+  return dim == 1 ? 15 : 1 + (4 * dim) + (2 * dim * (dim - 1)) + (std::size_t{1} << dim);
+}
+
+/// @brief Checks the options and the box of an adaptive integration.
+/// @throws std::invalid_argument When a tolerance is negative or not finite, both tolerances are
+/// zero, batch or sync_every is zero, imbalance is below 1, or a bound is not finite.
+void CheckAdaptive(const AdaptiveOptions &options, std::span<const double> lower, std::span<const double> upper);
+
+namespace detail {
+
+/// Genz-Malik degree 7 rule with its embedded degree 5 rule, for points scaled to [-1, 1]^d.
+struct GenzMalik {
+  double lambda2 = 0.0;
+  double lambda4 = 0.0;
+  double lambda5 = 0.0;
+  /// Weights of the centre, the +-lambda2 axis points, the +-lambda4 axis points, the +-lambda4
+  /// plane points and the +-lambda5 corners.
+  std::array<double, 5> degree7{};
+  std::array<double, 4> degree5{};
+};
+
+GenzMalik MakeGenzMalik(std::size_t dim);
+
+/// 15-point Kronrod nodes on [0, 1] (odd entries are the 7-point Gauss nodes, the last is the
+/// centre) with the Kronrod and Gauss weights.
+inline constexpr std::array<double, 8> kKronrodNodes = {
+    0.991455371120812639206854697526329, 0.949107912342758524526189684047851, 0.864864423359769072789712788640926,
+    0.741531185599394439863864773280788, 0.586087235467691130294144845693013, 0.405845151377397166906606412076961,
+    0.207784955007898467600689403773245, 0.0};
+inline constexpr std::array<double, 8> kKronrodWeights = {
+    0.022935322010529224963732008058970, 0.063092092629978553290700663189204, 0.104790010322250183839876322541518,
+    0.140653259715525918745189590510238, 0.169004726639267902826583426598550, 0.190350578064785409913256402421014,
+    0.204432940075298892414161999234649, 0.209482141084727828012999174891714};
+inline constexpr std::array<double, 4> kGaussWeights = {0.129484966168869693270611432679082,
+                                                        0.279705391489276667901467771423780,
+                                                        0.381830050505118944950369775488975,
+                                                        0.417959183673469387755102040816327};
+
+/// values[p] = f(x[0][p], ..., x[kDim - 1][p]) for p < count, kBatch points per integrand call.
+template <std::size_t kDim, typename F>
+void EvaluatePoints(const F &f, const std::array<std::vector<double>, kDim> &x, std::size_t count,
+                    std::vector<double> &values) {
+  values.resize(count);
+  for (std::size_t first = 0; first < count; first += kBatch) {
+    const std::size_t size = std::min(kBatch, count - first);
+    if constexpr (BatchIntegrand<F, kDim>) {
+      Batch<kDim> batch;
+      for (std::size_t d = 0; d < kDim; d++) {
+        batch.x[d] = x[d].data() + first;
+      }
+      batch.size = size;
+      f(batch, std::span<double>(values.data() + first, size));
+    } else {
+      for (std::size_t p = first; p < first + size; p++) {
+        std::array<double, kDim> point{};
+        for (std::size_t d = 0; d < kDim; d++) {
+          point[d] = x[d][p];
+        }
+        values[p] = static_cast<double>(f(point));
+      }
+    }
+  }
+}
+
+/// Gauss-Kronrod 7-15 estimate of a 1-D region; the error is |K15 - G7|.
+template <typename F>
+void EstimateGaussKronrod(const F &f, Region<1> &region) {
+  const double centre = 0.5 * (region.lower[0] + region.upper[0]);
+  const double half = 0.5 * (region.upper[0] - region.lower[0]);
+  std::array<std::vector<double>, 1> x;
+  for (std::size_t k = 0; k + 1 < kKronrodNodes.size(); k++) {
+    x[0].push_back(centre - (half * kKronrodNodes[k]));
+    x[0].push_back(centre + (half * kKronrodNodes[k]));
+  }
+  x[0].push_back(centre);
+  std::vector<double> values;
+  EvaluatePoints<1>(f, x, x[0].size(), values);
+  double kronrod = kKronrodWeights[7] * values[14];
+  double gauss = kGaussWeights[3] * values[14];
+  for (std::size_t k = 0; k < 7; k++) {
+    const double pair = values[2 * k] + values[(2 * k) + 1];
+    kronrod += kKronrodWeights[k] * pair;
+    if (k % 2 == 1) {
+      gauss += kGaussWeights[k / 2] * pair;
+    }
+  }
+  region.value = half * kronrod;
+  region.error = std::abs(half * (kronrod - gauss));
+  region.axis = 0;
+}
+
+/// Genz-Malik 7-5 estimate of a region; the error is the difference of the two degrees.
+template <std::size_t kDim, typename F>
+void EstimateGenzMalik(const F &f, const GenzMalik &rule, Region<kDim> &region) {
+  std::array<double, kDim> centre{};
+  std::array<double, kDim> half{};
+  double volume = 1.0;
+  for (std::size_t d = 0; d < kDim; d++) {
+    centre[d] = 0.5 * (region.lower[d] + region.upper[d]);
+    half[d] = 0.5 * (region.upper[d] - region.lower[d]);
+    volume *= region.upper[d] - region.lower[d];
+  }
+  std::array<std::vector<double>, kDim> x;
+  const auto add = [&](const std::array<double, kDim> &offset) {
+    for (std::size_t d = 0; d < kDim; d++) {
+      x[d].push_back(centre[d] + (offset[d] * half[d]));
+    }
+  };
+  add({});
+  for (const double lambda : {rule.lambda2, rule.lambda4}) {
+    for (std::size_t i = 0; i < kDim; i++) {
+      for (const double sign : {-1.0, 1.0}) {
+        std::array<double, kDim> offset{};
+        offset[i] = sign * lambda;
+        add(offset);
+      }
+    }
+  }
+  for (std::size_t i = 0; i < kDim; i++) {
+    for (std::size_t j = i + 1; j < kDim; j++) {
+      for (const double si : {-1.0, 1.0}) {
+        for (const double sj : {-1.0, 1.0}) {
+          std::array<double, kDim> offset{};
+          offset[i] = si * rule.lambda4;
+          offset[j] = sj * rule.lambda4;
+          add(offset);
+        }
+      }
+    }
+  }
+  for (std::size_t mask = 0; mask < (std::size_t{1} << kDim); mask++) {
+    std::array<double, kDim> offset{};
+    for (std::size_t d = 0; d < kDim; d++) {
+      offset[d] = ((mask >> d) & 1U) != 0 ? -rule.lambda5 : rule.lambda5;
+    }
+    add(offset);
+  }
+  std::vector<double> values;
+  EvaluatePoints<kDim>(f, x, x[0].size(), values);
+
+  const double centre_value = values[0];
+  std::array<double, 5> sums = {centre_value, 0.0, 0.0, 0.0, 0.0};
+  double widest_difference = -1.0;
+  for (std::size_t i = 0; i < kDim; i++) {
+    const double inner = values[1 + (2 * i)] + values[2 + (2 * i)];
+    const double outer = values[1 + (2 * kDim) + (2 * i)] + values[2 + (2 * kDim) + (2 * i)];
+    sums[1] += inner;
+    sums[2] += outer;
+    // (lambda2 / lambda4)^2 = 1 / 7 cancels the second derivative, leaving the fourth.
+    const double difference = std::abs(inner - (2.0 * centre_value) - ((outer - (2.0 * centre_value)) / 7.0));
+    if (difference > widest_difference) {
+      widest_difference = difference;
+      region.axis = i;
+    }
+  }
+  const std::size_t planes = 1 + (4 * kDim);
+  const std::size_t corners = planes + (2 * kDim * (kDim - 1));
+  for (std::size_t p = planes; p < corners; p++) {
+    sums[3] += values[p];
+  }
+  for (std::size_t p = corners; p < values.size(); p++) {
+    sums[4] += values[p];
+  }
+  double degree7 = 0.0;
+  double degree5 = 0.0;
+  for (std::size_t k = 0; k < 5; k++) {
+    degree7 += rule.degree7[k] * sums[k];
+  }
+  for (std::size_t k = 0; k < 4; k++) {
+    degree5 += rule.degree5[k] * sums[k];
+  }
+  region.value = volume * degree7;
+  region.error = std::abs(volume * (degree7 - degree5));
+}
+
+template <std::size_t kDim, typename F>
+void Estimate(const F &f, const GenzMalik &rule, Region<kDim> &region) {
+  if constexpr (kDim == 1) {
+    EstimateGaussKronrod(f, region);
+  } else {
+    EstimateGenzMalik<kDim>(f, rule, region);
+  }
+}
+
+/// Heap order: the region with the largest error on top.
+template <std::size_t kDim>
+bool SmallerError(const Region<kDim> &a, const Region<kDim> &b) {
+  return a.error < b.error;
+}
+
+/// Regions handed from one rank to another, flattened to doubles.
+template <std::size_t kDim>
+constexpr std::size_t kRegionDoubles = (2 * kDim) + 3;
+
+template <std::size_t kDim>
+void Pack(const Region<kDim> &region, std::vector<double> &out) {
+  out.insert(out.end(), region.lower.begin(), region.lower.end());
+  out.insert(out.end(), region.upper.begin(), region.upper.end());
+  out.insert(out.end(), {region.value, region.error, static_cast<double>(region.axis)});
+}
+
+template <std::size_t kDim>
+Region<kDim> Unpack(const double *in) {
+  Region<kDim> region;
+  std::copy_n(in, kDim, region.lower.begin());
+  std::copy_n(in + kDim, kDim, region.upper.begin());
+  region.value = in[2 * kDim];
+  region.error = in[(2 * kDim) + 1];
+  region.axis = static_cast<std::size_t>(in[(2 * kDim) + 2]);
+  return region;
+}
+
+/// Rank paired with @p rank in this rebalancing (the largest error with the smallest, and so on),
+/// or -1; @p donor tells whether @p rank hands regions over. Ranks whose errors are within the
+/// imbalance factor are not paired.
+int RebalancePartner(std::span<const double> errors, int rank, double imbalance, bool &donor);
+
+/// Sends @p packed to @p partner, or receives its regions into @p packed.
+void ExchangeRegions(std::vector<double> &packed, int partner, bool donor, MPI_Comm comm);
+
+/// The partition of one rank, kept as a max-heap by error with running sums.
+template <std::size_t kDim>
+struct Partition {
+  std::vector<Region<kDim>> heap;
+  double value = 0.0;
+  double error = 0.0;
+
+  void Push(const Region<kDim> &region) {
+    heap.push_back(region);
+    std::ranges::push_heap(heap, SmallerError<kDim>);
+    value += region.value;
+    error += region.error;
+  }
+
+  Region<kDim> Pop() {
+    std::ranges::pop_heap(heap, SmallerError<kDim>);
+    Region<kDim> region = heap.back();
+    heap.pop_back();
+    value -= region.value;
+    error -= region.error;
+    return region;
+  }
+};
+
+/// Moves regions from the rank with more error to its partner until half the difference moved:
+/// the donor walks its heap from the top and alternately keeps and sends, so both keep a share of
+/// the worst regions.
+template <std::size_t kDim>
+std::size_t Rebalance(Partition<kDim> &partition, double imbalance, MPI_Comm comm) {
+  int rank = 0;
+  int size = 1;
+  MPI_Comm_rank(comm, &rank);
+  MPI_Comm_size(comm, &size);
+  std::vector<double> errors(static_cast<std::size_t>(size));
+  MPI_Allgather(&partition.error, 1, MPI_DOUBLE, errors.data(), 1, MPI_DOUBLE, comm);
+  bool donor = false;
+  const int partner = RebalancePartner(errors, rank, imbalance, donor);
+  if (partner < 0) {
+    return 0;
+  }
+  std::vector<double> packed;
+  if (donor) {
+    const double target = 0.5 * (errors[static_cast<std::size_t>(rank)] - errors[static_cast<std::size_t>(partner)]);
+    double moved = 0.0;
+    std::vector<Region<kDim>> kept;
+    for (bool send = false; moved < target && partition.heap.size() > 1; send = !send) {
+      const Region<kDim> region = partition.Pop();
+      if (send) {
+        Pack(region, packed);
+        moved += region.error;
+      } else {
+        kept.push_back(region);
+      }
+    }
+    for (const auto &region : kept) {
+      partition.Push(region);
+    }
+  }
+  ExchangeRegions(packed, partner, donor, comm);
+  if (donor) {
+    return 0;
+  }
+  for (std::size_t i = 0; i < packed.size(); i += kRegionDoubles<kDim>) {
+    partition.Push(Unpack<kDim>(packed.data() + i));
+  }
+  return packed.size() / kRegionDoubles<kDim>;
+}
+
+}  // namespace detail
+
+/// @brief Integrates @p f over [lower, upper] by globally adaptive subdivision.
+/// @details Every region carries an embedded rule pair: Gauss-Kronrod 7-15 in 1-D, Genz-Malik 7-5
+/// above. The regions form a priority queue by error; each step takes the AdaptiveOptions::batch
+/// worst, bisects each along its axis of largest fourth difference and evaluates all children in
+/// parallel on the back-end. Under MPI the box is first cut into one slab per rank; every
+/// sync_every steps the ranks agree on the global estimate, stop if it converged, and pair the
+/// rank with the most error with the one with the least so the former hands over regions.
+/// @param comm Communicator of the ranks, or MPI_COMM_NULL for a shared-memory integration; the
+/// value, error and totals are returned on every rank.
+/// @throws std::invalid_argument When the options or bounds are invalid (see CheckAdaptive()).
+template <std::size_t kDim, Integrand<kDim> F>
+  requires(kDim >= 1 && kDim <= 15)
+AdaptiveResult IntegrateAdaptive(const F &f, const std::array<double, kDim> &lower,
+                                 const std::array<double, kDim> &upper, const AdaptiveOptions &options = {},
+                                 MPI_Comm comm = MPI_COMM_NULL) {
+  CheckAdaptive(options, lower, upper);
+  const auto start = std::chrono::steady_clock::now();
+  const auto elapsed = [start] {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+  };
+  const detail::GenzMalik rule = detail::MakeGenzMalik(kDim);
+  constexpr std::size_t kPoints = RulePoints(kDim);
+  int rank = 0;
+  int size = 1;
+  if (comm != MPI_COMM_NULL) {
+    MPI_Comm_rank(comm, &rank);
+    MPI_Comm_size(comm, &size);
+  }
+
+  // Slab of this rank along the widest axis.
+  std::size_t widest = 0;
+  for (std::size_t d = 1; d < kDim; d++) {
+    if (std::abs(upper[d] - lower[d]) > std::abs(upper[widest] - lower[widest])) {
+      widest = d;
+    }
+  }
+  Region<kDim> slab;
+  slab.lower = lower;
+  slab.upper = upper;
+  const double width = (upper[widest] - lower[widest]) / static_cast<double>(size);
+  slab.lower[widest] = lower[widest] + (static_cast<double>(rank) * width);
+  slab.upper[widest] = rank + 1 == size ? upper[widest] : lower[widest] + (static_cast<double>(rank + 1) * width);
+  detail::Estimate<kDim>(f, rule, slab);
+  detail::Partition<kDim> partition;
+  partition.Push(slab);
+
+  AdaptiveResult result;
+  std::size_t evaluations = kPoints;
+  std::vector<Region<kDim>> parents;
+  std::vector<Region<kDim>> children;
+  while (true) {
+    if (comm == MPI_COMM_NULL || result.steps % options.sync_every == 0) {
+      std::array<double, 3> totals = {partition.value, partition.error, static_cast<double>(evaluations)};
+      if (comm != MPI_COMM_NULL) {
+        MPI_Allreduce(MPI_IN_PLACE, totals.data(), 3, MPI_DOUBLE, MPI_SUM, comm);
+      }
+      result.history.push_back(ErrorCheck{.evaluations = static_cast<std::size_t>(totals[2]),
+                                          .seconds = elapsed(),
+                                          .error = totals[1]});
+      if (totals[1] <= std::max(options.abs_tolerance, options.rel_tolerance * std::abs(totals[0]))) {
+        result.converged = true;
+        break;
+      }
+      if (totals[2] >= static_cast<double>(options.max_evaluations)) {
+        break;
+      }
+      if (comm != MPI_COMM_NULL && size > 1) {
+        result.migrated += detail::Rebalance(partition, options.imbalance, comm);
+      }
+    }
+    parents.clear();
+    while (parents.size() < options.batch && !partition.heap.empty()) {
+      parents.push_back(partition.Pop());
+    }
+    children.assign(2 * parents.size(), Region<kDim>{});
+    ppc::shared_memory::ParallelFor(children.size(), options.backend, [&](std::size_t i) {
+      const Region<kDim> &parent = parents[i / 2];
+      Region<kDim> &child = children[i];
+      child.lower = parent.lower;
+      child.upper = parent.upper;
+      const double middle = 0.5 * (parent.lower[parent.axis] + parent.upper[parent.axis]);
+      (i % 2 == 0 ? child.upper : child.lower)[parent.axis] = middle;
+      detail::Estimate<kDim>(f, rule, child);
+    });
+    for (const auto &child : children) {
+      partition.Push(child);
+    }
+    evaluations += children.size() * kPoints;
+    result.steps++;
+  }
+
+  CompensatedSum value;
+  CompensatedSum error;
+  for (const auto &region : partition.heap) {
+    value.Add(region.value);
+    error.Add(region.error);
+  }
+  result.value = SumOverRanks(value, comm).Value();
+  result.error = SumOverRanks(error, comm).Value();
+  std::array<std::uint64_t, 2> counts = {evaluations, partition.heap.size()};
+  if (comm != MPI_COMM_NULL) {
+    MPI_Allreduce(MPI_IN_PLACE, counts.data(), 2, MPI_UINT64_T, MPI_SUM, comm);
+  }
+  result.evaluations = counts[0];
+  result.regions = counts[1];
+  result.seconds = elapsed();
+  return result;
+}
+
+}  // namespace ppc::integration
@@ -0,0 +1,282 @@
+#pragma once
+
+#include <mpi.h>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "shared_memory/include/parallel_for.hpp"
+#include "shared_memory/include/shared_memory.hpp"
+
+namespace ppc::integration {
+
+using Backend = ppc::shared_memory::Backend;
+
+/// @brief Composite quadrature rule applied along every axis.
+enum class Rule : uint8_t {
+  /// Midpoint rectangles: steps nodes per axis, exact for linear integrands
+  kRectangle,
+  /// Trapezoids: steps + 1 nodes per axis, end nodes weighted 1/2
+  kTrapezoid,
+  /// Simpson 1/3: steps + 1 nodes per axis with weights 1, 4, 2, ..., 4, 1; steps must be even
+  kSimpson
+};
+
+/// @brief Returns the lower-case name of the rule ("rectangle", "trapezoid", "simpson").
+std::string RuleToString(Rule rule);
+
+/// @brief Neumaier's variant of Kahan summation: the rounding error of every addition is kept in a
+/// separate term, so the error of a long sum does not grow with the number of terms.
+struct CompensatedSum {
+  double sum = 0.0;
+  double compensation = 0.0;
+
+  void Add(double value) {
+    const double total = sum + value;
+    if (std::abs(sum) >= std::abs(value)) {
+      compensation += (sum - total) + value;
+    } else {
+      compensation += (value - total) + sum;
+    }
+    sum = total;
+  }
+
+  void Merge(const CompensatedSum &other) {
+    Add(other.sum);
+    compensation += other.compensation;
+  }
+
+  [[nodiscard]] double Value() const {
+    return sum + compensation;
+  }
+};
+
+/// @brief One axis of the grid; nodes and weights are computed on the fly, so a grid of any size
+/// needs no per-node storage.
+struct Axis {
+  Rule rule = Rule::kSimpson;
+  double lower = 0.0;
+  double upper = 0.0;
+  std::size_t steps = 1;
+  double h = 0.0;
+  /// Weights including the step: end nodes, odd interior nodes and even interior nodes.
+  double end_weight = 0.0;
+  double odd_weight = 0.0;
+  double even_weight = 0.0;
+
+  [[nodiscard]] std::size_t Size() const {
+    return rule == Rule::kRectangle ? steps : steps + 1;
+  }
+
+  [[nodiscard]] double Node(std::size_t i) const {
+    if (rule == Rule::kRectangle) {
+      return lower + ((static_cast<double>(i) + 0.5) * h);
+    }
+    return i == steps ? upper : lower + (static_cast<double>(i) * h);
+  }
+
+  [[nodiscard]] double Weight(std::size_t i) const {
+    if (rule == Rule::kRectangle) {
+      return h;
+    }
+    if (i == 0 || i == steps) {
+      return end_weight;
+    }
+    return i % 2 == 1 ? odd_weight : even_weight;
+  }
+};
+
+/// @brief Axis of @p rule on [lower, upper] split into @p steps steps.
+/// @throws std::invalid_argument When steps is zero, odd for kSimpson, or a bound is not finite.
+Axis MakeAxis(Rule rule, double lower, double upper, std::size_t steps);
+
+/// @brief Box [lower, upper] of R^kDim with the number of steps along each axis.
+template <std::size_t kDim>
+struct Domain {
+  std::array<double, kDim> lower{};
+  std::array<double, kDim> upper{};
+  std::array<std::size_t, kDim> steps{};
+};
+
+/// @brief Structure-of-arrays block of points: coordinate d of point p is x[d][p].
+template <std::size_t kDim>
+struct Batch {
+  std::array<const double *, kDim> x{};
+  std::size_t size = 0;
+};
+
+/// @brief f(point) -> double; inlined into the batch loop, so simple integrands vectorise.
+template <typename F, std::size_t kDim>
+concept PointIntegrand = std::is_invocable_r_v<double, const F &, const std::array<double, kDim> &>;
+
+/// @brief f(batch, values) writing values[p] for every point of the batch, for integrands with
+/// their own vector kernels.
+template <typename F, std::size_t kDim>
+concept BatchIntegrand = std::is_invocable_v<const F &, const Batch<kDim> &, std::span<double>>;
+
+template <typename F, std::size_t kDim>
+concept Integrand = PointIntegrand<F, kDim> || BatchIntegrand<F, kDim>;
+
+struct Options {
+  Rule rule = Rule::kSimpson;
+  /// Thread back-end over the tiles of the index space.
+  Backend backend = Backend::kSeq;
+};
+
+/// @brief Work split of Integrate().
+struct Tuning {
+  /// Grid points per tile. Tiles are the unit of work and of the ordered reduction; their size does
+  /// not depend on the worker count, so every back-end and thread count returns the same bits.
+  std::size_t tile = std::size_t{1} << 14;
+};
+
+/// @brief Returns the tuning shared by all integrations.
+Tuning &GetTuning();
+
+struct Result {
+  double value = 0.0;
+  /// Integrand evaluations over all ranks.
+  std::size_t evaluations = 0;
+};
+
+/// @brief Sums the per-rank partials in rank order; every rank gets the same sum.
+/// @param comm Communicator of the ranks, or MPI_COMM_NULL to return @p local.
+CompensatedSum SumOverRanks(const CompensatedSum &local, MPI_Comm comm);
+
+namespace detail {
+
+/// Points evaluated per integrand call; a multiple of every SIMD width.
+inline constexpr std::size_t kBatch = 64;
+
+template <std::size_t kDim>
+std::size_t GridSize(const std::array<Axis, kDim> &axes) {
+  std::size_t total = 1;
+  for (const auto &axis : axes) {
+    if (total > SIZE_MAX / axis.Size()) {
+      throw std::invalid_argument("integration: grid does not fit the index space");
+    }
+    total *= axis.Size();
+  }
+  return total;
+}
+
+/// Evaluates values[p] for @p count points of one grid row: the last coordinate runs over
+/// inner[0, count), the others are fixed by @p outer.
+template <std::size_t kDim, typename F>
+void EvaluateRow(const F &f, const std::array<double, kDim> &outer, const double *inner, std::size_t count,
+                 double *values) {
+  if constexpr (BatchIntegrand<F, kDim>) {
+    std::array<std::array<double, kBatch>, kDim> fixed{};
+    Batch<kDim> batch;
+    for (std::size_t d = 0; d + 1 < kDim; d++) {
+      std::fill_n(fixed[d].begin(), count, outer[d]);
+      batch.x[d] = fixed[d].data();
+    }
+    batch.x[kDim - 1] = inner;
+    batch.size = count;
+    f(batch, std::span<double>(values, count));
+  } else {
+    for (std::size_t p = 0; p < count; p++) {
+      std::array<double, kDim> point = outer;
+      point[kDim - 1] = inner[p];
+      values[p] = static_cast<double>(f(point));
+    }
+  }
+}
+
+/// Weighted sum of the grid points with flat indices [begin, end), last axis fastest. The
+/// multi-index is decoded once and then advanced row by row; the last coordinate and its weights
+/// are generated kBatch at a time.
+template <std::size_t kDim, typename F>
+CompensatedSum SumTile(const F &f, const std::array<Axis, kDim> &axes, std::size_t begin, std::size_t end) {
+  std::array<std::size_t, kDim> index{};
+  for (std::size_t d = kDim, rest = begin; d-- > 0;) {
+    index[d] = rest % axes[d].Size();
+    rest /= axes[d].Size();
+  }
+  const Axis &last = axes[kDim - 1];
+  std::array<double, kBatch> inner{};
+  std::array<double, kBatch> values{};
+  CompensatedSum tile;
+  for (std::size_t position = begin; position < end;) {
+    std::array<double, kDim> outer{};
+    double outer_weight = 1.0;
+    for (std::size_t d = 0; d + 1 < kDim; d++) {
+      outer[d] = axes[d].Node(index[d]);
+      outer_weight *= axes[d].Weight(index[d]);
+    }
+    const std::size_t row_end = std::min(last.Size(), index[kDim - 1] + (end - position));
+    CompensatedSum row;
+    for (std::size_t i = index[kDim - 1]; i < row_end; i += kBatch) {
+      const std::size_t count = std::min(kBatch, row_end - i);
+      for (std::size_t p = 0; p < count; p++) {
+        inner[p] = last.Node(i + p);
+      }
+      EvaluateRow<kDim>(f, outer, inner.data(), count, values.data());
+      for (std::size_t p = 0; p < count; p++) {
+        row.Add(last.Weight(i + p) * values[p]);
+      }
+    }
+    tile.Add(outer_weight * row.sum);
+    tile.Add(outer_weight * row.compensation);
+    position += row_end - index[kDim - 1];
+    index[kDim - 1] = row_end;
+    for (std::size_t d = kDim - 1; d > 0 && index[d] == axes[d].Size(); d--) {
+      index[d] = 0;
+      index[d - 1]++;
+    }
+  }
+  return tile;
+}
+
+}  // namespace detail
+
+/// @brief Integrates @p f over @p domain with a composite rule on the tensor grid of the domain.
+/// @details The grid is one flat index space (last axis fastest) cut into Tuning::tile points per
+/// tile. Ranks take contiguous tile ranges, workers take tiles, and each tile walks its points row
+/// by row, evaluating the integrand kBatch points at a time. Rows, tiles and ranks are summed with
+/// compensation in a fixed order, so the result is independent of the back-end and thread count.
+/// @param comm Communicator of the ranks, or MPI_COMM_NULL for a shared-memory integration; the
+/// result is returned on every rank.
+/// @throws std::invalid_argument When an axis is invalid for the rule (see MakeAxis()) or the
+/// grid has more than SIZE_MAX points.
+template <std::size_t kDim, Integrand<kDim> F>
+  requires(kDim >= 1)
+Result Integrate(const F &f, const Domain<kDim> &domain, const Options &options = {},
+                 MPI_Comm comm = MPI_COMM_NULL) {
+  std::array<Axis, kDim> axes;
+  for (std::size_t d = 0; d < kDim; d++) {
+    axes[d] = MakeAxis(options.rule, domain.lower[d], domain.upper[d], domain.steps[d]);
+  }
+  const std::size_t total = detail::GridSize(axes);
+  const std::size_t tile = std::max<std::size_t>(1, GetTuning().tile);
+  const std::size_t tiles = (total / tile) + (total % tile == 0 ? 0 : 1);
+
+  int rank = 0;
+  int size = 1;
+  if (comm != MPI_COMM_NULL) {
+    MPI_Comm_rank(comm, &rank);
+    MPI_Comm_size(comm, &size);
+  }
+  const auto [first, last] = ppc::shared_memory::BlockRange(tiles, size, rank);
+  std::vector<CompensatedSum> partials(last - first);
+  ppc::shared_memory::ParallelFor(partials.size(), options.backend, [&](std::size_t t) {
+    const std::size_t begin = (first + t) * tile;
+    partials[t] = detail::SumTile<kDim>(f, axes, begin, std::min(total, begin + tile));
+  });
+  CompensatedSum local;
+  for (const auto &partial : partials) {
+    local.Merge(partial);
+  }
+  return {.value = SumOverRanks(local, comm).Value(), .evaluations = total};
+}
+
+}  // namespace ppc::integration
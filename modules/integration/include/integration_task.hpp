@@ -0,0 +1,119 @@
+#pragma once
+
+#include <mpi.h>
+
+#include <array>
+#include <cstddef>
+
+#include "integration/include/adaptive.hpp"
+#include "integration/include/integration.hpp"
+#include "shared_memory/include/parallel_for.hpp"
+#include "task/include/task.hpp"
+
+namespace ppc::integration {
+
+/// @brief Multistep integration of the functor type @p F as a course task on any back-end.
+/// @details The integrand is a type rather than a std::function, so that it is inlined into the
+/// evaluation loop. The kMPI variant splits the grid over MPI_COMM_WORLD; the result is returned on
+/// every rank.
+template <std::size_t kDim, Integrand<kDim> F, ppc::task::TypeOfTask kType, Rule kRule = Rule::kSimpson>
+class IntegrationTask : public ppc::task::Task<Domain<kDim>, Result> {
+ public:
+  using InType = Domain<kDim>;
+  using OutType = Result;
+
+  static constexpr ppc::task::TypeOfTask GetStaticTypeOfTask() {
+    return kType;
+  }
+
+  explicit IntegrationTask(const InType &in, F integrand = {}) : integrand_(integrand) {
+    this->SetTypeOfTask(GetStaticTypeOfTask());
+    this->GetInput() = in;
+  }
+
+ private:
+  bool ValidationImpl() override {
+    for (const std::size_t steps : this->GetInput().steps) {
+      if (steps == 0 || (kRule == Rule::kSimpson && steps % 2 != 0)) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  bool PreProcessingImpl() override {
+    return true;
+  }
+
+  bool RunImpl() override {
+    const MPI_Comm comm = kType == ppc::task::TypeOfTask::kMPI ? MPI_COMM_WORLD : MPI_COMM_NULL;
+    const Options options{.rule = kRule, .backend = ppc::shared_memory::BackendOf(kType)};
+    this->GetOutput() = Integrate<kDim>(integrand_, this->GetInput(), options, comm);
+    return true;
+  }
+
+  bool PostProcessingImpl() override {
+    return this->GetOutput().evaluations > 0;
+  }
+
+  F integrand_;
+};
+
+/// @brief Box and stopping rule of an adaptive integration.
+template <std::size_t kDim>
+struct AdaptiveProblem {
+  std::array<double, kDim> lower{};
+  std::array<double, kDim> upper{};
+  double abs_tolerance = 1e-10;
+  double rel_tolerance = 1e-8;
+  std::size_t max_evaluations = std::size_t{1} << 24;
+};
+
+/// @brief Adaptive cubature of the functor type @p F as a course task on any back-end.
+/// @details The kMPI variant starts from one slab per rank of MPI_COMM_WORLD and rebalances regions
+/// between ranks; the result is returned on every rank.
+template <std::size_t kDim, Integrand<kDim> F, ppc::task::TypeOfTask kType>
+class AdaptiveIntegrationTask : public ppc::task::Task<AdaptiveProblem<kDim>, AdaptiveResult> {
+ public:
+  using InType = AdaptiveProblem<kDim>;
+  using OutType = AdaptiveResult;
+
+  static constexpr ppc::task::TypeOfTask GetStaticTypeOfTask() {
+    return kType;
+  }
+
+  explicit AdaptiveIntegrationTask(const InType &in, F integrand = {}) : integrand_(integrand) {
+    this->SetTypeOfTask(GetStaticTypeOfTask());
+    this->GetInput() = in;
+  }
+
+ private:
+  bool ValidationImpl() override {
+    const InType &in = this->GetInput();
+    return in.abs_tolerance >= 0.0 && in.rel_tolerance >= 0.0 && (in.abs_tolerance > 0.0 || in.rel_tolerance > 0.0);
+  }
+
+  bool PreProcessingImpl() override {
+    return true;
+  }
+
+  bool RunImpl() override {
+    const InType &in = this->GetInput();
+    const MPI_Comm comm = kType == ppc::task::TypeOfTask::kMPI ? MPI_COMM_WORLD : MPI_COMM_NULL;
+    AdaptiveOptions options;
+    options.abs_tolerance = in.abs_tolerance;
+    options.rel_tolerance = in.rel_tolerance;
+    options.max_evaluations = in.max_evaluations;
+    options.backend = ppc::shared_memory::BackendOf(kType);
+    this->GetOutput() = IntegrateAdaptive<kDim>(integrand_, in.lower, in.upper, options, comm);
+    return true;
+  }
+
+  bool PostProcessingImpl() override {
+    return this->GetOutput().evaluations > 0;
+  }
+
+  F integrand_;
+};
+
+}  // namespace ppc::integration
@@ -0,0 +1,244 @@
+#include <gtest/gtest.h>
+
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <numbers>
+#include <string>
+
+#include "integration/include/adaptive.hpp"
+#include "integration/include/integration.hpp"
+#include "integration/include/integration_task.hpp"
+#include "task/include/task.hpp"
+#include "util/include/perf_test_util.hpp"
+
+namespace ppc::integration::perf {
+
+using ppc::task::TypeOfTask;
+
+namespace {
+
+/// prod_d (1 + x_d^2); its integral over [0, 1]^kDim is (4/3)^kDim, and Simpson's rule is exact.
+template <std::size_t kDim>
+struct Polynomial {
+  double operator()(const std::array<double, kDim> &x) const {
+    double value = 1.0;
+    for (const double coordinate : x) {
+      value *= 1.0 + (coordinate * coordinate);
+    }
+    return value;
+  }
+};
+
+/// Steps per axis giving 1.6e7 to 2.4e7 Simpson nodes in every dimension.
+constexpr std::array<std::size_t, 6> kSteps = {std::size_t{1} << 24, 4096, 256, 64, 28, 16};
+
+template <std::size_t kDim>
+Domain<kDim> PerfDomain() {
+  Domain<kDim> domain;
+  domain.lower.fill(0.0);
+  domain.upper.fill(1.0);
+  domain.steps.fill(kSteps[kDim - 1]);
+  return domain;
+}
+
+/// Integral of exp(-a^2 (x - c)^2) over [0, 1].
+double GaussianOnUnit(double a, double c) {
+  return std::sqrt(std::numbers::pi) / (2.0 * a) * (std::erf(a * (1.0 - c)) + std::erf(a * c));
+}
+
+/// 100 peaks exp(-10^4 (x - c_k)^2) on [0, 1]: the Gauss-Kronrod suite, which must resolve each.
+struct PeakComb {
+  static constexpr int kPeaks = 100;
+  static constexpr double kTolerance = 1e-12;
+
+  double operator()(const std::array<double, 1> &x) const {
+    double value = 0.0;
+    for (int k = 0; k < kPeaks; k++) {
+      const double r = x[0] - ((k + 0.5) / kPeaks);
+      value += std::exp(-1e4 * r * r);
+    }
+    return value;
+  }
+
+  static double Exact() {
+    double exact = 0.0;
+    for (int k = 0; k < kPeaks; k++) {
+      exact += GaussianOnUnit(100.0, (k + 0.5) / kPeaks);
+    }
+    return exact;
+  }
+};
+
+/// exp(-100 |x - 0.3|^2) over [0, 1]^kDim: the Genz-Malik suites.
+template <std::size_t kDim>
+struct GaussianPeak {
+  static constexpr double kTolerance = kDim <= 3 ? 1e-10 : 1e-8;
+
+  double operator()(const std::array<double, kDim> &x) const {
+    double r2 = 0.0;
+    for (const double coordinate : x) {
+      r2 += (coordinate - 0.3) * (coordinate - 0.3);
+    }
+    return std::exp(-100.0 * r2);
+  }
+
+  static double Exact() {
+    return std::pow(GaussianOnUnit(10.0, 0.3), static_cast<double>(kDim));
+  }
+};
+
+}  // namespace
+
+/// Reports integrand evaluations per second (in millions) and the relative error of the integral.
+template <std::size_t kDim>
+class IntegrationPerfTests : public ppc::util::BaseRunPerfTests<Domain<kDim>, Result> {
+  bool CheckTestOutputData(Result &output_data) final {
+    const double exact = std::pow(4.0 / 3.0, static_cast<double>(kDim));
+    this->PrintRate("mevals_per_s", 1e-6 * static_cast<double>(output_data.evaluations));
+    this->PrintValue("relative_error", std::abs(output_data.value - exact) / exact);
+    return std::abs(output_data.value - exact) <= 1e-12 * exact;
+  }
+
+  Domain<kDim> GetTestInputData() final {
+    return PerfDomain<kDim>();
+  }
+};
+
+using Integration1dPerfTests = IntegrationPerfTests<1>;
+using Integration2dPerfTests = IntegrationPerfTests<2>;
+using Integration3dPerfTests = IntegrationPerfTests<3>;
+using Integration4dPerfTests = IntegrationPerfTests<4>;
+using Integration5dPerfTests = IntegrationPerfTests<5>;
+using Integration6dPerfTests = IntegrationPerfTests<6>;
+
+/// Reports evaluations per second (in millions), the final error estimate and how fast the error
+/// fell: decades of error estimate per second between the first and the last convergence check.
+template <std::size_t kDim, typename F>
+class AdaptivePerfTests : public ppc::util::BaseRunPerfTests<AdaptiveProblem<kDim>, AdaptiveResult> {
+  bool CheckTestOutputData(AdaptiveResult &output_data) final {
+    this->PrintRate("mevals_per_s", 1e-6 * static_cast<double>(output_data.evaluations));
+    this->PrintValue("error", output_data.error);
+    const auto &history = output_data.history;
+    if (history.size() > 1 && history.back().seconds > 0.0 && history.back().error > 0.0) {
+      this->PrintValue("error_decades_per_s",
+                       std::log10(history.front().error / history.back().error) / history.back().seconds);
+    }
+    return output_data.converged && std::abs(output_data.value - F::Exact()) <= 10.0 * F::kTolerance;
+  }
+
+  AdaptiveProblem<kDim> GetTestInputData() final {
+    AdaptiveProblem<kDim> problem;
+    problem.lower.fill(0.0);
+    problem.upper.fill(1.0);
+    problem.abs_tolerance = F::kTolerance;
+    problem.rel_tolerance = 0.0;
+    problem.max_evaluations = std::size_t{1} << 27;
+    return problem;
+  }
+};
+
+using Adaptive1dPerfTests = AdaptivePerfTests<1, PeakComb>;
+using Adaptive3dPerfTests = AdaptivePerfTests<3, GaussianPeak<3>>;
+using Adaptive5dPerfTests = AdaptivePerfTests<5, GaussianPeak<5>>;
+
+/// Simpson IntegrationTask of every back-end for the polynomial of one dimension.
+template <std::size_t kDim>
+struct PerfIntegrationTasks {
+  template <TypeOfTask kType>
+  using Task = IntegrationTask<kDim, Polynomial<kDim>, kType, Rule::kSimpson>;
+};
+
+template <std::size_t kDim>
+auto MakeBackendSuite() {
+  return ppc::util::MakeBackendPerfTaskTuples<PerfIntegrationTasks<kDim>::template Task, Domain<kDim>>(
+      "ppc_integration", "simpson_" + std::to_string(kDim) + "d");
+}
+
+/// AdaptiveIntegrationTask of every back-end for one integrand.
+template <std::size_t kDim, typename F>
+struct PerfAdaptiveTasks {
+  template <TypeOfTask kType>
+  using Task = AdaptiveIntegrationTask<kDim, F, kType>;
+};
+
+template <std::size_t kDim, typename F>
+auto MakeAdaptiveSuite() {
+  return ppc::util::MakeBackendPerfTaskTuples<PerfAdaptiveTasks<kDim, F>::template Task, AdaptiveProblem<kDim>>(
+      "ppc_integration", "adaptive_" + std::to_string(kDim) + "d");
+}
+
+TEST_P(Integration1dPerfTests, RunPerfModes) {
+  ExecuteTest(GetParam());
+}
+
+TEST_P(Integration2dPerfTests, RunPerfModes) {
+  ExecuteTest(GetParam());
+}
+
+TEST_P(Integration3dPerfTests, RunPerfModes) {
+  ExecuteTest(GetParam());
+}
+
+TEST_P(Integration4dPerfTests, RunPerfModes) {
+  ExecuteTest(GetParam());
+}
+
+TEST_P(Integration5dPerfTests, RunPerfModes) {
+  ExecuteTest(GetParam());
+}
+
+TEST_P(Integration6dPerfTests, RunPerfModes) {
+  ExecuteTest(GetParam());
+}
+
+TEST_P(Adaptive1dPerfTests, RunPerfModes) {
+  ExecuteTest(GetParam());
+}
+
+TEST_P(Adaptive3dPerfTests, RunPerfModes) {
+  ExecuteTest(GetParam());
+}
+
+TEST_P(Adaptive5dPerfTests, RunPerfModes) {
+  ExecuteTest(GetParam());
+}
+
+const auto kIntegration1dPerfTasks = MakeBackendSuite<1>();
+const auto kIntegration2dPerfTasks = MakeBackendSuite<2>();
+const auto kIntegration3dPerfTasks = MakeBackendSuite<3>();
+const auto kIntegration4dPerfTasks = MakeBackendSuite<4>();
+const auto kIntegration5dPerfTasks = MakeBackendSuite<5>();
+const auto kIntegration6dPerfTasks = MakeBackendSuite<6>();
+
+INSTANTIATE_TEST_SUITE_P(MultistepSimpson1d, Integration1dPerfTests,
+                         ppc::util::TupleToGTestValues(kIntegration1dPerfTasks),
+                         Integration1dPerfTests::CustomPerfTestName);
+INSTANTIATE_TEST_SUITE_P(MultistepSimpson2d, Integration2dPerfTests,
+                         ppc::util::TupleToGTestValues(kIntegration2dPerfTasks),
+                         Integration2dPerfTests::CustomPerfTestName);
+INSTANTIATE_TEST_SUITE_P(MultistepSimpson3d, Integration3dPerfTests,
+                         ppc::util::TupleToGTestValues(kIntegration3dPerfTasks),
+                         Integration3dPerfTests::CustomPerfTestName);
+INSTANTIATE_TEST_SUITE_P(MultistepSimpson4d, Integration4dPerfTests,
+                         ppc::util::TupleToGTestValues(kIntegration4dPerfTasks),
+                         Integration4dPerfTests::CustomPerfTestName);
+INSTANTIATE_TEST_SUITE_P(MultistepSimpson5d, Integration5dPerfTests,
+                         ppc::util::TupleToGTestValues(kIntegration5dPerfTasks),
+                         Integration5dPerfTests::CustomPerfTestName);
+INSTANTIATE_TEST_SUITE_P(MultistepSimpson6d, Integration6dPerfTests,
+                         ppc::util::TupleToGTestValues(kIntegration6dPerfTasks),
+                         Integration6dPerfTests::CustomPerfTestName);
+
+const auto kAdaptive1dPerfTasks = MakeAdaptiveSuite<1, PeakComb>();
+const auto kAdaptive3dPerfTasks = MakeAdaptiveSuite<3, GaussianPeak<3>>();
+const auto kAdaptive5dPerfTasks = MakeAdaptiveSuite<5, GaussianPeak<5>>();
+
+INSTANTIATE_TEST_SUITE_P(GaussKronrod1d, Adaptive1dPerfTests, ppc::util::TupleToGTestValues(kAdaptive1dPerfTasks),
+                         Adaptive1dPerfTests::CustomPerfTestName);
+INSTANTIATE_TEST_SUITE_P(GenzMalik3d, Adaptive3dPerfTests, ppc::util::TupleToGTestValues(kAdaptive3dPerfTasks),
+                         Adaptive3dPerfTests::CustomPerfTestName);
+INSTANTIATE_TEST_SUITE_P(GenzMalik5d, Adaptive5dPerfTests, ppc::util::TupleToGTestValues(kAdaptive5dPerfTasks),
+                         Adaptive5dPerfTests::CustomPerfTestName);
+
+}  // namespace ppc::integration::perf
@@ -0,0 +1,82 @@
+#include "integration/include/adaptive.hpp"
+
+#include <mpi.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <numeric>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+namespace ppc::integration {
+
+void CheckAdaptive(const AdaptiveOptions &options, std::span<const double> lower, std::span<const double> upper) {
+  const auto valid_tolerance = [](double tolerance) { return std::isfinite(tolerance) && tolerance >= 0.0; };
+  if (!valid_tolerance(options.abs_tolerance) || !valid_tolerance(options.rel_tolerance) ||
+      (options.abs_tolerance == 0.0 && options.rel_tolerance == 0.0)) {
+    throw std::invalid_argument("integration: tolerances must be finite, non-negative and not both zero");
+  }
+  if (options.batch == 0 || options.sync_every == 0 || !(options.imbalance >= 1.0)) {
+    throw std::invalid_argument("integration: batch and sync_every must be positive and imbalance at least 1");
+  }
+  const auto finite = [](double bound) { return std::isfinite(bound); };
+  if (!std::ranges::all_of(lower, finite) || !std::ranges::all_of(upper, finite)) {
+    throw std::invalid_argument("integration: bounds must be finite");
+  }
+}
+
+namespace detail {
+
+GenzMalik MakeGenzMalik(std::size_t dim) {
+  const auto d = static_cast<double>(dim);
+  GenzMalik rule;
+  rule.lambda2 = std::sqrt(9.0 / 70.0);
+  rule.lambda4 = std::sqrt(9.0 / 10.0);
+  rule.lambda5 = std::sqrt(9.0 / 19.0);
+  rule.degree7 = {(12824.0 - (9120.0 * d) + (400.0 * d * d)) / 19683.0, 980.0 / 6561.0,
+                  (1820.0 - (400.0 * d)) / 19683.0, 200.0 / 19683.0,
+                  6859.0 / 19683.0 / std::ldexp(1.0, static_cast<int>(dim))};
+  rule.degree5 = {(729.0 - (950.0 * d) + (50.0 * d * d)) / 729.0, 245.0 / 486.0, (265.0 - (100.0 * d)) / 1458.0,
+                  25.0 / 729.0};
+  return rule;
+}
+
+int RebalancePartner(std::span<const double> errors, int rank, double imbalance, bool &donor) {
+  std::vector<int> order(errors.size());
+  std::iota(order.begin(), order.end(), 0);
+  std::ranges::stable_sort(order, [&](int a, int b) {
+    return errors[static_cast<std::size_t>(a)] > errors[static_cast<std::size_t>(b)];
+  });
+  for (std::size_t i = 0; i < order.size() / 2; i++) {
+    const int high = order[i];
+    const int low = order[order.size() - 1 - i];
+    if (errors[static_cast<std::size_t>(high)] <= imbalance * errors[static_cast<std::size_t>(low)]) {
+      // Every later pair is closer still.
+      break;
+    }
+    if (rank == high || rank == low) {
+      donor = rank == high;
+      return donor ? low : high;
+    }
+  }
+  return -1;
+}
+
+void ExchangeRegions(std::vector<double> &packed, int partner, bool donor, MPI_Comm comm) {
+  if (donor) {
+    MPI_Send(packed.data(), static_cast<int>(packed.size()), MPI_DOUBLE, partner, 0, comm);
+    return;
+  }
+  MPI_Status status;
+  MPI_Probe(partner, 0, comm, &status);
+  int count = 0;
+  MPI_Get_count(&status, MPI_DOUBLE, &count);
+  packed.resize(static_cast<std::size_t>(count));
+  MPI_Recv(packed.data(), count, MPI_DOUBLE, partner, 0, comm, MPI_STATUS_IGNORE);
+}
+
+}  // namespace detail
+
+}  // namespace ppc::integration
@@ -0,0 +1,75 @@
+#include "integration/include/integration.hpp"
+
+#include <mpi.h>
+
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace ppc::integration {
+
+std::string RuleToString(Rule rule) {
+  switch (rule) {
+    case Rule::kRectangle:
+      return "rectangle";
+    case Rule::kTrapezoid:
+      return "trapezoid";
+    case Rule::kSimpson:
+      return "simpson";
+  }
+  return "unknown";
+}
+
+Tuning &GetTuning() {
+  static Tuning tuning;
+  return tuning;
+}
+
+Axis MakeAxis(Rule rule, double lower, double upper, std::size_t steps) {
+  if (steps == 0) {
+    throw std::invalid_argument("integration: an axis needs at least one step");
+  }
+  if (!std::isfinite(lower) || !std::isfinite(upper)) {
+    throw std::invalid_argument("integration: bounds must be finite");
+  }
+  if (rule == Rule::kSimpson && steps % 2 != 0) {
+    throw std::invalid_argument("integration: Simpson's rule needs an even number of steps");
+  }
+  Axis axis;
+  axis.rule = rule;
+  axis.lower = lower;
+  axis.upper = upper;
+  axis.steps = steps;
+  axis.h = (upper - lower) / static_cast<double>(steps);
+  if (rule == Rule::kSimpson) {
+    axis.end_weight = axis.h / 3.0;
+    axis.odd_weight = 4.0 * axis.h / 3.0;
+    axis.even_weight = 2.0 * axis.h / 3.0;
+  } else {
+    axis.end_weight = axis.h / 2.0;
+    axis.odd_weight = axis.h;
+    axis.even_weight = axis.h;
+  }
+  return axis;
+}
+
+CompensatedSum SumOverRanks(const CompensatedSum &local, MPI_Comm comm) {
+  if (comm == MPI_COMM_NULL) {
+    return local;
+  }
+  int size = 1;
+  MPI_Comm_size(comm, &size);
+  const std::array<double, 2> mine = {local.sum, local.compensation};
+  std::vector<double> all(2 * static_cast<std::size_t>(size));
+  MPI_Allgather(mine.data(), 2, MPI_DOUBLE, all.data(), 2, MPI_DOUBLE, comm);
+  CompensatedSum total;
+  for (std::size_t r = 0; r < all.size(); r += 2) {
+    total.Merge({.sum = all[r], .compensation = all[r + 1]});
+  }
+  return total;
+}
+
+}  // namespace ppc::integration
@@ -0,0 +1,312 @@
+#include <gtest/gtest.h>
+#include <mpi.h>
+
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <numbers>
+#include <span>
+#include <stdexcept>
+#include <string>
+
+#include "integration/include/adaptive.hpp"
+#include "integration/include/integration.hpp"
+#include "integration/include/integration_task.hpp"
+#include "shared_memory/include/parallel_for.hpp"
+#include "task/include/task.hpp"
+#include "util/include/func_test_util.hpp"
+
+using ppc::integration::Backend;
+using ppc::integration::Domain;
+using ppc::integration::Rule;
+using ppc::task::TypeOfTask;
+
+namespace {
+
+constexpr std::array<Backend, 4> kAllBackends = {Backend::kSeq, Backend::kOmp, Backend::kTbb, Backend::kStl};
+constexpr std::array<Rule, 3> kAllRules = {Rule::kRectangle, Rule::kTrapezoid, Rule::kSimpson};
+
+/// prod_d cos(x_d); its integral over [0, 1]^kDim is sin(1)^kDim.
+template <std::size_t kDim>
+struct CosProduct {
+  double operator()(const std::array<double, kDim> &x) const {
+    double value = 1.0;
+    for (const double coordinate : x) {
+      value *= std::cos(coordinate);
+    }
+    return value;
+  }
+};
+
+/// CosProduct evaluated a batch at a time.
+template <std::size_t kDim>
+struct CosProductBatch {
+  void operator()(const ppc::integration::Batch<kDim> &batch, std::span<double> values) const {
+    for (std::size_t p = 0; p < batch.size; p++) {
+      values[p] = 1.0;
+      for (std::size_t d = 0; d < kDim; d++) {
+        values[p] *= std::cos(batch.x[d][p]);
+      }
+    }
+  }
+};
+
+/// exp(-100 |x - 0.3|^2): a peak that fixed grids under-resolve.
+template <std::size_t kDim>
+struct GaussianPeak {
+  double operator()(const std::array<double, kDim> &x) const {
+    double r2 = 0.0;
+    for (const double coordinate : x) {
+      r2 += (coordinate - 0.3) * (coordinate - 0.3);
+    }
+    return std::exp(-100.0 * r2);
+  }
+
+  static double Exact() {
+    const double axis = std::sqrt(std::numbers::pi) / 20.0 * (std::erf(7.0) + std::erf(3.0));
+    return std::pow(axis, static_cast<double>(kDim));
+  }
+};
+
+template <std::size_t kDim>
+std::array<double, kDim> Filled(double value) {
+  std::array<double, kDim> filled{};
+  filled.fill(value);
+  return filled;
+}
+
+template <std::size_t kDim>
+Domain<kDim> UnitCube(std::size_t steps) {
+  Domain<kDim> domain;
+  domain.lower.fill(0.0);
+  domain.upper.fill(1.0);
+  domain.steps.fill(steps);
+  return domain;
+}
+
+/// Restores the default tile size when a test that shrinks it ends.
+class SmallTiles {
+ public:
+  explicit SmallTiles(std::size_t tile) {
+    ppc::integration::GetTuning().tile = tile;
+  }
+  SmallTiles(const SmallTiles &) = delete;
+  SmallTiles &operator=(const SmallTiles &) = delete;
+  ~SmallTiles() {
+    ppc::integration::GetTuning() = {};
+  }
+};
+
+template <std::size_t kDim>
+void ExpectBackendsAgree(std::size_t steps, double tolerance) {
+  const double exact = std::pow(std::sin(1.0), static_cast<double>(kDim));
+  for (const Rule rule : kAllRules) {
+    const auto reference = ppc::integration::Integrate<kDim>(CosProduct<kDim>{}, UnitCube<kDim>(steps), {.rule = rule});
+    EXPECT_NEAR(reference.value, exact, tolerance) << kDim << "/" << ppc::integration::RuleToString(rule);
+    EXPECT_EQ(reference.evaluations, static_cast<std::size_t>(std::pow(
+                                         static_cast<double>(rule == Rule::kRectangle ? steps : steps + 1), kDim)));
+    for (const Backend backend : kAllBackends) {
+      SCOPED_TRACE(std::to_string(kDim) + "/" + ppc::integration::RuleToString(rule) + "/" +
+                   ppc::shared_memory::BackendToString(backend));
+      const auto result = ppc::integration::Integrate<kDim>(CosProduct<kDim>{}, UnitCube<kDim>(steps),
+                                                            {.rule = rule, .backend = backend});
+      EXPECT_EQ(result.value, reference.value);
+      const auto batched = ppc::integration::Integrate<kDim>(CosProductBatch<kDim>{}, UnitCube<kDim>(steps),
+                                                             {.rule = rule, .backend = backend});
+      EXPECT_EQ(batched.value, reference.value);
+    }
+  }
+}
+
+}  // namespace
+
+TEST(Integration, RulesAreExactForTheirDegreeAndConvergeAtTheirOrder) {
+  const Domain<1> domain{.lower = {-1.0}, .upper = {2.0}, .steps = {6}};
+  const auto line = [](const std::array<double, 1> &x) { return (3.0 * x[0]) - 1.0; };
+  const auto cubic = [](const std::array<double, 1> &x) { return x[0] * x[0] * x[0]; };
+  EXPECT_NEAR(ppc::integration::Integrate<1>(line, domain, {.rule = Rule::kRectangle}).value, 1.5, 1e-13);
+  EXPECT_NEAR(ppc::integration::Integrate<1>(line, domain, {.rule = Rule::kTrapezoid}).value, 1.5, 1e-13);
+  EXPECT_NEAR(ppc::integration::Integrate<1>(cubic, domain, {.rule = Rule::kSimpson}).value, 3.75, 1e-13);
+
+  // Doubling the steps divides the error by 4 for rectangles and trapezoids and by 16 for Simpson.
+  const double exact = std::sin(1.0) * std::sin(1.0);
+  for (const Rule rule : kAllRules) {
+    const auto error = [&](std::size_t steps) {
+      const auto result = ppc::integration::Integrate<2>(CosProduct<2>{}, UnitCube<2>(steps), {.rule = rule});
+      return std::abs(result.value - exact);
+    };
+    const double coarse = error(8);
+    const double fine = error(16);
+    const double order = rule == Rule::kSimpson ? 16.0 : 4.0;
+    EXPECT_NEAR(coarse / fine, order, 0.1 * order) << ppc::integration::RuleToString(rule);
+  }
+}
+
+TEST(Integration, EveryDimensionBackendAndIntegrandFormGivesTheSameBits) {
+  const SmallTiles tiles(97);
+  ExpectBackendsAgree<1>(1000, 1e-6);
+  ExpectBackendsAgree<2>(40, 1e-4);
+  ExpectBackendsAgree<3>(12, 3e-3);
+  ExpectBackendsAgree<4>(6, 1e-2);
+}
+
+TEST(Integration, CompensatedSumKeepsTheLowOrderBits) {
+  ppc::integration::CompensatedSum sum;
+  double naive = 0.0;
+  sum.Add(1.0);
+  naive += 1.0;
+  for (int i = 0; i < 1000000; i++) {
+    sum.Add(1e-16);
+    naive += 1e-16;
+  }
+  sum.Add(-1.0);
+  naive -= 1.0;
+  EXPECT_NEAR(sum.Value(), 1e-10, 1e-18);
+  EXPECT_EQ(naive, 0.0);
+}
+
+TEST(Integration, RejectsInvalidAxes) {
+  const auto one = [](const std::array<double, 2> &) { return 1.0; };
+  EXPECT_THROW((void)ppc::integration::Integrate<2>(one, Domain<2>{.lower = {0, 0}, .upper = {1, 1}, .steps = {4, 0}}),
+               std::invalid_argument);
+  EXPECT_THROW((void)ppc::integration::Integrate<2>(one, Domain<2>{.lower = {0, 0}, .upper = {1, 1}, .steps = {4, 3}}),
+               std::invalid_argument);
+  const Domain<2> unbounded{.lower = {0, 0}, .upper = {1, INFINITY}, .steps = {4, 4}};
+  EXPECT_THROW((void)ppc::integration::Integrate<2>(one, unbounded, {.rule = Rule::kTrapezoid}), std::invalid_argument);
+  // Reversed bounds flip the sign, as for a one-dimensional integral.
+  EXPECT_NEAR(ppc::integration::Integrate<2>(one, Domain<2>{.lower = {1, 0}, .upper = {0, 2}, .steps = {3, 3}},
+                                             {.rule = Rule::kRectangle})
+                  .value,
+              -2.0, 1e-14);
+}
+
+TEST(Integration, DistributedTilesMatchTheSharedMemoryIntegral) {
+  if (!ppc::util::MpiReady()) {
+    GTEST_SKIP() << "MPI is not initialized";
+  }
+  const SmallTiles tiles(61);
+  for (const Rule rule : kAllRules) {
+    const auto whole = ppc::integration::Integrate<3>(CosProduct<3>{}, UnitCube<3>(14), {.rule = rule});
+    for (const Backend backend : kAllBackends) {
+      const auto result = ppc::integration::Integrate<3>(CosProduct<3>{}, UnitCube<3>(14),
+                                                         {.rule = rule, .backend = backend}, MPI_COMM_WORLD);
+      EXPECT_NEAR(result.value, whole.value, 1e-15);
+      EXPECT_EQ(result.evaluations, whole.evaluations);
+    }
+  }
+}
+
+template <TypeOfTask kType, Rule kRule>
+void RunIntegrationTask() {
+  ppc::integration::IntegrationTask<2, CosProduct<2>, kType, kRule> task(UnitCube<2>(64));
+  ASSERT_TRUE(task.Validation());
+  ASSERT_TRUE(task.PreProcessing());
+  ASSERT_TRUE(task.Run());
+  ASSERT_TRUE(task.PostProcessing());
+  EXPECT_NEAR(task.GetOutput().value, std::sin(1.0) * std::sin(1.0), 1e-4);
+}
+
+TEST(Integration, TasksIntegrateOnEveryBackend) {
+  RunIntegrationTask<TypeOfTask::kSEQ, Rule::kSimpson>();
+  RunIntegrationTask<TypeOfTask::kOMP, Rule::kTrapezoid>();
+  RunIntegrationTask<TypeOfTask::kTBB, Rule::kRectangle>();
+  RunIntegrationTask<TypeOfTask::kSTL, Rule::kSimpson>();
+  if (ppc::util::MpiReady()) {
+    RunIntegrationTask<TypeOfTask::kMPI, Rule::kSimpson>();
+    RunIntegrationTask<TypeOfTask::kMPI, Rule::kRectangle>();
+  }
+}
+
+TEST(Integration, AdaptiveRulesAreExactForTheirDegree) {
+  // Genz-Malik 7-5 integrates degree 5 exactly with a zero error estimate: one region suffices.
+  const auto quintic = [](const std::array<double, 3> &x) { return (x[0] * x[0] * x[0] * x[1] * x[1]) + x[2]; };
+  const auto gm = ppc::integration::IntegrateAdaptive<3>(quintic, {0, 0, 0}, {1, 2, 3});
+  EXPECT_TRUE(gm.converged);
+  EXPECT_EQ(gm.steps, 0U);
+  EXPECT_EQ(gm.evaluations, ppc::integration::RulePoints(3));
+  EXPECT_NEAR(gm.value, (0.25 * 8.0 / 3.0 * 3.0) + (2.0 * 4.5), 1e-12);
+  // Gauss-Kronrod resolves the endpoint singularity of sqrt(x) by refining towards 0.
+  const auto root = [](const std::array<double, 1> &x) { return std::sqrt(x[0]); };
+  const auto gk =
+      ppc::integration::IntegrateAdaptive<1>(root, {0.0}, {1.0}, {.abs_tolerance = 1e-12, .rel_tolerance = 0.0});
+  EXPECT_TRUE(gk.converged);
+  EXPECT_NEAR(gk.value, 2.0 / 3.0, 1e-11);
+  EXPECT_LE(gk.error, 1e-12);
+}
+
+TEST(Integration, AdaptivePeakIsTheSameBitsOnEveryBackend) {
+  ppc::integration::AdaptiveOptions options{.abs_tolerance = 1e-9, .rel_tolerance = 0.0, .batch = 16};
+  const auto reference =
+      ppc::integration::IntegrateAdaptive<3>(GaussianPeak<3>{}, Filled<3>(0.0), Filled<3>(1.0), options);
+  EXPECT_TRUE(reference.converged);
+  EXPECT_NEAR(reference.value, GaussianPeak<3>::Exact(), 1e-9);
+  EXPECT_LE(reference.error, 1e-9);
+  // Every bisection replaces one region by two freshly evaluated ones.
+  EXPECT_EQ(reference.evaluations, ((2 * reference.regions) - 1) * ppc::integration::RulePoints(3));
+  for (const Backend backend : kAllBackends) {
+    options.backend = backend;
+    const auto result =
+        ppc::integration::IntegrateAdaptive<3>(GaussianPeak<3>{}, Filled<3>(0.0), Filled<3>(1.0), options);
+    EXPECT_EQ(result.value, reference.value) << ppc::shared_memory::BackendToString(backend);
+    EXPECT_EQ(result.regions, reference.regions);
+  }
+  // A budget too small for the tolerance stops unconverged.
+  options.max_evaluations = 2000;
+  const auto capped =
+      ppc::integration::IntegrateAdaptive<3>(GaussianPeak<3>{}, Filled<3>(0.0), Filled<3>(1.0), options);
+  EXPECT_FALSE(capped.converged);
+  EXPECT_GT(capped.error, 1e-9);
+
+  EXPECT_THROW((void)ppc::integration::IntegrateAdaptive<3>(GaussianPeak<3>{}, Filled<3>(0.0), Filled<3>(1.0),
+                                                            {.abs_tolerance = 0.0, .rel_tolerance = 0.0}),
+               std::invalid_argument);
+  EXPECT_THROW((void)ppc::integration::IntegrateAdaptive<3>(GaussianPeak<3>{}, Filled<3>(0.0), Filled<3>(1.0),
+                                                            {.batch = 0}),
+               std::invalid_argument);
+}
+
+TEST(Integration, AdaptiveRanksRebalanceTowardsThePeak) {
+  if (!ppc::util::MpiReady()) {
+    GTEST_SKIP() << "MPI is not initialized";
+  }
+  int size = 1;
+  MPI_Comm_size(MPI_COMM_WORLD, &size);
+  const ppc::integration::AdaptiveOptions options{
+      .abs_tolerance = 1e-9, .rel_tolerance = 0.0, .batch = 8, .sync_every = 4, .backend = Backend::kStl};
+  const auto result = ppc::integration::IntegrateAdaptive<2>(GaussianPeak<2>{}, Filled<2>(0.0), Filled<2>(1.0),
+                                                             options, MPI_COMM_WORLD);
+  EXPECT_TRUE(result.converged);
+  EXPECT_NEAR(result.value, GaussianPeak<2>::Exact(), 1e-9);
+  // The peak lies in the first slab, so with several ranks the others must receive regions from it.
+  std::size_t migrated = result.migrated;
+  MPI_Allreduce(MPI_IN_PLACE, &migrated, 1, MPI_UINT64_T, MPI_SUM, MPI_COMM_WORLD);
+  if (size > 1) {
+    EXPECT_GT(migrated, 0U);
+  }
+}
+
+template <TypeOfTask kType>
+void RunAdaptiveTask() {
+  const ppc::integration::AdaptiveProblem<2> problem{.lower = {0.0, 0.0},
+                                                     .upper = {1.0, 1.0},
+                                                     .abs_tolerance = 1e-8,
+                                                     .rel_tolerance = 0.0,
+                                                     .max_evaluations = 1U << 22};
+  ppc::integration::AdaptiveIntegrationTask<2, GaussianPeak<2>, kType> task(problem);
+  ASSERT_TRUE(task.Validation());
+  ASSERT_TRUE(task.PreProcessing());
+  ASSERT_TRUE(task.Run());
+  ASSERT_TRUE(task.PostProcessing());
+  EXPECT_TRUE(task.GetOutput().converged);
+  EXPECT_NEAR(task.GetOutput().value, GaussianPeak<2>::Exact(), 1e-8);
+}
+
+TEST(Integration, AdaptiveTasksIntegrateOnEveryBackend) {
+  RunAdaptiveTask<TypeOfTask::kSEQ>();
+  RunAdaptiveTask<TypeOfTask::kOMP>();
+  RunAdaptiveTask<TypeOfTask::kTBB>();
+  RunAdaptiveTask<TypeOfTask::kSTL>();
+  if (ppc::util::MpiReady()) {
+    RunAdaptiveTask<TypeOfTask::kMPI>();
+  }
+}
@@ -0,0 +1,135 @@
+#pragma once
+
+#include <mpi.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <vector>
+
+#include "geometry/include/hull.hpp"
+#include "image/include/image.hpp"
+#include "shared_memory/include/parallel_for.hpp"
+
+namespace ppc::labelling {
+
+using Backend = ppc::shared_memory::Backend;
+using Image = ppc::image::Image;
+
+/// @brief Pixels a foreground pixel is connected to.
+enum class Connectivity : uint8_t {
+  /// The pixels left, right, above and below
+  kFour,
+  /// The four of kFour and the four diagonal pixels
+  kEight
+};
+
+/// @brief Returns the lower-case name of the connectivity ("four", "eight").
+std::string ConnectivityToString(Connectivity connectivity);
+
+struct Options {
+  Connectivity connectivity = Connectivity::kEight;
+  Backend backend = Backend::kSeq;
+};
+
+struct Tuning {
+  /// Rows of a tile; the tiles are labelled independently and merged along their top rows.
+  std::size_t tile_rows = 32;
+};
+
+/// @brief Returns the tuning shared by all kernels of this module.
+Tuning &GetTuning();
+
+/// @brief Component label of every pixel: 0 for the background, 1 to count for the components,
+/// numbered in the raster order of their first pixel.
+struct Labels {
+  std::size_t width = 0;
+  std::size_t height = 0;
+  std::vector<std::uint32_t> labels;
+  std::size_t count = 0;
+
+  [[nodiscard]] std::uint32_t At(std::size_t x, std::size_t y) const {
+    return labels[(y * width) + x];
+  }
+
+  friend bool operator==(const Labels &, const Labels &) = default;
+};
+
+/// @brief Smallest rectangle holding every pixel of a component.
+struct BoundingBox {
+  std::size_t x0 = 0;
+  std::size_t y0 = 0;
+  std::size_t width = 0;
+  std::size_t height = 0;
+
+  friend bool operator==(const BoundingBox &, const BoundingBox &) = default;
+};
+
+/// @brief Bounding box and pixels of every component; component c (label c + 1) owns the raster
+/// indices y * width + x in pixels[offsets[c], offsets[c + 1]), in raster order.
+struct Components {
+  std::size_t width = 0;
+  std::vector<BoundingBox> boxes;
+  std::vector<std::size_t> offsets = {0};
+  std::vector<std::size_t> pixels;
+
+  [[nodiscard]] std::size_t Size() const {
+    return boxes.size();
+  }
+  [[nodiscard]] std::span<const std::size_t> Pixels(std::size_t component) const {
+    return std::span<const std::size_t>(pixels).subspan(offsets[component],
+                                                        offsets[component + 1] - offsets[component]);
+  }
+
+  friend bool operator==(const Components &, const Components &) = default;
+};
+
+/// @brief Binary image of @p width x @p height: every pixel is foreground (255) with probability
+/// @p density.
+Image RandomMask(std::size_t width, std::size_t height, double density, std::uint64_t seed);
+
+/// @brief Binary image of the first channel of @p image: foreground (255) where the sample is at
+/// least @p level.
+Image Threshold(const Image &image, std::uint8_t level);
+
+/// @brief Labels the connected components of the non-zero pixels of the one-channel @p mask.
+/// @details Two passes over tiles of Tuning::tile_rows rows. The first pass scans every tile on
+/// its own with the decision tree of Wu, Otoo and Suzuki, which visits the fewest neighbours
+/// (one when the pixel above is foreground), and records equivalences in a union-find over the
+/// raster indices that always links the larger root under the smaller. The top rows of the tiles
+/// are then merged with the row above in parallel, with compare-and-swap unions that need no
+/// lock. The second pass counts the roots of every tile, numbers them and resolves every pixel.
+/// The result is the same on every back-end and for every tile size.
+/// @throws std::invalid_argument When @p mask is invalid, has more than one channel or 2^32 or
+/// more pixels.
+Labels Label(const Image &mask, const Options &options = {});
+
+/// @brief Bounding boxes and pixel lists of the components of @p labels.
+/// @details The pixels are bucketed by component in parallel (counts per block of rows, then a
+/// scatter), and the boxes are taken from the buckets.
+Components CollectComponents(const Labels &labels, Backend backend = Backend::kSeq);
+
+/// @brief Points whose per-component convex hulls, by ppc::geometry::ComponentHulls(), are the
+/// hulls of the pixel centres of the components.
+/// @details Only the first and last pixel of every row of a component are kept: the others lie
+/// between them.
+ppc::geometry::LabelledPoints HullInput(const Components &components);
+
+/// @brief Labels a @p width x @p height mask split over the ranks of @p comm in row strips.
+/// @details Rank r holds the BlockRange(height, size, r) share of the rows in @p local and labels
+/// it with Label(). The labels are offset by the components of the ranks before; every strip
+/// receives the last row of the nearest non-empty strip above and pairs the labels its top row
+/// touches there. The pairs of all ranks are gathered and joined in a union-find over the labels
+/// they name only, and every rank renumbers its strip in the raster order of the whole mask.
+/// @return The labels of the strip of the rank, with the count of the whole mask; the same as
+/// the rows of Label() of the whole mask.
+/// @throws std::invalid_argument On every rank when a strip does not match its share or is
+/// invalid.
+Labels DistributedLabel(const Image &local, std::size_t width, std::size_t height, const Options &options,
+                        MPI_Comm comm);
+
+/// @brief Assembles the labels of the whole mask on every rank from the strip of each in @p local.
+Labels AllGatherLabels(const Labels &local, std::size_t height, MPI_Comm comm);
+
+}  // namespace ppc::labelling
@@ -0,0 +1,74 @@
+#pragma once
+
+#include <mpi.h>
+
+#include "image/include/image.hpp"
+#include "labelling/include/labelling.hpp"
+#include "shared_memory/include/parallel_for.hpp"
+#include "shared_memory/include/shared_memory.hpp"
+#include "task/include/task.hpp"
+
+namespace ppc::labelling {
+
+/// @brief Connected components of a binary image, with their bounding boxes and pixel lists, as a
+/// course task on any back-end.
+/// @details The kMPI variant crops the row strip of its rank in PreProcessing, runs
+/// DistributedLabel() and assembles the labels on every rank before collecting the components;
+/// every rank holds the whole input, as in the course tasks.
+template <ppc::task::TypeOfTask kType, Connectivity kConnectivity = Connectivity::kEight>
+class LabellingTask : public ppc::task::Task<Image, Components> {
+ public:
+  using InType = Image;
+  using OutType = Components;
+
+  static constexpr ppc::task::TypeOfTask GetStaticTypeOfTask() {
+    return kType;
+  }
+
+  explicit LabellingTask(const InType &in) {
+    this->SetTypeOfTask(GetStaticTypeOfTask());
+    this->GetInput() = in;
+  }
+
+ private:
+  bool ValidationImpl() override {
+    const InType &in = this->GetInput();
+    return ppc::image::IsValid(in) && in.channels == 1 && in.width > 0 && in.height > 0;
+  }
+
+  bool PreProcessingImpl() override {
+    if constexpr (kType == ppc::task::TypeOfTask::kMPI) {
+      int rank = 0;
+      int size = 1;
+      MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+      MPI_Comm_size(MPI_COMM_WORLD, &size);
+      const InType &in = this->GetInput();
+      const auto [begin, end] = ppc::shared_memory::BlockRange(in.height, size, rank);
+      local_ = ppc::image::Crop(in, 0, begin, in.width, end - begin);
+    }
+    return true;
+  }
+
+  bool RunImpl() override {
+    const InType &in = this->GetInput();
+    Options options;
+    options.connectivity = kConnectivity;
+    options.backend = ppc::shared_memory::BackendOf(kType);
+    if constexpr (kType != ppc::task::TypeOfTask::kMPI) {
+      this->GetOutput() = CollectComponents(Label(in, options), options.backend);
+    } else {
+      const Labels strip = DistributedLabel(local_, in.width, in.height, options, MPI_COMM_WORLD);
+      this->GetOutput() = CollectComponents(AllGatherLabels(strip, in.height, MPI_COMM_WORLD), options.backend);
+    }
+    return true;
+  }
+
+  bool PostProcessingImpl() override {
+    const OutType &out = this->GetOutput();
+    return out.width == this->GetInput().width && out.offsets.size() == out.Size() + 1;
+  }
+
+  Image local_;
+};
+
+}  // namespace ppc::labelling
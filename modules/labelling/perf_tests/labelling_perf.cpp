@@ -0,0 +1,95 @@
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <tuple>
+
+#include "image/include/image.hpp"
+#include "labelling/include/labelling.hpp"
+#include "labelling/include/labelling_task.hpp"
+#include "task/include/task.hpp"
+#include "util/include/perf_test_util.hpp"
+
+namespace ppc::labelling::perf {
+
+using ppc::task::TypeOfTask;
+
+namespace {
+
+constexpr std::size_t kSide = 2048;
+
+/// Masks of 2048 x 2048 pixels, shared by the cases of a suite.
+enum class Mask : std::uint8_t {
+  /// Uniform noise of density 1/2: many small components and long merge chains across tiles
+  kNoise,
+  /// The thresholded test picture: a few large blobs
+  kBlobs
+};
+
+template <Mask kMask>
+const Image &MaskImage() {
+  static const Image kImage =
+      kMask == Mask::kNoise
+          ? RandomMask(kSide, kSide, 0.5, 1)
+          : Threshold(ppc::image::TestPattern(kSide, kSide, 1, ppc::image::Layout::kInterleaved, 1), 128);
+  return kImage;
+}
+
+}  // namespace
+
+/// Reports megapixels per second, with the number of components.
+template <Mask kMask>
+class LabellingPerfTests : public ppc::util::BaseRunPerfTests<Image, Components> {
+  bool CheckTestOutputData(Components &output_data) final {
+    PrintRate("mpixels_per_s", static_cast<double>(kSide * kSide) / 1e6);
+    PrintValue("components", static_cast<double>(output_data.Size()));
+    return output_data.width == kSide && output_data.Size() > 0;
+  }
+
+  Image GetTestInputData() final {
+    return MaskImage<kMask>();
+  }
+};
+
+/// LabellingTask of every back-end for one connectivity.
+template <Connectivity kConnectivity>
+struct PerfLabellingTasks {
+  template <TypeOfTask kType>
+  using Task = LabellingTask<kType, kConnectivity>;
+};
+
+template <Connectivity kConnectivity>
+auto MakeBackendSuite(const std::string &mask) {
+  return ppc::util::MakeBackendPerfTaskTuples<PerfLabellingTasks<kConnectivity>::template Task, Image>(
+      "ppc_labelling", ConnectivityToString(kConnectivity) + "_" + mask);
+}
+
+namespace {
+
+auto MakeMaskSuite(const std::string &mask) {
+  return std::tuple_cat(MakeBackendSuite<Connectivity::kFour>(mask), MakeBackendSuite<Connectivity::kEight>(mask));
+}
+
+}  // namespace
+
+using NoisePerfTests = LabellingPerfTests<Mask::kNoise>;
+using BlobsPerfTests = LabellingPerfTests<Mask::kBlobs>;
+
+TEST_P(NoisePerfTests, RunPerfModes) {
+  ExecuteTest(GetParam());
+}
+
+TEST_P(BlobsPerfTests, RunPerfModes) {
+  ExecuteTest(GetParam());
+}
+
+const auto kNoisePerfTasks = MakeMaskSuite("noise");
+const auto kBlobsPerfTasks = MakeMaskSuite("blobs");
+
+INSTANTIATE_TEST_SUITE_P(LabellingNoise, NoisePerfTests, ppc::util::TupleToGTestValues(kNoisePerfTasks),
+                         NoisePerfTests::CustomPerfTestName);
+INSTANTIATE_TEST_SUITE_P(LabellingBlobs, BlobsPerfTests, ppc::util::TupleToGTestValues(kBlobsPerfTasks),
+                         BlobsPerfTests::CustomPerfTestName);
+
+}  // namespace ppc::labelling::perf
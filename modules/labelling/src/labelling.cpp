@@ -0,0 +1,527 @@
+#include "labelling/include/labelling.hpp"
+
+#include <mpi.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "geometry/include/geometry.hpp"
+#include "geometry/include/hull.hpp"
+#include "image/include/image.hpp"
+#include "shared_memory/include/parallel_for.hpp"
+#include "shared_memory/include/shared_memory.hpp"
+
+namespace ppc::labelling {
+
+namespace {
+
+using ppc::shared_memory::ParallelFor;
+
+/// Union-find over the raster indices; a root is its own parent and every parent is smaller than
+/// its child, so that the root of a component is its first pixel.
+using Parent = std::vector<std::atomic<std::uint32_t>>;
+
+std::uint32_t Find(Parent &parent, std::uint32_t node) {
+  while (true) {
+    const std::uint32_t up = parent[node].load(std::memory_order_relaxed);
+    if (up == node) {
+      return node;
+    }
+    // Path halving: only a non-root is rewritten, and only to one of its ancestors.
+    const std::uint32_t next = parent[up].load(std::memory_order_relaxed);
+    if (next != up) {
+      parent[node].store(next, std::memory_order_relaxed);
+    }
+    node = next;
+  }
+}
+
+/// Links the larger root under the smaller one; a failed compare-and-swap means another worker
+/// linked that root meanwhile, and the roots are looked up again.
+void Union(Parent &parent, std::uint32_t a, std::uint32_t b) {
+  while (true) {
+    a = Find(parent, a);
+    b = Find(parent, b);
+    if (a == b) {
+      return;
+    }
+    if (a < b) {
+      std::swap(a, b);
+    }
+    std::uint32_t expected = a;
+    if (parent[a].compare_exchange_strong(expected, b, std::memory_order_relaxed)) {
+      return;
+    }
+  }
+}
+
+/// First pass over rows [y0, y1): every foreground pixel is linked to one earlier neighbour of the
+/// tile or made a root, with the equivalences the decision tree finds merged.
+void ScanTile(const Image &mask, Parent &parent, std::size_t y0, std::size_t y1, Connectivity connectivity) {
+  const std::size_t width = mask.width;
+  const std::uint8_t *pixels = mask.pixels.data();
+  // A pixel takes the parent of its neighbour, an ancestor in the same tile, so that the chains
+  // along a run stay short.
+  const auto link = [&](std::size_t pixel, std::size_t target) {
+    const std::uint32_t up =
+        target == pixel ? static_cast<std::uint32_t>(pixel) : parent[target].load(std::memory_order_relaxed);
+    parent[pixel].store(up, std::memory_order_relaxed);
+  };
+  const auto merge = [&](std::size_t a, std::size_t b) {
+    Union(parent, static_cast<std::uint32_t>(a), static_cast<std::uint32_t>(b));
+  };
+  for (std::size_t x = 0, p = y0 * width; x < width; x++, p++) {
+    if (pixels[p] != 0) {
+      link(p, x > 0 && pixels[p - 1] != 0 ? p - 1 : p);
+    }
+  }
+  for (std::size_t y = y0 + 1; y < y1; y++) {
+    const std::uint8_t *row = pixels + (y * width);
+    const std::uint8_t *up = row - width;
+    for (std::size_t x = 0; x < width; x++) {
+      if (row[x] == 0) {
+        continue;
+      }
+      const std::size_t p = (y * width) + x;
+      const bool left = x > 0;
+      const bool right = x + 1 < width;
+      if (connectivity == Connectivity::kFour) {
+        if (up[x] != 0) {
+          // The left pixel already joined the one above through the pixel above it.
+          if (left && row[x - 1] != 0 && up[x - 1] == 0) {
+            merge(p - width, p - 1);
+          }
+          link(p, p - width);
+        } else {
+          link(p, left && row[x - 1] != 0 ? p - 1 : p);
+        }
+        continue;
+      }
+      // Wu, Otoo and Suzuki: the pixel above touches all other neighbours; the upper right one
+      // touches neither the upper left nor the left one, which touch each other.
+      if (up[x] != 0) {
+        link(p, p - width);
+      } else if (right && up[x + 1] != 0) {
+        if (left && up[x - 1] != 0) {
+          merge(p - width + 1, p - width - 1);
+        } else if (left && row[x - 1] != 0) {
+          merge(p - width + 1, p - 1);
+        }
+        link(p, p - width + 1);
+      } else if (left && up[x - 1] != 0) {
+        link(p, p - width - 1);
+      } else {
+        link(p, left && row[x - 1] != 0 ? p - 1 : p);
+      }
+    }
+  }
+}
+
+/// Merges the top row @p y of a tile with the row above, which belongs to another tile.
+void MergeBorder(const Image &mask, Parent &parent, std::size_t y, Connectivity connectivity) {
+  const std::size_t width = mask.width;
+  const std::uint8_t *row = mask.pixels.data() + (y * width);
+  const std::uint8_t *up = row - width;
+  const auto merge = [&](std::size_t a, std::size_t b) {
+    Union(parent, static_cast<std::uint32_t>(a), static_cast<std::uint32_t>(b));
+  };
+  for (std::size_t x = 0; x < width; x++) {
+    if (row[x] == 0) {
+      continue;
+    }
+    const std::size_t p = (y * width) + x;
+    if (up[x] != 0) {
+      // A run under a run joins once.
+      if (x == 0 || row[x - 1] == 0 || up[x - 1] == 0) {
+        merge(p, p - width);
+      }
+    } else if (connectivity == Connectivity::kEight) {
+      if (x > 0 && up[x - 1] != 0) {
+        merge(p, p - width - 1);
+      }
+      if (x + 1 < width && up[x + 1] != 0) {
+        merge(p, p - width + 1);
+      }
+    }
+  }
+}
+
+void CheckMask(const Image &mask, const char *caller) {
+  if (!ppc::image::IsValid(mask) || mask.channels != 1) {
+    throw std::invalid_argument(std::string(caller) + ": the mask is not a valid one-channel image");
+  }
+  if (mask.width * mask.height > std::numeric_limits<std::uint32_t>::max()) {
+    throw std::invalid_argument(std::string(caller) + ": the mask has 2^32 or more pixels");
+  }
+}
+
+/// Equivalences between labels, joined in a union-find over the labels they name; every other
+/// label is its own component.
+class LabelMerger {
+ public:
+  explicit LabelMerger(const std::vector<std::uint32_t> &pairs) : named_(pairs) {
+    std::ranges::sort(named_);
+    named_.erase(std::ranges::unique(named_).begin(), named_.end());
+    parent_.resize(named_.size());
+    for (std::size_t i = 0; i < parent_.size(); i++) {
+      parent_[i] = i;
+    }
+    for (std::size_t i = 0; i + 1 < pairs.size(); i += 2) {
+      std::size_t a = Root(IndexOf(pairs[i]));
+      std::size_t b = Root(IndexOf(pairs[i + 1]));
+      if (a != b) {
+        parent_[std::max(a, b)] = std::min(a, b);
+      }
+    }
+    for (std::size_t i = 0; i < named_.size(); i++) {
+      if (Root(i) != i) {
+        merged_.push_back(named_[i]);
+      }
+    }
+  }
+
+  /// Components of labels 1 to @p total.
+  [[nodiscard]] std::size_t Count(std::size_t total) const {
+    return total - merged_.size();
+  }
+
+  /// Final label of @p label: that of the smallest label of its component, less the merged labels
+  /// below it.
+  std::uint32_t Renumber(std::uint32_t label) {
+    const auto named = std::ranges::lower_bound(named_, label);
+    if (named != named_.end() && *named == label) {
+      label = named_[Root(static_cast<std::size_t>(named - named_.begin()))];
+    }
+    const auto below = std::ranges::lower_bound(merged_, label) - merged_.begin();
+    return label - static_cast<std::uint32_t>(below);
+  }
+
+ private:
+  [[nodiscard]] std::size_t IndexOf(std::uint32_t label) const {
+    return static_cast<std::size_t>(std::ranges::lower_bound(named_, label) - named_.begin());
+  }
+
+  std::size_t Root(std::size_t index) {
+    while (parent_[index] != index) {
+      parent_[index] = parent_[parent_[index]];
+      index = parent_[index];
+    }
+    return index;
+  }
+
+  std::vector<std::uint32_t> named_;
+  std::vector<std::size_t> parent_;
+  std::vector<std::uint32_t> merged_;
+};
+
+}  // namespace
+
+std::string ConnectivityToString(Connectivity connectivity) {
+  switch (connectivity) {
+    case Connectivity::kFour:
+      return "four";
+    case Connectivity::kEight:
+      return "eight";
+  }
+  return "unknown";
+}
+
+Tuning &GetTuning() {
+  static Tuning tuning;
+  return tuning;
+}
+
+Image RandomMask(std::size_t width, std::size_t height, double density, std::uint64_t seed) {
+  std::mt19937_64 gen(seed);
+  std::bernoulli_distribution foreground(density);
+  Image mask = ppc::image::MakeImage(width, height, 1);
+  for (std::uint8_t &pixel : mask.pixels) {
+    pixel = foreground(gen) ? 255 : 0;
+  }
+  return mask;
+}
+
+Image Threshold(const Image &image, std::uint8_t level) {
+  Image mask = ppc::image::MakeImage(image.width, image.height, 1);
+  for (std::size_t y = 0; y < image.height; y++) {
+    for (std::size_t x = 0; x < image.width; x++) {
+      mask.At(x, y, 0) = image.At(x, y, 0) >= level ? 255 : 0;
+    }
+  }
+  return mask;
+}
+
+Labels Label(const Image &mask, const Options &options) {
+  CheckMask(mask, "Label");
+  const std::size_t width = mask.width;
+  const std::size_t height = mask.height;
+  Labels result{.width = width, .height = height, .labels = std::vector<std::uint32_t>(width * height, 0), .count = 0};
+  if (width == 0 || height == 0) {
+    return result;
+  }
+  const std::size_t tile_rows = std::max<std::size_t>(GetTuning().tile_rows, 1);
+  const std::size_t tiles = (height + tile_rows - 1) / tile_rows;
+  const auto rows_of = [&](std::size_t tile) {
+    return std::pair{tile * tile_rows, std::min(height, (tile + 1) * tile_rows)};
+  };
+
+  Parent parent(width * height);
+  ParallelFor(tiles, options.backend, [&](std::size_t tile) {
+    const auto [y0, y1] = rows_of(tile);
+    ScanTile(mask, parent, y0, y1, options.connectivity);
+  });
+  ParallelFor(tiles - 1, options.backend,
+              [&](std::size_t tile) { MergeBorder(mask, parent, (tile + 1) * tile_rows, options.connectivity); });
+
+  // Second pass: roots per tile, numbered in raster order, then every pixel takes its root's label.
+  const std::uint8_t *pixels = mask.pixels.data();
+  std::vector<std::uint32_t> first(tiles + 1, 0);
+  ParallelFor(tiles, options.backend, [&](std::size_t tile) {
+    const auto [y0, y1] = rows_of(tile);
+    std::uint32_t roots = 0;
+    for (std::size_t p = y0 * width; p < y1 * width; p++) {
+      roots += static_cast<std::uint32_t>(pixels[p] != 0 && parent[p].load(std::memory_order_relaxed) == p);
+    }
+    first[tile + 1] = roots;
+  });
+  first[0] = 1;
+  for (std::size_t tile = 0; tile < tiles; tile++) {
+    first[tile + 1] += first[tile];
+  }
+  std::vector<std::uint32_t> &labels = result.labels;
+  ParallelFor(tiles, options.backend, [&](std::size_t tile) {
+    const auto [y0, y1] = rows_of(tile);
+    std::uint32_t next = first[tile];
+    for (std::size_t p = y0 * width; p < y1 * width; p++) {
+      if (pixels[p] != 0 && parent[p].load(std::memory_order_relaxed) == p) {
+        labels[p] = next++;
+      }
+    }
+  });
+  ParallelFor(tiles, options.backend, [&](std::size_t tile) {
+    const auto [y0, y1] = rows_of(tile);
+    for (std::size_t y = y0; y < y1; y++) {
+      for (std::size_t x = 0, p = y * width; x < width; x++, p++) {
+        if (pixels[p] == 0 || labels[p] != 0) {
+          continue;
+        }
+        // The left pixel of a run is resolved already and always in the same component.
+        labels[p] = x > 0 && pixels[p - 1] != 0 ? labels[p - 1] : labels[Find(parent, static_cast<std::uint32_t>(p))];
+      }
+    }
+  });
+  result.count = first[tiles] - 1;
+  return result;
+}
+
+Components CollectComponents(const Labels &labels, Backend backend) {
+  const std::size_t width = labels.width;
+  const std::size_t count = labels.count;
+  const auto parts = static_cast<std::size_t>(ppc::shared_memory::BackendWorkers(backend));
+  const auto rows_of = [&](std::size_t part) {
+    const auto [begin, end] =
+        ppc::shared_memory::BlockRange(labels.height, static_cast<int>(parts), static_cast<int>(part));
+    return std::pair{begin * width, end * width};
+  };
+  // Bucket by component: counts per block, offsets component-major so that every block scatters
+  // its pixels of a component after those of the blocks before it.
+  std::vector<std::size_t> offsets(parts * count, 0);
+  ParallelFor(parts, backend, [&](std::size_t part) {
+    const auto [begin, end] = rows_of(part);
+    for (std::size_t p = begin; p < end; p++) {
+      if (labels.labels[p] != 0) {
+        offsets[(part * count) + labels.labels[p] - 1]++;
+      }
+    }
+  });
+  Components components{.width = width,
+                        .boxes = std::vector<BoundingBox>(count),
+                        .offsets = std::vector<std::size_t>(count + 1, 0),
+                        .pixels = {}};
+  std::size_t running = 0;
+  for (std::size_t component = 0; component < count; component++) {
+    components.offsets[component] = running;
+    for (std::size_t part = 0; part < parts; part++) {
+      const std::size_t pixels = offsets[(part * count) + component];
+      offsets[(part * count) + component] = running;
+      running += pixels;
+    }
+  }
+  components.offsets[count] = running;
+  components.pixels.resize(running);
+  ParallelFor(parts, backend, [&](std::size_t part) {
+    const auto [begin, end] = rows_of(part);
+    for (std::size_t p = begin; p < end; p++) {
+      if (labels.labels[p] != 0) {
+        components.pixels[offsets[(part * count) + labels.labels[p] - 1]++] = p;
+      }
+    }
+  });
+  ParallelFor(parts, backend, [&](std::size_t part) {
+    const auto [begin, end] = ppc::shared_memory::BlockRange(count, static_cast<int>(parts), static_cast<int>(part));
+    for (std::size_t component = begin; component < end; component++) {
+      const std::span<const std::size_t> pixels = components.Pixels(component);
+      const std::size_t y0 = pixels[0] / width;
+      std::size_t y = y0;
+      std::size_t x0 = width;
+      std::size_t x1 = 0;
+      // The pixels ascend, so that a division is only needed on a new row.
+      for (const std::size_t p : pixels) {
+        if (p >= (y + 1) * width) {
+          y = p / width;
+        }
+        x0 = std::min(x0, p - (y * width));
+        x1 = std::max(x1, p - (y * width));
+      }
+      components.boxes[component] = {.x0 = x0, .y0 = y0, .width = x1 - x0 + 1, .height = y - y0 + 1};
+    }
+  });
+  return components;
+}
+
+ppc::geometry::LabelledPoints HullInput(const Components &components) {
+  ppc::geometry::LabelledPoints input;
+  input.components = components.Size();
+  const std::size_t width = components.width;
+  for (std::size_t component = 0; component < components.Size(); component++) {
+    const std::span<const std::size_t> pixels = components.Pixels(component);
+    for (std::size_t i = 0; i < pixels.size(); i++) {
+      const std::size_t y = pixels[i] / width;
+      const bool first = i == 0 || pixels[i - 1] / width != y;
+      const bool last = i + 1 == pixels.size() || pixels[i + 1] / width != y;
+      if (first || last) {
+        input.points.push_back({.x = static_cast<double>(pixels[i] % width), .y = static_cast<double>(y)});
+        input.labels.push_back(component);
+      }
+    }
+  }
+  return input;
+}
+
+Labels DistributedLabel(const Image &local, std::size_t width, std::size_t height, const Options &options,
+                        MPI_Comm comm) {
+  int rank = 0;
+  int size = 1;
+  MPI_Comm_rank(comm, &rank);
+  MPI_Comm_size(comm, &size);
+  const auto rows = [&](int r) {
+    const auto [begin, end] = ppc::shared_memory::BlockRange(height, size, r);
+    return end - begin;
+  };
+  int valid = ppc::image::IsValid(local) && local.channels == 1 && local.width == width &&
+                      local.height == rows(rank) && width * height <= std::numeric_limits<std::uint32_t>::max()
+                  ? 1
+                  : 0;
+  MPI_Allreduce(MPI_IN_PLACE, &valid, 1, MPI_INT, MPI_MIN, comm);
+  if (valid == 0) {
+    throw std::invalid_argument("DistributedLabel: a strip does not match its share of the rows");
+  }
+  Labels strip = Label(local, options);
+
+  // Labels of the strips before this one come first.
+  const std::uint64_t count = strip.count;
+  std::uint64_t offset = 0;
+  std::uint64_t total = 0;
+  MPI_Exscan(&count, &offset, 1, MPI_UINT64_T, MPI_SUM, comm);
+  MPI_Allreduce(&count, &total, 1, MPI_UINT64_T, MPI_SUM, comm);
+  if (rank == 0) {
+    offset = 0;
+  }
+  for (std::uint32_t &label : strip.labels) {
+    if (label != 0) {
+      label += static_cast<std::uint32_t>(offset);
+    }
+  }
+
+  // Last row of the nearest non-empty strip above, from which the next non-empty strip below is
+  // sent this strip's last row.
+  int above = MPI_PROC_NULL;
+  int below = MPI_PROC_NULL;
+  if (local.height > 0) {
+    for (int r = rank - 1; r >= 0 && above == MPI_PROC_NULL; r--) {
+      above = rows(r) > 0 ? r : MPI_PROC_NULL;
+    }
+    for (int r = rank + 1; r < size && below == MPI_PROC_NULL; r++) {
+      below = rows(r) > 0 ? r : MPI_PROC_NULL;
+    }
+  }
+  std::vector<std::uint32_t> row_above(width, 0);
+  const std::uint32_t *last_row = local.height > 0 ? strip.labels.data() + ((local.height - 1) * width) : nullptr;
+  MPI_Sendrecv(last_row, local.height > 0 ? static_cast<int>(width) : 0, MPI_UINT32_T, below, 0, row_above.data(),
+               static_cast<int>(width), MPI_UINT32_T, above, 0, comm, MPI_STATUS_IGNORE);
+
+  // Pairs of a top-row label and a label above it, the repeats along a run dropped.
+  std::vector<std::uint32_t> pairs;
+  const auto pair = [&](std::uint32_t mine, std::uint32_t other) {
+    const std::size_t n = pairs.size();
+    if (other != 0 && (n == 0 || pairs[n - 2] != mine || pairs[n - 1] != other)) {
+      pairs.push_back(mine);
+      pairs.push_back(other);
+    }
+  };
+  if (above != MPI_PROC_NULL) {
+    for (std::size_t x = 0; x < width; x++) {
+      const std::uint32_t mine = strip.labels[x];
+      if (mine == 0) {
+        continue;
+      }
+      if (row_above[x] != 0) {
+        pair(mine, row_above[x]);
+      } else if (options.connectivity == Connectivity::kEight) {
+        pair(mine, x > 0 ? row_above[x - 1] : 0);
+        pair(mine, x + 1 < width ? row_above[x + 1] : 0);
+      }
+    }
+  }
+  const int sent = static_cast<int>(pairs.size());
+  std::vector<int> counts(static_cast<std::size_t>(size));
+  MPI_Allgather(&sent, 1, MPI_INT, counts.data(), 1, MPI_INT, comm);
+  std::vector<int> displs(static_cast<std::size_t>(size), 0);
+  for (std::size_t r = 1; r < displs.size(); r++) {
+    displs[r] = displs[r - 1] + counts[r - 1];
+  }
+  std::vector<std::uint32_t> all_pairs(static_cast<std::size_t>(displs[displs.size() - 1] + counts[counts.size() - 1]));
+  MPI_Allgatherv(pairs.data(), sent, MPI_UINT32_T, all_pairs.data(), counts.data(), displs.data(), MPI_UINT32_T, comm);
+
+  LabelMerger merger(all_pairs);
+  std::vector<std::uint32_t> renumbered(count + 1, 0);
+  for (std::uint64_t label = 1; label <= count; label++) {
+    renumbered[label] = merger.Renumber(static_cast<std::uint32_t>(offset + label));
+  }
+  for (std::uint32_t &label : strip.labels) {
+    if (label != 0) {
+      label = renumbered[label - offset];
+    }
+  }
+  strip.count = merger.Count(total);
+  return strip;
+}
+
+Labels AllGatherLabels(const Labels &local, std::size_t height, MPI_Comm comm) {
+  int size = 1;
+  MPI_Comm_size(comm, &size);
+  std::vector<int> counts(static_cast<std::size_t>(size));
+  std::vector<int> displs(static_cast<std::size_t>(size));
+  for (int r = 0; r < size; r++) {
+    const auto [begin, end] = ppc::shared_memory::BlockRange(height, size, r);
+    counts[static_cast<std::size_t>(r)] = static_cast<int>((end - begin) * local.width);
+    displs[static_cast<std::size_t>(r)] = static_cast<int>(begin * local.width);
+  }
+  Labels labels{.width = local.width,
+                .height = height,
+                .labels = std::vector<std::uint32_t>(local.width * height, 0),
+                .count = local.count};
+  MPI_Allgatherv(local.labels.data(), static_cast<int>(local.labels.size()), MPI_UINT32_T, labels.labels.data(),
+                 counts.data(), displs.data(), MPI_UINT32_T, comm);
+  return labels;
+}
+
+}  // namespace ppc::labelling
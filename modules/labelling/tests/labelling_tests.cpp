@@ -0,0 +1,268 @@
+#include <gtest/gtest.h>
+#include <mpi.h>
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "geometry/include/geometry.hpp"
+#include "geometry/include/hull.hpp"
+#include "image/include/image.hpp"
+#include "labelling/include/labelling.hpp"
+#include "labelling/include/labelling_task.hpp"
+#include "shared_memory/include/parallel_for.hpp"
+#include "shared_memory/include/shared_memory.hpp"
+#include "task/include/task.hpp"
+#include "util/include/func_test_util.hpp"
+
+using ppc::labelling::Backend;
+using ppc::labelling::Components;
+using ppc::labelling::Connectivity;
+using ppc::labelling::Image;
+using ppc::labelling::Labels;
+using ppc::task::TypeOfTask;
+
+namespace {
+
+constexpr std::array<Backend, 4> kAllBackends = {Backend::kSeq, Backend::kOmp, Backend::kTbb, Backend::kStl};
+constexpr std::array<Connectivity, 2> kAllConnectivities = {Connectivity::kFour, Connectivity::kEight};
+
+/// Tiles of a few rows, so that most components cross tile borders.
+class SmallTiles {
+ public:
+  explicit SmallTiles(std::size_t rows) : saved_(ppc::labelling::GetTuning()) {
+    ppc::labelling::GetTuning().tile_rows = rows;
+  }
+  ~SmallTiles() {
+    ppc::labelling::GetTuning() = saved_;
+  }
+  SmallTiles(const SmallTiles &) = delete;
+  SmallTiles &operator=(const SmallTiles &) = delete;
+
+ private:
+  ppc::labelling::Tuning saved_;
+};
+
+/// Flood fill from every unlabelled foreground pixel in raster order.
+Labels ReferenceLabels(const Image &mask, Connectivity connectivity) {
+  const auto width = static_cast<std::ptrdiff_t>(mask.width);
+  const auto height = static_cast<std::ptrdiff_t>(mask.height);
+  Labels result{.width = mask.width,
+                .height = mask.height,
+                .labels = std::vector<std::uint32_t>(mask.pixels.size()),
+                .count = 0};
+  std::vector<std::ptrdiff_t> stack;
+  for (std::ptrdiff_t start = 0; start < width * height; start++) {
+    if (mask.pixels[static_cast<std::size_t>(start)] == 0 || result.labels[static_cast<std::size_t>(start)] != 0) {
+      continue;
+    }
+    const auto label = static_cast<std::uint32_t>(++result.count);
+    result.labels[static_cast<std::size_t>(start)] = label;
+    stack.push_back(start);
+    while (!stack.empty()) {
+      const std::ptrdiff_t p = stack[stack.size() - 1];
+      stack.pop_back();
+      for (std::ptrdiff_t dy = -1; dy <= 1; dy++) {
+        for (std::ptrdiff_t dx = -1; dx <= 1; dx++) {
+          const std::ptrdiff_t x = (p % width) + dx;
+          const std::ptrdiff_t y = (p / width) + dy;
+          const bool diagonal = dx != 0 && dy != 0;
+          if (x < 0 || y < 0 || x >= width || y >= height || (diagonal && connectivity == Connectivity::kFour)) {
+            continue;
+          }
+          const auto q = static_cast<std::size_t>((y * width) + x);
+          if (mask.pixels[q] != 0 && result.labels[q] == 0) {
+            result.labels[q] = label;
+            stack.push_back(static_cast<std::ptrdiff_t>(q));
+          }
+        }
+      }
+    }
+  }
+  return result;
+}
+
+/// Random masks of odd sizes across the densities where components are small, merge and span the
+/// mask, and a thresholded test picture with large blobs.
+std::vector<Image> TestMasks() {
+  std::vector<Image> masks;
+  std::uint64_t seed = 1;
+  for (const double density : {0.2, 0.45, 0.6, 0.9}) {
+    masks.push_back(ppc::labelling::RandomMask(37, 23, density, seed++));
+    masks.push_back(ppc::labelling::RandomMask(1, 19, density, seed++));
+    masks.push_back(ppc::labelling::RandomMask(29, 1, density, seed++));
+  }
+  const Image picture = ppc::image::TestPattern(53, 41, 1, ppc::image::Layout::kInterleaved, 4);
+  masks.push_back(ppc::labelling::Threshold(picture, 128));
+  return masks;
+}
+
+std::string Describe(const Image &mask, Connectivity connectivity, Backend backend) {
+  return std::to_string(mask.width) + "x" + std::to_string(mask.height) + " " +
+         ppc::labelling::ConnectivityToString(connectivity) + " " + ppc::shared_memory::BackendToString(backend);
+}
+
+}  // namespace
+
+TEST(Labelling, LabelsMatchFloodFillForEveryTileSize) {
+  for (const std::size_t rows : {1, 2, 5, 32}) {
+    const SmallTiles small_tiles(rows);
+    for (const Image &mask : TestMasks()) {
+      for (const Connectivity connectivity : kAllConnectivities) {
+        const Labels expected = ReferenceLabels(mask, connectivity);
+        for (const Backend backend : kAllBackends) {
+          const ppc::labelling::Options options{.connectivity = connectivity, .backend = backend};
+          ASSERT_EQ(ppc::labelling::Label(mask, options), expected)
+              << Describe(mask, connectivity, backend) << " tile_rows " << rows;
+        }
+      }
+    }
+  }
+}
+
+TEST(Labelling, DecisionTreeJoinsOnlyConnectedPixels) {
+  // A U whose arms meet at the bottom, two diagonal touches and a lone pixel.
+  const std::vector<std::uint8_t> pixels = {
+      1, 0, 1, 0, 0, 0, 1,  //
+      1, 0, 1, 0, 0, 1, 0,  //
+      1, 1, 1, 0, 1, 0, 0,  //
+      0, 0, 0, 0, 0, 0, 0,  //
+      0, 1, 0, 0, 0, 0, 1,  //
+  };
+  const Image mask = ppc::image::FromInterleaved(pixels, 7, 5, 1);
+  const SmallTiles small_tiles(1);
+  for (const Backend backend : kAllBackends) {
+    const Labels four = ppc::labelling::Label(mask, {.connectivity = Connectivity::kFour, .backend = backend});
+    const Labels eight = ppc::labelling::Label(mask, {.connectivity = Connectivity::kEight, .backend = backend});
+    EXPECT_EQ(four.count, 6U);
+    EXPECT_EQ(eight.count, 4U);
+    EXPECT_EQ(four.At(2, 0), four.At(0, 0));
+    EXPECT_NE(four.At(5, 1), four.At(6, 0));
+    EXPECT_EQ(eight.At(4, 2), eight.At(6, 0));
+    EXPECT_EQ(eight.At(1, 4), 3U);
+    EXPECT_EQ(eight.At(3, 3), 0U);
+  }
+  EXPECT_EQ(ppc::labelling::Label(ppc::image::MakeImage(0, 4, 1)).count, 0U);
+  EXPECT_EQ(ppc::labelling::Label(ppc::image::MakeImage(6, 3, 1)).count, 0U);
+}
+
+TEST(Labelling, ComponentsHoldTheirBoxesAndPixelsInRasterOrder) {
+  const Image mask = ppc::labelling::RandomMask(61, 47, 0.55, 9);
+  const Labels labels = ppc::labelling::Label(mask, {.connectivity = Connectivity::kFour});
+  std::vector<std::vector<std::size_t>> expected_pixels(labels.count);
+  std::vector<ppc::labelling::BoundingBox> expected_boxes(labels.count);
+  for (std::size_t y = 0; y < labels.height; y++) {
+    for (std::size_t x = 0; x < labels.width; x++) {
+      if (labels.At(x, y) == 0) {
+        continue;
+      }
+      const std::size_t component = labels.At(x, y) - 1;
+      ppc::labelling::BoundingBox &box = expected_boxes[component];
+      if (expected_pixels[component].empty()) {
+        box = {.x0 = x, .y0 = y, .width = 1, .height = 1};
+      }
+      const std::size_t x1 = std::max(box.x0 + box.width, x + 1);
+      box.x0 = std::min(box.x0, x);
+      box.width = x1 - box.x0;
+      box.height = y - box.y0 + 1;
+      expected_pixels[component].push_back((y * labels.width) + x);
+    }
+  }
+  for (const Backend backend : kAllBackends) {
+    const Components components = ppc::labelling::CollectComponents(labels, backend);
+    ASSERT_EQ(components.Size(), labels.count);
+    EXPECT_EQ(components.boxes, expected_boxes) << ppc::shared_memory::BackendToString(backend);
+    for (std::size_t component = 0; component < components.Size(); component++) {
+      const auto pixels = components.Pixels(component);
+      ASSERT_EQ(std::vector<std::size_t>(pixels.begin(), pixels.end()), expected_pixels[component]);
+    }
+  }
+}
+
+TEST(Labelling, HullInputGivesTheHullsOfTheComponentPixels) {
+  const Image picture = ppc::image::TestPattern(80, 60, 1, ppc::image::Layout::kPlanar, 3);
+  const Image mask = ppc::labelling::Threshold(picture, 100);
+  const Components components = ppc::labelling::CollectComponents(ppc::labelling::Label(mask));
+  std::vector<ppc::geometry::Point> points;
+  std::vector<std::size_t> labels;
+  for (std::size_t component = 0; component < components.Size(); component++) {
+    for (const std::size_t pixel : components.Pixels(component)) {
+      points.push_back({.x = static_cast<double>(pixel % 80), .y = static_cast<double>(pixel / 80)});
+      labels.push_back(component);
+    }
+  }
+  const ppc::geometry::LabelledPoints input = ppc::labelling::HullInput(components);
+  EXPECT_LT(input.points.size(), points.size());
+  EXPECT_EQ(ppc::geometry::ComponentHulls(input.points, input.labels, input.components),
+            ppc::geometry::ComponentHulls(points, labels, components.Size()));
+}
+
+TEST(Labelling, InvalidMasksAreRejected) {
+  EXPECT_THROW((void)ppc::labelling::Label(ppc::image::MakeImage(4, 4, 3)), std::invalid_argument);
+  Image truncated = ppc::image::MakeImage(4, 4, 1);
+  truncated.pixels.pop_back();
+  EXPECT_THROW((void)ppc::labelling::Label(truncated), std::invalid_argument);
+  ppc::labelling::LabellingTask<TypeOfTask::kSEQ> task(ppc::image::MakeImage(0, 0, 1));
+  EXPECT_FALSE(task.Validation());
+  task.PreProcessing();
+  task.Run();
+  task.PostProcessing();
+}
+
+TEST(Labelling, DistributedLabelsMatchSharedMemory) {
+  if (!ppc::util::MpiReady()) {
+    GTEST_SKIP() << "MPI is not initialized";
+  }
+  int rank = 0;
+  int size = 1;
+  MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+  MPI_Comm_size(MPI_COMM_WORLD, &size);
+  const SmallTiles small_tiles(3);
+  std::vector<Image> masks = TestMasks();
+  // Fewer rows than ranks leaves some strips empty.
+  masks.push_back(ppc::labelling::RandomMask(17, 2, 0.6, 21));
+  for (const Image &mask : masks) {
+    const auto [begin, end] = ppc::shared_memory::BlockRange(mask.height, size, rank);
+    const Image local = ppc::image::Crop(mask, 0, begin, mask.width, end - begin);
+    for (const Connectivity connectivity : kAllConnectivities) {
+      const ppc::labelling::Options options{.connectivity = connectivity, .backend = Backend::kOmp};
+      const Labels strip = ppc::labelling::DistributedLabel(local, mask.width, mask.height, options, MPI_COMM_WORLD);
+      ASSERT_EQ(ppc::labelling::AllGatherLabels(strip, mask.height, MPI_COMM_WORLD),
+                ppc::labelling::Label(mask, options))
+          << Describe(mask, connectivity, options.backend) << " on " << size << " ranks";
+    }
+  }
+  const Image row = ppc::image::MakeImage(5, 1, 1);
+  EXPECT_THROW((void)ppc::labelling::DistributedLabel(row, 5, 1 + size, {}, MPI_COMM_WORLD), std::invalid_argument);
+}
+
+namespace {
+
+template <TypeOfTask kType, Connectivity kConnectivity>
+void RunLabellingTask(const Image &mask) {
+  ppc::labelling::LabellingTask<kType, kConnectivity> task(mask);
+  ASSERT_TRUE(task.Validation());
+  ASSERT_TRUE(task.PreProcessing());
+  ASSERT_TRUE(task.Run());
+  ASSERT_TRUE(task.PostProcessing());
+  const Labels labels = ppc::labelling::Label(mask, {.connectivity = kConnectivity});
+  EXPECT_EQ(task.GetOutput(), ppc::labelling::CollectComponents(labels));
+}
+
+}  // namespace
+
+TEST(Labelling, TasksMatchTheSequentialComponentsOnEveryBackend) {
+  const Image mask = ppc::labelling::RandomMask(96, 70, 0.5, 13);
+  RunLabellingTask<TypeOfTask::kSEQ, Connectivity::kEight>(mask);
+  RunLabellingTask<TypeOfTask::kOMP, Connectivity::kFour>(mask);
+  RunLabellingTask<TypeOfTask::kTBB, Connectivity::kEight>(mask);
+  RunLabellingTask<TypeOfTask::kSTL, Connectivity::kFour>(mask);
+  if (ppc::util::MpiReady()) {
+    RunLabellingTask<TypeOfTask::kMPI, Connectivity::kEight>(mask);
+    RunLabellingTask<TypeOfTask::kMPI, Connectivity::kFour>(mask);
+  }
+}
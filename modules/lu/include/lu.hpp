@@ -0,0 +1,62 @@
+#pragma once
+
+#include <mpi.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "shared_memory/include/parallel_for.hpp"
+
+namespace ppc::lu {
+
+using Backend = ppc::shared_memory::Backend;
+
+/// @brief Direct method for A X = B.
+enum class Method : uint8_t {
+  /// Blocked right-looking LU with partial pivoting, then block back substitution
+  kLu,
+  /// Blocked Gauss-Jordan: every panel is eliminated above and below the diagonal, so the final
+  /// solve is block diagonal and needs no sequential back substitution
+  kGaussJordan
+};
+
+/// @brief Returns the lower-case name of the method ("lu", "gauss_jordan").
+std::string MethodToString(Method method);
+
+struct Options {
+  Method method = Method::kLu;
+  /// Panel width, and the block of the block-cyclic row distribution (1 gives a cyclic one).
+  std::size_t block = 64;
+  /// Factor panel k + 1 while the trailing rows of panel k are still being broadcast.
+  bool look_ahead = true;
+  /// Thread back-end of the panel, triangular solves and GEMM updates.
+  Backend backend = Backend::kSeq;
+};
+
+struct Result {
+  /// Row-major n x nrhs solution, on every rank.
+  std::vector<double> x;
+  /// Row exchanged with row i at step i of the elimination.
+  std::vector<std::size_t> pivots;
+  /// Wall time of the solve, and the part of it this rank spent waiting for panel broadcasts.
+  double seconds = 0.0;
+  double wait_seconds = 0.0;
+};
+
+/// @brief Solves A X = B by blocked elimination with partial pivoting.
+/// @details Rows are dealt to ranks in blocks of Options::block, round robin, so every rank keeps a
+/// share of the shrinking trailing matrix. Each pivot search is one allreduce that also carries the
+/// pivot's panel row; the owner of a panel broadcasts its rows of U, and the trailing update runs
+/// through ppc::gemm::Gemm(). With look-ahead the columns of the next panel are updated first, so
+/// the next panel is factored while the rest of the broadcast is in flight.
+/// @param a Row-major n x n matrix; read on every rank, each rank keeps only its rows.
+/// @param b Row-major n x nrhs right-hand sides, read like @p a.
+/// @param comm Communicator of the ranks, or MPI_COMM_NULL for a shared-memory solve.
+/// @throws std::invalid_argument When the sizes do not match or the block is zero.
+/// @throws std::runtime_error When A is singular to working precision (a zero pivot).
+Result Solve(const std::vector<double> &a, const std::vector<double> &b, std::size_t n, std::size_t nrhs,
+             const Options &options = {}, MPI_Comm comm = MPI_COMM_NULL);
+
+}  // namespace ppc::lu
@@ -0,0 +1,68 @@
+#pragma once
+
+#include <mpi.h>
+
+#include <cstddef>
+#include <vector>
+
+#include "lu/include/lu.hpp"
+#include "shared_memory/include/parallel_for.hpp"
+#include "task/include/task.hpp"
+
+namespace ppc::lu {
+
+/// @brief A X = B with row-major A (n x n) and B (n x nrhs); every rank holds the whole input, as in
+/// the course tasks.
+struct LinearSystem {
+  std::size_t n = 0;
+  std::size_t nrhs = 1;
+  std::vector<double> a;
+  std::vector<double> b;
+};
+
+/// @brief Blocked elimination as a course task on any back-end.
+/// @details The kMPI variant distributes block-cyclic rows over MPI_COMM_WORLD; the solution is
+/// returned on every rank.
+template <ppc::task::TypeOfTask kType, Method kMethod = Method::kLu>
+class LuTask : public ppc::task::Task<LinearSystem, Result> {
+ public:
+  using InType = LinearSystem;
+  using OutType = Result;
+
+  static constexpr ppc::task::TypeOfTask GetStaticTypeOfTask() {
+    return kType;
+  }
+
+  explicit LuTask(const InType &in, Options options = {}) {
+    SetTypeOfTask(GetStaticTypeOfTask());
+    GetInput() = in;
+    options_ = options;
+    options_.method = kMethod;
+    options_.backend = ppc::shared_memory::BackendOf(kType);
+  }
+
+ private:
+  bool ValidationImpl() override {
+    const InType &in = GetInput();
+    return in.a.size() == in.n * in.n && in.b.size() == in.n * in.nrhs && options_.block > 0;
+  }
+
+  bool PreProcessingImpl() override {
+    return true;
+  }
+
+  bool RunImpl() override {
+    const InType &in = GetInput();
+    const MPI_Comm comm = kType == ppc::task::TypeOfTask::kMPI ? MPI_COMM_WORLD : MPI_COMM_NULL;
+    GetOutput() = Solve(in.a, in.b, in.n, in.nrhs, options_, comm);
+    return true;
+  }
+
+  bool PostProcessingImpl() override {
+    return GetOutput().x.size() == GetInput().n * GetInput().nrhs;
+  }
+
+  Options options_;
+};
+
+}  // namespace ppc::lu
@@ -0,0 +1,115 @@
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <cstddef>
+#include <random>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include "lu/include/lu.hpp"
+#include "lu/include/lu_task.hpp"
+#include "task/include/task.hpp"
+#include "util/include/perf_test_util.hpp"
+
+namespace ppc::lu::perf {
+
+using ppc::task::TypeOfTask;
+
+namespace {
+
+constexpr std::size_t kOrder = 1024;
+
+/// Random 1024 x 1024 system with solution x_i = sin(i), built once per process.
+const LinearSystem &PerfSystem() {
+  static const LinearSystem kSystem = [] {
+    LinearSystem system{.n = kOrder, .nrhs = 1, .a = std::vector<double>(kOrder * kOrder), .b = {}};
+    std::mt19937_64 gen(39);
+    std::uniform_real_distribution<double> value(-1.0, 1.0);
+    for (auto &entry : system.a) {
+      entry = value(gen);
+    }
+    system.b.assign(kOrder, 0.0);
+    for (std::size_t i = 0; i < kOrder; i++) {
+      for (std::size_t j = 0; j < kOrder; j++) {
+        system.b[i] += system.a[(i * kOrder) + j] * std::sin(static_cast<double>(j));
+      }
+    }
+    return system;
+  }();
+  return kSystem;
+}
+
+/// LuTask with a fixed panel width and look-ahead setting.
+template <TypeOfTask kType, Method kMethod, bool kLookAhead>
+class PerfLuTask : public LuTask<kType, kMethod> {
+ public:
+  explicit PerfLuTask(const LinearSystem &in) : LuTask<kType, kMethod>(in, {.block = 64, .look_ahead = kLookAhead}) {}
+};
+
+}  // namespace
+
+/// Reports GFLOP/s (2/3 n^3 for LU, n^3 for Gauss-Jordan) and the time rank 0 waited for panel
+/// broadcasts.
+template <Method kMethod>
+class LuPerfTests : public ppc::util::BaseRunPerfTests<LinearSystem, Result> {
+  LinearSystem input_data_;
+
+  void SetUp() override {
+    input_data_ = PerfSystem();
+  }
+
+  bool CheckTestOutputData(Result &output_data) final {
+    const auto n = static_cast<double>(kOrder);
+    this->PrintRate("gflop_per_s", 1e-9 * (kMethod == Method::kLu ? 2.0 / 3.0 : 1.0) * n * n * n);
+    this->PrintValue("wait_ms", 1e3 * output_data.wait_seconds);
+    for (std::size_t i = 0; i < kOrder; i++) {
+      if (std::abs(output_data.x[i] - std::sin(static_cast<double>(i))) > 1e-6) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  LinearSystem GetTestInputData() final {
+    return input_data_;
+  }
+};
+
+using LuFactorPerfTests = LuPerfTests<Method::kLu>;
+using GaussJordanPerfTests = LuPerfTests<Method::kGaussJordan>;
+
+/// PerfLuTask of every back-end with look-ahead for one method.
+template <Method kMethod>
+struct PerfLuTasks {
+  template <TypeOfTask kType>
+  using Task = PerfLuTask<kType, kMethod, true>;
+};
+
+template <Method kMethod>
+auto MakeBackendSuite(const std::string &kernel) {
+  return std::tuple_cat(ppc::util::MakeBackendPerfTaskTuples<PerfLuTasks<kMethod>::template Task, LinearSystem>(
+                            "ppc_lu", kernel),
+                        ppc::util::MakeNamedPerfTaskTuples<PerfLuTask<TypeOfTask::kMPI, kMethod, false>, LinearSystem>(
+                            "ppc_lu_mpi_" + kernel + "_no_look_ahead"));
+}
+
+TEST_P(LuFactorPerfTests, RunPerfModes) {
+  ExecuteTest(GetParam());
+}
+
+TEST_P(GaussJordanPerfTests, RunPerfModes) {
+  ExecuteTest(GetParam());
+}
+
+const auto kLuPerfTasks = MakeBackendSuite<Method::kLu>("lu");
+const auto kGaussJordanPerfTasks = MakeBackendSuite<Method::kGaussJordan>("gauss_jordan");
+
+INSTANTIATE_TEST_SUITE_P(BlockedLu, LuFactorPerfTests, ppc::util::TupleToGTestValues(kLuPerfTasks),
+                         LuFactorPerfTests::CustomPerfTestName);
+
+INSTANTIATE_TEST_SUITE_P(BlockedGaussJordan, GaussJordanPerfTests,
+                         ppc::util::TupleToGTestValues(kGaussJordanPerfTasks),
+                         GaussJordanPerfTests::CustomPerfTestName);
+
+}  // namespace ppc::lu::perf
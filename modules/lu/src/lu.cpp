@@ -0,0 +1,452 @@
+#include "lu/include/lu.hpp"
+
+#include <mpi.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "gemm/include/gemm.hpp"
+#include "shared_memory/include/parallel_for.hpp"
+
+namespace ppc::lu {
+
+namespace {
+
+constexpr int kSwapTag = 0;
+
+/// B = L^{-1} B for the unit lower triangle of the h x h block at @p l; columns split between workers.
+void SolveLowerUnit(const double *l, std::size_t ldl, std::size_t h, double *b, std::size_t ldb, std::size_t cols,
+                    Backend backend) {
+  ppc::shared_memory::ParallelForBlocks(cols, backend, [&](std::size_t begin, std::size_t end) {
+    for (std::size_t i = 1; i < h; i++) {
+      for (std::size_t p = 0; p < i; p++) {
+        const double factor = l[(i * ldl) + p];
+        for (std::size_t c = begin; c < end; c++) {
+          b[(i * ldb) + c] -= factor * b[(p * ldb) + c];
+        }
+      }
+    }
+  });
+}
+
+/// B = U^{-1} B for the upper triangle of the h x h block at @p u; columns split between workers.
+void SolveUpper(const double *u, std::size_t ldu, std::size_t h, double *b, std::size_t ldb, std::size_t cols,
+                Backend backend) {
+  ppc::shared_memory::ParallelForBlocks(cols, backend, [&](std::size_t begin, std::size_t end) {
+    for (std::size_t i = h; i-- > 0;) {
+      for (std::size_t p = i + 1; p < h; p++) {
+        const double factor = u[(i * ldu) + p];
+        for (std::size_t c = begin; c < end; c++) {
+          b[(i * ldb) + c] -= factor * b[(p * ldb) + c];
+        }
+      }
+      const double diagonal = u[(i * ldu) + i];
+      for (std::size_t c = begin; c < end; c++) {
+        b[(i * ldb) + c] /= diagonal;
+      }
+    }
+  });
+}
+
+/// Block-cyclic distribution of n rows in blocks of nb over size ranks.
+struct Layout {
+  std::size_t n = 0;
+  std::size_t nb = 1;
+  int size = 1;
+
+  [[nodiscard]] std::size_t Blocks() const {
+    return (n + nb - 1) / nb;
+  }
+  [[nodiscard]] int Owner(std::size_t row) const {
+    return static_cast<int>((row / nb) % static_cast<std::size_t>(size));
+  }
+  /// Rows of @p rank with a global index below @p row; local rows are stored in global order.
+  [[nodiscard]] std::size_t LocalBefore(std::size_t row, int rank) const {
+    const std::size_t block = row / nb;
+    const auto r = static_cast<std::size_t>(rank);
+    const auto p = static_cast<std::size_t>(size);
+    std::size_t count = block > r ? ((block - r + p - 1) / p) * nb : 0;
+    if (block < Blocks() && Owner(row) == rank) {
+      count += row - (block * nb);
+    }
+    return count;
+  }
+  [[nodiscard]] std::size_t LocalRows(int rank) const {
+    return LocalBefore(n, rank);
+  }
+  [[nodiscard]] std::size_t GlobalOf(std::size_t local, int rank) const {
+    return ((((local / nb) * static_cast<std::size_t>(size)) + static_cast<std::size_t>(rank)) * nb) + (local % nb);
+  }
+};
+
+/// Payload of the pivot search: |a_pj|, p and the panel part of row p.
+void PickPivot(void *in, void *inout, int *len, MPI_Datatype *type) {
+  int bytes = 0;
+  MPI_Type_size(*type, &bytes);
+  const std::size_t width = static_cast<std::size_t>(bytes) / sizeof(double);
+  auto *source = static_cast<double *>(in);
+  auto *target = static_cast<double *>(inout);
+  for (int item = 0; item < *len; item++, source += width, target += width) {
+    if (source[0] > target[0] || (source[0] == target[0] && source[1] < target[1])) {
+      std::copy_n(source, width, target);
+    }
+  }
+}
+
+/// Contiguous datatype and reduction of the pivot payload, freed on scope exit.
+class PivotReduction {
+ public:
+  PivotReduction(std::size_t width, MPI_Comm comm) : comm_(comm) {
+    if (comm_ != MPI_COMM_NULL) {
+      MPI_Type_contiguous(static_cast<int>(width), MPI_DOUBLE, &type_);
+      MPI_Type_commit(&type_);
+      MPI_Op_create(&PickPivot, 1, &op_);
+    }
+  }
+  ~PivotReduction() {
+    if (comm_ != MPI_COMM_NULL) {
+      MPI_Op_free(&op_);
+      MPI_Type_free(&type_);
+    }
+  }
+  PivotReduction(const PivotReduction &) = delete;
+  PivotReduction &operator=(const PivotReduction &) = delete;
+  PivotReduction(PivotReduction &&) = delete;
+  PivotReduction &operator=(PivotReduction &&) = delete;
+
+  void Allreduce(std::vector<double> &payload) const {
+    if (comm_ != MPI_COMM_NULL) {
+      MPI_Allreduce(MPI_IN_PLACE, payload.data(), 1, type_, op_, comm_);
+    }
+  }
+
+ private:
+  MPI_Comm comm_;
+  MPI_Datatype type_ = MPI_DATATYPE_NULL;
+  MPI_Op op_ = MPI_OP_NULL;
+};
+
+/// The local rows of [A | B] and the elimination steps on them.
+class Eliminator {
+ public:
+  Eliminator(const std::vector<double> &a, const std::vector<double> &b, std::size_t n, std::size_t nrhs,
+             const Options &options, MPI_Comm comm)
+      : options_(options),
+        comm_(comm),
+        nrhs_(nrhs),
+        width_(n + nrhs),
+        reduction_(options.block + 2, comm) {
+    layout_ = {.n = n, .nb = options.block, .size = 1};
+    if (comm_ != MPI_COMM_NULL) {
+      MPI_Comm_rank(comm_, &rank_);
+      MPI_Comm_size(comm_, &layout_.size);
+    }
+    local_rows_ = layout_.LocalRows(rank_);
+    rows_.resize(local_rows_ * width_);
+    for (std::size_t l = 0; l < local_rows_; l++) {
+      const std::size_t i = layout_.GlobalOf(l, rank_);
+      std::copy_n(a.begin() + static_cast<std::ptrdiff_t>(i * n), n, Row(l));
+      std::copy_n(b.begin() + static_cast<std::ptrdiff_t>(i * nrhs), nrhs, Row(l) + n);
+    }
+    result_.pivots.resize(n);
+  }
+
+  Result Run() {
+    const auto start = std::chrono::steady_clock::now();
+    const std::size_t blocks = layout_.Blocks();
+    if (blocks > 0) {
+      ThrowIfSingular(FactorPanel(0));
+    }
+    for (std::size_t k = 0; k < blocks; k++) {
+      Step(k);
+    }
+    if (options_.method == Method::kLu) {
+      BackSubstitute();
+    } else {
+      SolveDiagonalBlocks();
+    }
+    result_.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return std::move(result_);
+  }
+
+ private:
+  double *Row(std::size_t local) {
+    return rows_.data() + (local * width_);
+  }
+
+  [[nodiscard]] std::pair<std::size_t, std::size_t> Panel(std::size_t k) const {
+    return {k * layout_.nb, std::min((k + 1) * layout_.nb, layout_.n)};
+  }
+
+  /// Unblocked partial pivoting over the columns of panel k and all rows below its top.
+  /// @return False on a zero pivot, which every rank sees; the caller throws once no broadcast is
+  /// in flight.
+  bool FactorPanel(std::size_t k) {
+    const auto [k0, k1] = Panel(k);
+    std::vector<double> payload(options_.block + 2);
+    for (std::size_t j = k0; j < k1; j++) {
+      const std::size_t first = layout_.LocalBefore(j, rank_);
+      std::ranges::fill(payload, 0.0);
+      payload[0] = -1.0;
+      payload[1] = std::numeric_limits<double>::max();
+      for (std::size_t l = first; l < local_rows_; l++) {
+        const double magnitude = std::abs(Row(l)[j]);
+        if (magnitude > payload[0]) {
+          payload[0] = magnitude;
+          payload[1] = static_cast<double>(layout_.GlobalOf(l, rank_));
+        }
+      }
+      if (payload[0] >= 0.0) {
+        const std::size_t l = layout_.LocalBefore(static_cast<std::size_t>(payload[1]), rank_);
+        std::copy(Row(l) + k0, Row(l) + k1, payload.begin() + 2);
+      }
+      reduction_.Allreduce(payload);
+      if (payload[0] <= 0.0) {
+        return false;
+      }
+      const auto pivot_row = static_cast<std::size_t>(payload[1]);
+      result_.pivots[j] = pivot_row;
+      Swap(j, pivot_row);
+
+      // Panel part of the pivot row, indexed by column - k0.
+      const double *segment = payload.data() + 2;
+      const double pivot = segment[j - k0];
+      const std::size_t below = layout_.LocalBefore(j + 1, rank_);
+      const std::size_t remaining = local_rows_ - below;
+      ppc::shared_memory::ParallelForBlocks(remaining, options_.backend, [&](std::size_t begin, std::size_t end) {
+        for (std::size_t l = below + begin; l < below + end; l++) {
+          double *row = Row(l);
+          const double factor = row[j] / pivot;
+          row[j] = factor;
+          for (std::size_t c = j + 1; c < k1; c++) {
+            row[c] -= factor * segment[c - k0];
+          }
+        }
+      });
+    }
+    return true;
+  }
+
+  static void ThrowIfSingular(bool factored) {
+    if (!factored) {
+      throw std::runtime_error("lu: the matrix is singular to working precision");
+    }
+  }
+
+  /// Exchanges the whole rows i and p of [A | B], between their owners if they differ.
+  void Swap(std::size_t i, std::size_t p) {
+    if (i == p) {
+      return;
+    }
+    const int owner_i = layout_.Owner(i);
+    const int owner_p = layout_.Owner(p);
+    if (owner_i == rank_ && owner_p == rank_) {
+      std::swap_ranges(Row(layout_.LocalBefore(i, rank_)), Row(layout_.LocalBefore(i, rank_)) + width_,
+                       Row(layout_.LocalBefore(p, rank_)));
+    } else if (owner_i == rank_ || owner_p == rank_) {
+      const std::size_t mine = owner_i == rank_ ? i : p;
+      const int other = owner_i == rank_ ? owner_p : owner_i;
+      MPI_Sendrecv_replace(Row(layout_.LocalBefore(mine, rank_)), static_cast<int>(width_), MPI_DOUBLE, other,
+                           kSwapTag, other, kSwapTag, comm_, MPI_STATUS_IGNORE);
+    }
+  }
+
+  /// Copies columns [c0, c1) of the rows of panel k into @p buffer on their owner and sends them to
+  /// every rank; non-blocking when @p request is given.
+  void BroadcastPanelRows(std::size_t k, std::size_t c0, std::size_t c1, std::vector<double> &buffer,
+                          MPI_Request *request) {
+    const auto [k0, k1] = Panel(k);
+    const std::size_t h = k1 - k0;
+    const int owner = layout_.Owner(k0);
+    buffer.resize(h * (c1 - c0));
+    if (owner == rank_) {
+      const std::size_t top = layout_.LocalBefore(k0, rank_);
+      for (std::size_t i = 0; i < h; i++) {
+        std::copy(Row(top + i) + c0, Row(top + i) + c1, buffer.begin() + static_cast<std::ptrdiff_t>(i * (c1 - c0)));
+      }
+    }
+    if (comm_ == MPI_COMM_NULL || buffer.empty()) {
+      return;
+    }
+    if (request != nullptr) {
+      MPI_Ibcast(buffer.data(), static_cast<int>(buffer.size()), MPI_DOUBLE, owner, comm_, request);
+    } else {
+      MPI_Bcast(buffer.data(), static_cast<int>(buffer.size()), MPI_DOUBLE, owner, comm_);
+    }
+  }
+
+  /// Rows below panel k: columns [c0, c1) -= L21 * U12, with U12 the panel rows held in @p u (ldu wide,
+  /// starting at column c0).
+  void UpdateBelow(std::size_t k, std::size_t c0, std::size_t c1, const double *u, std::size_t ldu) {
+    const auto [k0, k1] = Panel(k);
+    const std::size_t below = layout_.LocalBefore(k1, rank_);
+    if (below == local_rows_ || c0 == c1) {
+      return;
+    }
+    ppc::gemm::Gemm(local_rows_ - below, c1 - c0, k1 - k0, -1.0, Row(below) + k0, width_, u, ldu, 1.0,
+                    Row(below) + c0, width_, options_.backend);
+  }
+
+  /// One elimination step: U12 of panel k, its broadcast and the trailing update, with the
+  /// factorisation of panel k + 1 between the update of its columns and the rest.
+  void Step(std::size_t k) {
+    const auto [k0, k1] = Panel(k);
+    const std::size_t h = k1 - k0;
+    const bool next = k + 1 < layout_.Blocks();
+    const std::size_t k2 = options_.look_ahead ? std::min(k1 + layout_.nb, layout_.n) : width_;
+    if (layout_.Owner(k0) == rank_) {
+      double *top = Row(layout_.LocalBefore(k0, rank_));
+      SolveLowerUnit(top + k0, width_, h, top + k1, width_, width_ - k1, options_.backend);
+    }
+    BroadcastPanelRows(k, k0, k2, near_, nullptr);
+    MPI_Request request = MPI_REQUEST_NULL;
+    BroadcastPanelRows(k, k2, width_, far_, &request);
+
+    UpdateBelow(k, k1, k2, near_.data() + h, k2 - k0);
+    const bool factored = !(options_.look_ahead && next) || FactorPanel(k + 1);
+    const auto wait_start = std::chrono::steady_clock::now();
+    MPI_Wait(&request, MPI_STATUS_IGNORE);
+    result_.wait_seconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - wait_start).count();
+    ThrowIfSingular(factored);
+    UpdateBelow(k, k2, width_, far_.data(), width_ - k2);
+    if (options_.method == Method::kGaussJordan) {
+      UpdateAbove(k);
+    }
+    if (!options_.look_ahead && next) {
+      ThrowIfSingular(FactorPanel(k + 1));
+    }
+  }
+
+  /// Gauss-Jordan: rows above panel k, columns [k1, width) -= A_above,panel * U11^{-1} U12.
+  void UpdateAbove(std::size_t k) {
+    const auto [k0, k1] = Panel(k);
+    const std::size_t h = k1 - k0;
+    const std::size_t above = layout_.LocalBefore(k0, rank_);
+    const std::size_t cols = width_ - k1;
+    if (above == 0 || cols == 0) {
+      return;
+    }
+    const std::size_t near_width = near_.size() / h;
+    const std::size_t far_width = far_.size() / h;
+    std::vector<double> z(h * cols);
+    for (std::size_t i = 0; i < h; i++) {
+      auto out = z.begin() + static_cast<std::ptrdiff_t>(i * cols);
+      out = std::copy_n(near_.begin() + static_cast<std::ptrdiff_t>((i * near_width) + h), near_width - h, out);
+      std::copy_n(far_.begin() + static_cast<std::ptrdiff_t>(i * far_width), far_width, out);
+    }
+    SolveUpper(near_.data(), near_width, h, z.data(), cols, cols, options_.backend);
+    ppc::gemm::Gemm(above, cols, h, -1.0, Row(0) + k0, width_, z.data(), cols, 1.0, Row(0) + k1, width_,
+                    options_.backend);
+  }
+
+  /// LU: X block by block from the last one; each block is sent to every rank, which removes it from
+  /// the right-hand sides of its rows above.
+  void BackSubstitute() {
+    const std::size_t n = layout_.n;
+    result_.x.assign(n * nrhs_, 0.0);
+    std::vector<double> block;
+    for (std::size_t k = layout_.Blocks(); k-- > 0;) {
+      const auto [k0, k1] = Panel(k);
+      const std::size_t h = k1 - k0;
+      const int owner = layout_.Owner(k0);
+      block.resize(h * nrhs_);
+      if (owner == rank_) {
+        double *top = Row(layout_.LocalBefore(k0, rank_));
+        SolveUpper(top + k0, width_, h, top + n, width_, nrhs_, options_.backend);
+        for (std::size_t i = 0; i < h; i++) {
+          std::copy_n(top + (i * width_) + n, nrhs_, block.begin() + static_cast<std::ptrdiff_t>(i * nrhs_));
+        }
+      }
+      if (comm_ != MPI_COMM_NULL) {
+        MPI_Bcast(block.data(), static_cast<int>(block.size()), MPI_DOUBLE, owner, comm_);
+      }
+      std::ranges::copy(block, result_.x.begin() + static_cast<std::ptrdiff_t>(k0 * nrhs_));
+      const std::size_t above = layout_.LocalBefore(k0, rank_);
+      if (above > 0 && nrhs_ > 0) {
+        ppc::gemm::Gemm(above, nrhs_, h, -1.0, Row(0) + k0, width_, block.data(), nrhs_, 1.0, Row(0) + n, width_,
+                        options_.backend);
+      }
+    }
+  }
+
+  /// Gauss-Jordan: every block row is [U11 | B'] after the elimination, so each rank solves its own
+  /// blocks and the solution is gathered once.
+  void SolveDiagonalBlocks() {
+    const std::size_t n = layout_.n;
+    std::vector<double> local(local_rows_ * nrhs_);
+    for (std::size_t top = 0; top < local_rows_; top += layout_.nb) {
+      const std::size_t k0 = layout_.GlobalOf(top, rank_);
+      const std::size_t h = std::min(layout_.nb, n - k0);
+      SolveUpper(Row(top) + k0, width_, h, Row(top) + n, width_, nrhs_, options_.backend);
+      for (std::size_t i = 0; i < h; i++) {
+        std::copy_n(Row(top + i) + n, nrhs_, local.begin() + static_cast<std::ptrdiff_t>((top + i) * nrhs_));
+      }
+    }
+    result_.x.assign(n * nrhs_, 0.0);
+    std::vector<double> gathered = local;
+    std::vector<int> counts(static_cast<std::size_t>(layout_.size));
+    std::vector<int> displs(static_cast<std::size_t>(layout_.size));
+    for (int r = 0, offset = 0; r < layout_.size; r++) {
+      counts[static_cast<std::size_t>(r)] = static_cast<int>(layout_.LocalRows(r) * nrhs_);
+      displs[static_cast<std::size_t>(r)] = offset;
+      offset += counts[static_cast<std::size_t>(r)];
+    }
+    if (comm_ != MPI_COMM_NULL) {
+      gathered.resize(n * nrhs_);
+      MPI_Allgatherv(local.data(), static_cast<int>(local.size()), MPI_DOUBLE, gathered.data(), counts.data(),
+                     displs.data(), MPI_DOUBLE, comm_);
+    }
+    for (int r = 0; r < layout_.size; r++) {
+      const auto base = static_cast<std::size_t>(displs[static_cast<std::size_t>(r)]);
+      for (std::size_t l = 0; l < layout_.LocalRows(r); l++) {
+        std::copy_n(gathered.begin() + static_cast<std::ptrdiff_t>(base + (l * nrhs_)), nrhs_,
+                    result_.x.begin() + static_cast<std::ptrdiff_t>(layout_.GlobalOf(l, r) * nrhs_));
+      }
+    }
+  }
+
+  Options options_;
+  MPI_Comm comm_;
+  int rank_ = 0;
+  Layout layout_;
+  std::size_t nrhs_;
+  std::size_t width_;
+  std::size_t local_rows_ = 0;
+  std::vector<double> rows_;
+  std::vector<double> near_;
+  std::vector<double> far_;
+  PivotReduction reduction_;
+  Result result_;
+};
+
+}  // namespace
+
+std::string MethodToString(Method method) {
+  switch (method) {
+    case Method::kLu:
+      return "lu";
+    case Method::kGaussJordan:
+      return "gauss_jordan";
+  }
+  return "unknown";
+}
+
+Result Solve(const std::vector<double> &a, const std::vector<double> &b, std::size_t n, std::size_t nrhs,
+             const Options &options, MPI_Comm comm) {
+  if (a.size() != n * n || b.size() != n * nrhs) {
+    throw std::invalid_argument("lu: the sizes of A and B do not match n and nrhs");
+  }
+  if (options.block == 0) {
+    throw std::invalid_argument("lu: the block must be positive");
+  }
+  return Eliminator(a, b, n, nrhs, options, comm).Run();
+}
+
+}  // namespace ppc::lu
@@ -0,0 +1,148 @@
+#include <gtest/gtest.h>
+#include <mpi.h>
+
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+#include "lu/include/lu.hpp"
+#include "lu/include/lu_task.hpp"
+#include "shared_memory/include/parallel_for.hpp"
+#include "task/include/task.hpp"
+#include "util/include/func_test_util.hpp"
+
+using ppc::lu::Backend;
+using ppc::lu::Method;
+using ppc::task::TypeOfTask;
+
+namespace {
+
+constexpr std::array<Backend, 4> kAllBackends = {Backend::kSeq, Backend::kOmp, Backend::kTbb, Backend::kStl};
+constexpr std::array<Method, 2> kAllMethods = {Method::kLu, Method::kGaussJordan};
+
+/// Random n x n matrix with a zero leading diagonal, so that the very first step must pivot.
+std::vector<double> RandomMatrix(std::size_t n, unsigned seed) {
+  std::mt19937_64 gen(seed);
+  std::uniform_real_distribution<double> value(-1.0, 1.0);
+  std::vector<double> a(n * n);
+  for (auto &entry : a) {
+    entry = value(gen);
+  }
+  for (std::size_t i = 0; i < n; i++) {
+    a[(i * n) + i] = 0.0;
+  }
+  return a;
+}
+
+/// B = A * X for X_ij = sin(i + 3 j).
+std::vector<double> RhsOf(const std::vector<double> &a, std::size_t n, std::size_t nrhs) {
+  std::vector<double> b(n * nrhs);
+  for (std::size_t i = 0; i < n; i++) {
+    for (std::size_t l = 0; l < n; l++) {
+      for (std::size_t j = 0; j < nrhs; j++) {
+        b[(i * nrhs) + j] += a[(i * n) + l] * std::sin(static_cast<double>(l + (3 * j)));
+      }
+    }
+  }
+  return b;
+}
+
+void ExpectSolves(const std::vector<double> &x, std::size_t n, std::size_t nrhs) {
+  ASSERT_EQ(x.size(), n * nrhs);
+  for (std::size_t i = 0; i < n; i++) {
+    for (std::size_t j = 0; j < nrhs; j++) {
+      ASSERT_NEAR(x[(i * nrhs) + j], std::sin(static_cast<double>(i + (3 * j))), 1e-8) << i << "," << j;
+    }
+  }
+}
+
+}  // namespace
+
+TEST(Lu, EveryMethodBlockAndBackendSolves) {
+  constexpr std::size_t kN = 53;
+  constexpr std::size_t kRhs = 3;
+  const auto a = RandomMatrix(kN, 1);
+  const auto b = RhsOf(a, kN, kRhs);
+  for (const Method method : kAllMethods) {
+    for (const std::size_t block : {1U, 8U, 64U}) {
+      for (const bool look_ahead : {false, true}) {
+        for (const Backend backend : kAllBackends) {
+          SCOPED_TRACE(ppc::lu::MethodToString(method) + "/" + std::to_string(block) + "/" +
+                       ppc::shared_memory::BackendToString(backend) + (look_ahead ? "/look_ahead" : ""));
+          const auto result = ppc::lu::Solve(
+              a, b, kN, kRhs, {.method = method, .block = block, .look_ahead = look_ahead, .backend = backend});
+          ExpectSolves(result.x, kN, kRhs);
+          EXPECT_NE(result.pivots[0], 0U);
+        }
+      }
+    }
+  }
+}
+
+TEST(Lu, PivotsFollowPartialPivoting) {
+  // The largest entry of each remaining column wins.
+  const std::vector<double> a = {1, 2, 0, 4, 1, 1, 2, 8, 3};
+  const std::vector<double> b = {3, 6, 13};
+  const auto result = ppc::lu::Solve(a, b, 3, 1, {.block = 2});
+  EXPECT_EQ(result.pivots, (std::vector<std::size_t>{1, 2, 2}));
+  EXPECT_NEAR(result.x[0], 1.0, 1e-12);
+  EXPECT_NEAR(result.x[1], 1.0, 1e-12);
+  EXPECT_NEAR(result.x[2], 1.0, 1e-12);
+}
+
+TEST(Lu, RejectsMalformedAndSingularSystems) {
+  const std::vector<double> singular = {1, 2, 2, 4};
+  EXPECT_THROW((void)ppc::lu::Solve(singular, {1, 2}, 2, 1), std::runtime_error);
+  EXPECT_THROW((void)ppc::lu::Solve(singular, {1, 2, 3}, 2, 1), std::invalid_argument);
+  EXPECT_THROW((void)ppc::lu::Solve(singular, {1, 2}, 2, 1, {.block = 0}), std::invalid_argument);
+  EXPECT_TRUE(ppc::lu::Solve({}, {}, 0, 1).x.empty());
+}
+
+TEST(Lu, DistributedCyclicRowsMatchTheSharedMemorySolve) {
+  if (!ppc::util::MpiReady()) {
+    GTEST_SKIP() << "MPI is not initialized";
+  }
+  constexpr std::size_t kN = 71;
+  constexpr std::size_t kRhs = 2;
+  const auto a = RandomMatrix(kN, 2);
+  const auto b = RhsOf(a, kN, kRhs);
+  for (const Method method : kAllMethods) {
+    for (const std::size_t block : {1U, 5U, 16U}) {
+      for (const bool look_ahead : {false, true}) {
+        const ppc::lu::Options options{.method = method, .block = block, .look_ahead = look_ahead};
+        const auto whole = ppc::lu::Solve(a, b, kN, kRhs, options);
+        const auto result = ppc::lu::Solve(a, b, kN, kRhs, options, MPI_COMM_WORLD);
+        ExpectSolves(result.x, kN, kRhs);
+        EXPECT_EQ(result.pivots, whole.pivots);
+      }
+    }
+  }
+  const std::vector<double> singular = {1, 2, 3, 2, 4, 6, 0, 0, 1};
+  EXPECT_THROW((void)ppc::lu::Solve(singular, {1, 2, 3}, 3, 1, {.block = 1}, MPI_COMM_WORLD), std::runtime_error);
+}
+
+template <TypeOfTask kType, Method kMethod>
+void RunLuTask(const ppc::lu::LinearSystem &system) {
+  ppc::lu::LuTask<kType, kMethod> task(system, {.block = 6});
+  ASSERT_TRUE(task.Validation());
+  ASSERT_TRUE(task.PreProcessing());
+  ASSERT_TRUE(task.Run());
+  ASSERT_TRUE(task.PostProcessing());
+  ExpectSolves(task.GetOutput().x, system.n, system.nrhs);
+}
+
+TEST(Lu, TasksSolveOnEveryBackend) {
+  ppc::lu::LinearSystem system{.n = 40, .nrhs = 2, .a = RandomMatrix(40, 3), .b = {}};
+  system.b = RhsOf(system.a, system.n, system.nrhs);
+  RunLuTask<TypeOfTask::kSEQ, Method::kLu>(system);
+  RunLuTask<TypeOfTask::kOMP, Method::kGaussJordan>(system);
+  RunLuTask<TypeOfTask::kTBB, Method::kLu>(system);
+  RunLuTask<TypeOfTask::kSTL, Method::kGaussJordan>(system);
+  if (ppc::util::MpiReady()) {
+    RunLuTask<TypeOfTask::kMPI, Method::kLu>(system);
+    RunLuTask<TypeOfTask::kMPI, Method::kGaussJordan>(system);
+  }
+}
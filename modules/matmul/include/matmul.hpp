@@ -0,0 +1,137 @@
+#pragma once
+
+#include <mpi.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "distribution/include/distribution.hpp"
+#include "gemm/include/gemm.hpp"
+
+namespace ppc::matmul {
+
+/// @brief Distributed C = A * B algorithm.
+enum class Algorithm : uint8_t {
+  /// Skewed blocks shifted left (A) and up (B) on a periodic q x q grid
+  kCannon,
+  /// A broadcast along grid rows, B shifted up, on a q x q grid
+  kFox,
+  /// Panels of A and B broadcast along rows and columns of any pr x pc grid
+  kSumma
+};
+
+/// @brief Returns the lower-case name of the algorithm ("cannon", "fox", "summa").
+std::string AlgorithmToString(Algorithm algorithm);
+
+/// @brief Grid shape used by @p algorithm on @p size ranks.
+/// @details Cannon and Fox take the largest q x q grid with q * q <= size, so the remaining ranks
+/// sit idle; SUMMA uses all ranks in the most square shape MPI_Dims_create finds.
+std::pair<int, int> GridShape(Algorithm algorithm, int size);
+
+/// @brief Periodic 2D Cartesian process grid with row and column communicators.
+/// @details Ranks are not reordered: grid position (i, j) is rank i * Cols() + j of the parent
+/// communicator, which is also part i * Cols() + j of ppc::distribution::MatrixDistribution.
+class ProcessGrid {
+ public:
+  /// @brief Builds the grid (collective over @p comm).
+  /// @throws std::invalid_argument When rows * cols differs from the size of @p comm.
+  ProcessGrid(MPI_Comm comm, int rows, int cols);
+  ~ProcessGrid();
+
+  ProcessGrid(const ProcessGrid &) = delete;
+  ProcessGrid &operator=(const ProcessGrid &) = delete;
+
+  [[nodiscard]] int Rows() const {
+    return rows_;
+  }
+  [[nodiscard]] int Cols() const {
+    return cols_;
+  }
+  /// @brief Grid row of this rank.
+  [[nodiscard]] int Row() const {
+    return row_;
+  }
+  /// @brief Grid column of this rank.
+  [[nodiscard]] int Col() const {
+    return col_;
+  }
+  [[nodiscard]] int Rank() const {
+    return row_ * cols_ + col_;
+  }
+  /// @brief Rank of grid position (@p row, @p col), both taken modulo the grid size.
+  [[nodiscard]] int RankOf(int row, int col) const;
+  /// @brief Cartesian communicator over the whole grid.
+  [[nodiscard]] MPI_Comm Comm() const {
+    return cart_;
+  }
+  /// @brief Ranks of this grid row, ranked by column.
+  [[nodiscard]] MPI_Comm RowComm() const {
+    return row_comm_;
+  }
+  /// @brief Ranks of this grid column, ranked by row.
+  [[nodiscard]] MPI_Comm ColComm() const {
+    return col_comm_;
+  }
+
+ private:
+  int rows_;
+  int cols_;
+  int row_ = 0;
+  int col_ = 0;
+  MPI_Comm cart_ = MPI_COMM_NULL;
+  MPI_Comm row_comm_ = MPI_COMM_NULL;
+  MPI_Comm col_comm_ = MPI_COMM_NULL;
+};
+
+/// @brief Execution options of the distributed multiplication.
+struct Options {
+  /// Back-end of the local ppc::gemm::Gemm() calls.
+  ppc::gemm::Backend backend = ppc::gemm::Backend::kSeq;
+  /// Run the shifts (Cannon, Fox) or next-panel broadcasts (SUMMA) on a ppc::hybrid::ProgressThread
+  /// while the local GEMM runs; needs MPI_THREAD_SERIALIZED, otherwise they run in between.
+  bool overlap = true;
+  /// Inner dimension of a SUMMA panel.
+  std::size_t panel = 256;
+};
+
+/// @brief Block distributions of A (m x k), B (k x n) and C (m x n) over a grid.
+/// @details Cannon and Fox need equal blocks, so their dimensions are padded with zeros to
+/// multiples of the grid size; SUMMA distributes the exact dimensions.
+struct Layout {
+  std::size_t m;
+  std::size_t n;
+  std::size_t k;
+  ppc::distribution::MatrixDistribution a;
+  ppc::distribution::MatrixDistribution b;
+  ppc::distribution::MatrixDistribution c;
+};
+
+/// @throws std::invalid_argument When Cannon or Fox is asked for a non-square grid.
+Layout MakeLayout(const ProcessGrid &grid, Algorithm algorithm, std::size_t m, std::size_t n, std::size_t k);
+
+/// @brief Copies a rows x cols row-major matrix into the top-left corner of a zero padded_rows x padded_cols one.
+std::vector<double> Pad(const std::vector<double> &matrix, std::size_t rows, std::size_t cols, std::size_t padded_rows,
+                        std::size_t padded_cols);
+
+/// @brief Inverse of Pad(): the top-left rows x cols corner.
+std::vector<double> Unpad(const std::vector<double> &matrix, std::size_t padded_cols, std::size_t rows,
+                          std::size_t cols);
+
+/// @brief C = A * B on local blocks laid out by @p layout (collective over the grid).
+/// @param a_local, b_local, c_local Row-major local blocks of this rank; c_local is overwritten.
+/// @throws std::invalid_argument When a block has the wrong size or the algorithm does not fit the grid.
+void MultiplyBlocks(const ProcessGrid &grid, const Layout &layout, Algorithm algorithm, const Options &options,
+                    const std::vector<double> &a_local, const std::vector<double> &b_local,
+                    std::vector<double> &c_local);
+
+/// @brief C = A * B for global matrices on @p root (collective over the grid).
+/// @details Pads as needed, scatters the blocks, multiplies and gathers C back.
+/// @return C (m x n) on @p root, an empty vector elsewhere.
+std::vector<double> Multiply(const ProcessGrid &grid, Algorithm algorithm, const std::vector<double> &a,
+                             const std::vector<double> &b, std::size_t m, std::size_t n, std::size_t k,
+                             const Options &options = {}, int root = 0);
+
+}  // namespace ppc::matmul
@@ -0,0 +1,72 @@
+#pragma once
+
+#include <mpi.h>
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+#include "matmul/include/matmul.hpp"
+#include "task/include/task.hpp"
+
+namespace ppc::matmul {
+
+/// @brief Operands of C = A * B; every rank holds the whole input, as in the course tasks.
+struct Problem {
+  std::size_t m = 0;
+  std::size_t n = 0;
+  std::size_t k = 0;
+  std::vector<double> a;
+  std::vector<double> b;
+};
+
+using InType = Problem;
+using OutType = std::vector<double>;
+using BaseTask = ppc::task::Task<InType, OutType>;
+
+/// @brief Distributed matmul over MPI_COMM_WORLD.
+/// @details PreProcessing builds the grid given by GridShape() and scatters the blocks from rank 0,
+/// Run multiplies them, PostProcessing gathers C and broadcasts it to every rank, including the
+/// ranks left outside the Cannon/Fox grid. PostProcessing throws std::invalid_argument on every rank
+/// when C has more elements than an MPI count can hold.
+class MatmulTaskMPI : public BaseTask {
+ public:
+  static constexpr ppc::task::TypeOfTask GetStaticTypeOfTask() {
+    return ppc::task::TypeOfTask::kMPI;
+  }
+  MatmulTaskMPI(const InType &in, Algorithm algorithm, Options options = {});
+  ~MatmulTaskMPI() override;
+
+  MatmulTaskMPI(const MatmulTaskMPI &) = delete;
+  MatmulTaskMPI &operator=(const MatmulTaskMPI &) = delete;
+
+ private:
+  bool ValidationImpl() override;
+  bool PreProcessingImpl() override;
+  bool RunImpl() override;
+  bool PostProcessingImpl() override;
+  /// Frees the grid and its communicator (no-op once MPI is finalized).
+  void ReleaseGrid();
+
+  Algorithm algorithm_;
+  Options options_;
+  MPI_Comm grid_comm_ = MPI_COMM_NULL;
+  std::unique_ptr<ProcessGrid> grid_;
+  std::unique_ptr<Layout> layout_;
+  std::vector<double> a_local_;
+  std::vector<double> b_local_;
+  std::vector<double> c_local_;
+};
+
+/// @brief MatmulTaskMPI with a fixed algorithm, constructible by ppc::task::TaskGetter.
+template <Algorithm kAlgorithm>
+class AlgorithmTaskMPI : public MatmulTaskMPI {
+ public:
+  explicit AlgorithmTaskMPI(const InType &in) : MatmulTaskMPI(in, kAlgorithm) {}
+};
+
+using CannonTaskMPI = AlgorithmTaskMPI<Algorithm::kCannon>;
+using FoxTaskMPI = AlgorithmTaskMPI<Algorithm::kFox>;
+using SummaTaskMPI = AlgorithmTaskMPI<Algorithm::kSumma>;
+
+}  // namespace ppc::matmul
@@ -0,0 +1,91 @@
+#include <gtest/gtest.h>
+#include <mpi.h>
+
+#include <cmath>
+#include <cstddef>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include "gemm/include/gemm.hpp"
+#include "matmul/include/matmul.hpp"
+#include "matmul/include/matmul_task.hpp"
+#include "task/include/task.hpp"
+#include "util/include/perf_test_util.hpp"
+
+namespace ppc::matmul::perf {
+
+class MatmulRunPerfTests : public ppc::util::BaseRunPerfTests<InType, OutType> {
+  static constexpr std::size_t kN = 1024;
+  InType input_data_;
+
+  /// Seconds of one local ppc::gemm::Gemm() of the whole problem, timed once on all ranks at once
+  /// so that it sees the same core sharing as the distributed runs.
+  static double SequentialSeconds() {
+    static const double kSeconds = [] {
+      const auto a = std::vector<double>(kN * kN, 1.0);
+      std::vector<double> c(kN * kN);
+      MPI_Barrier(MPI_COMM_WORLD);
+      const double start = MPI_Wtime();
+      ppc::gemm::Gemm(kN, kN, kN, 1.0, a.data(), kN, a.data(), kN, 0.0, c.data(), kN);
+      double seconds = MPI_Wtime() - start;
+      MPI_Allreduce(MPI_IN_PLACE, &seconds, 1, MPI_DOUBLE, MPI_MAX, MPI_COMM_WORLD);
+      return seconds;
+    }();
+    return kSeconds;
+  }
+
+  void SetUp() override {
+    input_data_ = {.m = kN, .n = kN, .k = kN, .a = std::vector<double>(kN * kN), .b = std::vector<double>(kN * kN)};
+    for (std::size_t i = 0; i < kN * kN; i++) {
+      input_data_.a[i] = static_cast<double>(i % 7) - 3.0;
+      input_data_.b[i] = static_cast<double>(i % 5) - 2.0;
+    }
+    (void)SequentialSeconds();
+  }
+
+  bool CheckTestOutputData(OutType &output_data) final {
+    int size = 1;
+    MPI_Comm_size(MPI_COMM_WORLD, &size);
+    PrintRate("gflop_per_s", 2e-9 * static_cast<double>(kN * kN * kN));
+    // Efficiency = T_seq / (p * T_p), printed as the rate of T_seq / p units of work.
+    PrintRate("parallel_efficiency", SequentialSeconds() / static_cast<double>(size));
+    if (output_data.size() != kN * kN) {
+      return false;
+    }
+    for (std::size_t i = 0; i < kN; i += 89) {
+      const std::size_t j = (i * 37) % kN;
+      double expected = 0.0;
+      for (std::size_t l = 0; l < kN; l++) {
+        expected += input_data_.a[(i * kN) + l] * input_data_.b[(l * kN) + j];
+      }
+      if (std::abs(output_data[(i * kN) + j] - expected) > 1e-6) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  InType GetTestInputData() final {
+    return input_data_;
+  }
+};
+
+template <typename TaskType>
+auto MakeMatmulPerfTasks(Algorithm algorithm) {
+  const std::string name = "ppc_matmul_mpi_" + AlgorithmToString(algorithm);
+  return ppc::util::MakeNamedPerfTaskTuples<TaskType, InType>(name);
+}
+
+TEST_P(MatmulRunPerfTests, RunPerfModes) {
+  ExecuteTest(GetParam());
+}
+
+const auto kMatmulPerfTasks = std::tuple_cat(MakeMatmulPerfTasks<CannonTaskMPI>(Algorithm::kCannon),
+                                             MakeMatmulPerfTasks<FoxTaskMPI>(Algorithm::kFox),
+                                             MakeMatmulPerfTasks<SummaTaskMPI>(Algorithm::kSumma));
+
+INSTANTIATE_TEST_SUITE_P(DistributedMatmul, MatmulRunPerfTests, ppc::util::TupleToGTestValues(kMatmulPerfTasks),
+                         MatmulRunPerfTests::CustomPerfTestName);
+
+}  // namespace ppc::matmul::perf
@@ -0,0 +1,384 @@
+#include "matmul/include/matmul.hpp"
+
+#include <mpi.h>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "distribution/include/distribution.hpp"
+#include "gemm/include/gemm.hpp"
+#include "hybrid/include/hybrid.hpp"
+
+namespace ppc::matmul {
+
+namespace {
+
+using ppc::distribution::MatrixDistribution;
+using ppc::distribution::Partition;
+
+constexpr int kShiftTag = 0;
+
+int ToInt(std::size_t count) {
+  if (count > static_cast<std::size_t>(std::numeric_limits<int>::max())) {
+    throw std::invalid_argument("matmul: block of " + std::to_string(count) + " elements does not fit into int");
+  }
+  return static_cast<int>(count);
+}
+
+std::size_t RoundUp(std::size_t value, int multiple) {
+  const auto step = static_cast<std::size_t>(multiple);
+  return ((value + step - 1) / step) * step;
+}
+
+void RequireSquare(const ProcessGrid &grid, Algorithm algorithm) {
+  if (grid.Rows() != grid.Cols()) {
+    throw std::invalid_argument("matmul: " + AlgorithmToString(algorithm) + " needs a square grid, got " +
+                                std::to_string(grid.Rows()) + "x" + std::to_string(grid.Cols()));
+  }
+}
+
+/// Replaces @p block by the one of rank @p source while sending it to @p dest.
+void Shift(std::vector<double> &block, int dest, int source, MPI_Comm comm) {
+  MPI_Sendrecv_replace(block.data(), ToInt(block.size()), MPI_DOUBLE, dest, kShiftTag, source, kShiftTag, comm,
+                       MPI_STATUS_IGNORE);
+}
+
+/// Progress thread when MPI allows another thread to communicate, inline execution otherwise.
+ppc::hybrid::ProgressThread MakeProgress(const Options &options) {
+  int level = MPI_THREAD_SINGLE;
+  MPI_Query_thread(&level);
+  return ppc::hybrid::ProgressThread(options.overlap && level >= MPI_THREAD_SERIALIZED);
+}
+
+/// C += A * B on dense row-major local blocks.
+void LocalGemm(std::size_t m, std::size_t n, std::size_t k, const double *a, const double *b, double *c,
+               const Options &options) {
+  ppc::gemm::Gemm(m, n, k, 1.0, a, std::max<std::size_t>(k, 1), b, std::max<std::size_t>(n, 1), 1.0, c,
+                  std::max<std::size_t>(n, 1), options.backend);
+}
+
+void Cannon(const ProcessGrid &grid, const Layout &layout, const Options &options, std::vector<double> a,
+            std::vector<double> b, std::vector<double> &c) {
+  const int q = grid.Rows();
+  const int i = grid.Row();
+  const int j = grid.Col();
+  const std::size_t mb = layout.c.LocalRows(grid.Rank());
+  const std::size_t nb = layout.c.LocalCols(grid.Rank());
+  const std::size_t kb = layout.a.LocalCols(grid.Rank());
+  // Initial skew: row i of A moves i blocks left, column j of B moves j blocks up.
+  if (i != 0) {
+    Shift(a, grid.RankOf(i, j - i), grid.RankOf(i, j + i), grid.Comm());
+  }
+  if (j != 0) {
+    Shift(b, grid.RankOf(i - j, j), grid.RankOf(i + j, j), grid.Comm());
+  }
+  auto progress = MakeProgress(options);
+  std::vector<double> a_next(a.size());
+  std::vector<double> b_next(b.size());
+  for (int step = 0; step < q; step++) {
+    if (step + 1 == q) {
+      LocalGemm(mb, nb, kb, a.data(), b.data(), c.data(), options);
+      break;
+    }
+    a_next = a;
+    b_next = b;
+    auto shifted = progress.Submit([&] {
+      Shift(a_next, grid.RankOf(i, j - 1), grid.RankOf(i, j + 1), grid.Comm());
+      Shift(b_next, grid.RankOf(i - 1, j), grid.RankOf(i + 1, j), grid.Comm());
+    });
+    LocalGemm(mb, nb, kb, a.data(), b.data(), c.data(), options);
+    shifted.get();
+    std::swap(a, a_next);
+    std::swap(b, b_next);
+  }
+}
+
+void Fox(const ProcessGrid &grid, const Layout &layout, const Options &options, const std::vector<double> &a,
+         std::vector<double> b, std::vector<double> &c) {
+  const int q = grid.Rows();
+  const int i = grid.Row();
+  const int j = grid.Col();
+  const std::size_t mb = layout.c.LocalRows(grid.Rank());
+  const std::size_t nb = layout.c.LocalCols(grid.Rank());
+  const std::size_t kb = layout.a.LocalCols(grid.Rank());
+  // Stage s multiplies A(i, i + s), broadcast along row i, by the B block shifted up s times.
+  std::vector<double> a_stage(a.size());
+  std::vector<double> a_next(a.size());
+  const auto broadcast = [&](std::vector<double> &buffer, int stage) {
+    const int root = (i + stage) % q;
+    if (j == root) {
+      buffer = a;
+    }
+    MPI_Bcast(buffer.data(), ToInt(buffer.size()), MPI_DOUBLE, root, grid.RowComm());
+  };
+  broadcast(a_stage, 0);
+  auto progress = MakeProgress(options);
+  std::vector<double> b_next(b.size());
+  for (int stage = 0; stage < q; stage++) {
+    if (stage + 1 == q) {
+      LocalGemm(mb, nb, kb, a_stage.data(), b.data(), c.data(), options);
+      break;
+    }
+    b_next = b;
+    auto prefetched = progress.Submit([&] {
+      Shift(b_next, grid.RankOf(i - 1, j), grid.RankOf(i + 1, j), grid.Comm());
+      broadcast(a_next, stage + 1);
+    });
+    LocalGemm(mb, nb, kb, a_stage.data(), b.data(), c.data(), options);
+    prefetched.get();
+    std::swap(b, b_next);
+    std::swap(a_stage, a_next);
+  }
+}
+
+struct Panel {
+  std::size_t begin;
+  std::size_t width;
+  int a_owner;
+  int b_owner;
+};
+
+/// Splits the inner dimension into panels that each live in one grid column of A and one grid row of B.
+std::vector<Panel> SummaPanels(const Layout &layout, std::size_t panel) {
+  const Partition &a_cols = layout.a.ColPartition();
+  const Partition &b_rows = layout.b.RowPartition();
+  std::vector<Panel> panels;
+  for (std::size_t l = 0; l < layout.k;) {
+    const int a_owner = a_cols.Owner(l);
+    const int b_owner = b_rows.Owner(l);
+    const std::size_t a_end = a_cols.ToGlobal(a_owner, 0) + a_cols.LocalCount(a_owner);
+    const std::size_t b_end = b_rows.ToGlobal(b_owner, 0) + b_rows.LocalCount(b_owner);
+    const std::size_t width = std::min({panel, a_end - l, b_end - l});
+    panels.push_back({.begin = l, .width = width, .a_owner = a_owner, .b_owner = b_owner});
+    l += width;
+  }
+  return panels;
+}
+
+void Summa(const ProcessGrid &grid, const Layout &layout, const Options &options, const std::vector<double> &a,
+           const std::vector<double> &b, std::vector<double> &c) {
+  const int rank = grid.Rank();
+  const std::size_t mb = layout.c.LocalRows(rank);
+  const std::size_t nb = layout.c.LocalCols(rank);
+  const std::size_t a_cols = layout.a.LocalCols(rank);
+  const auto panels = SummaPanels(layout, std::max<std::size_t>(options.panel, 1));
+  // The caller skips k == 0, so there is at least one panel.
+  const std::size_t widest = std::ranges::max(panels, {}, &Panel::width).width;
+
+  std::array<std::vector<double>, 2> a_panel{std::vector<double>(mb * widest), std::vector<double>(mb * widest)};
+  std::array<std::vector<double>, 2> b_panel{std::vector<double>(widest * nb), std::vector<double>(widest * nb)};
+  const auto load = [&](const Panel &p, std::size_t slot) {
+    if (grid.Col() == p.a_owner) {
+      const std::size_t a_first = layout.a.ColPartition().ToGlobal(grid.Col(), 0);
+      for (std::size_t r = 0; r < mb; r++) {
+        std::copy_n(a.begin() + static_cast<std::ptrdiff_t>((r * a_cols) + (p.begin - a_first)), p.width,
+                    a_panel[slot].begin() + static_cast<std::ptrdiff_t>(r * p.width));
+      }
+    }
+    if (grid.Row() == p.b_owner) {
+      const std::size_t b_first = layout.b.RowPartition().ToGlobal(grid.Row(), 0);
+      std::copy_n(b.begin() + static_cast<std::ptrdiff_t>((p.begin - b_first) * nb), p.width * nb,
+                  b_panel[slot].begin());
+    }
+  };
+  const auto broadcast = [&](const Panel &p, std::size_t slot) {
+    MPI_Bcast(a_panel[slot].data(), ToInt(mb * p.width), MPI_DOUBLE, p.a_owner, grid.RowComm());
+    MPI_Bcast(b_panel[slot].data(), ToInt(p.width * nb), MPI_DOUBLE, p.b_owner, grid.ColComm());
+  };
+
+  load(panels.front(), 0);
+  broadcast(panels.front(), 0);
+  auto progress = MakeProgress(options);
+  for (std::size_t t = 0; t < panels.size(); t++) {
+    const std::size_t slot = t % 2;
+    if (t + 1 == panels.size()) {
+      LocalGemm(mb, nb, panels[t].width, a_panel[slot].data(), b_panel[slot].data(), c.data(), options);
+      break;
+    }
+    load(panels[t + 1], 1 - slot);
+    auto prefetched = progress.Submit([&] { broadcast(panels[t + 1], 1 - slot); });
+    LocalGemm(mb, nb, panels[t].width, a_panel[slot].data(), b_panel[slot].data(), c.data(), options);
+    prefetched.get();
+  }
+}
+
+}  // namespace
+
+std::string AlgorithmToString(Algorithm algorithm) {
+  switch (algorithm) {
+    case Algorithm::kCannon:
+      return "cannon";
+    case Algorithm::kFox:
+      return "fox";
+    case Algorithm::kSumma:
+      return "summa";
+  }
+  return "unknown";
+}
+
+std::pair<int, int> GridShape(Algorithm algorithm, int size) {
+  if (size <= 0) {
+    throw std::invalid_argument("matmul: grid of " + std::to_string(size) + " ranks");
+  }
+  switch (algorithm) {
+    case Algorithm::kCannon:
+    case Algorithm::kFox: {
+      auto q = static_cast<int>(std::sqrt(static_cast<double>(size)));
+      while ((q + 1) * (q + 1) <= size) {
+        q++;
+      }
+      while (q * q > size) {
+        q--;
+      }
+      return {q, q};
+    }
+    case Algorithm::kSumma: {
+      std::array<int, 2> dims{0, 0};
+      MPI_Dims_create(size, 2, dims.data());
+      return {dims[0], dims[1]};
+    }
+  }
+  return {1, size};
+}
+
+ProcessGrid::ProcessGrid(MPI_Comm comm, int rows, int cols) : rows_(rows), cols_(cols) {
+  int size = 0;
+  MPI_Comm_size(comm, &size);
+  if (rows <= 0 || cols <= 0 || rows * cols != size) {
+    throw std::invalid_argument("matmul: " + std::to_string(rows) + "x" + std::to_string(cols) + " grid on " +
+                                std::to_string(size) + " ranks");
+  }
+  const std::array<int, 2> dims{rows, cols};
+  const std::array<int, 2> periods{1, 1};
+  MPI_Cart_create(comm, 2, dims.data(), periods.data(), 0, &cart_);
+  int rank = 0;
+  MPI_Comm_rank(cart_, &rank);
+  std::array<int, 2> coords{0, 0};
+  MPI_Cart_coords(cart_, rank, 2, coords.data());
+  row_ = coords[0];
+  col_ = coords[1];
+  const std::array<int, 2> keep_cols{0, 1};
+  const std::array<int, 2> keep_rows{1, 0};
+  MPI_Cart_sub(cart_, keep_cols.data(), &row_comm_);
+  MPI_Cart_sub(cart_, keep_rows.data(), &col_comm_);
+}
+
+ProcessGrid::~ProcessGrid() {
+  int finalized = 0;
+  MPI_Finalized(&finalized);
+  if (finalized != 0) {
+    return;
+  }
+  for (MPI_Comm *comm : {&row_comm_, &col_comm_, &cart_}) {
+    if (*comm != MPI_COMM_NULL) {
+      MPI_Comm_free(comm);
+    }
+  }
+}
+
+int ProcessGrid::RankOf(int row, int col) const {
+  const int r = ((row % rows_) + rows_) % rows_;
+  const int c = ((col % cols_) + cols_) % cols_;
+  return (r * cols_) + c;
+}
+
+Layout MakeLayout(const ProcessGrid &grid, Algorithm algorithm, std::size_t m, std::size_t n, std::size_t k) {
+  const int pr = grid.Rows();
+  const int pc = grid.Cols();
+  switch (algorithm) {
+    case Algorithm::kCannon:
+    case Algorithm::kFox: {
+      RequireSquare(grid, algorithm);
+      const std::size_t pm = RoundUp(m, pr);
+      const std::size_t pn = RoundUp(n, pr);
+      const std::size_t pk = RoundUp(k, pr);
+      return {.m = m,
+              .n = n,
+              .k = k,
+              .a = MatrixDistribution::Blocks(pm, pk, pr, pc),
+              .b = MatrixDistribution::Blocks(pk, pn, pr, pc),
+              .c = MatrixDistribution::Blocks(pm, pn, pr, pc)};
+    }
+    case Algorithm::kSumma:
+      return {.m = m,
+              .n = n,
+              .k = k,
+              .a = MatrixDistribution(Partition(m, pr), Partition(k, pc)),
+              .b = MatrixDistribution(Partition(k, pr), Partition(n, pc)),
+              .c = MatrixDistribution(Partition(m, pr), Partition(n, pc))};
+  }
+  throw std::invalid_argument("matmul: unknown algorithm");
+}
+
+std::vector<double> Pad(const std::vector<double> &matrix, std::size_t rows, std::size_t cols, std::size_t padded_rows,
+                        std::size_t padded_cols) {
+  if (matrix.size() != rows * cols || padded_rows < rows || padded_cols < cols) {
+    throw std::invalid_argument("matmul: cannot pad a matrix of " + std::to_string(matrix.size()) + " elements");
+  }
+  std::vector<double> padded(padded_rows * padded_cols, 0.0);
+  for (std::size_t r = 0; r < rows; r++) {
+    std::copy_n(matrix.begin() + static_cast<std::ptrdiff_t>(r * cols), cols,
+                padded.begin() + static_cast<std::ptrdiff_t>(r * padded_cols));
+  }
+  return padded;
+}
+
+std::vector<double> Unpad(const std::vector<double> &matrix, std::size_t padded_cols, std::size_t rows,
+                          std::size_t cols) {
+  std::vector<double> result(rows * cols);
+  for (std::size_t r = 0; r < rows; r++) {
+    std::copy_n(matrix.begin() + static_cast<std::ptrdiff_t>(r * padded_cols), cols,
+                result.begin() + static_cast<std::ptrdiff_t>(r * cols));
+  }
+  return result;
+}
+
+void MultiplyBlocks(const ProcessGrid &grid, const Layout &layout, Algorithm algorithm, const Options &options,
+                    const std::vector<double> &a_local, const std::vector<double> &b_local,
+                    std::vector<double> &c_local) {
+  const int rank = grid.Rank();
+  if (layout.a.Parts() != grid.Rows() * grid.Cols() || a_local.size() != layout.a.LocalCount(rank) ||
+      b_local.size() != layout.b.LocalCount(rank)) {
+    throw std::invalid_argument("matmul: local blocks do not match the layout");
+  }
+  c_local.assign(layout.c.LocalCount(rank), 0.0);
+  switch (algorithm) {
+    case Algorithm::kCannon:
+      RequireSquare(grid, algorithm);
+      Cannon(grid, layout, options, a_local, b_local, c_local);
+      return;
+    case Algorithm::kFox:
+      RequireSquare(grid, algorithm);
+      Fox(grid, layout, options, a_local, b_local, c_local);
+      return;
+    case Algorithm::kSumma:
+      if (layout.k > 0) {
+        Summa(grid, layout, options, a_local, b_local, c_local);
+      }
+      return;
+  }
+}
+
+std::vector<double> Multiply(const ProcessGrid &grid, Algorithm algorithm, const std::vector<double> &a,
+                             const std::vector<double> &b, std::size_t m, std::size_t n, std::size_t k,
+                             const Options &options, int root) {
+  const Layout layout = MakeLayout(grid, algorithm, m, n, k);
+  const bool is_root = grid.Rank() == root;
+  const auto a_global = is_root ? Pad(a, m, k, layout.a.Rows(), layout.a.Cols()) : std::vector<double>{};
+  const auto b_global = is_root ? Pad(b, k, n, layout.b.Rows(), layout.b.Cols()) : std::vector<double>{};
+  const auto a_local = ppc::distribution::Scatter(layout.a, a_global, root, grid.Comm());
+  const auto b_local = ppc::distribution::Scatter(layout.b, b_global, root, grid.Comm());
+  std::vector<double> c_local;
+  MultiplyBlocks(grid, layout, algorithm, options, a_local, b_local, c_local);
+  const auto c_global = ppc::distribution::Gather(layout.c, c_local, root, grid.Comm());
+  return is_root ? Unpad(c_global, layout.c.Cols(), m, n) : std::vector<double>{};
+}
+
+}  // namespace ppc::matmul
@@ -0,0 +1,93 @@
+#include "matmul/include/matmul_task.hpp"
+
+#include <mpi.h>
+
+#include <climits>
+#include <cstddef>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "distribution/include/distribution.hpp"
+#include "matmul/include/matmul.hpp"
+
+namespace ppc::matmul {
+
+MatmulTaskMPI::MatmulTaskMPI(const InType &in, Algorithm algorithm, Options options)
+    : algorithm_(algorithm), options_(options) {
+  SetTypeOfTask(GetStaticTypeOfTask());
+  GetInput() = in;
+}
+
+MatmulTaskMPI::~MatmulTaskMPI() {
+  ReleaseGrid();
+}
+
+bool MatmulTaskMPI::ValidationImpl() {
+  const auto &in = GetInput();
+  return in.a.size() == in.m * in.k && in.b.size() == in.k * in.n;
+}
+
+bool MatmulTaskMPI::PreProcessingImpl() {
+  const auto &in = GetInput();
+  int rank = 0;
+  int size = 1;
+  MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+  MPI_Comm_size(MPI_COMM_WORLD, &size);
+  const auto [rows, cols] = GridShape(algorithm_, size);
+  ReleaseGrid();
+  MPI_Comm_split(MPI_COMM_WORLD, rank < rows * cols ? 0 : MPI_UNDEFINED, rank, &grid_comm_);
+  if (grid_comm_ == MPI_COMM_NULL) {
+    return true;
+  }
+  grid_ = std::make_unique<ProcessGrid>(grid_comm_, rows, cols);
+  layout_ = std::make_unique<Layout>(MakeLayout(*grid_, algorithm_, in.m, in.n, in.k));
+  const bool root = grid_->Rank() == 0;
+  const auto a_global = root ? Pad(in.a, in.m, in.k, layout_->a.Rows(), layout_->a.Cols()) : std::vector<double>{};
+  const auto b_global = root ? Pad(in.b, in.k, in.n, layout_->b.Rows(), layout_->b.Cols()) : std::vector<double>{};
+  a_local_ = ppc::distribution::Scatter(layout_->a, a_global, 0, grid_->Comm());
+  b_local_ = ppc::distribution::Scatter(layout_->b, b_global, 0, grid_->Comm());
+  return true;
+}
+
+bool MatmulTaskMPI::RunImpl() {
+  if (grid_) {
+    MultiplyBlocks(*grid_, *layout_, algorithm_, options_, a_local_, b_local_, c_local_);
+  }
+  return true;
+}
+
+bool MatmulTaskMPI::PostProcessingImpl() {
+  const auto &in = GetInput();
+  auto &out = GetOutput();
+  // m and n are the same on every rank, so every rank throws here before entering a collective.
+  const std::size_t count = in.m * in.n;
+  if (count > static_cast<std::size_t>(INT_MAX)) {
+    throw std::invalid_argument("matmul: " + std::to_string(count) + " elements of C do not fit into an MPI count");
+  }
+  out.assign(count, 0.0);
+  if (grid_) {
+    const auto c_global = ppc::distribution::Gather(layout_->c, c_local_, 0, grid_->Comm());
+    if (grid_->Rank() == 0) {
+      out = Unpad(c_global, layout_->c.Cols(), in.m, in.n);
+    }
+  }
+  // World rank 0 is grid rank 0, so it holds C for everyone.
+  MPI_Bcast(out.data(), static_cast<int>(out.size()), MPI_DOUBLE, 0, MPI_COMM_WORLD);
+  ReleaseGrid();
+  return true;
+}
+
+void MatmulTaskMPI::ReleaseGrid() {
+  grid_.reset();
+  layout_.reset();
+  int finalized = 0;
+  MPI_Finalized(&finalized);
+  if (grid_comm_ != MPI_COMM_NULL && finalized == 0) {
+    MPI_Comm_free(&grid_comm_);
+  }
+}
+
+}  // namespace ppc::matmul
@@ -0,0 +1,133 @@
+#include <gtest/gtest.h>
+#include <mpi.h>
+
+#include <array>
+#include <cstddef>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+#include "gemm/include/gemm.hpp"
+#include "matmul/include/matmul.hpp"
+#include "matmul/include/matmul_task.hpp"
+#include "util/include/func_test_util.hpp"
+
+using ppc::matmul::Algorithm;
+using ppc::matmul::ProcessGrid;
+
+namespace {
+
+constexpr std::array<Algorithm, 3> kAllAlgorithms = {Algorithm::kCannon, Algorithm::kFox, Algorithm::kSumma};
+
+int WorldSize() {
+  int size = 1;
+  MPI_Comm_size(MPI_COMM_WORLD, &size);
+  return size;
+}
+
+/// Same on every rank, as the task inputs are.
+std::vector<double> RandomMatrix(std::size_t count, unsigned seed) {
+  std::mt19937_64 gen(seed);
+  std::uniform_real_distribution<double> dist(-1.0, 1.0);
+  std::vector<double> data(count);
+  for (auto &value : data) {
+    value = dist(gen);
+  }
+  return data;
+}
+
+void ExpectClose(const std::vector<double> &actual, const std::vector<double> &expected) {
+  ASSERT_EQ(actual.size(), expected.size());
+  for (std::size_t i = 0; i < actual.size(); i++) {
+    ASSERT_NEAR(actual[i], expected[i], 1e-12) << "at " << i;
+  }
+}
+
+}  // namespace
+
+TEST(Matmul, SquareGridShapeUsesLargestSquare) {
+  EXPECT_EQ(ppc::matmul::GridShape(Algorithm::kCannon, 1), std::make_pair(1, 1));
+  EXPECT_EQ(ppc::matmul::GridShape(Algorithm::kFox, 8), std::make_pair(2, 2));
+  EXPECT_EQ(ppc::matmul::GridShape(Algorithm::kCannon, 9), std::make_pair(3, 3));
+  EXPECT_THROW((void)ppc::matmul::GridShape(Algorithm::kSumma, 0), std::invalid_argument);
+  EXPECT_EQ(ppc::matmul::AlgorithmToString(Algorithm::kSumma), "summa");
+}
+
+TEST(Matmul, PadAndUnpadRoundTrip) {
+  const auto matrix = RandomMatrix(3 * 5, 1);
+  const auto padded = ppc::matmul::Pad(matrix, 3, 5, 4, 6);
+  ASSERT_EQ(padded.size(), 24U);
+  EXPECT_EQ(padded[5], 0.0);
+  EXPECT_EQ(padded[6], matrix[5]);
+  EXPECT_EQ(ppc::matmul::Unpad(padded, 6, 3, 5), matrix);
+  EXPECT_THROW((void)ppc::matmul::Pad(matrix, 3, 5, 2, 6), std::invalid_argument);
+}
+
+TEST(MatmulMPI, GridCommunicatorsFollowCoordinates) {
+  if (!ppc::util::MpiReady()) {
+    GTEST_SKIP() << "MPI is not initialized";
+  }
+  const auto [rows, cols] = ppc::matmul::GridShape(Algorithm::kSumma, WorldSize());
+  const ProcessGrid grid(MPI_COMM_WORLD, rows, cols);
+  int world_rank = 0;
+  MPI_Comm_rank(MPI_COMM_WORLD, &world_rank);
+  EXPECT_EQ(grid.Rank(), world_rank);
+  int row_rank = -1;
+  int col_rank = -1;
+  MPI_Comm_rank(grid.RowComm(), &row_rank);
+  MPI_Comm_rank(grid.ColComm(), &col_rank);
+  EXPECT_EQ(row_rank, grid.Col());
+  EXPECT_EQ(col_rank, grid.Row());
+  EXPECT_EQ(grid.RankOf(grid.Row() + rows, grid.Col() - cols), grid.Rank());
+  EXPECT_THROW(ProcessGrid(MPI_COMM_WORLD, WorldSize() + 1, 1), std::invalid_argument);
+  if (rows != cols) {
+    EXPECT_THROW((void)ppc::matmul::MakeLayout(grid, Algorithm::kCannon, 4, 4, 4), std::invalid_argument);
+  }
+}
+
+TEST(MatmulMPI, SummaHandlesUnevenBlocksAndPanels) {
+  if (!ppc::util::MpiReady()) {
+    GTEST_SKIP() << "MPI is not initialized";
+  }
+  constexpr std::size_t kM = 13;
+  constexpr std::size_t kN = 9;
+  constexpr std::size_t kK = 11;
+  const auto a = RandomMatrix(kM * kK, 2);
+  const auto b = RandomMatrix(kK * kN, 3);
+  const auto expected = ppc::gemm::Multiply(a, b, kM, kN, kK);
+  const auto [rows, cols] = ppc::matmul::GridShape(Algorithm::kSumma, WorldSize());
+  const ProcessGrid grid(MPI_COMM_WORLD, rows, cols);
+  for (const bool overlap : {false, true}) {
+    for (const std::size_t panel : {1UL, 3UL, 256UL}) {
+      const ppc::matmul::Options options{.overlap = overlap, .panel = panel};
+      const auto c = ppc::matmul::Multiply(grid, Algorithm::kSumma, a, b, kM, kN, kK, options);
+      if (grid.Rank() == 0) {
+        ExpectClose(c, expected);
+      } else {
+        EXPECT_TRUE(c.empty());
+      }
+    }
+  }
+}
+
+TEST(MatmulMPI, TasksMatchLocalGemm) {
+  if (!ppc::util::MpiReady()) {
+    GTEST_SKIP() << "MPI is not initialized";
+  }
+  for (const auto &dims : {std::array<std::size_t, 3>{17, 10, 7}, std::array<std::size_t, 3>{2, 3, 1}}) {
+    const auto [m, n, k] = dims;
+    const ppc::matmul::Problem problem{
+        .m = m, .n = n, .k = k, .a = RandomMatrix(m * k, 4), .b = RandomMatrix(k * n, 5)};
+    const auto expected = ppc::gemm::Multiply(problem.a, problem.b, m, n, k);
+    for (const auto algorithm : kAllAlgorithms) {
+      for (const bool overlap : {false, true}) {
+        ppc::matmul::MatmulTaskMPI task(problem, algorithm, {.overlap = overlap});
+        ASSERT_TRUE(task.Validation());
+        ASSERT_TRUE(task.PreProcessing());
+        ASSERT_TRUE(task.Run());
+        ASSERT_TRUE(task.PostProcessing());
+        ExpectClose(task.GetOutput(), expected);
+      }
+    }
+  }
+}
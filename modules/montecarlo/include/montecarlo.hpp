@@ -0,0 +1,221 @@
+#pragma once
+
+#include <mpi.h>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "shared_memory/include/parallel_for.hpp"
+#include "shared_memory/include/shared_memory.hpp"
+
+namespace ppc::montecarlo {
+
+using Backend = ppc::shared_memory::Backend;
+
+/// @brief Counter-based generator: the n-th number of a stream is a pure function of (key, stream, n),
+/// so any stream can be started at any position without generating what comes before.
+enum class Generator : uint8_t {
+  /// Philox4x32-10 (Salmon et al., 2011): 32-bit multiplications, four outputs per counter
+  kPhilox,
+  /// Threefry2x64-20: add/rotate/xor rounds of Threefish, two outputs per counter
+  kThreefry
+};
+
+/// @brief Returns the lower-case name of the generator ("philox", "threefry").
+std::string GeneratorToString(Generator generator);
+
+/// @brief One Philox4x32-10 block.
+std::array<std::uint32_t, 4> Philox4x32(std::array<std::uint32_t, 4> counter, std::array<std::uint32_t, 2> key);
+
+/// @brief One Threefry2x64-20 block.
+std::array<std::uint64_t, 2> Threefry2x64(std::array<std::uint64_t, 2> counter, std::array<std::uint64_t, 2> key);
+
+/// @brief Writes draws [first, first + out.size()) of stream @p stream as doubles uniform in (0, 1).
+/// @details Every counter yields 128 random bits, i.e. two doubles with 53 random bits each. Counters
+/// are processed several at a time in structure-of-arrays form, so the rounds vectorise.
+void FillUniform(Generator generator, std::uint64_t seed, std::uint64_t stream, std::uint64_t first,
+                 std::span<double> out);
+
+/// @brief Count, mean and sum of squared deviations of a sample (Welford), mergeable in any
+/// grouping (Chan et al.).
+struct RunningStats {
+  std::size_t count = 0;
+  double mean = 0.0;
+  double m2 = 0.0;
+
+  void Merge(const RunningStats &other) {
+    if (other.count == 0) {
+      return;
+    }
+    const auto n_a = static_cast<double>(count);
+    const auto n_b = static_cast<double>(other.count);
+    const double n = n_a + n_b;
+    const double delta = other.mean - mean;
+    mean += delta * n_b / n;
+    m2 += other.m2 + (delta * delta * n_a * n_b / n);
+    count += other.count;
+  }
+
+  /// Unbiased sample variance.
+  [[nodiscard]] double Variance() const {
+    return count > 1 ? m2 / static_cast<double>(count - 1) : 0.0;
+  }
+
+  /// Standard error of the mean.
+  [[nodiscard]] double StandardError() const {
+    return count > 1 ? std::sqrt(Variance() / static_cast<double>(count)) : 0.0;
+  }
+};
+
+/// @brief Box [lower, upper] of R^kDim.
+template <std::size_t kDim>
+struct Box {
+  std::array<double, kDim> lower{};
+  std::array<double, kDim> upper{};
+};
+
+template <typename F, std::size_t kDim>
+concept Integrand = std::is_invocable_r_v<double, const F &, const std::array<double, kDim> &>;
+
+struct Options {
+  Generator generator = Generator::kPhilox;
+  std::uint64_t seed = 0;
+  /// Upper bound of the sample count.
+  std::size_t max_samples = std::size_t{1} << 24;
+  /// Stop after the first round whose standard error is at most this; 0 runs max_samples.
+  double target_error = 0.0;
+  /// Samples per block. Block b draws from stream b, and blocks are merged in index order, so the
+  /// estimate depends on neither the rank count nor the thread count.
+  std::size_t block = 4096;
+  /// Blocks per round; the stopping rule is checked between rounds.
+  std::size_t blocks_per_round = 16;
+  /// Thread back-end over the blocks of a round.
+  Backend backend = Backend::kSeq;
+};
+
+struct Result {
+  /// Estimate of the integral and its standard error.
+  double value = 0.0;
+  double error = 0.0;
+  /// Sample variance of f, scaled by the squared volume.
+  double variance = 0.0;
+  std::size_t samples = 0;
+  std::size_t rounds = 0;
+  /// Whether the target error was reached before max_samples.
+  bool converged = false;
+  /// Standard error after every round.
+  std::vector<double> history;
+};
+
+/// @brief Merges per-block statistics in block order. Ranks hold consecutive ranges of the
+/// round's blocks; every rank gets the merged statistics.
+/// @param comm Communicator of the ranks, or MPI_COMM_NULL when @p local holds all blocks.
+RunningStats MergeBlocks(const std::vector<RunningStats> &local, std::size_t blocks, MPI_Comm comm);
+
+/// @brief Validates @p options.
+/// @throws std::invalid_argument When max_samples, block or blocks_per_round is zero, or the
+/// target error is negative or not finite.
+void CheckOptions(const Options &options);
+
+namespace detail {
+
+/// Samples evaluated per uniform fill.
+inline constexpr std::size_t kChunk = 64;
+
+/// Statistics of the first @p samples samples of block @p block.
+template <std::size_t kDim, typename F>
+RunningStats SampleBlock(const F &f, const Box<kDim> &box, const Options &options, std::size_t block,
+                         std::size_t samples) {
+  std::array<double, kChunk * kDim> uniforms{};
+  std::array<double, kChunk> values{};
+  std::array<double, kDim> width{};
+  for (std::size_t d = 0; d < kDim; d++) {
+    width[d] = box.upper[d] - box.lower[d];
+  }
+  RunningStats stats;
+  for (std::size_t first = 0; first < samples; first += kChunk) {
+    const std::size_t count = std::min(kChunk, samples - first);
+    const std::span<double> draws(uniforms.data(), count * kDim);
+    FillUniform(options.generator, options.seed, block, first * kDim, draws);
+    for (std::size_t p = 0; p < count; p++) {
+      std::array<double, kDim> point{};
+      for (std::size_t d = 0; d < kDim; d++) {
+        point[d] = box.lower[d] + (uniforms[(p * kDim) + d] * width[d]);
+      }
+      values[p] = static_cast<double>(f(point));
+    }
+    // Two passes over the chunk, then one merge: no division per sample.
+    double sum = 0.0;
+    for (std::size_t p = 0; p < count; p++) {
+      sum += values[p];
+    }
+    RunningStats chunk{.count = count, .mean = sum / static_cast<double>(count), .m2 = 0.0};
+    for (std::size_t p = 0; p < count; p++) {
+      chunk.m2 += (values[p] - chunk.mean) * (values[p] - chunk.mean);
+    }
+    stats.Merge(chunk);
+  }
+  return stats;
+}
+
+}  // namespace detail
+
+/// @brief Estimates the integral of @p f over @p box from uniform samples.
+/// @details Samples are grouped into blocks of Options::block; sample s of block b takes draws
+/// [s kDim, (s + 1) kDim) of stream b. A round hands its blocks to ranks in consecutive ranges and
+/// to workers one block at a time; the per-block statistics are then merged in block order on every
+/// rank, and the run stops after the first round that reaches Options::target_error. Which rank or
+/// thread evaluated a block never changes its numbers, so the result is reproducible bit for bit
+/// on any back-end, thread count and rank count.
+/// @param comm Communicator of the ranks, or MPI_COMM_NULL for a shared-memory run; the result is
+/// returned on every rank.
+/// @throws std::invalid_argument When the options are invalid (see CheckOptions()).
+template <std::size_t kDim, Integrand<kDim> F>
+  requires(kDim >= 1)
+Result Integrate(const F &f, const Box<kDim> &box, const Options &options = {}, MPI_Comm comm = MPI_COMM_NULL) {
+  CheckOptions(options);
+  double volume = 1.0;
+  for (std::size_t d = 0; d < kDim; d++) {
+    volume *= box.upper[d] - box.lower[d];
+  }
+  int rank = 0;
+  int size = 1;
+  if (comm != MPI_COMM_NULL) {
+    MPI_Comm_rank(comm, &rank);
+    MPI_Comm_size(comm, &size);
+  }
+  const std::size_t blocks = (options.max_samples / options.block) + (options.max_samples % options.block == 0 ? 0 : 1);
+  Result result;
+  RunningStats total;
+  for (std::size_t round_begin = 0; round_begin < blocks; round_begin += options.blocks_per_round) {
+    const std::size_t round_blocks = std::min(options.blocks_per_round, blocks - round_begin);
+    const auto [first, last] = ppc::shared_memory::BlockRange(round_blocks, size, rank);
+    std::vector<RunningStats> local(last - first);
+    ppc::shared_memory::ParallelFor(local.size(), options.backend, [&](std::size_t i) {
+      const std::size_t block = round_begin + first + i;
+      const std::size_t samples = std::min(options.block, options.max_samples - (block * options.block));
+      local[i] = detail::SampleBlock<kDim>(f, box, options, block, samples);
+    });
+    total.Merge(MergeBlocks(local, round_blocks, comm));
+    result.rounds++;
+    result.history.push_back(std::abs(volume) * total.StandardError());
+    if (options.target_error > 0.0 && total.count > 1 && result.history.back() <= options.target_error) {
+      result.converged = true;
+      break;
+    }
+  }
+  result.value = volume * total.mean;
+  result.error = result.history.empty() ? 0.0 : result.history.back();
+  result.variance = volume * volume * total.Variance();
+  result.samples = total.count;
+  return result;
+}
+
+}  // namespace ppc::montecarlo
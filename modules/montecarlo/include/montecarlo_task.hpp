@@ -0,0 +1,74 @@
+#pragma once
+
+#include <mpi.h>
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+
+#include "montecarlo/include/montecarlo.hpp"
+#include "shared_memory/include/parallel_for.hpp"
+#include "task/include/task.hpp"
+
+namespace ppc::montecarlo {
+
+/// @brief Integration box with the sample budget, the stopping error and the seed.
+template <std::size_t kDim>
+struct MonteCarloProblem {
+  Box<kDim> box;
+  std::size_t max_samples = std::size_t{1} << 20;
+  /// 0 runs all max_samples samples.
+  double target_error = 0.0;
+  std::uint64_t seed = 0;
+};
+
+/// @brief Monte Carlo integration of the functor type @p F as a course task on any back-end.
+/// @details The kMPI variant splits every round over MPI_COMM_WORLD; the estimate is the same bits
+/// as on the other back-ends and is returned on every rank.
+template <std::size_t kDim, Integrand<kDim> F, ppc::task::TypeOfTask kType,
+          Generator kGenerator = Generator::kPhilox>
+class MonteCarloTask : public ppc::task::Task<MonteCarloProblem<kDim>, Result> {
+ public:
+  using InType = MonteCarloProblem<kDim>;
+  using OutType = Result;
+
+  static constexpr ppc::task::TypeOfTask GetStaticTypeOfTask() {
+    return kType;
+  }
+
+  explicit MonteCarloTask(const InType &in, F integrand = {}) : integrand_(integrand) {
+    this->SetTypeOfTask(GetStaticTypeOfTask());
+    this->GetInput() = in;
+  }
+
+ private:
+  bool ValidationImpl() override {
+    const InType &in = this->GetInput();
+    return in.max_samples > 0 && std::isfinite(in.target_error) && in.target_error >= 0.0;
+  }
+
+  bool PreProcessingImpl() override {
+    return true;
+  }
+
+  bool RunImpl() override {
+    const InType &in = this->GetInput();
+    const MPI_Comm comm = kType == ppc::task::TypeOfTask::kMPI ? MPI_COMM_WORLD : MPI_COMM_NULL;
+    Options options;
+    options.generator = kGenerator;
+    options.seed = in.seed;
+    options.max_samples = in.max_samples;
+    options.target_error = in.target_error;
+    options.backend = ppc::shared_memory::BackendOf(kType);
+    this->GetOutput() = Integrate<kDim>(integrand_, in.box, options, comm);
+    return true;
+  }
+
+  bool PostProcessingImpl() override {
+    return this->GetOutput().samples > 0;
+  }
+
+  F integrand_;
+};
+
+}  // namespace ppc::montecarlo
@@ -0,0 +1,80 @@
+#include <gtest/gtest.h>
+
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <string>
+#include <tuple>
+
+#include "montecarlo/include/montecarlo.hpp"
+#include "montecarlo/include/montecarlo_task.hpp"
+#include "task/include/task.hpp"
+#include "util/include/perf_test_util.hpp"
+
+namespace ppc::montecarlo::perf {
+
+using ppc::task::TypeOfTask;
+
+namespace {
+
+constexpr std::size_t kDim = 4;
+constexpr std::size_t kSamples = std::size_t{1} << 22;
+
+/// prod_d (1 + x_d^2); its integral over [0, 1]^4 is (4/3)^4.
+struct Polynomial {
+  double operator()(const std::array<double, kDim> &x) const {
+    double value = 1.0;
+    for (const double coordinate : x) {
+      value *= 1.0 + (coordinate * coordinate);
+    }
+    return value;
+  }
+};
+
+}  // namespace
+
+/// Reports samples and uniforms per second (in millions) and the standard error of the estimate.
+class MonteCarloPerfTests : public ppc::util::BaseRunPerfTests<MonteCarloProblem<kDim>, Result> {
+  bool CheckTestOutputData(Result &output_data) final {
+    const double exact = std::pow(4.0 / 3.0, static_cast<double>(kDim));
+    const auto samples = static_cast<double>(output_data.samples);
+    PrintRate("msamples_per_s", 1e-6 * samples);
+    PrintRate("muniforms_per_s", 1e-6 * samples * static_cast<double>(kDim));
+    PrintValue("error", output_data.error);
+    return output_data.samples == kSamples && std::abs(output_data.value - exact) <= 5.0 * output_data.error;
+  }
+
+  MonteCarloProblem<kDim> GetTestInputData() final {
+    MonteCarloProblem<kDim> problem;
+    problem.box.lower.fill(0.0);
+    problem.box.upper.fill(1.0);
+    problem.max_samples = kSamples;
+    problem.seed = 41;
+    return problem;
+  }
+};
+
+/// MonteCarloTask of every back-end for one generator.
+template <Generator kGenerator>
+struct PerfMonteCarloTasks {
+  template <TypeOfTask kType>
+  using Task = MonteCarloTask<kDim, Polynomial, kType, kGenerator>;
+};
+
+template <Generator kGenerator>
+auto MakeBackendSuite() {
+  return ppc::util::MakeBackendPerfTaskTuples<PerfMonteCarloTasks<kGenerator>::template Task, MonteCarloProblem<kDim>>(
+      "ppc_montecarlo", GeneratorToString(kGenerator));
+}
+
+TEST_P(MonteCarloPerfTests, RunPerfModes) {
+  ExecuteTest(GetParam());
+}
+
+const auto kMonteCarloPerfTasks =
+    std::tuple_cat(MakeBackendSuite<Generator::kPhilox>(), MakeBackendSuite<Generator::kThreefry>());
+
+INSTANTIATE_TEST_SUITE_P(CounterBasedMonteCarlo, MonteCarloPerfTests,
+                         ppc::util::TupleToGTestValues(kMonteCarloPerfTasks), MonteCarloPerfTests::CustomPerfTestName);
+
+}  // namespace ppc::montecarlo::perf
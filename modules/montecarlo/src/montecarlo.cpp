@@ -0,0 +1,197 @@
+#include "montecarlo/include/montecarlo.hpp"
+
+#include <mpi.h>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "shared_memory/include/shared_memory.hpp"
+
+namespace ppc::montecarlo {
+
+namespace {
+
+/// Counters generated together; the rounds run over the lanes in the innermost loop.
+constexpr std::size_t kLanes = 8;
+
+constexpr std::uint32_t kPhiloxM0 = 0xD2511F53U;
+constexpr std::uint32_t kPhiloxM1 = 0xCD9E8D57U;
+constexpr std::uint32_t kPhiloxW0 = 0x9E3779B9U;
+constexpr std::uint32_t kPhiloxW1 = 0xBB67AE85U;
+
+constexpr std::uint64_t kThreefryParity = 0x1BD11BDAA9FC1A22ULL;
+constexpr std::array<int, 8> kThreefryRotations = {16, 42, 12, 31, 16, 32, 24, 21};
+
+template <std::size_t kL>
+using Lanes32 = std::array<std::array<std::uint32_t, kL>, 4>;
+template <std::size_t kL>
+using Lanes64 = std::array<std::array<std::uint64_t, kL>, 2>;
+
+template <std::size_t kL>
+void PhiloxRounds(Lanes32<kL> &x, std::array<std::uint32_t, 2> key) {
+  for (int round = 0; round < 10; round++) {
+    for (std::size_t l = 0; l < kL; l++) {
+      const std::uint64_t p0 = std::uint64_t{kPhiloxM0} * x[0][l];
+      const std::uint64_t p1 = std::uint64_t{kPhiloxM1} * x[2][l];
+      const auto y0 = static_cast<std::uint32_t>(p1 >> 32) ^ x[1][l] ^ key[0];
+      const auto y2 = static_cast<std::uint32_t>(p0 >> 32) ^ x[3][l] ^ key[1];
+      x[0][l] = y0;
+      x[1][l] = static_cast<std::uint32_t>(p1);
+      x[2][l] = y2;
+      x[3][l] = static_cast<std::uint32_t>(p0);
+    }
+    key[0] += kPhiloxW0;
+    key[1] += kPhiloxW1;
+  }
+}
+
+constexpr std::uint64_t RotateLeft(std::uint64_t value, int bits) {
+  return (value << bits) | (value >> (64 - bits));
+}
+
+template <std::size_t kL>
+void ThreefryRounds(Lanes64<kL> &x, std::array<std::uint64_t, 2> key) {
+  const std::array<std::uint64_t, 3> schedule = {key[0], key[1], kThreefryParity ^ key[0] ^ key[1]};
+  for (std::size_t l = 0; l < kL; l++) {
+    x[0][l] += schedule[0];
+    x[1][l] += schedule[1];
+  }
+  for (int round = 0; round < 20; round++) {
+    for (std::size_t l = 0; l < kL; l++) {
+      x[0][l] += x[1][l];
+      x[1][l] = RotateLeft(x[1][l], kThreefryRotations[round % 8]) ^ x[0][l];
+    }
+    if (round % 4 == 3) {
+      const auto injection = static_cast<std::uint64_t>((round + 1) / 4);
+      for (std::size_t l = 0; l < kL; l++) {
+        x[0][l] += schedule[injection % 3];
+        x[1][l] += schedule[(injection + 1) % 3] + injection;
+      }
+    }
+  }
+}
+
+/// Top 53 bits of @p bits mapped to the centre of their interval, so 0 and 1 never occur.
+double ToUnit(std::uint64_t bits) {
+  return (static_cast<double>(bits >> 11) + 0.5) * 0x1p-53;
+}
+
+/// Random bits of counters [counter, counter + kLanes) of @p stream, two words per counter.
+std::array<std::uint64_t, 2 * kLanes> Generate(Generator generator, std::uint64_t seed, std::uint64_t stream,
+                                                 std::uint64_t counter) {
+  std::array<std::uint64_t, 2 * kLanes> bits{};
+  if (generator == Generator::kPhilox) {
+    Lanes32<kLanes> x{};
+    for (std::size_t l = 0; l < kLanes; l++) {
+      x[0][l] = static_cast<std::uint32_t>(counter + l);
+      x[1][l] = static_cast<std::uint32_t>((counter + l) >> 32);
+      x[2][l] = static_cast<std::uint32_t>(stream);
+      x[3][l] = static_cast<std::uint32_t>(stream >> 32);
+    }
+    PhiloxRounds(x, {static_cast<std::uint32_t>(seed), static_cast<std::uint32_t>(seed >> 32)});
+    for (std::size_t l = 0; l < kLanes; l++) {
+      bits[2 * l] = (std::uint64_t{x[1][l]} << 32) | x[0][l];
+      bits[(2 * l) + 1] = (std::uint64_t{x[3][l]} << 32) | x[2][l];
+    }
+    return bits;
+  }
+  Lanes64<kLanes> x{};
+  for (std::size_t l = 0; l < kLanes; l++) {
+    x[0][l] = counter + l;
+    x[1][l] = stream;
+  }
+  ThreefryRounds(x, {seed, 0});
+  for (std::size_t l = 0; l < kLanes; l++) {
+    bits[2 * l] = x[0][l];
+    bits[(2 * l) + 1] = x[1][l];
+  }
+  return bits;
+}
+
+}  // namespace
+
+std::string GeneratorToString(Generator generator) {
+  switch (generator) {
+    case Generator::kPhilox:
+      return "philox";
+    case Generator::kThreefry:
+      return "threefry";
+  }
+  return "unknown";
+}
+
+std::array<std::uint32_t, 4> Philox4x32(std::array<std::uint32_t, 4> counter, std::array<std::uint32_t, 2> key) {
+  Lanes32<1> x = {{{counter[0]}, {counter[1]}, {counter[2]}, {counter[3]}}};
+  PhiloxRounds(x, key);
+  return {x[0][0], x[1][0], x[2][0], x[3][0]};
+}
+
+std::array<std::uint64_t, 2> Threefry2x64(std::array<std::uint64_t, 2> counter, std::array<std::uint64_t, 2> key) {
+  Lanes64<1> x = {{{counter[0]}, {counter[1]}}};
+  ThreefryRounds(x, key);
+  return {x[0][0], x[1][0]};
+}
+
+void FillUniform(Generator generator, std::uint64_t seed, std::uint64_t stream, std::uint64_t first,
+                 std::span<double> out) {
+  // Draw n is word n % 2 of counter n / 2.
+  std::size_t written = 0;
+  for (std::uint64_t counter = first / 2; written < out.size(); counter += kLanes) {
+    const auto bits = Generate(generator, seed, stream, counter);
+    const std::size_t skip = written == 0 ? first % 2 : 0;
+    const std::size_t take = std::min(bits.size() - skip, out.size() - written);
+    for (std::size_t i = 0; i < take; i++) {
+      out[written + i] = ToUnit(bits[skip + i]);
+    }
+    written += take;
+  }
+}
+
+RunningStats MergeBlocks(const std::vector<RunningStats> &local, std::size_t blocks, MPI_Comm comm) {
+  RunningStats merged;
+  if (comm == MPI_COMM_NULL) {
+    for (const auto &stats : local) {
+      merged.Merge(stats);
+    }
+    return merged;
+  }
+  int size = 1;
+  MPI_Comm_size(comm, &size);
+  std::vector<int> counts(static_cast<std::size_t>(size));
+  std::vector<int> displs(static_cast<std::size_t>(size));
+  for (int r = 0; r < size; r++) {
+    const auto [begin, end] = ppc::shared_memory::BlockRange(blocks, size, r);
+    counts[static_cast<std::size_t>(r)] = static_cast<int>(3 * (end - begin));
+    displs[static_cast<std::size_t>(r)] = static_cast<int>(3 * begin);
+  }
+  std::vector<double> packed;
+  packed.reserve(3 * local.size());
+  for (const auto &stats : local) {
+    packed.insert(packed.end(), {static_cast<double>(stats.count), stats.mean, stats.m2});
+  }
+  std::vector<double> all(3 * blocks);
+  MPI_Allgatherv(packed.data(), static_cast<int>(packed.size()), MPI_DOUBLE, all.data(), counts.data(),
+                 displs.data(), MPI_DOUBLE, comm);
+  for (std::size_t b = 0; b < blocks; b++) {
+    merged.Merge({.count = static_cast<std::size_t>(all[3 * b]), .mean = all[(3 * b) + 1], .m2 = all[(3 * b) + 2]});
+  }
+  return merged;
+}
+
+void CheckOptions(const Options &options) {
+  if (options.max_samples == 0 || options.block == 0 || options.blocks_per_round == 0) {
+    throw std::invalid_argument("montecarlo: max_samples, block and blocks_per_round must be positive");
+  }
+  if (!std::isfinite(options.target_error) || options.target_error < 0.0) {
+    throw std::invalid_argument("montecarlo: target_error must be finite and non-negative");
+  }
+}
+
+}  // namespace ppc::montecarlo
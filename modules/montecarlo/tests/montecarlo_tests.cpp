@@ -0,0 +1,171 @@
+#include <gtest/gtest.h>
+#include <mpi.h>
+
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "montecarlo/include/montecarlo.hpp"
+#include "montecarlo/include/montecarlo_task.hpp"
+#include "shared_memory/include/parallel_for.hpp"
+#include "task/include/task.hpp"
+#include "util/include/func_test_util.hpp"
+
+using ppc::montecarlo::Backend;
+using ppc::montecarlo::Box;
+using ppc::montecarlo::Generator;
+using ppc::task::TypeOfTask;
+
+namespace {
+
+constexpr std::array<Backend, 4> kAllBackends = {Backend::kSeq, Backend::kOmp, Backend::kTbb, Backend::kStl};
+constexpr std::array<Generator, 2> kAllGenerators = {Generator::kPhilox, Generator::kThreefry};
+
+/// prod_d cos(x_d); its integral over [0, 1]^3 is sin(1)^3.
+struct CosProduct {
+  double operator()(const std::array<double, 3> &x) const {
+    return std::cos(x[0]) * std::cos(x[1]) * std::cos(x[2]);
+  }
+};
+
+const Box<3> kUnitCube{.lower = {0.0, 0.0, 0.0}, .upper = {1.0, 1.0, 1.0}};
+
+double Exact() {
+  return std::pow(std::sin(1.0), 3.0);
+}
+
+}  // namespace
+
+TEST(MonteCarlo, GeneratorsMatchTheRandom123KnownAnswers) {
+  EXPECT_EQ(ppc::montecarlo::Philox4x32({0, 0, 0, 0}, {0, 0}),
+            (std::array<std::uint32_t, 4>{0x6627e8d5U, 0xe169c58dU, 0xbc57ac4cU, 0x9b00dbd8U}));
+  EXPECT_EQ(ppc::montecarlo::Philox4x32({~0U, ~0U, ~0U, ~0U}, {~0U, ~0U}),
+            (std::array<std::uint32_t, 4>{0x408f276dU, 0x41c83b0eU, 0xa20bc7c6U, 0x6d5451fdU}));
+  EXPECT_EQ(ppc::montecarlo::Philox4x32({0x243f6a88U, 0x85a308d3U, 0x13198a2eU, 0x03707344U},
+                                        {0xa4093822U, 0x299f31d0U}),
+            (std::array<std::uint32_t, 4>{0xd16cfe09U, 0x94fdccebU, 0x5001e420U, 0x24126ea1U}));
+  EXPECT_EQ(ppc::montecarlo::Threefry2x64({0, 0}, {0, 0}),
+            (std::array<std::uint64_t, 2>{0xc2b6e3a8c2c69865ULL, 0x6f81ed42f350084dULL}));
+  EXPECT_EQ(ppc::montecarlo::Threefry2x64({~0ULL, ~0ULL}, {~0ULL, ~0ULL}),
+            (std::array<std::uint64_t, 2>{0xe02cb7c4d95d277aULL, 0xd06633d0893b8b68ULL}));
+}
+
+TEST(MonteCarlo, StreamsCanBeEnteredAtAnyDraw) {
+  for (const Generator generator : kAllGenerators) {
+    std::vector<double> whole(1000);
+    ppc::montecarlo::FillUniform(generator, 7, 3, 0, whole);
+    double mean = 0.0;
+    for (const double u : whole) {
+      ASSERT_GT(u, 0.0);
+      ASSERT_LT(u, 1.0);
+      mean += u / static_cast<double>(whole.size());
+    }
+    EXPECT_NEAR(mean, 0.5, 0.05);
+    for (const std::size_t first : {1U, 16U, 333U}) {
+      std::vector<double> part(101);
+      ppc::montecarlo::FillUniform(generator, 7, 3, first, part);
+      for (std::size_t i = 0; i < part.size(); i++) {
+        ASSERT_EQ(part[i], whole[first + i]) << ppc::montecarlo::GeneratorToString(generator) << " " << first;
+      }
+    }
+    std::vector<double> other(whole.size());
+    ppc::montecarlo::FillUniform(generator, 7, 4, 0, other);
+    EXPECT_NE(other, whole);
+  }
+}
+
+TEST(MonteCarlo, EstimateIsTheSameBitsOnEveryBackend) {
+  for (const Generator generator : kAllGenerators) {
+    ppc::montecarlo::Options options;
+    options.generator = generator;
+    options.seed = 11;
+    options.max_samples = 100000;
+    options.block = 1000;
+    options.blocks_per_round = 7;
+    const auto reference = ppc::montecarlo::Integrate<3>(CosProduct{}, kUnitCube, options);
+    EXPECT_EQ(reference.samples, options.max_samples);
+    EXPECT_EQ(reference.rounds, 15U);
+    EXPECT_NEAR(reference.value, Exact(), 5.0 * reference.error);
+    EXPECT_LT(reference.error, 1e-3);
+    for (const Backend backend : kAllBackends) {
+      options.backend = backend;
+      const auto result = ppc::montecarlo::Integrate<3>(CosProduct{}, kUnitCube, options);
+      EXPECT_EQ(result.value, reference.value) << ppc::shared_memory::BackendToString(backend);
+      EXPECT_EQ(result.error, reference.error);
+      EXPECT_EQ(result.history, reference.history);
+    }
+  }
+}
+
+TEST(MonteCarlo, StopsOnceTheTargetErrorIsReached) {
+  ppc::montecarlo::Options options;
+  options.max_samples = std::size_t{1} << 22;
+  options.target_error = 3e-4;
+  const auto result = ppc::montecarlo::Integrate<3>(CosProduct{}, kUnitCube, options);
+  EXPECT_TRUE(result.converged);
+  ASSERT_GE(result.history.size(), 2U);
+  EXPECT_LE(result.error, options.target_error);
+  EXPECT_GT(result.history[result.history.size() - 2], options.target_error);
+  EXPECT_LT(result.samples, options.max_samples);
+  EXPECT_NEAR(result.value, Exact(), 5.0 * result.error);
+  // The error falls like 1 / sqrt(samples).
+  const double sigma = std::sqrt(result.variance);
+  EXPECT_NEAR(result.error, sigma / std::sqrt(static_cast<double>(result.samples)), 1e-12);
+
+  options.target_error = -1.0;
+  EXPECT_THROW((void)ppc::montecarlo::Integrate<3>(CosProduct{}, kUnitCube, options), std::invalid_argument);
+  options.target_error = 0.0;
+  options.block = 0;
+  EXPECT_THROW((void)ppc::montecarlo::Integrate<3>(CosProduct{}, kUnitCube, options), std::invalid_argument);
+}
+
+TEST(MonteCarlo, DistributedRoundsMatchTheSharedMemoryEstimate) {
+  if (!ppc::util::MpiReady()) {
+    GTEST_SKIP() << "MPI is not initialized";
+  }
+  for (const Generator generator : kAllGenerators) {
+    for (const double target : {0.0, 3e-3}) {
+      ppc::montecarlo::Options options;
+      options.generator = generator;
+      options.max_samples = 200003;
+      options.block = 512;
+      options.blocks_per_round = 5;
+      options.target_error = target;
+      const auto whole = ppc::montecarlo::Integrate<3>(CosProduct{}, kUnitCube, options);
+      options.backend = Backend::kOmp;
+      const auto result = ppc::montecarlo::Integrate<3>(CosProduct{}, kUnitCube, options, MPI_COMM_WORLD);
+      EXPECT_EQ(result.value, whole.value);
+      EXPECT_EQ(result.samples, whole.samples);
+      EXPECT_EQ(result.rounds, whole.rounds);
+      EXPECT_EQ(result.converged, whole.converged);
+    }
+  }
+}
+
+template <TypeOfTask kType, Generator kGenerator>
+void RunMonteCarloTask() {
+  const ppc::montecarlo::MonteCarloProblem<3> problem{
+      .box = kUnitCube, .max_samples = 1U << 18, .target_error = 0.0, .seed = 5};
+  ppc::montecarlo::MonteCarloTask<3, CosProduct, kType, kGenerator> task(problem);
+  ASSERT_TRUE(task.Validation());
+  ASSERT_TRUE(task.PreProcessing());
+  ASSERT_TRUE(task.Run());
+  ASSERT_TRUE(task.PostProcessing());
+  EXPECT_EQ(task.GetOutput().samples, problem.max_samples);
+  EXPECT_NEAR(task.GetOutput().value, Exact(), 5.0 * task.GetOutput().error);
+}
+
+TEST(MonteCarlo, TasksIntegrateOnEveryBackend) {
+  RunMonteCarloTask<TypeOfTask::kSEQ, Generator::kPhilox>();
+  RunMonteCarloTask<TypeOfTask::kOMP, Generator::kThreefry>();
+  RunMonteCarloTask<TypeOfTask::kTBB, Generator::kPhilox>();
+  RunMonteCarloTask<TypeOfTask::kSTL, Generator::kThreefry>();
+  if (ppc::util::MpiReady()) {
+    RunMonteCarloTask<TypeOfTask::kMPI, Generator::kPhilox>();
+    RunMonteCarloTask<TypeOfTask::kMPI, Generator::kThreefry>();
+  }
+}
@@ -0,0 +1,187 @@
+#pragma once
+
+#include <mpi.h>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <type_traits>
+#include <vector>
+
+#include "shared_memory/include/parallel_for.hpp"
+#include "shared_memory/include/shared_memory.hpp"
+
+namespace ppc::optimization {
+
+using Backend = ppc::shared_memory::Backend;
+
+struct Options {
+  /// Reliability r > 1: the Lipschitz constant used is r times the largest observed slope.
+  double reliability = 2.0;
+  /// Stop once the interval of the best characteristic is shorter than epsilon * (upper - lower).
+  double epsilon = 1e-4;
+  /// Stop after this many trials, converged or not.
+  std::size_t max_trials = 10000;
+  /// Trials per step on every rank: the intervals with the best characteristics are split together.
+  std::size_t points_per_step = 1;
+  /// Thread back-end of the trial evaluations.
+  Backend backend = Backend::kSeq;
+};
+
+struct Result {
+  /// Best trial point and its value.
+  double x = 0.0;
+  double value = 0.0;
+  std::size_t trials = 0;
+  std::size_t steps = 0;
+  bool converged = false;
+  double seconds = 0.0;
+};
+
+/// @brief Strongin's information-statistical global search on [lower, upper], with the trials of a
+/// step taken in the intervals of the best characteristics.
+/// @details Trial points and values are kept in two sorted arrays, so the characteristics of all
+/// intervals are one contiguous pass; a step's trials are merged into them in one pass as well. The
+/// largest slope M only grows as trials are added, so it is updated from the new intervals alone.
+/// The engine does not evaluate anything: Propose() returns points and Record() takes their values,
+/// which lets the drivers evaluate a step on threads or ranks.
+class Strongin {
+ public:
+  /// @throws std::invalid_argument When the bounds are not finite with lower < upper, reliability
+  /// <= 1, epsilon <= 0, max_trials < 2 or points_per_step == 0.
+  Strongin(double lower, double upper, const Options &options);
+
+  /// @brief Points of the next step, one in each of the @p count intervals with the largest
+  /// characteristics, in increasing order. Returns nothing once converged.
+  std::vector<double> Propose(std::size_t count);
+
+  /// @brief Adds the trials @p points (in any order, distinct from the existing ones) with their values.
+  void Record(std::span<const double> points, std::span<const double> values);
+
+  [[nodiscard]] bool Converged() const {
+    return converged_;
+  }
+
+  [[nodiscard]] std::size_t Trials() const {
+    return x_.size();
+  }
+
+  /// @brief Best trial, trial and step counts; seconds is left to the caller.
+  [[nodiscard]] Result Report() const;
+
+ private:
+  double lower_;
+  double upper_;
+  Options options_;
+  std::vector<double> x_;
+  std::vector<double> z_;
+  double slope_ = 0.0;
+  std::size_t best_ = 0;
+  std::size_t steps_ = 0;
+  bool converged_ = false;
+};
+
+/// @brief Gathers the values of a step: each rank filled the BlockRange share of @p values for its
+/// rank, and every rank gets all of them.
+void ShareValues(std::vector<double> &values, MPI_Comm comm);
+
+template <typename F>
+concept Objective = std::is_invocable_r_v<double, const F &, double>;
+
+template <typename F>
+concept Objective2d = std::is_invocable_r_v<double, const F &, double, double>;
+
+/// @brief Minimises @p f on [lower, upper] by Strongin's global search.
+/// @details Every step proposes points_per_step trials per rank; ranks evaluate their share of the
+/// step on the thread back-end and exchange the values, so all ranks keep the same trial set and
+/// return the same result. A run with p points per step on s ranks takes exactly the trials of a
+/// shared-memory run with p * s points per step.
+/// @param comm Communicator of the ranks, or MPI_COMM_NULL for a shared-memory search.
+/// @throws std::invalid_argument When the bounds or options are invalid (see Strongin).
+template <Objective F>
+Result Minimize(const F &f, double lower, double upper, const Options &options = {}, MPI_Comm comm = MPI_COMM_NULL) {
+  const auto start = std::chrono::steady_clock::now();
+  Strongin engine(lower, upper, options);
+  int rank = 0;
+  int size = 1;
+  if (comm != MPI_COMM_NULL) {
+    MPI_Comm_rank(comm, &rank);
+    MPI_Comm_size(comm, &size);
+  }
+  const std::array<double, 2> ends = {lower, upper};
+  engine.Record(ends, std::array<double, 2>{f(lower), f(upper)});
+  std::vector<double> values;
+  while (engine.Trials() < options.max_trials) {
+    const std::size_t count =
+        std::min(options.points_per_step * static_cast<std::size_t>(size), options.max_trials - engine.Trials());
+    const std::vector<double> points = engine.Propose(count);
+    if (engine.Converged()) {
+      break;
+    }
+    values.assign(points.size(), 0.0);
+    const auto [begin, end] = ppc::shared_memory::BlockRange(points.size(), size, rank);
+    ppc::shared_memory::ParallelFor(end - begin, options.backend,
+                                    [&](std::size_t i) { values[begin + i] = f(points[begin + i]); });
+    ShareValues(values, comm);
+    engine.Record(points, values);
+  }
+  Result result = engine.Report();
+  result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+  return result;
+}
+
+struct NestedResult {
+  /// Best point and its value.
+  std::array<double, 2> point{};
+  double value = 0.0;
+  /// Evaluations of f over all ranks, and trials of the outer search.
+  std::size_t trials = 0;
+  std::size_t outer_trials = 0;
+  bool converged = false;
+  double seconds = 0.0;
+};
+
+/// @brief Minimises f(x, y) on a box by the multistep scheme: the outer search minimises
+/// phi(x) = min_y f(x, y), and every outer trial runs a sequential inner search over y.
+/// @details The outer search is Minimize() with its threads and ranks, so the inner searches of a
+/// step run in parallel. The minimiser y is recovered by repeating the inner search at the best x.
+/// @param outer Options of the search over x, including the back-end.
+/// @param inner Options of the searches over y; their back-end is ignored.
+/// @param comm Communicator of the ranks, or MPI_COMM_NULL for a shared-memory search.
+template <Objective2d F>
+NestedResult MinimizeNested(const F &f, const std::array<double, 2> &lower, const std::array<double, 2> &upper,
+                            const Options &outer, const Options &inner, MPI_Comm comm = MPI_COMM_NULL) {
+  const auto start = std::chrono::steady_clock::now();
+  Options sequential = inner;
+  sequential.backend = Backend::kSeq;
+  std::atomic<std::size_t> inner_trials{0};
+  const auto search_y = [&](double x) {
+    return Minimize([&](double y) { return f(x, y); }, lower[1], upper[1], sequential);
+  };
+  const auto phi = [&](double x) {
+    const Result line = search_y(x);
+    inner_trials.fetch_add(line.trials, std::memory_order_relaxed);
+    return line.value;
+  };
+  const Result result_x = Minimize(phi, lower[0], upper[0], outer, comm);
+  const Result result_y = search_y(result_x.x);
+
+  std::uint64_t trials = inner_trials.load();
+  if (comm != MPI_COMM_NULL) {
+    MPI_Allreduce(MPI_IN_PLACE, &trials, 1, MPI_UINT64_T, MPI_SUM, comm);
+  }
+  NestedResult result;
+  result.point = {result_x.x, result_y.x};
+  result.value = result_y.value;
+  result.trials = trials + result_y.trials;
+  result.outer_trials = result_x.trials;
+  result.converged = result_x.converged;
+  result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+  return result;
+}
+
+}  // namespace ppc::optimization
@@ -0,0 +1,128 @@
+#pragma once
+
+#include <mpi.h>
+
+#include <array>
+#include <cstddef>
+
+#include "optimization/include/optimization.hpp"
+#include "shared_memory/include/parallel_for.hpp"
+#include "task/include/task.hpp"
+
+namespace ppc::optimization {
+
+/// @brief Objective, interval and stopping rule of a 1D global search.
+template <typename F>
+struct SearchProblem {
+  F f{};
+  double lower = 0.0;
+  double upper = 1.0;
+  double epsilon = 1e-4;
+  std::size_t max_trials = 10000;
+  std::size_t points_per_step = 1;
+};
+
+/// @brief Objective, box and stopping rules of a nested 2D global search.
+template <typename F>
+struct NestedProblem {
+  F f{};
+  std::array<double, 2> lower{0.0, 0.0};
+  std::array<double, 2> upper{1.0, 1.0};
+  double epsilon = 1e-3;
+  std::size_t max_trials = 10000;
+  std::size_t points_per_step = 1;
+};
+
+/// @brief Strongin's search for the minimum of the functor type @p F as a course task on any back-end.
+/// @details The kMPI variant evaluates the trials of a step on the ranks of MPI_COMM_WORLD; the
+/// result is returned on every rank.
+template <Objective F, ppc::task::TypeOfTask kType>
+class GlobalSearchTask : public ppc::task::Task<SearchProblem<F>, Result> {
+ public:
+  using InType = SearchProblem<F>;
+  using OutType = Result;
+
+  static constexpr ppc::task::TypeOfTask GetStaticTypeOfTask() {
+    return kType;
+  }
+
+  explicit GlobalSearchTask(const InType &in) {
+    this->SetTypeOfTask(GetStaticTypeOfTask());
+    this->GetInput() = in;
+  }
+
+ private:
+  bool ValidationImpl() override {
+    const InType &in = this->GetInput();
+    return in.lower < in.upper && in.epsilon > 0.0 && in.max_trials >= 2 && in.points_per_step > 0;
+  }
+
+  bool PreProcessingImpl() override {
+    return true;
+  }
+
+  bool RunImpl() override {
+    const InType &in = this->GetInput();
+    const MPI_Comm comm = kType == ppc::task::TypeOfTask::kMPI ? MPI_COMM_WORLD : MPI_COMM_NULL;
+    Options options;
+    options.epsilon = in.epsilon;
+    options.max_trials = in.max_trials;
+    options.points_per_step = in.points_per_step;
+    options.backend = ppc::shared_memory::BackendOf(kType);
+    this->GetOutput() = Minimize(in.f, in.lower, in.upper, options, comm);
+    return true;
+  }
+
+  bool PostProcessingImpl() override {
+    return this->GetOutput().trials >= 2;
+  }
+};
+
+/// @brief Multistep 2D search for the minimum of the functor type @p F as a course task on any back-end.
+/// @details Both levels use the problem's epsilon, trial cap and points per step; the outer level
+/// runs on the task's back-end and, for kMPI, on the ranks of MPI_COMM_WORLD.
+template <Objective2d F, ppc::task::TypeOfTask kType>
+class NestedSearchTask : public ppc::task::Task<NestedProblem<F>, NestedResult> {
+ public:
+  using InType = NestedProblem<F>;
+  using OutType = NestedResult;
+
+  static constexpr ppc::task::TypeOfTask GetStaticTypeOfTask() {
+    return kType;
+  }
+
+  explicit NestedSearchTask(const InType &in) {
+    this->SetTypeOfTask(GetStaticTypeOfTask());
+    this->GetInput() = in;
+  }
+
+ private:
+  bool ValidationImpl() override {
+    const InType &in = this->GetInput();
+    return in.lower[0] < in.upper[0] && in.lower[1] < in.upper[1] && in.epsilon > 0.0 && in.max_trials >= 2 &&
+           in.points_per_step > 0;
+  }
+
+  bool PreProcessingImpl() override {
+    return true;
+  }
+
+  bool RunImpl() override {
+    const InType &in = this->GetInput();
+    const MPI_Comm comm = kType == ppc::task::TypeOfTask::kMPI ? MPI_COMM_WORLD : MPI_COMM_NULL;
+    Options inner;
+    inner.epsilon = in.epsilon;
+    inner.max_trials = in.max_trials;
+    Options outer = inner;
+    outer.points_per_step = in.points_per_step;
+    outer.backend = ppc::shared_memory::BackendOf(kType);
+    this->GetOutput() = MinimizeNested(in.f, in.lower, in.upper, outer, inner, comm);
+    return true;
+  }
+
+  bool PostProcessingImpl() override {
+    return this->GetOutput().trials > this->GetOutput().outer_trials;
+  }
+};
+
+}  // namespace ppc::optimization
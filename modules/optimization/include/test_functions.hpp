@@ -0,0 +1,77 @@
+#pragma once
+
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <numbers>
+
+namespace ppc::optimization {
+
+/// @brief Hill's class of multiextremal functions on [0, 1]:
+/// f(x) = a_0 + sum_{i=1}^{14} (a_i sin(2 pi i x) + b_i cos(2 pi i x)), with coefficients uniform in
+/// [-1, 1] drawn from @p seed.
+class HillFunction {
+ public:
+  static constexpr std::size_t kTerms = 14;
+
+  explicit HillFunction(std::uint32_t seed = 1);
+
+  double operator()(double x) const {
+    double value = a_[0];
+    for (std::size_t i = 1; i <= kTerms; i++) {
+      const double phase = 2.0 * std::numbers::pi * static_cast<double>(i) * x;
+      value += (a_[i] * std::sin(phase)) + (b_[i] * std::cos(phase));
+    }
+    return value;
+  }
+
+ private:
+  std::array<double, kTerms + 1> a_{};
+  std::array<double, kTerms + 1> b_{};
+};
+
+/// @brief Grishagin's class of multiextremal functions on [0, 1]^2:
+/// f(x, y) = -sqrt((sum_ij A_ij a_ij + B_ij b_ij)^2 + (sum_ij C_ij a_ij - D_ij b_ij)^2), with
+/// a_ij = sin(pi i x) sin(pi j y), b_ij = cos(pi i x) cos(pi j y), i, j = 1..7 and coefficients
+/// uniform in [-1, 1] drawn from @p seed.
+class GrishaginFunction {
+ public:
+  static constexpr std::size_t kTerms = 7;
+
+  explicit GrishaginFunction(std::uint32_t seed = 1);
+
+  double operator()(double x, double y) const {
+    std::array<double, kTerms> sin_x{};
+    std::array<double, kTerms> cos_x{};
+    std::array<double, kTerms> sin_y{};
+    std::array<double, kTerms> cos_y{};
+    for (std::size_t i = 0; i < kTerms; i++) {
+      const double frequency = std::numbers::pi * static_cast<double>(i + 1);
+      sin_x[i] = std::sin(frequency * x);
+      cos_x[i] = std::cos(frequency * x);
+      sin_y[i] = std::sin(frequency * y);
+      cos_y[i] = std::cos(frequency * y);
+    }
+    double first = 0.0;
+    double second = 0.0;
+    for (std::size_t i = 0; i < kTerms; i++) {
+      for (std::size_t j = 0; j < kTerms; j++) {
+        const double a = sin_x[i] * sin_y[j];
+        const double b = cos_x[i] * cos_y[j];
+        first += (a_[i][j] * a) + (b_[i][j] * b);
+        second += (c_[i][j] * a) - (d_[i][j] * b);
+      }
+    }
+    return -std::sqrt((first * first) + (second * second));
+  }
+
+ private:
+  using Table = std::array<std::array<double, kTerms>, kTerms>;
+  Table a_{};
+  Table b_{};
+  Table c_{};
+  Table d_{};
+};
+
+}  // namespace ppc::optimization
@@ -0,0 +1,102 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <string>
+
+#include "optimization/include/optimization.hpp"
+#include "optimization/include/optimization_task.hpp"
+#include "optimization/include/test_functions.hpp"
+#include "task/include/task.hpp"
+#include "util/include/perf_test_util.hpp"
+
+namespace ppc::optimization::perf {
+
+using ppc::task::TypeOfTask;
+
+namespace {
+
+constexpr std::size_t kPointsPerStep = 8;
+
+}  // namespace
+
+/// Reports trials per second of a 1D search on a Hill function, and its steps.
+class HillPerfTests : public ppc::util::BaseRunPerfTests<SearchProblem<HillFunction>, Result> {
+  bool CheckTestOutputData(Result &output_data) final {
+    PrintRate("trials_per_s", static_cast<double>(output_data.trials));
+    PrintValue("trials", static_cast<double>(output_data.trials));
+    PrintValue("steps", static_cast<double>(output_data.steps));
+    const HillFunction f(kSeed);
+    double grid = std::numeric_limits<double>::infinity();
+    for (std::size_t i = 0; i <= 100000; i++) {
+      grid = std::min(grid, f(static_cast<double>(i) * 1e-5));
+    }
+    return output_data.converged && output_data.value <= grid + 1e-6;
+  }
+
+  SearchProblem<HillFunction> GetTestInputData() final {
+    SearchProblem<HillFunction> problem;
+    problem.f = HillFunction(kSeed);
+    problem.epsilon = 1e-7;
+    problem.max_trials = 100000;
+    problem.points_per_step = kPointsPerStep;
+    return problem;
+  }
+
+  static constexpr std::uint32_t kSeed = 3;
+};
+
+/// Reports evaluations per second of a nested 2D search on a Grishagin function, and its trials.
+class GrishaginPerfTests : public ppc::util::BaseRunPerfTests<NestedProblem<GrishaginFunction>, NestedResult> {
+  bool CheckTestOutputData(NestedResult &output_data) final {
+    PrintRate("trials_per_s", static_cast<double>(output_data.trials));
+    PrintValue("trials", static_cast<double>(output_data.trials));
+    PrintValue("outer_trials", static_cast<double>(output_data.outer_trials));
+    return output_data.converged && output_data.trials > output_data.outer_trials;
+  }
+
+  NestedProblem<GrishaginFunction> GetTestInputData() final {
+    NestedProblem<GrishaginFunction> problem;
+    problem.f = GrishaginFunction(kSeed);
+    problem.epsilon = 1e-4;
+    problem.max_trials = 100000;
+    problem.points_per_step = kPointsPerStep;
+    return problem;
+  }
+
+  static constexpr std::uint32_t kSeed = 5;
+};
+
+/// Search task of every back-end for one objective.
+template <template <typename, TypeOfTask> class Task, typename F>
+struct PerfSearchTasks {
+  template <TypeOfTask kType>
+  using Of = Task<F, kType>;
+};
+
+template <template <typename, TypeOfTask> class Task, typename F>
+auto MakeBackendSuite(const std::string &kernel) {
+  using InType = typename Task<F, TypeOfTask::kSEQ>::InType;
+  return ppc::util::MakeBackendPerfTaskTuples<PerfSearchTasks<Task, F>::template Of, InType>("ppc_optimization",
+                                                                                          kernel);
+}
+
+TEST_P(HillPerfTests, RunPerfModes) {
+  ExecuteTest(GetParam());
+}
+
+TEST_P(GrishaginPerfTests, RunPerfModes) {
+  ExecuteTest(GetParam());
+}
+
+const auto kHillPerfTasks = MakeBackendSuite<GlobalSearchTask, HillFunction>("hill");
+const auto kGrishaginPerfTasks = MakeBackendSuite<NestedSearchTask, GrishaginFunction>("grishagin");
+
+INSTANTIATE_TEST_SUITE_P(StronginHill, HillPerfTests, ppc::util::TupleToGTestValues(kHillPerfTasks),
+                         HillPerfTests::CustomPerfTestName);
+INSTANTIATE_TEST_SUITE_P(StronginGrishagin, GrishaginPerfTests, ppc::util::TupleToGTestValues(kGrishaginPerfTasks),
+                         GrishaginPerfTests::CustomPerfTestName);
+
+}  // namespace ppc::optimization::perf
@@ -0,0 +1,150 @@
+#include "optimization/include/optimization.hpp"
+
+#include <mpi.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <numeric>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+#include "shared_memory/include/shared_memory.hpp"
+
+namespace ppc::optimization {
+
+Strongin::Strongin(double lower, double upper, const Options &options)
+    : lower_(lower), upper_(upper), options_(options) {
+  if (!std::isfinite(lower) || !std::isfinite(upper) || !(lower < upper)) {
+    throw std::invalid_argument("optimization: bounds must be finite with lower < upper");
+  }
+  if (!(options.reliability > 1.0) || !(options.epsilon > 0.0)) {
+    throw std::invalid_argument("optimization: reliability must exceed 1 and epsilon must be positive");
+  }
+  if (options.max_trials < 2 || options.points_per_step == 0) {
+    throw std::invalid_argument("optimization: max_trials must be at least 2 and points_per_step positive");
+  }
+}
+
+std::vector<double> Strongin::Propose(std::size_t count) {
+  if (converged_ || x_.size() < 2 || count == 0) {
+    return {};
+  }
+  const std::size_t intervals = x_.size() - 1;
+  const double m = slope_ > 0.0 ? options_.reliability * slope_ : 1.0;
+  std::vector<double> characteristic(intervals);
+  for (std::size_t i = 0; i < intervals; i++) {
+    const double dx = x_[i + 1] - x_[i];
+    const double dz = z_[i + 1] - z_[i];
+    characteristic[i] = (m * dx) + ((dz * dz) / (m * dx)) - (2.0 * (z_[i + 1] + z_[i]));
+  }
+  // Ties go to the leftmost interval, so that every rank and back-end picks the same ones.
+  std::vector<std::size_t> order(intervals);
+  std::iota(order.begin(), order.end(), std::size_t{0});
+  const std::size_t chosen = std::min(count, intervals);
+  std::partial_sort(order.begin(), order.begin() + static_cast<std::ptrdiff_t>(chosen), order.end(),
+                    [&](std::size_t a, std::size_t b) {
+    return characteristic[a] > characteristic[b] || (characteristic[a] == characteristic[b] && a < b);
+  });
+  order.resize(chosen);
+
+  // Intervals already below the accuracy are not split again; the search stops when the best one is.
+  const double accuracy = options_.epsilon * (upper_ - lower_);
+  const auto too_short = [&](std::size_t i) { return x_[i + 1] - x_[i] <= accuracy; };
+  if (too_short(order.front())) {
+    converged_ = true;
+    return {};
+  }
+  std::erase_if(order, too_short);
+  std::ranges::sort(order);
+
+  std::vector<double> points(order.size());
+  for (std::size_t k = 0; k < order.size(); k++) {
+    const std::size_t i = order[k];
+    points[k] = (0.5 * (x_[i + 1] + x_[i])) - ((z_[i + 1] - z_[i]) / (2.0 * m));
+  }
+  steps_++;
+  return points;
+}
+
+void Strongin::Record(std::span<const double> points, std::span<const double> values) {
+  if (points.size() != values.size()) {
+    throw std::invalid_argument("optimization: every trial point needs one value");
+  }
+  if (points.empty()) {
+    return;
+  }
+  std::vector<std::size_t> order(points.size());
+  std::iota(order.begin(), order.end(), std::size_t{0});
+  std::ranges::sort(order, [&](std::size_t a, std::size_t b) { return points[a] < points[b]; });
+
+  const std::size_t total = x_.size() + points.size();
+  std::vector<double> x(total);
+  std::vector<double> z(total);
+  std::vector<std::size_t> inserted;
+  inserted.reserve(points.size());
+  std::size_t old = 0;
+  std::size_t next = 0;
+  std::size_t best = 0;
+  for (std::size_t k = 0; k < total; k++) {
+    if (next < order.size() && (old == x_.size() || points[order[next]] < x_[old])) {
+      x[k] = points[order[next]];
+      z[k] = values[order[next]];
+      inserted.push_back(k);
+      next++;
+    } else {
+      if (old == best_) {
+        best = k;
+      }
+      x[k] = x_[old];
+      z[k] = z_[old];
+      old++;
+    }
+  }
+  x_.swap(x);
+  z_.swap(z);
+  best_ = inserted.size() == x_.size() ? inserted.front() : best;
+
+  for (const std::size_t k : inserted) {
+    if (k > 0) {
+      slope_ = std::max(slope_, std::abs(z_[k] - z_[k - 1]) / (x_[k] - x_[k - 1]));
+    }
+    if (k + 1 < x_.size()) {
+      slope_ = std::max(slope_, std::abs(z_[k + 1] - z_[k]) / (x_[k + 1] - x_[k]));
+    }
+    if (z_[k] < z_[best_] || (z_[k] == z_[best_] && x_[k] < x_[best_])) {
+      best_ = k;
+    }
+  }
+}
+
+Result Strongin::Report() const {
+  Result result;
+  if (!x_.empty()) {
+    result.x = x_[best_];
+    result.value = z_[best_];
+  }
+  result.trials = x_.size();
+  result.steps = steps_;
+  result.converged = converged_;
+  return result;
+}
+
+void ShareValues(std::vector<double> &values, MPI_Comm comm) {
+  if (comm == MPI_COMM_NULL) {
+    return;
+  }
+  int size = 1;
+  MPI_Comm_size(comm, &size);
+  std::vector<int> counts(static_cast<std::size_t>(size));
+  std::vector<int> displs(static_cast<std::size_t>(size));
+  for (int rank = 0; rank < size; rank++) {
+    const auto [begin, end] = ppc::shared_memory::BlockRange(values.size(), size, rank);
+    counts[static_cast<std::size_t>(rank)] = static_cast<int>(end - begin);
+    displs[static_cast<std::size_t>(rank)] = static_cast<int>(begin);
+  }
+  MPI_Allgatherv(MPI_IN_PLACE, 0, MPI_DATATYPE_NULL, values.data(), counts.data(), displs.data(), MPI_DOUBLE, comm);
+}
+
+}  // namespace ppc::optimization
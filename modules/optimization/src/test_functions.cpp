@@ -0,0 +1,37 @@
+#include "optimization/include/test_functions.hpp"
+
+#include <cstdint>
+#include <random>
+
+namespace ppc::optimization {
+
+namespace {
+
+/// Uniform in [-1, 1] from the raw 32-bit output, so that the coefficients do not depend on the
+/// standard library's distributions.
+double Coefficient(std::mt19937 &engine) {
+  return (2.0 * static_cast<double>(engine()) / 4294967295.0) - 1.0;
+}
+
+}  // namespace
+
+HillFunction::HillFunction(std::uint32_t seed) {
+  std::mt19937 engine(seed);
+  for (std::size_t i = 0; i <= kTerms; i++) {
+    a_[i] = Coefficient(engine);
+    b_[i] = Coefficient(engine);
+  }
+}
+
+GrishaginFunction::GrishaginFunction(std::uint32_t seed) {
+  std::mt19937 engine(seed);
+  for (Table *table : {&a_, &b_, &c_, &d_}) {
+    for (auto &row : *table) {
+      for (double &coefficient : row) {
+        coefficient = Coefficient(engine);
+      }
+    }
+  }
+}
+
+}  // namespace ppc::optimization
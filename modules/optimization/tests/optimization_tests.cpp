@@ -0,0 +1,155 @@
+#include <gtest/gtest.h>
+#include <mpi.h>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+#include "optimization/include/optimization.hpp"
+#include "optimization/include/optimization_task.hpp"
+#include "optimization/include/test_functions.hpp"
+#include "shared_memory/include/parallel_for.hpp"
+#include "task/include/task.hpp"
+#include "util/include/func_test_util.hpp"
+
+using ppc::optimization::Backend;
+using ppc::optimization::GrishaginFunction;
+using ppc::optimization::HillFunction;
+using ppc::optimization::Options;
+using ppc::task::TypeOfTask;
+
+namespace {
+
+constexpr std::array<Backend, 4> kAllBackends = {Backend::kSeq, Backend::kOmp, Backend::kTbb, Backend::kStl};
+
+/// Smallest value of @p f on a uniform grid of [0, 1] with @p steps intervals.
+template <typename F>
+double GridMinimum(const F &f, std::size_t steps) {
+  double best = std::numeric_limits<double>::infinity();
+  for (std::size_t i = 0; i <= steps; i++) {
+    best = std::min(best, f(static_cast<double>(i) / static_cast<double>(steps)));
+  }
+  return best;
+}
+
+void ExpectSameSearch(const ppc::optimization::Result &a, const ppc::optimization::Result &b) {
+  EXPECT_EQ(a.x, b.x);
+  EXPECT_EQ(a.value, b.value);
+  EXPECT_EQ(a.trials, b.trials);
+  EXPECT_EQ(a.steps, b.steps);
+  EXPECT_EQ(a.converged, b.converged);
+}
+
+}  // namespace
+
+TEST(Optimization, FindsTheGlobalMinimumOfHillFunctions) {
+  // r = 2 misses the global basin of one function of the set; r = 3 solves all twenty.
+  for (std::uint32_t seed = 1; seed <= 20; seed++) {
+    const HillFunction f(seed);
+    const auto result = ppc::optimization::Minimize(f, 0.0, 1.0, {.reliability = 3.0, .epsilon = 1e-5});
+    EXPECT_TRUE(result.converged) << "seed " << seed;
+    EXPECT_LE(result.value, GridMinimum(f, 100000) + 1e-6) << "seed " << seed;
+    EXPECT_EQ(result.value, f(result.x));
+    EXPECT_LT(result.trials, 2000U);
+  }
+}
+
+TEST(Optimization, ParallelCharacteristicsAreTheSameOnEveryBackend) {
+  const HillFunction f(7);
+  Options options{.epsilon = 1e-5, .points_per_step = 6};
+  const auto reference = ppc::optimization::Minimize(f, 0.0, 1.0, options);
+  EXPECT_TRUE(reference.converged);
+  EXPECT_LE(reference.value, GridMinimum(f, 100000) + 1e-6);
+  // Six trials per step need fewer steps than one, at the price of some extra trials.
+  const auto single = ppc::optimization::Minimize(f, 0.0, 1.0, {.epsilon = 1e-5});
+  EXPECT_LT(reference.steps, single.steps);
+  for (const Backend backend : kAllBackends) {
+    options.backend = backend;
+    ExpectSameSearch(ppc::optimization::Minimize(f, 0.0, 1.0, options), reference);
+  }
+  options.max_trials = 40;
+  const auto capped = ppc::optimization::Minimize(f, 0.0, 1.0, options);
+  EXPECT_FALSE(capped.converged);
+  EXPECT_EQ(capped.trials, 40U);
+}
+
+TEST(Optimization, RanksTakeTheTrialsOfASharedMemoryStep) {
+  if (!ppc::util::MpiReady()) {
+    GTEST_SKIP() << "MPI is not initialized";
+  }
+  int size = 1;
+  MPI_Comm_size(MPI_COMM_WORLD, &size);
+  const HillFunction f(11);
+  Options options{.epsilon = 1e-5, .points_per_step = 2, .backend = Backend::kOmp};
+  const auto distributed = ppc::optimization::Minimize(f, 0.0, 1.0, options, MPI_COMM_WORLD);
+  options.points_per_step = 2 * static_cast<std::size_t>(size);
+  options.backend = Backend::kSeq;
+  ExpectSameSearch(distributed, ppc::optimization::Minimize(f, 0.0, 1.0, options));
+  EXPECT_LE(distributed.value, GridMinimum(f, 100000) + 1e-6);
+}
+
+TEST(Optimization, NestedSearchFindsTheMinimumOfGrishaginFunctions) {
+  for (std::uint32_t seed = 1; seed <= 4; seed++) {
+    const GrishaginFunction f(seed);
+    double grid = std::numeric_limits<double>::infinity();
+    for (std::size_t i = 0; i <= 200; i++) {
+      const auto x = static_cast<double>(i) / 200.0;
+      grid = std::min(grid, GridMinimum([&](double y) { return f(x, y); }, 200));
+    }
+    const Options options{.epsilon = 1e-3, .points_per_step = 4, .backend = Backend::kStl};
+    const auto result = ppc::optimization::MinimizeNested(f, {0.0, 0.0}, {1.0, 1.0}, options, options);
+    EXPECT_TRUE(result.converged) << "seed " << seed;
+    EXPECT_LE(result.value, grid + 1e-6) << "seed " << seed;
+    EXPECT_EQ(result.value, f(result.point[0], result.point[1]));
+    EXPECT_GT(result.trials, result.outer_trials);
+  }
+}
+
+TEST(Optimization, InvalidSearchesThrow) {
+  const HillFunction f;
+  EXPECT_THROW((void)ppc::optimization::Minimize(f, 1.0, 0.0), std::invalid_argument);
+  EXPECT_THROW((void)ppc::optimization::Minimize(f, 0.0, std::numeric_limits<double>::infinity()),
+               std::invalid_argument);
+  EXPECT_THROW((void)ppc::optimization::Minimize(f, 0.0, 1.0, {.reliability = 1.0}), std::invalid_argument);
+  EXPECT_THROW((void)ppc::optimization::Minimize(f, 0.0, 1.0, {.epsilon = 0.0}), std::invalid_argument);
+  EXPECT_THROW((void)ppc::optimization::Minimize(f, 0.0, 1.0, {.points_per_step = 0}), std::invalid_argument);
+  ppc::optimization::Strongin engine(0.0, 1.0, {});
+  EXPECT_THROW(engine.Record(std::vector<double>{0.5}, std::vector<double>{}), std::invalid_argument);
+}
+
+namespace {
+
+template <TypeOfTask kType>
+void RunSearchTasks() {
+  ppc::optimization::GlobalSearchTask<HillFunction, kType> line(
+      {.f = HillFunction(3), .epsilon = 1e-5, .points_per_step = 3});
+  ASSERT_TRUE(line.Validation());
+  ASSERT_TRUE(line.PreProcessing());
+  ASSERT_TRUE(line.Run());
+  ASSERT_TRUE(line.PostProcessing());
+  EXPECT_LE(line.GetOutput().value, GridMinimum(HillFunction(3), 100000) + 1e-6);
+
+  ppc::optimization::NestedSearchTask<GrishaginFunction, kType> plane({.f = GrishaginFunction(5)});
+  ASSERT_TRUE(plane.Validation());
+  ASSERT_TRUE(plane.PreProcessing());
+  ASSERT_TRUE(plane.Run());
+  ASSERT_TRUE(plane.PostProcessing());
+  EXPECT_TRUE(plane.GetOutput().converged);
+}
+
+}  // namespace
+
+TEST(Optimization, TasksSearchOnEveryBackend) {
+  RunSearchTasks<TypeOfTask::kSEQ>();
+  RunSearchTasks<TypeOfTask::kOMP>();
+  RunSearchTasks<TypeOfTask::kTBB>();
+  RunSearchTasks<TypeOfTask::kSTL>();
+  if (ppc::util::MpiReady()) {
+    RunSearchTasks<TypeOfTask::kMPI>();
+  }
+}
@@ -0,0 +1,104 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+
+// Per-function target attributes for the vector kernels of DetectIsa(); defined only where they
+// can be built. Modules that dispatch on ActiveIsa() share them.
+#if (defined(__GNUC__) || defined(__clang__)) && defined(__x86_64__)
+#define PPC_TARGET_AVX2 __attribute__((target("avx2")))
+#define PPC_TARGET_AVX512 __attribute__((target("avx512f")))
+#endif
+
+namespace ppc::reduction {
+
+/// @brief Instruction set used by the kernels.
+enum class Isa : uint8_t {
+  /// Portable C++ loops
+  kScalar,
+  /// 4 doubles per instruction
+  kAvx2,
+  /// 8 doubles per instruction
+  kAvx512
+};
+
+/// @brief Returns the lower-case name of the instruction set ("scalar", "avx2", "avx512").
+std::string IsaToString(Isa isa);
+
+/// @brief Best instruction set supported by both the build and the running CPU.
+/// @details Vector kernels are built with per-function target attributes on x86-64 GCC/Clang
+/// and selected at run time, so the library itself needs no -mavx flags. Other compilers and
+/// architectures always get kScalar.
+Isa DetectIsa();
+
+/// @brief Floating-point summation algorithm.
+enum class Summation : uint8_t {
+  /// Plain accumulation per vector lane: fastest, error grows linearly with n
+  kNaive,
+  /// Kahan compensation per vector lane: error independent of n, about 4x the flops
+  kKahan,
+  /// Naive blocks combined in a binary tree: error grows with log n at naive speed
+  kPairwise
+};
+
+/// @brief Returns the lower-case name of the summation ("naive", "kahan", "pairwise").
+std::string SummationToString(Summation summation);
+
+/// @brief Element-wise operation of the matrix row/column reductions.
+enum class Op : uint8_t { kSum, kMin, kMax };
+
+/// @brief Kernel selection shared by all reductions of this module.
+struct Tuning {
+  /// Instruction set to use; anything above DetectIsa() is clamped to it.
+  Isa isa = DetectIsa();
+  /// Length of the naive blocks of Summation::kPairwise.
+  std::size_t pairwise_block = 256;
+};
+
+/// @brief Returns the tuning shared by all reductions of this module.
+Tuning &GetTuning();
+
+/// @brief Instruction set the kernels currently dispatch to.
+Isa ActiveIsa();
+
+/// @brief Adjacent pair (x[index], x[index + 1]) and |x[index + 1] - x[index]|.
+struct AdjacentPair {
+  std::size_t index = 0;
+  double difference = 0.0;
+};
+
+double Sum(std::span<const double> x, Summation summation = Summation::kPairwise);
+
+/// @throws std::invalid_argument When the spans differ in length.
+double Dot(std::span<const double> x, std::span<const double> y, Summation summation = Summation::kPairwise);
+
+/// @throws std::invalid_argument On an empty span.
+double Min(std::span<const double> x);
+/// @throws std::invalid_argument On an empty span.
+double Max(std::span<const double> x);
+
+/// @brief Reduces @p x with @p op (Sum uses Summation::kPairwise).
+/// @throws std::invalid_argument When @p x is empty and @p op is kMin or kMax.
+double Reduce(std::span<const double> x, Op op);
+
+/// @brief Number of adjacent pairs with strictly opposite signs (zeros never alternate).
+std::size_t CountSignAlternations(std::span<const double> x);
+
+/// @brief Number of adjacent pairs with x[i] > x[i + 1].
+std::size_t CountOrderViolations(std::span<const double> x);
+
+/// @brief Adjacent pair with the smallest difference; the first one on ties.
+/// @throws std::invalid_argument When @p x has fewer than two elements.
+AdjacentPair ClosestAdjacent(std::span<const double> x);
+
+/// @brief Adjacent pair with the largest difference; the first one on ties.
+/// @throws std::invalid_argument When @p x has fewer than two elements.
+AdjacentPair FarthestAdjacent(std::span<const double> x);
+
+/// @brief acc[j] = op(acc[j], row[j]): one row of a column-wise matrix reduction.
+/// @throws std::invalid_argument When the spans differ in length.
+void AccumulateColumns(std::span<double> acc, std::span<const double> row, Op op);
+
+}  // namespace ppc::reduction
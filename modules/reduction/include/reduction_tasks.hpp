@@ -0,0 +1,447 @@
+#pragma once
+
+#include <mpi.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "oneapi/tbb/parallel_for.h"
+#include "reduction/include/reduction.hpp"
+#include "shared_memory/include/shared_memory.hpp"
+#include "task/include/task.hpp"
+#include "util/include/util.hpp"
+
+namespace ppc::reduction {
+
+/// @brief Row-major matrix input of the row and column reductions.
+struct Matrix {
+  std::size_t rows = 0;
+  std::size_t cols = 0;
+  std::vector<double> values;
+};
+
+/// @brief Running sum kept as hi + lo so that partial sums of workers combine without loss.
+struct CompensatedSum {
+  double hi = 0.0;
+  double lo = 0.0;
+
+  void Add(double value) {
+    const double sum = hi + value;
+    const double virtual_value = sum - hi;
+    lo += (hi - (sum - virtual_value)) + (value - virtual_value);
+    hi = sum;
+  }
+  [[nodiscard]] double Value() const {
+    return hi + lo;
+  }
+};
+
+// A kernel describes one reduction to ReductionTask:
+//   InType, OutType, Partial           task input/output and per-worker partial result
+//   Valid(in)                          input check done in ValidationImpl
+//   Size(in)                           length of the index space split between workers
+//   Identity(in)                       neutral partial
+//   Accumulate(in, begin, end, p)      folds indices [begin, end) into p with the SIMD kernels
+//   Combine(into, from)                folds a later partial into an earlier one
+//   Finish(in, p)                      turns the combined partial into the output
+// Partials are combined in index order, so results do not depend on the thread count beyond
+// the chunk boundaries. Kernels with non-trivially-copyable partials also provide
+// Allreduce(p, comm) for the MPI front-end.
+
+/// @brief Sum of a vector.
+template <Summation kSummation = Summation::kPairwise>
+struct SumKernel {
+  using InType = std::vector<double>;
+  using OutType = double;
+  using Partial = CompensatedSum;
+
+  static bool Valid(const InType & /*in*/) {
+    return true;
+  }
+  static std::size_t Size(const InType &in) {
+    return in.size();
+  }
+  static Partial Identity(const InType & /*in*/) {
+    return {};
+  }
+  static void Accumulate(const InType &in, std::size_t begin, std::size_t end, Partial &partial) {
+    partial.Add(Sum(std::span(in).subspan(begin, end - begin), kSummation));
+  }
+  static void Combine(Partial &into, const Partial &from) {
+    into.Add(from.hi);
+    into.Add(from.lo);
+  }
+  static OutType Finish(const InType & /*in*/, const Partial &partial) {
+    return partial.Value();
+  }
+};
+
+/// @brief Arithmetic mean of a non-empty vector.
+template <Summation kSummation = Summation::kPairwise>
+struct MeanKernel : SumKernel<kSummation> {
+  static bool Valid(const std::vector<double> &in) {
+    return !in.empty();
+  }
+  static double Finish(const std::vector<double> &in, const CompensatedSum &partial) {
+    return partial.Value() / static_cast<double>(in.size());
+  }
+};
+
+/// @brief Dot product of two vectors of equal length.
+template <Summation kSummation = Summation::kPairwise>
+struct DotKernel {
+  using InType = std::pair<std::vector<double>, std::vector<double>>;
+  using OutType = double;
+  using Partial = CompensatedSum;
+
+  static bool Valid(const InType &in) {
+    return in.first.size() == in.second.size();
+  }
+  static std::size_t Size(const InType &in) {
+    return in.first.size();
+  }
+  static Partial Identity(const InType & /*in*/) {
+    return {};
+  }
+  static void Accumulate(const InType &in, std::size_t begin, std::size_t end, Partial &partial) {
+    partial.Add(Dot(std::span(in.first).subspan(begin, end - begin), std::span(in.second).subspan(begin, end - begin),
+                    kSummation));
+  }
+  static void Combine(Partial &into, const Partial &from) {
+    into.Add(from.hi);
+    into.Add(from.lo);
+  }
+  static OutType Finish(const InType & /*in*/, const Partial &partial) {
+    return partial.Value();
+  }
+};
+
+/// @brief Minimum (kMin) or maximum (kMax) element of a non-empty vector.
+template <Op kOp>
+struct ExtremeKernel {
+  static_assert(kOp != Op::kSum, "use SumKernel for sums");
+  using InType = std::vector<double>;
+  using OutType = double;
+  using Partial = double;
+
+  static bool Valid(const InType &in) {
+    return !in.empty();
+  }
+  static std::size_t Size(const InType &in) {
+    return in.size();
+  }
+  static Partial Identity(const InType & /*in*/) {
+    return kOp == Op::kMin ? std::numeric_limits<double>::infinity() : -std::numeric_limits<double>::infinity();
+  }
+  static void Accumulate(const InType &in, std::size_t begin, std::size_t end, Partial &partial) {
+    if (begin < end) {
+      Combine(partial, Reduce(std::span(in).subspan(begin, end - begin), kOp));
+    }
+  }
+  static void Combine(Partial &into, const Partial &from) {
+    into = kOp == Op::kMin ? std::min(into, from) : std::max(into, from);
+  }
+  static OutType Finish(const InType & /*in*/, const Partial &partial) {
+    return partial;
+  }
+};
+
+using MinKernel = ExtremeKernel<Op::kMin>;
+using MaxKernel = ExtremeKernel<Op::kMax>;
+
+/// @brief Number of adjacent pairs satisfying @p kCount (CountSignAlternations or CountOrderViolations).
+template <std::size_t (*kCount)(std::span<const double>)>
+struct AdjacentCountKernel {
+  using InType = std::vector<double>;
+  using OutType = std::size_t;
+  using Partial = std::uint64_t;
+
+  static bool Valid(const InType & /*in*/) {
+    return true;
+  }
+  /// Index i stands for the pair (in[i], in[i + 1]).
+  static std::size_t Size(const InType &in) {
+    return in.empty() ? 0 : in.size() - 1;
+  }
+  static Partial Identity(const InType & /*in*/) {
+    return 0;
+  }
+  static void Accumulate(const InType &in, std::size_t begin, std::size_t end, Partial &partial) {
+    if (begin < end) {
+      partial += kCount(std::span(in).subspan(begin, end - begin + 1));
+    }
+  }
+  static void Combine(Partial &into, const Partial &from) {
+    into += from;
+  }
+  static OutType Finish(const InType & /*in*/, const Partial &partial) {
+    return static_cast<OutType>(partial);
+  }
+};
+
+using SignAlternationsKernel = AdjacentCountKernel<CountSignAlternations>;
+using OrderViolationsKernel = AdjacentCountKernel<CountOrderViolations>;
+
+/// @brief Closest (kMin) or farthest (kMax) adjacent pair of a vector with at least two elements.
+template <Op kOp>
+struct AdjacentPairKernel {
+  static_assert(kOp != Op::kSum, "adjacent pairs are selected by kMin or kMax");
+  using InType = std::vector<double>;
+  using OutType = AdjacentPair;
+  using Partial = AdjacentPair;
+
+  static bool Valid(const InType &in) {
+    return in.size() >= 2;
+  }
+  static std::size_t Size(const InType &in) {
+    return in.size() - 1;
+  }
+  static Partial Identity(const InType & /*in*/) {
+    const double worst =
+        kOp == Op::kMin ? std::numeric_limits<double>::infinity() : -std::numeric_limits<double>::infinity();
+    return {.index = std::numeric_limits<std::size_t>::max(), .difference = worst};
+  }
+  static void Accumulate(const InType &in, std::size_t begin, std::size_t end, Partial &partial) {
+    if (begin >= end) {
+      return;
+    }
+    const auto chunk = std::span(in).subspan(begin, end - begin + 1);
+    AdjacentPair best = kOp == Op::kMin ? ClosestAdjacent(chunk) : FarthestAdjacent(chunk);
+    best.index += begin;
+    Combine(partial, best);
+  }
+  /// Ties keep the smaller index.
+  static void Combine(Partial &into, const Partial &from) {
+    const bool better = kOp == Op::kMin ? from.difference < into.difference : from.difference > into.difference;
+    if (better || (from.difference == into.difference && from.index < into.index)) {
+      into = from;
+    }
+  }
+  static OutType Finish(const InType & /*in*/, const Partial &partial) {
+    return partial;
+  }
+};
+
+using ClosestAdjacentKernel = AdjacentPairKernel<Op::kMin>;
+using FarthestAdjacentKernel = AdjacentPairKernel<Op::kMax>;
+
+namespace detail {
+
+inline double OpIdentity(Op op) {
+  switch (op) {
+    case Op::kSum:
+      return 0.0;
+    case Op::kMin:
+      return std::numeric_limits<double>::infinity();
+    case Op::kMax:
+      return -std::numeric_limits<double>::infinity();
+  }
+  return 0.0;
+}
+
+inline MPI_Op MpiOp(Op op) {
+  switch (op) {
+    case Op::kSum:
+      return MPI_SUM;
+    case Op::kMin:
+      return MPI_MIN;
+    case Op::kMax:
+      return MPI_MAX;
+  }
+  return MPI_SUM;
+}
+
+inline bool ValidMatrix(const Matrix &in, Op op) {
+  return in.values.size() == in.rows * in.cols && (op == Op::kSum || (in.rows > 0 && in.cols > 0));
+}
+
+/// Element-wise op of equally sized vectors of partial row/column results.
+inline void CombineVectors(std::vector<double> &into, const std::vector<double> &from, Op op) {
+  AccumulateColumns(into, from, op);
+}
+
+}  // namespace detail
+
+/// @brief Sum, minimum or maximum of every matrix row.
+template <Op kOp>
+struct RowReduceKernel {
+  using InType = Matrix;
+  using OutType = std::vector<double>;
+  using Partial = std::vector<double>;
+
+  static bool Valid(const InType &in) {
+    return detail::ValidMatrix(in, kOp);
+  }
+  static std::size_t Size(const InType &in) {
+    return in.rows;
+  }
+  static Partial Identity(const InType &in) {
+    return Partial(in.rows, detail::OpIdentity(kOp));
+  }
+  static void Accumulate(const InType &in, std::size_t begin, std::size_t end, Partial &partial) {
+    for (std::size_t row = begin; row < end; row++) {
+      partial[row] = Reduce(std::span(in.values).subspan(row * in.cols, in.cols), kOp);
+    }
+  }
+  static void Combine(Partial &into, const Partial &from) {
+    detail::CombineVectors(into, from, kOp);
+  }
+  static void Allreduce(Partial &partial, MPI_Comm comm) {
+    MPI_Allreduce(MPI_IN_PLACE, partial.data(), static_cast<int>(partial.size()), MPI_DOUBLE, detail::MpiOp(kOp),
+                  comm);
+  }
+  static OutType Finish(const InType & /*in*/, const Partial &partial) {
+    return partial;
+  }
+};
+
+/// @brief Sum, minimum or maximum of every matrix column; workers split the rows.
+template <Op kOp>
+struct ColReduceKernel {
+  using InType = Matrix;
+  using OutType = std::vector<double>;
+  using Partial = std::vector<double>;
+
+  static bool Valid(const InType &in) {
+    return detail::ValidMatrix(in, kOp);
+  }
+  static std::size_t Size(const InType &in) {
+    return in.rows;
+  }
+  static Partial Identity(const InType &in) {
+    return Partial(in.cols, detail::OpIdentity(kOp));
+  }
+  static void Accumulate(const InType &in, std::size_t begin, std::size_t end, Partial &partial) {
+    for (std::size_t row = begin; row < end; row++) {
+      AccumulateColumns(partial, std::span(in.values).subspan(row * in.cols, in.cols), kOp);
+    }
+  }
+  static void Combine(Partial &into, const Partial &from) {
+    detail::CombineVectors(into, from, kOp);
+  }
+  static void Allreduce(Partial &partial, MPI_Comm comm) {
+    MPI_Allreduce(MPI_IN_PLACE, partial.data(), static_cast<int>(partial.size()), MPI_DOUBLE, detail::MpiOp(kOp),
+                  comm);
+  }
+  static OutType Finish(const InType & /*in*/, const Partial &partial) {
+    return partial;
+  }
+};
+
+/// @brief ppc::task::Task running @p Kernel with the @p kType back-end.
+/// @details kSEQ runs one chunk; kOMP, kTBB and kSTL split Kernel::Size() into
+/// ppc::util::GetNumThreads() chunks; kMPI gives each rank one block of the index space
+/// (every rank holds the whole input, as in the course tasks) and combines the partials in
+/// rank order, so all ranks end with the output.
+template <typename Kernel, ppc::task::TypeOfTask kType>
+class ReductionTask : public ppc::task::Task<typename Kernel::InType, typename Kernel::OutType> {
+  static_assert(kType == ppc::task::TypeOfTask::kSEQ || kType == ppc::task::TypeOfTask::kOMP ||
+                    kType == ppc::task::TypeOfTask::kTBB || kType == ppc::task::TypeOfTask::kSTL ||
+                    kType == ppc::task::TypeOfTask::kMPI,
+                "unsupported back-end");
+
+ public:
+  using InType = typename Kernel::InType;
+  using OutType = typename Kernel::OutType;
+  using Partial = typename Kernel::Partial;
+
+  static constexpr ppc::task::TypeOfTask GetStaticTypeOfTask() {
+    return kType;
+  }
+
+  explicit ReductionTask(const InType &in) {
+    this->SetTypeOfTask(GetStaticTypeOfTask());
+    this->GetInput() = in;
+  }
+
+ private:
+  bool ValidationImpl() override {
+    return Kernel::Valid(this->GetInput());
+  }
+
+  bool PreProcessingImpl() override {
+    partial_ = Kernel::Identity(this->GetInput());
+    return true;
+  }
+
+  bool RunImpl() override {
+    const InType &in = this->GetInput();
+    const std::size_t total = Kernel::Size(in);
+    partial_ = Kernel::Identity(in);
+    if constexpr (kType == ppc::task::TypeOfTask::kSEQ) {
+      Kernel::Accumulate(in, 0, total, partial_);
+    } else if constexpr (kType == ppc::task::TypeOfTask::kMPI) {
+      int rank = 0;
+      int size = 1;
+      MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+      MPI_Comm_size(MPI_COMM_WORLD, &size);
+      const auto [begin, end] = ppc::shared_memory::BlockRange(total, size, rank);
+      Kernel::Accumulate(in, begin, end, partial_);
+      AllreducePartial(in, size);
+    } else {
+      RunThreads(in, total);
+    }
+    return true;
+  }
+
+  bool PostProcessingImpl() override {
+    this->GetOutput() = Kernel::Finish(this->GetInput(), partial_);
+    return true;
+  }
+
+  void RunThreads(const InType &in, std::size_t total) {
+    const int chunks = std::max(ppc::util::GetNumThreads(), 1);
+    std::vector<Partial> partials(static_cast<std::size_t>(chunks), Kernel::Identity(in));
+    const auto run_chunk = [&](int chunk) {
+      const auto [begin, end] = ppc::shared_memory::BlockRange(total, chunks, chunk);
+      Kernel::Accumulate(in, begin, end, partials[static_cast<std::size_t>(chunk)]);
+    };
+    if constexpr (kType == ppc::task::TypeOfTask::kOMP) {
+#pragma omp parallel for default(none) shared(run_chunk, chunks) num_threads(chunks)
+      for (int chunk = 0; chunk < chunks; chunk++) {
+        run_chunk(chunk);
+      }
+    } else if constexpr (kType == ppc::task::TypeOfTask::kTBB) {
+      tbb::parallel_for(0, chunks, run_chunk);
+    } else {
+      std::vector<std::thread> threads;
+      threads.reserve(static_cast<std::size_t>(chunks - 1));
+      for (int chunk = 1; chunk < chunks; chunk++) {
+        threads.emplace_back(run_chunk, chunk);
+      }
+      run_chunk(0);
+      for (auto &thread : threads) {
+        thread.join();
+      }
+    }
+    for (const auto &partial : partials) {
+      Kernel::Combine(partial_, partial);
+    }
+  }
+
+  void AllreducePartial(const InType &in, int size) {
+    if constexpr (requires(Partial &p) { Kernel::Allreduce(p, MPI_COMM_WORLD); }) {
+      Kernel::Allreduce(partial_, MPI_COMM_WORLD);
+    } else {
+      static_assert(std::is_trivially_copyable_v<Partial>, "partials without Allreduce must be trivially copyable");
+      std::vector<Partial> partials(static_cast<std::size_t>(size));
+      MPI_Allgather(&partial_, static_cast<int>(sizeof(Partial)), MPI_BYTE, partials.data(),
+                    static_cast<int>(sizeof(Partial)), MPI_BYTE, MPI_COMM_WORLD);
+      partial_ = Kernel::Identity(in);
+      for (const auto &partial : partials) {
+        Kernel::Combine(partial_, partial);
+      }
+    }
+  }
+
+  Partial partial_{};
+};
+
+}  // namespace ppc::reduction
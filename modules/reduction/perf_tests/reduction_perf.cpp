@@ -0,0 +1,198 @@
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include "reduction/include/reduction.hpp"
+#include "reduction/include/reduction_tasks.hpp"
+#include "task/include/task.hpp"
+#include "util/include/perf_test_util.hpp"
+
+namespace ppc::reduction::perf {
+
+using ppc::task::TypeOfTask;
+
+/// Copies the input into a preallocated buffer: the memory bandwidth reference for the reductions.
+class CopyTask : public ppc::task::Task<std::vector<double>, double> {
+ public:
+  static constexpr TypeOfTask GetStaticTypeOfTask() {
+    return TypeOfTask::kSEQ;
+  }
+
+  explicit CopyTask(const std::vector<double> &in) {
+    SetTypeOfTask(GetStaticTypeOfTask());
+    GetInput() = in;
+  }
+
+ private:
+  bool ValidationImpl() override {
+    return !GetInput().empty();
+  }
+  bool PreProcessingImpl() override {
+    buffer_.resize(GetInput().size());
+    return true;
+  }
+  bool RunImpl() override {
+    std::memcpy(buffer_.data(), GetInput().data(), GetInput().size() * sizeof(double));
+    return true;
+  }
+  bool PostProcessingImpl() override {
+    GetOutput() = buffer_.back();
+    return true;
+  }
+
+  std::vector<double> buffer_;
+};
+
+/// Value a vector case must return.
+enum class VectorResult : std::uint8_t {
+  kSum,
+  kMax,
+  /// Last element, which CopyTask returns
+  kLast,
+};
+
+template <VectorResult kResult>
+class VectorReductionPerfTests : public ppc::util::BaseRunPerfTests<std::vector<double>, double> {
+  // 64 MiB: well beyond the last-level cache, so the runs are bound by memory bandwidth.
+  static constexpr std::size_t kCount = std::size_t{1} << 23;
+  std::vector<double> input_data_;
+
+  void SetUp() override {
+    input_data_.resize(kCount);
+    for (std::size_t i = 0; i < kCount; i++) {
+      input_data_[i] = static_cast<double>(i % 7) - 3.0;
+    }
+  }
+
+  // kCount = 4 (mod 7): full periods of -3..3 cancel and the trailing -3, -2, -1, 0 sum to -6 and end in 0.
+  // Every partial sum is a small integer, so each summation order is exact.
+  static constexpr double Expected() {
+    switch (kResult) {
+      case VectorResult::kSum:
+        return -6.0;
+      case VectorResult::kMax:
+        return 3.0;
+      case VectorResult::kLast:
+        return 0.0;
+    }
+    return 0.0;
+  }
+
+  bool CheckTestOutputData(double &output_data) final {
+    PrintRate("gb_per_s", 1e-9 * static_cast<double>(kCount * sizeof(double)));
+    return output_data == Expected();
+  }
+
+  std::vector<double> GetTestInputData() final {
+    return input_data_;
+  }
+};
+
+using SumPerfTests = VectorReductionPerfTests<VectorResult::kSum>;
+using MaxPerfTests = VectorReductionPerfTests<VectorResult::kMax>;
+using CopyPerfTests = VectorReductionPerfTests<VectorResult::kLast>;
+
+/// Sums a matrix case must return.
+enum class MatrixResult : std::uint8_t {
+  kRowSums,
+  kColSums,
+};
+
+template <MatrixResult kResult>
+class MatrixReductionPerfTests : public ppc::util::BaseRunPerfTests<Matrix, std::vector<double>> {
+  static constexpr std::size_t kRows = 4096;
+  static constexpr std::size_t kCols = 2048;
+  Matrix input_data_;
+  std::vector<double> expected_;
+
+  void SetUp() override {
+    input_data_ = {.rows = kRows, .cols = kCols, .values = std::vector<double>(kRows * kCols)};
+    expected_.assign(kResult == MatrixResult::kRowSums ? kRows : kCols, 0.0);
+    for (std::size_t i = 0; i < input_data_.values.size(); i++) {
+      input_data_.values[i] = static_cast<double>(i % 5);
+      // Integer sums below 2^53 are exact in any order.
+      expected_[kResult == MatrixResult::kRowSums ? i / kCols : i % kCols] += input_data_.values[i];
+    }
+  }
+
+  bool CheckTestOutputData(std::vector<double> &output_data) final {
+    PrintRate("gb_per_s", 1e-9 * static_cast<double>(kRows * kCols * sizeof(double)));
+    return output_data == expected_;
+  }
+
+  Matrix GetTestInputData() final {
+    return input_data_;
+  }
+};
+
+using RowSumPerfTests = MatrixReductionPerfTests<MatrixResult::kRowSums>;
+using ColSumPerfTests = MatrixReductionPerfTests<MatrixResult::kColSums>;
+
+/// ReductionTask of every back-end for one kernel.
+template <typename Kernel>
+struct PerfReductionTasks {
+  template <TypeOfTask kType>
+  using Task = ReductionTask<Kernel, kType>;
+};
+
+template <typename Kernel>
+auto MakeBackendSuite(const std::string &kernel) {
+  return ppc::util::MakeBackendPerfTaskTuples<PerfReductionTasks<Kernel>::template Task, typename Kernel::InType>(
+      "ppc_reduction", kernel);
+}
+
+TEST_P(SumPerfTests, RunPerfModes) {
+  ExecuteTest(GetParam());
+}
+
+TEST_P(MaxPerfTests, RunPerfModes) {
+  ExecuteTest(GetParam());
+}
+
+TEST_P(CopyPerfTests, RunPerfModes) {
+  ExecuteTest(GetParam());
+}
+
+TEST_P(RowSumPerfTests, RunPerfModes) {
+  ExecuteTest(GetParam());
+}
+
+TEST_P(ColSumPerfTests, RunPerfModes) {
+  ExecuteTest(GetParam());
+}
+
+const auto kCopyPerfTasks =
+    ppc::util::MakeNamedPerfTaskTuples<CopyTask, std::vector<double>>("ppc_reduction_seq_memcpy_reference");
+
+const auto kSumPerfTasks = std::tuple_cat(
+    ppc::util::MakeNamedPerfTaskTuples<ReductionTask<SumKernel<Summation::kNaive>, TypeOfTask::kSEQ>,
+                                       std::vector<double>>("ppc_reduction_seq_sum_naive"),
+    ppc::util::MakeNamedPerfTaskTuples<ReductionTask<SumKernel<Summation::kKahan>, TypeOfTask::kSEQ>,
+                                       std::vector<double>>("ppc_reduction_seq_sum_kahan"),
+    MakeBackendSuite<SumKernel<Summation::kPairwise>>("sum_pairwise"));
+
+const auto kMaxPerfTasks = MakeBackendSuite<MaxKernel>("max");
+const auto kRowSumPerfTasks = MakeBackendSuite<RowReduceKernel<Op::kSum>>("row_sum");
+const auto kColSumPerfTasks = MakeBackendSuite<ColReduceKernel<Op::kSum>>("col_sum");
+
+INSTANTIATE_TEST_SUITE_P(MemcpyReference, CopyPerfTests, ppc::util::TupleToGTestValues(kCopyPerfTasks),
+                         CopyPerfTests::CustomPerfTestName);
+
+INSTANTIATE_TEST_SUITE_P(VectorSums, SumPerfTests, ppc::util::TupleToGTestValues(kSumPerfTasks),
+                         SumPerfTests::CustomPerfTestName);
+
+INSTANTIATE_TEST_SUITE_P(VectorMax, MaxPerfTests, ppc::util::TupleToGTestValues(kMaxPerfTasks),
+                         MaxPerfTests::CustomPerfTestName);
+
+INSTANTIATE_TEST_SUITE_P(MatrixRowSums, RowSumPerfTests, ppc::util::TupleToGTestValues(kRowSumPerfTasks),
+                         RowSumPerfTests::CustomPerfTestName);
+
+INSTANTIATE_TEST_SUITE_P(MatrixColSums, ColSumPerfTests, ppc::util::TupleToGTestValues(kColSumPerfTasks),
+                         ColSumPerfTests::CustomPerfTestName);
+
+}  // namespace ppc::reduction::perf
@@ -0,0 +1,817 @@
+#include "reduction/include/reduction.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <span>
+#include <stdexcept>
+#include <string>
+
+#ifdef PPC_TARGET_AVX2
+#define PPC_REDUCTION_X86 1
+#include <immintrin.h>
+#endif
+
+namespace ppc::reduction {
+
+namespace {
+
+/// Entry points of one instruction set; every kernel takes raw pointers and a length.
+struct KernelTable {
+  double (*sum_naive)(const double *, std::size_t);
+  double (*sum_kahan)(const double *, std::size_t);
+  double (*dot_naive)(const double *, const double *, std::size_t);
+  double (*dot_kahan)(const double *, const double *, std::size_t);
+  double (*min)(const double *, std::size_t);
+  double (*max)(const double *, std::size_t);
+  std::size_t (*sign_alternations)(const double *, std::size_t);
+  std::size_t (*order_violations)(const double *, std::size_t);
+  /// Smallest / largest |x[i + 1] - x[i]| over n >= 2 elements
+  double (*min_gap)(const double *, std::size_t);
+  double (*max_gap)(const double *, std::size_t);
+  void (*accumulate_sum)(double *, const double *, std::size_t);
+  void (*accumulate_min)(double *, const double *, std::size_t);
+  void (*accumulate_max)(double *, const double *, std::size_t);
+};
+
+/// Kahan step: adds @p value to @p sum, carrying the lost low-order bits in @p comp.
+inline void KahanAdd(double &sum, double &comp, double value) {
+  const double y = value - comp;
+  const double t = sum + y;
+  comp = (t - sum) - y;
+  sum = t;
+}
+
+inline bool SignsAlternate(double a, double b) {
+  return (a > 0.0 && b < 0.0) || (a < 0.0 && b > 0.0);
+}
+
+namespace scalar {
+
+double SumNaive(const double *x, std::size_t n) {
+  double sum = 0.0;
+  for (std::size_t i = 0; i < n; i++) {
+    sum += x[i];
+  }
+  return sum;
+}
+
+double SumKahan(const double *x, std::size_t n) {
+  double sum = 0.0;
+  double comp = 0.0;
+  for (std::size_t i = 0; i < n; i++) {
+    KahanAdd(sum, comp, x[i]);
+  }
+  return sum;
+}
+
+double DotNaive(const double *x, const double *y, std::size_t n) {
+  double sum = 0.0;
+  for (std::size_t i = 0; i < n; i++) {
+    sum += x[i] * y[i];
+  }
+  return sum;
+}
+
+double DotKahan(const double *x, const double *y, std::size_t n) {
+  double sum = 0.0;
+  double comp = 0.0;
+  for (std::size_t i = 0; i < n; i++) {
+    KahanAdd(sum, comp, x[i] * y[i]);
+  }
+  return sum;
+}
+
+double Min(const double *x, std::size_t n) {
+  double best = std::numeric_limits<double>::infinity();
+  for (std::size_t i = 0; i < n; i++) {
+    best = std::min(best, x[i]);
+  }
+  return best;
+}
+
+double Max(const double *x, std::size_t n) {
+  double best = -std::numeric_limits<double>::infinity();
+  for (std::size_t i = 0; i < n; i++) {
+    best = std::max(best, x[i]);
+  }
+  return best;
+}
+
+std::size_t SignAlternations(const double *x, std::size_t n) {
+  std::size_t count = 0;
+  for (std::size_t i = 0; i + 1 < n; i++) {
+    count += SignsAlternate(x[i], x[i + 1]) ? 1 : 0;
+  }
+  return count;
+}
+
+std::size_t OrderViolations(const double *x, std::size_t n) {
+  std::size_t count = 0;
+  for (std::size_t i = 0; i + 1 < n; i++) {
+    count += x[i] > x[i + 1] ? 1 : 0;
+  }
+  return count;
+}
+
+double MinGap(const double *x, std::size_t n) {
+  double best = std::numeric_limits<double>::infinity();
+  for (std::size_t i = 0; i + 1 < n; i++) {
+    best = std::min(best, std::abs(x[i + 1] - x[i]));
+  }
+  return best;
+}
+
+double MaxGap(const double *x, std::size_t n) {
+  double best = -std::numeric_limits<double>::infinity();
+  for (std::size_t i = 0; i + 1 < n; i++) {
+    best = std::max(best, std::abs(x[i + 1] - x[i]));
+  }
+  return best;
+}
+
+void AccumulateSum(double *acc, const double *row, std::size_t n) {
+  for (std::size_t j = 0; j < n; j++) {
+    acc[j] += row[j];
+  }
+}
+
+void AccumulateMin(double *acc, const double *row, std::size_t n) {
+  for (std::size_t j = 0; j < n; j++) {
+    acc[j] = std::min(acc[j], row[j]);
+  }
+}
+
+void AccumulateMax(double *acc, const double *row, std::size_t n) {
+  for (std::size_t j = 0; j < n; j++) {
+    acc[j] = std::max(acc[j], row[j]);
+  }
+}
+
+constexpr KernelTable kTable = {.sum_naive = SumNaive,
+                                .sum_kahan = SumKahan,
+                                .dot_naive = DotNaive,
+                                .dot_kahan = DotKahan,
+                                .min = Min,
+                                .max = Max,
+                                .sign_alternations = SignAlternations,
+                                .order_violations = OrderViolations,
+                                .min_gap = MinGap,
+                                .max_gap = MaxGap,
+                                .accumulate_sum = AccumulateSum,
+                                .accumulate_min = AccumulateMin,
+                                .accumulate_max = AccumulateMax};
+
+}  // namespace scalar
+
+#ifdef PPC_REDUCTION_X86
+
+namespace avx2 {
+
+constexpr std::size_t kLanes = 4;
+
+PPC_TARGET_AVX2 double Horizontal(__m256d v) {
+  alignas(32) std::array<double, kLanes> lanes{};
+  _mm256_store_pd(lanes.data(), v);
+  return (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]);
+}
+
+/// Folds per-lane Kahan sums into one compensated scalar sum.
+PPC_TARGET_AVX2 double FoldKahan(__m256d sum, __m256d comp, double &tail_comp) {
+  alignas(32) std::array<double, kLanes> sums{};
+  alignas(32) std::array<double, kLanes> comps{};
+  _mm256_store_pd(sums.data(), sum);
+  _mm256_store_pd(comps.data(), comp);
+  double total = 0.0;
+  tail_comp = 0.0;
+  for (std::size_t k = 0; k < kLanes; k++) {
+    KahanAdd(total, tail_comp, sums[k]);
+    KahanAdd(total, tail_comp, -comps[k]);
+  }
+  return total;
+}
+
+PPC_TARGET_AVX2 double SumNaive(const double *x, std::size_t n) {
+  __m256d a0 = _mm256_setzero_pd();
+  __m256d a1 = _mm256_setzero_pd();
+  __m256d a2 = _mm256_setzero_pd();
+  __m256d a3 = _mm256_setzero_pd();
+  std::size_t i = 0;
+  for (; i + (4 * kLanes) <= n; i += 4 * kLanes) {
+    a0 = _mm256_add_pd(a0, _mm256_loadu_pd(x + i));
+    a1 = _mm256_add_pd(a1, _mm256_loadu_pd(x + i + kLanes));
+    a2 = _mm256_add_pd(a2, _mm256_loadu_pd(x + i + (2 * kLanes)));
+    a3 = _mm256_add_pd(a3, _mm256_loadu_pd(x + i + (3 * kLanes)));
+  }
+  for (; i + kLanes <= n; i += kLanes) {
+    a0 = _mm256_add_pd(a0, _mm256_loadu_pd(x + i));
+  }
+  double sum = Horizontal(_mm256_add_pd(_mm256_add_pd(a0, a1), _mm256_add_pd(a2, a3)));
+  for (; i < n; i++) {
+    sum += x[i];
+  }
+  return sum;
+}
+
+PPC_TARGET_AVX2 double SumKahan(const double *x, std::size_t n) {
+  __m256d sum = _mm256_setzero_pd();
+  __m256d comp = _mm256_setzero_pd();
+  std::size_t i = 0;
+  for (; i + kLanes <= n; i += kLanes) {
+    const __m256d y = _mm256_sub_pd(_mm256_loadu_pd(x + i), comp);
+    const __m256d t = _mm256_add_pd(sum, y);
+    comp = _mm256_sub_pd(_mm256_sub_pd(t, sum), y);
+    sum = t;
+  }
+  double tail_comp = 0.0;
+  double total = FoldKahan(sum, comp, tail_comp);
+  for (; i < n; i++) {
+    KahanAdd(total, tail_comp, x[i]);
+  }
+  return total;
+}
+
+PPC_TARGET_AVX2 double DotNaive(const double *x, const double *y, std::size_t n) {
+  __m256d a0 = _mm256_setzero_pd();
+  __m256d a1 = _mm256_setzero_pd();
+  std::size_t i = 0;
+  for (; i + (2 * kLanes) <= n; i += 2 * kLanes) {
+    a0 = _mm256_add_pd(a0, _mm256_mul_pd(_mm256_loadu_pd(x + i), _mm256_loadu_pd(y + i)));
+    a1 = _mm256_add_pd(a1, _mm256_mul_pd(_mm256_loadu_pd(x + i + kLanes), _mm256_loadu_pd(y + i + kLanes)));
+  }
+  double sum = Horizontal(_mm256_add_pd(a0, a1));
+  for (; i < n; i++) {
+    sum += x[i] * y[i];
+  }
+  return sum;
+}
+
+PPC_TARGET_AVX2 double DotKahan(const double *x, const double *y, std::size_t n) {
+  __m256d sum = _mm256_setzero_pd();
+  __m256d comp = _mm256_setzero_pd();
+  std::size_t i = 0;
+  for (; i + kLanes <= n; i += kLanes) {
+    const __m256d v = _mm256_mul_pd(_mm256_loadu_pd(x + i), _mm256_loadu_pd(y + i));
+    const __m256d w = _mm256_sub_pd(v, comp);
+    const __m256d t = _mm256_add_pd(sum, w);
+    comp = _mm256_sub_pd(_mm256_sub_pd(t, sum), w);
+    sum = t;
+  }
+  double tail_comp = 0.0;
+  double total = FoldKahan(sum, comp, tail_comp);
+  for (; i < n; i++) {
+    KahanAdd(total, tail_comp, x[i] * y[i]);
+  }
+  return total;
+}
+
+PPC_TARGET_AVX2 double Min(const double *x, std::size_t n) {
+  __m256d best = _mm256_set1_pd(std::numeric_limits<double>::infinity());
+  std::size_t i = 0;
+  for (; i + kLanes <= n; i += kLanes) {
+    best = _mm256_min_pd(best, _mm256_loadu_pd(x + i));
+  }
+  alignas(32) std::array<double, kLanes> lanes{};
+  _mm256_store_pd(lanes.data(), best);
+  double result = std::ranges::min(lanes);
+  for (; i < n; i++) {
+    result = std::min(result, x[i]);
+  }
+  return result;
+}
+
+PPC_TARGET_AVX2 double Max(const double *x, std::size_t n) {
+  __m256d best = _mm256_set1_pd(-std::numeric_limits<double>::infinity());
+  std::size_t i = 0;
+  for (; i + kLanes <= n; i += kLanes) {
+    best = _mm256_max_pd(best, _mm256_loadu_pd(x + i));
+  }
+  alignas(32) std::array<double, kLanes> lanes{};
+  _mm256_store_pd(lanes.data(), best);
+  double result = std::ranges::max(lanes);
+  for (; i < n; i++) {
+    result = std::max(result, x[i]);
+  }
+  return result;
+}
+
+PPC_TARGET_AVX2 std::size_t SignAlternations(const double *x, std::size_t n) {
+  const __m256d zero = _mm256_setzero_pd();
+  std::size_t count = 0;
+  std::size_t i = 0;
+  for (; i + kLanes < n; i += kLanes) {
+    const __m256d a = _mm256_loadu_pd(x + i);
+    const __m256d b = _mm256_loadu_pd(x + i + 1);
+    const __m256d up = _mm256_and_pd(_mm256_cmp_pd(a, zero, _CMP_LT_OQ), _mm256_cmp_pd(b, zero, _CMP_GT_OQ));
+    const __m256d down = _mm256_and_pd(_mm256_cmp_pd(a, zero, _CMP_GT_OQ), _mm256_cmp_pd(b, zero, _CMP_LT_OQ));
+    count += static_cast<std::size_t>(__builtin_popcount(_mm256_movemask_pd(_mm256_or_pd(up, down))));
+  }
+  return count + scalar::SignAlternations(x + i, n - i);
+}
+
+PPC_TARGET_AVX2 std::size_t OrderViolations(const double *x, std::size_t n) {
+  std::size_t count = 0;
+  std::size_t i = 0;
+  for (; i + kLanes < n; i += kLanes) {
+    const __m256d gt = _mm256_cmp_pd(_mm256_loadu_pd(x + i), _mm256_loadu_pd(x + i + 1), _CMP_GT_OQ);
+    count += static_cast<std::size_t>(__builtin_popcount(_mm256_movemask_pd(gt)));
+  }
+  return count + scalar::OrderViolations(x + i, n - i);
+}
+
+PPC_TARGET_AVX2 __m256d AbsGap(const double *x) {
+  const __m256d sign = _mm256_set1_pd(-0.0);
+  return _mm256_andnot_pd(sign, _mm256_sub_pd(_mm256_loadu_pd(x + 1), _mm256_loadu_pd(x)));
+}
+
+PPC_TARGET_AVX2 double MinGap(const double *x, std::size_t n) {
+  __m256d best = _mm256_set1_pd(std::numeric_limits<double>::infinity());
+  std::size_t i = 0;
+  for (; i + kLanes < n; i += kLanes) {
+    best = _mm256_min_pd(best, AbsGap(x + i));
+  }
+  alignas(32) std::array<double, kLanes> lanes{};
+  _mm256_store_pd(lanes.data(), best);
+  return std::min(std::ranges::min(lanes), scalar::MinGap(x + i, n - i));
+}
+
+PPC_TARGET_AVX2 double MaxGap(const double *x, std::size_t n) {
+  __m256d best = _mm256_set1_pd(-std::numeric_limits<double>::infinity());
+  std::size_t i = 0;
+  for (; i + kLanes < n; i += kLanes) {
+    best = _mm256_max_pd(best, AbsGap(x + i));
+  }
+  alignas(32) std::array<double, kLanes> lanes{};
+  _mm256_store_pd(lanes.data(), best);
+  return std::max(std::ranges::max(lanes), scalar::MaxGap(x + i, n - i));
+}
+
+PPC_TARGET_AVX2 void AccumulateSum(double *acc, const double *row, std::size_t n) {
+  std::size_t j = 0;
+  for (; j + kLanes <= n; j += kLanes) {
+    _mm256_storeu_pd(acc + j, _mm256_add_pd(_mm256_loadu_pd(acc + j), _mm256_loadu_pd(row + j)));
+  }
+  scalar::AccumulateSum(acc + j, row + j, n - j);
+}
+
+PPC_TARGET_AVX2 void AccumulateMin(double *acc, const double *row, std::size_t n) {
+  std::size_t j = 0;
+  for (; j + kLanes <= n; j += kLanes) {
+    _mm256_storeu_pd(acc + j, _mm256_min_pd(_mm256_loadu_pd(acc + j), _mm256_loadu_pd(row + j)));
+  }
+  scalar::AccumulateMin(acc + j, row + j, n - j);
+}
+
+PPC_TARGET_AVX2 void AccumulateMax(double *acc, const double *row, std::size_t n) {
+  std::size_t j = 0;
+  for (; j + kLanes <= n; j += kLanes) {
+    _mm256_storeu_pd(acc + j, _mm256_max_pd(_mm256_loadu_pd(acc + j), _mm256_loadu_pd(row + j)));
+  }
+  scalar::AccumulateMax(acc + j, row + j, n - j);
+}
+
+constexpr KernelTable kTable = {.sum_naive = SumNaive,
+                                .sum_kahan = SumKahan,
+                                .dot_naive = DotNaive,
+                                .dot_kahan = DotKahan,
+                                .min = Min,
+                                .max = Max,
+                                .sign_alternations = SignAlternations,
+                                .order_violations = OrderViolations,
+                                .min_gap = MinGap,
+                                .max_gap = MaxGap,
+                                .accumulate_sum = AccumulateSum,
+                                .accumulate_min = AccumulateMin,
+                                .accumulate_max = AccumulateMax};
+
+}  // namespace avx2
+
+namespace avx512 {
+
+constexpr std::size_t kLanes = 8;
+
+// Stores instead of _mm512_reduce_*_pd: GCC 12 flags the undefined upper half those use.
+PPC_TARGET_AVX512 std::array<double, kLanes> Lanes(__m512d v) {
+  alignas(64) std::array<double, kLanes> lanes{};
+  _mm512_store_pd(lanes.data(), v);
+  return lanes;
+}
+
+PPC_TARGET_AVX512 double Horizontal(__m512d v) {
+  const auto lanes = Lanes(v);
+  return ((lanes[0] + lanes[1]) + (lanes[2] + lanes[3])) + ((lanes[4] + lanes[5]) + (lanes[6] + lanes[7]));
+}
+
+PPC_TARGET_AVX512 double HorizontalMin(__m512d v) {
+  const auto lanes = Lanes(v);
+  return *std::ranges::min_element(lanes);
+}
+
+PPC_TARGET_AVX512 double HorizontalMax(__m512d v) {
+  const auto lanes = Lanes(v);
+  return *std::ranges::max_element(lanes);
+}
+
+// The masked forms take an explicit pass-through operand, which avoids the same warning.
+PPC_TARGET_AVX512 __m512d MinPd(__m512d a, __m512d b) {
+  return _mm512_mask_min_pd(a, static_cast<__mmask8>(0xFF), a, b);
+}
+
+PPC_TARGET_AVX512 __m512d MaxPd(__m512d a, __m512d b) {
+  return _mm512_mask_max_pd(a, static_cast<__mmask8>(0xFF), a, b);
+}
+
+PPC_TARGET_AVX512 double FoldKahan(__m512d sum, __m512d comp, double &tail_comp) {
+  alignas(64) std::array<double, kLanes> sums{};
+  alignas(64) std::array<double, kLanes> comps{};
+  _mm512_store_pd(sums.data(), sum);
+  _mm512_store_pd(comps.data(), comp);
+  double total = 0.0;
+  tail_comp = 0.0;
+  for (std::size_t k = 0; k < kLanes; k++) {
+    KahanAdd(total, tail_comp, sums[k]);
+    KahanAdd(total, tail_comp, -comps[k]);
+  }
+  return total;
+}
+
+PPC_TARGET_AVX512 double SumNaive(const double *x, std::size_t n) {
+  __m512d a0 = _mm512_setzero_pd();
+  __m512d a1 = _mm512_setzero_pd();
+  __m512d a2 = _mm512_setzero_pd();
+  __m512d a3 = _mm512_setzero_pd();
+  std::size_t i = 0;
+  for (; i + (4 * kLanes) <= n; i += 4 * kLanes) {
+    a0 = _mm512_add_pd(a0, _mm512_loadu_pd(x + i));
+    a1 = _mm512_add_pd(a1, _mm512_loadu_pd(x + i + kLanes));
+    a2 = _mm512_add_pd(a2, _mm512_loadu_pd(x + i + (2 * kLanes)));
+    a3 = _mm512_add_pd(a3, _mm512_loadu_pd(x + i + (3 * kLanes)));
+  }
+  for (; i + kLanes <= n; i += kLanes) {
+    a0 = _mm512_add_pd(a0, _mm512_loadu_pd(x + i));
+  }
+  double sum = Horizontal(_mm512_add_pd(_mm512_add_pd(a0, a1), _mm512_add_pd(a2, a3)));
+  for (; i < n; i++) {
+    sum += x[i];
+  }
+  return sum;
+}
+
+PPC_TARGET_AVX512 double SumKahan(const double *x, std::size_t n) {
+  __m512d sum = _mm512_setzero_pd();
+  __m512d comp = _mm512_setzero_pd();
+  std::size_t i = 0;
+  for (; i + kLanes <= n; i += kLanes) {
+    const __m512d y = _mm512_sub_pd(_mm512_loadu_pd(x + i), comp);
+    const __m512d t = _mm512_add_pd(sum, y);
+    comp = _mm512_sub_pd(_mm512_sub_pd(t, sum), y);
+    sum = t;
+  }
+  double tail_comp = 0.0;
+  double total = FoldKahan(sum, comp, tail_comp);
+  for (; i < n; i++) {
+    KahanAdd(total, tail_comp, x[i]);
+  }
+  return total;
+}
+
+PPC_TARGET_AVX512 double DotNaive(const double *x, const double *y, std::size_t n) {
+  __m512d a0 = _mm512_setzero_pd();
+  __m512d a1 = _mm512_setzero_pd();
+  std::size_t i = 0;
+  for (; i + (2 * kLanes) <= n; i += 2 * kLanes) {
+    a0 = _mm512_add_pd(a0, _mm512_mul_pd(_mm512_loadu_pd(x + i), _mm512_loadu_pd(y + i)));
+    a1 = _mm512_add_pd(a1, _mm512_mul_pd(_mm512_loadu_pd(x + i + kLanes), _mm512_loadu_pd(y + i + kLanes)));
+  }
+  double sum = Horizontal(_mm512_add_pd(a0, a1));
+  for (; i < n; i++) {
+    sum += x[i] * y[i];
+  }
+  return sum;
+}
+
+PPC_TARGET_AVX512 double DotKahan(const double *x, const double *y, std::size_t n) {
+  __m512d sum = _mm512_setzero_pd();
+  __m512d comp = _mm512_setzero_pd();
+  std::size_t i = 0;
+  for (; i + kLanes <= n; i += kLanes) {
+    const __m512d v = _mm512_mul_pd(_mm512_loadu_pd(x + i), _mm512_loadu_pd(y + i));
+    const __m512d w = _mm512_sub_pd(v, comp);
+    const __m512d t = _mm512_add_pd(sum, w);
+    comp = _mm512_sub_pd(_mm512_sub_pd(t, sum), w);
+    sum = t;
+  }
+  double tail_comp = 0.0;
+  double total = FoldKahan(sum, comp, tail_comp);
+  for (; i < n; i++) {
+    KahanAdd(total, tail_comp, x[i] * y[i]);
+  }
+  return total;
+}
+
+PPC_TARGET_AVX512 double Min(const double *x, std::size_t n) {
+  __m512d best = _mm512_set1_pd(std::numeric_limits<double>::infinity());
+  std::size_t i = 0;
+  for (; i + kLanes <= n; i += kLanes) {
+    best = MinPd(best, _mm512_loadu_pd(x + i));
+  }
+  double result = HorizontalMin(best);
+  for (; i < n; i++) {
+    result = std::min(result, x[i]);
+  }
+  return result;
+}
+
+PPC_TARGET_AVX512 double Max(const double *x, std::size_t n) {
+  __m512d best = _mm512_set1_pd(-std::numeric_limits<double>::infinity());
+  std::size_t i = 0;
+  for (; i + kLanes <= n; i += kLanes) {
+    best = MaxPd(best, _mm512_loadu_pd(x + i));
+  }
+  double result = HorizontalMax(best);
+  for (; i < n; i++) {
+    result = std::max(result, x[i]);
+  }
+  return result;
+}
+
+PPC_TARGET_AVX512 std::size_t SignAlternations(const double *x, std::size_t n) {
+  const __m512d zero = _mm512_setzero_pd();
+  std::size_t count = 0;
+  std::size_t i = 0;
+  for (; i + kLanes < n; i += kLanes) {
+    const __m512d a = _mm512_loadu_pd(x + i);
+    const __m512d b = _mm512_loadu_pd(x + i + 1);
+    const __mmask8 up = _mm512_cmp_pd_mask(a, zero, _CMP_LT_OQ) & _mm512_cmp_pd_mask(b, zero, _CMP_GT_OQ);
+    const __mmask8 down = _mm512_cmp_pd_mask(a, zero, _CMP_GT_OQ) & _mm512_cmp_pd_mask(b, zero, _CMP_LT_OQ);
+    count += static_cast<std::size_t>(__builtin_popcount(static_cast<unsigned>(up | down)));
+  }
+  return count + scalar::SignAlternations(x + i, n - i);
+}
+
+PPC_TARGET_AVX512 std::size_t OrderViolations(const double *x, std::size_t n) {
+  std::size_t count = 0;
+  std::size_t i = 0;
+  for (; i + kLanes < n; i += kLanes) {
+    const __mmask8 gt = _mm512_cmp_pd_mask(_mm512_loadu_pd(x + i), _mm512_loadu_pd(x + i + 1), _CMP_GT_OQ);
+    count += static_cast<std::size_t>(__builtin_popcount(static_cast<unsigned>(gt)));
+  }
+  return count + scalar::OrderViolations(x + i, n - i);
+}
+
+PPC_TARGET_AVX512 __m512d AbsGap(const double *x) {
+  return _mm512_abs_pd(_mm512_sub_pd(_mm512_loadu_pd(x + 1), _mm512_loadu_pd(x)));
+}
+
+PPC_TARGET_AVX512 double MinGap(const double *x, std::size_t n) {
+  __m512d best = _mm512_set1_pd(std::numeric_limits<double>::infinity());
+  std::size_t i = 0;
+  for (; i + kLanes < n; i += kLanes) {
+    best = MinPd(best, AbsGap(x + i));
+  }
+  return std::min(HorizontalMin(best), scalar::MinGap(x + i, n - i));
+}
+
+PPC_TARGET_AVX512 double MaxGap(const double *x, std::size_t n) {
+  __m512d best = _mm512_set1_pd(-std::numeric_limits<double>::infinity());
+  std::size_t i = 0;
+  for (; i + kLanes < n; i += kLanes) {
+    best = MaxPd(best, AbsGap(x + i));
+  }
+  return std::max(HorizontalMax(best), scalar::MaxGap(x + i, n - i));
+}
+
+PPC_TARGET_AVX512 void AccumulateSum(double *acc, const double *row, std::size_t n) {
+  std::size_t j = 0;
+  for (; j + kLanes <= n; j += kLanes) {
+    _mm512_storeu_pd(acc + j, _mm512_add_pd(_mm512_loadu_pd(acc + j), _mm512_loadu_pd(row + j)));
+  }
+  scalar::AccumulateSum(acc + j, row + j, n - j);
+}
+
+PPC_TARGET_AVX512 void AccumulateMin(double *acc, const double *row, std::size_t n) {
+  std::size_t j = 0;
+  for (; j + kLanes <= n; j += kLanes) {
+    _mm512_storeu_pd(acc + j, MinPd(_mm512_loadu_pd(acc + j), _mm512_loadu_pd(row + j)));
+  }
+  scalar::AccumulateMin(acc + j, row + j, n - j);
+}
+
+PPC_TARGET_AVX512 void AccumulateMax(double *acc, const double *row, std::size_t n) {
+  std::size_t j = 0;
+  for (; j + kLanes <= n; j += kLanes) {
+    _mm512_storeu_pd(acc + j, MaxPd(_mm512_loadu_pd(acc + j), _mm512_loadu_pd(row + j)));
+  }
+  scalar::AccumulateMax(acc + j, row + j, n - j);
+}
+
+constexpr KernelTable kTable = {.sum_naive = SumNaive,
+                                .sum_kahan = SumKahan,
+                                .dot_naive = DotNaive,
+                                .dot_kahan = DotKahan,
+                                .min = Min,
+                                .max = Max,
+                                .sign_alternations = SignAlternations,
+                                .order_violations = OrderViolations,
+                                .min_gap = MinGap,
+                                .max_gap = MaxGap,
+                                .accumulate_sum = AccumulateSum,
+                                .accumulate_min = AccumulateMin,
+                                .accumulate_max = AccumulateMax};
+
+}  // namespace avx512
+
+#endif  // PPC_REDUCTION_X86
+
+const KernelTable &Kernels() {
+#ifdef PPC_REDUCTION_X86
+  switch (ActiveIsa()) {
+    case Isa::kAvx512:
+      return avx512::kTable;
+    case Isa::kAvx2:
+      return avx2::kTable;
+    case Isa::kScalar:
+      return scalar::kTable;
+  }
+#endif
+  return scalar::kTable;
+}
+
+/// Naive sums of GetTuning().pairwise_block elements combined in a balanced binary tree.
+double PairwiseSum(const double *x, std::size_t n, std::size_t block, const KernelTable &kernels) {
+  if (n <= block) {
+    return kernels.sum_naive(x, n);
+  }
+  const std::size_t half = (((n / 2) + block - 1) / block) * block;
+  return PairwiseSum(x, half, block, kernels) + PairwiseSum(x + half, n - half, block, kernels);
+}
+
+double PairwiseDot(const double *x, const double *y, std::size_t n, std::size_t block, const KernelTable &kernels) {
+  if (n <= block) {
+    return kernels.dot_naive(x, y, n);
+  }
+  const std::size_t half = (((n / 2) + block - 1) / block) * block;
+  return PairwiseDot(x, y, half, block, kernels) + PairwiseDot(x + half, y + half, n - half, block, kernels);
+}
+
+void RequireNonEmpty(std::size_t size, std::size_t minimum, const char *what) {
+  if (size < minimum) {
+    throw std::invalid_argument(std::string("reduction: ") + what + " needs at least " + std::to_string(minimum) +
+                                " element(s)");
+  }
+}
+
+/// First adjacent pair whose gap equals @p gap, as computed by the vector kernels.
+AdjacentPair FindGap(std::span<const double> x, double gap) {
+  for (std::size_t i = 0; i + 1 < x.size(); i++) {
+    if (std::abs(x[i + 1] - x[i]) == gap) {
+      return {.index = i, .difference = gap};
+    }
+  }
+  return {.index = 0, .difference = std::abs(x[1] - x[0])};
+}
+
+}  // namespace
+
+std::string IsaToString(Isa isa) {
+  switch (isa) {
+    case Isa::kScalar:
+      return "scalar";
+    case Isa::kAvx2:
+      return "avx2";
+    case Isa::kAvx512:
+      return "avx512";
+  }
+  return "unknown";
+}
+
+std::string SummationToString(Summation summation) {
+  switch (summation) {
+    case Summation::kNaive:
+      return "naive";
+    case Summation::kKahan:
+      return "kahan";
+    case Summation::kPairwise:
+      return "pairwise";
+  }
+  return "unknown";
+}
+
+Isa DetectIsa() {
+#ifdef PPC_REDUCTION_X86
+  static const Isa kDetected = [] {
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f") != 0) {
+      return Isa::kAvx512;
+    }
+    if (__builtin_cpu_supports("avx2") != 0) {
+      return Isa::kAvx2;
+    }
+    return Isa::kScalar;
+  }();
+  return kDetected;
+#else
+  return Isa::kScalar;
+#endif
+}
+
+Tuning &GetTuning() {
+  static Tuning tuning;
+  return tuning;
+}
+
+Isa ActiveIsa() {
+  return std::min(GetTuning().isa, DetectIsa());
+}
+
+double Sum(std::span<const double> x, Summation summation) {
+  const auto &kernels = Kernels();
+  switch (summation) {
+    case Summation::kNaive:
+      return kernels.sum_naive(x.data(), x.size());
+    case Summation::kKahan:
+      return kernels.sum_kahan(x.data(), x.size());
+    case Summation::kPairwise:
+      return PairwiseSum(x.data(), x.size(), std::max<std::size_t>(GetTuning().pairwise_block, 1), kernels);
+  }
+  return 0.0;
+}
+
+double Dot(std::span<const double> x, std::span<const double> y, Summation summation) {
+  if (x.size() != y.size()) {
+    throw std::invalid_argument("reduction: dot product of vectors of different length");
+  }
+  const auto &kernels = Kernels();
+  switch (summation) {
+    case Summation::kNaive:
+      return kernels.dot_naive(x.data(), y.data(), x.size());
+    case Summation::kKahan:
+      return kernels.dot_kahan(x.data(), y.data(), x.size());
+    case Summation::kPairwise:
+      return PairwiseDot(x.data(), y.data(), x.size(), std::max<std::size_t>(GetTuning().pairwise_block, 1),
+                         kernels);
+  }
+  return 0.0;
+}
+
+double Min(std::span<const double> x) {
+  RequireNonEmpty(x.size(), 1, "min");
+  return Kernels().min(x.data(), x.size());
+}
+
+double Max(std::span<const double> x) {
+  RequireNonEmpty(x.size(), 1, "max");
+  return Kernels().max(x.data(), x.size());
+}
+
+double Reduce(std::span<const double> x, Op op) {
+  switch (op) {
+    case Op::kSum:
+      return Sum(x);
+    case Op::kMin:
+      return Min(x);
+    case Op::kMax:
+      return Max(x);
+  }
+  return 0.0;
+}
+
+std::size_t CountSignAlternations(std::span<const double> x) {
+  return Kernels().sign_alternations(x.data(), x.size());
+}
+
+std::size_t CountOrderViolations(std::span<const double> x) {
+  return Kernels().order_violations(x.data(), x.size());
+}
+
+AdjacentPair ClosestAdjacent(std::span<const double> x) {
+  RequireNonEmpty(x.size(), 2, "closest adjacent pair");
+  return FindGap(x, Kernels().min_gap(x.data(), x.size()));
+}
+
+AdjacentPair FarthestAdjacent(std::span<const double> x) {
+  RequireNonEmpty(x.size(), 2, "farthest adjacent pair");
+  return FindGap(x, Kernels().max_gap(x.data(), x.size()));
+}
+
+void AccumulateColumns(std::span<double> acc, std::span<const double> row, Op op) {
+  if (acc.size() != row.size()) {
+    throw std::invalid_argument("reduction: row length differs from the number of columns");
+  }
+  const auto &kernels = Kernels();
+  switch (op) {
+    case Op::kSum:
+      kernels.accumulate_sum(acc.data(), row.data(), row.size());
+      return;
+    case Op::kMin:
+      kernels.accumulate_min(acc.data(), row.data(), row.size());
+      return;
+    case Op::kMax:
+      kernels.accumulate_max(acc.data(), row.data(), row.size());
+      return;
+  }
+}
+
+}  // namespace ppc::reduction
@@ -0,0 +1,245 @@
+#include <gtest/gtest.h>
+
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <random>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "reduction/include/reduction.hpp"
+#include "reduction/include/reduction_tasks.hpp"
+#include "shared_memory/include/shared_memory.hpp"
+#include "task/include/task.hpp"
+#include "util/include/func_test_util.hpp"
+
+using ppc::reduction::Isa;
+using ppc::reduction::Op;
+using ppc::reduction::Summation;
+using ppc::task::TypeOfTask;
+
+namespace {
+
+constexpr std::array<Isa, 3> kAllIsas = {Isa::kScalar, Isa::kAvx2, Isa::kAvx512};
+
+std::vector<double> RandomVector(std::size_t count, unsigned seed) {
+  std::mt19937_64 gen(seed);
+  std::uniform_real_distribution<double> dist(-100.0, 100.0);
+  std::vector<double> data(count);
+  for (auto &value : data) {
+    value = dist(gen);
+  }
+  return data;
+}
+
+/// Restores the tuned instruction set when a test that switches it ends.
+class IsaGuard {
+ public:
+  explicit IsaGuard(Isa isa) : saved_(ppc::reduction::GetTuning().isa) {
+    ppc::reduction::GetTuning().isa = isa;
+  }
+  IsaGuard(const IsaGuard &) = delete;
+  IsaGuard &operator=(const IsaGuard &) = delete;
+  ~IsaGuard() {
+    ppc::reduction::GetTuning().isa = saved_;
+  }
+
+ private:
+  Isa saved_;
+};
+
+/// Runs Kernel as @p chunks workers would, to exercise Combine independently of PPC_NUM_THREADS.
+template <typename Kernel>
+typename Kernel::OutType RunChunked(const typename Kernel::InType &in, int chunks) {
+  auto result = Kernel::Identity(in);
+  for (int chunk = 0; chunk < chunks; chunk++) {
+    auto partial = Kernel::Identity(in);
+    const auto [begin, end] = ppc::shared_memory::BlockRange(Kernel::Size(in), chunks, chunk);
+    Kernel::Accumulate(in, begin, end, partial);
+    Kernel::Combine(result, partial);
+  }
+  return Kernel::Finish(in, result);
+}
+
+template <typename Kernel, TypeOfTask kType>
+typename Kernel::OutType RunTask(const typename Kernel::InType &in) {
+  ppc::reduction::ReductionTask<Kernel, kType> task(in);
+  EXPECT_TRUE(task.Validation());
+  EXPECT_TRUE(task.PreProcessing());
+  EXPECT_TRUE(task.Run());
+  EXPECT_TRUE(task.PostProcessing());
+  return task.GetOutput();
+}
+
+}  // namespace
+
+TEST(Reduction, ActiveIsaIsClampedToCpu) {
+  const IsaGuard guard(Isa::kAvx512);
+  EXPECT_LE(static_cast<int>(ppc::reduction::ActiveIsa()), static_cast<int>(ppc::reduction::DetectIsa()));
+  EXPECT_EQ(ppc::reduction::IsaToString(Isa::kAvx2), "avx2");
+  EXPECT_EQ(ppc::reduction::SummationToString(Summation::kKahan), "kahan");
+}
+
+TEST(Reduction, VectorKernelsMatchScalar) {
+  for (const std::size_t count : {0UL, 1UL, 7UL, 31UL, 1000UL, 4099UL}) {
+    auto x = RandomVector(count, 1);
+    const auto y = RandomVector(count, 2);
+    if (count > 5) {
+      x[3] = 0.0;
+      x[4] = x[3] + 1.5;
+      x[5] = x[4];
+    }
+    for (const Isa isa : kAllIsas) {
+      const IsaGuard guard(isa);
+      for (const Summation summation : {Summation::kNaive, Summation::kKahan, Summation::kPairwise}) {
+        double expected_sum = 0.0;
+        double expected_dot = 0.0;
+        for (std::size_t i = 0; i < count; i++) {
+          expected_sum += x[i];
+          expected_dot += x[i] * y[i];
+        }
+        EXPECT_NEAR(ppc::reduction::Sum(x, summation), expected_sum, 1e-9 * static_cast<double>(count + 1));
+        EXPECT_NEAR(ppc::reduction::Dot(x, y, summation), expected_dot, 1e-7 * static_cast<double>(count + 1));
+      }
+      if (count == 0) {
+        continue;
+      }
+      std::size_t alternations = 0;
+      std::size_t violations = 0;
+      ppc::reduction::AdjacentPair closest{.index = 0, .difference = INFINITY};
+      ppc::reduction::AdjacentPair farthest{.index = 0, .difference = -1.0};
+      for (std::size_t i = 0; i + 1 < count; i++) {
+        alternations += static_cast<std::size_t>((x[i] < 0.0 && x[i + 1] > 0.0) || (x[i] > 0.0 && x[i + 1] < 0.0));
+        violations += static_cast<std::size_t>(x[i] > x[i + 1]);
+        const double difference = std::abs(x[i + 1] - x[i]);
+        if (difference < closest.difference) {
+          closest = {.index = i, .difference = difference};
+        }
+        if (difference > farthest.difference) {
+          farthest = {.index = i, .difference = difference};
+        }
+      }
+      EXPECT_EQ(ppc::reduction::Min(x), *std::ranges::min_element(x));
+      EXPECT_EQ(ppc::reduction::Max(x), *std::ranges::max_element(x));
+      EXPECT_EQ(ppc::reduction::CountSignAlternations(x), alternations);
+      EXPECT_EQ(ppc::reduction::CountOrderViolations(x), violations);
+      if (count >= 2) {
+        EXPECT_EQ(ppc::reduction::ClosestAdjacent(x).index, closest.index);
+        EXPECT_EQ(ppc::reduction::ClosestAdjacent(x).difference, closest.difference);
+        EXPECT_EQ(ppc::reduction::FarthestAdjacent(x).index, farthest.index);
+      }
+    }
+  }
+}
+
+TEST(Reduction, CompensatedSummationIsAccurate) {
+  // 1 followed by many values below half an ulp of 1: naive accumulation drops them all.
+  std::vector<double> x(100000, 1e-17);
+  x[0] = 1.0;
+  const double exact = 1.0 + (1e-17 * static_cast<double>(x.size() - 1));
+  for (const Isa isa : kAllIsas) {
+    const IsaGuard guard(isa);
+    EXPECT_NEAR(ppc::reduction::Sum(x, Summation::kKahan), exact, 1e-16);
+    EXPECT_LT(std::abs(ppc::reduction::Sum(x, Summation::kPairwise) - exact),
+              std::abs(ppc::reduction::Sum(x, Summation::kNaive) - exact) + 1e-18);
+  }
+}
+
+TEST(Reduction, AccumulateColumnsAppliesOp) {
+  for (const Isa isa : kAllIsas) {
+    const IsaGuard guard(isa);
+    const auto row = RandomVector(19, 3);
+    std::vector<double> sums(19, 1.0);
+    std::vector<double> mins(19, 0.0);
+    ppc::reduction::AccumulateColumns(sums, row, Op::kSum);
+    ppc::reduction::AccumulateColumns(mins, row, Op::kMin);
+    for (std::size_t j = 0; j < row.size(); j++) {
+      EXPECT_EQ(sums[j], 1.0 + row[j]);
+      EXPECT_EQ(mins[j], std::min(0.0, row[j]));
+    }
+  }
+}
+
+TEST(Reduction, RejectsInvalidArguments) {
+  const std::vector<double> empty;
+  const std::vector<double> one = {1.0};
+  const std::vector<double> two = {1.0, 2.0};
+  EXPECT_THROW((void)ppc::reduction::Min(empty), std::invalid_argument);
+  EXPECT_THROW((void)ppc::reduction::Reduce(empty, Op::kMax), std::invalid_argument);
+  EXPECT_EQ(ppc::reduction::Reduce(empty, Op::kSum), 0.0);
+  EXPECT_THROW((void)ppc::reduction::Dot(one, two), std::invalid_argument);
+  EXPECT_THROW((void)ppc::reduction::ClosestAdjacent(one), std::invalid_argument);
+  std::vector<double> acc(1);
+  EXPECT_THROW(ppc::reduction::AccumulateColumns(acc, two, Op::kSum), std::invalid_argument);
+
+  ppc::reduction::ReductionTask<ppc::reduction::MinKernel, TypeOfTask::kSEQ> task(empty);
+  EXPECT_FALSE(task.Validation());
+  task.PreProcessing();
+  task.Run();
+  task.PostProcessing();
+}
+
+TEST(Reduction, ChunkedKernelsMatchWholeRange) {
+  auto x = RandomVector(1001, 4);
+  x[500] = x[499];  // tie at a chunk boundary of some chunk counts
+  const ppc::reduction::Matrix matrix{.rows = 37, .cols = 23, .values = RandomVector(37 * 23, 5)};
+  for (const int chunks : {1, 2, 3, 7, 64}) {
+    EXPECT_NEAR(RunChunked<ppc::reduction::SumKernel<>>(x, chunks), ppc::reduction::Sum(x), 1e-9);
+    EXPECT_EQ(RunChunked<ppc::reduction::MaxKernel>(x, chunks), ppc::reduction::Max(x));
+    EXPECT_EQ(RunChunked<ppc::reduction::SignAlternationsKernel>(x, chunks), ppc::reduction::CountSignAlternations(x));
+    EXPECT_EQ(RunChunked<ppc::reduction::OrderViolationsKernel>(x, chunks), ppc::reduction::CountOrderViolations(x));
+    EXPECT_EQ(RunChunked<ppc::reduction::ClosestAdjacentKernel>(x, chunks).index, 499U);
+    EXPECT_EQ(RunChunked<ppc::reduction::FarthestAdjacentKernel>(x, chunks).index,
+              ppc::reduction::FarthestAdjacent(x).index);
+    const auto col_max = RunChunked<ppc::reduction::ColReduceKernel<Op::kMax>>(matrix, chunks);
+    const auto row_sum = RunChunked<ppc::reduction::RowReduceKernel<Op::kSum>>(matrix, chunks);
+    ASSERT_EQ(col_max.size(), matrix.cols);
+    ASSERT_EQ(row_sum.size(), matrix.rows);
+    for (std::size_t i = 0; i < matrix.rows; i++) {
+      for (std::size_t j = 0; j < matrix.cols; j++) {
+        EXPECT_LE(matrix.values[(i * matrix.cols) + j], col_max[j]);
+      }
+      EXPECT_NEAR(row_sum[i], ppc::reduction::Sum(std::span(matrix.values).subspan(i * matrix.cols, matrix.cols)),
+                  1e-12);
+    }
+  }
+}
+
+TEST(Reduction, ThreadBackendsAgreeWithSequential) {
+  const auto x = RandomVector(5000, 6);
+  const std::pair<std::vector<double>, std::vector<double>> xy{x, RandomVector(5000, 7)};
+  const double sum = RunTask<ppc::reduction::SumKernel<Summation::kKahan>, TypeOfTask::kSEQ>(x);
+  const double dot = RunTask<ppc::reduction::DotKernel<>, TypeOfTask::kSEQ>(xy);
+  const auto closest = RunTask<ppc::reduction::ClosestAdjacentKernel, TypeOfTask::kSEQ>(x);
+
+  EXPECT_NEAR((RunTask<ppc::reduction::SumKernel<Summation::kKahan>, TypeOfTask::kOMP>(x)), sum, 1e-9);
+  EXPECT_NEAR((RunTask<ppc::reduction::SumKernel<Summation::kKahan>, TypeOfTask::kTBB>(x)), sum, 1e-9);
+  EXPECT_NEAR((RunTask<ppc::reduction::SumKernel<Summation::kKahan>, TypeOfTask::kSTL>(x)), sum, 1e-9);
+  EXPECT_NEAR((RunTask<ppc::reduction::DotKernel<>, TypeOfTask::kOMP>(xy)), dot, 1e-6);
+  EXPECT_NEAR((RunTask<ppc::reduction::MeanKernel<>, TypeOfTask::kSTL>(x)), sum / 5000.0, 1e-12);
+  EXPECT_EQ((RunTask<ppc::reduction::ClosestAdjacentKernel, TypeOfTask::kTBB>(x)).index, closest.index);
+}
+
+TEST(ReductionMPI, RanksAgreeWithSequential) {
+  if (!ppc::util::MpiReady()) {
+    GTEST_SKIP() << "MPI is not initialized";
+  }
+  const auto x = RandomVector(3001, 8);
+  const ppc::reduction::Matrix matrix{.rows = 11, .cols = 9, .values = RandomVector(99, 9)};
+  EXPECT_NEAR((RunTask<ppc::reduction::SumKernel<>, TypeOfTask::kMPI>(x)),
+              (RunTask<ppc::reduction::SumKernel<>, TypeOfTask::kSEQ>(x)), 1e-9);
+  EXPECT_EQ((RunTask<ppc::reduction::MinKernel, TypeOfTask::kMPI>(x)), ppc::reduction::Min(x));
+  EXPECT_EQ((RunTask<ppc::reduction::OrderViolationsKernel, TypeOfTask::kMPI>(x)),
+            ppc::reduction::CountOrderViolations(x));
+  EXPECT_EQ((RunTask<ppc::reduction::FarthestAdjacentKernel, TypeOfTask::kMPI>(x)).index,
+            ppc::reduction::FarthestAdjacent(x).index);
+  EXPECT_EQ((RunTask<ppc::reduction::RowReduceKernel<Op::kMin>, TypeOfTask::kMPI>(matrix)),
+            (RunTask<ppc::reduction::RowReduceKernel<Op::kMin>, TypeOfTask::kSEQ>(matrix)));
+  const auto col_sum = RunTask<ppc::reduction::ColReduceKernel<Op::kSum>, TypeOfTask::kMPI>(matrix);
+  const auto col_sum_seq = RunTask<ppc::reduction::ColReduceKernel<Op::kSum>, TypeOfTask::kSEQ>(matrix);
+  ASSERT_EQ(col_sum.size(), col_sum_seq.size());
+  for (std::size_t j = 0; j < col_sum.size(); j++) {
+    EXPECT_NEAR(col_sum[j], col_sum_seq[j], 1e-12);
+  }
+}
@@ -0,0 +1,52 @@
+#pragma once
+
+#include <mpi.h>
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace ppc::runners {
+
+/// @brief Point-to-point traffic this rank has issued on one communicator.
+struct CommTraffic {
+  /// Name from MPI_Comm_get_name, "unnamed" when none was set
+  std::string name;
+  /// MPI_COMM_WORLD ranks of the members (local and remote group of inter-communicators)
+  std::vector<int> world_ranks;
+  /// Messages sent by this rank, MPI_PROC_NULL excluded
+  std::int64_t sent = 0;
+  /// Receives posted by this rank, MPI_PROC_NULL excluded
+  std::int64_t received = 0;
+  /// Whether MPI_Comm_free was called on the communicator
+  bool freed = false;
+};
+
+/// @brief Communicator whose messages do not add up across its members.
+struct UnbalancedComm {
+  /// Local traffic of the calling rank on the communicator
+  CommTraffic traffic;
+  /// Sends minus receives summed over all ranks (and over communicators sharing the bucket)
+  std::int64_t imbalance = 0;
+};
+
+/// @brief Whether the PMPI interposition layer is compiled in (PPC_MPI_ACCOUNTING).
+/// @details When it is, every MPI_Send/Isend/Recv/Irecv/Sendrecv/persistent/matched-probe
+/// call of the program is counted per communicator before being passed to the PMPI entry
+/// point. Collectives and one-sided operations are not counted.
+bool MessageAccountingEnabled();
+
+/// @brief Traffic of every communicator the calling rank has used, freed ones included.
+std::vector<CommTraffic> MessageTraffic();
+
+/// @brief Checks that every message sent so far has been received (or a receive posted).
+/// @details Collective over @p comm, which must contain every rank that communicated. Costs a
+/// single MPI_Allreduce of a fixed number of per-communicator balance buckets.
+/// @return Communicators the calling rank belongs to whose bucket does not balance; empty
+/// everywhere when all traffic is matched or accounting is disabled.
+std::vector<UnbalancedComm> FindUnbalancedComms(MPI_Comm comm = MPI_COMM_WORLD);
+
+/// @brief Human-readable description: name, members and local counts.
+std::string Describe(const UnbalancedComm &comm);
+
+}  // namespace ppc::runners
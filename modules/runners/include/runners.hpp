@@ -8,6 +8,9 @@
 namespace ppc::runners {
 
 /// @brief GTest event listener that checks for unread MPI messages after each test.
+/// @details With message accounting compiled in (see message_accounting.hpp) the check is a
+/// single reduction of per-communicator send/receive balances and names the leaking
+/// communicator; otherwise it falls back to barriers around an MPI_Iprobe on MPI_COMM_WORLD.
 /// @note Used to detect unexpected inter-process communication leftovers.
 class UnreadMessagesDetector : public ::testing::EmptyTestEventListener {
  public:
@@ -37,6 +40,7 @@ class WorkerTestFailurePrinter : public ::testing::EmptyTestEventListener {
 };
 
 /// @brief Initializes the testing environment (e.g., MPI, logging).
+/// @details MPI is started with MPI_Init_thread at ppc::hybrid::kRequestedThreadLevel.
 /// @param argc Argument count.
 /// @param argv Argument vector.
 /// @return Exit code from RUN_ALL_TESTS or MPI error code if initialization/
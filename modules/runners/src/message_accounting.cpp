@@ -0,0 +1,375 @@
+#include "runners/include/message_accounting.hpp"
+
+#include <mpi.h>
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <format>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace ppc::runners {
+
+namespace {
+
+/// Balance buckets reduced per check; communicators are spread over them by member hash.
+constexpr std::size_t kBalanceBuckets = 64;
+/// Members listed by Describe() before the list is cut short.
+constexpr std::size_t kDescribedRanks = 16;
+
+struct Record {
+  CommTraffic traffic;
+  std::uint64_t hash = 0;
+};
+
+/// FNV-1a over the sorted world ranks: equal on every member, so buckets line up across ranks.
+std::uint64_t HashRanks(const std::vector<int> &ranks) {
+  std::uint64_t hash = 14695981039346656037ULL;
+  for (const int rank : ranks) {
+    hash ^= static_cast<std::uint64_t>(static_cast<std::uint32_t>(rank));
+    hash *= 1099511628211ULL;
+  }
+  return hash;
+}
+
+void AppendWorldRanks(MPI_Group group, std::vector<int> &out) {
+  int size = 0;
+  MPI_Group_size(group, &size);
+  std::vector<int> ranks(static_cast<std::size_t>(size));
+  for (int i = 0; i < size; i++) {
+    ranks[static_cast<std::size_t>(i)] = i;
+  }
+  MPI_Group world_group = MPI_GROUP_NULL;
+  MPI_Comm_group(MPI_COMM_WORLD, &world_group);
+  std::vector<int> world(static_cast<std::size_t>(size));
+  MPI_Group_translate_ranks(group, size, ranks.data(), world_group, world.data());
+  MPI_Group_free(&world_group);
+  out.insert(out.end(), world.begin(), world.end());
+}
+
+Record Identify(MPI_Comm comm) {
+  Record record;
+  std::array<char, MPI_MAX_OBJECT_NAME> name{};
+  int length = 0;
+  MPI_Comm_get_name(comm, name.data(), &length);
+  record.traffic.name = length > 0 ? std::string(name.data(), static_cast<std::size_t>(length)) : "unnamed";
+
+  MPI_Group group = MPI_GROUP_NULL;
+  MPI_Comm_group(comm, &group);
+  AppendWorldRanks(group, record.traffic.world_ranks);
+  MPI_Group_free(&group);
+  int inter = 0;
+  MPI_Comm_test_inter(comm, &inter);
+  if (inter != 0) {
+    MPI_Comm_remote_group(comm, &group);
+    AppendWorldRanks(group, record.traffic.world_ranks);
+    MPI_Group_free(&group);
+  }
+  std::ranges::sort(record.traffic.world_ranks);
+  record.hash = HashRanks(record.traffic.world_ranks);
+  return record;
+}
+
+struct PersistentRequest {
+  MPI_Comm comm = MPI_COMM_NULL;
+  bool send = false;
+};
+
+class Ledger {
+ public:
+  static Ledger &Instance() {
+    static Ledger ledger;
+    return ledger;
+  }
+
+  void Count(MPI_Comm comm, std::int64_t sent, std::int64_t received) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = live_.find(comm);
+    if (it == live_.end()) {
+      it = live_.emplace(comm, Identify(comm)).first;
+    }
+    it->second.traffic.sent += sent;
+    it->second.traffic.received += received;
+  }
+
+  /// Keeps the counts of a communicator about to be freed; its handle may be reused.
+  void Retire(MPI_Comm comm) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = live_.find(comm);
+    if (it == live_.end()) {
+      return;
+    }
+    Record record = std::move(it->second);
+    live_.erase(it);
+    record.traffic.freed = true;
+    auto same = std::ranges::find_if(retired_, [&](const Record &r) {
+      return r.hash == record.hash && r.traffic.name == record.traffic.name &&
+             r.traffic.world_ranks == record.traffic.world_ranks;
+    });
+    if (same == retired_.end()) {
+      retired_.push_back(std::move(record));
+    } else {
+      same->traffic.sent += record.traffic.sent;
+      same->traffic.received += record.traffic.received;
+    }
+  }
+
+  void AddPersistent(MPI_Request request, MPI_Comm comm, bool send) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    persistent_[request] = {.comm = comm, .send = send};
+  }
+
+  void StartPersistent(MPI_Request request) {
+    PersistentRequest info;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      auto it = persistent_.find(request);
+      if (it == persistent_.end()) {
+        return;
+      }
+      info = it->second;
+    }
+    Count(info.comm, info.send ? 1 : 0, info.send ? 0 : 1);
+  }
+
+  void ForgetPersistent(MPI_Request request) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    persistent_.erase(request);
+  }
+
+  std::vector<Record> Records() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::vector<Record> records = retired_;
+    for (const auto &[comm, record] : live_) {
+      records.push_back(record);
+    }
+    return records;
+  }
+
+ private:
+  std::mutex mutex_;
+  std::unordered_map<MPI_Comm, Record> live_;
+  std::vector<Record> retired_;
+  std::unordered_map<MPI_Request, PersistentRequest> persistent_;
+};
+
+}  // namespace
+
+bool MessageAccountingEnabled() {
+#ifdef PPC_MPI_ACCOUNTING
+  return true;
+#else
+  return false;
+#endif
+}
+
+std::vector<CommTraffic> MessageTraffic() {
+  std::vector<CommTraffic> traffic;
+  for (auto &record : Ledger::Instance().Records()) {
+    traffic.push_back(std::move(record.traffic));
+  }
+  return traffic;
+}
+
+std::vector<UnbalancedComm> FindUnbalancedComms(MPI_Comm comm) {
+  if (!MessageAccountingEnabled()) {
+    return {};
+  }
+  const auto records = Ledger::Instance().Records();
+  std::array<std::int64_t, kBalanceBuckets> balance{};
+  for (const auto &record : records) {
+    balance[record.hash % kBalanceBuckets] += record.traffic.sent - record.traffic.received;
+  }
+  MPI_Allreduce(MPI_IN_PLACE, balance.data(), static_cast<int>(balance.size()), MPI_INT64_T, MPI_SUM, comm);
+
+  std::vector<UnbalancedComm> unbalanced;
+  for (const auto &record : records) {
+    const std::int64_t imbalance = balance[record.hash % kBalanceBuckets];
+    if (imbalance != 0 && (record.traffic.sent != 0 || record.traffic.received != 0)) {
+      unbalanced.push_back({.traffic = record.traffic, .imbalance = imbalance});
+    }
+  }
+  return unbalanced;
+}
+
+std::string Describe(const UnbalancedComm &comm) {
+  const auto &ranks = comm.traffic.world_ranks;
+  std::string members;
+  for (std::size_t i = 0; i < std::min(ranks.size(), kDescribedRanks); i++) {
+    members += (i == 0 ? "" : ",") + std::to_string(ranks[i]);
+  }
+  if (ranks.size() > kDescribedRanks) {
+    members += std::format(",... ({} ranks)", ranks.size());
+  }
+  const std::string problem = comm.imbalance > 0 ? std::format("{} message(s) sent but never received", comm.imbalance)
+                                                 : std::format("{} receive(s) never matched", -comm.imbalance);
+  return std::format("communicator '{}'{} of world ranks [{}]: {}; this rank sent {}, received {}",
+                     comm.traffic.name, comm.traffic.freed ? " (freed)" : "", members, problem, comm.traffic.sent,
+                     comm.traffic.received);
+}
+
+}  // namespace ppc::runners
+
+#ifdef PPC_MPI_ACCOUNTING
+
+// PMPI interposition: these definitions take precedence over the MPI library's, count the
+// call and forward it to the PMPI_ entry point. Only successful calls are counted.
+
+namespace {
+
+using ppc::runners::Ledger;
+
+int CountSend(int result, int dest, MPI_Comm comm) {
+  if (result == MPI_SUCCESS && dest != MPI_PROC_NULL) {
+    Ledger::Instance().Count(comm, 1, 0);
+  }
+  return result;
+}
+
+int CountRecv(int result, int source, MPI_Comm comm) {
+  if (result == MPI_SUCCESS && source != MPI_PROC_NULL) {
+    Ledger::Instance().Count(comm, 0, 1);
+  }
+  return result;
+}
+
+int AddPersistent(int result, int peer, MPI_Comm comm, const MPI_Request *request, bool send) {
+  if (result == MPI_SUCCESS && peer != MPI_PROC_NULL) {
+    Ledger::Instance().AddPersistent(*request, comm, send);
+  }
+  return result;
+}
+
+}  // namespace
+
+int MPI_Send(const void *buf, int count, MPI_Datatype datatype, int dest, int tag, MPI_Comm comm) {
+  return CountSend(PMPI_Send(buf, count, datatype, dest, tag, comm), dest, comm);
+}
+
+int MPI_Bsend(const void *buf, int count, MPI_Datatype datatype, int dest, int tag, MPI_Comm comm) {
+  return CountSend(PMPI_Bsend(buf, count, datatype, dest, tag, comm), dest, comm);
+}
+
+int MPI_Ssend(const void *buf, int count, MPI_Datatype datatype, int dest, int tag, MPI_Comm comm) {
+  return CountSend(PMPI_Ssend(buf, count, datatype, dest, tag, comm), dest, comm);
+}
+
+int MPI_Rsend(const void *buf, int count, MPI_Datatype datatype, int dest, int tag, MPI_Comm comm) {
+  return CountSend(PMPI_Rsend(buf, count, datatype, dest, tag, comm), dest, comm);
+}
+
+int MPI_Isend(const void *buf, int count, MPI_Datatype datatype, int dest, int tag, MPI_Comm comm,
+              MPI_Request *request) {
+  return CountSend(PMPI_Isend(buf, count, datatype, dest, tag, comm, request), dest, comm);
+}
+
+int MPI_Ibsend(const void *buf, int count, MPI_Datatype datatype, int dest, int tag, MPI_Comm comm,
+               MPI_Request *request) {
+  return CountSend(PMPI_Ibsend(buf, count, datatype, dest, tag, comm, request), dest, comm);
+}
+
+int MPI_Issend(const void *buf, int count, MPI_Datatype datatype, int dest, int tag, MPI_Comm comm,
+               MPI_Request *request) {
+  return CountSend(PMPI_Issend(buf, count, datatype, dest, tag, comm, request), dest, comm);
+}
+
+int MPI_Irsend(const void *buf, int count, MPI_Datatype datatype, int dest, int tag, MPI_Comm comm,
+               MPI_Request *request) {
+  return CountSend(PMPI_Irsend(buf, count, datatype, dest, tag, comm, request), dest, comm);
+}
+
+int MPI_Recv(void *buf, int count, MPI_Datatype datatype, int source, int tag, MPI_Comm comm, MPI_Status *status) {
+  return CountRecv(PMPI_Recv(buf, count, datatype, source, tag, comm, status), source, comm);
+}
+
+int MPI_Irecv(void *buf, int count, MPI_Datatype datatype, int source, int tag, MPI_Comm comm,
+              MPI_Request *request) {
+  return CountRecv(PMPI_Irecv(buf, count, datatype, source, tag, comm, request), source, comm);
+}
+
+int MPI_Sendrecv(const void *sendbuf, int sendcount, MPI_Datatype sendtype, int dest, int sendtag, void *recvbuf,
+                 int recvcount, MPI_Datatype recvtype, int source, int recvtag, MPI_Comm comm, MPI_Status *status) {
+  const int result = PMPI_Sendrecv(sendbuf, sendcount, sendtype, dest, sendtag, recvbuf, recvcount, recvtype, source,
+                                   recvtag, comm, status);
+  return CountRecv(CountSend(result, dest, comm), source, comm);
+}
+
+int MPI_Sendrecv_replace(void *buf, int count, MPI_Datatype datatype, int dest, int sendtag, int source,
+                         int recvtag, MPI_Comm comm, MPI_Status *status) {
+  const int result = PMPI_Sendrecv_replace(buf, count, datatype, dest, sendtag, source, recvtag, comm, status);
+  return CountRecv(CountSend(result, dest, comm), source, comm);
+}
+
+// A matched probe removes the message from the queue, so it counts as the receive.
+int MPI_Mprobe(int source, int tag, MPI_Comm comm, MPI_Message *message, MPI_Status *status) {
+  return CountRecv(PMPI_Mprobe(source, tag, comm, message, status), source, comm);
+}
+
+int MPI_Improbe(int source, int tag, MPI_Comm comm, int *flag, MPI_Message *message, MPI_Status *status) {
+  const int result = PMPI_Improbe(source, tag, comm, flag, message, status);
+  // The flag is only written on success; a failed probe matched nothing.
+  if (result != MPI_SUCCESS || *flag == 0) {
+    return result;
+  }
+  return CountRecv(result, source, comm);
+}
+
+int MPI_Send_init(const void *buf, int count, MPI_Datatype datatype, int dest, int tag, MPI_Comm comm,
+                  MPI_Request *request) {
+  return AddPersistent(PMPI_Send_init(buf, count, datatype, dest, tag, comm, request), dest, comm, request, true);
+}
+
+int MPI_Bsend_init(const void *buf, int count, MPI_Datatype datatype, int dest, int tag, MPI_Comm comm,
+                   MPI_Request *request) {
+  return AddPersistent(PMPI_Bsend_init(buf, count, datatype, dest, tag, comm, request), dest, comm, request, true);
+}
+
+int MPI_Ssend_init(const void *buf, int count, MPI_Datatype datatype, int dest, int tag, MPI_Comm comm,
+                   MPI_Request *request) {
+  return AddPersistent(PMPI_Ssend_init(buf, count, datatype, dest, tag, comm, request), dest, comm, request, true);
+}
+
+int MPI_Rsend_init(const void *buf, int count, MPI_Datatype datatype, int dest, int tag, MPI_Comm comm,
+                   MPI_Request *request) {
+  return AddPersistent(PMPI_Rsend_init(buf, count, datatype, dest, tag, comm, request), dest, comm, request, true);
+}
+
+int MPI_Recv_init(void *buf, int count, MPI_Datatype datatype, int source, int tag, MPI_Comm comm,
+                  MPI_Request *request) {
+  return AddPersistent(PMPI_Recv_init(buf, count, datatype, source, tag, comm, request), source, comm, request,
+                       false);
+}
+
+int MPI_Start(MPI_Request *request) {
+  const int result = PMPI_Start(request);
+  if (result == MPI_SUCCESS) {
+    Ledger::Instance().StartPersistent(*request);
+  }
+  return result;
+}
+
+int MPI_Startall(int count, MPI_Request array_of_requests[]) {
+  const int result = PMPI_Startall(count, array_of_requests);
+  if (result == MPI_SUCCESS) {
+    for (int i = 0; i < count; i++) {
+      Ledger::Instance().StartPersistent(array_of_requests[i]);
+    }
+  }
+  return result;
+}
+
+int MPI_Request_free(MPI_Request *request) {
+  Ledger::Instance().ForgetPersistent(*request);
+  return PMPI_Request_free(request);
+}
+
+int MPI_Comm_free(MPI_Comm *comm) {
+  Ledger::Instance().Retire(*comm);
+  return PMPI_Comm_free(comm);
+}
+
+#endif  // PPC_MPI_ACCOUNTING
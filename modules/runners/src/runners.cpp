@@ -15,6 +15,8 @@
 #include <string>
 #include <string_view>
 
+#include "hybrid/include/hybrid.hpp"
+#include "runners/include/message_accounting.hpp"
 #include "oneapi/tbb/global_control.h"
 #include "util/include/util.hpp"
 
@@ -24,6 +26,17 @@ void UnreadMessagesDetector::OnTestEnd(const ::testing::TestInfo & /*test_info*/
   int rank = -1;
   MPI_Comm_rank(MPI_COMM_WORLD, &rank);
 
+  if (MessageAccountingEnabled()) {
+    const auto unbalanced = FindUnbalancedComms(MPI_COMM_WORLD);
+    if (!unbalanced.empty()) {
+      for (const auto &comm : unbalanced) {
+        std::cerr << std::format("[  PROCESS {}  ] [  FAILED  ] {}", rank, Describe(comm)) << '\n';
+      }
+      MPI_Abort(MPI_COMM_WORLD, EXIT_FAILURE);
+    }
+    return;
+  }
+
   MPI_Barrier(MPI_COMM_WORLD);
 
   int flag = -1;
@@ -140,12 +153,15 @@ int RunAllTestsSafely() {
 }  // namespace
 
 int Init(int argc, char **argv) {
-  const int init_res = MPI_Init(&argc, &argv);
+  int provided = MPI_THREAD_SINGLE;
+  const int init_res = MPI_Init_thread(&argc, &argv, ppc::hybrid::kRequestedThreadLevel, &provided);
   if (init_res != MPI_SUCCESS) {
-    std::cerr << std::format("[  ERROR  ] MPI_Init failed with code {}", init_res) << '\n';
+    std::cerr << std::format("[  ERROR  ] MPI_Init_thread failed with code {}", init_res) << '\n';
     MPI_Abort(MPI_COMM_WORLD, init_res);
     return init_res;
   }
+  // A lower level is not fatal: hybrid kernels then keep all MPI calls on the main thread.
+  (void)provided;
 
   // Limit the number of threads in TBB
   tbb::global_control control(tbb::global_control::max_allowed_parallelism, ppc::util::GetNumThreads());
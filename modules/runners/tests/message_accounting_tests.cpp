@@ -0,0 +1,87 @@
+#include <gtest/gtest.h>
+#include <mpi.h>
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include "runners/include/message_accounting.hpp"
+
+using ppc::runners::CommTraffic;
+using ppc::runners::FindUnbalancedComms;
+using ppc::runners::MessageTraffic;
+
+namespace {
+
+bool AccountingReady() {
+  int initialized = 0;
+  MPI_Initialized(&initialized);
+  return initialized != 0 && ppc::runners::MessageAccountingEnabled();
+}
+
+const CommTraffic *FindTraffic(const std::vector<CommTraffic> &traffic, const std::string &name) {
+  const auto it = std::ranges::find_if(traffic, [&](const CommTraffic &t) { return t.name == name && !t.freed; });
+  return it == traffic.end() ? nullptr : &*it;
+}
+
+}  // namespace
+
+TEST(MessageAccountingMPI, CountsTrafficPerCommunicator) {
+  if (!AccountingReady()) {
+    GTEST_SKIP() << "MPI is not initialized or message accounting is disabled";
+  }
+  int rank = 0;
+  MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+  MPI_Comm comm = MPI_COMM_NULL;
+  MPI_Comm_split(MPI_COMM_WORLD, rank % 2, rank, &comm);
+  MPI_Comm_set_name(comm, "accounting_split");
+  int sub_rank = 0;
+  int sub_size = 1;
+  MPI_Comm_rank(comm, &sub_rank);
+  MPI_Comm_size(comm, &sub_size);
+
+  int token = rank;
+  MPI_Sendrecv_replace(&token, 1, MPI_INT, (sub_rank + 1) % sub_size, 0, (sub_rank - 1 + sub_size) % sub_size, 0, comm,
+                       MPI_STATUS_IGNORE);
+
+  const auto traffic = MessageTraffic();
+  const auto *entry = FindTraffic(traffic, "accounting_split");
+  ASSERT_NE(entry, nullptr);
+  EXPECT_EQ(entry->sent, 1);
+  EXPECT_EQ(entry->received, 1);
+  EXPECT_EQ(static_cast<int>(entry->world_ranks.size()), sub_size);
+  EXPECT_TRUE(std::ranges::all_of(entry->world_ranks, [&](int r) { return r % 2 == rank % 2; }));
+  EXPECT_TRUE(FindUnbalancedComms().empty());
+  MPI_Comm_free(&comm);
+}
+
+TEST(MessageAccountingMPI, ReportsLeakedCommunicator) {
+  if (!AccountingReady()) {
+    GTEST_SKIP() << "MPI is not initialized or message accounting is disabled";
+  }
+  int rank = 0;
+  MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+  MPI_Comm comm = MPI_COMM_NULL;
+  MPI_Comm_split(MPI_COMM_WORLD, 0, rank, &comm);
+  MPI_Comm_set_name(comm, "accounting_leak");
+
+  int sub_rank = 0;
+  MPI_Comm_rank(comm, &sub_rank);
+  int payload = 42;
+  MPI_Request request = MPI_REQUEST_NULL;
+  MPI_Isend(&payload, 1, MPI_INT, sub_rank, 0, comm, &request);
+
+  const auto unbalanced = FindUnbalancedComms();
+  const auto leak = std::ranges::find_if(unbalanced, [](const auto &u) { return u.traffic.name == "accounting_leak"; });
+  ASSERT_NE(leak, unbalanced.end());
+  EXPECT_GT(leak->imbalance, 0);
+  EXPECT_NE(ppc::runners::Describe(*leak).find("accounting_leak"), std::string::npos);
+
+  // Drain the message so the suite stays clean for the next test.
+  int received = 0;
+  MPI_Recv(&received, 1, MPI_INT, sub_rank, 0, comm, MPI_STATUS_IGNORE);
+  MPI_Wait(&request, MPI_STATUS_IGNORE);
+  EXPECT_EQ(received, payload);
+  EXPECT_TRUE(FindUnbalancedComms().empty());
+  MPI_Comm_free(&comm);
+}
@@ -0,0 +1,35 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+
+namespace ppc::task {
+enum class TypeOfTask : uint8_t;
+}  // namespace ppc::task
+
+namespace ppc::shared_memory {
+
+/// @brief Thread back-end of a shared-memory loop.
+enum class Backend : uint8_t { kSeq, kOmp, kTbb, kStl };
+
+/// @brief Returns the lower-case name of the back-end ("seq", "omp", "tbb", "stl").
+std::string BackendToString(Backend backend);
+
+/// @brief Thread back-end that runs a task of type @p type (kSeq for kMPI, whose ranks run sequentially).
+Backend BackendOf(ppc::task::TypeOfTask type);
+
+/// @brief Number of workers ParallelFor() uses: 1 for kSeq, ppc::util::GetNumThreads() otherwise.
+int BackendWorkers(Backend backend);
+
+/// @brief Calls @p body(i) for every i in [0, @p count) on the @p backend.
+/// @details Iterations are independent blocks of work chosen by the caller; kOmp and kStl hand
+/// them out statically, kTbb lets the scheduler balance them.
+void ParallelFor(std::size_t count, Backend backend, const std::function<void(std::size_t)> &body);
+
+/// @brief Calls @p body(begin, end) on one contiguous BlockRange() of [0, @p count) per worker of
+/// the @p backend.
+void ParallelForBlocks(std::size_t count, Backend backend, const std::function<void(std::size_t, std::size_t)> &body);
+
+}  // namespace ppc::shared_memory
@@ -0,0 +1,274 @@
+#pragma once
+
+#include <mpi.h>
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+namespace ppc::shared_memory {
+
+/// @brief Node-level decomposition of a communicator.
+/// @details Splits the parent communicator into per-node communicators with
+/// MPI_Comm_split_type(MPI_COMM_TYPE_SHARED) and builds a second communicator that
+/// contains only one leader (node rank 0) per node. Inter-node traffic goes through
+/// the leader communicator, everything else stays inside the node.
+class NodeTopology {
+ public:
+  /// @brief Builds node and leader communicators (collective over @p comm).
+  /// @param comm Parent communicator.
+  explicit NodeTopology(MPI_Comm comm = MPI_COMM_WORLD);
+  ~NodeTopology();
+
+  NodeTopology(const NodeTopology &) = delete;
+  NodeTopology &operator=(const NodeTopology &) = delete;
+  NodeTopology(NodeTopology &&other) noexcept;
+  NodeTopology &operator=(NodeTopology &&other) noexcept;
+
+  /// @brief Parent communicator the topology was built from.
+  [[nodiscard]] MPI_Comm Parent() const {
+    return parent_;
+  }
+  /// @brief Communicator of the ranks sharing memory with this rank.
+  [[nodiscard]] MPI_Comm Node() const {
+    return node_;
+  }
+  /// @brief Communicator of node leaders; MPI_COMM_NULL on non-leaders.
+  [[nodiscard]] MPI_Comm Leaders() const {
+    return leaders_;
+  }
+  [[nodiscard]] int Rank() const {
+    return rank_;
+  }
+  [[nodiscard]] int Size() const {
+    return size_;
+  }
+  [[nodiscard]] int NodeRank() const {
+    return node_rank_;
+  }
+  [[nodiscard]] int NodeSize() const {
+    return node_size_;
+  }
+  /// @brief Index of this rank's node (rank of its leader in the leader communicator).
+  [[nodiscard]] int NodeId() const {
+    return node_id_;
+  }
+  /// @brief Total number of nodes.
+  [[nodiscard]] int NodeCount() const {
+    return node_count_;
+  }
+  [[nodiscard]] bool IsLeader() const {
+    return node_rank_ == 0;
+  }
+  /// @brief True when every rank of the parent communicator lives on one node.
+  [[nodiscard]] bool IsSingleNode() const {
+    return node_count_ == 1;
+  }
+
+ private:
+  void Release() noexcept;
+
+  MPI_Comm parent_ = MPI_COMM_NULL;
+  MPI_Comm node_ = MPI_COMM_NULL;
+  MPI_Comm leaders_ = MPI_COMM_NULL;
+  int rank_ = 0;
+  int size_ = 1;
+  int node_rank_ = 0;
+  int node_size_ = 1;
+  int node_id_ = 0;
+  int node_count_ = 1;
+};
+
+/// @brief Returns the half-open range [begin, end) of block @p index when @p count
+/// elements are split into @p parts nearly equal contiguous blocks.
+std::pair<std::size_t, std::size_t> BlockRange(std::size_t count, int parts, int index);
+
+/// @brief RAII owner of an MPI_Win_allocate_shared segment holding @p T elements.
+/// @details The whole segment is allocated by the node leader; other ranks of the node
+/// map it through MPI_Win_shared_query, so every rank sees the same memory. The window
+/// stays in a passive-target epoch (MPI_Win_lock_all) for its whole lifetime and
+/// Sync() is the only synchronisation point needed between writers and readers.
+template <typename T>
+class SharedWindow {
+ public:
+  SharedWindow() = default;
+
+  /// @brief Allocates @p count elements shared by all ranks of @p node_comm (collective).
+  /// @param node_comm Communicator whose ranks share memory (see NodeTopology::Node()).
+  /// @param count Number of elements; only the value on node rank 0 is used.
+  /// @throws std::runtime_error If the window cannot be allocated.
+  SharedWindow(MPI_Comm node_comm, std::size_t count) : comm_(node_comm) {
+    int node_rank = 0;
+    MPI_Comm_rank(node_comm, &node_rank);
+    auto elements = static_cast<std::uint64_t>(count);
+    MPI_Bcast(&elements, 1, MPI_UINT64_T, 0, node_comm);
+    count_ = static_cast<std::size_t>(elements);
+
+    const auto local_bytes = static_cast<MPI_Aint>(node_rank == 0 ? count_ * sizeof(T) : 0);
+    void *local_base = nullptr;
+    MPI_Info info = MPI_INFO_NULL;
+    MPI_Info_create(&info);
+    // One contiguous segment is all we need; let the implementation skip per-rank padding.
+    MPI_Info_set(info, "alloc_shared_noncontig", "false");
+    const int res =
+        MPI_Win_allocate_shared(local_bytes, static_cast<int>(sizeof(T)), info, node_comm, &local_base, &win_);
+    MPI_Info_free(&info);
+    if (res != MPI_SUCCESS) {
+      throw std::runtime_error("MPI_Win_allocate_shared failed with code " + std::to_string(res));
+    }
+
+    MPI_Aint segment_bytes = 0;
+    int disp_unit = 0;
+    void *base = nullptr;
+    MPI_Win_shared_query(win_, 0, &segment_bytes, &disp_unit, &base);
+    data_ = static_cast<T *>(base);
+    MPI_Win_lock_all(MPI_MODE_NOCHECK, win_);
+  }
+
+  ~SharedWindow() {
+    Release();
+  }
+
+  SharedWindow(const SharedWindow &) = delete;
+  SharedWindow &operator=(const SharedWindow &) = delete;
+
+  SharedWindow(SharedWindow &&other) noexcept
+      : comm_(std::exchange(other.comm_, MPI_COMM_NULL)),
+        win_(std::exchange(other.win_, MPI_WIN_NULL)),
+        data_(std::exchange(other.data_, nullptr)),
+        count_(std::exchange(other.count_, 0)) {}
+
+  SharedWindow &operator=(SharedWindow &&other) noexcept {
+    if (this != &other) {
+      Release();
+      comm_ = std::exchange(other.comm_, MPI_COMM_NULL);
+      win_ = std::exchange(other.win_, MPI_WIN_NULL);
+      data_ = std::exchange(other.data_, nullptr);
+      count_ = std::exchange(other.count_, 0);
+    }
+    return *this;
+  }
+
+  /// @brief Makes stores of every node rank visible to every other node rank (collective).
+  void Sync() const {
+    MPI_Win_sync(win_);
+    MPI_Barrier(comm_);
+    MPI_Win_sync(win_);
+  }
+
+  [[nodiscard]] T *Data() {
+    return data_;
+  }
+  [[nodiscard]] const T *Data() const {
+    return data_;
+  }
+  [[nodiscard]] std::size_t Size() const {
+    return count_;
+  }
+  [[nodiscard]] std::span<T> Span() {
+    return {data_, count_};
+  }
+  [[nodiscard]] std::span<const T> Span() const {
+    return {data_, count_};
+  }
+
+ private:
+  void Release() noexcept {
+    int finalized = 0;
+    MPI_Finalized(&finalized);
+    if (win_ != MPI_WIN_NULL && finalized == 0) {
+      MPI_Win_unlock_all(win_);
+      MPI_Win_free(&win_);
+    }
+    win_ = MPI_WIN_NULL;
+    data_ = nullptr;
+    count_ = 0;
+  }
+
+  MPI_Comm comm_ = MPI_COMM_NULL;
+  MPI_Win win_ = MPI_WIN_NULL;
+  T *data_ = nullptr;
+  std::size_t count_ = 0;
+};
+
+/// @brief Read-mostly array replicated once per node instead of once per rank.
+/// @details The root copies its buffer into its node's shared segment; node leaders then
+/// broadcast node-to-node over the leader communicator straight into their own segments.
+/// Ranks that share a node never exchange messages: they read the segment in place.
+/// @tparam T Trivially copyable element type.
+template <typename T>
+class SharedArray {
+ public:
+  /// @brief Distributes @p data from @p root to every node (collective over topology.Parent()).
+  /// @param topology Node decomposition of the communicator.
+  /// @param data Buffer to share; only read on @p root.
+  /// @param root Rank of the data owner in the parent communicator.
+  static SharedArray FromRoot(const NodeTopology &topology, std::span<const T> data, int root) {
+    // Root announces the element count and the node it lives on.
+    std::array<std::uint64_t, 2> header = {static_cast<std::uint64_t>(data.size()),
+                                           static_cast<std::uint64_t>(topology.NodeId())};
+    MPI_Bcast(header.data(), static_cast<int>(header.size()), MPI_UINT64_T, root, topology.Parent());
+    const auto count = static_cast<std::size_t>(header[0]);
+    const auto root_node = static_cast<int>(header[1]);
+
+    SharedArray result;
+    result.window_ = SharedWindow<T>(topology.Node(), count);
+    if (topology.Rank() == root && count > 0) {
+      std::memcpy(result.window_.Data(), data.data(), count * sizeof(T));
+    }
+    result.window_.Sync();
+
+    if (topology.IsLeader() && !topology.IsSingleNode()) {
+      BcastBytes(result.window_.Data(), count * sizeof(T), root_node, topology.Leaders());
+    }
+    result.window_.Sync();
+    return result;
+  }
+
+  /// @brief The whole array as seen by this rank (no copy).
+  [[nodiscard]] std::span<const T> View() const {
+    return window_.Span();
+  }
+
+  /// @brief Contiguous block @p index out of @p parts (no copy).
+  [[nodiscard]] std::span<const T> Block(int index, int parts) const {
+    const auto [begin, end] = BlockRange(window_.Size(), parts, index);
+    return View().subspan(begin, end - begin);
+  }
+
+  /// @brief Mutable access for ranks that cooperatively update the node copy.
+  /// @note Call Sync() before other node ranks read updated elements.
+  [[nodiscard]] std::span<T> MutableView() {
+    return window_.Span();
+  }
+
+  /// @brief Synchronises node-local readers and writers (collective over the node).
+  void Sync() const {
+    window_.Sync();
+  }
+
+  [[nodiscard]] std::size_t Size() const {
+    return window_.Size();
+  }
+
+ private:
+  static void BcastBytes(T *ptr, std::size_t bytes, int root, MPI_Comm comm) {
+    // MPI counts are int: ship large payloads in chunks below INT_MAX.
+    constexpr std::size_t kChunk = std::size_t{1} << 30U;
+    auto *bytes_ptr = reinterpret_cast<unsigned char *>(ptr);
+    for (std::size_t offset = 0; offset < bytes; offset += kChunk) {
+      const auto len = std::min(kChunk, bytes - offset);
+      MPI_Bcast(bytes_ptr + offset, static_cast<int>(len), MPI_BYTE, root, comm);
+    }
+  }
+
+  SharedWindow<T> window_;
+};
+
+}  // namespace ppc::shared_memory
@@ -0,0 +1,111 @@
+#include "shared_memory/include/parallel_for.hpp"
+
+#include <omp.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "oneapi/tbb/blocked_range.h"
+#include "oneapi/tbb/parallel_for.h"
+#include "shared_memory/include/shared_memory.hpp"
+#include "task/include/task.hpp"
+#include "util/include/util.hpp"
+
+namespace ppc::shared_memory {
+
+std::string BackendToString(Backend backend) {
+  switch (backend) {
+    case Backend::kSeq:
+      return "seq";
+    case Backend::kOmp:
+      return "omp";
+    case Backend::kTbb:
+      return "tbb";
+    case Backend::kStl:
+      return "stl";
+  }
+  return "unknown";
+}
+
+Backend BackendOf(ppc::task::TypeOfTask type) {
+  switch (type) {
+    case ppc::task::TypeOfTask::kOMP:
+      return Backend::kOmp;
+    case ppc::task::TypeOfTask::kTBB:
+      return Backend::kTbb;
+    case ppc::task::TypeOfTask::kSTL:
+      return Backend::kStl;
+    case ppc::task::TypeOfTask::kALL:
+    case ppc::task::TypeOfTask::kMPI:
+    case ppc::task::TypeOfTask::kSEQ:
+    case ppc::task::TypeOfTask::kUnknown:
+      return Backend::kSeq;
+  }
+  return Backend::kSeq;
+}
+
+int BackendWorkers(Backend backend) {
+  return backend == Backend::kSeq ? 1 : std::max(ppc::util::GetNumThreads(), 1);
+}
+
+void ParallelFor(std::size_t count, Backend backend, const std::function<void(std::size_t)> &body) {
+  const int workers = BackendWorkers(backend);
+  switch (backend) {
+    case Backend::kSeq:
+      for (std::size_t i = 0; i < count; i++) {
+        body(i);
+      }
+      return;
+    case Backend::kOmp: {
+      const auto iterations = static_cast<std::int64_t>(count);
+#pragma omp parallel for default(none) shared(body, iterations) schedule(static) num_threads(workers)
+      for (std::int64_t i = 0; i < iterations; i++) {
+        body(static_cast<std::size_t>(i));
+      }
+      return;
+    }
+    case Backend::kTbb:
+      tbb::parallel_for(tbb::blocked_range<std::size_t>(0, count, 1), [&](const tbb::blocked_range<std::size_t> &r) {
+        for (std::size_t i = r.begin(); i != r.end(); i++) {
+          body(i);
+        }
+      });
+      return;
+    case Backend::kStl: {
+      const std::size_t threads = std::min(static_cast<std::size_t>(workers), count);
+      if (threads == 0) {
+        return;
+      }
+      const auto run = [&](std::size_t first) {
+        for (std::size_t i = first; i < count; i += threads) {
+          body(i);
+        }
+      };
+      std::vector<std::thread> pool;
+      pool.reserve(threads - 1);
+      for (std::size_t t = 1; t < threads; t++) {
+        pool.emplace_back(run, t);
+      }
+      run(0);
+      for (auto &thread : pool) {
+        thread.join();
+      }
+      return;
+    }
+  }
+}
+
+void ParallelForBlocks(std::size_t count, Backend backend, const std::function<void(std::size_t, std::size_t)> &body) {
+  const int blocks = BackendWorkers(backend);
+  ParallelFor(static_cast<std::size_t>(blocks), backend, [&](std::size_t block) {
+    const auto [begin, end] = BlockRange(count, blocks, static_cast<int>(block));
+    body(begin, end);
+  });
+}
+
+}  // namespace ppc::shared_memory
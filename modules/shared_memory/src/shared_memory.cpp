@@ -0,0 +1,88 @@
+#include "shared_memory/include/shared_memory.hpp"
+
+#include <mpi.h>
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <utility>
+
+namespace ppc::shared_memory {
+
+NodeTopology::NodeTopology(MPI_Comm comm) : parent_(comm) {
+  MPI_Comm_rank(comm, &rank_);
+  MPI_Comm_size(comm, &size_);
+
+  MPI_Comm_split_type(comm, MPI_COMM_TYPE_SHARED, rank_, MPI_INFO_NULL, &node_);
+  MPI_Comm_rank(node_, &node_rank_);
+  MPI_Comm_size(node_, &node_size_);
+
+  MPI_Comm_split(comm, IsLeader() ? 0 : MPI_UNDEFINED, rank_, &leaders_);
+  if (leaders_ != MPI_COMM_NULL) {
+    MPI_Comm_rank(leaders_, &node_id_);
+    MPI_Comm_size(leaders_, &node_count_);
+  }
+  std::array<int, 2> node_info = {node_id_, node_count_};
+  MPI_Bcast(node_info.data(), static_cast<int>(node_info.size()), MPI_INT, 0, node_);
+  node_id_ = node_info[0];
+  node_count_ = node_info[1];
+}
+
+NodeTopology::~NodeTopology() {
+  Release();
+}
+
+NodeTopology::NodeTopology(NodeTopology &&other) noexcept
+    : parent_(std::exchange(other.parent_, MPI_COMM_NULL)),
+      node_(std::exchange(other.node_, MPI_COMM_NULL)),
+      leaders_(std::exchange(other.leaders_, MPI_COMM_NULL)),
+      rank_(other.rank_),
+      size_(other.size_),
+      node_rank_(other.node_rank_),
+      node_size_(other.node_size_),
+      node_id_(other.node_id_),
+      node_count_(other.node_count_) {}
+
+NodeTopology &NodeTopology::operator=(NodeTopology &&other) noexcept {
+  if (this != &other) {
+    Release();
+    parent_ = std::exchange(other.parent_, MPI_COMM_NULL);
+    node_ = std::exchange(other.node_, MPI_COMM_NULL);
+    leaders_ = std::exchange(other.leaders_, MPI_COMM_NULL);
+    rank_ = other.rank_;
+    size_ = other.size_;
+    node_rank_ = other.node_rank_;
+    node_size_ = other.node_size_;
+    node_id_ = other.node_id_;
+    node_count_ = other.node_count_;
+  }
+  return *this;
+}
+
+void NodeTopology::Release() noexcept {
+  int finalized = 0;
+  MPI_Finalized(&finalized);
+  if (finalized != 0) {
+    return;
+  }
+  if (leaders_ != MPI_COMM_NULL) {
+    MPI_Comm_free(&leaders_);
+  }
+  if (node_ != MPI_COMM_NULL) {
+    MPI_Comm_free(&node_);
+  }
+}
+
+std::pair<std::size_t, std::size_t> BlockRange(std::size_t count, int parts, int index) {
+  if (parts <= 0 || index < 0 || index >= parts) {
+    return {0, 0};
+  }
+  const auto p = static_cast<std::size_t>(parts);
+  const auto i = static_cast<std::size_t>(index);
+  const std::size_t base = count / p;
+  const std::size_t extra = count % p;
+  const std::size_t begin = (i * base) + std::min(i, extra);
+  return {begin, begin + base + (i < extra ? 1 : 0)};
+}
+
+}  // namespace ppc::shared_memory
@@ -0,0 +1,87 @@
+#include <gtest/gtest.h>
+#include <mpi.h>
+
+#include <cstddef>
+#include <numeric>
+#include <span>
+#include <vector>
+
+#include "shared_memory/include/shared_memory.hpp"
+#include "util/include/func_test_util.hpp"
+
+using ppc::shared_memory::BlockRange;
+using ppc::shared_memory::NodeTopology;
+using ppc::shared_memory::SharedArray;
+
+TEST(SharedMemoryBlockRange, CoversWholeRangeWithoutGaps) {
+  constexpr std::size_t kCount = 103;
+  constexpr int kParts = 7;
+  std::size_t expected_begin = 0;
+  for (int i = 0; i < kParts; i++) {
+    const auto [begin, end] = BlockRange(kCount, kParts, i);
+    EXPECT_EQ(begin, expected_begin);
+    EXPECT_GE(end, begin);
+    EXPECT_LE(end - begin, (kCount / kParts) + 1);
+    expected_begin = end;
+  }
+  EXPECT_EQ(expected_begin, kCount);
+}
+
+TEST(SharedMemoryBlockRange, MorePartsThanElements) {
+  EXPECT_EQ(BlockRange(2, 4, 0), std::make_pair(std::size_t{0}, std::size_t{1}));
+  EXPECT_EQ(BlockRange(2, 4, 1), std::make_pair(std::size_t{1}, std::size_t{2}));
+  EXPECT_EQ(BlockRange(2, 4, 3), std::make_pair(std::size_t{2}, std::size_t{2}));
+}
+
+TEST(SharedMemoryBlockRange, InvalidIndexIsEmpty) {
+  EXPECT_EQ(BlockRange(10, 0, 0), std::make_pair(std::size_t{0}, std::size_t{0}));
+  EXPECT_EQ(BlockRange(10, 2, 2), std::make_pair(std::size_t{0}, std::size_t{0}));
+}
+
+TEST(SharedMemoryMPI, NodeTopologyIsConsistent) {
+  if (!ppc::util::MpiReady()) {
+    GTEST_SKIP() << "MPI is not initialized";
+  }
+  NodeTopology topology(MPI_COMM_WORLD);
+  EXPECT_GE(topology.NodeCount(), 1);
+  EXPECT_LT(topology.NodeId(), topology.NodeCount());
+  EXPECT_LE(topology.NodeSize(), topology.Size());
+  EXPECT_EQ(topology.IsLeader(), topology.Leaders() != MPI_COMM_NULL);
+}
+
+TEST(SharedMemoryMPI, ArrayFromRootIsVisibleOnEveryRank) {
+  if (!ppc::util::MpiReady()) {
+    GTEST_SKIP() << "MPI is not initialized";
+  }
+  NodeTopology topology(MPI_COMM_WORLD);
+  const int root = topology.Size() - 1;
+  std::vector<double> data;
+  if (topology.Rank() == root) {
+    data.resize(1000);
+    std::iota(data.begin(), data.end(), 0.0);
+  }
+
+  auto shared = SharedArray<double>::FromRoot(topology, std::span<const double>(data), root);
+  ASSERT_EQ(shared.Size(), 1000U);
+  auto view = shared.View();
+  for (std::size_t i = 0; i < view.size(); i++) {
+    ASSERT_EQ(view[i], static_cast<double>(i));
+  }
+
+  auto block = shared.Block(topology.Rank(), topology.Size());
+  const auto [begin, end] = BlockRange(shared.Size(), topology.Size(), topology.Rank());
+  ASSERT_EQ(block.size(), end - begin);
+  if (!block.empty()) {
+    EXPECT_EQ(block.front(), static_cast<double>(begin));
+  }
+}
+
+TEST(SharedMemoryMPI, EmptyArrayIsAllowed) {
+  if (!ppc::util::MpiReady()) {
+    GTEST_SKIP() << "MPI is not initialized";
+  }
+  NodeTopology topology(MPI_COMM_WORLD);
+  auto shared = SharedArray<int>::FromRoot(topology, std::span<const int>(), 0);
+  EXPECT_EQ(shared.Size(), 0U);
+  EXPECT_TRUE(shared.View().empty());
+}
@@ -0,0 +1,676 @@
+#pragma once
+
+#include <mpi.h>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "collectives/include/collectives.hpp"
+#include "distribution/include/distribution.hpp"
+#include "shared_memory/include/parallel_for.hpp"
+
+namespace ppc::sorting {
+
+using Backend = ppc::shared_memory::Backend;
+
+/// @brief Sort of one block (a thread's share, or a rank's).
+enum class Algorithm : uint8_t { kQuick, kShell, kRadix };
+
+/// @brief How sorted blocks are combined: a tree of two-way merges, compare-split steps of
+/// Batcher's odd-even merge network, of the bitonic network or of odd-even transposition between
+/// neighbouring blocks, or a sample sort that routes every key to its final block by splitters and
+/// k-way merges the pieces there.
+enum class Merge : uint8_t { kSimple, kBatcher, kBitonic, kSample, kOddEven };
+
+/// @brief Returns the lower-case name of the algorithm ("quick", "shell", "radix").
+std::string AlgorithmToString(Algorithm algorithm);
+
+/// @brief Returns the lower-case name of the merge ("simple", "batcher", "bitonic", "sample",
+/// "odd_even").
+std::string MergeToString(Merge merge);
+
+template <typename Key>
+concept SortKey = std::same_as<Key, double> || std::same_as<Key, float> || std::same_as<Key, int> ||
+                  std::same_as<Key, unsigned> || std::same_as<Key, std::int64_t> || std::same_as<Key, std::uint64_t>;
+
+struct Options {
+  Algorithm algorithm = Algorithm::kQuick;
+  Merge merge = Merge::kBatcher;
+  /// Blocks sorted in parallel and then merged; 0 takes one per worker of the back-end.
+  std::size_t blocks = 0;
+  Backend backend = Backend::kSeq;
+};
+
+struct Tuning {
+  /// Quicksort leaves runs up to this length to insertion sort.
+  std::size_t insertion_cutoff = 24;
+  /// Keys a rank sends to one destination per exchange round of the distributed sample sort,
+  /// which bounds the bytes in flight.
+  std::size_t exchange_chunk = std::size_t{1} << 20;
+};
+
+Tuning &GetTuning();
+
+/// @brief What the merge of Sort() or SortDistributed() did.
+struct SortStats {
+  /// Merge rounds: network stages or transposition phases run, tree levels, or exchange rounds.
+  std::size_t rounds = 0;
+  /// Compare-splits that moved keys; the others found their pair already in order.
+  std::size_t exchanges = 0;
+  /// Bytes sent between ranks, summed over the ranks; 0 for Sort().
+  std::uint64_t bytes = 0;
+};
+
+/// @brief Blocks Sort() splits @p count keys into: Options::blocks or one per worker, at most @p count.
+std::size_t BlockCount(const Options &options, std::size_t count);
+
+/// @brief One comparator of a merge network: block @p first receives the smaller keys of the pair.
+using Comparator = std::pair<std::size_t, std::size_t>;
+
+/// @brief Comparator stages of Batcher's odd-even merge sort over @p count blocks.
+/// @details The comparators of a stage touch disjoint blocks, so a stage runs in parallel. Every
+/// comparator sends the smaller keys to the lower index, so the network for the next power of two
+/// truncated to @p count still sorts.
+std::vector<std::vector<Comparator>> BatcherStages(std::size_t count);
+
+/// @brief Comparator stages of the bitonic sort over @p count blocks, in the form whose comparators
+/// all send the smaller keys to the lower index (the first stage of every merge compares mirror
+/// images), so that it truncates to any @p count like BatcherStages().
+std::vector<std::vector<Comparator>> BitonicStages(std::size_t count);
+
+/// @brief Phases of odd-even transposition over @p count blocks: the even phases compare-split
+/// blocks (0, 1), (2, 3), ..., the odd ones (1, 2), (3, 4), ...; @p count phases sort any input.
+std::vector<std::vector<Comparator>> TranspositionStages(std::size_t count);
+
+/// @brief BatcherStages(), BitonicStages() or TranspositionStages() for @p merge.
+/// @throws std::invalid_argument For Merge::kSimple and Merge::kSample, which are not networks.
+std::vector<std::vector<Comparator>> MergeStages(Merge merge, std::size_t count);
+
+namespace detail {
+
+constexpr int kRadixBits = 8;
+constexpr std::size_t kRadixBuckets = std::size_t{1} << kRadixBits;
+
+template <SortKey Key>
+using Bits = std::conditional_t<sizeof(Key) == 4, std::uint32_t, std::uint64_t>;
+
+/// @brief Unsigned image of @p key whose order is the order of the keys: the sign bit is flipped
+/// for signed integers and non-negative floats, every bit for negative floats.
+template <SortKey Key>
+Bits<Key> OrderedBits(Key key) {
+  using U = Bits<Key>;
+  constexpr U kSign = U{1} << ((8 * sizeof(U)) - 1);
+  const auto bits = std::bit_cast<U>(key);
+  if constexpr (std::floating_point<Key>) {
+    return (bits & kSign) != 0 ? static_cast<U>(~bits) : static_cast<U>(bits | kSign);
+  } else if constexpr (std::signed_integral<Key>) {
+    return static_cast<U>(bits ^ kSign);
+  } else {
+    return bits;
+  }
+}
+
+/// @brief Key that sorts after every other: +infinity or the largest integer. Pads blocks.
+template <SortKey Key>
+constexpr Key Sentinel() {
+  if constexpr (std::numeric_limits<Key>::has_infinity) {
+    return std::numeric_limits<Key>::infinity();
+  } else {
+    return std::numeric_limits<Key>::max();
+  }
+}
+
+template <SortKey Key>
+void InsertionSort(std::span<Key> keys) {
+  for (std::size_t i = 1; i < keys.size(); i++) {
+    const Key key = keys[i];
+    std::size_t j = i;
+    for (; j > 0 && key < keys[j - 1]; j--) {
+      keys[j] = keys[j - 1];
+    }
+    keys[j] = key;
+  }
+}
+
+/// @brief Introsort with Bentley-McIlroy three-way partitioning around a median of three: the
+/// scans swap only misplaced keys (none on sorted runs), and keys equal to the pivot are parked at
+/// the ends and swapped into the middle, so runs of duplicates are settled in one pass. Recurses
+/// into the smaller side and falls back to heapsort when @p depth runs out.
+template <SortKey Key>
+void QuickSort(std::span<Key> keys, std::size_t cutoff, int depth) {
+  while (keys.size() > cutoff) {
+    if (depth-- == 0) {
+      std::ranges::make_heap(keys);
+      std::ranges::sort_heap(keys);
+      return;
+    }
+    std::array<Key, 3> samples = {keys.front(), keys[keys.size() / 2], keys.back()};
+    std::ranges::sort(samples);
+    const Key pivot = samples[1];
+    const auto n = static_cast<std::ptrdiff_t>(keys.size());
+    const auto at = [&](std::ptrdiff_t i) -> Key & { return keys[static_cast<std::size_t>(i)]; };
+    // [0, a) and (d, n) hold keys equal to the pivot, [a, b) smaller and (c, d] larger ones.
+    std::ptrdiff_t a = 0;
+    std::ptrdiff_t b = 0;
+    std::ptrdiff_t c = n - 1;
+    std::ptrdiff_t d = n - 1;
+    while (true) {
+      for (; b <= c && !(pivot < at(b)); b++) {
+        if (!(at(b) < pivot)) {
+          std::swap(at(a++), at(b));
+        }
+      }
+      for (; c >= b && !(at(c) < pivot); c--) {
+        if (!(pivot < at(c))) {
+          std::swap(at(c), at(d--));
+        }
+      }
+      if (b > c) {
+        break;
+      }
+      std::swap(at(b++), at(c--));
+    }
+    const std::ptrdiff_t head = std::min(a, b - a);
+    std::swap_ranges(keys.begin(), keys.begin() + head, keys.begin() + (b - head));
+    const std::ptrdiff_t tail = std::min(d - c, n - 1 - d);
+    std::swap_ranges(keys.begin() + b, keys.begin() + b + tail, keys.end() - tail);
+    const std::span<Key> left = keys.first(static_cast<std::size_t>(b - a));
+    const std::span<Key> right = keys.last(static_cast<std::size_t>(d - c));
+    if (left.size() < right.size()) {
+      QuickSort(left, cutoff, depth);
+      keys = right;
+    } else {
+      QuickSort(right, cutoff, depth);
+      keys = left;
+    }
+  }
+  InsertionSort(keys);
+}
+
+/// @brief Shell sort on Ciura's gaps, extended by a factor 2.25 for long inputs.
+template <SortKey Key>
+void ShellSort(std::span<Key> keys) {
+  std::vector<std::size_t> gaps = {1, 4, 10, 23, 57, 132, 301, 701, 1750};
+  while (gaps.back() < keys.size() / 2) {
+    gaps.push_back((gaps.back() * 9) / 4);
+  }
+  for (auto gap = gaps.rbegin(); gap != gaps.rend(); ++gap) {
+    const std::size_t h = *gap;
+    for (std::size_t i = h; i < keys.size(); i++) {
+      const Key key = keys[i];
+      std::size_t j = i;
+      for (; j >= h && key < keys[j - h]; j -= h) {
+        keys[j] = keys[j - h];
+      }
+      keys[j] = key;
+    }
+  }
+}
+
+/// @brief LSD radix sort on the OrderedBits() of the keys, kRadixBits per pass, ping-ponging with
+/// @p scratch (same size as @p keys).
+/// @details One read pass builds the histograms of every digit; passes whose digit is the same for
+/// all keys (sorted prefixes, narrow ranges, duplicates) are skipped.
+template <SortKey Key>
+void RadixSort(std::span<Key> keys, std::span<Key> scratch) {
+  constexpr int kPasses = static_cast<int>(8 * sizeof(Key)) / kRadixBits;
+  std::vector<std::array<std::size_t, kRadixBuckets>> counts(kPasses);
+  for (const Key key : keys) {
+    const auto bits = OrderedBits(key);
+    for (int pass = 0; pass < kPasses; pass++) {
+      counts[pass][(bits >> (pass * kRadixBits)) & (kRadixBuckets - 1)]++;
+    }
+  }
+  std::span<Key> from = keys;
+  std::span<Key> to = scratch;
+  for (int pass = 0; pass < kPasses; pass++) {
+    auto &count = counts[pass];
+    if (std::ranges::find(count, keys.size()) != count.end()) {
+      continue;
+    }
+    std::size_t offset = 0;
+    for (std::size_t &bucket : count) {
+      offset += std::exchange(bucket, offset);
+    }
+    for (const Key key : from) {
+      to[count[(OrderedBits(key) >> (pass * kRadixBits)) & (kRadixBuckets - 1)]++] = key;
+    }
+    std::swap(from, to);
+  }
+  if (from.data() != keys.data()) {
+    std::ranges::copy(from, keys.begin());
+  }
+}
+
+/// @brief Sorts @p keys by @p algorithm; radix sort uses @p scratch of the same size.
+template <SortKey Key>
+void SortBlock(std::span<Key> keys, std::span<Key> scratch, Algorithm algorithm) {
+  switch (algorithm) {
+    case Algorithm::kQuick:
+      QuickSort(keys, GetTuning().insertion_cutoff, 2 * std::bit_width(keys.size()));
+      return;
+    case Algorithm::kShell:
+      ShellSort(keys);
+      return;
+    case Algorithm::kRadix:
+      RadixSort(keys, scratch);
+      return;
+  }
+}
+
+/// @brief Merge of sorted double runs by a bitonic network over AVX2 registers of four keys: the
+/// out.size() smallest keys in ascending order, or the largest when @p back.
+/// @return false, leaving @p out alone, when ActiveIsa() is below AVX2 or a run is shorter than a
+/// register; the caller then merges by scalar code.
+bool MergeDoublesSimd(std::span<const double> low, std::span<const double> high, std::span<double> out, bool back);
+
+/// @brief Writes the out.size() smallest keys of the sorted runs @p low and @p high to @p out.
+template <SortKey Key>
+void MergeFront(std::span<const Key> low, std::span<const Key> high, std::span<Key> out) {
+  if constexpr (std::same_as<Key, double>) {
+    if (MergeDoublesSimd(low, high, out, false)) {
+      return;
+    }
+  }
+  std::size_t a = 0;
+  std::size_t b = 0;
+  for (Key &key : out) {
+    key = (a == low.size() || (b < high.size() && high[b] < low[a])) ? high[b++] : low[a++];
+  }
+}
+
+/// @brief Writes the out.size() largest keys of the sorted runs @p low and @p high to @p out.
+template <SortKey Key>
+void MergeBack(std::span<const Key> low, std::span<const Key> high, std::span<Key> out) {
+  if constexpr (std::same_as<Key, double>) {
+    if (MergeDoublesSimd(low, high, out, true)) {
+      return;
+    }
+  }
+  std::size_t a = low.size();
+  std::size_t b = high.size();
+  for (std::size_t k = out.size(); k-- > 0;) {
+    out[k] = (b == 0 || (a > 0 && high[b - 1] < low[a - 1])) ? low[--a] : high[--b];
+  }
+}
+
+/// @brief Compare-split of two sorted blocks: @p low keeps the smaller keys and @p high the larger,
+/// both sorted, through scratch blocks of the same sizes. Ordered pairs are left alone.
+/// @return Whether keys moved.
+template <SortKey Key>
+bool MergeSplit(std::span<Key> low, std::span<Key> high, std::span<Key> low_scratch, std::span<Key> high_scratch) {
+  if (low.empty() || high.empty() || !(high.front() < low.back())) {
+    return false;
+  }
+  MergeFront<Key>(low, high, low_scratch);
+  MergeBack<Key>(low, high, high_scratch);
+  std::ranges::copy(low_scratch, low.begin());
+  std::ranges::copy(high_scratch, high.begin());
+  return true;
+}
+
+/// @brief Merges @p runs sorted runs of @p run keys each (the last may be shorter) in a tree of
+/// two-way merges, the merges of a level in parallel.
+template <SortKey Key>
+void MergeRuns(std::vector<Key> &keys, std::size_t run, std::size_t runs, Backend backend) {
+  std::vector<Key> merged(keys.size());
+  for (std::size_t width = 1; width < runs; width *= 2) {
+    const std::size_t length = width * run;
+    const std::size_t pairs = (runs + (2 * width) - 1) / (2 * width);
+    ppc::shared_memory::ParallelFor(pairs, backend, [&](std::size_t p) {
+      const std::size_t begin = std::min(2 * p * length, keys.size());
+      const std::size_t middle = std::min(begin + length, keys.size());
+      const std::size_t end = std::min(middle + length, keys.size());
+      std::merge(keys.begin() + static_cast<std::ptrdiff_t>(begin), keys.begin() + static_cast<std::ptrdiff_t>(middle),
+                 keys.begin() + static_cast<std::ptrdiff_t>(middle), keys.begin() + static_cast<std::ptrdiff_t>(end),
+                 merged.begin() + static_cast<std::ptrdiff_t>(begin));
+    });
+    keys.swap(merged);
+  }
+}
+
+/// @brief Appends @p count regular samples of the sorted @p run (at i * size / count) to @p samples.
+template <SortKey Key>
+void RegularSamples(std::span<const Key> run, std::size_t count, std::vector<Key> &samples) {
+  for (std::size_t i = 0; i < count && !run.empty(); i++) {
+    samples.push_back(run[(i * run.size()) / count]);
+  }
+}
+
+/// @brief Sorts @p samples and returns @p buckets - 1 splitters evenly spaced among them.
+template <SortKey Key>
+std::vector<Key> PickSplitters(std::vector<Key> samples, std::size_t buckets) {
+  std::ranges::sort(samples);
+  std::vector<Key> splitters;
+  for (std::size_t i = 1; i < buckets && !samples.empty(); i++) {
+    splitters.push_back(samples[(i * samples.size()) / buckets]);
+  }
+  return splitters;
+}
+
+/// @brief Bucket boundaries of the sorted @p run: bucket i takes the keys in (splitter[i-1],
+/// splitter[i]]. The keys equal to a splitter that repeats are dealt evenly to its buckets, so
+/// that heavy duplicates do not all land in one bucket.
+template <SortKey Key>
+std::vector<std::size_t> SplitPoints(std::span<const Key> run, std::span<const Key> splitters) {
+  std::vector<std::size_t> bounds(splitters.size() + 2, 0);
+  bounds[splitters.size() + 1] = run.size();
+  for (std::size_t i = 0; i < splitters.size();) {
+    std::size_t j = i;
+    while (j + 1 < splitters.size() && !(splitters[i] < splitters[j + 1])) {
+      j++;
+    }
+    const auto lower = static_cast<std::size_t>(std::ranges::lower_bound(run, splitters[i]) - run.begin());
+    const auto upper = static_cast<std::size_t>(std::ranges::upper_bound(run, splitters[i]) - run.begin());
+    const std::size_t shares = j - i + 1;
+    for (std::size_t t = 0; t < shares; t++) {
+      bounds[i + t + 1] = lower + (((upper - lower) * (t + 1)) / shares);
+    }
+    i = j + 1;
+  }
+  return bounds;
+}
+
+/// @brief Merges the sorted @p runs into @p out (of their total size) through a binary heap of
+/// run heads.
+template <SortKey Key>
+void KWayMerge(std::span<const std::span<const Key>> runs, std::span<Key> out) {
+  using Head = std::pair<Key, std::size_t>;
+  std::vector<Head> heap;
+  std::vector<std::size_t> next(runs.size(), 1);
+  for (std::size_t r = 0; r < runs.size(); r++) {
+    if (!runs[r].empty()) {
+      heap.emplace_back(runs[r].front(), r);
+    }
+  }
+  const auto later = [](const Head &a, const Head &b) { return b.first < a.first; };
+  std::ranges::make_heap(heap, later);
+  for (Key &key : out) {
+    std::ranges::pop_heap(heap, later);
+    const std::size_t r = heap.back().second;
+    key = heap.back().first;
+    if (next[r] < runs[r].size()) {
+      heap.back().first = runs[r][next[r]++];
+      std::ranges::push_heap(heap, later);
+    } else {
+      heap.pop_back();
+    }
+  }
+}
+
+/// @brief Sample sort of @p blocks sorted blocks of @p block keys: splitters from regular samples
+/// of every block cut each block into one piece per bucket, and each bucket k-way merges its
+/// pieces straight into its place in the output, the buckets in parallel.
+template <SortKey Key>
+void SampleMerge(std::vector<Key> &keys, std::size_t block, std::size_t blocks, Backend backend) {
+  const auto run = [&](std::size_t b) { return std::span<const Key>(keys).subspan(b * block, block); };
+  std::vector<Key> samples;
+  for (std::size_t b = 0; b < blocks; b++) {
+    RegularSamples(run(b), blocks, samples);
+  }
+  const std::vector<Key> splitters = PickSplitters(std::move(samples), blocks);
+  std::vector<std::vector<std::size_t>> bounds(blocks);
+  for (std::size_t b = 0; b < blocks; b++) {
+    bounds[b] = SplitPoints<Key>(run(b), splitters);
+  }
+  std::vector<std::size_t> offsets(blocks + 1, 0);
+  for (std::size_t k = 0; k < blocks; k++) {
+    offsets[k + 1] = offsets[k];
+    for (std::size_t b = 0; b < blocks; b++) {
+      offsets[k + 1] += bounds[b][k + 1] - bounds[b][k];
+    }
+  }
+  std::vector<Key> merged(keys.size());
+  ppc::shared_memory::ParallelFor(blocks, backend, [&](std::size_t k) {
+    std::vector<std::span<const Key>> pieces(blocks);
+    for (std::size_t b = 0; b < blocks; b++) {
+      pieces[b] = run(b).subspan(bounds[b][k], bounds[b][k + 1] - bounds[b][k]);
+    }
+    KWayMerge<Key>(pieces, std::span<Key>(merged).subspan(offsets[k], offsets[k + 1] - offsets[k]));
+  });
+  keys.swap(merged);
+}
+
+/// @brief Distributed sample sort of the sorted @p local keys: splitters from regular samples of
+/// every rank, a ppc::collectives::ChunkedAlltoallv() exchange of the buckets in rounds of at most
+/// Tuning::exchange_chunk keys per destination, and a k-way merge of the received runs.
+/// @return The exchange rounds, and the bytes of samples and keys this rank sent.
+template <SortKey Key>
+SortStats SampleSortRanks(std::vector<Key> &local, MPI_Comm comm) {
+  int rank = 0;
+  int size = 1;
+  MPI_Comm_rank(comm, &rank);
+  MPI_Comm_size(comm, &size);
+  const auto ranks = static_cast<std::size_t>(size);
+  const MPI_Datatype type = ppc::distribution::DatatypeOf<Key>();
+
+  std::vector<Key> samples;
+  RegularSamples<Key>(local, ranks, samples);
+  const int sample_count = static_cast<int>(samples.size());
+  std::vector<int> sample_counts(ranks);
+  MPI_Allgather(&sample_count, 1, MPI_INT, sample_counts.data(), 1, MPI_INT, comm);
+  std::vector<int> sample_displs(ranks, 0);
+  int total_samples = 0;
+  for (std::size_t r = 0; r < ranks; r++) {
+    sample_displs[r] = total_samples;
+    total_samples += sample_counts[r];
+  }
+  std::vector<Key> all_samples(static_cast<std::size_t>(total_samples));
+  MPI_Allgatherv(samples.data(), sample_count, type, all_samples.data(), sample_counts.data(), sample_displs.data(),
+                 type, comm);
+  const std::vector<Key> splitters = PickSplitters(std::move(all_samples), ranks);
+  SortStats stats;
+  stats.bytes = samples.size() * (ranks - 1) * sizeof(Key);
+  if (splitters.empty()) {
+    return stats;
+  }
+
+  const std::vector<std::size_t> bounds = SplitPoints<Key>(local, splitters);
+  std::vector<std::uint64_t> send(ranks);
+  std::vector<std::uint64_t> receive(ranks);
+  for (std::size_t r = 0; r < ranks; r++) {
+    send[r] = bounds[r + 1] - bounds[r];
+    stats.bytes += std::cmp_equal(r, rank) ? 0 : send[r] * sizeof(Key);
+  }
+  MPI_Alltoall(send.data(), 1, MPI_UINT64_T, receive.data(), 1, MPI_UINT64_T, comm);
+  std::vector<std::size_t> received_at(ranks + 1, 0);
+  for (std::size_t r = 0; r < ranks; r++) {
+    received_at[r + 1] = received_at[r] + receive[r];
+  }
+  std::vector<Key> received(received_at.back());
+
+  const std::uint64_t rounds =
+      ppc::collectives::ChunkedAlltoallv(local.data(), send, std::span(bounds).first(ranks), received.data(), receive,
+                                         std::span(received_at).first(ranks), type, GetTuning().exchange_chunk, comm);
+
+  std::vector<std::span<const Key>> runs(ranks);
+  for (std::size_t r = 0; r < ranks; r++) {
+    runs[r] = std::span<const Key>(received).subspan(received_at[r], receive[r]);
+  }
+  local.resize(received.size());
+  KWayMerge<Key>(runs, local);
+  stats.rounds = rounds;
+  return stats;
+}
+
+}  // namespace detail
+
+/// @brief Sorts @p keys sequentially by @p algorithm.
+template <SortKey Key>
+void SortRun(std::span<Key> keys, Algorithm algorithm) {
+  std::vector<Key> scratch(algorithm == Algorithm::kRadix ? keys.size() : 0);
+  detail::SortBlock<Key>(keys, scratch, algorithm);
+}
+
+/// @brief Sorts @p keys in ascending order: BlockCount() equal blocks are sorted in parallel by the
+/// local algorithm and then combined by the merge.
+/// @details Keys must not be NaN. The last block is padded with Sentinel() keys that are dropped at
+/// the end, so the networks always compare-split blocks of equal size. Odd-even transposition stops
+/// early once two phases in a row moved nothing, as every neighbouring pair is then in order.
+template <SortKey Key>
+SortStats Sort(std::vector<Key> &keys, const Options &options = {}) {
+  const std::size_t count = keys.size();
+  const std::size_t blocks = BlockCount(options, count);
+  SortStats stats;
+  if (blocks <= 1) {
+    SortRun<Key>(keys, options.algorithm);
+    return stats;
+  }
+  const std::size_t block = (count + blocks - 1) / blocks;
+  keys.resize(blocks * block, detail::Sentinel<Key>());
+  std::vector<Key> scratch(keys.size());
+  const auto slice = [&](std::vector<Key> &data, std::size_t b) {
+    return std::span<Key>(data).subspan(b * block, block);
+  };
+  ppc::shared_memory::ParallelFor(blocks, options.backend, [&](std::size_t b) {
+    detail::SortBlock<Key>(slice(keys, b), slice(scratch, b), options.algorithm);
+  });
+  if (options.merge == Merge::kSimple) {
+    detail::MergeRuns(keys, block, blocks, options.backend);
+    stats.rounds = static_cast<std::size_t>(std::bit_width(blocks - 1));
+  } else if (options.merge == Merge::kSample) {
+    detail::SampleMerge(keys, block, blocks, options.backend);
+    stats.rounds = 1;
+  } else {
+    std::size_t quiet = 0;
+    for (const auto &stage : MergeStages(options.merge, blocks)) {
+      std::atomic<std::size_t> moved{0};
+      ppc::shared_memory::ParallelFor(stage.size(), options.backend, [&](std::size_t c) {
+        const auto [low, high] = stage[c];
+        if (detail::MergeSplit<Key>(slice(keys, low), slice(keys, high), slice(scratch, low), slice(scratch, high))) {
+          moved.fetch_add(1, std::memory_order_relaxed);
+        }
+      });
+      stats.rounds++;
+      stats.exchanges += moved.load();
+      quiet = moved.load() == 0 ? quiet + 1 : 0;
+      if (options.merge == Merge::kOddEven && quiet == 2) {
+        break;
+      }
+    }
+  }
+  keys.resize(count);
+  return stats;
+}
+
+namespace detail {
+
+/// @brief Compare-split of this rank's sorted block @p local with @p partner's block of the same
+/// size: one boundary key is exchanged first, and the blocks only when they overlap. The rank
+/// that @p keeps_low ends with the smaller half.
+/// @return Whether keys moved; @p bytes grows by what this rank sent.
+template <SortKey Key>
+bool CompareSplitRanks(std::vector<Key> &local, std::vector<Key> &other, std::vector<Key> &merged, int partner,
+                       bool keeps_low, std::uint64_t &bytes, MPI_Comm comm) {
+  const MPI_Datatype type = ppc::distribution::DatatypeOf<Key>();
+  const int count = static_cast<int>(local.size());
+  Key boundary = keeps_low ? local.back() : local.front();
+  Key partner_boundary{};
+  MPI_Sendrecv(&boundary, 1, type, partner, 0, &partner_boundary, 1, type, partner, 0, comm, MPI_STATUS_IGNORE);
+  bytes += sizeof(Key);
+  if (keeps_low ? !(partner_boundary < boundary) : !(boundary < partner_boundary)) {
+    return false;
+  }
+  MPI_Sendrecv(local.data(), count, type, partner, 0, other.data(), count, type, partner, 0, comm, MPI_STATUS_IGNORE);
+  bytes += local.size() * sizeof(Key);
+  if (keeps_low) {
+    MergeFront<Key>(local, other, merged);
+  } else {
+    MergeBack<Key>(other, local, merged);
+  }
+  local.swap(merged);
+  return true;
+}
+
+}  // namespace detail
+
+/// @brief Sorts the keys spread over the ranks of @p comm.
+/// @details Every rank sorts its keys with Sort(), padded to the largest local count B. Blocks are
+/// then combined across ranks: the networks compare-split ranks with MPI_Sendrecv (exchanging one
+/// boundary key first, so that ordered pairs skip the block exchange), and kSimple gathers the
+/// blocks to rank 0, merges them there and scatters them back. Afterwards rank r holds keys
+/// [r * B, (r + 1) * B) of the sorted sequence, which leaves trailing ranks short or empty.
+/// Odd-even transposition only talks to neighbouring ranks, and an MPI_Allreduce after every phase
+/// stops it once two phases in a row moved nothing. kSample skips the padding and moves every key
+/// once, in one all-to-all exchange: rank r then holds the keys between the (r - 1)-th and r-th
+/// splitters, about total / size keys each, and the shares are no longer equal.
+/// @return The merge across ranks, the same on every rank.
+template <SortKey Key>
+SortStats SortDistributed(std::vector<Key> &local, const Options &options, MPI_Comm comm) {
+  int rank = 0;
+  int size = 1;
+  MPI_Comm_rank(comm, &rank);
+  MPI_Comm_size(comm, &size);
+  SortStats stats;
+  std::array<std::uint64_t, 2> sums = {0, 0};  // exchanges (counted by the lower rank), bytes
+  if (options.merge == Merge::kSample) {
+    Sort(local, options);
+    if (size > 1) {
+      stats = detail::SampleSortRanks(local, comm);
+    }
+    sums[1] = stats.bytes;
+  } else {
+    std::uint64_t block = local.size();
+    std::uint64_t total = local.size();
+    MPI_Allreduce(MPI_IN_PLACE, &block, 1, MPI_UINT64_T, MPI_MAX, comm);
+    MPI_Allreduce(MPI_IN_PLACE, &total, 1, MPI_UINT64_T, MPI_SUM, comm);
+    local.resize(block, detail::Sentinel<Key>());
+    Sort(local, options);
+
+    if (size > 1 && block > 0 && options.merge == Merge::kSimple) {
+      const MPI_Datatype type = ppc::distribution::DatatypeOf<Key>();
+      const int count = static_cast<int>(block);
+      std::vector<Key> all(rank == 0 ? block * static_cast<std::size_t>(size) : 0);
+      MPI_Gather(local.data(), count, type, all.data(), count, type, 0, comm);
+      if (rank == 0) {
+        detail::MergeRuns(all, block, static_cast<std::size_t>(size), options.backend);
+      }
+      MPI_Scatter(all.data(), count, type, local.data(), count, type, 0, comm);
+      stats.rounds = 2;
+      sums[1] = block * sizeof(Key) * (rank == 0 ? static_cast<std::uint64_t>(size - 1) : 1);
+    } else if (size > 1 && block > 0) {
+      std::vector<Key> other(block);
+      std::vector<Key> merged(block);
+      std::size_t quiet = 0;
+      for (const auto &stage : MergeStages(options.merge, static_cast<std::size_t>(size))) {
+        const auto mine = std::ranges::find_if(stage, [&](const Comparator &c) {
+          return std::cmp_equal(c.first, rank) || std::cmp_equal(c.second, rank);
+        });
+        int moved = 0;
+        if (mine != stage.end()) {
+          const bool keeps_low = std::cmp_equal(mine->first, rank);
+          const int partner = static_cast<int>(keeps_low ? mine->second : mine->first);
+          moved = detail::CompareSplitRanks<Key>(local, other, merged, partner, keeps_low, sums[1], comm) ? 1 : 0;
+          sums[0] += keeps_low ? static_cast<std::uint64_t>(moved) : 0;
+        }
+        stats.rounds++;
+        if (options.merge == Merge::kOddEven) {
+          MPI_Allreduce(MPI_IN_PLACE, &moved, 1, MPI_INT, MPI_LOR, comm);
+          quiet = moved == 0 ? quiet + 1 : 0;
+          if (quiet == 2) {
+            break;
+          }
+        }
+      }
+    }
+    const std::uint64_t first = static_cast<std::uint64_t>(rank) * block;
+    local.resize(total > first ? static_cast<std::size_t>(std::min(block, total - first)) : 0);
+  }
+  MPI_Allreduce(MPI_IN_PLACE, sums.data(), 2, MPI_UINT64_T, MPI_SUM, comm);
+  stats.exchanges = static_cast<std::size_t>(sums[0]);
+  stats.bytes = sums[1];
+  return stats;
+}
+
+}  // namespace ppc::sorting
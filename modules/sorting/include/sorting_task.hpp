@@ -0,0 +1,93 @@
+#pragma once
+
+#include <mpi.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+#include "distribution/include/distribution.hpp"
+#include "shared_memory/include/parallel_for.hpp"
+#include "shared_memory/include/shared_memory.hpp"
+#include "sorting/include/sorting.hpp"
+#include "task/include/task.hpp"
+
+namespace ppc::sorting {
+
+/// @brief Sorted keys of a SortTask, with what its merge did.
+template <SortKey Key>
+struct SortOutput {
+  std::vector<Key> keys;
+  SortStats stats;
+};
+
+/// @brief Sorting of a key vector as a course task on any back-end.
+/// @details The kMPI variant sorts the BlockRange share of every rank of MPI_COMM_WORLD with
+/// SortDistributed() and gathers the sorted sequence on every rank; its statistics are those of the
+/// merge across ranks.
+template <SortKey Key, ppc::task::TypeOfTask kType, Algorithm kAlgorithm = Algorithm::kQuick,
+          Merge kMerge = Merge::kBatcher>
+class SortTask : public ppc::task::Task<std::vector<Key>, SortOutput<Key>> {
+ public:
+  using InType = std::vector<Key>;
+  using OutType = SortOutput<Key>;
+
+  static constexpr ppc::task::TypeOfTask GetStaticTypeOfTask() {
+    return kType;
+  }
+
+  explicit SortTask(const InType &in) {
+    this->SetTypeOfTask(GetStaticTypeOfTask());
+    this->GetInput() = in;
+  }
+
+ private:
+  bool ValidationImpl() override {
+    return true;
+  }
+
+  bool PreProcessingImpl() override {
+    return true;
+  }
+
+  bool RunImpl() override {
+    const InType &in = this->GetInput();
+    Options options;
+    options.algorithm = kAlgorithm;
+    options.merge = kMerge;
+    options.backend = ppc::shared_memory::BackendOf(kType);
+    if constexpr (kType != ppc::task::TypeOfTask::kMPI) {
+      this->GetOutput().keys = in;
+      this->GetOutput().stats = Sort(this->GetOutput().keys, options);
+    } else {
+      int rank = 0;
+      int size = 1;
+      MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+      MPI_Comm_size(MPI_COMM_WORLD, &size);
+      const auto [begin, end] = ppc::shared_memory::BlockRange(in.size(), size, rank);
+      std::vector<Key> local(in.begin() + static_cast<std::ptrdiff_t>(begin),
+                             in.begin() + static_cast<std::ptrdiff_t>(end));
+      this->GetOutput().stats = SortDistributed(local, options, MPI_COMM_WORLD);
+
+      std::vector<int> counts(static_cast<std::size_t>(size));
+      const int count = static_cast<int>(local.size());
+      MPI_Allgather(&count, 1, MPI_INT, counts.data(), 1, MPI_INT, MPI_COMM_WORLD);
+      std::vector<int> displs(counts.size(), 0);
+      for (std::size_t r = 1; r < counts.size(); r++) {
+        displs[r] = displs[r - 1] + counts[r - 1];
+      }
+      this->GetOutput().keys.resize(in.size());
+      const MPI_Datatype type = ppc::distribution::DatatypeOf<Key>();
+      MPI_Allgatherv(local.data(), count, type, this->GetOutput().keys.data(), counts.data(), displs.data(), type,
+                     MPI_COMM_WORLD);
+    }
+    return true;
+  }
+
+  bool PostProcessingImpl() override {
+    const std::vector<Key> &keys = this->GetOutput().keys;
+    return keys.size() == this->GetInput().size() && std::ranges::is_sorted(keys);
+  }
+};
+
+}  // namespace ppc::sorting
@@ -0,0 +1,201 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <random>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include "sorting/include/sorting.hpp"
+#include "sorting/include/sorting_task.hpp"
+#include "task/include/task.hpp"
+#include "util/include/perf_test_util.hpp"
+
+namespace ppc::sorting::perf {
+
+using ppc::task::TypeOfTask;
+
+namespace {
+
+constexpr std::size_t kKeys = std::size_t{1} << 20;
+constexpr std::size_t kLargeKeys = std::size_t{1} << 23;
+
+enum class Distribution : uint8_t { kUniform, kSorted, kReverse, kDuplicates };
+
+std::string DistributionToString(Distribution distribution) {
+  switch (distribution) {
+    case Distribution::kUniform:
+      return "uniform";
+    case Distribution::kSorted:
+      return "sorted";
+    case Distribution::kReverse:
+      return "reverse";
+    case Distribution::kDuplicates:
+      return "duplicates";
+  }
+  return "unknown";
+}
+
+/// Uniform keys in [-1, 1), sorted or reversed, or uniform over 16 distinct values.
+std::vector<double> MakeKeys(Distribution distribution, std::size_t count = kKeys) {
+  std::mt19937_64 engine(44);
+  std::uniform_real_distribution<double> uniform(-1.0, 1.0);
+  std::vector<double> keys(count);
+  for (double &key : keys) {
+    key = uniform(engine);
+  }
+  switch (distribution) {
+    case Distribution::kUniform:
+      break;
+    case Distribution::kSorted:
+      std::ranges::sort(keys);
+      break;
+    case Distribution::kReverse:
+      std::ranges::sort(keys, std::greater<>());
+      break;
+    case Distribution::kDuplicates:
+      for (double &key : keys) {
+        key = std::floor(8.0 * key) / 8.0;
+      }
+      break;
+  }
+  return keys;
+}
+
+}  // namespace
+
+/// Sort perf fixture that also prints the merge statistics.
+class SortStatsPerfTests : public ppc::util::BaseRunPerfTests<std::vector<double>, SortOutput<double>> {
+ protected:
+  /// Reports rounds, compare-splits that moved keys, and bytes sent between ranks.
+  void PrintStats(const SortStats &stats) const {
+    PrintValue("rounds", static_cast<double>(stats.rounds));
+    PrintValue("exchanges", static_cast<double>(stats.exchanges));
+    PrintValue("bytes", static_cast<double>(stats.bytes));
+  }
+};
+
+/// Reports sorted keys per second (in millions) on one key distribution, and the merge statistics.
+template <Distribution kDistribution>
+class SortPerfTests : public SortStatsPerfTests {
+  bool CheckTestOutputData(SortOutput<double> &output_data) final {
+    PrintRate("mkeys_per_s", 1e-6 * static_cast<double>(output_data.keys.size()));
+    PrintStats(output_data.stats);
+    return output_data.keys.size() == kKeys && std::ranges::is_sorted(output_data.keys);
+  }
+
+  std::vector<double> GetTestInputData() final {
+    return MakeKeys(kDistribution);
+  }
+};
+
+/// Reports keys per second on a large uniform input, for distributed sample sort against Batcher's
+/// and odd-even transposition's compare-split merges; run it at 1 to 16 ranks.
+class LargeSortPerfTests : public SortStatsPerfTests {
+  bool CheckTestOutputData(SortOutput<double> &output_data) final {
+    PrintRate("mkeys_per_s", 1e-6 * static_cast<double>(output_data.keys.size()));
+    PrintStats(output_data.stats);
+    return output_data.keys.size() == kLargeKeys && std::ranges::is_sorted(output_data.keys);
+  }
+
+  std::vector<double> GetTestInputData() final {
+    return MakeKeys(Distribution::kUniform, kLargeKeys);
+  }
+};
+
+/// SortTask of every back-end for one local sort and merge.
+template <Algorithm kAlgorithm, Merge kMerge>
+struct PerfSortTasks {
+  template <TypeOfTask kType>
+  using Task = SortTask<double, kType, kAlgorithm, kMerge>;
+};
+
+template <Algorithm kAlgorithm, Merge kMerge>
+auto MakeBackendSuite(Distribution distribution) {
+  const std::string kernel =
+      AlgorithmToString(kAlgorithm) + "_" + MergeToString(kMerge) + "_" + DistributionToString(distribution);
+  return ppc::util::MakeBackendPerfTaskTuples<PerfSortTasks<kAlgorithm, kMerge>::template Task, std::vector<double>>(
+      "ppc_sorting", kernel);
+}
+
+namespace {
+
+/// Every local sort under Batcher's merge.
+auto MakeAlgorithmSuites(Distribution distribution) {
+  return std::tuple_cat(MakeBackendSuite<Algorithm::kQuick, Merge::kBatcher>(distribution),
+                        MakeBackendSuite<Algorithm::kShell, Merge::kBatcher>(distribution),
+                        MakeBackendSuite<Algorithm::kRadix, Merge::kBatcher>(distribution));
+}
+
+/// One MPI sort of the large input.
+template <Algorithm kAlgorithm, Merge kMerge>
+auto MakeLargeMpiCase(const std::string &kernel) {
+  using Task = SortTask<double, TypeOfTask::kMPI, kAlgorithm, kMerge>;
+  return ppc::util::MakeNamedPerfTaskTuples<Task, std::vector<double>>("ppc_sorting_mpi_" + kernel + "_large");
+}
+
+}  // namespace
+
+using UniformPerfTests = SortPerfTests<Distribution::kUniform>;
+using SortedPerfTests = SortPerfTests<Distribution::kSorted>;
+using ReversePerfTests = SortPerfTests<Distribution::kReverse>;
+using DuplicatesPerfTests = SortPerfTests<Distribution::kDuplicates>;
+
+TEST_P(UniformPerfTests, RunPerfModes) {
+  ExecuteTest(GetParam());
+}
+
+TEST_P(SortedPerfTests, RunPerfModes) {
+  ExecuteTest(GetParam());
+}
+
+TEST_P(ReversePerfTests, RunPerfModes) {
+  ExecuteTest(GetParam());
+}
+
+TEST_P(DuplicatesPerfTests, RunPerfModes) {
+  ExecuteTest(GetParam());
+}
+
+TEST_P(LargeSortPerfTests, RunPerfModes) {
+  ExecuteTest(GetParam());
+}
+
+// Uniform keys also compare the merges under radix sort; sorted keys show odd-even transposition
+// stopping after two phases.
+const auto kUniformPerfTasks =
+    std::tuple_cat(MakeAlgorithmSuites(Distribution::kUniform),
+                   MakeBackendSuite<Algorithm::kRadix, Merge::kSimple>(Distribution::kUniform),
+                   MakeBackendSuite<Algorithm::kRadix, Merge::kBitonic>(Distribution::kUniform),
+                   MakeBackendSuite<Algorithm::kRadix, Merge::kSample>(Distribution::kUniform),
+                   MakeBackendSuite<Algorithm::kRadix, Merge::kOddEven>(Distribution::kUniform));
+const auto kSortedPerfTasks =
+    std::tuple_cat(MakeAlgorithmSuites(Distribution::kSorted),
+                   MakeBackendSuite<Algorithm::kQuick, Merge::kOddEven>(Distribution::kSorted));
+const auto kReversePerfTasks = MakeAlgorithmSuites(Distribution::kReverse);
+const auto kDuplicatesPerfTasks = MakeAlgorithmSuites(Distribution::kDuplicates);
+const auto kLargePerfTasks = std::tuple_cat(
+    ppc::util::MakeNamedPerfTaskTuples<SortTask<double, TypeOfTask::kSEQ, Algorithm::kRadix>, std::vector<double>>(
+        "ppc_sorting_seq_radix_large"),
+    MakeLargeMpiCase<Algorithm::kQuick, Merge::kBatcher>("quick_batcher"),
+    MakeLargeMpiCase<Algorithm::kQuick, Merge::kSample>("quick_sample"),
+    MakeLargeMpiCase<Algorithm::kRadix, Merge::kBatcher>("radix_batcher"),
+    MakeLargeMpiCase<Algorithm::kRadix, Merge::kSample>("radix_sample"),
+    MakeLargeMpiCase<Algorithm::kRadix, Merge::kOddEven>("radix_odd_even"));
+
+INSTANTIATE_TEST_SUITE_P(SortUniform, UniformPerfTests, ppc::util::TupleToGTestValues(kUniformPerfTasks),
+                         UniformPerfTests::CustomPerfTestName);
+INSTANTIATE_TEST_SUITE_P(SortSorted, SortedPerfTests, ppc::util::TupleToGTestValues(kSortedPerfTasks),
+                         SortedPerfTests::CustomPerfTestName);
+INSTANTIATE_TEST_SUITE_P(SortReverse, ReversePerfTests, ppc::util::TupleToGTestValues(kReversePerfTasks),
+                         ReversePerfTests::CustomPerfTestName);
+INSTANTIATE_TEST_SUITE_P(SortLarge, LargeSortPerfTests, ppc::util::TupleToGTestValues(kLargePerfTasks),
+                         LargeSortPerfTests::CustomPerfTestName);
+INSTANTIATE_TEST_SUITE_P(SortDuplicates, DuplicatesPerfTests, ppc::util::TupleToGTestValues(kDuplicatesPerfTasks),
+                         DuplicatesPerfTests::CustomPerfTestName);
+
+}  // namespace ppc::sorting::perf
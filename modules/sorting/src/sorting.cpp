@@ -0,0 +1,280 @@
+#include "sorting/include/sorting.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "reduction/include/reduction.hpp"
+#include "shared_memory/include/parallel_for.hpp"
+
+#ifdef PPC_TARGET_AVX2
+#define PPC_SORTING_X86 1
+#include <immintrin.h>
+#endif
+
+namespace ppc::sorting {
+
+std::string AlgorithmToString(Algorithm algorithm) {
+  switch (algorithm) {
+    case Algorithm::kQuick:
+      return "quick";
+    case Algorithm::kShell:
+      return "shell";
+    case Algorithm::kRadix:
+      return "radix";
+  }
+  return "unknown";
+}
+
+std::string MergeToString(Merge merge) {
+  switch (merge) {
+    case Merge::kSimple:
+      return "simple";
+    case Merge::kBatcher:
+      return "batcher";
+    case Merge::kBitonic:
+      return "bitonic";
+    case Merge::kSample:
+      return "sample";
+    case Merge::kOddEven:
+      return "odd_even";
+  }
+  return "unknown";
+}
+
+Tuning &GetTuning() {
+  static Tuning tuning;
+  return tuning;
+}
+
+std::size_t BlockCount(const Options &options, std::size_t count) {
+  const std::size_t blocks =
+      options.blocks != 0 ? options.blocks
+                          : static_cast<std::size_t>(ppc::shared_memory::BackendWorkers(options.backend));
+  return std::min(blocks, std::max<std::size_t>(count, 1));
+}
+
+std::vector<std::vector<Comparator>> BatcherStages(std::size_t count) {
+  std::vector<std::vector<Comparator>> stages;
+  for (std::size_t p = 1; p < count; p *= 2) {
+    for (std::size_t k = p; k >= 1; k /= 2) {
+      std::vector<Comparator> stage;
+      for (std::size_t j = k % p; j + k < count; j += 2 * k) {
+        for (std::size_t i = 0; i < k && i + j + k < count; i++) {
+          if ((i + j) / (2 * p) == (i + j + k) / (2 * p)) {
+            stage.emplace_back(i + j, i + j + k);
+          }
+        }
+      }
+      if (!stage.empty()) {
+        stages.push_back(std::move(stage));
+      }
+    }
+  }
+  return stages;
+}
+
+std::vector<std::vector<Comparator>> BitonicStages(std::size_t count) {
+  std::vector<std::vector<Comparator>> stages;
+  const auto add_stage = [&](std::size_t distance, bool mirror) {
+    std::vector<Comparator> stage;
+    for (std::size_t i = 0; i < count; i++) {
+      const std::size_t partner = mirror ? i ^ ((2 * distance) - 1) : i ^ distance;
+      if ((i & distance) == 0 && partner < count) {
+        stage.emplace_back(i, partner);
+      }
+    }
+    if (!stage.empty()) {
+      stages.push_back(std::move(stage));
+    }
+  };
+  for (std::size_t k = 2; k / 2 < count; k *= 2) {
+    add_stage(k / 2, true);
+    for (std::size_t j = k / 4; j >= 1; j /= 2) {
+      add_stage(j, false);
+    }
+  }
+  return stages;
+}
+
+std::vector<std::vector<Comparator>> TranspositionStages(std::size_t count) {
+  std::vector<std::vector<Comparator>> stages;
+  for (std::size_t phase = 0; phase < count; phase++) {
+    std::vector<Comparator> stage;
+    for (std::size_t i = phase % 2; i + 1 < count; i += 2) {
+      stage.emplace_back(i, i + 1);
+    }
+    if (!stage.empty()) {
+      stages.push_back(std::move(stage));
+    }
+  }
+  return stages;
+}
+
+std::vector<std::vector<Comparator>> MergeStages(Merge merge, std::size_t count) {
+  switch (merge) {
+    case Merge::kBatcher:
+      return BatcherStages(count);
+    case Merge::kBitonic:
+      return BitonicStages(count);
+    case Merge::kOddEven:
+      return TranspositionStages(count);
+    case Merge::kSimple:
+    case Merge::kSample:
+      break;
+  }
+  throw std::invalid_argument("sorting: " + MergeToString(merge) + " merge is not a network");
+}
+
+namespace detail {
+
+namespace {
+
+#ifdef PPC_SORTING_X86
+
+namespace avx2 {
+
+// A register holds four keys in merge order: ascending for a front merge, descending for a back
+// merge, which only swaps the roles of min and max.
+
+constexpr std::size_t kWidth = 4;
+
+PPC_TARGET_AVX2 __m256d Reverse(__m256d v) {
+  return _mm256_permute4x64_pd(v, 0x1B);
+}
+
+template <bool kBack>
+PPC_TARGET_AVX2 __m256d First(__m256d a, __m256d b) {
+  return kBack ? _mm256_max_pd(a, b) : _mm256_min_pd(a, b);
+}
+
+template <bool kBack>
+PPC_TARGET_AVX2 __m256d Second(__m256d a, __m256d b) {
+  return kBack ? _mm256_min_pd(a, b) : _mm256_max_pd(a, b);
+}
+
+/// Sorts a bitonic register: half-cleaners at distances 2 and 1.
+template <bool kBack>
+PPC_TARGET_AVX2 __m256d Clean(__m256d v) {
+  __m256d swapped = _mm256_permute4x64_pd(v, 0x4E);
+  v = _mm256_blend_pd(First<kBack>(v, swapped), Second<kBack>(v, swapped), 0b1100);
+  swapped = _mm256_permute_pd(v, 0b0101);
+  return _mm256_blend_pd(First<kBack>(v, swapped), Second<kBack>(v, swapped), 0b1010);
+}
+
+/// Merges two sorted registers: @p first gets the four first keys of the eight and @p second the rest.
+template <bool kBack>
+PPC_TARGET_AVX2 void MergeRegisters(__m256d &first, __m256d &second) {
+  const __m256d reversed = Reverse(second);
+  const __m256d low = First<kBack>(first, reversed);
+  second = Clean<kBack>(Second<kBack>(first, reversed));
+  first = Clean<kBack>(low);
+}
+
+/// The next four keys of @p run in merge order, after @p taken keys.
+template <bool kBack>
+PPC_TARGET_AVX2 __m256d Load(std::span<const double> run, std::size_t taken) {
+  if constexpr (kBack) {
+    return Reverse(_mm256_loadu_pd(run.data() + (run.size() - taken - kWidth)));
+  } else {
+    return _mm256_loadu_pd(run.data() + taken);
+  }
+}
+
+template <bool kBack>
+PPC_TARGET_AVX2 void Store(std::span<double> out, std::size_t done, __m256d v) {
+  if constexpr (kBack) {
+    _mm256_storeu_pd(out.data() + (out.size() - done - kWidth), Reverse(v));
+  } else {
+    _mm256_storeu_pd(out.data() + done, v);
+  }
+}
+
+template <bool kBack>
+double At(std::span<const double> run, std::size_t taken) {
+  return kBack ? run[run.size() - 1 - taken] : run[taken];
+}
+
+template <bool kBack>
+bool Before(double a, double b) {
+  return kBack ? b < a : a < b;
+}
+
+/// Merges with a register of pending keys: every step loads four keys from the run whose next key
+/// comes first, which keeps the four first keys of the register pair ahead of all unloaded keys.
+template <bool kBack>
+PPC_TARGET_AVX2 void Merge(std::span<const double> low, std::span<const double> high, std::span<double> out) {
+  __m256d front = Load<kBack>(low, 0);
+  __m256d pending = Load<kBack>(high, 0);
+  MergeRegisters<kBack>(front, pending);
+  Store<kBack>(out, 0, front);
+  std::size_t done = kWidth;
+  std::size_t a = kWidth;
+  std::size_t b = kWidth;
+  while (done + kWidth <= out.size() && a + kWidth <= low.size() && b + kWidth <= high.size()) {
+    __m256d next{};
+    if (Before<kBack>(At<kBack>(high, b), At<kBack>(low, a))) {
+      next = Load<kBack>(high, b);
+      b += kWidth;
+    } else {
+      next = Load<kBack>(low, a);
+      a += kWidth;
+    }
+    MergeRegisters<kBack>(pending, next);
+    Store<kBack>(out, done, pending);
+    pending = next;
+    done += kWidth;
+  }
+  std::array<double, kWidth> rest{};
+  _mm256_storeu_pd(rest.data(), pending);
+  std::size_t r = 0;
+  for (; done < out.size(); done++) {
+    double key = 0.0;
+    if (r < kWidth && (a == low.size() || !Before<kBack>(At<kBack>(low, a), rest[r])) &&
+        (b == high.size() || !Before<kBack>(At<kBack>(high, b), rest[r]))) {
+      key = rest[r++];
+    } else if (a < low.size() && (b == high.size() || !Before<kBack>(At<kBack>(high, b), At<kBack>(low, a)))) {
+      key = At<kBack>(low, a++);
+    } else {
+      key = At<kBack>(high, b++);
+    }
+    out[kBack ? out.size() - 1 - done : done] = key;
+  }
+}
+
+}  // namespace avx2
+
+#endif  // PPC_SORTING_X86
+
+}  // namespace
+
+bool MergeDoublesSimd(std::span<const double> low, std::span<const double> high, std::span<double> out, bool back) {
+#ifdef PPC_SORTING_X86
+  constexpr std::size_t kWidth = avx2::kWidth;
+  if (ppc::reduction::ActiveIsa() == ppc::reduction::Isa::kScalar || low.size() < kWidth || high.size() < kWidth ||
+      out.size() < kWidth || out.size() > low.size() + high.size()) {
+    return false;
+  }
+  if (back) {
+    avx2::Merge<true>(low, high, out);
+  } else {
+    avx2::Merge<false>(low, high, out);
+  }
+  return true;
+#else
+  static_cast<void>(low);
+  static_cast<void>(high);
+  static_cast<void>(out);
+  static_cast<void>(back);
+  return false;
+#endif
+}
+
+}  // namespace detail
+
+}  // namespace ppc::sorting
@@ -0,0 +1,352 @@
+#include <gtest/gtest.h>
+#include <mpi.h>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+#include "reduction/include/reduction.hpp"
+#include "shared_memory/include/parallel_for.hpp"
+#include "shared_memory/include/shared_memory.hpp"
+#include "sorting/include/sorting.hpp"
+#include "sorting/include/sorting_task.hpp"
+#include "task/include/task.hpp"
+#include "util/include/func_test_util.hpp"
+
+using ppc::sorting::Algorithm;
+using ppc::sorting::Backend;
+using ppc::sorting::Merge;
+using ppc::task::TypeOfTask;
+
+namespace {
+
+constexpr std::array<Backend, 4> kAllBackends = {Backend::kSeq, Backend::kOmp, Backend::kTbb, Backend::kStl};
+constexpr std::array<Algorithm, 3> kAllAlgorithms = {Algorithm::kQuick, Algorithm::kShell, Algorithm::kRadix};
+constexpr std::array<Merge, 5> kAllMerges = {Merge::kSimple, Merge::kBatcher, Merge::kBitonic, Merge::kSample,
+                                             Merge::kOddEven};
+
+/// Random keys spanning the whole range of @p Key, with a few duplicates and extreme values.
+template <typename Key>
+std::vector<Key> RandomKeys(std::size_t count, std::uint64_t seed) {
+  std::mt19937_64 engine(seed);
+  std::vector<Key> keys(count);
+  for (Key &key : keys) {
+    if constexpr (std::is_floating_point_v<Key>) {
+      std::uniform_real_distribution<Key> value(-1e6, 1e6);
+      key = value(engine);
+    } else {
+      key = static_cast<Key>(engine());
+    }
+  }
+  for (std::size_t i = 0; i < count; i += 7) {
+    keys[i] = keys[(i * 31) % count];
+  }
+  if (count > 4) {
+    keys[1] = std::numeric_limits<Key>::lowest();
+    keys[2] = std::numeric_limits<Key>::max();
+    keys[3] = Key{0};
+    if constexpr (std::is_floating_point_v<Key>) {
+      keys[4] = -std::numeric_limits<Key>::infinity();
+      keys[0] = std::numeric_limits<Key>::denorm_min();
+    }
+  }
+  return keys;
+}
+
+template <typename Key>
+void ExpectEveryAlgorithmSorts() {
+  for (const std::size_t count : {0U, 1U, 2U, 23U, 24U, 25U, 1000U, 20000U}) {
+    const std::vector<Key> keys = RandomKeys<Key>(count, count);
+    std::vector<Key> expected = keys;
+    std::ranges::sort(expected);
+    for (const Algorithm algorithm : kAllAlgorithms) {
+      std::vector<Key> sorted = keys;
+      ppc::sorting::SortRun<Key>(sorted, algorithm);
+      EXPECT_EQ(sorted, expected) << ppc::sorting::AlgorithmToString(algorithm) << " " << count;
+    }
+  }
+}
+
+/// Sorting-network check by the 0-1 principle: every 0-1 input of @p count blocks comes out sorted.
+void ExpectNetworkSorts(const std::vector<std::vector<ppc::sorting::Comparator>> &stages, std::size_t count) {
+  for (const auto &stage : stages) {
+    std::vector<int> used(count, 0);
+    for (const auto &[low, high] : stage) {
+      ASSERT_LT(low, high);
+      ASSERT_LT(high, count);
+      EXPECT_EQ(used[low]++ + used[high]++, 0) << "stage comparators overlap";
+    }
+  }
+  for (std::uint32_t input = 0; input < (1U << count); input++) {
+    std::vector<int> bits(count);
+    for (std::size_t i = 0; i < count; i++) {
+      bits[i] = static_cast<int>((input >> i) & 1U);
+    }
+    for (const auto &stage : stages) {
+      for (const auto &[low, high] : stage) {
+        if (bits[high] < bits[low]) {
+          std::swap(bits[low], bits[high]);
+        }
+      }
+    }
+    ASSERT_TRUE(std::ranges::is_sorted(bits)) << count << " blocks, input " << input;
+  }
+}
+
+}  // namespace
+
+TEST(Sorting, EveryAlgorithmSortsEveryKeyType) {
+  ExpectEveryAlgorithmSorts<double>();
+  ExpectEveryAlgorithmSorts<float>();
+  ExpectEveryAlgorithmSorts<int>();
+  ExpectEveryAlgorithmSorts<unsigned>();
+  ExpectEveryAlgorithmSorts<std::int64_t>();
+  ExpectEveryAlgorithmSorts<std::uint64_t>();
+}
+
+TEST(Sorting, MergeNetworksSortAnyBlockCount) {
+  for (std::size_t count = 1; count <= 12; count++) {
+    ExpectNetworkSorts(ppc::sorting::BatcherStages(count), count);
+    ExpectNetworkSorts(ppc::sorting::BitonicStages(count), count);
+    ExpectNetworkSorts(ppc::sorting::TranspositionStages(count), count);
+  }
+  // Batcher's network on 8 blocks has 19 comparators in 6 stages, the bitonic one 24 in 6.
+  const auto batcher = ppc::sorting::BatcherStages(8);
+  const auto bitonic = ppc::sorting::BitonicStages(8);
+  EXPECT_EQ(batcher.size(), 6U);
+  EXPECT_EQ(bitonic.size(), 6U);
+  const auto comparators = [](const auto &stages) {
+    std::size_t total = 0;
+    for (const auto &stage : stages) {
+      total += stage.size();
+    }
+    return total;
+  };
+  EXPECT_EQ(comparators(batcher), 19U);
+  EXPECT_EQ(comparators(bitonic), 24U);
+  EXPECT_THROW((void)ppc::sorting::MergeStages(Merge::kSimple, 4), std::invalid_argument);
+  EXPECT_THROW((void)ppc::sorting::MergeStages(Merge::kSample, 4), std::invalid_argument);
+}
+
+TEST(Sorting, BlocksMergeToTheSortedSequenceOnEveryBackend) {
+  const std::vector<double> keys = RandomKeys<double>(10007, 5);
+  std::vector<double> expected = keys;
+  std::ranges::sort(expected);
+  for (const Backend backend : kAllBackends) {
+    for (const Algorithm algorithm : kAllAlgorithms) {
+      for (const Merge merge : kAllMerges) {
+        for (const std::size_t blocks : {0U, 2U, 3U, 5U, 8U}) {
+          std::vector<double> sorted = keys;
+          ppc::sorting::Sort(sorted, {.algorithm = algorithm, .merge = merge, .blocks = blocks, .backend = backend});
+          EXPECT_EQ(sorted, expected) << ppc::shared_memory::BackendToString(backend) << " "
+                                      << ppc::sorting::AlgorithmToString(algorithm) << " "
+                                      << ppc::sorting::MergeToString(merge) << " " << blocks;
+        }
+      }
+    }
+  }
+}
+
+TEST(Sorting, PresortedAndDuplicateInputs) {
+  constexpr std::size_t kCount = 5000;
+  std::vector<std::vector<int>> inputs(4, std::vector<int>(kCount));
+  for (std::size_t i = 0; i < kCount; i++) {
+    inputs[0][i] = static_cast<int>(i);
+    inputs[1][i] = static_cast<int>(kCount - i);
+    inputs[2][i] = static_cast<int>((i * 7919) % 5);
+    inputs[3][i] = 42;
+  }
+  inputs.emplace_back(3, 1);
+  inputs.emplace_back();
+  for (const auto &keys : inputs) {
+    std::vector<int> expected = keys;
+    std::ranges::sort(expected);
+    for (const Algorithm algorithm : kAllAlgorithms) {
+      for (const Merge merge : kAllMerges) {
+        std::vector<int> sorted = keys;
+        ppc::sorting::Sort(sorted, {.algorithm = algorithm, .merge = merge, .blocks = 6, .backend = Backend::kTbb});
+        EXPECT_EQ(sorted, expected);
+      }
+    }
+  }
+}
+
+TEST(Sorting, DistributedMergesGiveEachRankItsSlice) {
+  if (!ppc::util::MpiReady()) {
+    GTEST_SKIP() << "MPI is not initialized";
+  }
+  int rank = 0;
+  int size = 1;
+  MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+  MPI_Comm_size(MPI_COMM_WORLD, &size);
+  // Uneven shares, with the last rank empty when there are several.
+  const std::vector<std::int64_t> all = RandomKeys<std::int64_t>(4099, 9);
+  const std::size_t parts = size > 1 ? static_cast<std::size_t>(size) - 1 : 1;
+  std::vector<std::int64_t> expected = all;
+  std::ranges::sort(expected);
+  for (const Merge merge : {Merge::kSimple, Merge::kBatcher, Merge::kBitonic, Merge::kOddEven}) {
+    for (const Algorithm algorithm : kAllAlgorithms) {
+      std::vector<std::int64_t> local;
+      if (static_cast<std::size_t>(rank) < parts) {
+        const auto [begin, end] = ppc::shared_memory::BlockRange(all.size(), static_cast<int>(parts), rank);
+        local.assign(all.begin() + static_cast<std::ptrdiff_t>(begin), all.begin() + static_cast<std::ptrdiff_t>(end));
+      }
+      ppc::sorting::SortDistributed(local, {.algorithm = algorithm, .merge = merge, .backend = Backend::kOmp},
+                                    MPI_COMM_WORLD);
+      const std::size_t block = (all.size() + parts - 1) / parts;
+      const std::size_t first = std::min(all.size(), static_cast<std::size_t>(rank) * block);
+      const std::size_t last = std::min(all.size(), first + block);
+      const std::vector<std::int64_t> slice(expected.begin() + static_cast<std::ptrdiff_t>(first),
+                                            expected.begin() + static_cast<std::ptrdiff_t>(last));
+      EXPECT_EQ(local, slice) << ppc::sorting::MergeToString(merge) << " "
+                              << ppc::sorting::AlgorithmToString(algorithm);
+    }
+  }
+}
+
+TEST(Sorting, SampleSortExchangesBucketsInChunks) {
+  if (!ppc::util::MpiReady()) {
+    GTEST_SKIP() << "MPI is not initialized";
+  }
+  int rank = 0;
+  int size = 1;
+  MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+  MPI_Comm_size(MPI_COMM_WORLD, &size);
+  // Small rounds, so that every bucket takes several; random keys and a single repeated key.
+  const std::size_t saved = ppc::sorting::GetTuning().exchange_chunk;
+  ppc::sorting::GetTuning().exchange_chunk = 37;
+  for (const bool duplicates : {false, true}) {
+    const std::vector<double> all = duplicates ? std::vector<double>(6000, 0.5) : RandomKeys<double>(6000, 21);
+    std::vector<double> expected = all;
+    std::ranges::sort(expected);
+    const auto [begin, end] = ppc::shared_memory::BlockRange(all.size(), size, rank);
+    std::vector<double> local(all.begin() + static_cast<std::ptrdiff_t>(begin),
+                              all.begin() + static_cast<std::ptrdiff_t>(end));
+    ppc::sorting::SortDistributed(local, {.merge = Merge::kSample, .backend = Backend::kStl}, MPI_COMM_WORLD);
+    EXPECT_TRUE(std::ranges::is_sorted(local));
+    // Regular sampling keeps every rank under twice its fair share, duplicates included.
+    EXPECT_LE(local.size(), (2 * all.size() / static_cast<std::size_t>(size)) + 1);
+
+    const int count = static_cast<int>(local.size());
+    std::vector<int> counts(static_cast<std::size_t>(size));
+    MPI_Allgather(&count, 1, MPI_INT, counts.data(), 1, MPI_INT, MPI_COMM_WORLD);
+    std::vector<int> displs(counts.size(), 0);
+    for (std::size_t r = 1; r < counts.size(); r++) {
+      displs[r] = displs[r - 1] + counts[r - 1];
+    }
+    std::vector<double> gathered(all.size());
+    MPI_Allgatherv(local.data(), count, MPI_DOUBLE, gathered.data(), counts.data(), displs.data(), MPI_DOUBLE,
+                   MPI_COMM_WORLD);
+    EXPECT_EQ(gathered, expected);
+  }
+  ppc::sorting::GetTuning().exchange_chunk = saved;
+}
+
+TEST(Sorting, SimdMergeMatchesScalarMerge) {
+  const std::vector<double> keys = RandomKeys<double>(600, 31);
+  std::vector<double> duplicates(keys.size());
+  for (std::size_t i = 0; i < keys.size(); i++) {
+    duplicates[i] = std::round(keys[i] * 1e-5);
+  }
+  const ppc::reduction::Isa saved = ppc::reduction::GetTuning().isa;
+  for (const auto &input : {keys, duplicates}) {
+    // Runs of every length around the register width, and partial outputs of either end.
+    for (const std::size_t split : {0U, 3U, 4U, 5U, 17U, 300U, 597U}) {
+      std::vector<double> low(input.begin(), input.begin() + static_cast<std::ptrdiff_t>(split));
+      std::vector<double> high(input.begin() + static_cast<std::ptrdiff_t>(split), input.end());
+      std::ranges::sort(low);
+      std::ranges::sort(high);
+      for (const std::size_t length : {4U, 11U, 300U, 600U}) {
+        std::array<std::vector<double>, 2> front;
+        std::array<std::vector<double>, 2> back;
+        for (std::size_t pass = 0; pass < 2; pass++) {
+          ppc::reduction::GetTuning().isa = pass == 0 ? saved : ppc::reduction::Isa::kScalar;
+          front[pass].resize(length);
+          back[pass].resize(length);
+          ppc::sorting::detail::MergeFront<double>(low, high, front[pass]);
+          ppc::sorting::detail::MergeBack<double>(low, high, back[pass]);
+        }
+        std::vector<double> merged = input;
+        std::ranges::sort(merged);
+        EXPECT_EQ(front[0], front[1]) << split << " " << length;
+        EXPECT_EQ(back[0], back[1]) << split << " " << length;
+        EXPECT_TRUE(std::ranges::equal(front[0], std::span<const double>(merged).first(length)));
+        EXPECT_TRUE(std::ranges::equal(back[0], std::span<const double>(merged).last(length)));
+      }
+    }
+  }
+  ppc::reduction::GetTuning().isa = saved;
+}
+
+TEST(Sorting, OddEvenTranspositionStopsOnceOrdered) {
+  std::vector<double> sorted = RandomKeys<double>(8000, 41);
+  std::ranges::sort(sorted);
+  std::vector<double> keys = sorted;
+  // Sorted blocks move nothing: the two first phases find every pair ordered.
+  auto stats = ppc::sorting::Sort(keys, {.merge = Merge::kOddEven, .blocks = 8, .backend = Backend::kOmp});
+  EXPECT_EQ(stats.rounds, 2U);
+  EXPECT_EQ(stats.exchanges, 0U);
+  // One key out of place travels one block per phase.
+  keys = sorted;
+  std::ranges::rotate(keys, keys.end() - 1);
+  stats = ppc::sorting::Sort(keys, {.merge = Merge::kOddEven, .blocks = 8, .backend = Backend::kStl});
+  EXPECT_EQ(keys, sorted);
+  EXPECT_EQ(stats.exchanges, 7U);
+  EXPECT_LE(stats.rounds, 8U);
+
+  if (!ppc::util::MpiReady()) {
+    return;
+  }
+  int rank = 0;
+  int size = 1;
+  MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+  MPI_Comm_size(MPI_COMM_WORLD, &size);
+  const auto [begin, end] = ppc::shared_memory::BlockRange(sorted.size(), size, rank);
+  std::vector<double> local(sorted.begin() + static_cast<std::ptrdiff_t>(begin),
+                            sorted.begin() + static_cast<std::ptrdiff_t>(end));
+  stats = ppc::sorting::SortDistributed(local, {.merge = Merge::kOddEven}, MPI_COMM_WORLD);
+  EXPECT_EQ(stats.exchanges, 0U);
+  EXPECT_LE(stats.rounds, 2U);
+  // Only boundary keys cross: two per neighbouring pair and phase.
+  EXPECT_LE(stats.bytes, 4 * static_cast<std::uint64_t>(size) * sizeof(double));
+}
+
+namespace {
+
+template <TypeOfTask kType, Algorithm kAlgorithm, Merge kMerge>
+void RunSortTask() {
+  const std::vector<double> keys = RandomKeys<double>(3001, 17);
+  ppc::sorting::SortTask<double, kType, kAlgorithm, kMerge> task(keys);
+  ASSERT_TRUE(task.Validation());
+  ASSERT_TRUE(task.PreProcessing());
+  ASSERT_TRUE(task.Run());
+  ASSERT_TRUE(task.PostProcessing());
+  std::vector<double> expected = keys;
+  std::ranges::sort(expected);
+  EXPECT_EQ(task.GetOutput().keys, expected);
+}
+
+}  // namespace
+
+TEST(Sorting, TasksSortOnEveryBackend) {
+  RunSortTask<TypeOfTask::kSEQ, Algorithm::kShell, Merge::kSimple>();
+  RunSortTask<TypeOfTask::kOMP, Algorithm::kQuick, Merge::kBatcher>();
+  RunSortTask<TypeOfTask::kTBB, Algorithm::kRadix, Merge::kBitonic>();
+  RunSortTask<TypeOfTask::kSTL, Algorithm::kRadix, Merge::kSimple>();
+  RunSortTask<TypeOfTask::kOMP, Algorithm::kShell, Merge::kSample>();
+  RunSortTask<TypeOfTask::kTBB, Algorithm::kQuick, Merge::kOddEven>();
+  if (ppc::util::MpiReady()) {
+    RunSortTask<TypeOfTask::kMPI, Algorithm::kQuick, Merge::kBatcher>();
+    RunSortTask<TypeOfTask::kMPI, Algorithm::kRadix, Merge::kBitonic>();
+    RunSortTask<TypeOfTask::kMPI, Algorithm::kShell, Merge::kSimple>();
+    RunSortTask<TypeOfTask::kMPI, Algorithm::kRadix, Merge::kSample>();
+    RunSortTask<TypeOfTask::kMPI, Algorithm::kQuick, Merge::kOddEven>();
+  }
+}
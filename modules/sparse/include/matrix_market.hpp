@@ -0,0 +1,114 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <vector>
+
+#include "sparse/include/sparse.hpp"
+
+namespace ppc::sparse {
+
+/// @brief Read-only view of a whole file, memory-mapped where the platform has mmap and read into
+/// memory otherwise.
+class MappedFile {
+ public:
+  /// @throws std::runtime_error When the file cannot be opened or mapped.
+  explicit MappedFile(const std::string &path);
+  ~MappedFile();
+
+  MappedFile(const MappedFile &) = delete;
+  MappedFile &operator=(const MappedFile &) = delete;
+  MappedFile(MappedFile &&other) noexcept;
+  MappedFile &operator=(MappedFile &&other) noexcept;
+
+  [[nodiscard]] const char *Data() const {
+    return data_;
+  }
+  [[nodiscard]] std::size_t Size() const {
+    return size_;
+  }
+
+ private:
+  void Release() noexcept;
+
+  const char *data_ = nullptr;
+  std::size_t size_ = 0;
+  bool mapped_ = false;
+  std::vector<char> buffer_;
+};
+
+/// @brief Reads a Matrix Market coordinate file into a Crs.
+/// @details The header is read sequentially; the entry lines are split into byte ranges that are
+/// parsed in parallel on the @p backend. Symmetric, skew-symmetric and Hermitian files are expanded
+/// to both triangles, pattern files get unit values and duplicate entries are summed.
+/// @throws std::runtime_error When the file cannot be read, is not a coordinate matrix, or holds
+/// complex values and T is double.
+template <Element T>
+Crs<T> ReadMatrixMarket(const std::string &path, Backend backend = Backend::kSeq);
+
+/// @brief Writes @p matrix as a general coordinate Matrix Market file (real or complex by T).
+/// @throws std::runtime_error When the file cannot be written.
+template <Element T>
+void WriteMatrixMarket(const std::string &path, const Crs<T> &matrix);
+
+/// @brief Writes @p matrix in the binary cache format read by MappedCrs.
+/// @details The file is a 40-byte header (magic, element type, rows, cols, nnz) followed by
+/// row_ptr, col_indices and values as raw 8-byte aligned arrays. It is written to a temporary
+/// file and renamed, so concurrent readers never see a partial cache.
+/// @throws std::runtime_error When the file cannot be written.
+template <Element T>
+void WriteCrsCache(const std::string &path, const Crs<T> &matrix);
+
+/// @brief Crs stored in a binary cache file, mapped into memory without parsing.
+template <Element T>
+class MappedCrs {
+ public:
+  /// @throws std::runtime_error When the file is not a cache of T elements, is truncated or does
+  /// not hold a valid Crs.
+  explicit MappedCrs(const std::string &path);
+
+  [[nodiscard]] std::size_t Rows() const {
+    return rows_;
+  }
+  [[nodiscard]] std::size_t Cols() const {
+    return cols_;
+  }
+  [[nodiscard]] std::size_t Nnz() const {
+    return values_.size();
+  }
+  [[nodiscard]] std::span<const std::uint64_t> RowPtr() const {
+    return row_ptr_;
+  }
+  [[nodiscard]] std::span<const std::uint64_t> ColIndices() const {
+    return col_indices_;
+  }
+  [[nodiscard]] std::span<const T> Values() const {
+    return values_;
+  }
+  /// @brief Owning copy of the mapped arrays.
+  [[nodiscard]] Crs<T> ToCrs() const;
+
+ private:
+  MappedFile file_;
+  std::size_t rows_ = 0;
+  std::size_t cols_ = 0;
+  std::span<const std::uint64_t> row_ptr_;
+  std::span<const std::uint64_t> col_indices_;
+  std::span<const T> values_;
+};
+
+/// @brief Reads @p path through its binary cache @p path + ".double.crs" (".complex.crs" for complex T).
+/// @details A cache at least as new as the text file is mapped; otherwise the text is parsed with
+/// ReadMatrixMarket() and the cache is rewritten. A cache that cannot be written (read-only data
+/// directory) is skipped silently.
+template <Element T>
+Crs<T> LoadMatrixMarket(const std::string &path, Backend backend = Backend::kSeq);
+
+/// @brief LoadMatrixMarket() of file @p file_name in the data directory of task @p id_path, as
+/// resolved by ppc::util::GetAbsoluteTaskPath().
+template <Element T>
+Crs<T> LoadTaskMatrix(const std::string &id_path, const std::string &file_name, Backend backend = Backend::kSeq);
+
+}  // namespace ppc::sparse
@@ -0,0 +1,173 @@
+#pragma once
+
+#include <mpi.h>
+
+#include <complex>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "shared_memory/include/parallel_for.hpp"
+
+namespace ppc::sparse {
+
+using Backend = ppc::shared_memory::Backend;
+
+/// @brief Element types the sparse module is instantiated for.
+template <typename T>
+concept Element = std::same_as<T, double> || std::same_as<T, std::complex<double>>;
+
+/// @brief Compressed row storage of a rows x cols matrix.
+/// @details Row i holds the entries row_ptr[i] .. row_ptr[i + 1] - 1 of col_indices and values,
+/// with strictly increasing column indices.
+template <Element T>
+struct Crs {
+  std::size_t rows = 0;
+  std::size_t cols = 0;
+  std::vector<T> values;
+  std::vector<std::size_t> col_indices;
+  std::vector<std::size_t> row_ptr = {0};
+
+  [[nodiscard]] std::size_t Nnz() const {
+    return values.size();
+  }
+};
+
+/// @brief Compressed column storage of a rows x cols matrix: Crs of the transpose with the roles
+/// of rows and columns swapped.
+template <Element T>
+struct Ccs {
+  std::size_t rows = 0;
+  std::size_t cols = 0;
+  std::vector<T> values;
+  std::vector<std::size_t> row_indices;
+  std::vector<std::size_t> col_ptr = {0};
+
+  [[nodiscard]] std::size_t Nnz() const {
+    return values.size();
+  }
+};
+
+/// @brief One (row, col, value) entry of a coordinate list.
+template <Element T>
+struct Triplet {
+  std::size_t row = 0;
+  std::size_t col = 0;
+  T value{};
+};
+
+/// @brief Row accumulator of SpGEMM().
+enum class Accumulator : uint8_t {
+  /// kDense while the result has at most Tuning::dense_columns columns, kHash above
+  kAuto,
+  /// Array of the full row width per worker, indexed by column
+  kDense,
+  /// Open-addressing table per worker, sized by the row's upper bound of entries
+  kHash
+};
+
+/// @brief Returns the lower-case name of the accumulator ("auto", "dense", "hash").
+std::string AccumulatorToString(Accumulator accumulator);
+
+/// @brief Work split of the parallel kernels.
+struct Tuning {
+  /// Row blocks handed out per worker; more than one evens out power-law row lengths.
+  std::size_t blocks_per_worker = 8;
+  /// Widest result for which Accumulator::kAuto picks the dense accumulator.
+  std::size_t dense_columns = std::size_t{1} << 16;
+};
+
+/// @brief Returns the tuning shared by all kernels of this module.
+Tuning &GetTuning();
+
+/// @brief Checks the shape, bounds and column order of @p matrix.
+template <Element T>
+bool IsValid(const Crs<T> &matrix);
+template <Element T>
+bool IsValid(const Ccs<T> &matrix);
+
+/// @brief Builds a Crs from a coordinate list in any order; duplicate entries are summed.
+/// @throws std::invalid_argument When an entry lies outside rows x cols.
+template <Element T>
+Crs<T> FromTriplets(std::size_t rows, std::size_t cols, const std::vector<Triplet<T>> &triplets);
+
+/// @brief Crs of the non-zero entries of a row-major rows x cols matrix.
+/// @throws std::invalid_argument When dense.size() != rows * cols.
+template <Element T>
+Crs<T> FromDense(std::size_t rows, std::size_t cols, const std::vector<T> &dense);
+
+/// @brief Row-major dense copy of @p matrix.
+template <Element T>
+std::vector<T> ToDense(const Crs<T> &matrix);
+template <Element T>
+std::vector<T> ToDense(const Ccs<T> &matrix);
+
+/// @brief Converts between the storage orders by a counting sort over the minor index.
+template <Element T>
+Ccs<T> ToCcs(const Crs<T> &matrix);
+template <Element T>
+Crs<T> ToCrs(const Ccs<T> &matrix);
+
+/// @brief y = A * x for Crs A; rows are split into blocks over the @p backend.
+/// @throws std::invalid_argument When x.size() != a.cols.
+template <Element T>
+std::vector<T> SpMV(const Crs<T> &a, const std::vector<T> &x, Backend backend = Backend::kSeq);
+
+/// @brief y = A * x for Ccs A; every worker scatters its columns into a private y, then the
+/// partial vectors are summed by row blocks.
+/// @throws std::invalid_argument When x.size() != a.cols.
+template <Element T>
+std::vector<T> SpMV(const Ccs<T> &a, const std::vector<T> &x, Backend backend = Backend::kSeq);
+
+/// @brief C = A * B by Gustavson's row-wise algorithm.
+/// @details A symbolic pass counts the entries of every row of C, a prefix sum sizes C exactly and
+/// a numeric pass fills it in place with sorted columns, so nothing is reallocated. Both passes
+/// split the rows of A into Tuning::blocks_per_worker blocks per worker, each with its own accumulator.
+/// @throws std::invalid_argument When a.cols != b.rows.
+template <Element T>
+Crs<T> SpGEMM(const Crs<T> &a, const Crs<T> &b, Backend backend = Backend::kSeq,
+              Accumulator accumulator = Accumulator::kAuto);
+
+/// @brief C = A * B for Ccs operands, computed as the Crs product C^T = B^T * A^T on the same arrays.
+/// @throws std::invalid_argument When a.cols != b.rows.
+template <Element T>
+Ccs<T> SpGEMM(const Ccs<T> &a, const Ccs<T> &b, Backend backend = Backend::kSeq,
+              Accumulator accumulator = Accumulator::kAuto);
+
+/// @brief rows x cols R-MAT matrix with about edge_factor entries per row and values in [-1, 1].
+/// @details rows = cols = 2^scale; every entry descends into quadrants with probabilities
+/// 0.57/0.19/0.19/0.05, which gives the power-law row and column lengths of web and social graphs.
+Crs<double> RmatMatrix(unsigned scale, std::size_t edge_factor, std::uint64_t seed);
+
+/// @brief Rows [begin, end) of @p matrix as a strip with row_ptr starting at zero and global columns.
+/// @throws std::invalid_argument When the range does not fit the matrix.
+template <Element T>
+Crs<T> SliceRows(const Crs<T> &matrix, std::size_t begin, std::size_t end);
+
+/// @brief Sends block BlockRange(rows, size, rank) of the rows of @p global on @p root to every rank.
+/// @param global Read on @p root only.
+/// @return Local rows x global.cols strip with row_ptr starting at zero.
+/// @throws std::invalid_argument On every rank when the rows or nonzeros of @p global do not fit
+/// into MPI int counts.
+template <Element T>
+Crs<T> ScatterRows(const Crs<T> &global, int root, MPI_Comm comm);
+
+/// @brief Stacks the row strips of all ranks in rank order on @p root.
+/// @return The global matrix on @p root, an empty one elsewhere.
+template <Element T>
+Crs<T> GatherRows(const Crs<T> &local, int root, MPI_Comm comm);
+
+/// @brief Replaces @p matrix on every rank by the one on @p root.
+template <Element T>
+void Broadcast(Crs<T> &matrix, int root, MPI_Comm comm);
+
+/// @brief y = A * x for A distributed by rows; every rank gets the whole y.
+/// @param x Whole vector, present on every rank.
+/// @throws std::invalid_argument When x.size() != a_local.cols.
+template <Element T>
+std::vector<T> DistributedSpMV(const Crs<T> &a_local, const std::vector<T> &x, MPI_Comm comm,
+                               Backend backend = Backend::kSeq);
+
+}  // namespace ppc::sparse
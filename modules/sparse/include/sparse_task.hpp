@@ -0,0 +1,131 @@
+#pragma once
+
+#include <mpi.h>
+
+#include <vector>
+
+#include "shared_memory/include/parallel_for.hpp"
+#include "sparse/include/sparse.hpp"
+#include "task/include/task.hpp"
+
+namespace ppc::sparse {
+
+/// @brief Operands of y = A * x; every rank holds the whole input, as in the course tasks.
+template <Element T>
+struct SpMVProblem {
+  Crs<T> a;
+  std::vector<T> x;
+};
+
+/// @brief Operands of C = A * B; every rank holds the whole input, as in the course tasks.
+template <Element T>
+struct SpGEMMProblem {
+  Crs<T> a;
+  Crs<T> b;
+};
+
+/// @brief y = A * x as a course task on any back-end.
+/// @details The kMPI variant scatters the rows of A from rank 0 in PreProcessing and gathers y on
+/// every rank in Run.
+template <Element T, ppc::task::TypeOfTask kType>
+class SpMVTask : public ppc::task::Task<SpMVProblem<T>, std::vector<T>> {
+ public:
+  using InType = SpMVProblem<T>;
+  using OutType = std::vector<T>;
+
+  static constexpr ppc::task::TypeOfTask GetStaticTypeOfTask() {
+    return kType;
+  }
+
+  explicit SpMVTask(const InType &in) {
+    this->SetTypeOfTask(GetStaticTypeOfTask());
+    this->GetInput() = in;
+  }
+
+ private:
+  bool ValidationImpl() override {
+    const InType &in = this->GetInput();
+    return IsValid(in.a) && in.x.size() == in.a.cols;
+  }
+
+  bool PreProcessingImpl() override {
+    if constexpr (kType == ppc::task::TypeOfTask::kMPI) {
+      a_local_ = ScatterRows(this->GetInput().a, 0, MPI_COMM_WORLD);
+    }
+    return true;
+  }
+
+  bool RunImpl() override {
+    const InType &in = this->GetInput();
+    if constexpr (kType == ppc::task::TypeOfTask::kMPI) {
+      this->GetOutput() = DistributedSpMV(a_local_, in.x, MPI_COMM_WORLD);
+    } else {
+      this->GetOutput() = SpMV(in.a, in.x, ppc::shared_memory::BackendOf(kType));
+    }
+    return true;
+  }
+
+  bool PostProcessingImpl() override {
+    return this->GetOutput().size() == this->GetInput().a.rows;
+  }
+
+  Crs<T> a_local_;
+};
+
+/// @brief C = A * B as a course task on any back-end.
+/// @details The kMPI variant scatters the rows of A and broadcasts B from rank 0, multiplies its
+/// strip, then gathers C on rank 0 and broadcasts it to every rank.
+template <Element T, ppc::task::TypeOfTask kType, Accumulator kAccumulator = Accumulator::kAuto>
+class SpGEMMTask : public ppc::task::Task<SpGEMMProblem<T>, Crs<T>> {
+ public:
+  using InType = SpGEMMProblem<T>;
+  using OutType = Crs<T>;
+
+  static constexpr ppc::task::TypeOfTask GetStaticTypeOfTask() {
+    return kType;
+  }
+
+  explicit SpGEMMTask(const InType &in) {
+    this->SetTypeOfTask(GetStaticTypeOfTask());
+    this->GetInput() = in;
+  }
+
+ private:
+  bool ValidationImpl() override {
+    const InType &in = this->GetInput();
+    return IsValid(in.a) && IsValid(in.b) && in.a.cols == in.b.rows;
+  }
+
+  bool PreProcessingImpl() override {
+    if constexpr (kType == ppc::task::TypeOfTask::kMPI) {
+      a_local_ = ScatterRows(this->GetInput().a, 0, MPI_COMM_WORLD);
+      b_ = this->GetInput().b;
+      Broadcast(b_, 0, MPI_COMM_WORLD);
+    }
+    return true;
+  }
+
+  bool RunImpl() override {
+    const InType &in = this->GetInput();
+    if constexpr (kType == ppc::task::TypeOfTask::kMPI) {
+      c_local_ = SpGEMM(a_local_, b_, Backend::kSeq, kAccumulator);
+    } else {
+      this->GetOutput() = SpGEMM(in.a, in.b, ppc::shared_memory::BackendOf(kType), kAccumulator);
+    }
+    return true;
+  }
+
+  bool PostProcessingImpl() override {
+    if constexpr (kType == ppc::task::TypeOfTask::kMPI) {
+      this->GetOutput() = GatherRows(c_local_, 0, MPI_COMM_WORLD);
+      Broadcast(this->GetOutput(), 0, MPI_COMM_WORLD);
+    }
+    return this->GetOutput().rows == this->GetInput().a.rows;
+  }
+
+  Crs<T> a_local_;
+  Crs<T> b_;
+  Crs<T> c_local_;
+};
+
+}  // namespace ppc::sparse
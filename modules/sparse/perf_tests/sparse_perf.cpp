@@ -0,0 +1,215 @@
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <cstddef>
+#include <filesystem>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include "shared_memory/include/parallel_for.hpp"
+#include "sparse/include/matrix_market.hpp"
+#include "sparse/include/sparse.hpp"
+#include "sparse/include/sparse_task.hpp"
+#include "task/include/task.hpp"
+#include "util/include/perf_test_util.hpp"
+
+namespace ppc::sparse::perf {
+
+using ppc::task::TypeOfTask;
+
+namespace {
+
+// The R-MAT matrices are shared by the cases of a suite: generating one costs more than a run.
+
+/// 2^18 rows, about 4M entries: SpMV streams well beyond the last-level cache.
+const Crs<double> &SpMVMatrix() {
+  static const Crs<double> kMatrix = RmatMatrix(18, 16, 1);
+  return kMatrix;
+}
+
+/// 2^13 rows, about 60K entries; the hub rows of A * A are nearly dense.
+const Crs<double> &SpGEMMMatrix() {
+  static const Crs<double> kMatrix = RmatMatrix(13, 8, 2);
+  return kMatrix;
+}
+
+bool Close(const std::vector<double> &actual, const std::vector<double> &expected) {
+  if (actual.size() != expected.size()) {
+    return false;
+  }
+  for (std::size_t i = 0; i < actual.size(); i++) {
+    if (std::abs(actual[i] - expected[i]) > 1e-9 * (1.0 + std::abs(expected[i]))) {
+      return false;
+    }
+  }
+  return true;
+}
+
+}  // namespace
+
+class SpMVPerfTests : public ppc::util::BaseRunPerfTests<SpMVProblem<double>, std::vector<double>> {
+  SpMVProblem<double> input_data_;
+
+  void SetUp() override {
+    const Crs<double> &a = SpMVMatrix();
+    input_data_ = {.a = a, .x = std::vector<double>(a.cols)};
+    for (std::size_t j = 0; j < a.cols; j++) {
+      input_data_.x[j] = static_cast<double>(j % 7) - 3.0;
+    }
+  }
+
+  bool CheckTestOutputData(std::vector<double> &output_data) final {
+    PrintRate("gflop_per_s", 2e-9 * static_cast<double>(input_data_.a.Nnz()));
+    return Close(output_data, SpMV(input_data_.a, input_data_.x));
+  }
+
+  SpMVProblem<double> GetTestInputData() final {
+    return input_data_;
+  }
+};
+
+class SpGEMMPerfTests : public ppc::util::BaseRunPerfTests<SpGEMMProblem<double>, Crs<double>> {
+  SpGEMMProblem<double> input_data_;
+
+  void SetUp() override {
+    const Crs<double> &a = SpGEMMMatrix();
+    input_data_ = {.a = a, .b = a};
+  }
+
+  bool CheckTestOutputData(Crs<double> &output_data) final {
+    const Crs<double> &a = input_data_.a;
+    double flops = 0.0;
+    for (std::size_t e = 0; e < a.Nnz(); e++) {
+      const std::size_t k = a.col_indices[e];
+      flops += 2.0 * static_cast<double>(a.row_ptr[k + 1] - a.row_ptr[k]);
+    }
+    PrintRate("gflop_per_s", 1e-9 * flops);
+    if (!IsValid(output_data) || output_data.cols != a.cols) {
+      return false;
+    }
+    // (A * A) * x must equal A * (A * x).
+    const std::vector<double> x(a.cols, 1.0);
+    return Close(SpMV(output_data, x), SpMV(a, SpMV(a, x)));
+  }
+
+  SpGEMMProblem<double> GetTestInputData() final {
+    return input_data_;
+  }
+};
+
+/// Reads the Matrix Market file by parsing its text (kParse) or by mapping its binary cache.
+template <TypeOfTask kType, bool kParse>
+class LoadTask : public ppc::task::Task<std::string, Crs<double>> {
+ public:
+  static constexpr TypeOfTask GetStaticTypeOfTask() {
+    return kType;
+  }
+
+  explicit LoadTask(const std::string &in) {
+    SetTypeOfTask(GetStaticTypeOfTask());
+    GetInput() = in;
+  }
+
+ private:
+  bool ValidationImpl() override {
+    return std::filesystem::exists(GetInput());
+  }
+  bool PreProcessingImpl() override {
+    return true;
+  }
+  bool RunImpl() override {
+    if constexpr (kParse) {
+      GetOutput() = ReadMatrixMarket<double>(GetInput(), ppc::shared_memory::BackendOf(kType));
+    } else {
+      GetOutput() = MappedCrs<double>(GetInput() + ".double.crs").ToCrs();
+    }
+    return true;
+  }
+  bool PostProcessingImpl() override {
+    return IsValid(GetOutput());
+  }
+};
+
+/// Reads a Matrix Market copy of an R-MAT matrix with about 1M entries and its binary cache, written
+/// once per suite to the temporary directory and removed after it.
+class MatrixMarketPerfTests : public ppc::util::BaseRunPerfTests<std::string, Crs<double>> {
+ public:
+  static void SetUpTestSuite() {
+    const std::string name = "ppc_sparse_perf_" + std::to_string(ppc::util::GetMPIRank()) + ".mtx";
+    path_ = (std::filesystem::temp_directory_path() / name).string();
+    const Crs<double> matrix = RmatMatrix(16, 16, 3);
+    WriteMatrixMarket(path_, matrix);
+    WriteCrsCache(path_ + ".double.crs", matrix);
+  }
+
+  static void TearDownTestSuite() {
+    std::filesystem::remove(path_);
+    std::filesystem::remove(path_ + ".double.crs");
+  }
+
+ private:
+  static inline std::string path_;
+
+  bool CheckTestOutputData(Crs<double> &output_data) final {
+    PrintRate("mnnz_per_s", 1e-6 * static_cast<double>(output_data.Nnz()));
+    return output_data.rows == std::size_t{1} << 16U && output_data.Nnz() > 0;
+  }
+
+  std::string GetTestInputData() final {
+    return path_;
+  }
+};
+
+template <template <TypeOfTask> typename Task, typename InType>
+auto MakeBackendSuite(const std::string &kernel) {
+  return ppc::util::MakeBackendPerfTaskTuples<Task, InType>("ppc_sparse", kernel);
+}
+
+template <TypeOfTask kType>
+using SpMVDouble = SpMVTask<double, kType>;
+template <TypeOfTask kType>
+using SpGEMMDense = SpGEMMTask<double, kType, Accumulator::kDense>;
+template <TypeOfTask kType>
+using SpGEMMHash = SpGEMMTask<double, kType, Accumulator::kHash>;
+
+TEST_P(SpMVPerfTests, RunPerfModes) {
+  ExecuteTest(GetParam());
+}
+
+TEST_P(SpGEMMPerfTests, RunPerfModes) {
+  ExecuteTest(GetParam());
+}
+
+TEST_P(MatrixMarketPerfTests, RunPerfModes) {
+  ExecuteTest(GetParam());
+}
+
+const auto kSpMVPerfTasks = MakeBackendSuite<SpMVDouble, SpMVProblem<double>>("spmv");
+
+const auto kSpGEMMPerfTasks =
+    std::tuple_cat(MakeBackendSuite<SpGEMMDense, SpGEMMProblem<double>>("spgemm_dense"),
+                   MakeBackendSuite<SpGEMMHash, SpGEMMProblem<double>>("spgemm_hash"));
+
+const auto kMatrixMarketPerfTasks =
+    std::tuple_cat(ppc::util::MakeNamedPerfTaskTuples<LoadTask<TypeOfTask::kSEQ, true>, std::string>(
+                       "ppc_sparse_seq_mtx_parse"),
+                   ppc::util::MakeNamedPerfTaskTuples<LoadTask<TypeOfTask::kOMP, true>, std::string>(
+                       "ppc_sparse_omp_mtx_parse"),
+                   ppc::util::MakeNamedPerfTaskTuples<LoadTask<TypeOfTask::kTBB, true>, std::string>(
+                       "ppc_sparse_tbb_mtx_parse"),
+                   ppc::util::MakeNamedPerfTaskTuples<LoadTask<TypeOfTask::kSTL, true>, std::string>(
+                       "ppc_sparse_stl_mtx_parse"),
+                   ppc::util::MakeNamedPerfTaskTuples<LoadTask<TypeOfTask::kSEQ, false>, std::string>(
+                       "ppc_sparse_seq_crs_cache"));
+
+INSTANTIATE_TEST_SUITE_P(PowerLawSpMV, SpMVPerfTests, ppc::util::TupleToGTestValues(kSpMVPerfTasks),
+                         SpMVPerfTests::CustomPerfTestName);
+
+INSTANTIATE_TEST_SUITE_P(PowerLawSpGEMM, SpGEMMPerfTests, ppc::util::TupleToGTestValues(kSpGEMMPerfTasks),
+                         SpGEMMPerfTests::CustomPerfTestName);
+
+INSTANTIATE_TEST_SUITE_P(MatrixMarketLoad, MatrixMarketPerfTests, ppc::util::TupleToGTestValues(kMatrixMarketPerfTasks),
+                         MatrixMarketPerfTests::CustomPerfTestName);
+
+}  // namespace ppc::sparse::perf
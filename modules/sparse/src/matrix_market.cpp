@@ -0,0 +1,581 @@
+#include "sparse/include/matrix_market.hpp"
+
+#if __has_include(<sys/mman.h>)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define PPC_SPARSE_HAS_MMAP 1
+#endif
+
+#include <algorithm>
+#include <array>
+#include <cctype>
+#include <complex>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <ios>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "shared_memory/include/parallel_for.hpp"
+#include "shared_memory/include/shared_memory.hpp"
+#include "sparse/include/sparse.hpp"
+#include "util/include/util.hpp"
+
+namespace ppc::sparse {
+
+namespace {
+
+static_assert(sizeof(std::size_t) == sizeof(std::uint64_t), "the cache stores indices as 64-bit words");
+
+enum class Field : uint8_t { kReal, kInteger, kComplex, kPattern };
+enum class Symmetry : uint8_t { kGeneral, kSymmetric, kSkewSymmetric, kHermitian };
+
+/// Parsed banner and size line of a coordinate file.
+struct Header {
+  Field field = Field::kReal;
+  Symmetry symmetry = Symmetry::kGeneral;
+  std::size_t rows = 0;
+  std::size_t cols = 0;
+  std::size_t entries = 0;
+  /// Offset of the first entry line.
+  std::size_t body = 0;
+};
+
+/// Cache file header; the arrays follow it directly.
+struct CacheHeader {
+  std::array<char, 8> magic;
+  std::uint32_t element;
+  std::uint32_t reserved;
+  std::uint64_t rows;
+  std::uint64_t cols;
+  std::uint64_t nnz;
+};
+static_assert(sizeof(CacheHeader) == 40, "cache header must keep the arrays 8-byte aligned");
+
+constexpr std::array<char, 8> kCacheMagic = {'P', 'P', 'C', 'C', 'R', 'S', '0', '1'};
+
+template <Element T>
+constexpr std::uint32_t ElementCode() {
+  return std::is_same_v<T, double> ? 1U : 2U;
+}
+
+template <Element T>
+std::string CacheSuffix() {
+  return std::is_same_v<T, double> ? ".double.crs" : ".complex.crs";
+}
+
+/// Cursor over one byte range of the file.
+class Scanner {
+ public:
+  Scanner(const char *begin, const char *end) : pos_(begin), end_(end) {}
+
+  [[nodiscard]] bool AtEnd() const {
+    return pos_ >= end_;
+  }
+
+  void SkipBlanks() {
+    while (pos_ < end_ && (*pos_ == ' ' || *pos_ == '\t' || *pos_ == '\r')) {
+      pos_++;
+    }
+  }
+
+  void SkipLine() {
+    while (pos_ < end_ && *pos_ != '\n') {
+      pos_++;
+    }
+    if (pos_ < end_) {
+      pos_++;
+    }
+  }
+
+  /// True when the rest of the current line is blank or a comment.
+  bool LineIsEmpty() {
+    SkipBlanks();
+    return pos_ >= end_ || *pos_ == '\n' || *pos_ == '%';
+  }
+
+  std::string_view Token() {
+    SkipBlanks();
+    const char *start = pos_;
+    while (pos_ < end_ && std::isspace(static_cast<unsigned char>(*pos_)) == 0) {
+      pos_++;
+    }
+    return {start, static_cast<std::size_t>(pos_ - start)};
+  }
+
+  bool Index(std::size_t &value) {
+    const std::string_view token = Token();
+    if (token.empty()) {
+      return false;
+    }
+    value = 0;
+    for (const char c : token) {
+      if (c < '0' || c > '9') {
+        return false;
+      }
+      value = (value * 10) + static_cast<std::size_t>(c - '0');
+    }
+    return true;
+  }
+
+  bool Real(double &value) {
+    const std::string_view token = Token();
+    std::array<char, 64> buffer{};
+    if (token.empty() || token.size() >= buffer.size()) {
+      return false;
+    }
+    std::ranges::copy(token, buffer.begin());
+    char *parsed_end = nullptr;
+    value = std::strtod(buffer.data(), &parsed_end);
+    return parsed_end == buffer.data() + token.size();
+  }
+
+  [[nodiscard]] const char *Position() const {
+    return pos_;
+  }
+
+ private:
+  const char *pos_;
+  const char *end_;
+};
+
+std::string Lower(std::string_view text) {
+  std::string out(text);
+  for (auto &c : out) {
+    c = static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+  }
+  return out;
+}
+
+Header ParseHeader(const MappedFile &file, const std::string &path) {
+  Scanner scan(file.Data(), file.Data() + file.Size());
+  const auto fail = [&path](const std::string &what) {
+    return std::runtime_error("Matrix Market file " + path + ": " + what);
+  };
+  if (Lower(scan.Token()) != "%%matrixmarket" || Lower(scan.Token()) != "matrix") {
+    throw fail("missing %%MatrixMarket matrix banner");
+  }
+  if (Lower(scan.Token()) != "coordinate") {
+    throw fail("only the coordinate format is supported");
+  }
+  Header header;
+  const std::string field = Lower(scan.Token());
+  if (field == "real" || field == "double") {
+    header.field = Field::kReal;
+  } else if (field == "integer") {
+    header.field = Field::kInteger;
+  } else if (field == "complex") {
+    header.field = Field::kComplex;
+  } else if (field == "pattern") {
+    header.field = Field::kPattern;
+  } else {
+    throw fail("unknown field '" + field + "'");
+  }
+  const std::string symmetry = Lower(scan.Token());
+  if (symmetry == "general") {
+    header.symmetry = Symmetry::kGeneral;
+  } else if (symmetry == "symmetric") {
+    header.symmetry = Symmetry::kSymmetric;
+  } else if (symmetry == "skew-symmetric") {
+    header.symmetry = Symmetry::kSkewSymmetric;
+  } else if (symmetry == "hermitian") {
+    header.symmetry = Symmetry::kHermitian;
+  } else {
+    throw fail("unknown symmetry '" + symmetry + "'");
+  }
+  scan.SkipLine();
+  while (!scan.AtEnd() && scan.LineIsEmpty()) {
+    scan.SkipLine();
+  }
+  if (!scan.Index(header.rows) || !scan.Index(header.cols) || !scan.Index(header.entries)) {
+    throw fail("malformed size line");
+  }
+  scan.SkipLine();
+  header.body = static_cast<std::size_t>(scan.Position() - file.Data());
+  return header;
+}
+
+/// Entries of one byte range, already expanded by the symmetry of the file.
+template <Element T>
+struct Chunk {
+  std::vector<Triplet<T>> triplets;
+  std::size_t lines = 0;
+  std::string error;
+};
+
+template <Element T>
+void ParseChunk(const Header &header, const char *begin, const char *end, Chunk<T> &chunk) {
+  Scanner scan(begin, end);
+  while (!scan.AtEnd()) {
+    if (scan.LineIsEmpty()) {
+      scan.SkipLine();
+      continue;
+    }
+    std::size_t row = 0;
+    std::size_t col = 0;
+    double re = 1.0;
+    double im = 0.0;
+    bool ok = scan.Index(row) && scan.Index(col);
+    if (ok && header.field != Field::kPattern) {
+      ok = scan.Real(re) && (header.field != Field::kComplex || scan.Real(im));
+    }
+    if (!ok || row == 0 || col == 0 || row > header.rows || col > header.cols) {
+      chunk.error = "malformed or out-of-range entry";
+      return;
+    }
+    scan.SkipLine();
+    chunk.lines++;
+    T value{};
+    if constexpr (std::is_same_v<T, double>) {
+      value = re;
+    } else {
+      value = T(re, im);
+    }
+    chunk.triplets.push_back({.row = row - 1, .col = col - 1, .value = value});
+    if (header.symmetry == Symmetry::kGeneral || row == col) {
+      continue;
+    }
+    T mirrored = value;
+    if (header.symmetry == Symmetry::kSkewSymmetric) {
+      mirrored = -value;
+    } else if (header.symmetry == Symmetry::kHermitian) {
+      if constexpr (!std::is_same_v<T, double>) {
+        mirrored = std::conj(value);
+      }
+    }
+    chunk.triplets.push_back({.row = col - 1, .col = row - 1, .value = mirrored});
+  }
+}
+
+/// First line start at or after @p offset within the body.
+std::size_t AlignToLine(const MappedFile &file, std::size_t body, std::size_t offset) {
+  if (offset <= body) {
+    return body;
+  }
+  const char *data = file.Data();
+  while (offset < file.Size() && data[offset - 1] != '\n') {
+    offset++;
+  }
+  return offset;
+}
+
+/// Scatters the chunks into rows, then sorts every row and sums duplicate columns.
+template <Element T>
+Crs<T> AssembleRows(const Header &header, const std::vector<Chunk<T>> &chunks, Backend backend) {
+  Crs<T> out{.rows = header.rows,
+             .cols = header.cols,
+             .values = {},
+             .col_indices = {},
+             .row_ptr = std::vector<std::size_t>(header.rows + 1)};
+  for (const auto &chunk : chunks) {
+    for (const auto &t : chunk.triplets) {
+      out.row_ptr[t.row + 1]++;
+    }
+  }
+  for (std::size_t i = 0; i < header.rows; i++) {
+    out.row_ptr[i + 1] += out.row_ptr[i];
+  }
+  out.col_indices.resize(out.row_ptr.back());
+  out.values.resize(out.row_ptr.back());
+  std::vector<std::size_t> next(out.row_ptr.begin(), out.row_ptr.end() - 1);
+  for (const auto &chunk : chunks) {
+    for (const auto &t : chunk.triplets) {
+      const std::size_t pos = next[t.row]++;
+      out.col_indices[pos] = t.col;
+      out.values[pos] = t.value;
+    }
+  }
+
+  // next[i] becomes the end of row i after merging duplicates.
+  const int blocks = ppc::shared_memory::BackendWorkers(backend);
+  ppc::shared_memory::ParallelFor(static_cast<std::size_t>(blocks), backend, [&](std::size_t block) {
+    std::vector<std::pair<std::size_t, T>> row;
+    const auto [first, last] = ppc::shared_memory::BlockRange(header.rows, blocks, static_cast<int>(block));
+    for (std::size_t i = first; i < last; i++) {
+      const std::size_t begin = out.row_ptr[i];
+      row.clear();
+      for (std::size_t e = begin; e < out.row_ptr[i + 1]; e++) {
+        row.emplace_back(out.col_indices[e], out.values[e]);
+      }
+      std::ranges::sort(row, {}, &std::pair<std::size_t, T>::first);
+      std::size_t end = begin;
+      for (std::size_t p = 0; p < row.size(); p++) {
+        if (p > 0 && row[p].first == row[p - 1].first) {
+          out.values[end - 1] += row[p].second;
+          continue;
+        }
+        out.col_indices[end] = row[p].first;
+        out.values[end++] = row[p].second;
+      }
+      next[i] = end;
+    }
+  });
+
+  std::size_t write = 0;
+  for (std::size_t i = 0; i < header.rows; i++) {
+    const std::size_t begin = out.row_ptr[i];
+    out.row_ptr[i] = write;
+    for (std::size_t e = begin; e < next[i]; e++, write++) {
+      out.col_indices[write] = out.col_indices[e];
+      out.values[write] = out.values[e];
+    }
+  }
+  out.row_ptr[header.rows] = write;
+  out.col_indices.resize(write);
+  out.values.resize(write);
+  return out;
+}
+
+}  // namespace
+
+MappedFile::MappedFile(const std::string &path) {
+#ifdef PPC_SPARSE_HAS_MMAP
+  const int fd = open(path.c_str(), O_RDONLY);  // NOLINT(cppcoreguidelines-pro-type-vararg)
+  if (fd < 0) {
+    throw std::runtime_error("Failed to open " + path);
+  }
+  struct stat info{};
+  if (fstat(fd, &info) != 0) {
+    close(fd);
+    throw std::runtime_error("Failed to stat " + path);
+  }
+  size_ = static_cast<std::size_t>(info.st_size);
+  if (size_ > 0) {
+    void *address = mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (address == MAP_FAILED) {
+      close(fd);
+      throw std::runtime_error("Failed to map " + path);
+    }
+    data_ = static_cast<const char *>(address);
+    mapped_ = true;
+  }
+  close(fd);
+#else
+  std::ifstream in(path, std::ios::binary | std::ios::ate);
+  if (!in) {
+    throw std::runtime_error("Failed to open " + path);
+  }
+  buffer_.resize(static_cast<std::size_t>(in.tellg()));
+  in.seekg(0);
+  in.read(buffer_.data(), static_cast<std::streamsize>(buffer_.size()));
+  data_ = buffer_.data();
+  size_ = buffer_.size();
+#endif
+}
+
+MappedFile::~MappedFile() {
+  Release();
+}
+
+MappedFile::MappedFile(MappedFile &&other) noexcept
+    : data_(std::exchange(other.data_, nullptr)),
+      size_(std::exchange(other.size_, 0)),
+      mapped_(std::exchange(other.mapped_, false)),
+      buffer_(std::move(other.buffer_)) {}
+
+MappedFile &MappedFile::operator=(MappedFile &&other) noexcept {
+  if (this != &other) {
+    Release();
+    data_ = std::exchange(other.data_, nullptr);
+    size_ = std::exchange(other.size_, 0);
+    mapped_ = std::exchange(other.mapped_, false);
+    buffer_ = std::move(other.buffer_);
+  }
+  return *this;
+}
+
+void MappedFile::Release() noexcept {
+#ifdef PPC_SPARSE_HAS_MMAP
+  if (mapped_) {
+    munmap(const_cast<char *>(data_), size_);  // NOLINT(cppcoreguidelines-pro-type-const-cast)
+  }
+#endif
+  data_ = nullptr;
+  size_ = 0;
+  mapped_ = false;
+  buffer_.clear();
+}
+
+template <Element T>
+Crs<T> ReadMatrixMarket(const std::string &path, Backend backend) {
+  const MappedFile file(path);
+  const Header header = ParseHeader(file, path);
+  if constexpr (std::is_same_v<T, double>) {
+    if (header.field == Field::kComplex) {
+      throw std::runtime_error("Matrix Market file " + path + ": complex values cannot be read as double");
+    }
+  }
+  // A few chunks per worker keep the split even when line lengths vary.
+  const std::size_t body_size = file.Size() - header.body;
+  const std::size_t chunks =
+      backend == Backend::kSeq
+          ? 1
+          : std::clamp<std::size_t>(body_size >> 16U, 1, 4 * ppc::shared_memory::BackendWorkers(backend));
+  std::vector<std::size_t> bounds(chunks + 1);
+  for (std::size_t c = 0; c <= chunks; c++) {
+    bounds[c] = AlignToLine(file, header.body, header.body + (body_size * c / chunks));
+  }
+  std::vector<Chunk<T>> parsed(chunks);
+  ppc::shared_memory::ParallelFor(chunks, backend, [&](std::size_t c) {
+    parsed[c].triplets.reserve((header.entries / chunks) + 1);
+    ParseChunk(header, file.Data() + bounds[c], file.Data() + bounds[c + 1], parsed[c]);
+  });
+  std::size_t lines = 0;
+  for (const auto &chunk : parsed) {
+    if (!chunk.error.empty()) {
+      throw std::runtime_error("Matrix Market file " + path + ": " + chunk.error);
+    }
+    lines += chunk.lines;
+  }
+  if (lines != header.entries) {
+    throw std::runtime_error("Matrix Market file " + path + ": expected " + std::to_string(header.entries) +
+                             " entries, found " + std::to_string(lines));
+  }
+  return AssembleRows(header, parsed, backend);
+}
+
+template <Element T>
+void WriteMatrixMarket(const std::string &path, const Crs<T> &matrix) {
+  std::ofstream out(path);
+  if (!out) {
+    throw std::runtime_error("Failed to create " + path);
+  }
+  out << "%%MatrixMarket matrix coordinate " << (std::is_same_v<T, double> ? "real" : "complex") << " general\n"
+      << matrix.rows << ' ' << matrix.cols << ' ' << matrix.Nnz() << '\n'
+      << std::setprecision(17);
+  for (std::size_t i = 0; i < matrix.rows; i++) {
+    for (std::size_t e = matrix.row_ptr[i]; e < matrix.row_ptr[i + 1]; e++) {
+      out << (i + 1) << ' ' << (matrix.col_indices[e] + 1) << ' ';
+      if constexpr (std::is_same_v<T, double>) {
+        out << matrix.values[e] << '\n';
+      } else {
+        out << matrix.values[e].real() << ' ' << matrix.values[e].imag() << '\n';
+      }
+    }
+  }
+  if (!out) {
+    throw std::runtime_error("Failed to write " + path);
+  }
+}
+
+template <Element T>
+void WriteCrsCache(const std::string &path, const Crs<T> &matrix) {
+  const CacheHeader header{.magic = kCacheMagic,
+                           .element = ElementCode<T>(),
+                           .reserved = 0,
+                           .rows = matrix.rows,
+                           .cols = matrix.cols,
+                           .nnz = matrix.Nnz()};
+  ppc::util::WriteFileAtomically(path, {std::as_bytes(std::span(&header, 1)), std::as_bytes(std::span(matrix.row_ptr)),
+                                        std::as_bytes(std::span(matrix.col_indices)),
+                                        std::as_bytes(std::span(matrix.values))});
+}
+
+template <Element T>
+MappedCrs<T>::MappedCrs(const std::string &path) : file_(path) {
+  CacheHeader header{};
+  if (file_.Size() < sizeof(header)) {
+    throw std::runtime_error("CRS cache " + path + " is truncated");
+  }
+  std::memcpy(&header, file_.Data(), sizeof(header));
+  if (header.magic != kCacheMagic || header.element != ElementCode<T>()) {
+    throw std::runtime_error("CRS cache " + path + " has a different format or element type");
+  }
+  // Bounding the counts by the file size first keeps the size below from wrapping around.
+  const std::size_t payload = file_.Size() - sizeof(header);
+  if (header.rows >= payload / sizeof(std::uint64_t) || header.nnz > payload / (sizeof(std::uint64_t) + sizeof(T))) {
+    throw std::runtime_error("CRS cache " + path + " is truncated");
+  }
+  const std::size_t expected =
+      sizeof(header) + ((header.rows + 1 + header.nnz) * sizeof(std::uint64_t)) + (header.nnz * sizeof(T));
+  if (file_.Size() != expected) {
+    throw std::runtime_error("CRS cache " + path + " is truncated");
+  }
+  rows_ = header.rows;
+  cols_ = header.cols;
+  // The header is 40 bytes and every array a multiple of 8, so all three stay aligned.
+  const char *base = file_.Data() + sizeof(header);
+  row_ptr_ = {reinterpret_cast<const std::uint64_t *>(base), header.rows + 1};  // NOLINT(*-reinterpret-cast)
+  base += row_ptr_.size_bytes();
+  col_indices_ = {reinterpret_cast<const std::uint64_t *>(base), header.nnz};  // NOLINT(*-reinterpret-cast)
+  base += col_indices_.size_bytes();
+  values_ = {reinterpret_cast<const T *>(base), header.nnz};  // NOLINT(*-reinterpret-cast)
+  // The same structure IsValid() demands of a Crs, checked on the mapped arrays without a copy.
+  bool valid = row_ptr_.front() == 0 && row_ptr_.back() == header.nnz;
+  for (std::size_t i = 0; valid && i < rows_; i++) {
+    valid = row_ptr_[i] <= row_ptr_[i + 1];
+    for (std::uint64_t e = row_ptr_[i]; valid && e < row_ptr_[i + 1]; e++) {
+      valid = col_indices_[e] < cols_ && (e == row_ptr_[i] || col_indices_[e - 1] < col_indices_[e]);
+    }
+  }
+  if (!valid) {
+    throw std::runtime_error("CRS cache " + path + " is corrupt");
+  }
+}
+
+template <Element T>
+Crs<T> MappedCrs<T>::ToCrs() const {
+  return {.rows = rows_,
+          .cols = cols_,
+          .values = std::vector<T>(values_.begin(), values_.end()),
+          .col_indices = std::vector<std::size_t>(col_indices_.begin(), col_indices_.end()),
+          .row_ptr = std::vector<std::size_t>(row_ptr_.begin(), row_ptr_.end())};
+}
+
+template <Element T>
+Crs<T> LoadMatrixMarket(const std::string &path, Backend backend) {
+  const std::string cache = path + CacheSuffix<T>();
+  std::error_code error;
+  const auto text_time = std::filesystem::last_write_time(path, error);
+  if (error) {
+    throw std::runtime_error("Failed to open " + path);
+  }
+  const auto cache_time = std::filesystem::last_write_time(cache, error);
+  if (!error && cache_time >= text_time) {
+    try {
+      return MappedCrs<T>(cache).ToCrs();
+    } catch (const std::runtime_error &) {
+      // Foreign or truncated cache: rebuild it from the text below.
+    }
+  }
+  Crs<T> matrix = ReadMatrixMarket<T>(path, backend);
+  try {
+    WriteCrsCache(cache, matrix);
+  } catch (const std::runtime_error &) {
+    // Read-only data directory: every run parses the text.
+  }
+  return matrix;
+}
+
+template <Element T>
+Crs<T> LoadTaskMatrix(const std::string &id_path, const std::string &file_name, Backend backend) {
+  return LoadMatrixMarket<T>(ppc::util::GetAbsoluteTaskPath(id_path, file_name), backend);
+}
+
+#define PPC_SPARSE_INSTANTIATE(T)                                                      \
+  template Crs<T> ReadMatrixMarket<T>(const std::string &, Backend);                  \
+  template void WriteMatrixMarket<T>(const std::string &, const Crs<T> &);            \
+  template void WriteCrsCache<T>(const std::string &, const Crs<T> &);                \
+  template class MappedCrs<T>;                                                        \
+  template Crs<T> LoadMatrixMarket<T>(const std::string &, Backend);                  \
+  template Crs<T> LoadTaskMatrix<T>(const std::string &, const std::string &, Backend);
+
+PPC_SPARSE_INSTANTIATE(double)
+PPC_SPARSE_INSTANTIATE(std::complex<double>)
+
+#undef PPC_SPARSE_INSTANTIATE
+
+}  // namespace ppc::sparse
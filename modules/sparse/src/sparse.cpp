@@ -0,0 +1,682 @@
+#include "sparse/include/sparse.hpp"
+
+#include <mpi.h>
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <complex>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "distribution/include/distribution.hpp"
+#include "shared_memory/include/parallel_for.hpp"
+#include "shared_memory/include/shared_memory.hpp"
+
+namespace ppc::sparse {
+
+namespace {
+
+constexpr std::size_t kEmpty = std::numeric_limits<std::size_t>::max();
+
+/// Read-only Crs arrays; a Ccs is the same view of its transpose.
+template <Element T>
+struct CrsView {
+  std::size_t rows;
+  std::size_t cols;
+  const std::size_t *ptr;
+  const std::size_t *idx;
+  const T *val;
+};
+
+template <Element T>
+CrsView<T> View(const Crs<T> &m) {
+  return {.rows = m.rows, .cols = m.cols, .ptr = m.row_ptr.data(), .idx = m.col_indices.data(), .val = m.values.data()};
+}
+
+template <Element T>
+CrsView<T> TransposedView(const Ccs<T> &m) {
+  return {.rows = m.cols, .cols = m.rows, .ptr = m.col_ptr.data(), .idx = m.row_indices.data(), .val = m.values.data()};
+}
+
+template <Element T>
+bool CompressedValid(std::size_t major, std::size_t minor, const std::vector<std::size_t> &ptr,
+                     const std::vector<std::size_t> &idx, const std::vector<T> &values) {
+  if (ptr.size() != major + 1 || ptr.front() != 0 || ptr.back() != values.size() || idx.size() != values.size()) {
+    return false;
+  }
+  for (std::size_t i = 0; i < major; i++) {
+    if (ptr[i] > ptr[i + 1]) {
+      return false;
+    }
+    for (std::size_t e = ptr[i]; e < ptr[i + 1]; e++) {
+      if (idx[e] >= minor || (e > ptr[i] && idx[e - 1] >= idx[e])) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+/// Counting-sort transposition of compressed arrays (major x minor into minor x major).
+template <Element T>
+void Transpose(const CrsView<T> &in, std::vector<std::size_t> &ptr, std::vector<std::size_t> &idx,
+               std::vector<T> &values) {
+  const std::size_t nnz = in.ptr[in.rows];
+  ptr.assign(in.cols + 1, 0);
+  for (std::size_t e = 0; e < nnz; e++) {
+    ptr[in.idx[e] + 1]++;
+  }
+  for (std::size_t j = 0; j < in.cols; j++) {
+    ptr[j + 1] += ptr[j];
+  }
+  idx.resize(nnz);
+  values.resize(nnz);
+  std::vector<std::size_t> next(ptr.begin(), ptr.end() - 1);
+  // Major indices are visited in order, so every output row comes out sorted.
+  for (std::size_t i = 0; i < in.rows; i++) {
+    for (std::size_t e = in.ptr[i]; e < in.ptr[i + 1]; e++) {
+      const std::size_t pos = next[in.idx[e]]++;
+      idx[pos] = i;
+      values[pos] = in.val[e];
+    }
+  }
+}
+
+std::size_t BlockCount(std::size_t rows, Backend backend) {
+  if (backend == Backend::kSeq) {
+    return std::min<std::size_t>(rows, 1);
+  }
+  const auto workers = static_cast<std::size_t>(ppc::shared_memory::BackendWorkers(backend));
+  return std::min(rows, workers * std::max<std::size_t>(GetTuning().blocks_per_worker, 1));
+}
+
+/// Calls @p body(begin, end) for every row block of [0, rows) on the @p backend.
+template <typename Body>
+void ForEachRowBlock(std::size_t rows, Backend backend, const Body &body) {
+  const std::size_t blocks = BlockCount(rows, backend);
+  ppc::shared_memory::ParallelFor(blocks, backend, [&](std::size_t block) {
+    const auto [begin, end] = ppc::shared_memory::BlockRange(rows, static_cast<int>(blocks), static_cast<int>(block));
+    body(begin, end);
+  });
+}
+
+/// Per-worker SpGEMM state, reused across rows and calls.
+template <Element T>
+struct Workspace {
+  // Dense accumulator: one slot per column of C, kEmpty where the row has no entry.
+  std::vector<std::size_t> marker;
+  std::vector<T> dense;
+  std::vector<std::size_t> touched;
+  // Hash accumulator: power-of-two open-addressing table of column keys.
+  std::vector<std::size_t> keys;
+  std::vector<T> hashed;
+  std::vector<std::pair<std::size_t, T>> entries;
+
+  void PrepareDense(std::size_t cols) {
+    if (marker.size() < cols) {
+      marker.assign(cols, kEmpty);
+      dense.assign(cols, T{});
+    }
+    touched.clear();
+  }
+
+  /// Clears a table for @p bound distinct keys and returns its index mask.
+  std::size_t PrepareHash(std::size_t bound) {
+    const std::size_t size = std::bit_ceil(std::max<std::size_t>(2 * bound, 8));
+    if (keys.size() < size) {
+      keys.resize(size);
+      hashed.resize(size);
+    }
+    std::fill(keys.begin(), keys.begin() + static_cast<std::ptrdiff_t>(size), kEmpty);
+    return size - 1;
+  }
+};
+
+inline std::size_t Slot(std::size_t key, std::size_t mask) {
+  return ((key * std::size_t{0x9E3779B97F4A7C15ULL}) >> 17U) & mask;
+}
+
+/// Upper bound of the entries of row @p i of A * B.
+template <Element T>
+std::size_t RowBound(const CrsView<T> &a, const CrsView<T> &b, std::size_t i) {
+  std::size_t bound = 0;
+  for (std::size_t e = a.ptr[i]; e < a.ptr[i + 1]; e++) {
+    const std::size_t k = a.idx[e];
+    bound += b.ptr[k + 1] - b.ptr[k];
+  }
+  return std::min(bound, b.cols);
+}
+
+template <Element T>
+std::size_t SymbolicRow(const CrsView<T> &a, const CrsView<T> &b, std::size_t i, bool dense, Workspace<T> &ws) {
+  if (dense) {
+    ws.touched.clear();
+    for (std::size_t e = a.ptr[i]; e < a.ptr[i + 1]; e++) {
+      const std::size_t k = a.idx[e];
+      for (std::size_t f = b.ptr[k]; f < b.ptr[k + 1]; f++) {
+        const std::size_t j = b.idx[f];
+        if (ws.marker[j] == kEmpty) {
+          ws.marker[j] = 0;
+          ws.touched.push_back(j);
+        }
+      }
+    }
+    for (const std::size_t j : ws.touched) {
+      ws.marker[j] = kEmpty;
+    }
+    return ws.touched.size();
+  }
+  const std::size_t mask = ws.PrepareHash(RowBound(a, b, i));
+  std::size_t count = 0;
+  for (std::size_t e = a.ptr[i]; e < a.ptr[i + 1]; e++) {
+    const std::size_t k = a.idx[e];
+    for (std::size_t f = b.ptr[k]; f < b.ptr[k + 1]; f++) {
+      const std::size_t j = b.idx[f];
+      std::size_t s = Slot(j, mask);
+      while (ws.keys[s] != kEmpty && ws.keys[s] != j) {
+        s = (s + 1) & mask;
+      }
+      if (ws.keys[s] == kEmpty) {
+        ws.keys[s] = j;
+        count++;
+      }
+    }
+  }
+  return count;
+}
+
+/// Writes row @p i of A * B, sorted by column, to @p out_idx / @p out_val.
+template <Element T>
+void NumericRow(const CrsView<T> &a, const CrsView<T> &b, std::size_t i, bool dense, Workspace<T> &ws,
+                std::size_t *out_idx, T *out_val) {
+  if (dense) {
+    ws.touched.clear();
+    for (std::size_t e = a.ptr[i]; e < a.ptr[i + 1]; e++) {
+      const std::size_t k = a.idx[e];
+      const T a_ik = a.val[e];
+      for (std::size_t f = b.ptr[k]; f < b.ptr[k + 1]; f++) {
+        const std::size_t j = b.idx[f];
+        if (ws.marker[j] == kEmpty) {
+          ws.marker[j] = 0;
+          ws.dense[j] = a_ik * b.val[f];
+          ws.touched.push_back(j);
+        } else {
+          ws.dense[j] += a_ik * b.val[f];
+        }
+      }
+    }
+    // Rows covering a large share of the columns are cheaper to collect by a scan than by a sort.
+    if (ws.touched.size() * 16 >= b.cols) {
+      std::size_t p = 0;
+      for (std::size_t j = 0; j < b.cols; j++) {
+        if (ws.marker[j] != kEmpty) {
+          out_idx[p] = j;
+          out_val[p++] = ws.dense[j];
+          ws.marker[j] = kEmpty;
+        }
+      }
+      return;
+    }
+    std::ranges::sort(ws.touched);
+    for (std::size_t p = 0; p < ws.touched.size(); p++) {
+      const std::size_t j = ws.touched[p];
+      out_idx[p] = j;
+      out_val[p] = ws.dense[j];
+      ws.marker[j] = kEmpty;
+    }
+    return;
+  }
+  const std::size_t mask = ws.PrepareHash(RowBound(a, b, i));
+  ws.entries.clear();
+  for (std::size_t e = a.ptr[i]; e < a.ptr[i + 1]; e++) {
+    const std::size_t k = a.idx[e];
+    const T a_ik = a.val[e];
+    for (std::size_t f = b.ptr[k]; f < b.ptr[k + 1]; f++) {
+      const std::size_t j = b.idx[f];
+      std::size_t s = Slot(j, mask);
+      while (ws.keys[s] != kEmpty && ws.keys[s] != j) {
+        s = (s + 1) & mask;
+      }
+      if (ws.keys[s] == kEmpty) {
+        ws.keys[s] = j;
+        ws.hashed[s] = a_ik * b.val[f];
+      } else {
+        ws.hashed[s] += a_ik * b.val[f];
+      }
+    }
+  }
+  for (std::size_t s = 0; s <= mask; s++) {
+    if (ws.keys[s] != kEmpty) {
+      ws.entries.emplace_back(ws.keys[s], ws.hashed[s]);
+    }
+  }
+  std::ranges::sort(ws.entries, {}, &std::pair<std::size_t, T>::first);
+  for (std::size_t p = 0; p < ws.entries.size(); p++) {
+    out_idx[p] = ws.entries[p].first;
+    out_val[p] = ws.entries[p].second;
+  }
+}
+
+template <Element T>
+void Gustavson(const CrsView<T> &a, const CrsView<T> &b, Backend backend, Accumulator accumulator,
+               std::vector<std::size_t> &ptr, std::vector<std::size_t> &idx, std::vector<T> &values) {
+  const bool dense = accumulator == Accumulator::kDense ||
+                     (accumulator == Accumulator::kAuto && b.cols <= GetTuning().dense_columns);
+  ptr.assign(a.rows + 1, 0);
+  ForEachRowBlock(a.rows, backend, [&](std::size_t begin, std::size_t end) {
+    thread_local Workspace<T> ws;
+    if (dense) {
+      ws.PrepareDense(b.cols);
+    }
+    for (std::size_t i = begin; i < end; i++) {
+      ptr[i + 1] = SymbolicRow(a, b, i, dense, ws);
+    }
+  });
+  for (std::size_t i = 0; i < a.rows; i++) {
+    ptr[i + 1] += ptr[i];
+  }
+  idx.resize(ptr.back());
+  values.resize(ptr.back());
+  ForEachRowBlock(a.rows, backend, [&](std::size_t begin, std::size_t end) {
+    thread_local Workspace<T> ws;
+    if (dense) {
+      ws.PrepareDense(b.cols);
+    }
+    for (std::size_t i = begin; i < end; i++) {
+      NumericRow(a, b, i, dense, ws, idx.data() + ptr[i], values.data() + ptr[i]);
+    }
+  });
+}
+
+int CheckedCount(std::size_t count) {
+  if (count > static_cast<std::size_t>(std::numeric_limits<int>::max())) {
+    throw std::invalid_argument("sparse: count does not fit into an MPI int");
+  }
+  return static_cast<int>(count);
+}
+
+/// Exclusive prefix sums of @p counts.
+std::vector<int> Displacements(const std::vector<int> &counts) {
+  std::vector<int> displs(counts.size(), 0);
+  for (std::size_t r = 1; r < counts.size(); r++) {
+    displs[r] = displs[r - 1] + counts[r - 1];
+  }
+  return displs;
+}
+
+}  // namespace
+
+std::string AccumulatorToString(Accumulator accumulator) {
+  switch (accumulator) {
+    case Accumulator::kAuto:
+      return "auto";
+    case Accumulator::kDense:
+      return "dense";
+    case Accumulator::kHash:
+      return "hash";
+  }
+  return "unknown";
+}
+
+Tuning &GetTuning() {
+  static Tuning tuning;
+  return tuning;
+}
+
+template <Element T>
+bool IsValid(const Crs<T> &matrix) {
+  return CompressedValid(matrix.rows, matrix.cols, matrix.row_ptr, matrix.col_indices, matrix.values);
+}
+
+template <Element T>
+bool IsValid(const Ccs<T> &matrix) {
+  return CompressedValid(matrix.cols, matrix.rows, matrix.col_ptr, matrix.row_indices, matrix.values);
+}
+
+template <Element T>
+Crs<T> FromTriplets(std::size_t rows, std::size_t cols, const std::vector<Triplet<T>> &triplets) {
+  std::vector<Triplet<T>> sorted = triplets;
+  for (const auto &t : sorted) {
+    if (t.row >= rows || t.col >= cols) {
+      throw std::invalid_argument("sparse: triplet outside the matrix");
+    }
+  }
+  std::ranges::sort(sorted, [](const Triplet<T> &l, const Triplet<T> &r) {
+    return l.row != r.row ? l.row < r.row : l.col < r.col;
+  });
+  Crs<T> out{
+      .rows = rows, .cols = cols, .values = {}, .col_indices = {}, .row_ptr = std::vector<std::size_t>(rows + 1)};
+  for (std::size_t e = 0; e < sorted.size(); e++) {
+    if (e > 0 && sorted[e].row == sorted[e - 1].row && sorted[e].col == sorted[e - 1].col) {
+      out.values.back() += sorted[e].value;
+      continue;
+    }
+    out.col_indices.push_back(sorted[e].col);
+    out.values.push_back(sorted[e].value);
+    out.row_ptr[sorted[e].row + 1]++;
+  }
+  for (std::size_t i = 0; i < rows; i++) {
+    out.row_ptr[i + 1] += out.row_ptr[i];
+  }
+  return out;
+}
+
+template <Element T>
+Crs<T> FromDense(std::size_t rows, std::size_t cols, const std::vector<T> &dense) {
+  if (dense.size() != rows * cols) {
+    throw std::invalid_argument("sparse: dense matrix size does not match its shape");
+  }
+  Crs<T> out{
+      .rows = rows, .cols = cols, .values = {}, .col_indices = {}, .row_ptr = std::vector<std::size_t>(rows + 1)};
+  for (std::size_t i = 0; i < rows; i++) {
+    for (std::size_t j = 0; j < cols; j++) {
+      if (dense[(i * cols) + j] != T{}) {
+        out.col_indices.push_back(j);
+        out.values.push_back(dense[(i * cols) + j]);
+      }
+    }
+    out.row_ptr[i + 1] = out.values.size();
+  }
+  return out;
+}
+
+template <Element T>
+std::vector<T> ToDense(const Crs<T> &matrix) {
+  std::vector<T> dense(matrix.rows * matrix.cols);
+  for (std::size_t i = 0; i < matrix.rows; i++) {
+    for (std::size_t e = matrix.row_ptr[i]; e < matrix.row_ptr[i + 1]; e++) {
+      dense[(i * matrix.cols) + matrix.col_indices[e]] = matrix.values[e];
+    }
+  }
+  return dense;
+}
+
+template <Element T>
+std::vector<T> ToDense(const Ccs<T> &matrix) {
+  std::vector<T> dense(matrix.rows * matrix.cols);
+  for (std::size_t j = 0; j < matrix.cols; j++) {
+    for (std::size_t e = matrix.col_ptr[j]; e < matrix.col_ptr[j + 1]; e++) {
+      dense[(matrix.row_indices[e] * matrix.cols) + j] = matrix.values[e];
+    }
+  }
+  return dense;
+}
+
+template <Element T>
+Ccs<T> ToCcs(const Crs<T> &matrix) {
+  Ccs<T> out{.rows = matrix.rows, .cols = matrix.cols, .values = {}, .row_indices = {}, .col_ptr = {}};
+  Transpose(View(matrix), out.col_ptr, out.row_indices, out.values);
+  return out;
+}
+
+template <Element T>
+Crs<T> ToCrs(const Ccs<T> &matrix) {
+  Crs<T> out{.rows = matrix.rows, .cols = matrix.cols, .values = {}, .col_indices = {}, .row_ptr = {}};
+  Transpose(TransposedView(matrix), out.row_ptr, out.col_indices, out.values);
+  return out;
+}
+
+template <Element T>
+std::vector<T> SpMV(const Crs<T> &a, const std::vector<T> &x, Backend backend) {
+  if (x.size() != a.cols) {
+    throw std::invalid_argument("sparse: x does not match the columns of A");
+  }
+  std::vector<T> y(a.rows);
+  ForEachRowBlock(a.rows, backend, [&](std::size_t begin, std::size_t end) {
+    for (std::size_t i = begin; i < end; i++) {
+      T sum{};
+      for (std::size_t e = a.row_ptr[i]; e < a.row_ptr[i + 1]; e++) {
+        sum += a.values[e] * x[a.col_indices[e]];
+      }
+      y[i] = sum;
+    }
+  });
+  return y;
+}
+
+template <Element T>
+std::vector<T> SpMV(const Ccs<T> &a, const std::vector<T> &x, Backend backend) {
+  if (x.size() != a.cols) {
+    throw std::invalid_argument("sparse: x does not match the columns of A");
+  }
+  const std::size_t parts = std::min<std::size_t>(a.cols, ppc::shared_memory::BackendWorkers(backend));
+  std::vector<std::vector<T>> partial(std::max<std::size_t>(parts, 1), std::vector<T>(a.rows));
+  ppc::shared_memory::ParallelFor(parts, backend, [&](std::size_t part) {
+    const auto [begin, end] = ppc::shared_memory::BlockRange(a.cols, static_cast<int>(parts), static_cast<int>(part));
+    std::vector<T> &y = partial[part];
+    for (std::size_t j = begin; j < end; j++) {
+      const T x_j = x[j];
+      for (std::size_t e = a.col_ptr[j]; e < a.col_ptr[j + 1]; e++) {
+        y[a.row_indices[e]] += a.values[e] * x_j;
+      }
+    }
+  });
+  std::vector<T> y = std::move(partial.front());
+  if (parts > 1) {
+    ForEachRowBlock(a.rows, backend, [&](std::size_t begin, std::size_t end) {
+      for (std::size_t part = 1; part < parts; part++) {
+        for (std::size_t i = begin; i < end; i++) {
+          y[i] += partial[part][i];
+        }
+      }
+    });
+  }
+  return y;
+}
+
+template <Element T>
+Crs<T> SpGEMM(const Crs<T> &a, const Crs<T> &b, Backend backend, Accumulator accumulator) {
+  if (a.cols != b.rows) {
+    throw std::invalid_argument("sparse: inner dimensions of A and B differ");
+  }
+  Crs<T> c{.rows = a.rows, .cols = b.cols, .values = {}, .col_indices = {}, .row_ptr = {}};
+  Gustavson(View(a), View(b), backend, accumulator, c.row_ptr, c.col_indices, c.values);
+  return c;
+}
+
+template <Element T>
+Ccs<T> SpGEMM(const Ccs<T> &a, const Ccs<T> &b, Backend backend, Accumulator accumulator) {
+  if (a.cols != b.rows) {
+    throw std::invalid_argument("sparse: inner dimensions of A and B differ");
+  }
+  Ccs<T> c{.rows = a.rows, .cols = b.cols, .values = {}, .row_indices = {}, .col_ptr = {}};
+  Gustavson(TransposedView(b), TransposedView(a), backend, accumulator, c.col_ptr, c.row_indices, c.values);
+  return c;
+}
+
+Crs<double> RmatMatrix(unsigned scale, std::size_t edge_factor, std::uint64_t seed) {
+  const std::size_t n = std::size_t{1} << scale;
+  std::mt19937_64 gen(seed);
+  std::uniform_real_distribution<double> unit(0.0, 1.0);
+  std::uniform_real_distribution<double> value(-1.0, 1.0);
+  std::vector<Triplet<double>> triplets(n * edge_factor);
+  for (auto &t : triplets) {
+    std::size_t row = 0;
+    std::size_t col = 0;
+    for (unsigned level = 0; level < scale; level++) {
+      const double p = unit(gen);
+      row = (row << 1U) | static_cast<std::size_t>(p >= 0.76);
+      col = (col << 1U) | static_cast<std::size_t>((p >= 0.57 && p < 0.76) || p >= 0.95);
+    }
+    t = {.row = row, .col = col, .value = value(gen)};
+  }
+  return FromTriplets(n, n, triplets);
+}
+
+template <Element T>
+Crs<T> SliceRows(const Crs<T> &matrix, std::size_t begin, std::size_t end) {
+  if (begin > end || end > matrix.rows || matrix.row_ptr.size() != matrix.rows + 1) {
+    throw std::invalid_argument("SliceRows: row range does not fit the matrix");
+  }
+  const auto first = static_cast<std::ptrdiff_t>(matrix.row_ptr[begin]);
+  const auto last = static_cast<std::ptrdiff_t>(matrix.row_ptr[end]);
+  Crs<T> strip{.rows = end - begin,
+               .cols = matrix.cols,
+               .values = {matrix.values.begin() + first, matrix.values.begin() + last},
+               .col_indices = {matrix.col_indices.begin() + first, matrix.col_indices.begin() + last},
+               .row_ptr = {}};
+  strip.row_ptr.reserve(end - begin + 1);
+  for (std::size_t i = begin; i <= end; i++) {
+    strip.row_ptr.push_back(matrix.row_ptr[i] - matrix.row_ptr[begin]);
+  }
+  return strip;
+}
+
+template <Element T>
+Crs<T> ScatterRows(const Crs<T> &global, int root, MPI_Comm comm) {
+  int rank = 0;
+  int size = 1;
+  MPI_Comm_rank(comm, &rank);
+  MPI_Comm_size(comm, &size);
+  std::array<std::uint64_t, 3> shape = {global.rows, global.cols, global.Nnz()};
+  MPI_Bcast(shape.data(), 3, MPI_UINT64_T, root, comm);
+  // Every count and displacement below is at most rows + 1 or nnz; checking both on every rank makes
+  // all of them throw together instead of leaving the others waiting in MPI_Scatter.
+  CheckedCount(shape[0] + 1);
+  CheckedCount(shape[2]);
+  const auto [first, last] = ppc::shared_memory::BlockRange(shape[0], size, rank);
+
+  std::vector<int> ptr_counts(static_cast<std::size_t>(size));
+  std::vector<int> ptr_displs(static_cast<std::size_t>(size));
+  std::vector<int> nnz_counts(static_cast<std::size_t>(size));
+  std::vector<int> nnz_displs(static_cast<std::size_t>(size));
+  if (rank == root) {
+    for (int r = 0; r < size; r++) {
+      const auto [begin, end] = ppc::shared_memory::BlockRange(shape[0], size, r);
+      const auto part = static_cast<std::size_t>(r);
+      // Neighbouring strips share their boundary entry of row_ptr; overlapping sends are allowed.
+      ptr_counts[part] = CheckedCount(end - begin + 1);
+      ptr_displs[part] = CheckedCount(begin);
+      nnz_counts[part] = CheckedCount(global.row_ptr[end] - global.row_ptr[begin]);
+      nnz_displs[part] = CheckedCount(global.row_ptr[begin]);
+    }
+  }
+  int nnz = 0;
+  MPI_Scatter(nnz_counts.data(), 1, MPI_INT, &nnz, 1, MPI_INT, root, comm);
+
+  Crs<T> local{.rows = last - first,
+               .cols = shape[1],
+               .values = std::vector<T>(static_cast<std::size_t>(nnz)),
+               .col_indices = std::vector<std::size_t>(static_cast<std::size_t>(nnz)),
+               .row_ptr = std::vector<std::size_t>(last - first + 1)};
+  const auto datatype = ppc::distribution::DatatypeOf<std::uint64_t>();
+  MPI_Scatterv(global.row_ptr.data(), ptr_counts.data(), ptr_displs.data(), datatype, local.row_ptr.data(),
+               CheckedCount(local.row_ptr.size()), datatype, root, comm);
+  MPI_Scatterv(global.col_indices.data(), nnz_counts.data(), nnz_displs.data(), datatype, local.col_indices.data(),
+               nnz, datatype, root, comm);
+  MPI_Scatterv(global.values.data(), nnz_counts.data(), nnz_displs.data(), ppc::distribution::DatatypeOf<T>(),
+               local.values.data(), nnz, ppc::distribution::DatatypeOf<T>(), root, comm);
+  const std::size_t base = local.row_ptr.front();
+  for (auto &offset : local.row_ptr) {
+    offset -= base;
+  }
+  return local;
+}
+
+template <Element T>
+Crs<T> GatherRows(const Crs<T> &local, int root, MPI_Comm comm) {
+  int rank = 0;
+  int size = 1;
+  MPI_Comm_rank(comm, &rank);
+  MPI_Comm_size(comm, &size);
+  const int local_rows = CheckedCount(local.rows);
+  const int local_nnz = CheckedCount(local.Nnz());
+  std::vector<int> row_counts(static_cast<std::size_t>(size));
+  std::vector<int> nnz_counts(static_cast<std::size_t>(size));
+  MPI_Gather(&local_rows, 1, MPI_INT, row_counts.data(), 1, MPI_INT, root, comm);
+  MPI_Gather(&local_nnz, 1, MPI_INT, nnz_counts.data(), 1, MPI_INT, root, comm);
+
+  Crs<T> global{.rows = 0, .cols = local.cols, .values = {}, .col_indices = {}, .row_ptr = {0}};
+  const std::vector<int> row_displs = Displacements(row_counts);
+  const std::vector<int> nnz_displs = Displacements(nnz_counts);
+  if (rank == root) {
+    global.rows = static_cast<std::size_t>(row_displs.back() + row_counts.back());
+    const auto nnz = static_cast<std::size_t>(nnz_displs.back() + nnz_counts.back());
+    global.row_ptr.resize(global.rows + 1);
+    global.col_indices.resize(nnz);
+    global.values.resize(nnz);
+  }
+  const auto datatype = ppc::distribution::DatatypeOf<std::uint64_t>();
+  // Row ends of every strip land after the leading zero; each strip is rebased below.
+  MPI_Gatherv(local.row_ptr.data() + 1, local_rows, datatype, rank == root ? global.row_ptr.data() + 1 : nullptr,
+              row_counts.data(), row_displs.data(), datatype, root, comm);
+  MPI_Gatherv(local.col_indices.data(), local_nnz, datatype, global.col_indices.data(), nnz_counts.data(),
+              nnz_displs.data(), datatype, root, comm);
+  MPI_Gatherv(local.values.data(), local_nnz, ppc::distribution::DatatypeOf<T>(), global.values.data(),
+              nnz_counts.data(), nnz_displs.data(), ppc::distribution::DatatypeOf<T>(), root, comm);
+  if (rank != root) {
+    return {};
+  }
+  for (int r = 0; r < size; r++) {
+    const auto part = static_cast<std::size_t>(r);
+    const auto begin = static_cast<std::size_t>(row_displs[part]);
+    const auto base = static_cast<std::size_t>(nnz_displs[part]);
+    for (std::size_t i = begin; i < begin + static_cast<std::size_t>(row_counts[part]); i++) {
+      global.row_ptr[i + 1] += base;
+    }
+  }
+  return global;
+}
+
+template <Element T>
+void Broadcast(Crs<T> &matrix, int root, MPI_Comm comm) {
+  std::array<std::uint64_t, 3> shape = {matrix.rows, matrix.cols, matrix.Nnz()};
+  MPI_Bcast(shape.data(), 3, MPI_UINT64_T, root, comm);
+  matrix.rows = shape[0];
+  matrix.cols = shape[1];
+  matrix.row_ptr.resize(shape[0] + 1);
+  matrix.col_indices.resize(shape[2]);
+  matrix.values.resize(shape[2]);
+  const auto datatype = ppc::distribution::DatatypeOf<std::uint64_t>();
+  MPI_Bcast(matrix.row_ptr.data(), CheckedCount(matrix.row_ptr.size()), datatype, root, comm);
+  MPI_Bcast(matrix.col_indices.data(), CheckedCount(shape[2]), datatype, root, comm);
+  MPI_Bcast(matrix.values.data(), CheckedCount(shape[2]), ppc::distribution::DatatypeOf<T>(), root, comm);
+}
+
+template <Element T>
+std::vector<T> DistributedSpMV(const Crs<T> &a_local, const std::vector<T> &x, MPI_Comm comm, Backend backend) {
+  int size = 1;
+  MPI_Comm_size(comm, &size);
+  const std::vector<T> y_local = SpMV(a_local, x, backend);
+  const int local_rows = CheckedCount(y_local.size());
+  std::vector<int> counts(static_cast<std::size_t>(size));
+  MPI_Allgather(&local_rows, 1, MPI_INT, counts.data(), 1, MPI_INT, comm);
+  const std::vector<int> displs = Displacements(counts);
+  std::vector<T> y(static_cast<std::size_t>(displs.back() + counts.back()));
+  MPI_Allgatherv(y_local.data(), local_rows, ppc::distribution::DatatypeOf<T>(), y.data(), counts.data(),
+                 displs.data(), ppc::distribution::DatatypeOf<T>(), comm);
+  return y;
+}
+
+#define PPC_SPARSE_INSTANTIATE(T)                                                                        \
+  template bool IsValid<T>(const Crs<T> &);                                                             \
+  template bool IsValid<T>(const Ccs<T> &);                                                             \
+  template Crs<T> FromTriplets<T>(std::size_t, std::size_t, const std::vector<Triplet<T>> &);           \
+  template Crs<T> FromDense<T>(std::size_t, std::size_t, const std::vector<T> &);                       \
+  template std::vector<T> ToDense<T>(const Crs<T> &);                                                   \
+  template std::vector<T> ToDense<T>(const Ccs<T> &);                                                   \
+  template Ccs<T> ToCcs<T>(const Crs<T> &);                                                             \
+  template Crs<T> ToCrs<T>(const Ccs<T> &);                                                             \
+  template std::vector<T> SpMV<T>(const Crs<T> &, const std::vector<T> &, Backend);                     \
+  template std::vector<T> SpMV<T>(const Ccs<T> &, const std::vector<T> &, Backend);                     \
+  template Crs<T> SpGEMM<T>(const Crs<T> &, const Crs<T> &, Backend, Accumulator);                      \
+  template Ccs<T> SpGEMM<T>(const Ccs<T> &, const Ccs<T> &, Backend, Accumulator);                      \
+  template Crs<T> SliceRows<T>(const Crs<T> &, std::size_t, std::size_t);                               \
+  template Crs<T> ScatterRows<T>(const Crs<T> &, int, MPI_Comm);                                        \
+  template Crs<T> GatherRows<T>(const Crs<T> &, int, MPI_Comm);                                         \
+  template void Broadcast<T>(Crs<T> &, int, MPI_Comm);                                                  \
+  template std::vector<T> DistributedSpMV<T>(const Crs<T> &, const std::vector<T> &, MPI_Comm, Backend);
+
+PPC_SPARSE_INSTANTIATE(double)
+PPC_SPARSE_INSTANTIATE(std::complex<double>)
+
+#undef PPC_SPARSE_INSTANTIATE
+
+}  // namespace ppc::sparse
@@ -0,0 +1,292 @@
+#include <gtest/gtest.h>
+#include <mpi.h>
+
+#include <algorithm>
+#include <array>
+#include <complex>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <ios>
+#include <limits>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "shared_memory/include/parallel_for.hpp"
+#include "sparse/include/matrix_market.hpp"
+#include "sparse/include/sparse.hpp"
+#include "sparse/include/sparse_task.hpp"
+#include "task/include/task.hpp"
+#include "util/include/func_test_util.hpp"
+
+using ppc::sparse::Accumulator;
+using ppc::sparse::Backend;
+using ppc::sparse::Ccs;
+using ppc::sparse::Crs;
+using ppc::task::TypeOfTask;
+using Complex = std::complex<double>;
+
+namespace {
+
+constexpr std::array<Backend, 4> kAllBackends = {Backend::kSeq, Backend::kOmp, Backend::kTbb, Backend::kStl};
+
+/// Row-major rows x cols matrix with about @p density of its entries non-zero.
+template <typename T>
+std::vector<T> RandomDense(std::size_t rows, std::size_t cols, double density, unsigned seed) {
+  std::mt19937_64 gen(seed);
+  std::uniform_real_distribution<double> unit(0.0, 1.0);
+  std::uniform_real_distribution<double> value(-1.0, 1.0);
+  std::vector<T> dense(rows * cols);
+  for (auto &entry : dense) {
+    if (unit(gen) < density) {
+      if constexpr (std::is_same_v<T, Complex>) {
+        entry = Complex(value(gen), value(gen));
+      } else {
+        entry = value(gen);
+      }
+    }
+  }
+  return dense;
+}
+
+template <typename T>
+std::vector<T> DenseMultiply(const std::vector<T> &a, const std::vector<T> &b, std::size_t m, std::size_t n,
+                             std::size_t k) {
+  std::vector<T> c(m * n);
+  for (std::size_t i = 0; i < m; i++) {
+    for (std::size_t l = 0; l < k; l++) {
+      for (std::size_t j = 0; j < n; j++) {
+        c[(i * n) + j] += a[(i * k) + l] * b[(l * n) + j];
+      }
+    }
+  }
+  return c;
+}
+
+/// Per-rank path in the temporary directory, so that concurrent ranks do not share files.
+std::string TempPath(const std::string &name) {
+  int rank = 0;
+  if (ppc::util::MpiReady()) {
+    MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+  }
+  return (std::filesystem::temp_directory_path() / ("ppc_sparse_" + std::to_string(rank) + "_" + name)).string();
+}
+
+template <typename T>
+void ExpectClose(const std::vector<T> &actual, const std::vector<T> &expected) {
+  ASSERT_EQ(actual.size(), expected.size());
+  for (std::size_t i = 0; i < actual.size(); i++) {
+    ASSERT_NEAR(std::abs(actual[i] - expected[i]), 0.0, 1e-12) << "at " << i;
+  }
+}
+
+}  // namespace
+
+TEST(Sparse, TripletsDenseAndTransposedStorageRoundTrip) {
+  const auto crs = ppc::sparse::FromTriplets<Complex>(3, 4,
+                                                      {{.row = 2, .col = 1, .value = {1, 1}},
+                                                       {.row = 0, .col = 3, .value = 2},
+                                                       {.row = 2, .col = 1, .value = 3}});
+  ASSERT_TRUE(ppc::sparse::IsValid(crs));
+  EXPECT_EQ(crs.Nnz(), 2U);
+  EXPECT_EQ(crs.row_ptr, (std::vector<std::size_t>{0, 1, 1, 2}));
+  EXPECT_EQ(crs.values[1], Complex(4, 1));
+  EXPECT_THROW((void)ppc::sparse::FromTriplets<double>(2, 2, {{.row = 2, .col = 0, .value = 1.0}}),
+               std::invalid_argument);
+
+  const auto dense = RandomDense<double>(17, 23, 0.2, 1);
+  const auto a = ppc::sparse::FromDense(17, 23, dense);
+  const Ccs<double> ccs = ppc::sparse::ToCcs(a);
+  ASSERT_TRUE(ppc::sparse::IsValid(ccs));
+  EXPECT_EQ(ppc::sparse::ToDense(a), dense);
+  EXPECT_EQ(ppc::sparse::ToDense(ccs), dense);
+  const Crs<double> back = ppc::sparse::ToCrs(ccs);
+  EXPECT_EQ(back.row_ptr, a.row_ptr);
+  EXPECT_EQ(back.col_indices, a.col_indices);
+  EXPECT_EQ(back.values, a.values);
+
+  auto broken = a;
+  std::swap(broken.col_indices[0], broken.col_indices[1]);
+  EXPECT_FALSE(ppc::sparse::IsValid(broken));
+}
+
+TEST(Sparse, SpMVMatchesDenseOnEveryBackendAndStorage) {
+  constexpr std::size_t kRows = 61;
+  constexpr std::size_t kCols = 47;
+  const auto dense = RandomDense<Complex>(kRows, kCols, 0.15, 2);
+  const auto x = RandomDense<Complex>(kCols, 1, 1.0, 3);
+  const auto expected = DenseMultiply(dense, x, kRows, 1, kCols);
+  const auto crs = ppc::sparse::FromDense(kRows, kCols, dense);
+  const auto ccs = ppc::sparse::ToCcs(crs);
+  for (const Backend backend : kAllBackends) {
+    SCOPED_TRACE(ppc::shared_memory::BackendToString(backend));
+    ExpectClose(ppc::sparse::SpMV(crs, x, backend), expected);
+    ExpectClose(ppc::sparse::SpMV(ccs, x, backend), expected);
+  }
+  EXPECT_THROW((void)ppc::sparse::SpMV(crs, std::vector<Complex>(kRows), Backend::kSeq), std::invalid_argument);
+}
+
+TEST(Sparse, SpGEMMMatchesDenseForEveryAccumulator) {
+  constexpr std::size_t kM = 40;
+  constexpr std::size_t kK = 33;
+  constexpr std::size_t kN = 52;
+  const auto a_dense = RandomDense<Complex>(kM, kK, 0.1, 4);
+  const auto b_dense = RandomDense<Complex>(kK, kN, 0.1, 5);
+  const auto expected = DenseMultiply(a_dense, b_dense, kM, kN, kK);
+  const auto a = ppc::sparse::FromDense(kM, kK, a_dense);
+  const auto b = ppc::sparse::FromDense(kK, kN, b_dense);
+  for (const Backend backend : kAllBackends) {
+    for (const Accumulator accumulator : {Accumulator::kAuto, Accumulator::kDense, Accumulator::kHash}) {
+      SCOPED_TRACE(ppc::shared_memory::BackendToString(backend) + "/" + ppc::sparse::AccumulatorToString(accumulator));
+      const auto c = ppc::sparse::SpGEMM(a, b, backend, accumulator);
+      ASSERT_TRUE(ppc::sparse::IsValid(c));
+      ExpectClose(ppc::sparse::ToDense(c), expected);
+      const auto c_ccs = ppc::sparse::SpGEMM(ppc::sparse::ToCcs(a), ppc::sparse::ToCcs(b), backend, accumulator);
+      ASSERT_TRUE(ppc::sparse::IsValid(c_ccs));
+      ExpectClose(ppc::sparse::ToDense(c_ccs), expected);
+    }
+  }
+  EXPECT_THROW((void)ppc::sparse::SpGEMM(a, a), std::invalid_argument);
+}
+
+TEST(Sparse, RmatMatrixHasSkewedRows) {
+  const auto a = ppc::sparse::RmatMatrix(10, 8, 6);
+  ASSERT_TRUE(ppc::sparse::IsValid(a));
+  EXPECT_EQ(a.rows, 1024U);
+  std::size_t longest = 0;
+  for (std::size_t i = 0; i < a.rows; i++) {
+    longest = std::max(longest, a.row_ptr[i + 1] - a.row_ptr[i]);
+  }
+  // Duplicates are merged, so there are fewer than 8 entries per row on average, but the heaviest
+  // row is far above that.
+  EXPECT_LE(a.Nnz(), a.rows * 8);
+  EXPECT_GT(longest, 64U);
+}
+
+TEST(Sparse, RowDistributionRoundTripsAndMultiplies) {
+  if (!ppc::util::MpiReady()) {
+    GTEST_SKIP() << "MPI is not initialized";
+  }
+  int rank = 0;
+  MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+  const auto dense = RandomDense<Complex>(29, 19, 0.3, 7);
+  const auto x = RandomDense<Complex>(19, 1, 1.0, 8);
+  const auto a = ppc::sparse::FromDense(29, 19, dense);
+  const auto local = ppc::sparse::ScatterRows(rank == 0 ? a : Crs<Complex>{}, 0, MPI_COMM_WORLD);
+  ASSERT_TRUE(ppc::sparse::IsValid(local));
+  ExpectClose(ppc::sparse::DistributedSpMV(local, x, MPI_COMM_WORLD), DenseMultiply(dense, x, 29, 1, 19));
+
+  const auto gathered = ppc::sparse::GatherRows(local, 0, MPI_COMM_WORLD);
+  if (rank == 0) {
+    EXPECT_EQ(gathered.row_ptr, a.row_ptr);
+    EXPECT_EQ(gathered.values, a.values);
+  } else {
+    EXPECT_EQ(gathered.rows, 0U);
+  }
+}
+
+TEST(Sparse, ScatterRowsRejectsOversizedMatrixOnEveryRank) {
+  if (!ppc::util::MpiReady()) {
+    GTEST_SKIP() << "MPI is not initialized";
+  }
+  int rank = 0;
+  MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+  // Only the shape is read before the check, so the row count alone can exceed an MPI int.
+  Crs<double> oversized;
+  oversized.rows = static_cast<std::size_t>(std::numeric_limits<int>::max());
+  EXPECT_THROW((void)ppc::sparse::ScatterRows(rank == 0 ? oversized : Crs<double>{}, 0, MPI_COMM_WORLD),
+               std::invalid_argument);
+}
+
+template <TypeOfTask kType>
+void RunSpGEMMTask() {
+  const auto a = ppc::sparse::RmatMatrix(7, 4, 9);
+  const auto expected = ppc::sparse::ToDense(ppc::sparse::SpGEMM(a, a));
+  ppc::sparse::SpGEMMTask<double, kType, Accumulator::kHash> task({.a = a, .b = a});
+  ASSERT_TRUE(task.Validation());
+  ASSERT_TRUE(task.PreProcessing());
+  ASSERT_TRUE(task.Run());
+  ASSERT_TRUE(task.PostProcessing());
+  ExpectClose(ppc::sparse::ToDense(task.GetOutput()), expected);
+}
+
+TEST(Sparse, TasksMatchTheSequentialProduct) {
+  RunSpGEMMTask<TypeOfTask::kOMP>();
+  RunSpGEMMTask<TypeOfTask::kTBB>();
+  RunSpGEMMTask<TypeOfTask::kSTL>();
+  if (ppc::util::MpiReady()) {
+    RunSpGEMMTask<TypeOfTask::kMPI>();
+  }
+}
+
+TEST(Sparse, MatrixMarketRoundTripsAndExpandsSymmetry) {
+  const auto a = ppc::sparse::FromDense(37, 29, RandomDense<Complex>(37, 29, 0.2, 10));
+  const std::string path = TempPath("roundtrip.mtx");
+  ppc::sparse::WriteMatrixMarket(path, a);
+  for (const Backend backend : kAllBackends) {
+    const auto read = ppc::sparse::ReadMatrixMarket<Complex>(path, backend);
+    EXPECT_EQ(read.row_ptr, a.row_ptr);
+    EXPECT_EQ(read.col_indices, a.col_indices);
+    ExpectClose(read.values, a.values);
+  }
+  EXPECT_THROW((void)ppc::sparse::ReadMatrixMarket<double>(path), std::runtime_error);
+
+  const std::string symmetric = TempPath("symmetric.mtx");
+  {
+    std::ofstream out(symmetric);
+    out << "%%MatrixMarket matrix coordinate real symmetric\n% comment\n3 3 4\n1 1 2.5\n3 1 -1\n\n2 2 4e0\n3 1 1\n";
+  }
+  const auto s = ppc::sparse::ReadMatrixMarket<double>(symmetric, Backend::kTbb);
+  EXPECT_EQ(ppc::sparse::ToDense(s), (std::vector<double>{2.5, 0, 0, 0, 4, 0, 0, 0, 0}));
+
+  const std::string broken = TempPath("broken.mtx");
+  {
+    std::ofstream out(broken);
+    out << "%%MatrixMarket matrix coordinate pattern general\n2 2 2\n1 1\n3 1\n";
+  }
+  EXPECT_THROW((void)ppc::sparse::ReadMatrixMarket<double>(broken), std::runtime_error);
+  std::filesystem::remove(path);
+  std::filesystem::remove(symmetric);
+  std::filesystem::remove(broken);
+}
+
+TEST(Sparse, LoadMatrixMarketMapsItsBinaryCache) {
+  const auto a = ppc::sparse::RmatMatrix(9, 8, 11);
+  const std::string path = TempPath("cached.mtx");
+  const std::string cache = path + ".double.crs";
+  std::filesystem::remove(cache);
+  ppc::sparse::WriteMatrixMarket(path, a);
+
+  const auto parsed = ppc::sparse::LoadMatrixMarket<double>(path, Backend::kOmp);
+  ASSERT_TRUE(std::filesystem::exists(cache));
+  const ppc::sparse::MappedCrs<double> mapped(cache);
+  EXPECT_EQ(mapped.Rows(), a.rows);
+  EXPECT_EQ(mapped.Nnz(), a.Nnz());
+  EXPECT_EQ(mapped.RowPtr().back(), a.Nnz());
+  const auto cached = ppc::sparse::LoadMatrixMarket<double>(path);
+  EXPECT_EQ(cached.col_indices, parsed.col_indices);
+  EXPECT_EQ(cached.values, parsed.values);
+  ExpectClose(parsed.values, a.values);
+
+  EXPECT_THROW(ppc::sparse::MappedCrs<Complex>{cache}, std::runtime_error);
+
+  const auto patch = [&cache](std::streamoff offset, std::uint64_t word) {
+    std::fstream file(cache, std::ios::binary | std::ios::in | std::ios::out);
+    file.seekp(offset);
+    file.write(reinterpret_cast<const char *>(&word), sizeof(word));  // NOLINT(*-reinterpret-cast)
+  };
+  // A column index out of range passes the size check but not the structure check.
+  patch(static_cast<std::streamoff>(40 + ((a.rows + 1) * sizeof(std::uint64_t))), a.cols);
+  EXPECT_THROW(ppc::sparse::MappedCrs<double>{cache}, std::runtime_error);
+  EXPECT_EQ(ppc::sparse::LoadMatrixMarket<double>(path).col_indices, parsed.col_indices);
+  // A row count 2^61 too large wraps the size it implies back to the size of the file.
+  patch(16, a.rows + (std::uint64_t{1} << 61U));
+  EXPECT_THROW(ppc::sparse::MappedCrs<double>{cache}, std::runtime_error);
+  std::filesystem::remove(path);
+  std::filesystem::remove(cache);
+}
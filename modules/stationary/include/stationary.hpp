@@ -0,0 +1,89 @@
+#pragma once
+
+#include <mpi.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <vector>
+
+#include "shared_memory/include/parallel_for.hpp"
+#include "sparse/include/sparse.hpp"
+
+namespace ppc::stationary {
+
+using Backend = ppc::shared_memory::Backend;
+
+/// @brief Stationary iteration x <- x + M^{-1} (b - A x).
+enum class Method : uint8_t {
+  /// M = D: every row reads the previous iterate, one halo exchange per sweep
+  kJacobi,
+  /// Multicolour Gauss-Seidel: rows of one colour are independent and updated in parallel, the halo
+  /// of a colour is exchanged before the next colour reads it
+  kGaussSeidel,
+  /// Multicolour Gauss-Seidel over-relaxed by Options::omega
+  kSor
+};
+
+/// @brief Returns the lower-case name of the method ("jacobi", "gauss_seidel", "sor").
+std::string MethodToString(Method method);
+
+struct Options {
+  Method method = Method::kGaussSeidel;
+  /// Relaxation factor of kSor, in (0, 2).
+  double omega = 1.5;
+  /// Stop once ||b - A x|| <= tolerance * ||b||.
+  double tolerance = 1e-8;
+  std::size_t max_iterations = 10000;
+  /// The residual, and with it the only allreduce of the loop, is evaluated every check_every
+  /// sweeps and after the last one.
+  std::size_t check_every = 10;
+  /// Thread back-end of the sweeps.
+  Backend backend = Backend::kSeq;
+};
+
+struct ResidualCheck {
+  std::size_t iteration = 0;
+  /// ||b - A x|| / ||b|| after @ref iteration sweeps.
+  double residual = 0.0;
+};
+
+/// @brief Solution and convergence/performance report of one solve.
+struct Result {
+  /// Local part of the solution.
+  std::vector<double> x;
+  std::size_t iterations = 0;
+  bool converged = false;
+  /// One entry per residual check, starting with iteration 0.
+  std::vector<ResidualCheck> history;
+  /// Colours of the Gauss-Seidel ordering (1 for Jacobi).
+  std::size_t colours = 1;
+  /// Wall time of the iterations, and the part of it spent in halo exchanges.
+  double seconds = 0.0;
+  double exchange_seconds = 0.0;
+  /// Allreduce calls of the iterations.
+  std::size_t reductions = 0;
+  /// Halo bytes this rank sent during the iterations.
+  std::size_t halo_bytes = 0;
+};
+
+/// @brief Greedy colouring of the rows in index order over the symmetrised pattern of @p a; adjacent
+/// rows get different colours. Five-point stencils get the red-black ordering.
+/// @return Colour of every row.
+std::vector<std::uint32_t> GreedyColouring(const ppc::sparse::Crs<double> &a);
+
+/// @brief Solves A x = b from x = 0 by a stationary iteration.
+/// @param strip Rows [row_offset, row_offset + strip.rows) of the square matrix, columns global.
+/// @param b_local Local rows of b.
+/// @param comm Communicator of the strips in rank order, or MPI_COMM_NULL for a shared-memory solve.
+/// @details Ranks exchange only the entries their strips reference (the halo), with point-to-point
+/// messages between the ranks that share columns. The multicolour ordering is coloured across
+/// ranks in rank order, so for structurally symmetric matrices the iterates match the shared-memory
+/// solve.
+/// @throws std::invalid_argument When the strips do not tile the matrix, b_local does not match,
+/// a diagonal entry is zero, or omega is outside (0, 2).
+Result Solve(const ppc::sparse::Crs<double> &strip, std::span<const double> b_local, const Options &options = {},
+             std::size_t row_offset = 0, MPI_Comm comm = MPI_COMM_NULL);
+
+}  // namespace ppc::stationary
@@ -0,0 +1,105 @@
+#pragma once
+
+#include <mpi.h>
+
+#include <cstddef>
+#include <span>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include "shared_memory/include/parallel_for.hpp"
+#include "shared_memory/include/shared_memory.hpp"
+#include "sparse/include/sparse.hpp"
+#include "stationary/include/stationary.hpp"
+#include "task/include/task.hpp"
+
+namespace ppc::stationary {
+
+/// @brief A x = b with a non-zero diagonal; every rank holds the whole input, as in the course
+/// tasks. Dense systems enter through ppc::sparse::FromDense().
+struct StationaryProblem {
+  ppc::sparse::Crs<double> a;
+  std::vector<double> b;
+};
+
+/// @brief Stationary solve as a course task on any back-end.
+/// @details The kMPI variant solves on a block of rows per rank with halo exchanges and gathers the
+/// whole solution on every rank in PostProcessing. The output carries the convergence report.
+template <ppc::task::TypeOfTask kType, Method kMethod = Method::kGaussSeidel>
+class StationaryTask : public ppc::task::Task<StationaryProblem, Result> {
+ public:
+  using InType = StationaryProblem;
+  using OutType = Result;
+
+  static constexpr ppc::task::TypeOfTask GetStaticTypeOfTask() {
+    return kType;
+  }
+
+  explicit StationaryTask(const InType &in, Options options = {}) {
+    SetTypeOfTask(GetStaticTypeOfTask());
+    GetInput() = in;
+    options_ = options;
+    options_.method = kMethod;
+    options_.backend = ppc::shared_memory::BackendOf(kType);
+  }
+
+ private:
+  bool ValidationImpl() override {
+    const InType &in = GetInput();
+    return ppc::sparse::IsValid(in.a) && in.a.rows == in.a.cols && in.b.size() == in.a.rows;
+  }
+
+  bool PreProcessingImpl() override {
+    const std::size_t n = GetInput().a.rows;
+    begin_ = 0;
+    std::size_t end = n;
+    if constexpr (kType == ppc::task::TypeOfTask::kMPI) {
+      int rank = 0;
+      int size = 1;
+      MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+      MPI_Comm_size(MPI_COMM_WORLD, &size);
+      std::tie(begin_, end) = ppc::shared_memory::BlockRange(n, size, rank);
+      strip_ = ppc::sparse::SliceRows(GetInput().a, begin_, end);
+    }
+    return true;
+  }
+
+  bool RunImpl() override {
+    const InType &in = GetInput();
+    if constexpr (kType == ppc::task::TypeOfTask::kMPI) {
+      const auto b_local = std::span<const double>(in.b).subspan(begin_, strip_.rows);
+      GetOutput() = Solve(strip_, b_local, options_, begin_, MPI_COMM_WORLD);
+    } else {
+      GetOutput() = Solve(in.a, in.b, options_);
+    }
+    return true;
+  }
+
+  bool PostProcessingImpl() override {
+    Result &out = GetOutput();
+    const std::size_t n = GetInput().a.rows;
+    if constexpr (kType == ppc::task::TypeOfTask::kMPI) {
+      int size = 1;
+      MPI_Comm_size(MPI_COMM_WORLD, &size);
+      std::vector<int> counts(static_cast<std::size_t>(size));
+      std::vector<int> displs(static_cast<std::size_t>(size));
+      for (int r = 0; r < size; r++) {
+        const auto [b, e] = ppc::shared_memory::BlockRange(n, size, r);
+        displs[static_cast<std::size_t>(r)] = static_cast<int>(b);
+        counts[static_cast<std::size_t>(r)] = static_cast<int>(e - b);
+      }
+      std::vector<double> x(n);
+      MPI_Allgatherv(out.x.data(), static_cast<int>(out.x.size()), MPI_DOUBLE, x.data(), counts.data(),
+                     displs.data(), MPI_DOUBLE, MPI_COMM_WORLD);
+      out.x = std::move(x);
+    }
+    return out.x.size() == n;
+  }
+
+  Options options_;
+  std::size_t begin_ = 0;
+  ppc::sparse::Crs<double> strip_;
+};
+
+}  // namespace ppc::stationary
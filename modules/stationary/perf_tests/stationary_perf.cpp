@@ -0,0 +1,121 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include "sparse/include/sparse.hpp"
+#include "stationary/include/stationary.hpp"
+#include "stationary/include/stationary_task.hpp"
+#include "task/include/task.hpp"
+#include "util/include/perf_test_util.hpp"
+
+namespace ppc::stationary::perf {
+
+using ppc::sparse::Crs;
+using ppc::task::TypeOfTask;
+
+namespace {
+
+/// Every run does exactly this many sweeps: the tolerance is out of reach on the perf grid.
+constexpr std::size_t kSweeps = 200;
+
+/// Five-point Laplacian on a 256 x 256 grid: 65536 rows, a two-row halo between row strips.
+const Crs<double> &PoissonMatrix() {
+  static const Crs<double> kMatrix = [] {
+    constexpr std::size_t kSide = 256;
+    std::vector<ppc::sparse::Triplet<double>> entries;
+    for (std::size_t i = 0; i < kSide; i++) {
+      for (std::size_t j = 0; j < kSide; j++) {
+        const std::size_t row = (i * kSide) + j;
+        entries.push_back({.row = row, .col = row, .value = 4.0});
+        if (i > 0) {
+          entries.push_back({.row = row, .col = row - kSide, .value = -1.0});
+        }
+        if (i + 1 < kSide) {
+          entries.push_back({.row = row, .col = row + kSide, .value = -1.0});
+        }
+        if (j > 0) {
+          entries.push_back({.row = row, .col = row - 1, .value = -1.0});
+        }
+        if (j + 1 < kSide) {
+          entries.push_back({.row = row, .col = row + 1, .value = -1.0});
+        }
+      }
+    }
+    return ppc::sparse::FromTriplets<double>(kSide * kSide, kSide * kSide, entries);
+  }();
+  return kMatrix;
+}
+
+/// StationaryTask with a fixed sweep count and residual checks every @p kCheckEvery sweeps.
+template <TypeOfTask kType, Method kMethod, std::size_t kCheckEvery>
+class PerfStationaryTask : public StationaryTask<kType, kMethod> {
+ public:
+  explicit PerfStationaryTask(const StationaryProblem &in)
+      : StationaryTask<kType, kMethod>(
+            in, {.omega = 1.9, .tolerance = 1e-30, .max_iterations = kSweeps, .check_every = kCheckEvery}) {}
+};
+
+}  // namespace
+
+/// Reports sweeps per second, the share of time in halo exchanges, the allreduce count, the halo
+/// volume and the residual history.
+class StationaryPerfTests : public ppc::util::BaseRunPerfTests<StationaryProblem, Result> {
+  StationaryProblem input_data_;
+
+  void SetUp() override {
+    input_data_ = {.a = PoissonMatrix(), .b = std::vector<double>(PoissonMatrix().rows, 1.0)};
+  }
+
+  bool CheckTestOutputData(Result &output_data) final {
+    PrintRate("sweeps_per_s", static_cast<double>(output_data.iterations));
+    PrintValue("ms_per_sweep", 1e3 * output_data.seconds / static_cast<double>(output_data.iterations));
+    PrintValue("exchange_share", output_data.seconds > 0.0 ? output_data.exchange_seconds / output_data.seconds : 0.0);
+    PrintValue("reductions", static_cast<double>(output_data.reductions));
+    PrintValue("halo_kib", static_cast<double>(output_data.halo_bytes) / 1024.0);
+    // The SOR residual grows over the first sweeps before it decays: compare with its peak.
+    std::vector<double> residuals;
+    for (const auto &check : output_data.history) {
+      residuals.push_back(check.residual);
+    }
+    PrintSeries("history", residuals);
+    return output_data.iterations == kSweeps && output_data.x.size() == input_data_.b.size() &&
+           residuals.back() < std::ranges::max(residuals);
+  }
+
+  StationaryProblem GetTestInputData() final {
+    return input_data_;
+  }
+};
+
+/// PerfStationaryTask of every back-end for one method, checking the residual every 10 sweeps.
+template <Method kMethod>
+struct PerfStationaryTasks {
+  template <TypeOfTask kType>
+  using Task = PerfStationaryTask<kType, kMethod, 10>;
+};
+
+template <Method kMethod>
+auto MakeBackendSuite(const std::string &kernel) {
+  return ppc::util::MakeBackendPerfTaskTuples<PerfStationaryTasks<kMethod>::template Task, StationaryProblem>(
+      "ppc_stationary", kernel);
+}
+
+TEST_P(StationaryPerfTests, RunPerfModes) {
+  ExecuteTest(GetParam());
+}
+
+// sor_check_every_sweep shows what the residual check interval saves in allreduce calls.
+const auto kStationaryPerfTasks = std::tuple_cat(
+    MakeBackendSuite<Method::kJacobi>("jacobi"), MakeBackendSuite<Method::kGaussSeidel>("gauss_seidel"),
+    MakeBackendSuite<Method::kSor>("sor"),
+    ppc::util::MakeNamedPerfTaskTuples<PerfStationaryTask<TypeOfTask::kMPI, Method::kSor, 1>, StationaryProblem>(
+        "ppc_stationary_mpi_sor_check_every_sweep"));
+
+INSTANTIATE_TEST_SUITE_P(Poisson2D, StationaryPerfTests, ppc::util::TupleToGTestValues(kStationaryPerfTasks),
+                         StationaryPerfTests::CustomPerfTestName);
+
+}  // namespace ppc::stationary::perf
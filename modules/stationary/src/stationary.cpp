@@ -0,0 +1,476 @@
+#include "stationary/include/stationary.hpp"
+
+#include <mpi.h>
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "shared_memory/include/parallel_for.hpp"
+#include "sparse/include/sparse.hpp"
+
+namespace ppc::stationary {
+
+namespace {
+
+constexpr std::uint32_t kUncoloured = std::numeric_limits<std::uint32_t>::max();
+constexpr std::size_t kAllColours = std::numeric_limits<std::size_t>::max();
+constexpr int kHaloTag = 0;
+constexpr int kColourTag = 1;
+
+/// Greedy colouring in row order. Row i avoids the colours of its coloured neighbours: local columns
+/// j < i, local rows j < i that reference i, and ghosts already coloured by lower ranks.
+std::vector<std::uint32_t> ColourRows(std::size_t rows, const std::vector<std::size_t> &row_ptr,
+                                      const std::vector<std::size_t> &cols,
+                                      const std::vector<std::uint32_t> &ghost_colours) {
+  std::vector<std::vector<std::size_t>> referenced_by(rows);
+  for (std::size_t i = 0; i < rows; i++) {
+    for (std::size_t e = row_ptr[i]; e < row_ptr[i + 1]; e++) {
+      if (cols[e] < rows && cols[e] > i) {
+        referenced_by[cols[e]].push_back(i);
+      }
+    }
+  }
+  std::vector<std::uint32_t> colours(rows, kUncoloured);
+  std::vector<std::size_t> stamp;
+  const auto forbid = [&](std::uint32_t colour, std::size_t row) {
+    if (colour == kUncoloured) {
+      return;
+    }
+    if (colour >= stamp.size()) {
+      stamp.resize(colour + 1, kAllColours);
+    }
+    stamp[colour] = row;
+  };
+  for (std::size_t i = 0; i < rows; i++) {
+    for (std::size_t e = row_ptr[i]; e < row_ptr[i + 1]; e++) {
+      const std::size_t col = cols[e];
+      if (col < i) {
+        forbid(colours[col], i);
+      } else if (col >= rows) {
+        forbid(ghost_colours[col - rows], i);
+      }
+    }
+    for (const std::size_t j : referenced_by[i]) {
+      forbid(colours[j], i);
+    }
+    std::uint32_t colour = 0;
+    while (colour < stamp.size() && stamp[colour] == i) {
+      colour++;
+    }
+    colours[i] = colour;
+  }
+  return colours;
+}
+
+struct Neighbor {
+  int rank = 0;
+  /// Local rows this rank sends, and the ghost slots (extended indices) it receives into.
+  std::vector<std::size_t> send;
+  std::vector<std::size_t> recv;
+  /// The same lists split by the colour of the row.
+  std::vector<std::vector<std::size_t>> send_by_colour;
+  std::vector<std::vector<std::size_t>> recv_by_colour;
+  std::vector<double> send_buffer;
+  std::vector<double> recv_buffer;
+};
+
+/// Local strip with columns renumbered into the extended vector [own rows | ghosts], and the
+/// point-to-point halo exchange that keeps the ghosts current.
+class LocalSystem {
+ public:
+  LocalSystem(const ppc::sparse::Crs<double> &strip, std::size_t row_offset, MPI_Comm comm)
+      : rows_(strip.rows), comm_(comm), row_ptr_(strip.row_ptr), values_(strip.values) {
+    if (!ppc::sparse::IsValid(strip)) {
+      throw std::invalid_argument("stationary: the strip is malformed");
+    }
+    const std::vector<std::size_t> offsets = Offsets(strip, row_offset);
+    const std::size_t end = row_offset + rows_;
+
+    // Ghosts are the referenced columns outside the strip, sorted so that each owner's are contiguous.
+    std::vector<std::size_t> ghost_cols;
+    for (const std::size_t col : strip.col_indices) {
+      if (col < row_offset || col >= end) {
+        ghost_cols.push_back(col);
+      }
+    }
+    std::ranges::sort(ghost_cols);
+    ghost_cols.erase(std::ranges::unique(ghost_cols).begin(), ghost_cols.end());
+    ghosts_ = ghost_cols.size();
+    cols_.resize(strip.col_indices.size());
+    for (std::size_t e = 0; e < cols_.size(); e++) {
+      const std::size_t col = strip.col_indices[e];
+      if (col >= row_offset && col < end) {
+        cols_[e] = col - row_offset;
+      } else {
+        cols_[e] = rows_ + static_cast<std::size_t>(std::ranges::lower_bound(ghost_cols, col) - ghost_cols.begin());
+      }
+    }
+    inverse_diagonal_.assign(rows_, 0.0);
+    for (std::size_t i = 0; i < rows_; i++) {
+      for (std::size_t e = row_ptr_[i]; e < row_ptr_[i + 1]; e++) {
+        if (cols_[e] == i) {
+          inverse_diagonal_[i] += values_[e];
+        }
+      }
+    }
+    int ok = static_cast<int>(std::ranges::none_of(inverse_diagonal_, [](double d) { return d == 0.0; }));
+    if (comm_ != MPI_COMM_NULL) {
+      MPI_Allreduce(MPI_IN_PLACE, &ok, 1, MPI_INT, MPI_MIN, comm_);
+    }
+    if (ok == 0) {
+      throw std::invalid_argument("stationary: every diagonal entry must be non-zero");
+    }
+    for (auto &d : inverse_diagonal_) {
+      d = 1.0 / d;
+    }
+    if (comm_ != MPI_COMM_NULL) {
+      BuildNeighbors(ghost_cols, offsets, row_offset);
+    }
+  }
+
+  [[nodiscard]] std::size_t Rows() const {
+    return rows_;
+  }
+  [[nodiscard]] std::size_t Extended() const {
+    return rows_ + ghosts_;
+  }
+  [[nodiscard]] std::size_t Colours() const {
+    return rows_by_colour_.size();
+  }
+  [[nodiscard]] const std::vector<std::size_t> &RowsOfColour(std::size_t colour) const {
+    return rows_by_colour_[colour];
+  }
+
+  /// sum_j a_ij x_j of local row @p i over the extended @p x.
+  [[nodiscard]] double RowProduct(std::size_t i, std::span<const double> x) const {
+    double sum = 0.0;
+    for (std::size_t e = row_ptr_[i]; e < row_ptr_[i + 1]; e++) {
+      sum += values_[e] * x[cols_[e]];
+    }
+    return sum;
+  }
+  [[nodiscard]] double InverseDiagonal(std::size_t i) const {
+    return inverse_diagonal_[i];
+  }
+
+  /// Colours the rows consistently across ranks: rank r colours after the lower ranks it shares
+  /// columns with, as the sequential greedy colouring of the whole matrix would.
+  void Colour() {
+    std::vector<std::uint32_t> ghost_colours(ghosts_, kUncoloured);
+    std::vector<std::uint32_t> colours;
+    if (comm_ == MPI_COMM_NULL) {
+      colours = ColourRows(rows_, row_ptr_, cols_, ghost_colours);
+    } else {
+      int rank = 0;
+      MPI_Comm_rank(comm_, &rank);
+      std::vector<std::vector<std::uint32_t>> buffers(neighbors_.size());
+      std::vector<MPI_Request> requests;
+      for (std::size_t k = 0; k < neighbors_.size(); k++) {
+        if (neighbors_[k].rank < rank && !neighbors_[k].recv.empty()) {
+          buffers[k].resize(neighbors_[k].recv.size());
+          requests.emplace_back();
+          MPI_Irecv(buffers[k].data(), static_cast<int>(buffers[k].size()), MPI_UINT32_T, neighbors_[k].rank,
+                    kColourTag, comm_, &requests.back());
+        }
+      }
+      MPI_Waitall(static_cast<int>(requests.size()), requests.data(), MPI_STATUSES_IGNORE);
+      requests.clear();
+      for (std::size_t k = 0; k < neighbors_.size(); k++) {
+        for (std::size_t g = 0; g < buffers[k].size(); g++) {
+          ghost_colours[neighbors_[k].recv[g] - rows_] = buffers[k][g];
+        }
+      }
+      colours = ColourRows(rows_, row_ptr_, cols_, ghost_colours);
+      for (std::size_t k = 0; k < neighbors_.size(); k++) {
+        if (neighbors_[k].rank > rank && !neighbors_[k].send.empty()) {
+          buffers[k].clear();
+          for (const std::size_t row : neighbors_[k].send) {
+            buffers[k].push_back(colours[row]);
+          }
+          requests.emplace_back();
+          MPI_Isend(buffers[k].data(), static_cast<int>(buffers[k].size()), MPI_UINT32_T, neighbors_[k].rank,
+                    kColourTag, comm_, &requests.back());
+        }
+      }
+      // The higher ranks' colours reach the ghosts through an ordinary exchange.
+      std::vector<double> extended(Extended());
+      std::ranges::transform(colours, extended.begin(), [](std::uint32_t c) { return static_cast<double>(c); });
+      Exchange(extended, kAllColours);
+      for (std::size_t g = 0; g < ghosts_; g++) {
+        ghost_colours[g] = static_cast<std::uint32_t>(extended[rows_ + g]);
+      }
+      MPI_Waitall(static_cast<int>(requests.size()), requests.data(), MPI_STATUSES_IGNORE);
+    }
+
+    std::uint32_t count = colours.empty() ? 0 : *std::ranges::max_element(colours) + 1;
+    if (comm_ != MPI_COMM_NULL) {
+      MPI_Allreduce(MPI_IN_PLACE, &count, 1, MPI_UINT32_T, MPI_MAX, comm_);
+    }
+    rows_by_colour_.assign(std::max<std::uint32_t>(count, 1), {});
+    for (std::size_t i = 0; i < rows_; i++) {
+      rows_by_colour_[colours[i]].push_back(i);
+    }
+    for (auto &neighbor : neighbors_) {
+      neighbor.send_by_colour.assign(rows_by_colour_.size(), {});
+      neighbor.recv_by_colour.assign(rows_by_colour_.size(), {});
+      for (const std::size_t row : neighbor.send) {
+        neighbor.send_by_colour[colours[row]].push_back(row);
+      }
+      for (const std::size_t slot : neighbor.recv) {
+        neighbor.recv_by_colour[ghost_colours[slot - rows_]].push_back(slot);
+      }
+    }
+  }
+
+  /// Refreshes the ghosts of @p x from their owners: all of them, or those of one colour.
+  /// @return Bytes sent by this rank.
+  std::size_t Exchange(std::span<double> x, std::size_t colour) {
+    if (comm_ == MPI_COMM_NULL) {
+      return 0;
+    }
+    std::size_t bytes = 0;
+    std::vector<MPI_Request> requests;
+    requests.reserve(2 * neighbors_.size());
+    for (auto &neighbor : neighbors_) {
+      const auto &recv = colour == kAllColours ? neighbor.recv : neighbor.recv_by_colour[colour];
+      if (!recv.empty()) {
+        neighbor.recv_buffer.resize(recv.size());
+        requests.emplace_back();
+        MPI_Irecv(neighbor.recv_buffer.data(), static_cast<int>(recv.size()), MPI_DOUBLE, neighbor.rank, kHaloTag,
+                  comm_, &requests.back());
+      }
+    }
+    for (auto &neighbor : neighbors_) {
+      const auto &send = colour == kAllColours ? neighbor.send : neighbor.send_by_colour[colour];
+      if (!send.empty()) {
+        neighbor.send_buffer.resize(send.size());
+        for (std::size_t k = 0; k < send.size(); k++) {
+          neighbor.send_buffer[k] = x[send[k]];
+        }
+        requests.emplace_back();
+        MPI_Isend(neighbor.send_buffer.data(), static_cast<int>(send.size()), MPI_DOUBLE, neighbor.rank, kHaloTag,
+                  comm_, &requests.back());
+        bytes += send.size() * sizeof(double);
+      }
+    }
+    MPI_Waitall(static_cast<int>(requests.size()), requests.data(), MPI_STATUSES_IGNORE);
+    for (auto &neighbor : neighbors_) {
+      const auto &recv = colour == kAllColours ? neighbor.recv : neighbor.recv_by_colour[colour];
+      for (std::size_t k = 0; k < recv.size(); k++) {
+        x[recv[k]] = neighbor.recv_buffer[k];
+      }
+    }
+    return bytes;
+  }
+
+ private:
+  /// First row of every rank, plus the order of the matrix; checks that the strips tile it.
+  [[nodiscard]] std::vector<std::size_t> Offsets(const ppc::sparse::Crs<double> &strip, std::size_t row_offset) const {
+    if (comm_ == MPI_COMM_NULL) {
+      if (row_offset != 0 || strip.rows != strip.cols) {
+        throw std::invalid_argument("stationary: a shared-memory solve needs the whole matrix");
+      }
+      return {0, strip.rows};
+    }
+    int size = 1;
+    MPI_Comm_size(comm_, &size);
+    std::array<std::uint64_t, 2> mine = {row_offset, strip.rows};
+    std::vector<std::uint64_t> all(2 * static_cast<std::size_t>(size));
+    MPI_Allgather(mine.data(), 2, MPI_UINT64_T, all.data(), 2, MPI_UINT64_T, comm_);
+    std::vector<std::size_t> offsets;
+    std::size_t next = 0;
+    for (std::size_t r = 0; r < static_cast<std::size_t>(size); r++) {
+      if (all[2 * r] != next) {
+        throw std::invalid_argument("stationary: the strips must tile the matrix in rank order");
+      }
+      offsets.push_back(next);
+      next += all[(2 * r) + 1];
+    }
+    if (next != strip.cols) {
+      throw std::invalid_argument("stationary: the strips must tile the matrix in rank order");
+    }
+    offsets.push_back(next);
+    return offsets;
+  }
+
+  /// Tells every owner which of its rows this rank reads, and learns which of ours the others read.
+  void BuildNeighbors(const std::vector<std::size_t> &ghost_cols, const std::vector<std::size_t> &offsets,
+                      std::size_t row_offset) {
+    const auto size = offsets.size() - 1;
+    std::vector<int> recv_counts(size);
+    std::vector<int> recv_displs(size);
+    std::size_t g = 0;
+    for (std::size_t r = 0; r < size; r++) {
+      recv_displs[r] = static_cast<int>(g);
+      while (g < ghost_cols.size() && ghost_cols[g] < offsets[r + 1]) {
+        g++;
+      }
+      recv_counts[r] = static_cast<int>(g) - recv_displs[r];
+    }
+    std::vector<int> send_counts(size);
+    MPI_Alltoall(recv_counts.data(), 1, MPI_INT, send_counts.data(), 1, MPI_INT, comm_);
+    std::vector<int> send_displs(size);
+    int total = 0;
+    for (std::size_t r = 0; r < size; r++) {
+      send_displs[r] = total;
+      total += send_counts[r];
+    }
+    const std::vector<std::uint64_t> requested(ghost_cols.begin(), ghost_cols.end());
+    std::vector<std::uint64_t> wanted(static_cast<std::size_t>(total));
+    MPI_Alltoallv(requested.data(), recv_counts.data(), recv_displs.data(), MPI_UINT64_T, wanted.data(),
+                  send_counts.data(), send_displs.data(), MPI_UINT64_T, comm_);
+    for (std::size_t r = 0; r < size; r++) {
+      if (recv_counts[r] == 0 && send_counts[r] == 0) {
+        continue;
+      }
+      Neighbor neighbor;
+      neighbor.rank = static_cast<int>(r);
+      for (int k = 0; k < send_counts[r]; k++) {
+        neighbor.send.push_back(wanted[static_cast<std::size_t>(send_displs[r] + k)] - row_offset);
+      }
+      for (int k = 0; k < recv_counts[r]; k++) {
+        neighbor.recv.push_back(rows_ + static_cast<std::size_t>(recv_displs[r] + k));
+      }
+      neighbors_.push_back(std::move(neighbor));
+    }
+  }
+
+  std::size_t rows_;
+  std::size_t ghosts_ = 0;
+  MPI_Comm comm_;
+  std::vector<std::size_t> row_ptr_;
+  std::vector<std::size_t> cols_;
+  std::vector<double> values_;
+  std::vector<double> inverse_diagonal_;
+  std::vector<Neighbor> neighbors_;
+  std::vector<std::vector<std::size_t>> rows_by_colour_;
+};
+
+double SquaredNorm(std::span<const double> v, MPI_Comm comm) {
+  double sum = 0.0;
+  for (const double value : v) {
+    sum += value * value;
+  }
+  if (comm != MPI_COMM_NULL) {
+    MPI_Allreduce(MPI_IN_PLACE, &sum, 1, MPI_DOUBLE, MPI_SUM, comm);
+  }
+  return sum;
+}
+
+}  // namespace
+
+std::string MethodToString(Method method) {
+  switch (method) {
+    case Method::kJacobi:
+      return "jacobi";
+    case Method::kGaussSeidel:
+      return "gauss_seidel";
+    case Method::kSor:
+      return "sor";
+  }
+  return "unknown";
+}
+
+std::vector<std::uint32_t> GreedyColouring(const ppc::sparse::Crs<double> &a) {
+  if (!ppc::sparse::IsValid(a) || a.rows != a.cols) {
+    throw std::invalid_argument("stationary: GreedyColouring needs a valid square matrix");
+  }
+  return ColourRows(a.rows, a.row_ptr, a.col_indices, {});
+}
+
+Result Solve(const ppc::sparse::Crs<double> &strip, std::span<const double> b_local, const Options &options,
+             std::size_t row_offset, MPI_Comm comm) {
+  if (b_local.size() != strip.rows) {
+    throw std::invalid_argument("stationary: b does not match the rows of the strip");
+  }
+  if (options.check_every == 0) {
+    throw std::invalid_argument("stationary: check_every must be positive");
+  }
+  if (options.method == Method::kSor && (options.omega <= 0.0 || options.omega >= 2.0)) {
+    throw std::invalid_argument("stationary: SOR needs omega in (0, 2)");
+  }
+  LocalSystem system(strip, row_offset, comm);
+  const bool coloured = options.method != Method::kJacobi;
+  if (coloured) {
+    system.Colour();
+  }
+  const double omega = options.method == Method::kSor ? options.omega : 1.0;
+  const std::size_t rows = system.Rows();
+  const Backend backend = options.backend;
+
+  Result result;
+  result.colours = coloured ? system.Colours() : 1;
+  result.x.assign(rows, 0.0);
+  const double b_norm = std::sqrt(SquaredNorm(b_local, comm));
+  if (b_norm == 0.0) {
+    result.converged = true;
+    result.history.push_back({.iteration = 0, .residual = 0.0});
+    return result;
+  }
+  result.history.push_back({.iteration = 0, .residual = 1.0});
+
+  std::vector<double> x(system.Extended(), 0.0);
+  std::vector<double> next(coloured ? 0 : system.Extended(), 0.0);
+  std::vector<double> residual(rows);
+  const auto exchange = [&](std::span<double> v, std::size_t colour) {
+    const auto start = std::chrono::steady_clock::now();
+    result.halo_bytes += system.Exchange(v, colour);
+    result.exchange_seconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+  };
+
+  const auto start = std::chrono::steady_clock::now();
+  for (std::size_t iteration = 1; iteration <= options.max_iterations; iteration++) {
+    if (coloured) {
+      for (std::size_t colour = 0; colour < system.Colours(); colour++) {
+        const auto &members = system.RowsOfColour(colour);
+        ppc::shared_memory::ParallelForBlocks(members.size(), backend, [&](std::size_t begin, std::size_t end) {
+          for (std::size_t k = begin; k < end; k++) {
+            const std::size_t i = members[k];
+            const double update = (b_local[i] - system.RowProduct(i, x)) * system.InverseDiagonal(i);
+            x[i] += omega * update;
+          }
+        });
+        exchange(x, colour);
+      }
+    } else {
+      ppc::shared_memory::ParallelForBlocks(rows, backend, [&](std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; i++) {
+          next[i] = x[i] + ((b_local[i] - system.RowProduct(i, x)) * system.InverseDiagonal(i));
+        }
+      });
+      std::swap(x, next);
+      exchange(x, kAllColours);
+    }
+    result.iterations = iteration;
+
+    if (iteration % options.check_every == 0 || iteration == options.max_iterations) {
+      ppc::shared_memory::ParallelForBlocks(rows, backend, [&](std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; i++) {
+          residual[i] = b_local[i] - system.RowProduct(i, x);
+        }
+      });
+      const double relative = std::sqrt(SquaredNorm(residual, comm)) / b_norm;
+      result.reductions += comm != MPI_COMM_NULL ? 1 : 0;
+      result.history.push_back({.iteration = iteration, .residual = relative});
+      if (relative <= options.tolerance) {
+        result.converged = true;
+        break;
+      }
+    }
+  }
+  result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+  std::copy_n(x.begin(), rows, result.x.begin());
+  return result;
+}
+
+}  // namespace ppc::stationary
@@ -0,0 +1,189 @@
+#include <gtest/gtest.h>
+#include <mpi.h>
+
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+#include "shared_memory/include/parallel_for.hpp"
+#include "shared_memory/include/shared_memory.hpp"
+#include "sparse/include/sparse.hpp"
+#include "stationary/include/stationary.hpp"
+#include "stationary/include/stationary_task.hpp"
+#include "task/include/task.hpp"
+#include "util/include/func_test_util.hpp"
+
+using ppc::sparse::Crs;
+using ppc::stationary::Backend;
+using ppc::stationary::Method;
+using ppc::task::TypeOfTask;
+
+namespace {
+
+constexpr std::array<Backend, 4> kAllBackends = {Backend::kSeq, Backend::kOmp, Backend::kTbb, Backend::kStl};
+constexpr std::array<Method, 3> kAllMethods = {Method::kJacobi, Method::kGaussSeidel, Method::kSor};
+
+/// Five-point Laplacian on a k x k grid with Dirichlet boundaries.
+Crs<double> Poisson2D(std::size_t k) {
+  std::vector<ppc::sparse::Triplet<double>> entries;
+  for (std::size_t i = 0; i < k; i++) {
+    for (std::size_t j = 0; j < k; j++) {
+      const std::size_t row = (i * k) + j;
+      entries.push_back({.row = row, .col = row, .value = 4.0});
+      if (i > 0) {
+        entries.push_back({.row = row, .col = row - k, .value = -1.0});
+      }
+      if (i + 1 < k) {
+        entries.push_back({.row = row, .col = row + k, .value = -1.0});
+      }
+      if (j > 0) {
+        entries.push_back({.row = row, .col = row - 1, .value = -1.0});
+      }
+      if (j + 1 < k) {
+        entries.push_back({.row = row, .col = row + 1, .value = -1.0});
+      }
+    }
+  }
+  return ppc::sparse::FromTriplets<double>(k * k, k * k, entries);
+}
+
+/// Right-hand side whose exact solution is x_i = cos(i).
+std::vector<double> RhsOf(const Crs<double> &a) {
+  std::vector<double> x(a.cols);
+  for (std::size_t i = 0; i < x.size(); i++) {
+    x[i] = std::cos(static_cast<double>(i));
+  }
+  return ppc::sparse::SpMV(a, x);
+}
+
+void ExpectSolves(const std::vector<double> &x, std::size_t offset, double tolerance) {
+  for (std::size_t i = 0; i < x.size(); i++) {
+    ASSERT_NEAR(x[i], std::cos(static_cast<double>(offset + i)), tolerance) << "at " << offset + i;
+  }
+}
+
+}  // namespace
+
+TEST(Stationary, GreedyColouringOfAFivePointStencilIsRedBlack) {
+  const auto colours = ppc::stationary::GreedyColouring(Poisson2D(7));
+  for (std::size_t i = 0; i < 7; i++) {
+    for (std::size_t j = 0; j < 7; j++) {
+      EXPECT_EQ(colours[(i * 7) + j], (i + j) % 2) << i << "," << j;
+    }
+  }
+  // A dense 4 x 4 pattern needs one colour per row.
+  const auto dense = ppc::sparse::FromDense<double>(4, 4, std::vector<double>(16, 1.0));
+  EXPECT_EQ(ppc::stationary::GreedyColouring(dense), (std::vector<std::uint32_t>{0, 1, 2, 3}));
+}
+
+TEST(Stationary, EveryMethodConvergesIdenticallyOnEveryBackend) {
+  const auto a = Poisson2D(12);
+  const auto b = RhsOf(a);
+  std::array<std::size_t, 3> iterations{};
+  for (std::size_t m = 0; m < kAllMethods.size(); m++) {
+    const ppc::stationary::Options options{.method = kAllMethods[m], .omega = 1.6, .tolerance = 1e-10};
+    const auto reference = ppc::stationary::Solve(a, b, options);
+    ASSERT_TRUE(reference.converged) << ppc::stationary::MethodToString(kAllMethods[m]);
+    ExpectSolves(reference.x, 0, 1e-8);
+    EXPECT_EQ(reference.colours, kAllMethods[m] == Method::kJacobi ? 1U : 2U);
+    iterations[m] = reference.iterations;
+    for (const Backend backend : kAllBackends) {
+      auto threaded = options;
+      threaded.backend = backend;
+      const auto result = ppc::stationary::Solve(a, b, threaded);
+      EXPECT_EQ(result.iterations, reference.iterations);
+      EXPECT_EQ(result.x, reference.x) << ppc::shared_memory::BackendToString(backend);
+    }
+  }
+  // Gauss-Seidel halves the Jacobi sweeps; SOR near the optimal omega needs several times fewer.
+  EXPECT_LT(iterations[1], iterations[0]);
+  EXPECT_LT(4 * iterations[2], iterations[1]);
+}
+
+TEST(Stationary, ResidualIsCheckedEveryNIterations) {
+  const auto a = Poisson2D(8);
+  const auto result = ppc::stationary::Solve(
+      a, RhsOf(a), {.method = Method::kJacobi, .tolerance = 1e-30, .max_iterations = 40, .check_every = 7});
+  EXPECT_FALSE(result.converged);
+  EXPECT_EQ(result.iterations, 40U);
+  std::vector<std::size_t> checked;
+  for (const auto &check : result.history) {
+    checked.push_back(check.iteration);
+  }
+  EXPECT_EQ(checked, (std::vector<std::size_t>{0, 7, 14, 21, 28, 35, 40}));
+  EXPECT_LT(result.history.back().residual, result.history[1].residual);
+  EXPECT_EQ(result.reductions, 0U);
+  EXPECT_EQ(result.halo_bytes, 0U);
+}
+
+TEST(Stationary, RejectsMalformedInput) {
+  const auto a = Poisson2D(3);
+  const std::vector<double> b(9, 1.0);
+  EXPECT_THROW((void)ppc::stationary::Solve(a, std::vector<double>(8)), std::invalid_argument);
+  EXPECT_THROW((void)ppc::stationary::Solve(a, b, {.method = Method::kSor, .omega = 2.0}), std::invalid_argument);
+  EXPECT_THROW((void)ppc::stationary::Solve(a, b, {.check_every = 0}), std::invalid_argument);
+  EXPECT_THROW((void)ppc::stationary::Solve(ppc::sparse::SliceRows(a, 3, 6), std::vector<double>(3), {}, 3),
+               std::invalid_argument);
+  auto singular = a;
+  singular.values[0] = 0.0;
+  EXPECT_THROW((void)ppc::stationary::Solve(singular, b), std::invalid_argument);
+}
+
+TEST(Stationary, DistributedStripsMatchTheSharedMemorySolve) {
+  if (!ppc::util::MpiReady()) {
+    GTEST_SKIP() << "MPI is not initialized";
+  }
+  int rank = 0;
+  int size = 1;
+  MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+  MPI_Comm_size(MPI_COMM_WORLD, &size);
+  const auto a = Poisson2D(11);
+  const auto b = RhsOf(a);
+  const auto [begin, end] = ppc::shared_memory::BlockRange(a.rows, size, rank);
+  const auto strip = ppc::sparse::SliceRows(a, begin, end);
+  const std::vector<double> b_local(b.begin() + static_cast<std::ptrdiff_t>(begin),
+                                    b.begin() + static_cast<std::ptrdiff_t>(end));
+  for (const Method method : kAllMethods) {
+    const ppc::stationary::Options options{.method = method, .tolerance = 1e-9, .backend = Backend::kTbb};
+    const auto whole = ppc::stationary::Solve(a, b, options);
+    const auto result = ppc::stationary::Solve(strip, b_local, options, begin, MPI_COMM_WORLD);
+    ASSERT_TRUE(result.converged);
+    EXPECT_EQ(result.iterations, whole.iterations);
+    EXPECT_EQ(result.colours, whole.colours);
+    EXPECT_EQ(result.reductions, result.history.size() - 1);
+    if (size > 1) {
+      EXPECT_GT(result.halo_bytes, 0U);
+    }
+    for (std::size_t i = 0; i < result.x.size(); i++) {
+      ASSERT_NEAR(result.x[i], whole.x[begin + i], 1e-12) << "at " << begin + i;
+    }
+  }
+}
+
+template <TypeOfTask kType, Method kMethod>
+void RunStationaryTask(const Crs<double> &a, const std::vector<double> &b) {
+  ppc::stationary::StationaryTask<kType, kMethod> task({.a = a, .b = b}, {.omega = 1.5, .tolerance = 1e-10});
+  ASSERT_TRUE(task.Validation());
+  ASSERT_TRUE(task.PreProcessing());
+  ASSERT_TRUE(task.Run());
+  ASSERT_TRUE(task.PostProcessing());
+  ASSERT_TRUE(task.GetOutput().converged);
+  ASSERT_EQ(task.GetOutput().x.size(), a.rows);
+  ExpectSolves(task.GetOutput().x, 0, 1e-8);
+}
+
+TEST(Stationary, TasksSolveOnEveryBackend) {
+  const auto a = Poisson2D(9);
+  const auto b = RhsOf(a);
+  RunStationaryTask<TypeOfTask::kSEQ, Method::kJacobi>(a, b);
+  RunStationaryTask<TypeOfTask::kOMP, Method::kGaussSeidel>(a, b);
+  RunStationaryTask<TypeOfTask::kTBB, Method::kSor>(a, b);
+  RunStationaryTask<TypeOfTask::kSTL, Method::kGaussSeidel>(a, b);
+  if (ppc::util::MpiReady()) {
+    RunStationaryTask<TypeOfTask::kMPI, Method::kSor>(a, b);
+    RunStationaryTask<TypeOfTask::kMPI, Method::kJacobi>(a, b);
+  }
+}
@@ -0,0 +1,139 @@
+#pragma once
+
+#include <mpi.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace ppc::topology {
+
+/// @brief Shape of the virtual process topology.
+enum class Kind : uint8_t {
+  /// 0 - 1 - ... - (n-1)
+  kLine,
+  /// Line with the ends connected
+  kRing,
+  /// Rank 0 connected to every other rank
+  kStar,
+  /// rows x cols grid with wrap-around links
+  kTorus,
+  /// log2(n)-dimensional cube, n is a power of two
+  kHypercube
+};
+
+/// @brief Forwarding strategy of intermediate ranks.
+enum class Mode : uint8_t {
+  /// Pick by payload size (see Tuning)
+  kAuto,
+  /// Every hop receives the whole message before passing it on
+  kStoreAndForward,
+  /// Hops forward fixed-size segments as soon as they arrive
+  kCutThrough
+};
+
+/// @brief Returns the lower-case name of the topology ("line", "torus", ...).
+std::string KindToString(Kind kind);
+
+/// @brief Payload-size switch points used by Mode::kAuto.
+struct Tuning {
+  /// Payloads of at least this many bytes are sent cut-through.
+  std::size_t cut_through_min_bytes = std::size_t{64} * 1024;
+  /// Segment size of cut-through forwarding.
+  std::size_t segment_bytes = std::size_t{32} * 1024;
+};
+
+/// @brief Returns the tuning shared by all topologies.
+Tuning &GetTuning();
+
+/// @brief Neighbour table and shortest-path routing of a topology shape.
+/// @details Pure rank arithmetic: every rank builds the same layout locally, so routes between
+/// any two ranks are known without communication. Routing is deterministic (dimension order
+/// on the torus, e-cube on the hypercube) and always follows a shortest path.
+class Layout {
+ public:
+  /// @param size Number of ranks; the hypercube requires a power of two.
+  /// @param rows Torus rows (0 = most square grid); must divide @p size.
+  /// @throws std::invalid_argument On a size or row count the shape cannot use.
+  Layout(Kind kind, int size, int rows = 0);
+
+  [[nodiscard]] Kind GetKind() const {
+    return kind_;
+  }
+  [[nodiscard]] int Size() const {
+    return size_;
+  }
+  /// @brief Torus rows (1 for other kinds).
+  [[nodiscard]] int Rows() const {
+    return rows_;
+  }
+  /// @brief Torus columns (Size() for other kinds).
+  [[nodiscard]] int Cols() const {
+    return cols_;
+  }
+  /// @brief Direct neighbours of @p rank, sorted ascending.
+  [[nodiscard]] const std::vector<int> &Neighbours(int rank) const;
+  /// @brief Next rank on the shortest path from @p from to @p to (@p to itself when adjacent).
+  [[nodiscard]] int NextHop(int from, int to) const;
+  /// @brief Ranks visited from @p from to @p to, both included.
+  [[nodiscard]] std::vector<int> Route(int from, int to) const;
+  /// @brief Number of hops between two ranks.
+  [[nodiscard]] int Distance(int from, int to) const;
+  /// @brief Largest distance between any two ranks.
+  [[nodiscard]] int Diameter() const;
+
+ private:
+  void CheckRank(int rank) const;
+
+  Kind kind_;
+  int size_;
+  int rows_ = 1;
+  int cols_ = 1;
+  std::vector<std::vector<int>> neighbours_;
+};
+
+/// @brief Virtual topology over a sub-communicator created with MPI_Comm_split.
+/// @details Line, ring and star use all ranks; the torus arranges all ranks in a rows x cols
+/// grid; the hypercube uses the largest power-of-two prefix of ranks. Ranks left out get
+/// IsMember() == false. Members keep their parent rank.
+class Topology {
+ public:
+  /// @brief Builds the topology (collective over @p comm).
+  /// @param rows Torus rows (0 = choose automatically).
+  Topology(MPI_Comm comm, Kind kind, int rows = 0);
+  ~Topology();
+
+  Topology(const Topology &) = delete;
+  Topology &operator=(const Topology &) = delete;
+
+  [[nodiscard]] const Layout &GetLayout() const {
+    return layout_;
+  }
+  /// @brief Communicator of the topology members; MPI_COMM_NULL on non-members.
+  [[nodiscard]] MPI_Comm Comm() const {
+    return comm_;
+  }
+  [[nodiscard]] bool IsMember() const {
+    return comm_ != MPI_COMM_NULL;
+  }
+  /// @brief Rank inside the topology, -1 on non-members.
+  [[nodiscard]] int Rank() const {
+    return rank_;
+  }
+  [[nodiscard]] int Size() const {
+    return layout_.Size();
+  }
+
+  /// @brief Moves @p count elements from @p source to @p dest along the layout route.
+  /// @details Must be called by all members; ranks off the route return immediately.
+  /// @p buffer is read on @p source and written on @p dest.
+  void Transfer(void *buffer, int count, MPI_Datatype type, int source, int dest, Mode mode = Mode::kAuto) const;
+
+ private:
+  Layout layout_;
+  MPI_Comm comm_ = MPI_COMM_NULL;
+  int rank_ = -1;
+};
+
+}  // namespace ppc::topology
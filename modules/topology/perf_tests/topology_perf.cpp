@@ -0,0 +1,159 @@
+#include <gtest/gtest.h>
+#include <mpi.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <numeric>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include "task/include/task.hpp"
+#include "topology/include/topology.hpp"
+#include "util/include/perf_test_util.hpp"
+
+namespace ppc::topology::perf {
+
+using InType = std::vector<double>;
+using OutType = double;
+
+enum class Benchmark : uint8_t {
+  /// 1-element ping-pong between rank 0 and the farthest rank
+  kLatency,
+  /// Whole input sent one way from rank 0 to the farthest rank
+  kBandwidth
+};
+
+constexpr int kPingPongRounds = 100;
+
+template <Kind kKind, Benchmark kBenchmark, Mode kMode>
+class TopologyTask : public ppc::task::Task<InType, OutType> {
+ public:
+  static constexpr ppc::task::TypeOfTask GetStaticTypeOfTask() {
+    return ppc::task::TypeOfTask::kMPI;
+  }
+
+  explicit TopologyTask(const InType &in) {
+    SetTypeOfTask(GetStaticTypeOfTask());
+    GetInput() = in;
+    GetOutput() = 0.0;
+  }
+
+ private:
+  bool ValidationImpl() override {
+    return !GetInput().empty();
+  }
+
+  bool PreProcessingImpl() override {
+    topology_ = std::make_unique<Topology>(MPI_COMM_WORLD, kKind);
+    const auto &layout = topology_->GetLayout();
+    far_ = 0;
+    for (int r = 0; r < layout.Size(); r++) {
+      if (layout.Distance(0, r) > layout.Distance(0, far_)) {
+        far_ = r;
+      }
+    }
+    const std::size_t count = (kBenchmark == Benchmark::kLatency) ? 1 : GetInput().size();
+    buffer_.assign(count, 0.0);
+    if (topology_->Rank() == 0) {
+      std::copy_n(GetInput().begin(), count, buffer_.begin());
+    }
+    return true;
+  }
+
+  bool RunImpl() override {
+    const int count = static_cast<int>(buffer_.size());
+    if constexpr (kBenchmark == Benchmark::kLatency) {
+      for (int round = 0; round < kPingPongRounds; round++) {
+        topology_->Transfer(buffer_.data(), count, MPI_DOUBLE, 0, far_, kMode);
+        topology_->Transfer(buffer_.data(), count, MPI_DOUBLE, far_, 0, kMode);
+      }
+    } else {
+      topology_->Transfer(buffer_.data(), count, MPI_DOUBLE, 0, far_, kMode);
+    }
+    return true;
+  }
+
+  bool PostProcessingImpl() override {
+    double checksum = std::accumulate(buffer_.begin(), buffer_.end(), 0.0);
+    // Members keep their MPI_COMM_WORLD rank, so far_ is also the world rank of the receiver.
+    MPI_Bcast(&checksum, 1, MPI_DOUBLE, far_, MPI_COMM_WORLD);
+    GetOutput() = checksum;
+    topology_.reset();
+    return true;
+  }
+
+  std::unique_ptr<Topology> topology_;
+  std::vector<double> buffer_;
+  int far_ = 0;
+};
+
+/// Checks the checksum that kBenchmark must produce.
+template <Benchmark kBenchmark>
+class TopologyRunPerfTests : public ppc::util::BaseRunPerfTests<InType, OutType> {
+  static constexpr std::size_t kCount = std::size_t{1} << 20;
+  InType input_data_;
+
+  void SetUp() override {
+    input_data_.resize(kCount);
+    for (std::size_t i = 0; i < kCount; i++) {
+      input_data_[i] = static_cast<double>((i % 5) + 1);
+    }
+  }
+
+  bool CheckTestOutputData(OutType &output_data) final {
+    // Latency runs move only the first element, bandwidth runs the whole input; its integer sum is exact.
+    if constexpr (kBenchmark == Benchmark::kLatency) {
+      return output_data == input_data_.front();
+    } else {
+      return output_data == std::accumulate(input_data_.begin(), input_data_.end(), 0.0);
+    }
+  }
+
+  InType GetTestInputData() final {
+    return input_data_;
+  }
+};
+
+using LatencyPerfTests = TopologyRunPerfTests<Benchmark::kLatency>;
+using BandwidthPerfTests = TopologyRunPerfTests<Benchmark::kBandwidth>;
+
+template <Kind kKind, Benchmark kBenchmark, Mode kMode>
+auto MakeTopologyPerfTasks(const std::string &benchmark_name) {
+  using TaskType = TopologyTask<kKind, kBenchmark, kMode>;
+  const std::string name = "ppc_topology_mpi_" + KindToString(kKind) + "_" + benchmark_name;
+  return ppc::util::MakeNamedPerfTaskTuples<TaskType, InType>(name);
+}
+
+/// One benchmark on every topology kind.
+template <Benchmark kBenchmark, Mode kMode>
+auto MakeTopologySuite(const std::string &benchmark_name) {
+  return std::tuple_cat(MakeTopologyPerfTasks<Kind::kLine, kBenchmark, kMode>(benchmark_name),
+                        MakeTopologyPerfTasks<Kind::kRing, kBenchmark, kMode>(benchmark_name),
+                        MakeTopologyPerfTasks<Kind::kStar, kBenchmark, kMode>(benchmark_name),
+                        MakeTopologyPerfTasks<Kind::kTorus, kBenchmark, kMode>(benchmark_name),
+                        MakeTopologyPerfTasks<Kind::kHypercube, kBenchmark, kMode>(benchmark_name));
+}
+
+TEST_P(LatencyPerfTests, RunPerfModes) {
+  ExecuteTest(GetParam());
+}
+
+TEST_P(BandwidthPerfTests, RunPerfModes) {
+  ExecuteTest(GetParam());
+}
+
+const auto kLatencyPerfTasks = MakeTopologySuite<Benchmark::kLatency, Mode::kStoreAndForward>("latency");
+const auto kBandwidthPerfTasks =
+    std::tuple_cat(MakeTopologySuite<Benchmark::kBandwidth, Mode::kStoreAndForward>("bandwidth_store_and_forward"),
+                   MakeTopologySuite<Benchmark::kBandwidth, Mode::kCutThrough>("bandwidth_cut_through"));
+
+INSTANTIATE_TEST_SUITE_P(TopologyLatency, LatencyPerfTests, ppc::util::TupleToGTestValues(kLatencyPerfTasks),
+                         LatencyPerfTests::CustomPerfTestName);
+
+INSTANTIATE_TEST_SUITE_P(TopologyBandwidth, BandwidthPerfTests, ppc::util::TupleToGTestValues(kBandwidthPerfTasks),
+                         BandwidthPerfTests::CustomPerfTestName);
+
+}  // namespace ppc::topology::perf
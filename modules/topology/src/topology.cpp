@@ -0,0 +1,273 @@
+#include "topology/include/topology.hpp"
+
+#include <mpi.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace ppc::topology {
+
+namespace {
+
+constexpr int kTagTransfer = 7201;
+
+int LargestPowerOfTwo(int n) {
+  int pof2 = 1;
+  while (pof2 * 2 <= n) {
+    pof2 *= 2;
+  }
+  return pof2;
+}
+
+int SquarestRows(int n) {
+  int rows = 1;
+  for (int r = 1; r * r <= n; r++) {
+    if (n % r == 0) {
+      rows = r;
+    }
+  }
+  return rows;
+}
+
+int Log2(int n) {
+  int bits = 0;
+  while ((1 << bits) < n) {
+    bits++;
+  }
+  return bits;
+}
+
+int MemberCount(MPI_Comm comm, Kind kind) {
+  int size = 1;
+  MPI_Comm_size(comm, &size);
+  return kind == Kind::kHypercube ? LargestPowerOfTwo(size) : size;
+}
+
+/// Step along one ring dimension of length @p n towards @p to by the shorter way.
+int RingStep(int from, int to, int n) {
+  const int forward = (to - from + n) % n;
+  return forward <= n / 2 ? (from + 1) % n : (from - 1 + n) % n;
+}
+
+}  // namespace
+
+std::string KindToString(Kind kind) {
+  switch (kind) {
+    case Kind::kLine:
+      return "line";
+    case Kind::kRing:
+      return "ring";
+    case Kind::kStar:
+      return "star";
+    case Kind::kTorus:
+      return "torus";
+    case Kind::kHypercube:
+      return "hypercube";
+  }
+  return "unknown";
+}
+
+Tuning &GetTuning() {
+  static Tuning tuning;
+  return tuning;
+}
+
+Layout::Layout(Kind kind, int size, int rows) : kind_(kind), size_(size) {
+  if (size <= 0) {
+    throw std::invalid_argument("topology: size must be positive");
+  }
+  if (kind == Kind::kHypercube && (size & (size - 1)) != 0) {
+    throw std::invalid_argument("topology: hypercube size " + std::to_string(size) + " is not a power of two");
+  }
+  if (kind == Kind::kTorus) {
+    if (rows < 0 || (rows > 0 && size % rows != 0)) {
+      throw std::invalid_argument("topology: " + std::to_string(rows) + " rows do not divide " +
+                                  std::to_string(size) + " ranks");
+    }
+    rows_ = rows > 0 ? rows : SquarestRows(size);
+  }
+  cols_ = size_ / rows_;
+
+  neighbours_.assign(static_cast<std::size_t>(size_), {});
+  for (int r = 0; r < size_; r++) {
+    auto &list = neighbours_[static_cast<std::size_t>(r)];
+    switch (kind_) {
+      case Kind::kLine:
+        list = {r - 1, r + 1};
+        break;
+      case Kind::kRing:
+        list = {(r - 1 + size_) % size_, (r + 1) % size_};
+        break;
+      case Kind::kStar:
+        if (r == 0) {
+          for (int i = 1; i < size_; i++) {
+            list.push_back(i);
+          }
+        } else {
+          list = {0};
+        }
+        break;
+      case Kind::kTorus: {
+        const int row = r / cols_;
+        const int col = r % cols_;
+        list = {(((row - 1 + rows_) % rows_) * cols_) + col, (((row + 1) % rows_) * cols_) + col,
+                (row * cols_) + ((col - 1 + cols_) % cols_), (row * cols_) + ((col + 1) % cols_)};
+        break;
+      }
+      case Kind::kHypercube:
+        for (int bit = 1; bit < size_; bit <<= 1) {
+          list.push_back(r ^ bit);
+        }
+        break;
+    }
+    std::erase_if(list, [&](int n) { return n < 0 || n >= size_ || n == r; });
+    std::ranges::sort(list);
+    list.erase(std::ranges::unique(list).begin(), list.end());
+  }
+}
+
+const std::vector<int> &Layout::Neighbours(int rank) const {
+  CheckRank(rank);
+  return neighbours_[static_cast<std::size_t>(rank)];
+}
+
+void Layout::CheckRank(int rank) const {
+  if (rank < 0 || rank >= size_) {
+    throw std::out_of_range("topology: rank " + std::to_string(rank) + " is not a member");
+  }
+}
+
+int Layout::NextHop(int from, int to) const {
+  CheckRank(from);
+  CheckRank(to);
+  if (from == to) {
+    return to;
+  }
+  switch (kind_) {
+    case Kind::kLine:
+      return to > from ? from + 1 : from - 1;
+    case Kind::kRing:
+      return RingStep(from, to, size_);
+    case Kind::kStar:
+      return from == 0 ? to : 0;
+    case Kind::kTorus: {
+      // Dimension-order routing: fix the column first, then the row.
+      const int row = from / cols_;
+      const int col = from % cols_;
+      if (col != to % cols_) {
+        return (row * cols_) + RingStep(col, to % cols_, cols_);
+      }
+      return (RingStep(row, to / cols_, rows_) * cols_) + col;
+    }
+    case Kind::kHypercube: {
+      // E-cube routing: flip the lowest differing bit.
+      const int diff = from ^ to;
+      return from ^ (diff & -diff);
+    }
+  }
+  return to;
+}
+
+std::vector<int> Layout::Route(int from, int to) const {
+  std::vector<int> route = {from};
+  while (route.back() != to) {
+    route.push_back(NextHop(route.back(), to));
+  }
+  return route;
+}
+
+int Layout::Distance(int from, int to) const {
+  return static_cast<int>(Route(from, to).size()) - 1;
+}
+
+int Layout::Diameter() const {
+  switch (kind_) {
+    case Kind::kLine:
+      return size_ - 1;
+    case Kind::kRing:
+      return size_ / 2;
+    case Kind::kStar:
+      return std::min(size_ - 1, 2);
+    case Kind::kTorus:
+      return (rows_ / 2) + (cols_ / 2);
+    case Kind::kHypercube:
+      return Log2(size_);
+  }
+  return 0;
+}
+
+Topology::Topology(MPI_Comm comm, Kind kind, int rows) : layout_(kind, MemberCount(comm, kind), rows) {
+  int parent_rank = 0;
+  MPI_Comm_rank(comm, &parent_rank);
+  const bool member = parent_rank < layout_.Size();
+  MPI_Comm_split(comm, member ? 0 : MPI_UNDEFINED, parent_rank, &comm_);
+  if (member) {
+    MPI_Comm_rank(comm_, &rank_);
+  }
+}
+
+Topology::~Topology() {
+  int finalized = 0;
+  MPI_Finalized(&finalized);
+  if (finalized == 0 && comm_ != MPI_COMM_NULL) {
+    MPI_Comm_free(&comm_);
+  }
+}
+
+void Topology::Transfer(void *buffer, int count, MPI_Datatype type, int source, int dest, Mode mode) const {
+  if (!IsMember() || source == dest || count == 0) {
+    return;
+  }
+  const auto route = layout_.Route(source, dest);
+  const auto pos_it = std::ranges::find(route, rank_);
+  if (pos_it == route.end()) {
+    return;
+  }
+  const auto pos = static_cast<std::size_t>(pos_it - route.begin());
+  const int prev = pos > 0 ? route[pos - 1] : MPI_PROC_NULL;
+  const int next = pos + 1 < route.size() ? route[pos + 1] : MPI_PROC_NULL;
+
+  MPI_Aint lb = 0;
+  MPI_Aint extent = 0;
+  MPI_Type_get_extent(type, &lb, &extent);
+  int type_size = 0;
+  MPI_Type_size(type, &type_size);
+  const std::size_t payload = static_cast<std::size_t>(count) * static_cast<std::size_t>(type_size);
+
+  // Intermediate hops relay through a private buffer and leave the caller's untouched.
+  std::vector<unsigned char> relay;
+  auto *data = static_cast<unsigned char *>(buffer);
+  if (prev != MPI_PROC_NULL && next != MPI_PROC_NULL) {
+    relay.resize(static_cast<std::size_t>(count) * static_cast<std::size_t>(extent));
+    data = relay.data();
+  }
+
+  if (mode == Mode::kAuto) {
+    mode = payload >= GetTuning().cut_through_min_bytes ? Mode::kCutThrough : Mode::kStoreAndForward;
+  }
+  if (mode == Mode::kStoreAndForward) {
+    MPI_Recv(data, count, type, prev, kTagTransfer, comm_, MPI_STATUS_IGNORE);
+    MPI_Send(data, count, type, next, kTagTransfer, comm_);
+    return;
+  }
+
+  const auto element_bytes = static_cast<std::size_t>(std::max(type_size, 1));
+  const int segment = static_cast<int>(std::max<std::size_t>(GetTuning().segment_bytes / element_bytes, 1));
+  std::vector<MPI_Request> requests;
+  requests.reserve(static_cast<std::size_t>((count / segment) + 1));
+  for (int offset = 0; offset < count; offset += segment) {
+    const int len = std::min(segment, count - offset);
+    auto *chunk = data + (static_cast<std::size_t>(offset) * static_cast<std::size_t>(extent));
+    MPI_Recv(chunk, len, type, prev, kTagTransfer, comm_, MPI_STATUS_IGNORE);
+    if (next != MPI_PROC_NULL) {
+      requests.emplace_back();
+      MPI_Isend(chunk, len, type, next, kTagTransfer, comm_, &requests.back());
+    }
+  }
+  MPI_Waitall(static_cast<int>(requests.size()), requests.data(), MPI_STATUSES_IGNORE);
+}
+
+}  // namespace ppc::topology
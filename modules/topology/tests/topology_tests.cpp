@@ -0,0 +1,129 @@
+#include <gtest/gtest.h>
+#include <mpi.h>
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <numeric>
+#include <queue>
+#include <stdexcept>
+#include <vector>
+
+#include "topology/include/topology.hpp"
+#include "util/include/func_test_util.hpp"
+
+using ppc::topology::Kind;
+using ppc::topology::Layout;
+using ppc::topology::Mode;
+using ppc::topology::Topology;
+
+namespace {
+
+constexpr std::array<Kind, 5> kAllKinds = {Kind::kLine, Kind::kRing, Kind::kStar, Kind::kTorus, Kind::kHypercube};
+
+std::vector<int> BfsDistances(const Layout &layout, int from) {
+  std::vector<int> dist(static_cast<std::size_t>(layout.Size()), -1);
+  std::queue<int> queue;
+  dist[static_cast<std::size_t>(from)] = 0;
+  queue.push(from);
+  while (!queue.empty()) {
+    const int v = queue.front();
+    queue.pop();
+    for (const int n : layout.Neighbours(v)) {
+      if (dist[static_cast<std::size_t>(n)] < 0) {
+        dist[static_cast<std::size_t>(n)] = dist[static_cast<std::size_t>(v)] + 1;
+        queue.push(n);
+      }
+    }
+  }
+  return dist;
+}
+
+}  // namespace
+
+TEST(TopologyLayout, RoutesAreShortestAndFollowLinks) {
+  for (const auto kind : kAllKinds) {
+    for (int size = 1; size <= 16; size++) {
+      if (kind == Kind::kHypercube && (size & (size - 1)) != 0) {
+        continue;
+      }
+      const Layout layout(kind, size);
+      int diameter = 0;
+      for (int from = 0; from < size; from++) {
+        const auto dist = BfsDistances(layout, from);
+        for (int to = 0; to < size; to++) {
+          const auto route = layout.Route(from, to);
+          ASSERT_EQ(static_cast<int>(route.size()) - 1, dist[static_cast<std::size_t>(to)])
+              << ppc::topology::KindToString(kind) << " size " << size << " " << from << "->" << to;
+          for (std::size_t i = 1; i < route.size(); i++) {
+            const auto &links = layout.Neighbours(route[i - 1]);
+            ASSERT_TRUE(std::ranges::binary_search(links, route[i]));
+          }
+          diameter = std::max(diameter, dist[static_cast<std::size_t>(to)]);
+        }
+      }
+      EXPECT_EQ(layout.Diameter(), diameter) << ppc::topology::KindToString(kind) << " size " << size;
+    }
+  }
+}
+
+TEST(TopologyLayout, NeighbourTablesAreSymmetric) {
+  for (const auto kind : kAllKinds) {
+    const Layout layout(kind, 8);
+    for (int r = 0; r < layout.Size(); r++) {
+      for (const int n : layout.Neighbours(r)) {
+        EXPECT_TRUE(std::ranges::binary_search(layout.Neighbours(n), r));
+      }
+    }
+  }
+}
+
+TEST(TopologyLayout, TorusUsesSquarestGridOrGivenRows) {
+  const Layout square(Kind::kTorus, 12);
+  EXPECT_EQ(square.Rows(), 3);
+  EXPECT_EQ(square.Cols(), 4);
+  const Layout wide(Kind::kTorus, 12, 2);
+  EXPECT_EQ(wide.Rows(), 2);
+  EXPECT_EQ(wide.Cols(), 6);
+  EXPECT_EQ(wide.Neighbours(0), (std::vector<int>{1, 5, 6}));
+}
+
+TEST(TopologyLayout, RejectsInvalidShapes) {
+  EXPECT_THROW(Layout(Kind::kHypercube, 6), std::invalid_argument);
+  EXPECT_THROW(Layout(Kind::kTorus, 12, 5), std::invalid_argument);
+  EXPECT_THROW(Layout(Kind::kLine, 0), std::invalid_argument);
+  const Layout line(Kind::kLine, 4);
+  EXPECT_THROW((void)line.Route(0, 4), std::out_of_range);
+}
+
+TEST(TopologyMPI, TransferDeliversBetweenEveryPair) {
+  if (!ppc::util::MpiReady()) {
+    GTEST_SKIP() << "MPI is not initialized";
+  }
+  for (const auto kind : kAllKinds) {
+    const Topology topology(MPI_COMM_WORLD, kind);
+    if (!topology.IsMember()) {
+      continue;
+    }
+    const int size = topology.Size();
+    const int rank = topology.Rank();
+    for (const auto mode : {Mode::kStoreAndForward, Mode::kCutThrough}) {
+      for (int source = 0; source < size; source++) {
+        for (int dest = 0; dest < size; dest++) {
+          std::vector<int> data(10000, -1);
+          if (rank == source) {
+            std::iota(data.begin(), data.end(), source * 7);
+          }
+          const std::vector<int> before = data;
+          topology.Transfer(data.data(), static_cast<int>(data.size()), MPI_INT, source, dest, mode);
+          if (rank == dest) {
+            ASSERT_EQ(data.front(), source * 7);
+            ASSERT_EQ(data.back(), (source * 7) + 9999);
+          } else {
+            ASSERT_EQ(data, before);
+          }
+        }
+      }
+    }
+  }
+}
@@ -18,6 +18,9 @@
 
 namespace ppc::util {
 
+/// @brief Whether MPI is initialized; tests of MPI code skip themselves when it is not.
+bool MpiReady();
+
 template <typename InType, typename OutType, typename TestType = void>
 using FuncTestParam = std::tuple<std::function<ppc::task::TaskPtr<InType, OutType>(InType)>, std::string, TestType>;
 
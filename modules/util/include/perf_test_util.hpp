@@ -7,6 +7,9 @@
 #include <csignal>
 #include <cstddef>
 #include <functional>
+#include <iomanip>
+#include <iostream>
+#include <span>
 #include <sstream>
 #include <stdexcept>
 #include <string>
@@ -57,7 +60,7 @@ class BaseRunPerfTests : public ::testing::TestWithParam<PerfTestParam<InType, O
                task_->GetDynamicTypeOfTask() == ppc::task::TypeOfTask::kSTL ||
                task_->GetDynamicTypeOfTask() == ppc::task::TypeOfTask::kTBB) {
       const auto t0 = std::chrono::high_resolution_clock::now();
-      perf_attrs.current_timer = [&] {
+      perf_attrs.current_timer = [t0] {
         auto now = std::chrono::high_resolution_clock::now();
         auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(now - t0).count();
         return static_cast<double>(ns) * 1e-9;
@@ -67,6 +70,42 @@ class BaseRunPerfTests : public ::testing::TestWithParam<PerfTestParam<InType, O
     }
   }
 
+  /// @brief Results of the measurement that ExecuteTest() just finished; valid in CheckTestOutputData().
+  [[nodiscard]] const ppc::performance::PerfResults &GetLastPerfResults() const {
+    return last_results_;
+  }
+
+  /// @brief Prints "<test>:<task_run|pipeline>:<unit>:<work / time>" on rank 0 for the last measurement.
+  /// @param unit Name of the rate, e.g. "gflop_per_s".
+  /// @param work Amount of work done by one run in the unit's numerator, e.g. 1e-9 * flops.
+  void PrintRate(const std::string &unit, double work) const {
+    if (GetMPIRank() != 0 || last_results_.time_sec <= 0.0) {
+      return;
+    }
+    std::cout << last_test_name_ << ":" << ppc::performance::GetStringParamName(last_results_.type_of_running) << ":"
+              << unit << ":" << std::fixed << std::setprecision(3) << (work / last_results_.time_sec) << '\n';
+  }
+
+  /// @brief Prints "<test>:<task_run|pipeline>:<name>:<value>" on rank 0, for metrics that are not rates
+  /// (iteration counts, residuals, bytes moved).
+  void PrintValue(const std::string &name, double value) const {
+    PrintSeries(name, std::span<const double>(&value, 1));
+  }
+
+  /// @brief Prints "<test>:<task_run|pipeline>:<name>:<v0>;<v1>;..." on rank 0, e.g. a convergence history.
+  void PrintSeries(const std::string &name, std::span<const double> values) const {
+    if (GetMPIRank() != 0) {
+      return;
+    }
+    std::ostringstream line;
+    line << last_test_name_ << ":" << ppc::performance::GetStringParamName(last_results_.type_of_running) << ":"
+         << name << ":" << std::setprecision(6);
+    for (std::size_t i = 0; i < values.size(); i++) {
+      line << (i == 0 ? "" : ";") << values[i];
+    }
+    std::cout << line.str() << '\n';
+  }
+
   void ExecuteTest(const PerfTestParam<InType, OutType> &perf_test_param) {
     auto task_getter = std::get<static_cast<std::size_t>(GTestParamIndex::kTaskGetter)>(perf_test_param);
     auto test_name = std::get<static_cast<std::size_t>(GTestParamIndex::kNameTest)>(perf_test_param);
@@ -97,6 +136,8 @@ class BaseRunPerfTests : public ::testing::TestWithParam<PerfTestParam<InType, O
     if (GetMPIRank() == 0) {
       perf.PrintPerfStatistic(test_name);
     }
+    last_test_name_ = test_name;
+    last_results_ = perf.GetPerfResults();
 
     OutType output_data = task_->GetOutput();
     ASSERT_TRUE(CheckTestOutputData(output_data));
@@ -104,19 +145,41 @@ class BaseRunPerfTests : public ::testing::TestWithParam<PerfTestParam<InType, O
 
  private:
   ppc::task::TaskPtr<InType, OutType> task_;
+  std::string last_test_name_;
+  ppc::performance::PerfResults last_results_;
 };
 
+/// @brief Pipeline and task-run cases of @p TaskType under the test name @p name.
 template <typename TaskType, typename InputType>
-auto MakePerfTaskTuples(const std::string &settings_path) {
-  const auto name = std::string(GetNamespace<TaskType>()) + "_" +
-                    ppc::task::GetStringTaskType(TaskType::GetStaticTypeOfTask(), settings_path);
-
+auto MakeNamedPerfTaskTuples(const std::string &name) {
   return std::make_tuple(std::make_tuple(ppc::task::TaskGetter<TaskType, InputType>, name,
                                          ppc::performance::PerfResults::TypeOfRunning::kPipeline),
                          std::make_tuple(ppc::task::TaskGetter<TaskType, InputType>, name,
                                          ppc::performance::PerfResults::TypeOfRunning::kTaskRun));
 }
 
+/// @brief Pipeline and task-run cases of one kernel on the seq, omp, tbb, stl and mpi back-ends,
+/// named @p prefix + "_<backend>_" + @p kernel.
+/// @details Task<kType> is the task of back-end kType; suites whose tasks take more parameters
+/// bind them with a member alias template.
+template <template <ppc::task::TypeOfTask> class Task, typename InputType>
+auto MakeBackendPerfTaskTuples(const std::string &prefix, const std::string &kernel) {
+  using ppc::task::TypeOfTask;
+  const auto name = [&](TypeOfTask type) { return prefix + "_" + ppc::task::TypeOfTaskToString(type) + "_" + kernel; };
+  return std::tuple_cat(MakeNamedPerfTaskTuples<Task<TypeOfTask::kSEQ>, InputType>(name(TypeOfTask::kSEQ)),
+                        MakeNamedPerfTaskTuples<Task<TypeOfTask::kOMP>, InputType>(name(TypeOfTask::kOMP)),
+                        MakeNamedPerfTaskTuples<Task<TypeOfTask::kTBB>, InputType>(name(TypeOfTask::kTBB)),
+                        MakeNamedPerfTaskTuples<Task<TypeOfTask::kSTL>, InputType>(name(TypeOfTask::kSTL)),
+                        MakeNamedPerfTaskTuples<Task<TypeOfTask::kMPI>, InputType>(name(TypeOfTask::kMPI)));
+}
+
+template <typename TaskType, typename InputType>
+auto MakePerfTaskTuples(const std::string &settings_path) {
+  const auto name = std::string(GetNamespace<TaskType>()) + "_" +
+                    ppc::task::GetStringTaskType(TaskType::GetStaticTypeOfTask(), settings_path);
+  return MakeNamedPerfTaskTuples<TaskType, InputType>(name);
+}
+
 template <typename Tuple, std::size_t... I>
 auto TupleToGTestValuesImpl(const Tuple &tup, std::index_sequence<I...> /*unused*/) {
   return ::testing::Values(std::get<I>(tup)...);
@@ -4,10 +4,13 @@
 #include <array>
 #include <atomic>
 #include <cctype>
+#include <cstddef>
 #include <cstdint>
 #include <cstdlib>
 #include <filesystem>
+#include <initializer_list>
 #include <memory>
+#include <span>
 #include <sstream>
 #include <string>
 #include <string_view>
@@ -67,6 +70,14 @@ class DestructorFailureFlag {
 enum class GTestParamIndex : uint8_t { kTaskGetter, kNameTest, kTestParams };
 
 std::string GetAbsoluteTaskPath(const std::string &id_path, const std::string &relative_path);
+
+/// @brief Replaces @p path with the concatenation of @p parts, written to a temporary file of its
+/// own that is then renamed over @p path.
+/// @details Readers never map a partial file, and ranks sharing a directory may write the same
+/// file at once.
+/// @throws std::runtime_error When the temporary cannot be written or renamed.
+void WriteFileAtomically(const std::string &path, std::initializer_list<std::span<const std::byte>> parts);
+
 int GetNumThreads();
 int GetNumProc();
 double GetTaskMaxTime();
@@ -1,5 +1,6 @@
 #include <mpi.h>
 
+#include "util/include/func_test_util.hpp"
 #include "util/include/perf_test_util.hpp"
 
 double ppc::util::GetTimeMPI() {
@@ -11,3 +12,9 @@ int ppc::util::GetMPIRank() {
   MPI_Comm_rank(MPI_COMM_WORLD, &rank);
   return rank;
 }
+
+bool ppc::util::MpiReady() {
+  int initialized = 0;
+  MPI_Initialized(&initialized);
+  return initialized != 0;
+}
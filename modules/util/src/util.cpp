@@ -2,9 +2,17 @@
 
 #include <algorithm>
 #include <array>
+#include <cstddef>
 #include <filesystem>
+#include <fstream>
+#include <initializer_list>
+#include <ios>
 #include <libenvpp/detail/get.hpp>
+#include <random>
+#include <span>
+#include <stdexcept>
 #include <string>
+#include <system_error>
 
 namespace {
 
@@ -20,6 +28,33 @@ std::string ppc::util::GetAbsoluteTaskPath(const std::string &id_path, const std
   return GetAbsolutePath(task_relative.string());
 }
 
+void ppc::util::WriteFileAtomically(const std::string &path, std::initializer_list<std::span<const std::byte>> parts) {
+  // Ranks sharing a directory may write the same file at once; each uses its own temporary.
+  const std::string temporary = path + ".tmp" + std::to_string(std::random_device{}());
+  {
+    std::ofstream out(temporary, std::ios::binary | std::ios::trunc);
+    if (!out) {
+      throw std::runtime_error("Failed to create " + temporary);
+    }
+    for (const auto part : parts) {
+      out.write(reinterpret_cast<const char *>(part.data()),  // NOLINT(*-reinterpret-cast)
+                static_cast<std::streamsize>(part.size()));
+    }
+    if (!out) {
+      std::error_code error;
+      out.close();
+      std::filesystem::remove(temporary, error);
+      throw std::runtime_error("Failed to write " + temporary);
+    }
+  }
+  std::error_code error;
+  std::filesystem::rename(temporary, path, error);
+  if (error) {
+    std::filesystem::remove(temporary, error);
+    throw std::runtime_error("Failed to replace " + path);
+  }
+}
+
 int ppc::util::GetNumThreads() {
   const auto num_threads = env::get<int>("PPC_NUM_THREADS");
   if (num_threads.has_value()) {
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "example_threads/common/include/common.hpp"
+#include "hybrid/include/hybrid.hpp"
 #include "task/include/task.hpp"
 
 namespace nesterov_a_test_task_threads {
@@ -10,13 +11,15 @@ class NesterovATestTaskALL : public BaseTask {
   static constexpr ppc::task::TypeOfTask GetStaticTypeOfTask() {
     return ppc::task::TypeOfTask::kALL;
   }
-  explicit NesterovATestTaskALL(const InType &in);
+  explicit NesterovATestTaskALL(const InType &in, ppc::hybrid::Context &context = ppc::hybrid::Context::Default());
 
  private:
   bool ValidationImpl() override;
   bool PreProcessingImpl() override;
   bool RunImpl() override;
   bool PostProcessingImpl() override;
+
+  ppc::hybrid::Context *context_;
 };
 
 }  // namespace nesterov_a_test_task_threads
@@ -4,16 +4,14 @@
 
 #include <atomic>
 #include <numeric>
-#include <thread>
 #include <vector>
 
 #include "example_threads/common/include/common.hpp"
-#include "oneapi/tbb/parallel_for.h"
-#include "util/include/util.hpp"
+#include "hybrid/include/hybrid.hpp"
 
 namespace nesterov_a_test_task_threads {
 
-NesterovATestTaskALL::NesterovATestTaskALL(const InType &in) {
+NesterovATestTaskALL::NesterovATestTaskALL(const InType &in, ppc::hybrid::Context &context) : context_(&context) {
   SetTypeOfTask(GetStaticTypeOfTask());
   GetInput() = in;
   GetOutput() = 0;
@@ -39,41 +37,23 @@ bool NesterovATestTaskALL::RunImpl() {
     }
   }
 
-  const int num_threads = ppc::util::GetNumThreads();
-  {
-    GetOutput() *= num_threads;
+  // Intra-node work: threads of the local pool.
+  auto &pool = context_->Pool();
+  const int num_threads = pool.Size();
+  GetOutput() *= num_threads;
+  std::atomic<int> counter(0);
+  pool.RunOnAll([&](int /*thread_id*/) { counter++; });
+  GetOutput() /= counter;
 
-    int rank = -1;
-    MPI_Comm_rank(MPI_COMM_WORLD, &rank);
-    if (rank == 0) {
-      std::atomic<int> counter(0);
-#pragma omp parallel default(none) shared(counter) num_threads(ppc::util::GetNumThreads())
-      counter++;
-
-      GetOutput() /= counter;
-    } else {
-      GetOutput() /= num_threads;
-    }
-  }
-
-  {
-    GetOutput() *= num_threads;
-    std::vector<std::thread> threads(num_threads);
-    std::atomic<int> counter(0);
-    for (int i = 0; i < num_threads; i++) {
-      threads[i] = std::thread([&]() { counter++; });
-      threads[i].join();
-    }
-    GetOutput() /= counter;
-  }
-
-  {
-    GetOutput() *= num_threads;
-    std::atomic<int> counter(0);
-    tbb::parallel_for(0, ppc::util::GetNumThreads(), [&](int /*i*/) { counter++; });
-    GetOutput() /= counter;
+  // Inter-node work: one rank per node agrees on the result, then shares it with its node.
+  OutType result = GetOutput();
+  if (context_->Leaders() != MPI_COMM_NULL) {
+    context_->Progress()
+        .Submit([&] { MPI_Allreduce(MPI_IN_PLACE, &result, 1, MPI_INT, MPI_MIN, context_->Leaders()); })
+        .get();
   }
-  MPI_Barrier(MPI_COMM_WORLD);
+  MPI_Bcast(&result, 1, MPI_INT, 0, context_->Node());
+  GetOutput() = result;
   return GetOutput() > 0;
 }
 